@@ -12,6 +12,9 @@ menu.data = [{
     "subMenu": [{
         "title": "BTC Quote Plugin",
         "hyperRef": "/plugins/BTCQuotePlugin.html"
+    }, {
+        "title": "Canvas Plugin",
+        "hyperRef": "/plugins/CanvasPlugin.html"
     }, {
         "title": "Countdown Plugin",
         "hyperRef": "/plugins/CountdownPlugin.html"
@@ -39,6 +42,9 @@ menu.data = [{
     }, {
         "title": "JustText Plugin",
         "hyperRef": "/plugins/JustTextPlugin.html"
+    }, {
+        "title": "LiveStream Plugin",
+        "hyperRef": "/plugins/LiveStreamPlugin.html"
     }, {
         "title": "Matrix Plugin",
         "hyperRef": "/plugins/MatrixPlugin.html"
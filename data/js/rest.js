@@ -111,6 +111,25 @@ pixelix.rest.Client.prototype.getPluginInstances = function() {
     });
 };
 
+pixelix.rest.Client.prototype.getDisplayStatistics = function() {
+    return utils.makeRequest({
+        method: "GET",
+        url: "/rest/api/v1/display/stats",
+        isJsonResponse: true
+    });
+};
+
+pixelix.rest.Client.prototype.enableDisplayStatistics = function(enable) {
+    return utils.makeRequest({
+        method: "POST",
+        url: "/rest/api/v1/display/stats",
+        isJsonResponse: true,
+        parameter: {
+            enable: (true === enable) ? "true" : "false"
+        }
+    });
+};
+
 pixelix.rest.Client.prototype.getSensors = function() {
     return utils.makeRequest({
         method: "GET",
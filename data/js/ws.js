@@ -37,6 +37,9 @@ pixelix.ws.Client = function(options) {
     this._cmdQueue      = [];
     this._pendingCmd    = null;
     this._onEvent       = null;
+    this._framebuffer   = [];
+    this._onMirror      = null;
+    this._mirrorFramebuffer = [];
 
     this._sendCmdFromQueue = function() {
         var msg = "";
@@ -90,6 +93,9 @@ pixelix.ws.Client.prototype.connect = function(options) {
             try {
                 wsUrl = options.protocol + "://" + options.hostname + ":" + options.port + options.endpoint;
                 this._socket = new WebSocket(wsUrl);
+                this._socket.binaryType = "arraybuffer";
+                this._framebuffer = [];
+                this._mirrorFramebuffer = [];
 
                 this._socket.onopen = function(openEvent) {
                     console.debug("Websocket opened.");
@@ -106,8 +112,13 @@ pixelix.ws.Client.prototype.connect = function(options) {
                 };
 
                 this._socket.onmessage = function(messageEvent) {
-                    console.debug("Websocket message: " + messageEvent.data);
-                    this._onMessage(messageEvent.data);
+                    if (messageEvent.data instanceof ArrayBuffer) {
+                        console.debug("Websocket binary message: " + messageEvent.data.byteLength + " byte");
+                        this._onBinaryMessage(messageEvent.data);
+                    } else {
+                        console.debug("Websocket message: " + messageEvent.data);
+                        this._onMessage(messageEvent.data);
+                    }
                 }.bind(this);
 
             } catch (exception) {
@@ -181,6 +192,8 @@ pixelix.ws.Client.prototype._onMessage = function(msg) {
             } else if ("LOG" === this._pendingCmd.name) {
                 rsp.isEnabled = (0 === parseInt(data[0])) ? false : true;
                 this._pendingCmd.resolve(rsp);
+            } else if ("MIRROR" === this._pendingCmd.name) {
+                this._pendingCmd.resolve(rsp);
             } else if ("MOVE" === this._pendingCmd.name) {
                 this._pendingCmd.resolve(rsp);
             } else if ("PLUGINS" === this._pendingCmd.name) {
@@ -226,14 +239,157 @@ pixelix.ws.Client.prototype._onMessage = function(msg) {
     return;
 };
 
-pixelix.ws.Client.prototype.getDisplayContent = function() {
+pixelix.ws.Client.prototype._decodeFrame = function(buffer, framebuffer) {
+    var view        = new DataView(buffer);
+    var frameType   = view.getUint8(0);
+    var colorFormat = view.getUint8(1);
+    var width       = view.getUint16(4, true);
+    var height      = view.getUint16(6, true);
+    var offset      = 8;
+    var index       = 0;
+    var unchanged   = 0;
+    var changed     = 0;
+    var readPixel   = function() {
+        var color = 0;
+        var red, green, blue;
+
+        if (1 === colorFormat) {
+            color   = view.getUint16(offset, true);
+            red     = (color >> 11) & 0x1f;
+            green   = (color >> 5) & 0x3f;
+            blue    = (color >> 0) & 0x1f;
+            color   = (((red << 3) | (red >> 2)) << 16) | (((green << 2) | (green >> 4)) << 8) | ((blue << 3) | (blue >> 2));
+            offset += 2;
+        } else {
+            color   = (view.getUint8(offset) << 16) | (view.getUint8(offset + 1) << 8) | view.getUint8(offset + 2);
+            offset += 3;
+        }
+
+        return color;
+    };
+
+    if (framebuffer.length !== (width * height)) {
+        framebuffer = new Array(width * height).fill(0);
+    }
+
+    /* Key frame with all pixels */
+    if (0 === frameType) {
+        for(index = 0; index < framebuffer.length; ++index) {
+            framebuffer[index] = readPixel();
+        }
+    /* Delta frame with only the changed pixels */
+    } else {
+        while(buffer.byteLength > offset) {
+            unchanged   = view.getUint16(offset, true);
+            changed     = view.getUint16(offset + 2, true);
+            offset     += 4;
+            index      += unchanged;
+
+            while(0 < changed) {
+                framebuffer[index] = readPixel();
+                ++index;
+                --changed;
+            }
+        }
+    }
+
+    return framebuffer;
+};
+
+pixelix.ws.Client.prototype._onBinaryMessage = function(buffer) {
+    var view    = new DataView(buffer);
+    var slotId  = view.getUint8(2);
+    var source  = view.getUint8(3);
+
+    /* Pushed by the display mirror? */
+    if (1 === source) {
+        this._mirrorFramebuffer = this._decodeFrame(buffer, this._mirrorFramebuffer);
+
+        if (null !== this._onMirror) {
+            this._onMirror({
+                slotId: slotId,
+                data: this._mirrorFramebuffer.slice()
+            });
+        }
+    } else {
+        if (null === this._pendingCmd) {
+            console.error("No pending command, but binary response received.");
+        } else if ("GETDISP" !== this._pendingCmd.name) {
+            console.error("Command " + this._pendingCmd.name + " got unexpected binary response.");
+            this._pendingCmd.reject();
+        } else {
+            this._framebuffer = this._decodeFrame(buffer, this._framebuffer);
+
+            this._pendingCmd.resolve({
+                slotId: slotId,
+                data: this._framebuffer.slice()
+            });
+        }
+
+        this._pendingCmd = null;
+        this._sendCmdFromQueue();
+    }
+
+    return;
+};
+
+pixelix.ws.Client.prototype.getDisplayContent = function(colorFormat, isDeltaAllowed) {
     return new Promise(function(resolve, reject) {
+        var par = null;
+
+        /* Binary frame requested? */
+        if ("string" === typeof colorFormat) {
+            par = colorFormat;
+
+            if (true === isDeltaAllowed) {
+                par += ";DELTA";
+            }
+        }
+
         if (null === this._socket) {
             reject();
         } else {
             this._sendCmd({
                 name: "GETDISP",
-                par: null,
+                par: par,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+pixelix.ws.Client.prototype.subscribeMirror = function(fps, callback) {
+    return new Promise(function(resolve, reject) {
+        if (null === this._socket) {
+            reject();
+        } else if (("number" !== typeof fps) ||
+                   ("function" !== typeof callback)) {
+            reject();
+        } else {
+            this._onMirror = callback;
+            this._mirrorFramebuffer = [];
+
+            this._sendCmd({
+                name: "MIRROR",
+                par: fps,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+pixelix.ws.Client.prototype.unsubscribeMirror = function() {
+    return new Promise(function(resolve, reject) {
+        if (null === this._socket) {
+            reject();
+        } else {
+            this._onMirror = null;
+
+            this._sendCmd({
+                name: "MIRROR",
+                par: 0,
                 resolve: resolve,
                 reject: reject
             });
@@ -181,6 +181,17 @@ public:
         return height;
     }
 
+    /**
+     * Get read access to the whole pixel buffer.
+     * The pixels are stored row by row.
+     *
+     * @return Pixel buffer
+     */
+    const TColor* get() const
+    {
+        return m_pixels;
+    }
+
     /**
      * Get pixel color at given position.
      * This is used for color manipulation in higher layers.
@@ -444,6 +455,17 @@ public:
         return m_height;
     }
 
+    /**
+     * Get read access to the whole pixel buffer.
+     * The pixels are stored row by row.
+     *
+     * @return Pixel buffer, which may be nullptr if not created.
+     */
+    const TColor* get() const
+    {
+        return m_pixels;
+    }
+
     /**
      * Get pixel color at given position.
      * This is used for color manipulation in higher layers.
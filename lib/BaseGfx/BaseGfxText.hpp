@@ -353,7 +353,8 @@ public:
     {
         size_t idx = 0U;
 
-        if (nullptr == m_font)
+        if ((nullptr == m_font.getGfxFont()) ||
+            (nullptr == text))
         {
             return;
         }
@@ -101,6 +101,17 @@ public:
      */
     virtual void clear() = 0;
 
+    /**
+     * Copy the framebuffer row by row in RGB888 format, which is much faster
+     * than reading pixel by pixel via getColor().
+     *
+     * @param[out] buffer   Buffer, which will be filled.
+     * @param[in]  length   Buffer length in number of pixels.
+     *
+     * @return Number of copied pixels
+     */
+    virtual size_t readFramebuffer(uint32_t* buffer, size_t length) const = 0;
+
 protected:
 
     /**
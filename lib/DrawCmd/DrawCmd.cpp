@@ -0,0 +1,329 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary drawing command list
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DrawCmd.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int16_t readInt16(const uint8_t* buffer);
+static uint16_t readUInt16(const uint8_t* buffer);
+static Color readColor(const uint8_t* buffer);
+static void executeCmd(YAGfx& gfx, YAGfxText& text, const uint8_t* cmd, const YAGfxBitmap* const* images);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Size of a color parameter in byte. */
+static const size_t COLOR_SIZE      = 3U;
+
+/** Size of a coordinate or size parameter in byte. */
+static const size_t COORD_SIZE      = 2U;
+
+/** Size of the text command without the characters in byte. */
+static const size_t TEXT_CMD_SIZE   = 1U + 2U * COORD_SIZE + COLOR_SIZE + 1U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+size_t DrawCmd::getCmdSize(const uint8_t* buffer, size_t size)
+{
+    size_t cmdSize = 0U;
+
+    if ((nullptr != buffer) &&
+        (0U < size))
+    {
+        switch(buffer[0U])
+        {
+        case OPCODE_FILL_SCREEN:
+            cmdSize = 1U + COLOR_SIZE;
+            break;
+
+        case OPCODE_FILL_RECT:
+        case OPCODE_DRAW_RECT:
+        case OPCODE_DRAW_LINE:
+            cmdSize = 1U + 4U * COORD_SIZE + COLOR_SIZE;
+            break;
+
+        case OPCODE_DRAW_PIXEL:
+        case OPCODE_SCROLL:
+            cmdSize = 1U + 2U * COORD_SIZE + COLOR_SIZE;
+            break;
+
+        case OPCODE_DRAW_TEXT:
+            if (TEXT_CMD_SIZE <= size)
+            {
+                cmdSize = TEXT_CMD_SIZE + buffer[TEXT_CMD_SIZE - 1U];
+            }
+            break;
+
+        case OPCODE_BLIT:
+            cmdSize = 1U + 2U * COORD_SIZE + 1U;
+            break;
+
+        default:
+            break;
+        }
+
+        /* Incomplete command? */
+        if (size < cmdSize)
+        {
+            cmdSize = 0U;
+        }
+    }
+
+    return cmdSize;
+}
+
+bool DrawCmd::validate(const uint8_t* buffer, size_t size, size_t imageCnt)
+{
+    bool    isValid = (nullptr != buffer) || (0U == size);
+    size_t  index   = 0U;
+
+    while((true == isValid) && (size > index))
+    {
+        size_t cmdSize = getCmdSize(&buffer[index], size - index);
+
+        if (0U == cmdSize)
+        {
+            isValid = false;
+        }
+        else
+        {
+            /* The referenced image must exist. */
+            if ((OPCODE_BLIT == buffer[index]) &&
+                (imageCnt <= buffer[index + cmdSize - 1U]))
+            {
+                isValid = false;
+            }
+
+            index += cmdSize;
+        }
+    }
+
+    return isValid;
+}
+
+bool DrawCmd::execute(YAGfx& gfx, YAGfxText& text, const uint8_t* buffer, size_t size, const YAGfxBitmap* const* images, size_t imageCnt)
+{
+    bool isSuccessful = validate(buffer, size, imageCnt);
+
+    if (true == isSuccessful)
+    {
+        size_t index = 0U;
+
+        while(size > index)
+        {
+            executeCmd(gfx, text, &buffer[index], images);
+            index += getCmdSize(&buffer[index], size - index);
+        }
+    }
+
+    return isSuccessful;
+}
+
+void DrawCmd::scroll(YAGfx& gfx, int16_t dx, int16_t dy, const Color& color)
+{
+    const int16_t   WIDTH   = static_cast<int16_t>(gfx.getWidth());
+    const int16_t   HEIGHT  = static_cast<int16_t>(gfx.getHeight());
+    int16_t         row     = 0;
+
+    /* The pixels are moved in place, therefore the iteration direction is
+     * against the scroll direction. This way no source pixel is overwritten,
+     * before it was moved.
+     */
+    for(row = 0; row < HEIGHT; ++row)
+    {
+        int16_t y       = (0 < dy) ? (HEIGHT - 1 - row) : row;
+        int16_t srcY    = y - dy;
+        int16_t column  = 0;
+
+        for(column = 0; column < WIDTH; ++column)
+        {
+            int16_t x       = (0 < dx) ? (WIDTH - 1 - column) : column;
+            int16_t srcX    = x - dx;
+
+            if ((0 <= srcX) &&
+                (WIDTH > srcX) &&
+                (0 <= srcY) &&
+                (HEIGHT > srcY))
+            {
+                gfx.drawPixel(x, y, gfx.getColor(srcX, srcY));
+            }
+            else
+            {
+                gfx.drawPixel(x, y, color);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Read a signed 16 bit value in little endian.
+ *
+ * @param[in] buffer    Buffer, where to read from.
+ *
+ * @return Value
+ */
+static int16_t readInt16(const uint8_t* buffer)
+{
+    return static_cast<int16_t>(readUInt16(buffer));
+}
+
+/**
+ * Read a unsigned 16 bit value in little endian.
+ *
+ * @param[in] buffer    Buffer, where to read from.
+ *
+ * @return Value
+ */
+static uint16_t readUInt16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0U]) | (static_cast<uint16_t>(buffer[1U]) << 8U);
+}
+
+/**
+ * Read a RGB888 color.
+ *
+ * @param[in] buffer    Buffer, where to read from.
+ *
+ * @return Color
+ */
+static Color readColor(const uint8_t* buffer)
+{
+    return Color(buffer[0U], buffer[1U], buffer[2U]);
+}
+
+/**
+ * Execute a single command, which must be valid.
+ *
+ * @param[in] gfx       Graphic interface, where to draw.
+ * @param[in] text      Text properties used by the text command.
+ * @param[in] cmd       Command
+ * @param[in] images    Images, addressed by the blit command.
+ */
+static void executeCmd(YAGfx& gfx, YAGfxText& text, const uint8_t* cmd, const YAGfxBitmap* const* images)
+{
+    const uint8_t* par = &cmd[1U];
+
+    switch(cmd[0U])
+    {
+    case DrawCmd::OPCODE_FILL_SCREEN:
+        gfx.fillScreen(readColor(&par[0U]));
+        break;
+
+    case DrawCmd::OPCODE_FILL_RECT:
+        gfx.fillRect(readInt16(&par[0U]), readInt16(&par[2U]), readUInt16(&par[4U]), readUInt16(&par[6U]), readColor(&par[8U]));
+        break;
+
+    case DrawCmd::OPCODE_DRAW_RECT:
+        gfx.drawRectangle(readInt16(&par[0U]), readInt16(&par[2U]), readUInt16(&par[4U]), readUInt16(&par[6U]), readColor(&par[8U]));
+        break;
+
+    case DrawCmd::OPCODE_DRAW_LINE:
+        gfx.drawLine(readInt16(&par[0U]), readInt16(&par[2U]), readInt16(&par[4U]), readInt16(&par[6U]), readColor(&par[8U]));
+        break;
+
+    case DrawCmd::OPCODE_DRAW_PIXEL:
+        gfx.drawPixel(readInt16(&par[0U]), readInt16(&par[2U]), readColor(&par[4U]));
+        break;
+
+    case DrawCmd::OPCODE_DRAW_TEXT:
+        {
+            char    str[DrawCmd::TEXT_LENGTH_MAX + 1U];
+            size_t  length  = par[7U];
+            size_t  idx     = 0U;
+            int16_t x       = readInt16(&par[0U]);
+            int16_t y       = readInt16(&par[2U]);
+
+            for(idx = 0U; idx < length; ++idx)
+            {
+                str[idx] = static_cast<char>(par[8U + idx]);
+            }
+            str[length] = '\0';
+
+            /* The position is the upper left corner, but the text cursor is on the baseline. */
+            text.setTextColor(readColor(&par[4U]));
+            text.setTextCursorPos(x, y + static_cast<int16_t>(text.getFont().getHeight()) - 1);
+            text.drawText(gfx, str);
+        }
+        break;
+
+    case DrawCmd::OPCODE_BLIT:
+        if (nullptr != images[par[4U]])
+        {
+            gfx.drawBitmap(readInt16(&par[0U]), readInt16(&par[2U]), *images[par[4U]]);
+        }
+        break;
+
+    case DrawCmd::OPCODE_SCROLL:
+        DrawCmd::scroll(gfx, readInt16(&par[0U]), readInt16(&par[2U]), readColor(&par[4U]));
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,144 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary drawing command list
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup draw_cmd
+ *
+ * @{
+ */
+
+#ifndef __DRAW_CMD_H__
+#define __DRAW_CMD_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <YAGfx.h>
+#include <YAGfxBitmap.h>
+#include <YAGfxText.h>
+
+/**
+ * Compact binary drawing command list, which is executed at once against
+ * a graphic interface.
+ *
+ * Every command starts with its opcode (1 byte), followed by its parameters.
+ * Coordinates are signed 16 bit, sizes are unsigned 16 bit and colors are
+ * RGB888 (3 byte: red, green, blue). All multi-byte values are little endian.
+ */
+namespace DrawCmd
+{
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Drawing command opcodes. */
+enum Opcode
+{
+    OPCODE_FILL_SCREEN = 1, /**< Fill screen: color */
+    OPCODE_FILL_RECT,       /**< Fill rectangle: x, y, width, height, color */
+    OPCODE_DRAW_RECT,       /**< Draw rectangle outline: x, y, width, height, color */
+    OPCODE_DRAW_LINE,       /**< Draw line: xs, ys, xe, ye, color */
+    OPCODE_DRAW_PIXEL,      /**< Draw pixel: x, y, color */
+    OPCODE_DRAW_TEXT,       /**< Draw text: x, y, color, length (1 byte), characters */
+    OPCODE_BLIT,            /**< Draw cached image: x, y, image id (1 byte) */
+    OPCODE_SCROLL,          /**< Scroll content: dx, dy, color of uncovered pixels */
+    OPCODE_MAX              /**< Number of opcodes */
+};
+
+/** Max. text length of a single text command. */
+static const size_t TEXT_LENGTH_MAX = 255U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Get the size of the command at the begin of the buffer.
+ *
+ * @param[in] buffer    Command list
+ * @param[in] size      Command list size in byte
+ *
+ * @return Command size in byte or 0 if the command is invalid or incomplete.
+ */
+size_t getCmdSize(const uint8_t* buffer, size_t size);
+
+/**
+ * Validate the whole command list, without drawing anything.
+ *
+ * @param[in] buffer    Command list
+ * @param[in] size      Command list size in byte
+ * @param[in] imageCnt  Number of available images for the blit command.
+ *
+ * @return If all commands are valid, it will return true otherwise false.
+ */
+bool validate(const uint8_t* buffer, size_t size, size_t imageCnt);
+
+/**
+ * Execute the command list. The command list is validated first, so an
+ * invalid command list doesn't draw anything.
+ *
+ * @param[in] gfx       Graphic interface, where to draw.
+ * @param[in] text      Text properties (font) used by the text command.
+ * @param[in] buffer    Command list
+ * @param[in] size      Command list size in byte
+ * @param[in] images    Images, addressed by the blit command. Entries may be nullptr.
+ * @param[in] imageCnt  Number of images
+ *
+ * @return If successful executed, it will return true otherwise false.
+ */
+bool execute(YAGfx& gfx, YAGfxText& text, const uint8_t* buffer, size_t size, const YAGfxBitmap* const* images, size_t imageCnt);
+
+/**
+ * Scroll the content of the graphic interface. Pixels which are uncovered
+ * are filled with the given color.
+ *
+ * @param[in] gfx   Graphic interface
+ * @param[in] dx    Horizontal distance in pixel, positive to the right.
+ * @param[in] dy    Vertical distance in pixel, positive downwards.
+ * @param[in] color Color of the uncovered pixels
+ */
+void scroll(YAGfx& gfx, int16_t dx, int16_t dy, const Color& color);
+
+}
+
+#endif  /* __DRAW_CMD_H__ */
+
+/** @} */
@@ -0,0 +1,287 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Drawing command list builder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DrawCmdList.h"
+
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+DrawCmdList::DrawCmdList() :
+    m_buffer(nullptr),
+    m_capacity(0U),
+    m_size(0U),
+    m_isOverflow(false)
+{
+}
+
+DrawCmdList::~DrawCmdList()
+{
+    release();
+}
+
+bool DrawCmdList::create(size_t capacity)
+{
+    release();
+
+    if (0U < capacity)
+    {
+        m_buffer = new(std::nothrow) uint8_t[capacity];
+
+        if (nullptr != m_buffer)
+        {
+            m_capacity = capacity;
+        }
+    }
+
+    return (nullptr != m_buffer);
+}
+
+void DrawCmdList::release()
+{
+    if (nullptr != m_buffer)
+    {
+        delete[] m_buffer;
+        m_buffer = nullptr;
+    }
+
+    m_capacity = 0U;
+    clear();
+}
+
+bool DrawCmdList::fillScreen(const Color& color)
+{
+    bool isSuccessful = begin(DrawCmd::OPCODE_FILL_SCREEN, 4U);
+
+    if (true == isSuccessful)
+    {
+        append(color);
+    }
+
+    return isSuccessful;
+}
+
+bool DrawCmdList::fillRect(int16_t x, int16_t y, uint16_t width, uint16_t height, const Color& color)
+{
+    bool isSuccessful = begin(DrawCmd::OPCODE_FILL_RECT, 12U);
+
+    if (true == isSuccessful)
+    {
+        append(static_cast<uint16_t>(x));
+        append(static_cast<uint16_t>(y));
+        append(width);
+        append(height);
+        append(color);
+    }
+
+    return isSuccessful;
+}
+
+bool DrawCmdList::drawRectangle(int16_t x, int16_t y, uint16_t width, uint16_t height, const Color& color)
+{
+    bool isSuccessful = begin(DrawCmd::OPCODE_DRAW_RECT, 12U);
+
+    if (true == isSuccessful)
+    {
+        append(static_cast<uint16_t>(x));
+        append(static_cast<uint16_t>(y));
+        append(width);
+        append(height);
+        append(color);
+    }
+
+    return isSuccessful;
+}
+
+bool DrawCmdList::drawLine(int16_t xs, int16_t ys, int16_t xe, int16_t ye, const Color& color)
+{
+    bool isSuccessful = begin(DrawCmd::OPCODE_DRAW_LINE, 12U);
+
+    if (true == isSuccessful)
+    {
+        append(static_cast<uint16_t>(xs));
+        append(static_cast<uint16_t>(ys));
+        append(static_cast<uint16_t>(xe));
+        append(static_cast<uint16_t>(ye));
+        append(color);
+    }
+
+    return isSuccessful;
+}
+
+bool DrawCmdList::drawPixel(int16_t x, int16_t y, const Color& color)
+{
+    bool isSuccessful = begin(DrawCmd::OPCODE_DRAW_PIXEL, 8U);
+
+    if (true == isSuccessful)
+    {
+        append(static_cast<uint16_t>(x));
+        append(static_cast<uint16_t>(y));
+        append(color);
+    }
+
+    return isSuccessful;
+}
+
+bool DrawCmdList::drawText(int16_t x, int16_t y, const Color& color, const char* text)
+{
+    bool isSuccessful = false;
+
+    if (nullptr != text)
+    {
+        size_t length = strlen(text);
+
+        if (DrawCmd::TEXT_LENGTH_MAX >= length)
+        {
+            isSuccessful = begin(DrawCmd::OPCODE_DRAW_TEXT, 9U + length);
+
+            if (true == isSuccessful)
+            {
+                append(static_cast<uint16_t>(x));
+                append(static_cast<uint16_t>(y));
+                append(color);
+                m_buffer[m_size] = static_cast<uint8_t>(length);
+                ++m_size;
+                memcpy(&m_buffer[m_size], text, length);
+                m_size += length;
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool DrawCmdList::blit(int16_t x, int16_t y, uint8_t imageId)
+{
+    bool isSuccessful = begin(DrawCmd::OPCODE_BLIT, 6U);
+
+    if (true == isSuccessful)
+    {
+        append(static_cast<uint16_t>(x));
+        append(static_cast<uint16_t>(y));
+        m_buffer[m_size] = imageId;
+        ++m_size;
+    }
+
+    return isSuccessful;
+}
+
+bool DrawCmdList::scroll(int16_t dx, int16_t dy, const Color& color)
+{
+    bool isSuccessful = begin(DrawCmd::OPCODE_SCROLL, 8U);
+
+    if (true == isSuccessful)
+    {
+        append(static_cast<uint16_t>(dx));
+        append(static_cast<uint16_t>(dy));
+        append(color);
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool DrawCmdList::begin(DrawCmd::Opcode opcode, size_t cmdSize)
+{
+    bool isSuccessful = false;
+
+    if ((nullptr == m_buffer) ||
+        ((m_capacity - m_size) < cmdSize))
+    {
+        m_isOverflow = true;
+    }
+    else
+    {
+        m_buffer[m_size] = static_cast<uint8_t>(opcode);
+        ++m_size;
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void DrawCmdList::append(uint16_t value)
+{
+    m_buffer[m_size + 0U] = static_cast<uint8_t>((value >> 0U) & 0xFFU);
+    m_buffer[m_size + 1U] = static_cast<uint8_t>((value >> 8U) & 0xFFU);
+    m_size += 2U;
+}
+
+void DrawCmdList::append(const Color& color)
+{
+    m_buffer[m_size + 0U] = color.getRed();
+    m_buffer[m_size + 1U] = color.getGreen();
+    m_buffer[m_size + 2U] = color.getBlue();
+    m_size += 3U;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
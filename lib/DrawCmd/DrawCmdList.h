@@ -0,0 +1,267 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Drawing command list builder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup draw_cmd
+ *
+ * @{
+ */
+
+#ifndef __DRAW_CMD_LIST_H__
+#define __DRAW_CMD_LIST_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <YAColor.h>
+
+#include "DrawCmd.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Builds a binary drawing command list in a buffer with fixed capacity.
+ * If a command doesn't fit into the remaining buffer, it is not added and
+ * the list is marked as overflowed.
+ */
+class DrawCmdList
+{
+public:
+
+    /**
+     * Constructs the command list without buffer.
+     */
+    DrawCmdList();
+
+    /**
+     * Destroys the command list.
+     */
+    ~DrawCmdList();
+
+    /**
+     * Allocate the buffer. A already allocated buffer is released before.
+     *
+     * @param[in] capacity  Buffer capacity in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool create(size_t capacity);
+
+    /**
+     * Release the buffer.
+     */
+    void release();
+
+    /**
+     * Remove all commands.
+     */
+    void clear()
+    {
+        m_size          = 0U;
+        m_isOverflow    = false;
+    }
+
+    /**
+     * Get the command list.
+     *
+     * @return Command list
+     */
+    const uint8_t* get() const
+    {
+        return m_buffer;
+    }
+
+    /**
+     * Get the command list size in byte.
+     *
+     * @return Command list size in byte
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Is at least one command rejected, because the buffer was full?
+     *
+     * @return If a command was rejected, it will return true otherwise false.
+     */
+    bool isOverflow() const
+    {
+        return m_isOverflow;
+    }
+
+    /**
+     * Add command to fill the whole screen.
+     *
+     * @param[in] color Color
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool fillScreen(const Color& color);
+
+    /**
+     * Add command to fill a rectangle.
+     *
+     * @param[in] x         Upper left x-coordinate
+     * @param[in] y         Upper left y-coordinate
+     * @param[in] width     Width in pixel
+     * @param[in] height    Height in pixel
+     * @param[in] color     Color
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool fillRect(int16_t x, int16_t y, uint16_t width, uint16_t height, const Color& color);
+
+    /**
+     * Add command to draw a rectangle outline.
+     *
+     * @param[in] x         Upper left x-coordinate
+     * @param[in] y         Upper left y-coordinate
+     * @param[in] width     Width in pixel
+     * @param[in] height    Height in pixel
+     * @param[in] color     Color
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool drawRectangle(int16_t x, int16_t y, uint16_t width, uint16_t height, const Color& color);
+
+    /**
+     * Add command to draw a line.
+     *
+     * @param[in] xs    Start x-coordinate
+     * @param[in] ys    Start y-coordinate
+     * @param[in] xe    End x-coordinate
+     * @param[in] ye    End y-coordinate
+     * @param[in] color Color
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool drawLine(int16_t xs, int16_t ys, int16_t xe, int16_t ye, const Color& color);
+
+    /**
+     * Add command to draw a single pixel.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Color
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool drawPixel(int16_t x, int16_t y, const Color& color);
+
+    /**
+     * Add command to draw a text, without format tags.
+     *
+     * @param[in] x     Upper left x-coordinate
+     * @param[in] y     Upper left y-coordinate
+     * @param[in] color Text color
+     * @param[in] text  Text with max. DrawCmd::TEXT_LENGTH_MAX characters.
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool drawText(int16_t x, int16_t y, const Color& color, const char* text);
+
+    /**
+     * Add command to draw a cached image.
+     *
+     * @param[in] x         Upper left x-coordinate
+     * @param[in] y         Upper left y-coordinate
+     * @param[in] imageId   Image id
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool blit(int16_t x, int16_t y, uint8_t imageId);
+
+    /**
+     * Add command to scroll the content.
+     *
+     * @param[in] dx    Horizontal distance in pixel, positive to the right.
+     * @param[in] dy    Vertical distance in pixel, positive downwards.
+     * @param[in] color Color of the uncovered pixels
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool scroll(int16_t dx, int16_t dy, const Color& color);
+
+private:
+
+    uint8_t*    m_buffer;       /**< Command list buffer */
+    size_t      m_capacity;     /**< Buffer capacity in byte */
+    size_t      m_size;         /**< Command list size in byte */
+    bool        m_isOverflow;   /**< Is a command rejected, because the buffer was full? */
+
+    /**
+     * Start a new command, if it fits into the buffer.
+     *
+     * @param[in] opcode    Opcode
+     * @param[in] cmdSize   Command size in byte, incl. opcode.
+     *
+     * @return If the command fits, it will return true otherwise false.
+     */
+    bool begin(DrawCmd::Opcode opcode, size_t cmdSize);
+
+    /**
+     * Append a 16 bit value in little endian.
+     *
+     * @param[in] value Value
+     */
+    void append(uint16_t value);
+
+    /**
+     * Append a RGB888 color.
+     *
+     * @param[in] color Color
+     */
+    void append(const Color& color);
+
+    DrawCmdList(const DrawCmdList& list);
+    DrawCmdList& operator=(const DrawCmdList& list);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DRAW_CMD_LIST_H__ */
+
+/** @} */
@@ -0,0 +1,358 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary display frame encoding
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DisplayFrame.h"
+
+#include <ColorDef.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeHeader(uint8_t* buffer, DisplayFrame::FrameType type, const DisplayFrame::FrameInfo& info);
+static size_t writePixel(uint8_t* buffer, DisplayFrame::ColorFormat format, uint32_t color);
+static size_t readPixel(const uint8_t* buffer, DisplayFrame::ColorFormat format, uint32_t& color);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+size_t DisplayFrame::getPixelSize(ColorFormat format)
+{
+    return (COLOR_FORMAT_RGB565 == format) ? 2U : 3U;
+}
+
+size_t DisplayFrame::getMaxFrameSize(const FrameInfo& info)
+{
+    return HEADER_SIZE + static_cast<size_t>(info.width) * info.height * getPixelSize(info.format);
+}
+
+size_t DisplayFrame::encodeKeyFrame(uint8_t* buffer, const FrameInfo& info, const uint32_t* framebuffer)
+{
+    const size_t    LENGTH      = static_cast<size_t>(info.width) * info.height;
+    size_t          frameSize   = HEADER_SIZE;
+    size_t          index       = 0U;
+
+    writeHeader(buffer, FRAME_TYPE_KEY, info);
+
+    for(index = 0U; index < LENGTH; ++index)
+    {
+        frameSize += writePixel(&buffer[frameSize], info.format, framebuffer[index]);
+    }
+
+    return frameSize;
+}
+
+size_t DisplayFrame::encodeDeltaFrame(uint8_t* buffer, size_t size, const FrameInfo& info, const uint32_t* framebuffer, const uint32_t* reference)
+{
+    const size_t    LENGTH          = static_cast<size_t>(info.width) * info.height;
+    const size_t    RUN_HEADER_SIZE = 4U;
+    const size_t    PIXEL_SIZE      = getPixelSize(info.format);
+    size_t          frameSize       = HEADER_SIZE;
+    size_t          index           = 0U;
+    bool            isAborted       = false;
+
+    if (HEADER_SIZE > size)
+    {
+        return 0U;
+    }
+
+    writeHeader(buffer, FRAME_TYPE_DELTA, info);
+
+    while((LENGTH > index) && (false == isAborted))
+    {
+        uint16_t    unchanged   = 0U;
+        uint16_t    changed     = 0U;
+        size_t      start       = 0U;
+
+        while((LENGTH > index) &&
+              (framebuffer[index] == reference[index]) &&
+              (UINT16_MAX > unchanged))
+        {
+            ++unchanged;
+            ++index;
+        }
+
+        /* Unchanged pixels at the end need no run. */
+        if (LENGTH > index)
+        {
+            start = index;
+
+            while((LENGTH > index) &&
+                  (framebuffer[index] != reference[index]) &&
+                  (UINT16_MAX > changed))
+            {
+                ++changed;
+                ++index;
+            }
+
+            /* A delta frame, which is larger than a key frame makes no sense. */
+            if (size < (frameSize + RUN_HEADER_SIZE + changed * PIXEL_SIZE))
+            {
+                isAborted = true;
+            }
+            else
+            {
+                buffer[frameSize + 0U] = static_cast<uint8_t>((unchanged >> 0U) & 0xffU);
+                buffer[frameSize + 1U] = static_cast<uint8_t>((unchanged >> 8U) & 0xffU);
+                buffer[frameSize + 2U] = static_cast<uint8_t>((changed >> 0U) & 0xffU);
+                buffer[frameSize + 3U] = static_cast<uint8_t>((changed >> 8U) & 0xffU);
+                frameSize += RUN_HEADER_SIZE;
+
+                while(index > start)
+                {
+                    frameSize += writePixel(&buffer[frameSize], info.format, framebuffer[start]);
+                    ++start;
+                }
+            }
+        }
+    }
+
+    if (true == isAborted)
+    {
+        frameSize = 0U;
+    }
+
+    return frameSize;
+}
+
+bool DisplayFrame::parseHeader(const uint8_t* buffer, size_t size, FrameType& type, FrameInfo& info)
+{
+    bool isValid = false;
+
+    if ((nullptr != buffer) &&
+        (HEADER_SIZE <= size) &&
+        (FRAME_TYPE_DELTA >= buffer[0U]) &&
+        (COLOR_FORMAT_MAX > buffer[1U]) &&
+        (SOURCE_MIRROR >= buffer[3U]))
+    {
+        type        = static_cast<FrameType>(buffer[0U]);
+        info.format = static_cast<ColorFormat>(buffer[1U]);
+        info.slotId = buffer[2U];
+        info.source = static_cast<Source>(buffer[3U]);
+        info.width  = static_cast<uint16_t>(buffer[4U]) | (static_cast<uint16_t>(buffer[5U]) << 8U);
+        info.height = static_cast<uint16_t>(buffer[6U]) | (static_cast<uint16_t>(buffer[7U]) << 8U);
+
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+bool DisplayFrame::decodeFrame(const uint8_t* buffer, size_t size, uint32_t* framebuffer, size_t length)
+{
+    FrameType   type        = FRAME_TYPE_KEY;
+    FrameInfo   info;
+    bool        isValid     = parseHeader(buffer, size, type, info);
+    size_t      pixelSize   = 0U;
+    size_t      offset      = HEADER_SIZE;
+    size_t      index       = 0U;
+
+    if ((false == isValid) ||
+        ((static_cast<size_t>(info.width) * info.height) != length))
+    {
+        return false;
+    }
+
+    pixelSize = getPixelSize(info.format);
+
+    if (FRAME_TYPE_KEY == type)
+    {
+        if ((HEADER_SIZE + length * pixelSize) != size)
+        {
+            isValid = false;
+        }
+        else
+        {
+            for(index = 0U; index < length; ++index)
+            {
+                offset += readPixel(&buffer[offset], info.format, framebuffer[index]);
+            }
+        }
+    }
+    else
+    {
+        const size_t RUN_HEADER_SIZE = 4U;
+
+        while((size > offset) && (true == isValid))
+        {
+            size_t  unchanged   = 0U;
+            size_t  changed     = 0U;
+
+            if (size < (offset + RUN_HEADER_SIZE))
+            {
+                isValid = false;
+            }
+            else
+            {
+                unchanged   = static_cast<size_t>(buffer[offset + 0U]) | (static_cast<size_t>(buffer[offset + 1U]) << 8U);
+                changed     = static_cast<size_t>(buffer[offset + 2U]) | (static_cast<size_t>(buffer[offset + 3U]) << 8U);
+                offset     += RUN_HEADER_SIZE;
+                index      += unchanged;
+
+                if ((length < (index + changed)) ||
+                    (size < (offset + changed * pixelSize)))
+                {
+                    isValid = false;
+                }
+                else
+                {
+                    while(0U < changed)
+                    {
+                        offset += readPixel(&buffer[offset], info.format, framebuffer[index]);
+                        ++index;
+                        --changed;
+                    }
+                }
+            }
+        }
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write the frame header.
+ *
+ * @param[out] buffer   Buffer, where to write the header.
+ * @param[in]  type     Frame type
+ * @param[in]  info     Frame information
+ */
+static void writeHeader(uint8_t* buffer, DisplayFrame::FrameType type, const DisplayFrame::FrameInfo& info)
+{
+    buffer[0U] = type;
+    buffer[1U] = info.format;
+    buffer[2U] = info.slotId;
+    buffer[3U] = info.source;
+    buffer[4U] = static_cast<uint8_t>((info.width >> 0U) & 0xffU);
+    buffer[5U] = static_cast<uint8_t>((info.width >> 8U) & 0xffU);
+    buffer[6U] = static_cast<uint8_t>((info.height >> 0U) & 0xffU);
+    buffer[7U] = static_cast<uint8_t>((info.height >> 8U) & 0xffU);
+}
+
+/**
+ * Write a single pixel in the given color format.
+ *
+ * @param[out] buffer   Buffer, where to write the pixel.
+ * @param[in]  format   Color format
+ * @param[in]  color    Color in RGB888 format
+ *
+ * @return Number of written bytes
+ */
+static size_t writePixel(uint8_t* buffer, DisplayFrame::ColorFormat format, uint32_t color)
+{
+    size_t written = 0U;
+
+    if (DisplayFrame::COLOR_FORMAT_RGB565 == format)
+    {
+        uint16_t color565 = ColorDef::convert888To565(color);
+
+        buffer[0U] = static_cast<uint8_t>((color565 >> 0U) & 0xffU);
+        buffer[1U] = static_cast<uint8_t>((color565 >> 8U) & 0xffU);
+        written = 2U;
+    }
+    else
+    {
+        buffer[0U] = ColorDef::getRed(color);
+        buffer[1U] = ColorDef::getGreen(color);
+        buffer[2U] = ColorDef::getBlue(color);
+        written = 3U;
+    }
+
+    return written;
+}
+
+/**
+ * Read a single pixel in the given color format.
+ *
+ * @param[in]  buffer   Buffer, where to read the pixel from.
+ * @param[in]  format   Color format
+ * @param[out] color    Color in RGB888 format
+ *
+ * @return Number of read bytes
+ */
+static size_t readPixel(const uint8_t* buffer, DisplayFrame::ColorFormat format, uint32_t& color)
+{
+    size_t read = 0U;
+
+    if (DisplayFrame::COLOR_FORMAT_RGB565 == format)
+    {
+        uint16_t color565 = static_cast<uint16_t>(buffer[0U]) | (static_cast<uint16_t>(buffer[1U]) << 8U);
+
+        color = ColorDef::convert565To888(color565);
+        read = 2U;
+    }
+    else
+    {
+        color = (static_cast<uint32_t>(buffer[0U]) << 16U) |
+                (static_cast<uint32_t>(buffer[1U]) << 8U) |
+                (static_cast<uint32_t>(buffer[2U]) << 0U);
+        read = 3U;
+    }
+
+    return read;
+}
@@ -0,0 +1,177 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary display frame encoding
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup frame_stream
+ *
+ * @{
+ */
+
+#ifndef __DISPLAY_FRAME_H__
+#define __DISPLAY_FRAME_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/** Binary display frame encoding, used to transfer display content via network. */
+namespace DisplayFrame
+{
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Color formats of the binary frame. */
+enum ColorFormat
+{
+    COLOR_FORMAT_RGB888 = 0,    /**< 3 byte per pixel: red, green, blue */
+    COLOR_FORMAT_RGB565,        /**< 2 byte per pixel in little endian */
+    COLOR_FORMAT_MAX            /**< Number of color formats */
+};
+
+/** Types of the binary frame. */
+enum FrameType
+{
+    FRAME_TYPE_KEY = 0, /**< All pixels */
+    FRAME_TYPE_DELTA    /**< Only the pixels, which changed since the reference frame. */
+};
+
+/** Source of the binary frame. */
+enum Source
+{
+    SOURCE_REQUEST = 0, /**< Response to a request. */
+    SOURCE_MIRROR       /**< Pushed to the display mirror subscribers. */
+};
+
+/** Information, which is part of the frame header. */
+struct FrameInfo
+{
+    ColorFormat format;     /**< Color format */
+    Source      source;     /**< Frame source */
+    uint8_t     slotId;     /**< Id of the slot, which is shown. */
+    uint16_t    width;      /**< Display width in pixel */
+    uint16_t    height;     /**< Display height in pixel */
+};
+
+/** Size of the binary frame header in byte. */
+static const size_t HEADER_SIZE = 8U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Get the pixel size in byte of the given color format.
+ *
+ * @param[in] format    Color format
+ *
+ * @return Pixel size in byte
+ */
+size_t getPixelSize(ColorFormat format);
+
+/**
+ * Get the max. frame size in byte, which is the size of a key frame.
+ *
+ * @param[in] info  Frame information
+ *
+ * @return Max. frame size in byte
+ */
+size_t getMaxFrameSize(const FrameInfo& info);
+
+/**
+ * Encode a key frame with all pixels.
+ *
+ * @param[out] buffer       Frame buffer, which must have at least the max. frame size.
+ * @param[in]  info         Frame information
+ * @param[in]  framebuffer  Pixels in RGB888 format, row by row.
+ *
+ * @return Frame size in byte
+ */
+size_t encodeKeyFrame(uint8_t* buffer, const FrameInfo& info, const uint32_t* framebuffer);
+
+/**
+ * Encode a delta frame with only the changed pixels, as sequence of runs.
+ * Every run consists of the number of unchanged pixels (16 bit), the number
+ * of changed pixels (16 bit) and the changed pixels.
+ *
+ * @param[out] buffer       Frame buffer
+ * @param[in]  size         Frame buffer size in byte
+ * @param[in]  info         Frame information
+ * @param[in]  framebuffer  Pixels in RGB888 format, row by row.
+ * @param[in]  reference    Reference pixels in RGB888 format, row by row.
+ *
+ * @return Frame size in byte or 0 if the delta frame doesn't fit into the buffer.
+ */
+size_t encodeDeltaFrame(uint8_t* buffer, size_t size, const FrameInfo& info, const uint32_t* framebuffer, const uint32_t* reference);
+
+/**
+ * Parse the frame header.
+ *
+ * @param[in]  buffer   Frame
+ * @param[in]  size     Frame size in byte
+ * @param[out] type     Frame type
+ * @param[out] info     Frame information
+ *
+ * @return If the header is valid, it will return true otherwise false.
+ */
+bool parseHeader(const uint8_t* buffer, size_t size, FrameType& type, FrameInfo& info);
+
+/**
+ * Decode a frame into the framebuffer. A key frame overwrites all pixels,
+ * a delta frame only the changed ones. Therefore the framebuffer must
+ * contain the reference frame of a delta frame.
+ *
+ * If the frame is invalid, the framebuffer may be partly changed.
+ *
+ * @param[in]     buffer        Frame
+ * @param[in]     size          Frame size in byte
+ * @param[in,out] framebuffer   Pixels in RGB888 format, row by row.
+ * @param[in]     length        Number of pixels in the framebuffer
+ *
+ * @return If successful decoded, it will return true otherwise false.
+ */
+bool decodeFrame(const uint8_t* buffer, size_t size, uint32_t* framebuffer, size_t length);
+
+}
+
+#endif  /* __DISPLAY_FRAME_H__ */
+
+/** @} */
@@ -0,0 +1,327 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Jitter buffer for display frames
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "JitterBuffer.h"
+#include "DisplayFrame.h"
+
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+JitterBuffer::JitterBuffer() :
+    m_width(0U),
+    m_height(0U),
+    m_length(0U),
+    m_slots(),
+    m_slotCnt(0U),
+    m_depth(0U),
+    m_holdTime(0U),
+    m_lastPush(0U),
+    m_head(0U),
+    m_count(0U),
+    m_reference(nullptr),
+    m_isReferenceValid(false),
+    m_lastSeqNum(0U),
+    m_statistics()
+{
+}
+
+JitterBuffer::~JitterBuffer()
+{
+    release();
+}
+
+bool JitterBuffer::init(uint16_t width, uint16_t height, uint8_t slotCnt, uint8_t depth, uint32_t holdTime)
+{
+    bool    isSuccessful    = true;
+    uint8_t idx             = 0U;
+
+    release();
+
+    if ((0U == width) ||
+        (0U == height) ||
+        (2U > slotCnt) ||
+        (SLOTS_MAX < slotCnt) ||
+        (0U == depth) ||
+        (slotCnt <= depth))
+    {
+        return false;
+    }
+
+    m_width     = width;
+    m_height    = height;
+    m_length    = static_cast<size_t>(width) * height;
+    m_slotCnt   = slotCnt;
+    m_depth     = depth;
+    m_holdTime  = holdTime;
+    m_reference = new(std::nothrow) uint32_t[m_length];
+
+    if (nullptr == m_reference)
+    {
+        isSuccessful = false;
+    }
+
+    for(idx = 0U; (idx < m_slotCnt) && (true == isSuccessful); ++idx)
+    {
+        m_slots[idx] = new(std::nothrow) uint32_t[m_length];
+
+        if (nullptr == m_slots[idx])
+        {
+            isSuccessful = false;
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        release();
+    }
+    else
+    {
+        reset();
+    }
+
+    return isSuccessful;
+}
+
+void JitterBuffer::release()
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0U; idx < SLOTS_MAX; ++idx)
+    {
+        if (nullptr != m_slots[idx])
+        {
+            delete[] m_slots[idx];
+            m_slots[idx] = nullptr;
+        }
+    }
+
+    if (nullptr != m_reference)
+    {
+        delete[] m_reference;
+        m_reference = nullptr;
+    }
+
+    m_width     = 0U;
+    m_height    = 0U;
+    m_length    = 0U;
+    m_slotCnt   = 0U;
+
+    reset();
+
+    return;
+}
+
+void JitterBuffer::reset()
+{
+    m_head              = 0U;
+    m_count             = 0U;
+    m_isReferenceValid  = false;
+    m_lastSeqNum        = 0U;
+
+    return;
+}
+
+JitterBuffer::Result JitterBuffer::push(uint16_t seqNum, const uint8_t* frame, size_t size, uint32_t timestamp)
+{
+    Result                  result  = RESULT_OK;
+    DisplayFrame::FrameType type    = DisplayFrame::FRAME_TYPE_KEY;
+    DisplayFrame::FrameInfo info;
+
+    ++m_statistics.received;
+
+    if ((nullptr == m_reference) ||
+        (false == DisplayFrame::parseHeader(frame, size, type, info)) ||
+        (m_width != info.width) ||
+        (m_height != info.height))
+    {
+        result = RESULT_INVALID;
+    }
+    else if (true == m_isReferenceValid)
+    {
+        /* The sequence number wraps around, therefore the distance is signed. */
+        int16_t distance = static_cast<int16_t>(static_cast<uint16_t>(seqNum - m_lastSeqNum));
+
+        if (0 == distance)
+        {
+            result = RESULT_DUPLICATE;
+        }
+        else if (0 > distance)
+        {
+            /* A key frame long ago is considered as restart of the stream. */
+            if ((DisplayFrame::FRAME_TYPE_KEY != type) ||
+                (-static_cast<int32_t>(RESTART_THRESHOLD) < distance))
+            {
+                result = RESULT_LATE;
+            }
+        }
+        else if ((DisplayFrame::FRAME_TYPE_DELTA == type) &&
+                 (1 != distance))
+        {
+            /* The reference of the delta frame was lost. */
+            m_isReferenceValid  = false;
+            result              = RESULT_NO_REFERENCE;
+        }
+        else
+        {
+            ;
+        }
+    }
+    else if (DisplayFrame::FRAME_TYPE_DELTA == type)
+    {
+        result = RESULT_NO_REFERENCE;
+    }
+    else
+    {
+        ;
+    }
+
+    if (RESULT_OK == result)
+    {
+        if (false == DisplayFrame::decodeFrame(frame, size, m_reference, m_length))
+        {
+            /* The reference may be partly overwritten. */
+            m_isReferenceValid  = false;
+            result              = RESULT_INVALID;
+        }
+        else
+        {
+            m_isReferenceValid  = true;
+            m_lastSeqNum        = seqNum;
+            m_lastPush          = timestamp;
+
+            /* Buffer full? Drop the oldest frame. */
+            if (m_slotCnt == m_count)
+            {
+                m_head = (m_head + 1U) % m_slotCnt;
+                --m_count;
+                ++m_statistics.dropped;
+            }
+
+            (void)memcpy(m_slots[(m_head + m_count) % m_slotCnt], m_reference, m_length * sizeof(uint32_t));
+            ++m_count;
+        }
+    }
+
+    switch(result)
+    {
+    case RESULT_OK:
+        break;
+
+    case RESULT_DUPLICATE:
+        ++m_statistics.duplicate;
+        break;
+
+    case RESULT_LATE:
+        ++m_statistics.late;
+        break;
+
+    case RESULT_INVALID:
+        /* fallthrough */
+    case RESULT_NO_REFERENCE:
+        /* fallthrough */
+    default:
+        ++m_statistics.dropped;
+        break;
+    }
+
+    return result;
+}
+
+const uint32_t* JitterBuffer::pop(uint32_t timestamp)
+{
+    const uint32_t* pixels = nullptr;
+
+    /* Nothing to present or wait for more frames to compensate the jitter? */
+    if ((0U == m_count) ||
+        ((m_depth > m_count) && (m_holdTime > (timestamp - m_lastPush))))
+    {
+        return nullptr;
+    }
+
+    /* Skip the oldest frames to keep the latency low. */
+    while(m_depth < m_count)
+    {
+        m_head = (m_head + 1U) % m_slotCnt;
+        --m_count;
+        ++m_statistics.dropped;
+    }
+
+    pixels = m_slots[m_head];
+    m_head = (m_head + 1U) % m_slotCnt;
+    --m_count;
+    ++m_statistics.presented;
+
+    return pixels;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
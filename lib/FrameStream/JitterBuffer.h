@@ -0,0 +1,228 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Jitter buffer for display frames
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup frame_stream
+ *
+ * @{
+ */
+
+#ifndef __JITTER_BUFFER_H__
+#define __JITTER_BUFFER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The jitter buffer receives display frames with a sequence number and
+ * presents them one by one. All frame slots are allocated once, so no heap
+ * memory is used while streaming.
+ *
+ * A frame is presented, if the configured number of frames (depth) is
+ * buffered, which compensates the network jitter. If no further frame is
+ * received within the hold time, the buffered frames are presented anyway,
+ * e.g. at the end of a stream. If more frames than the depth are buffered,
+ * the oldest ones are skipped to keep the latency low.
+ *
+ * The jitter buffer is not thread-safe.
+ */
+class JitterBuffer
+{
+public:
+
+    /** Result of pushing a frame into the jitter buffer. */
+    enum Result
+    {
+        RESULT_OK = 0,          /**< Frame is buffered. */
+        RESULT_INVALID,         /**< Frame is invalid or doesn't fit to the display size. */
+        RESULT_DUPLICATE,       /**< Frame was already received. */
+        RESULT_LATE,            /**< A newer frame was already received. */
+        RESULT_NO_REFERENCE     /**< Delta frame without reference, a key frame is needed. */
+    };
+
+    /** Jitter buffer counters */
+    struct Statistics
+    {
+        uint32_t    received;   /**< Number of received frames */
+        uint32_t    presented;  /**< Number of presented frames */
+        uint32_t    late;       /**< Number of frames, which were received after a newer one. */
+        uint32_t    dropped;    /**< Number of frames, which were invalid, had no reference or were skipped. */
+        uint32_t    duplicate;  /**< Number of frames, which were received more than once. */
+
+        /**
+         * Constructs the statistics with all counters reset.
+         */
+        Statistics() :
+            received(0U),
+            presented(0U),
+            late(0U),
+            dropped(0U),
+            duplicate(0U)
+        {
+        }
+    };
+
+    /** Max. number of frame slots. */
+    static const uint8_t    SLOTS_MAX           = 8U;
+
+    /**
+     * A key frame, which is older than this number of frames, is considered
+     * as restart of the stream.
+     */
+    static const uint16_t   RESTART_THRESHOLD   = 64U;
+
+    /**
+     * Constructs the jitter buffer without memory.
+     */
+    JitterBuffer();
+
+    /**
+     * Destroys the jitter buffer.
+     */
+    ~JitterBuffer();
+
+    /**
+     * Allocate the frame slots. A already allocated jitter buffer is released before.
+     *
+     * @param[in] width     Frame width in pixel
+     * @param[in] height    Frame height in pixel
+     * @param[in] slotCnt   Number of frame slots [2; SLOTS_MAX]
+     * @param[in] depth     Number of frames, which are buffered before presentation [1; slotCnt - 1]
+     * @param[in] holdTime  Max. time in ms, a frame is hold back to reach the depth.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool init(uint16_t width, uint16_t height, uint8_t slotCnt, uint8_t depth, uint32_t holdTime);
+
+    /**
+     * Release all frame slots.
+     */
+    void release();
+
+    /**
+     * Discard all buffered frames and the reference. The counters are kept.
+     */
+    void reset();
+
+    /**
+     * Push a frame into the jitter buffer. If the buffer is full, the
+     * oldest frame is dropped.
+     *
+     * @param[in] seqNum    Sequence number of the frame
+     * @param[in] frame     Frame (see DisplayFrame)
+     * @param[in] size      Frame size in byte
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return Result
+     */
+    Result push(uint16_t seqNum, const uint8_t* frame, size_t size, uint32_t timestamp);
+
+    /**
+     * Get the next frame, which shall be presented. Call it once per
+     * display refresh.
+     *
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return Pixels in RGB888 format, row by row or nullptr if there is no new frame.
+     * The pixels are valid until the next call to push() or pop().
+     */
+    const uint32_t* pop(uint32_t timestamp);
+
+    /**
+     * Get number of buffered frames.
+     *
+     * @return Number of buffered frames
+     */
+    uint8_t getCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Get the counters.
+     *
+     * @return Statistics
+     */
+    const Statistics& getStatistics() const
+    {
+        return m_statistics;
+    }
+
+    /**
+     * Reset all counters.
+     */
+    void resetStatistics()
+    {
+        m_statistics = Statistics();
+    }
+
+private:
+
+    uint16_t    m_width;                /**< Frame width in pixel */
+    uint16_t    m_height;               /**< Frame height in pixel */
+    size_t      m_length;               /**< Number of pixels per frame */
+    uint32_t*   m_slots[SLOTS_MAX];     /**< Frame slots */
+    uint8_t     m_slotCnt;              /**< Number of frame slots */
+    uint8_t     m_depth;                /**< Number of frames, which are buffered before presentation. */
+    uint32_t    m_holdTime;             /**< Max. time in ms, a frame is hold back to reach the depth. */
+    uint32_t    m_lastPush;             /**< Timestamp in ms of the last buffered frame */
+    uint8_t     m_head;                 /**< Slot index of the oldest frame */
+    uint8_t     m_count;                /**< Number of buffered frames */
+    uint32_t*   m_reference;            /**< Last received frame, which is the reference for the next delta frame. */
+    bool        m_isReferenceValid;     /**< Is the reference valid? */
+    uint16_t    m_lastSeqNum;           /**< Sequence number of the reference */
+    Statistics  m_statistics;           /**< Counters */
+
+    JitterBuffer(const JitterBuffer& buffer);
+    JitterBuffer& operator=(const JitterBuffer& buffer);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __JITTER_BUFFER_H__ */
+
+/** @} */
@@ -0,0 +1,232 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Loopback test sender for display frames
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "LoopbackSender.h"
+#include "StreamPacket.h"
+
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+LoopbackSender::LoopbackSender() :
+    m_sendFunc(),
+    m_info(),
+    m_uid(0U),
+    m_seqNum(0U),
+    m_keyFrameInterval(0U),
+    m_frameCnt(0U),
+    m_length(0U),
+    m_reference(nullptr),
+    m_isReferenceValid(false),
+    m_packetBufferSize(0U),
+    m_packet(nullptr),
+    m_packetSize(0U)
+{
+}
+
+LoopbackSender::~LoopbackSender()
+{
+    release();
+}
+
+bool LoopbackSender::init(uint16_t uid, uint16_t width, uint16_t height, DisplayFrame::ColorFormat format, uint16_t keyFrameInterval)
+{
+    bool isSuccessful = true;
+
+    release();
+
+    m_info.format       = format;
+    m_info.source       = DisplayFrame::SOURCE_REQUEST;
+    m_info.slotId       = 0U;
+    m_info.width        = width;
+    m_info.height       = height;
+    m_uid               = uid;
+    m_keyFrameInterval  = keyFrameInterval;
+    m_length            = static_cast<size_t>(width) * height;
+    m_packetBufferSize  = StreamPacket::HEADER_SIZE + DisplayFrame::getMaxFrameSize(m_info);
+    m_reference         = new(std::nothrow) uint32_t[m_length];
+    m_packet            = new(std::nothrow) uint8_t[m_packetBufferSize];
+
+    if ((nullptr == m_reference) ||
+        (nullptr == m_packet))
+    {
+        release();
+        isSuccessful = false;
+    }
+
+    return isSuccessful;
+}
+
+void LoopbackSender::release()
+{
+    if (nullptr != m_reference)
+    {
+        delete[] m_reference;
+        m_reference = nullptr;
+    }
+
+    if (nullptr != m_packet)
+    {
+        delete[] m_packet;
+        m_packet = nullptr;
+    }
+
+    m_length            = 0U;
+    m_packetBufferSize  = 0U;
+    m_packetSize        = 0U;
+    m_isReferenceValid  = false;
+
+    return;
+}
+
+size_t LoopbackSender::encode(const uint32_t* framebuffer)
+{
+    uint8_t*    frame       = nullptr;
+    size_t      frameSize   = 0U;
+
+    if ((nullptr == m_packet) ||
+        (nullptr == framebuffer))
+    {
+        return 0U;
+    }
+
+    frame = &m_packet[StreamPacket::HEADER_SIZE];
+
+    if ((0U < m_keyFrameInterval) &&
+        (m_keyFrameInterval <= m_frameCnt))
+    {
+        m_isReferenceValid = false;
+    }
+
+    if (true == m_isReferenceValid)
+    {
+        frameSize = DisplayFrame::encodeDeltaFrame(frame, m_packetBufferSize - StreamPacket::HEADER_SIZE, m_info, framebuffer, m_reference);
+        ++m_frameCnt;
+    }
+
+    /* Delta frame not possible or bigger than a key frame? */
+    if (0U == frameSize)
+    {
+        frameSize   = DisplayFrame::encodeKeyFrame(frame, m_info, framebuffer);
+        m_frameCnt  = 1U;
+    }
+
+    (void)StreamPacket::writeHeader(m_packet, m_uid, m_seqNum);
+    (void)memcpy(m_reference, framebuffer, m_length * sizeof(uint32_t));
+
+    m_isReferenceValid  = true;
+    m_packetSize        = StreamPacket::HEADER_SIZE + frameSize;
+    ++m_seqNum;
+
+    return m_packetSize;
+}
+
+bool LoopbackSender::send()
+{
+    bool isSuccessful = false;
+
+    if ((0U < m_packetSize) &&
+        (nullptr != m_sendFunc))
+    {
+        m_sendFunc(m_packet, m_packetSize);
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void LoopbackSender::drawTestPattern(uint32_t* framebuffer, uint16_t width, uint16_t height, uint32_t frameNo)
+{
+    const uint32_t  BACKGROUND  = 0x000010U;
+    const uint32_t  FOREGROUND  = 0xffffffU;
+    uint16_t        x           = 0U;
+    uint16_t        y           = 0U;
+
+    for(y = 0U; y < height; ++y)
+    {
+        for(x = 0U; x < width; ++x)
+        {
+            uint32_t color = BACKGROUND;
+
+            if (((x + y) % width) == (frameNo % width))
+            {
+                color = FOREGROUND;
+            }
+
+            framebuffer[y * width + x] = color;
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,213 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Loopback test sender for display frames
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup frame_stream
+ *
+ * @{
+ */
+
+#ifndef __LOOPBACK_SENDER_H__
+#define __LOOPBACK_SENDER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+#include "DisplayFrame.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The loopback sender encodes display frames as stream packets, like a
+ * streaming host does. The packets are handed over to a send function
+ * instead of the network, which allows to exercise the receiver without
+ * network, e.g. in the native test environment.
+ *
+ * Encoding and sending are separated, so network effects can be simulated:
+ * - Lost packet: Encode a frame without sending it.
+ * - Duplicate packet: Send the same packet twice.
+ * - Reordered packets: Keep a copy of the packet and send it later.
+ */
+class LoopbackSender
+{
+public:
+
+    /**
+     * Prototype of the send function.
+     *
+     * @param[in] packet    Stream packet
+     * @param[in] size      Stream packet size in byte
+     */
+    typedef std::function<void(const uint8_t* packet, size_t size)> SendFunc;
+
+    /**
+     * Constructs the loopback sender without memory.
+     */
+    LoopbackSender();
+
+    /**
+     * Destroys the loopback sender.
+     */
+    ~LoopbackSender();
+
+    /**
+     * Allocate the frame buffers. A already allocated sender is released before.
+     *
+     * @param[in] uid               Plugin UID, which is the receiver.
+     * @param[in] width             Frame width in pixel
+     * @param[in] height            Frame height in pixel
+     * @param[in] format            Color format
+     * @param[in] keyFrameInterval  Every n-th frame is a key frame. Use 0 to send only the first one as key frame.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool init(uint16_t uid, uint16_t width, uint16_t height, DisplayFrame::ColorFormat format, uint16_t keyFrameInterval);
+
+    /**
+     * Release all frame buffers.
+     */
+    void release();
+
+    /**
+     * Set the send function, which receives the stream packets.
+     *
+     * @param[in] sendFunc  Send function
+     */
+    void setSendFunc(const SendFunc& sendFunc)
+    {
+        m_sendFunc = sendFunc;
+    }
+
+    /**
+     * Set the sequence number of the next frame.
+     *
+     * @param[in] seqNum    Sequence number
+     */
+    void setSeqNum(uint16_t seqNum)
+    {
+        m_seqNum = seqNum;
+    }
+
+    /**
+     * Force a key frame as next frame.
+     */
+    void forceKeyFrame()
+    {
+        m_isReferenceValid = false;
+    }
+
+    /**
+     * Encode the next frame as stream packet. A delta frame is used if
+     * possible, otherwise a key frame.
+     *
+     * @param[in] framebuffer   Pixels in RGB888 format, row by row.
+     *
+     * @return Stream packet size in byte or 0 if not initialized.
+     */
+    size_t encode(const uint32_t* framebuffer);
+
+    /**
+     * Send the last encoded stream packet.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool send();
+
+    /**
+     * Get the last encoded stream packet.
+     *
+     * @return Stream packet
+     */
+    const uint8_t* getPacket() const
+    {
+        return m_packet;
+    }
+
+    /**
+     * Get the size of the last encoded stream packet.
+     *
+     * @return Stream packet size in byte
+     */
+    size_t getPacketSize() const
+    {
+        return m_packetSize;
+    }
+
+    /**
+     * Draw a test pattern: a diagonal line, which moves one pixel per frame
+     * over a dark background.
+     *
+     * @param[out] framebuffer  Pixels in RGB888 format, row by row.
+     * @param[in]  width        Frame width in pixel
+     * @param[in]  height       Frame height in pixel
+     * @param[in]  frameNo      Frame number
+     */
+    static void drawTestPattern(uint32_t* framebuffer, uint16_t width, uint16_t height, uint32_t frameNo);
+
+private:
+
+    SendFunc                    m_sendFunc;         /**< Send function */
+    DisplayFrame::FrameInfo     m_info;             /**< Frame information */
+    uint16_t                    m_uid;              /**< Plugin UID */
+    uint16_t                    m_seqNum;           /**< Sequence number of the next frame */
+    uint16_t                    m_keyFrameInterval; /**< Every n-th frame is a key frame. */
+    uint16_t                    m_frameCnt;         /**< Number of frames since the last key frame */
+    size_t                      m_length;           /**< Number of pixels per frame */
+    uint32_t*                   m_reference;        /**< Last encoded frame */
+    bool                        m_isReferenceValid; /**< Is the reference valid? */
+    size_t                      m_packetBufferSize; /**< Stream packet buffer size in byte */
+    uint8_t*                    m_packet;           /**< Stream packet buffer */
+    size_t                      m_packetSize;       /**< Size of the last encoded stream packet in byte */
+
+    LoopbackSender(const LoopbackSender& sender);
+    LoopbackSender& operator=(const LoopbackSender& sender);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LOOPBACK_SENDER_H__ */
+
+/** @} */
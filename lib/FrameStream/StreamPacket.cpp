@@ -0,0 +1,103 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Stream packet, which carries a display frame
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "StreamPacket.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+size_t StreamPacket::writeHeader(uint8_t* buffer, uint16_t uid, uint16_t seqNum)
+{
+    buffer[0U] = static_cast<uint8_t>((uid >> 0U) & 0xffU);
+    buffer[1U] = static_cast<uint8_t>((uid >> 8U) & 0xffU);
+    buffer[2U] = static_cast<uint8_t>((seqNum >> 0U) & 0xffU);
+    buffer[3U] = static_cast<uint8_t>((seqNum >> 8U) & 0xffU);
+
+    return HEADER_SIZE;
+}
+
+bool StreamPacket::parse(const uint8_t* buffer, size_t size, uint16_t& uid, uint16_t& seqNum, const uint8_t*& frame, size_t& frameSize)
+{
+    bool isValid = false;
+
+    if ((nullptr != buffer) &&
+        (HEADER_SIZE < size))
+    {
+        uid         = static_cast<uint16_t>(buffer[0U]) | (static_cast<uint16_t>(buffer[1U]) << 8U);
+        seqNum      = static_cast<uint16_t>(buffer[2U]) | (static_cast<uint16_t>(buffer[3U]) << 8U);
+        frame       = &buffer[HEADER_SIZE];
+        frameSize   = size - HEADER_SIZE;
+        isValid     = true;
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,103 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Stream packet, which carries a display frame
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup frame_stream
+ *
+ * @{
+ */
+
+#ifndef __STREAM_PACKET_H__
+#define __STREAM_PACKET_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * A stream packet carries a single display frame (see DisplayFrame) to a
+ * plugin. It starts with a 4 byte header, all values are little endian:
+ * - Byte 0-1: Plugin UID
+ * - Byte 2-3: Sequence number, which is incremented with every frame.
+ */
+namespace StreamPacket
+{
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Size of the stream packet header in byte. */
+static const size_t HEADER_SIZE = 4U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Write the stream packet header.
+ *
+ * @param[out] buffer   Buffer, which must have at least the header size.
+ * @param[in]  uid      Plugin UID
+ * @param[in]  seqNum   Sequence number
+ *
+ * @return Header size in byte
+ */
+size_t writeHeader(uint8_t* buffer, uint16_t uid, uint16_t seqNum);
+
+/**
+ * Parse a stream packet.
+ *
+ * @param[in]  buffer       Stream packet
+ * @param[in]  size         Stream packet size in byte
+ * @param[out] uid          Plugin UID
+ * @param[out] seqNum       Sequence number
+ * @param[out] frame        Display frame
+ * @param[out] frameSize    Display frame size in byte
+ *
+ * @return If the stream packet is valid, it will return true otherwise false.
+ */
+bool parse(const uint8_t* buffer, size_t size, uint16_t& uid, uint16_t& seqNum, const uint8_t*& frame, size_t& frameSize);
+
+}
+
+#endif  /* __STREAM_PACKET_H__ */
+
+/** @} */
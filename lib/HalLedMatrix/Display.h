@@ -200,6 +200,42 @@ public:
         return m_ledMatrix.getColor(x, y);
     }
 
+    /**
+     * Copy the framebuffer row by row in RGB888 format, which is much faster
+     * than reading pixel by pixel via getColor().
+     *
+     * @param[out] buffer   Buffer, which will be filled.
+     * @param[in]  length   Buffer length in number of pixels.
+     *
+     * @return Number of copied pixels
+     */
+    size_t readFramebuffer(uint32_t* buffer, size_t length) const final
+    {
+        const Color*    pixels  = m_ledMatrix.get();
+        size_t          count   = static_cast<size_t>(m_ledMatrix.getWidth()) * m_ledMatrix.getHeight();
+        size_t          idx     = 0U;
+
+        if (nullptr == buffer)
+        {
+            count = 0U;
+        }
+        else if (length < count)
+        {
+            count = length;
+        }
+        else
+        {
+            ;
+        }
+
+        for(idx = 0U; idx < count; ++idx)
+        {
+            buffer[idx] = pixels[idx];
+        }
+
+        return count;
+    }
+
 private:
 
     /** Pixel representation of the LED matrix */
@@ -183,6 +183,23 @@ public:
         return isSuccessful;
     }
 
+    /**
+     * Get the number of items, which are currently stored in the queue.
+     * 
+     * @return Number of items
+     */
+    size_t getItemCount() const
+    {
+        size_t itemCount = 0U;
+
+        if (nullptr != m_queueHandle)
+        {
+            itemCount = static_cast<size_t>(uxQueueMessagesWaiting(m_queueHandle));
+        }
+
+        return itemCount;
+    }
+
 private:
 
     QueueHandle_t   m_queueHandle;  /**< Queue handle */
@@ -0,0 +1,512 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Connection pool
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __CONNECTION_POOL_HPP__
+#define __CONNECTION_POOL_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Bookkeeping of connections, which are kept alive to be used by the next
+ * request to the same host. A connection is identified by host, port and
+ * whether it is secure. Every connection is either in use by a owner or
+ * idle. Idle connections expire after the idle timeout.
+ * The number of connections per host and in total is limited.
+ *
+ * The pool neither creates nor destroys the connections, this is up to the
+ * user. It is not thread-safe.
+ *
+ * @tparam TConn    Connection type
+ * @tparam TOwner   Connection owner type
+ * @tparam maxConns Max. number of connections in total
+ */
+template < typename TConn, typename TOwner, size_t maxConns >
+class ConnectionPool
+{
+public:
+
+    /** Max. host name size in byte, incl. string termination. */
+    static const size_t HOST_SIZE_MAX   = 64U;
+
+    /**
+     * Constructs a empty connection pool.
+     *
+     * @param[in] maxConnsPerHost   Max. number of connections per host.
+     * @param[in] idleTimeout       Idle timeout in ms.
+     */
+    ConnectionPool(size_t maxConnsPerHost, uint32_t idleTimeout) :
+        m_slots(),
+        m_maxConnsPerHost(maxConnsPerHost),
+        m_idleTimeout(idleTimeout)
+    {
+    }
+
+    /**
+     * Destroys the connection pool.
+     */
+    ~ConnectionPool()
+    {
+    }
+
+    /**
+     * Take a idle connection to the host. The connection is in use by the
+     * owner afterwards.
+     *
+     * @param[in] host      Host name
+     * @param[in] port      Port
+     * @param[in] isSecure  Secure connection or not
+     * @param[in] owner     New connection owner
+     *
+     * @return If a idle connection is available, it will be returned otherwise nullptr.
+     */
+    TConn* acquireIdle(const char* host, uint16_t port, bool isSecure, TOwner* owner)
+    {
+        TConn*  conn    = nullptr;
+        size_t  idx     = 0U;
+
+        while((maxConns > idx) && (nullptr == conn))
+        {
+            Slot& slot = m_slots[idx];
+
+            if ((nullptr != slot.conn) &&
+                (true == slot.isIdle) &&
+                (true == isKeyEqual(slot, host, port, isSecure)))
+            {
+                slot.isIdle = false;
+                slot.owner  = owner;
+                conn        = slot.conn;
+            }
+
+            ++idx;
+        }
+
+        return conn;
+    }
+
+    /**
+     * Add a new connection, which is in use by the owner.
+     *
+     * @param[in] conn      Connection
+     * @param[in] host      Host name
+     * @param[in] port      Port
+     * @param[in] isSecure  Secure connection or not
+     * @param[in] owner     Connection owner
+     *
+     * @return If the connection limits are not reached, it will return true otherwise false.
+     */
+    bool add(TConn* conn, const char* host, uint16_t port, bool isSecure, TOwner* owner)
+    {
+        bool    isSuccessful    = false;
+        Slot*   freeSlot        = nullptr;
+        size_t  hostCnt         = 0U;
+        size_t  idx             = 0U;
+
+        if ((nullptr == conn) ||
+            (nullptr == host) ||
+            (HOST_SIZE_MAX <= strlen(host)))
+        {
+            return false;
+        }
+
+        for(idx = 0U; idx < maxConns; ++idx)
+        {
+            Slot& slot = m_slots[idx];
+
+            if (nullptr == slot.conn)
+            {
+                if (nullptr == freeSlot)
+                {
+                    freeSlot = &slot;
+                }
+            }
+            else if (true == isKeyEqual(slot, host, port, isSecure))
+            {
+                ++hostCnt;
+            }
+        }
+
+        if ((nullptr != freeSlot) &&
+            (m_maxConnsPerHost > hostCnt))
+        {
+            freeSlot->conn      = conn;
+            freeSlot->owner     = owner;
+            freeSlot->port      = port;
+            freeSlot->isSecure  = isSecure;
+            freeSlot->isIdle    = false;
+            freeSlot->timestamp = 0U;
+            strcpy(freeSlot->host, host);
+
+            isSuccessful = true;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Release a connection, which is in use. It becomes idle and can be
+     * taken by the next request to the same host.
+     *
+     * @param[in] conn      Connection
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool release(TConn* conn, uint32_t timestamp)
+    {
+        Slot* slot = findSlot(conn);
+
+        if (nullptr == slot)
+        {
+            return false;
+        }
+
+        slot->isIdle    = true;
+        slot->owner     = nullptr;
+        slot->timestamp = timestamp;
+
+        return true;
+    }
+
+    /**
+     * Detach the owner from all its connections. The connections stay in
+     * the pool without owner, until they are removed.
+     *
+     * @param[in] owner Connection owner
+     */
+    void detach(const TOwner* owner)
+    {
+        size_t idx = 0U;
+
+        for(idx = 0U; idx < maxConns; ++idx)
+        {
+            if ((nullptr != m_slots[idx].conn) &&
+                (owner == m_slots[idx].owner))
+            {
+                m_slots[idx].owner = nullptr;
+            }
+        }
+    }
+
+    /**
+     * Remove a connection from the pool, e.g. because it is closed.
+     *
+     * @param[in] conn  Connection
+     *
+     * @return If the connection was in the pool, it will return true otherwise false.
+     */
+    bool remove(const TConn* conn)
+    {
+        Slot* slot = findSlot(conn);
+
+        if (nullptr == slot)
+        {
+            return false;
+        }
+
+        slot->conn  = nullptr;
+        slot->owner = nullptr;
+
+        return true;
+    }
+
+    /**
+     * Get the owner of a connection.
+     *
+     * @param[in] conn  Connection
+     *
+     * @return Owner or nullptr, if the connection is idle or unknown.
+     */
+    TOwner* getOwner(const TConn* conn)
+    {
+        Slot*   slot    = findSlot(conn);
+        TOwner* owner   = nullptr;
+
+        if (nullptr != slot)
+        {
+            owner = slot->owner;
+        }
+
+        return owner;
+    }
+
+    /**
+     * Get the host name a connection is established to.
+     *
+     * @param[in] conn  Connection
+     *
+     * @return Host name or nullptr, if the connection is unknown.
+     */
+    const char* getHost(const TConn* conn)
+    {
+        Slot*       slot    = findSlot(conn);
+        const char* host    = nullptr;
+
+        if (nullptr != slot)
+        {
+            host = slot->host;
+        }
+
+        return host;
+    }
+
+    /**
+     * Is the connection in the pool?
+     *
+     * @param[in] conn  Connection
+     *
+     * @return If the connection is in the pool, it will return true otherwise false.
+     */
+    bool isKnown(const TConn* conn)
+    {
+        return (nullptr != findSlot(conn));
+    }
+
+    /**
+     * Is the connection idle?
+     *
+     * @param[in] conn  Connection
+     *
+     * @return If the connection is idle, it will return true otherwise false.
+     */
+    bool isIdle(const TConn* conn)
+    {
+        Slot* slot = findSlot(conn);
+
+        return ((nullptr != slot) && (true == slot->isIdle));
+    }
+
+    /**
+     * Is the connection idle for longer than the idle timeout?
+     *
+     * @param[in] conn      Connection
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If the connection idle time expired, it will return true otherwise false.
+     */
+    bool isIdleExpired(const TConn* conn, uint32_t timestamp)
+    {
+        Slot* slot = findSlot(conn);
+
+        return ((nullptr != slot) &&
+                (true == slot->isIdle) &&
+                (m_idleTimeout <= (timestamp - slot->timestamp)));
+    }
+
+    /**
+     * Get the connection, which is idle for the longest time.
+     *
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return Connection or nullptr, if no connection is idle.
+     */
+    TConn* getOldestIdle(uint32_t timestamp)
+    {
+        TConn*      conn        = nullptr;
+        uint32_t    maxIdleTime = 0U;
+        size_t      idx         = 0U;
+
+        for(idx = 0U; idx < maxConns; ++idx)
+        {
+            const Slot& slot = m_slots[idx];
+
+            if ((nullptr != slot.conn) &&
+                (true == slot.isIdle))
+            {
+                uint32_t idleTime = timestamp - slot.timestamp;
+
+                if ((nullptr == conn) ||
+                    (maxIdleTime < idleTime))
+                {
+                    conn        = slot.conn;
+                    maxIdleTime = idleTime;
+                }
+            }
+        }
+
+        return conn;
+    }
+
+    /**
+     * Get number of connections in the pool.
+     *
+     * @return Number of connections
+     */
+    size_t getCount() const
+    {
+        size_t  cnt = 0U;
+        size_t  idx = 0U;
+
+        for(idx = 0U; idx < maxConns; ++idx)
+        {
+            if (nullptr != m_slots[idx].conn)
+            {
+                ++cnt;
+            }
+        }
+
+        return cnt;
+    }
+
+    /**
+     * Get number of idle connections in the pool.
+     *
+     * @return Number of idle connections
+     */
+    size_t getIdleCount() const
+    {
+        size_t  cnt = 0U;
+        size_t  idx = 0U;
+
+        for(idx = 0U; idx < maxConns; ++idx)
+        {
+            if ((nullptr != m_slots[idx].conn) &&
+                (true == m_slots[idx].isIdle))
+            {
+                ++cnt;
+            }
+        }
+
+        return cnt;
+    }
+
+private:
+
+    /** A single pool entry. */
+    struct Slot
+    {
+        TConn*      conn;                   /**< Connection, nullptr if the slot is free. */
+        TOwner*     owner;                  /**< Owner of the connection, nullptr if idle or detached. */
+        char        host[HOST_SIZE_MAX];    /**< Host name */
+        uint16_t    port;                   /**< Port */
+        bool        isSecure;               /**< Secure connection or not */
+        bool        isIdle;                 /**< Is connection idle? */
+        uint32_t    timestamp;              /**< Timestamp in ms, when the connection became idle. */
+
+        /**
+         * Constructs a free slot.
+         */
+        Slot() :
+            conn(nullptr),
+            owner(nullptr),
+            host(),
+            port(0U),
+            isSecure(false),
+            isIdle(false),
+            timestamp(0U)
+        {
+        }
+    };
+
+    Slot        m_slots[maxConns];  /**< Pool entries */
+    size_t      m_maxConnsPerHost;  /**< Max. number of connections per host */
+    uint32_t    m_idleTimeout;      /**< Idle timeout in ms */
+
+    ConnectionPool();
+    ConnectionPool(const ConnectionPool& pool);
+    ConnectionPool& operator=(const ConnectionPool& pool);
+
+    /**
+     * Find the slot of a connection.
+     *
+     * @param[in] conn  Connection
+     *
+     * @return Slot or nullptr, if not found.
+     */
+    Slot* findSlot(const TConn* conn)
+    {
+        Slot*   slot    = nullptr;
+        size_t  idx     = 0U;
+
+        if (nullptr == conn)
+        {
+            return nullptr;
+        }
+
+        while((maxConns > idx) && (nullptr == slot))
+        {
+            if (conn == m_slots[idx].conn)
+            {
+                slot = &m_slots[idx];
+            }
+
+            ++idx;
+        }
+
+        return slot;
+    }
+
+    /**
+     * Is the slot key equal to the given key?
+     *
+     * @param[in] slot      Slot
+     * @param[in] host      Host name
+     * @param[in] port      Port
+     * @param[in] isSecure  Secure connection or not
+     *
+     * @return If equal, it will return true otherwise false.
+     */
+    static bool isKeyEqual(const Slot& slot, const char* host, uint16_t port, bool isSecure)
+    {
+        return (port == slot.port) &&
+               (isSecure == slot.isSecure) &&
+               (nullptr != host) &&
+               (0 == strcmp(host, slot.host));
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __CONNECTION_POOL_HPP__ */
+
+/** @} */
@@ -0,0 +1,281 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DnsCache.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+DnsCache::DnsCache() :
+    m_entries(),
+    m_usageCounter(0U)
+{
+    clear();
+}
+
+DnsCache::Result DnsCache::lookup(const char* host, uint32_t timestamp, uint32_t& address)
+{
+    Result  result  = RESULT_MISS;
+    Entry*  entry   = find(host);
+
+    if (nullptr != entry)
+    {
+        /* A expired entry is removed, which forces a new resolution. */
+        if (true == isExpired(*entry, timestamp))
+        {
+            entry->result = RESULT_MISS;
+        }
+        else
+        {
+            ++m_usageCounter;
+            entry->lastUsed = m_usageCounter;
+
+            result  = entry->result;
+            address = entry->address;
+        }
+    }
+
+    return result;
+}
+
+bool DnsCache::setPending(const char* host, uint32_t timeout, uint32_t timestamp)
+{
+    return set(host, RESULT_PENDING, 0U, timeout, timestamp);
+}
+
+bool DnsCache::setResolved(const char* host, uint32_t address, uint32_t ttl, uint32_t timestamp)
+{
+    return set(host, RESULT_RESOLVED, address, ttl, timestamp);
+}
+
+bool DnsCache::setFailed(const char* host, uint32_t ttl, uint32_t timestamp)
+{
+    return set(host, RESULT_FAILED, 0U, ttl, timestamp);
+}
+
+void DnsCache::remove(const char* host)
+{
+    Entry* entry = find(host);
+
+    if (nullptr != entry)
+    {
+        entry->result = RESULT_MISS;
+    }
+}
+
+void DnsCache::clear()
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+    {
+        m_entries[idx].host[0]  = '\0';
+        m_entries[idx].result   = RESULT_MISS;
+    }
+
+    m_usageCounter = 0U;
+}
+
+uint8_t DnsCache::getCount() const
+{
+    uint8_t count   = 0U;
+    uint8_t idx     = 0U;
+
+    for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+    {
+        if (RESULT_MISS != m_entries[idx].result)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool DnsCache::set(const char* host, Result result, uint32_t address, uint32_t ttl, uint32_t timestamp)
+{
+    bool    isSuccessful    = false;
+    Entry*  entry           = nullptr;
+
+    if ((nullptr != host) &&
+        ('\0' != host[0]) &&
+        (HOST_SIZE_MAX > strlen(host)))
+    {
+        entry = find(host);
+
+        if (nullptr == entry)
+        {
+            uint8_t idx = 0U;
+
+            /* Prefer a free or expired entry. */
+            while((MAX_ENTRIES > idx) && (nullptr == entry))
+            {
+                if ((RESULT_MISS == m_entries[idx].result) ||
+                    (true == isExpired(m_entries[idx], timestamp)))
+                {
+                    entry = &m_entries[idx];
+                }
+
+                ++idx;
+            }
+
+            /* Otherwise replace the least recently used one. */
+            if (nullptr == entry)
+            {
+                entry = &m_entries[0];
+
+                for(idx = 1U; idx < MAX_ENTRIES; ++idx)
+                {
+                    if (entry->lastUsed > m_entries[idx].lastUsed)
+                    {
+                        entry = &m_entries[idx];
+                    }
+                }
+            }
+
+            strcpy(entry->host, host);
+        }
+
+        ++m_usageCounter;
+
+        entry->result       = result;
+        entry->address      = address;
+        entry->timestamp    = timestamp;
+        entry->ttl          = ttl;
+        entry->lastUsed     = m_usageCounter;
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+DnsCache::Entry* DnsCache::find(const char* host)
+{
+    Entry*  entry   = nullptr;
+    uint8_t idx     = 0U;
+
+    if (nullptr != host)
+    {
+        while((MAX_ENTRIES > idx) && (nullptr == entry))
+        {
+            if ((RESULT_MISS != m_entries[idx].result) &&
+                (true == isHostEqual(m_entries[idx].host, host)))
+            {
+                entry = &m_entries[idx];
+            }
+
+            ++idx;
+        }
+    }
+
+    return entry;
+}
+
+bool DnsCache::isExpired(const Entry& entry, uint32_t timestamp)
+{
+    /* Considers the timestamp overflow. */
+    return (entry.ttl <= (timestamp - entry.timestamp));
+}
+
+bool DnsCache::isHostEqual(const char* host1, const char* host2)
+{
+    size_t  idx     = 0U;
+    bool    isEqual = true;
+
+    while ((true == isEqual) &&
+           (('\0' != host1[idx]) || ('\0' != host2[idx])))
+    {
+        char c1 = host1[idx];
+        char c2 = host2[idx];
+
+        if (('A' <= c1) && ('Z' >= c1))
+        {
+            c1 = c1 - 'A' + 'a';
+        }
+
+        if (('A' <= c2) && ('Z' >= c2))
+        {
+            c2 = c2 - 'A' + 'a';
+        }
+
+        if (c1 != c2)
+        {
+            isEqual = false;
+        }
+
+        ++idx;
+    }
+
+    return isEqual;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,236 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __DNS_CACHE_H__
+#define __DNS_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Caches the result of host name resolutions (host name to IPv4 address).
+ *
+ * - A resolved address is valid for its time to live.
+ * - A failed resolution is cached too (negative caching), which avoids to
+ *   ask the DNS server again and again for a host, which doesn't exist.
+ * - A pending resolution is marked, which avoids parallel requests for the
+ *   same host.
+ *
+ * If the cache is full, the least recently used entry is replaced.
+ * The cache is not thread-safe and works with timestamps provided by the
+ * caller.
+ */
+class DnsCache
+{
+public:
+
+    /** Lookup result */
+    enum Result
+    {
+        RESULT_MISS = 0,    /**< Host is unknown or its entry expired. */
+        RESULT_PENDING,     /**< Resolution is pending. */
+        RESULT_RESOLVED,    /**< Host is resolved. */
+        RESULT_FAILED       /**< Resolution failed. */
+    };
+
+    /** Max. number of cached hosts */
+    static const uint8_t    MAX_ENTRIES     = 8U;
+
+    /** Max. host name size in byte, incl. string termination. */
+    static const size_t     HOST_SIZE_MAX   = 64U;
+
+    /**
+     * Constructs a empty DNS cache.
+     */
+    DnsCache();
+
+    /**
+     * Destroys the DNS cache.
+     */
+    ~DnsCache()
+    {
+    }
+
+    /**
+     * Lookup a host name. The host name is compared case-insensitive.
+     *
+     * @param[in]   host        Host name
+     * @param[in]   timestamp   Current timestamp in ms
+     * @param[out]  address     IPv4 address in network byte order, only valid if resolved.
+     *
+     * @return Lookup result
+     */
+    Result lookup(const char* host, uint32_t timestamp, uint32_t& address);
+
+    /**
+     * Mark the resolution of a host as pending.
+     *
+     * @param[in] host      Host name
+     * @param[in] timeout   Time in ms, after the pending resolution is considered as lost.
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setPending(const char* host, uint32_t timeout, uint32_t timestamp);
+
+    /**
+     * Set the resolved address of a host.
+     *
+     * @param[in] host      Host name
+     * @param[in] address   IPv4 address in network byte order
+     * @param[in] ttl       Time to live in ms
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setResolved(const char* host, uint32_t address, uint32_t ttl, uint32_t timestamp);
+
+    /**
+     * Set the resolution of a host as failed.
+     *
+     * @param[in] host      Host name
+     * @param[in] ttl       Time to live in ms of the negative entry
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setFailed(const char* host, uint32_t ttl, uint32_t timestamp);
+
+    /**
+     * Remove a host, e.g. because its address is not reachable anymore.
+     *
+     * @param[in] host  Host name
+     */
+    void remove(const char* host);
+
+    /**
+     * Remove all hosts.
+     */
+    void clear();
+
+    /**
+     * Get number of cached hosts, including the expired ones.
+     *
+     * @return Number of cached hosts
+     */
+    uint8_t getCount() const;
+
+private:
+
+    /**
+     * A single cached host.
+     */
+    struct Entry
+    {
+        char        host[HOST_SIZE_MAX];    /**< Host name */
+        Result      result;                 /**< Result, RESULT_MISS means unused entry. */
+        uint32_t    address;                /**< IPv4 address in network byte order */
+        uint32_t    timestamp;              /**< Timestamp in ms, when the entry was set. */
+        uint32_t    ttl;                    /**< Time to live in ms */
+        uint32_t    lastUsed;               /**< Usage counter value of the last access */
+    };
+
+    Entry       m_entries[MAX_ENTRIES]; /**< Cached hosts */
+    uint32_t    m_usageCounter;         /**< Incremented with every access, used for the replacement strategy. */
+
+    DnsCache(const DnsCache& cache);
+    DnsCache& operator=(const DnsCache& cache);
+
+    /**
+     * Set a entry of a host. Either the existing entry is updated or
+     * a new one is used.
+     *
+     * @param[in] host      Host name
+     * @param[in] result    Result
+     * @param[in] address   IPv4 address in network byte order
+     * @param[in] ttl       Time to live in ms
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool set(const char* host, Result result, uint32_t address, uint32_t ttl, uint32_t timestamp);
+
+    /**
+     * Find the entry of a host.
+     *
+     * @param[in] host  Host name
+     *
+     * @return Entry or nullptr, if not found.
+     */
+    Entry* find(const char* host);
+
+    /**
+     * Is the entry expired?
+     *
+     * @param[in] entry     Entry
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If expired, it will return true otherwise false.
+     */
+    static bool isExpired(const Entry& entry, uint32_t timestamp);
+
+    /**
+     * Compare two host names case-insensitive.
+     *
+     * @param[in] host1 Host name
+     * @param[in] host2 Host name
+     *
+     * @return If equal, it will return true otherwise false.
+     */
+    static bool isHostEqual(const char* host1, const char* host2);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DNS_CACHE_H__ */
+
+/** @} */
@@ -0,0 +1,211 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Growing buffer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GrowBuffer.h"
+
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+GrowBuffer& GrowBuffer::operator=(const GrowBuffer& buffer)
+{
+    if (this != &buffer)
+    {
+        clear();
+
+        m_maxSize = buffer.m_maxSize;
+
+        if ((0U < buffer.m_size) &&
+            (true == reallocate(buffer.m_size)))
+        {
+            memcpy(m_buffer, buffer.m_buffer, buffer.m_size);
+            m_size = buffer.m_size;
+        }
+    }
+
+    return *this;
+}
+
+void GrowBuffer::clear()
+{
+    if (nullptr != m_buffer)
+    {
+        delete[] m_buffer;
+        m_buffer = nullptr;
+    }
+
+    m_size      = 0U;
+    m_capacity  = 0U;
+}
+
+bool GrowBuffer::take(GrowBuffer& buffer)
+{
+    bool isSuccessful = false;
+
+    if ((this != &buffer) &&
+        (m_maxSize >= buffer.m_capacity))
+    {
+        clear();
+
+        m_buffer            = buffer.m_buffer;
+        m_size              = buffer.m_size;
+        m_capacity          = buffer.m_capacity;
+
+        buffer.m_buffer     = nullptr;
+        buffer.m_size       = 0U;
+        buffer.m_capacity   = 0U;
+
+        isSuccessful        = true;
+    }
+
+    return isSuccessful;
+}
+
+bool GrowBuffer::reserve(size_t capacity)
+{
+    bool isSuccessful = true;
+
+    if (m_maxSize < capacity)
+    {
+        isSuccessful = false;
+    }
+    else if (m_capacity < capacity)
+    {
+        isSuccessful = reallocate(capacity);
+    }
+
+    return isSuccessful;
+}
+
+bool GrowBuffer::append(const uint8_t* data, size_t size)
+{
+    bool isSuccessful = true;
+
+    if ((nullptr == data) ||
+        ((m_maxSize - m_size) < size))
+    {
+        isSuccessful = false;
+    }
+    else if ((m_capacity - m_size) < size)
+    {
+        size_t  needed      = m_size + size;
+        size_t  capacity    = m_capacity;
+
+        if (MIN_CAPACITY > capacity)
+        {
+            capacity = MIN_CAPACITY;
+        }
+
+        while(needed > capacity)
+        {
+            capacity *= 2U;
+        }
+
+        if (m_maxSize < capacity)
+        {
+            capacity = m_maxSize;
+        }
+
+        isSuccessful = reallocate(capacity);
+    }
+
+    if ((true == isSuccessful) &&
+        (0U < size))
+    {
+        memcpy(&m_buffer[m_size], data, size);
+        m_size += size;
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool GrowBuffer::reallocate(size_t capacity)
+{
+    bool        isSuccessful    = false;
+    uint8_t*    buffer          = new(std::nothrow) uint8_t[capacity];
+
+    if (nullptr != buffer)
+    {
+        if (nullptr != m_buffer)
+        {
+            memcpy(buffer, m_buffer, m_size);
+            delete[] m_buffer;
+        }
+
+        m_buffer        = buffer;
+        m_capacity      = capacity;
+        isSuccessful    = true;
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
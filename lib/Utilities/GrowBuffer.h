@@ -0,0 +1,221 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Growing buffer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __GROW_BUFFER_H__
+#define __GROW_BUFFER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A contiguous byte buffer, which grows while data is appended.
+ * The capacity is doubled every time it runs out of space, so appending
+ * N bytes in several parts costs amortized O(N) copy effort instead of
+ * O(N^2) with a buffer which grows by the appended size only.
+ * The capacity never exceeds the configured max. size.
+ */
+class GrowBuffer
+{
+public:
+
+    /** Default max. size in byte. */
+    static const size_t DEFAULT_MAX_SIZE    = 65536U;
+
+    /** Min. capacity in byte, which is allocated at once. */
+    static const size_t MIN_CAPACITY        = 256U;
+
+    /**
+     * Constructs a empty buffer.
+     *
+     * @param[in] maxSize   Max. size in byte
+     */
+    GrowBuffer(size_t maxSize = DEFAULT_MAX_SIZE) :
+        m_buffer(nullptr),
+        m_size(0U),
+        m_capacity(0U),
+        m_maxSize(maxSize)
+    {
+    }
+
+    /**
+     * Destroys the buffer.
+     */
+    ~GrowBuffer()
+    {
+        clear();
+    }
+
+    /**
+     * Constructs a buffer by copying another buffer.
+     *
+     * @param[in] buffer    Buffer, which to copy.
+     */
+    GrowBuffer(const GrowBuffer& buffer) :
+        m_buffer(nullptr),
+        m_size(0U),
+        m_capacity(0U),
+        m_maxSize(buffer.m_maxSize)
+    {
+        *this = buffer;
+    }
+
+    /**
+     * Assign a buffer.
+     * Only the used part of the other buffer is copied.
+     *
+     * @param[in] buffer    Buffer, which to assign.
+     *
+     * @return Buffer
+     */
+    GrowBuffer& operator=(const GrowBuffer& buffer);
+
+    /**
+     * Release the buffer memory.
+     */
+    void clear();
+
+    /**
+     * Take over the memory of another buffer without copying, e.g. to hand
+     * received data over to another task. The own memory is released before
+     * and the other buffer is empty afterwards.
+     *
+     * @param[in] buffer    Buffer, which memory to take over.
+     *
+     * @return If successful, it will return true. If the data of the other
+     *          buffer exceeds the own max. size, it will return false.
+     */
+    bool take(GrowBuffer& buffer);
+
+    /**
+     * Reserve memory for at least the given capacity. Use it if the
+     * final size is known in advance, e.g. by the HTTP "Content-Length".
+     * It will never shrink the buffer.
+     *
+     * @param[in] capacity  Capacity in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool reserve(size_t capacity);
+
+    /**
+     * Append data to the buffer. If necessary the capacity is doubled.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool append(const uint8_t* data, size_t size);
+
+    /**
+     * Get the buffer data.
+     *
+     * @return Buffer data. If the buffer is empty, it may be nullptr.
+     */
+    const uint8_t* getData() const
+    {
+        return m_buffer;
+    }
+
+    /**
+     * Get number of used bytes in the buffer.
+     *
+     * @return Used size in byte
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Get buffer capacity.
+     *
+     * @return Capacity in byte
+     */
+    size_t getCapacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * Get the max. size, which the buffer can grow to.
+     *
+     * @return Max. size in byte
+     */
+    size_t getMaxSize() const
+    {
+        return m_maxSize;
+    }
+
+private:
+
+    uint8_t*    m_buffer;   /**< Buffer */
+    size_t      m_size;     /**< Used size in byte */
+    size_t      m_capacity; /**< Capacity in byte */
+    size_t      m_maxSize;  /**< Max. size in byte */
+
+    /**
+     * Reallocate the buffer with the given capacity.
+     * The used part is kept.
+     *
+     * @param[in] capacity  New capacity in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool reallocate(size_t capacity);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GROW_BUFFER_H__ */
+
+/** @} */
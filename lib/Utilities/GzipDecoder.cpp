@@ -0,0 +1,1019 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming gzip decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GzipDecoder.h"
+
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of length symbols */
+static const uint8_t    LENGTH_SYMBOLS          = 29U;
+
+/** Base lengths of the length symbols 257..285 */
+static const uint16_t   LENGTH_BASE[LENGTH_SYMBOLS] =
+{
+    3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 13U, 15U, 17U, 19U, 23U, 27U, 31U,
+    35U, 43U, 51U, 59U, 67U, 83U, 99U, 115U, 131U, 163U, 195U, 227U, 258U
+};
+
+/** Number of extra bits of the length symbols 257..285 */
+static const uint8_t    LENGTH_EXTRA[LENGTH_SYMBOLS] =
+{
+    0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U, 1U, 1U, 1U, 2U, 2U, 2U, 2U,
+    3U, 3U, 3U, 3U, 4U, 4U, 4U, 4U, 5U, 5U, 5U, 5U, 0U
+};
+
+/** Number of distance symbols */
+static const uint8_t    DISTANCE_SYMBOLS        = 30U;
+
+/** Base distances of the distance symbols */
+static const uint16_t   DISTANCE_BASE[DISTANCE_SYMBOLS] =
+{
+    1U, 2U, 3U, 4U, 5U, 7U, 9U, 13U, 17U, 25U, 33U, 49U, 65U, 97U, 129U, 193U,
+    257U, 385U, 513U, 769U, 1025U, 1537U, 2049U, 3073U, 4097U, 6145U,
+    8193U, 12289U, 16385U, 24577U
+};
+
+/** Number of extra bits of the distance symbols */
+static const uint8_t    DISTANCE_EXTRA[DISTANCE_SYMBOLS] =
+{
+    0U, 0U, 0U, 0U, 1U, 1U, 2U, 2U, 3U, 3U, 4U, 4U, 5U, 5U, 6U, 6U,
+    7U, 7U, 8U, 8U, 9U, 9U, 10U, 10U, 11U, 11U, 12U, 12U, 13U, 13U
+};
+
+/** Order of the code length code lengths in a dynamic block header */
+static const uint8_t    CODE_LENGTH_ORDER[]     =
+{
+    16U, 17U, 18U, 0U, 8U, 7U, 9U, 6U, 10U, 5U, 11U, 4U, 12U, 3U, 13U, 2U, 14U, 1U, 15U
+};
+
+/** CRC32 (polynom 0xEDB88320) table, used to process 4 bit at once. */
+static const uint32_t   CRC32_TABLE[]           =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+    0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+    0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+GzipDecoder::GzipDecoder(size_t windowSize) :
+    m_windowSize(windowSize),
+    m_window(nullptr),
+    m_windowPos(0U),
+    m_outputPos(0U),
+    m_outputSize(0U),
+    m_isWindowFull(false),
+    m_crc(0U),
+    m_state(STATE_HEADER),
+    m_input(nullptr),
+    m_inputSize(0U),
+    m_inputIndex(0U),
+    m_bitBuffer(0U),
+    m_bitCount(0U),
+    m_flags(0U),
+    m_bytes(),
+    m_count(0U),
+    m_remaining(0U),
+    m_isFinalBlock(false),
+    m_nlen(0U),
+    m_ndist(0U),
+    m_ncode(0U),
+    m_lengths(),
+    m_repeatSymbol(0U),
+    m_lencodeSymbols(),
+    m_distcodeSymbols(),
+    m_lencode(),
+    m_distcode(),
+    m_symbol(0U),
+    m_length(0U),
+    m_onData(nullptr)
+{
+    /* The window size must be a power of two. */
+    if ((MIN_WINDOW_SIZE > m_windowSize) ||
+        (MAX_WINDOW_SIZE < m_windowSize) ||
+        (0U != (m_windowSize & (m_windowSize - 1U))))
+    {
+        m_windowSize = MAX_WINDOW_SIZE;
+    }
+
+    m_lencode.symbol    = m_lencodeSymbols;
+    m_distcode.symbol   = m_distcodeSymbols;
+}
+
+void GzipDecoder::reset()
+{
+    m_windowPos     = 0U;
+    m_outputPos     = 0U;
+    m_outputSize    = 0U;
+    m_isWindowFull  = false;
+    m_crc           = 0U;
+    m_state         = STATE_HEADER;
+    m_bitBuffer     = 0U;
+    m_bitCount      = 0U;
+    m_flags         = 0U;
+    m_count         = 0U;
+    m_remaining     = 0U;
+    m_isFinalBlock  = false;
+}
+
+void GzipDecoder::release()
+{
+    reset();
+
+    if (nullptr != m_window)
+    {
+        delete[] m_window;
+        m_window = nullptr;
+    }
+}
+
+bool GzipDecoder::decode(const uint8_t* data, size_t size, const OnData& onData)
+{
+    if (STATE_DONE == m_state)
+    {
+        /* Any data after the stream is ignored. */
+        return true;
+    }
+
+    if ((STATE_ERROR != m_state) &&
+        (nullptr == m_window))
+    {
+        m_window = new(std::nothrow) uint8_t[m_windowSize];
+
+        if (nullptr == m_window)
+        {
+            m_state = STATE_ERROR;
+        }
+    }
+
+    if (STATE_ERROR != m_state)
+    {
+        m_input         = data;
+        m_inputSize     = (nullptr == data) ? 0U : size;
+        m_inputIndex    = 0U;
+        m_onData        = &onData;
+
+        while((STATE_DONE != m_state) &&
+              (STATE_ERROR != m_state) &&
+              (true == step()))
+        {
+            ;
+        }
+
+        /* Provide the decoded data of this part. */
+        flush();
+
+        m_input         = nullptr;
+        m_inputSize     = 0U;
+        m_inputIndex    = 0U;
+        m_onData        = nullptr;
+    }
+
+    return (STATE_ERROR != m_state);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool GzipDecoder::needBits(uint8_t need)
+{
+    while((need > m_bitCount) &&
+          (m_inputSize > m_inputIndex))
+    {
+        m_bitBuffer |= static_cast<uint32_t>(m_input[m_inputIndex]) << m_bitCount;
+        m_bitCount += 8U;
+        ++m_inputIndex;
+    }
+
+    return (need <= m_bitCount);
+}
+
+uint32_t GzipDecoder::getBits(uint8_t cnt)
+{
+    uint32_t bits = m_bitBuffer & ((1U << cnt) - 1U);
+
+    m_bitBuffer >>= cnt;
+    m_bitCount -= cnt;
+
+    return bits;
+}
+
+bool GzipDecoder::decodeSymbol(const Huffman& huffman, uint16_t& symbol)
+{
+    bool    isDecoded   = false;
+    int32_t code        = 0;    /* Code bits read so far */
+    int32_t first       = 0;    /* First code of the current length */
+    int32_t index       = 0;    /* Index of the first code of the current length in the symbol table */
+    uint8_t len         = 1U;
+
+    /* The code may be shorter, therefore take what is available. */
+    (void)needBits(MAX_BITS);
+
+    while((false == isDecoded) &&
+          (MAX_BITS >= len) &&
+          (m_bitCount >= len))
+    {
+        int32_t count = huffman.count[len];
+
+        code |= static_cast<int32_t>((m_bitBuffer >> (len - 1U)) & 1U);
+
+        if (count > (code - first))
+        {
+            symbol = huffman.symbol[index + (code - first)];
+            (void)getBits(len);
+            isDecoded = true;
+        }
+        else
+        {
+            index   += count;
+            first   += count;
+            first   <<= 1;
+            code    <<= 1;
+            ++len;
+        }
+    }
+
+    /* Code is not part of the Huffman code? */
+    if (MAX_BITS < len)
+    {
+        m_state = STATE_ERROR;
+    }
+
+    return isDecoded;
+}
+
+bool GzipDecoder::buildHuffman(Huffman& huffman, const uint8_t* lengths, uint16_t cnt)
+{
+    uint16_t    offsets[MAX_BITS + 1U];
+    int32_t     left                    = 1;    /* Number of possible codes left of the current length */
+    uint16_t    idx                     = 0U;
+    uint8_t     len                     = 0U;
+
+    for(len = 0U; len <= MAX_BITS; ++len)
+    {
+        huffman.count[len] = 0U;
+    }
+
+    for(idx = 0U; idx < cnt; ++idx)
+    {
+        ++huffman.count[lengths[idx]];
+    }
+
+    /* An over-subscribed code is invalid. An incomplete code is accepted,
+     * because a single distance code is allowed. Invalid codes are detected
+     * while decoding.
+     */
+    for(len = 1U; len <= MAX_BITS; ++len)
+    {
+        left <<= 1;
+        left -= huffman.count[len];
+
+        if (0 > left)
+        {
+            return false;
+        }
+    }
+
+    offsets[1U] = 0U;
+    for(len = 1U; len < MAX_BITS; ++len)
+    {
+        offsets[len + 1U] = offsets[len] + huffman.count[len];
+    }
+
+    for(idx = 0U; idx < cnt; ++idx)
+    {
+        if (0U != lengths[idx])
+        {
+            huffman.symbol[offsets[lengths[idx]]] = idx;
+            ++offsets[lengths[idx]];
+        }
+    }
+
+    return true;
+}
+
+void GzipDecoder::buildFixedCodes()
+{
+    uint16_t idx = 0U;
+
+    for(idx = 0U; idx < MAX_LCODES; ++idx)
+    {
+        if (144U > idx)
+        {
+            m_lengths[idx] = 8U;
+        }
+        else if (256U > idx)
+        {
+            m_lengths[idx] = 9U;
+        }
+        else if (280U > idx)
+        {
+            m_lengths[idx] = 7U;
+        }
+        else
+        {
+            m_lengths[idx] = 8U;
+        }
+    }
+
+    (void)buildHuffman(m_lencode, m_lengths, MAX_LCODES);
+
+    for(idx = 0U; idx < MAX_DCODES; ++idx)
+    {
+        m_lengths[idx] = 5U;
+    }
+
+    (void)buildHuffman(m_distcode, m_lengths, MAX_DCODES);
+}
+
+bool GzipDecoder::step()
+{
+    bool isProgress = false;
+
+    switch(m_state)
+    {
+    case STATE_HEADER:
+    case STATE_HEADER_EXTRA_LEN:
+    case STATE_HEADER_EXTRA:
+    case STATE_HEADER_NAME:
+    case STATE_HEADER_COMMENT:
+    case STATE_HEADER_CRC:
+        isProgress = stepHeader();
+        break;
+
+    case STATE_BLOCK:
+        if (true == needBits(3U))
+        {
+            m_isFinalBlock = (1U == getBits(1U));
+
+            switch(getBits(2U))
+            {
+            case 0U:
+                /* Stored block starts at the next byte boundary. */
+                (void)getBits(m_bitCount % 8U);
+                m_count = 0U;
+                m_state = STATE_STORED_LEN;
+                break;
+
+            case 1U:
+                buildFixedCodes();
+                m_state = STATE_SYMBOL;
+                break;
+
+            case 2U:
+                m_state = STATE_TABLE_SIZES;
+                break;
+
+            default:
+                m_state = STATE_ERROR;
+                break;
+            }
+
+            isProgress = true;
+        }
+        break;
+
+    case STATE_STORED_LEN:
+        /* LEN and its one's complement NLEN */
+        if ((0U == m_count) &&
+            (true == needBits(16U)))
+        {
+            m_remaining = getBits(16U);
+            m_count = 1U;
+        }
+
+        if ((1U == m_count) &&
+            (true == needBits(16U)))
+        {
+            if ((m_remaining ^ 0xFFFFU) != getBits(16U))
+            {
+                m_state = STATE_ERROR;
+            }
+            else
+            {
+                m_state = STATE_STORED;
+            }
+
+            isProgress = true;
+        }
+        break;
+
+    case STATE_STORED:
+        while((0U < m_remaining) &&
+              (true == needBits(8U)))
+        {
+            write(static_cast<uint8_t>(getBits(8U)));
+            --m_remaining;
+        }
+
+        if (0U == m_remaining)
+        {
+            finishBlock();
+            isProgress = true;
+        }
+        break;
+
+    case STATE_TABLE_SIZES:
+    case STATE_TABLE_CODE_LENS:
+    case STATE_TABLE_LENS:
+    case STATE_TABLE_REPEAT:
+        isProgress = stepTable();
+        break;
+
+    case STATE_SYMBOL:
+    case STATE_LENGTH_EXTRA:
+    case STATE_DISTANCE:
+    case STATE_DISTANCE_EXTRA:
+        isProgress = stepCompressed();
+        break;
+
+    case STATE_TRAILER:
+        isProgress = stepTrailer();
+        break;
+
+    case STATE_DONE:
+    case STATE_ERROR:
+    default:
+        break;
+    }
+
+    return isProgress;
+}
+
+bool GzipDecoder::stepHeader()
+{
+    bool isProgress = false;
+
+    switch(m_state)
+    {
+    case STATE_HEADER:
+        while((HEADER_SIZE > m_count) &&
+              (true == needBits(8U)))
+        {
+            m_bytes[m_count] = static_cast<uint8_t>(getBits(8U));
+            ++m_count;
+        }
+
+        if (HEADER_SIZE <= m_count)
+        {
+            /* Magic number, DEFLATE compression method and no reserved flags. */
+            if ((0x1FU != m_bytes[0U]) ||
+                (0x8BU != m_bytes[1U]) ||
+                (8U != m_bytes[2U]) ||
+                (0U != (FLAG_RESERVED & m_bytes[3U])))
+            {
+                m_state = STATE_ERROR;
+            }
+            else
+            {
+                m_flags = m_bytes[3U];
+                selectHeaderField();
+            }
+
+            isProgress = true;
+        }
+        break;
+
+    case STATE_HEADER_EXTRA_LEN:
+        if (true == needBits(16U))
+        {
+            m_remaining = getBits(16U);
+            m_state = STATE_HEADER_EXTRA;
+            isProgress = true;
+        }
+        break;
+
+    case STATE_HEADER_EXTRA:
+        while((0U < m_remaining) &&
+              (true == needBits(8U)))
+        {
+            (void)getBits(8U);
+            --m_remaining;
+        }
+
+        if (0U == m_remaining)
+        {
+            m_flags &= ~FLAG_EXTRA;
+            selectHeaderField();
+            isProgress = true;
+        }
+        break;
+
+    case STATE_HEADER_NAME:
+    case STATE_HEADER_COMMENT:
+        while((false == isProgress) &&
+              (true == needBits(8U)))
+        {
+            /* Zero-terminated */
+            if (0U == getBits(8U))
+            {
+                if (STATE_HEADER_NAME == m_state)
+                {
+                    m_flags &= ~FLAG_NAME;
+                }
+                else
+                {
+                    m_flags &= ~FLAG_COMMENT;
+                }
+
+                selectHeaderField();
+                isProgress = true;
+            }
+        }
+        break;
+
+    case STATE_HEADER_CRC:
+        /* The CRC16 of the header is not verified. */
+        if (true == needBits(16U))
+        {
+            (void)getBits(16U);
+            m_flags &= ~FLAG_HCRC;
+            selectHeaderField();
+            isProgress = true;
+        }
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    return isProgress;
+}
+
+void GzipDecoder::selectHeaderField()
+{
+    /* RFC1952 - The optional fields follow in this order. */
+    if (0U != (FLAG_EXTRA & m_flags))
+    {
+        m_state = STATE_HEADER_EXTRA_LEN;
+    }
+    else if (0U != (FLAG_NAME & m_flags))
+    {
+        m_state = STATE_HEADER_NAME;
+    }
+    else if (0U != (FLAG_COMMENT & m_flags))
+    {
+        m_state = STATE_HEADER_COMMENT;
+    }
+    else if (0U != (FLAG_HCRC & m_flags))
+    {
+        m_state = STATE_HEADER_CRC;
+    }
+    else
+    {
+        m_state = STATE_BLOCK;
+    }
+}
+
+void GzipDecoder::finishBlock()
+{
+    if (false == m_isFinalBlock)
+    {
+        m_state = STATE_BLOCK;
+    }
+    else
+    {
+        /* The CRC32 is calculated over the provided data, therefore
+         * provide the rest before the trailer is verified.
+         */
+        flush();
+
+        /* The trailer starts at the next byte boundary. */
+        (void)getBits(m_bitCount % 8U);
+        m_count = 0U;
+        m_state = STATE_TRAILER;
+    }
+}
+
+bool GzipDecoder::stepTable()
+{
+    bool isProgress = false;
+
+    switch(m_state)
+    {
+    case STATE_TABLE_SIZES:
+        if (true == needBits(14U))
+        {
+            uint16_t idx = 0U;
+
+            m_nlen  = getBits(5U) + 257U;
+            m_ndist = getBits(5U) + 1U;
+            m_ncode = getBits(4U) + 4U;
+
+            if ((286U < m_nlen) ||
+                (MAX_DCODES < m_ndist))
+            {
+                m_state = STATE_ERROR;
+            }
+            else
+            {
+                for(idx = 0U; idx < MAX_CLCODES; ++idx)
+                {
+                    m_lengths[idx] = 0U;
+                }
+
+                m_count = 0U;
+                m_state = STATE_TABLE_CODE_LENS;
+            }
+
+            isProgress = true;
+        }
+        break;
+
+    case STATE_TABLE_CODE_LENS:
+        while((m_ncode > m_count) &&
+              (true == needBits(3U)))
+        {
+            m_lengths[CODE_LENGTH_ORDER[m_count]] = static_cast<uint8_t>(getBits(3U));
+            ++m_count;
+        }
+
+        if (m_ncode <= m_count)
+        {
+            /* The code length code is temporary hold by the literal/length code. */
+            if (false == buildHuffman(m_lencode, m_lengths, MAX_CLCODES))
+            {
+                m_state = STATE_ERROR;
+            }
+            else
+            {
+                m_count = 0U;
+                m_state = STATE_TABLE_LENS;
+            }
+
+            isProgress = true;
+        }
+        break;
+
+    case STATE_TABLE_LENS:
+        {
+            uint16_t symbol = 0U;
+
+            while((STATE_TABLE_LENS == m_state) &&
+                  ((m_nlen + m_ndist) > m_count) &&
+                  (true == decodeSymbol(m_lencode, symbol)))
+            {
+                if (16U > symbol)
+                {
+                    m_lengths[m_count] = static_cast<uint8_t>(symbol);
+                    ++m_count;
+                }
+                else
+                {
+                    m_repeatSymbol = symbol;
+                    m_state = STATE_TABLE_REPEAT;
+                }
+
+                isProgress = true;
+            }
+
+            if ((STATE_TABLE_LENS == m_state) &&
+                ((m_nlen + m_ndist) <= m_count))
+            {
+                /* The end of block code is mandatory. */
+                if ((0U == m_lengths[256U]) ||
+                    (false == buildHuffman(m_lencode, m_lengths, m_nlen)) ||
+                    (false == buildHuffman(m_distcode, &m_lengths[m_nlen], m_ndist)))
+                {
+                    m_state = STATE_ERROR;
+                }
+                else
+                {
+                    m_state = STATE_SYMBOL;
+                }
+
+                isProgress = true;
+            }
+        }
+        break;
+
+    case STATE_TABLE_REPEAT:
+        {
+            /* 16: Repeat previous length 3..6 times
+             * 17: Repeat zero 3..10 times
+             * 18: Repeat zero 11..138 times
+             */
+            uint8_t extraBits   = (16U == m_repeatSymbol) ? 2U : ((17U == m_repeatSymbol) ? 3U : 7U);
+            uint8_t base        = (18U == m_repeatSymbol) ? 11U : 3U;
+
+            if (true == needBits(extraBits))
+            {
+                uint16_t    repeat  = base + getBits(extraBits);
+                uint8_t     length  = 0U;
+
+                if ((16U == m_repeatSymbol) &&
+                    (0U == m_count))
+                {
+                    m_state = STATE_ERROR;
+                }
+                else if ((m_nlen + m_ndist) < (m_count + repeat))
+                {
+                    m_state = STATE_ERROR;
+                }
+                else
+                {
+                    if (16U == m_repeatSymbol)
+                    {
+                        length = m_lengths[m_count - 1U];
+                    }
+
+                    while(0U < repeat)
+                    {
+                        m_lengths[m_count] = length;
+                        ++m_count;
+                        --repeat;
+                    }
+
+                    m_state = STATE_TABLE_LENS;
+                }
+
+                isProgress = true;
+            }
+        }
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    return isProgress;
+}
+
+bool GzipDecoder::stepCompressed()
+{
+    bool isProgress = false;
+
+    switch(m_state)
+    {
+    case STATE_SYMBOL:
+        {
+            uint16_t symbol = 0U;
+
+            /* Literals are the most frequent symbols, therefore they are
+             * decoded in a loop.
+             */
+            while((STATE_SYMBOL == m_state) &&
+                  (true == decodeSymbol(m_lencode, symbol)))
+            {
+                if (256U > symbol)
+                {
+                    write(static_cast<uint8_t>(symbol));
+                }
+                else if (256U == symbol)
+                {
+                    finishBlock();
+                }
+                else if ((257U + LENGTH_SYMBOLS) <= symbol)
+                {
+                    m_state = STATE_ERROR;
+                }
+                else
+                {
+                    m_symbol = symbol - 257U;
+                    m_state = STATE_LENGTH_EXTRA;
+                }
+
+                isProgress = true;
+            }
+        }
+        break;
+
+    case STATE_LENGTH_EXTRA:
+        if (true == needBits(LENGTH_EXTRA[m_symbol]))
+        {
+            m_length = LENGTH_BASE[m_symbol] + getBits(LENGTH_EXTRA[m_symbol]);
+            m_state = STATE_DISTANCE;
+            isProgress = true;
+        }
+        break;
+
+    case STATE_DISTANCE:
+        {
+            uint16_t symbol = 0U;
+
+            if (true == decodeSymbol(m_distcode, symbol))
+            {
+                if (DISTANCE_SYMBOLS <= symbol)
+                {
+                    m_state = STATE_ERROR;
+                }
+                else
+                {
+                    m_symbol = symbol;
+                    m_state = STATE_DISTANCE_EXTRA;
+                }
+
+                isProgress = true;
+            }
+        }
+        break;
+
+    case STATE_DISTANCE_EXTRA:
+        if (true == needBits(DISTANCE_EXTRA[m_symbol]))
+        {
+            uint16_t distance = DISTANCE_BASE[m_symbol] + getBits(DISTANCE_EXTRA[m_symbol]);
+
+            if (false == copy(distance, m_length))
+            {
+                m_state = STATE_ERROR;
+            }
+            else
+            {
+                m_state = STATE_SYMBOL;
+            }
+
+            isProgress = true;
+        }
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    return isProgress;
+}
+
+bool GzipDecoder::stepTrailer()
+{
+    bool isProgress = false;
+
+    while((TRAILER_SIZE > m_count) &&
+          (true == needBits(8U)))
+    {
+        m_bytes[m_count] = static_cast<uint8_t>(getBits(8U));
+        ++m_count;
+    }
+
+    if (TRAILER_SIZE <= m_count)
+    {
+        /* RFC1952 - CRC32 and size of the decoded data, both little endian. */
+        uint32_t crc    = static_cast<uint32_t>(m_bytes[0U]) |
+                          (static_cast<uint32_t>(m_bytes[1U]) << 8U) |
+                          (static_cast<uint32_t>(m_bytes[2U]) << 16U) |
+                          (static_cast<uint32_t>(m_bytes[3U]) << 24U);
+        uint32_t size   = static_cast<uint32_t>(m_bytes[4U]) |
+                          (static_cast<uint32_t>(m_bytes[5U]) << 8U) |
+                          (static_cast<uint32_t>(m_bytes[6U]) << 16U) |
+                          (static_cast<uint32_t>(m_bytes[7U]) << 24U);
+
+        if ((crc != m_crc) ||
+            (size != m_outputSize))
+        {
+            m_state = STATE_ERROR;
+        }
+        else
+        {
+            m_state = STATE_DONE;
+        }
+
+        isProgress = true;
+    }
+
+    return isProgress;
+}
+
+void GzipDecoder::write(uint8_t value)
+{
+    m_window[m_windowPos] = value;
+    ++m_windowPos;
+    ++m_outputSize;
+
+    /* Provide the data, before the window wraps around. */
+    if (m_windowSize <= m_windowPos)
+    {
+        flush();
+
+        m_windowPos     = 0U;
+        m_outputPos     = 0U;
+        m_isWindowFull  = true;
+    }
+}
+
+bool GzipDecoder::copy(uint16_t distance, uint16_t length)
+{
+    bool isValid = false;
+
+    /* The distance must not refer before the decoded data or the window. */
+    if ((m_windowSize >= distance) &&
+        ((true == m_isWindowFull) || (m_windowPos >= distance)))
+    {
+        size_t mask     = m_windowSize - 1U;
+        size_t from     = (m_windowPos + m_windowSize - distance) & mask;
+
+        /* The match may overlap with the data, which is written. */
+        while(0U < length)
+        {
+            write(m_window[from]);
+            from = (from + 1U) & mask;
+            --length;
+        }
+
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+void GzipDecoder::flush()
+{
+    if (m_windowPos > m_outputPos)
+    {
+        size_t size = m_windowPos - m_outputPos;
+
+        m_crc = updateCrc32(m_crc, &m_window[m_outputPos], size);
+
+        if ((nullptr != m_onData) &&
+            (nullptr != *m_onData))
+        {
+            (*m_onData)(&m_window[m_outputPos], size);
+        }
+
+        m_outputPos = m_windowPos;
+    }
+}
+
+uint32_t GzipDecoder::updateCrc32(uint32_t crc, const uint8_t* data, size_t size)
+{
+    size_t idx = 0U;
+
+    crc = ~crc;
+
+    for(idx = 0U; idx < size; ++idx)
+    {
+        crc ^= data[idx];
+        crc = (crc >> 4U) ^ CRC32_TABLE[crc & 0x0FU];
+        crc = (crc >> 4U) ^ CRC32_TABLE[crc & 0x0FU];
+    }
+
+    return ~crc;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,390 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming gzip decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __GZIP_DECODER_H__
+#define __GZIP_DECODER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decodes a gzip stream (RFC1952) with DEFLATE compressed data (RFC1951),
+ * which is received in several parts, e.g. TCP segments of a HTTP response
+ * body. The decoded data is provided in parts as well, directly from the
+ * sliding window. Therefore the required memory is bounded by the window
+ * size and not by the size of the decoded data.
+ *
+ * The window is allocated on the first decoding and released by release().
+ */
+class GzipDecoder
+{
+public:
+
+    /**
+     * Prototype of the callback, which is called for every decoded part.
+     *
+     * @param[in] data  Decoded data
+     * @param[in] size  Decoded data size in byte
+     */
+    typedef std::function<void(const uint8_t* data, size_t size)> OnData;
+
+    /**
+     * Max. window size in byte, which may be used by a DEFLATE encoder.
+     * A smaller window only decodes streams, which don't refer further back.
+     */
+    static const size_t MAX_WINDOW_SIZE = 32768U;
+
+    /** Min. window size in byte. */
+    static const size_t MIN_WINDOW_SIZE = 256U;
+
+    /**
+     * Constructs the decoder.
+     *
+     * @param[in] windowSize    Window size in byte, must be a power of two.
+     */
+    GzipDecoder(size_t windowSize = MAX_WINDOW_SIZE);
+
+    /**
+     * Destroys the decoder.
+     */
+    ~GzipDecoder()
+    {
+        release();
+    }
+
+    /**
+     * Reset the decoder to be ready for the next stream.
+     * The window is kept.
+     */
+    void reset();
+
+    /**
+     * Reset the decoder and release the window.
+     */
+    void release();
+
+    /**
+     * Decode the next part of the stream.
+     *
+     * @param[in] data      Part of the gzip stream
+     * @param[in] size      Part size in byte
+     * @param[in] onData    Callback, which is called for every decoded part.
+     *
+     * @return If successful decoded, it will return true. If the stream is
+     *          invalid or the window can not be allocated, it will return false.
+     */
+    bool decode(const uint8_t* data, size_t size, const OnData& onData);
+
+    /**
+     * Is the stream complete decoded and verified?
+     *
+     * @return If complete, it will return true otherwise false.
+     */
+    bool isComplete() const
+    {
+        return (STATE_DONE == m_state);
+    }
+
+    /**
+     * Did a decoding error happen?
+     *
+     * @return If an error happened, it will return true otherwise false.
+     */
+    bool isError() const
+    {
+        return (STATE_ERROR == m_state);
+    }
+
+    /**
+     * Get the window size.
+     *
+     * @return Window size in byte
+     */
+    size_t getWindowSize() const
+    {
+        return m_windowSize;
+    }
+
+private:
+
+    /** Decoder states */
+    enum State
+    {
+        STATE_HEADER = 0,       /**< Fixed gzip header */
+        STATE_HEADER_EXTRA_LEN, /**< Length of the extra field */
+        STATE_HEADER_EXTRA,     /**< Extra field */
+        STATE_HEADER_NAME,      /**< Zero-terminated original file name */
+        STATE_HEADER_COMMENT,   /**< Zero-terminated file comment */
+        STATE_HEADER_CRC,       /**< CRC16 of the header */
+        STATE_BLOCK,            /**< DEFLATE block header */
+        STATE_STORED_LEN,       /**< Length of a stored block */
+        STATE_STORED,           /**< Data of a stored block */
+        STATE_TABLE_SIZES,      /**< Number of code lengths of a dynamic block */
+        STATE_TABLE_CODE_LENS,  /**< Code lengths of the code length code */
+        STATE_TABLE_LENS,       /**< Literal/length and distance code lengths */
+        STATE_TABLE_REPEAT,     /**< Extra bits of a repeated code length */
+        STATE_SYMBOL,           /**< Literal/length symbol */
+        STATE_LENGTH_EXTRA,     /**< Extra bits of the length */
+        STATE_DISTANCE,         /**< Distance symbol */
+        STATE_DISTANCE_EXTRA,   /**< Extra bits of the distance */
+        STATE_TRAILER,          /**< CRC32 and size of the decoded data */
+        STATE_DONE,             /**< Stream complete */
+        STATE_ERROR             /**< Decoding error */
+    };
+
+    /** Max. number of bits of a Huffman code. */
+    static const uint8_t    MAX_BITS        = 15U;
+
+    /** Number of literal/length codes. */
+    static const uint16_t   MAX_LCODES      = 288U;
+
+    /** Number of distance codes. */
+    static const uint16_t   MAX_DCODES      = 30U;
+
+    /** Number of code length codes. */
+    static const uint16_t   MAX_CLCODES     = 19U;
+
+    /** Size of the fixed gzip header in byte. */
+    static const uint8_t    HEADER_SIZE     = 10U;
+
+    /** Size of the gzip trailer in byte. */
+    static const uint8_t    TRAILER_SIZE    = 8U;
+
+    /** gzip header flag: CRC16 of the header is present. */
+    static const uint8_t    FLAG_HCRC       = 0x02U;
+
+    /** gzip header flag: Extra field is present. */
+    static const uint8_t    FLAG_EXTRA      = 0x04U;
+
+    /** gzip header flag: Original file name is present. */
+    static const uint8_t    FLAG_NAME       = 0x08U;
+
+    /** gzip header flag: File comment is present. */
+    static const uint8_t    FLAG_COMMENT    = 0x10U;
+
+    /** gzip header flags, which are reserved. */
+    static const uint8_t    FLAG_RESERVED   = 0xE0U;
+
+    /**
+     * Canonical Huffman code, described by the number of codes per length
+     * and the symbols ordered by their codes.
+     */
+    struct Huffman
+    {
+        uint16_t    count[MAX_BITS + 1U];   /**< Number of codes per length */
+        uint16_t*   symbol;                 /**< Symbols ordered by their codes */
+    };
+
+    size_t          m_windowSize;                           /**< Window size in byte */
+    uint8_t*        m_window;                               /**< Sliding window, which contains the decoded data. */
+    size_t          m_windowPos;                            /**< Write position in the window */
+    size_t          m_outputPos;                            /**< Window position of the first not provided decoded byte */
+    uint32_t        m_outputSize;                           /**< Size of the decoded data in byte (modulo 2^32) */
+    bool            m_isWindowFull;                         /**< Is the window completely filled once? */
+    uint32_t        m_crc;                                  /**< CRC32 of the provided decoded data */
+    State           m_state;                                /**< Decoder state */
+    const uint8_t*  m_input;                                /**< Current input part */
+    size_t          m_inputSize;                            /**< Current input part size in byte */
+    size_t          m_inputIndex;                           /**< Index of the next input byte */
+    uint32_t        m_bitBuffer;                            /**< Bit buffer, the next bit is the LSB. */
+    uint8_t         m_bitCount;                             /**< Number of bits in the bit buffer */
+    uint8_t         m_flags;                                /**< gzip header flags of the fields, which are not decoded yet. */
+    uint8_t         m_bytes[HEADER_SIZE];                   /**< Bytes of the fixed gzip header or the trailer */
+    uint16_t        m_count;                                /**< Generic counter of the current state */
+    uint16_t        m_remaining;                            /**< Remaining bytes of the current field or stored block */
+    bool            m_isFinalBlock;                         /**< Is the current DEFLATE block the last one? */
+    uint16_t        m_nlen;                                 /**< Number of literal/length codes of a dynamic block */
+    uint16_t        m_ndist;                                /**< Number of distance codes of a dynamic block */
+    uint16_t        m_ncode;                                /**< Number of code length codes of a dynamic block */
+    uint8_t         m_lengths[MAX_LCODES + MAX_DCODES];     /**< Code lengths of a dynamic block */
+    uint16_t        m_repeatSymbol;                         /**< Code length symbol, which is repeated. */
+    uint16_t        m_lencodeSymbols[MAX_LCODES];           /**< Symbols of the literal/length code */
+    uint16_t        m_distcodeSymbols[MAX_DCODES];          /**< Symbols of the distance code */
+    Huffman         m_lencode;                              /**< Literal/length code, also used for the code length code. */
+    Huffman         m_distcode;                             /**< Distance code */
+    uint16_t        m_symbol;                               /**< Current length or distance symbol */
+    uint16_t        m_length;                               /**< Length of the current match */
+    const OnData*   m_onData;                               /**< Callback of the current decoding */
+
+    GzipDecoder(const GzipDecoder& decoder);
+    GzipDecoder& operator=(const GzipDecoder& decoder);
+
+    /**
+     * Request bits from the bit buffer, which is refilled from the input.
+     *
+     * @param[in] need  Number of bits (max. 16)
+     *
+     * @return If the bits are available, it will return true otherwise false.
+     */
+    bool needBits(uint8_t need);
+
+    /**
+     * Get bits from the bit buffer. They must be available, see needBits().
+     *
+     * @param[in] cnt   Number of bits (max. 16)
+     *
+     * @return Bits
+     */
+    uint32_t getBits(uint8_t cnt);
+
+    /**
+     * Decode a symbol with a Huffman code.
+     *
+     * @param[in]   huffman Huffman code
+     * @param[out]  symbol  Decoded symbol
+     *
+     * @return If enough bits are available, it will return true otherwise false.
+     *          An invalid code results in the error state.
+     */
+    bool decodeSymbol(const Huffman& huffman, uint16_t& symbol);
+
+    /**
+     * Build a Huffman code from the code lengths.
+     *
+     * @param[out]  huffman Huffman code
+     * @param[in]   lengths Code lengths per symbol
+     * @param[in]   cnt     Number of symbols
+     *
+     * @return If the code is valid, it will return true otherwise false.
+     */
+    static bool buildHuffman(Huffman& huffman, const uint8_t* lengths, uint16_t cnt);
+
+    /**
+     * Build the fixed Huffman codes.
+     */
+    void buildFixedCodes();
+
+    /**
+     * Decode as much as possible of the current input in the current state.
+     *
+     * @return If more input is required, it will return false otherwise true.
+     */
+    bool step();
+
+    /**
+     * Decode the gzip header.
+     *
+     * @return If more input is required, it will return false otherwise true.
+     */
+    bool stepHeader();
+
+    /**
+     * Select the next optional gzip header field or the first DEFLATE block.
+     */
+    void selectHeaderField();
+
+    /**
+     * Finish the current DEFLATE block and select the next block or the trailer.
+     */
+    void finishBlock();
+
+    /**
+     * Decode the dynamic Huffman code tables.
+     *
+     * @return If more input is required, it will return false otherwise true.
+     */
+    bool stepTable();
+
+    /**
+     * Decode compressed data.
+     *
+     * @return If more input is required, it will return false otherwise true.
+     */
+    bool stepCompressed();
+
+    /**
+     * Decode the gzip trailer and verify the decoded data.
+     *
+     * @return If more input is required, it will return false otherwise true.
+     */
+    bool stepTrailer();
+
+    /**
+     * Write a decoded byte to the window.
+     *
+     * @param[in] value Decoded byte
+     */
+    void write(uint8_t value);
+
+    /**
+     * Copy a match from the window.
+     *
+     * @param[in] distance  Distance back in byte
+     * @param[in] length    Length in byte
+     *
+     * @return If the distance is valid, it will return true otherwise false.
+     */
+    bool copy(uint16_t distance, uint16_t length);
+
+    /**
+     * Provide all not provided decoded data via callback.
+     */
+    void flush();
+
+    /**
+     * Update a CRC32.
+     *
+     * @param[in] crc   CRC32
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return Updated CRC32
+     */
+    static uint32_t updateCrc32(uint32_t crc, const uint8_t* data, size_t size);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GZIP_DECODER_H__ */
+
+/** @} */
@@ -0,0 +1,311 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Histogram with fixed buckets
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __HISTOGRAM_HPP__
+#define __HISTOGRAM_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A histogram with a fixed number of buckets of equal width. Every value
+ * is counted in its bucket, values which are greater than the range
+ * are counted in the last bucket. Adding a value costs O(1) and no heap
+ * memory is used, therefore it can be used in time critical context.
+ * 
+ * @tparam T            Data type of the value
+ * @tparam zero         The number zero, compliant to the data type of the value.
+ * @tparam bucketWidth  Width of a single bucket.
+ * @tparam bucketCnt    Number of buckets.
+ */
+template < typename T, T zero, T bucketWidth, uint32_t bucketCnt >
+class Histogram
+{
+public:
+
+    /**
+     * Create the histogram in initial state.
+     */
+    Histogram() :
+        m_buckets(),
+        m_cnt(0U),
+        m_min(zero),
+        m_max(zero),
+        m_sum(zero)
+    {
+        reset();
+    }
+
+    /**
+     * Destroys the histogram.
+     */
+    ~Histogram()
+    {
+    }
+
+    /**
+     * Count the value in its bucket.
+     * 
+     * @param[in] value The value which to count.
+     */
+    void update(const T& value)
+    {
+        uint32_t idx = static_cast<uint32_t>(value / bucketWidth);
+
+        /* Values out of range are counted in the last bucket. */
+        if (bucketCnt <= idx)
+        {
+            idx = bucketCnt - 1U;
+        }
+
+        ++m_buckets[idx];
+
+        /* Initialize min. and max. value with the first given real value. */
+        if (0U == m_cnt)
+        {
+            m_min = value;
+            m_max = value;
+        }
+        else
+        {
+            if (m_min > value)
+            {
+                m_min = value;
+            }
+
+            if (m_max < value)
+            {
+                m_max = value;
+            }
+        }
+
+        m_sum += value;
+        ++m_cnt;
+    }
+
+    /**
+     * Reset everything to get it back in initial state.
+     */
+    void reset()
+    {
+        uint32_t idx = 0U;
+
+        for(idx = 0U; idx < bucketCnt; ++idx)
+        {
+            m_buckets[idx] = 0U;
+        }
+
+        m_cnt   = 0U;
+        m_min   = zero;
+        m_max   = zero;
+        m_sum   = zero;
+    }
+
+    /**
+     * Get the number of values, counted since the last reset.
+     * 
+     * @return Number of values
+     */
+    uint32_t getCount() const
+    {
+        return m_cnt;
+    }
+
+    /**
+     * Get the minimum value, determined since the last reset.
+     * 
+     * @return Minimum value
+     */
+    T getMin() const
+    {
+        return m_min;
+    }
+
+    /**
+     * Get the maximum value, determined since the last reset.
+     * 
+     * @return Maximum value
+     */
+    T getMax() const
+    {
+        return m_max;
+    }
+
+    /**
+     * Get the average value, determined since the last reset.
+     * 
+     * @return Average value
+     */
+    T getAvg() const
+    {
+        T avg = zero;
+
+        if (0U < m_cnt)
+        {
+            avg = m_sum / m_cnt;
+        }
+
+        return avg;
+    }
+
+    /**
+     * Get the percentile value. Because the values are only counted in
+     * buckets, the upper bound of the bucket is returned, which is limited
+     * to the maximum value. If the percentile is in the last bucket, which
+     * counts the values out of range too, the maximum value is returned.
+     * This way the outliers are not hidden.
+     * 
+     * @param[in] percent   Percent [0; 100]
+     * 
+     * @return Percentile value
+     */
+    T getPercentile(uint8_t percent) const
+    {
+        T           percentile  = zero;
+        uint32_t    rank        = 0U;
+        uint32_t    sum         = 0U;
+        uint32_t    idx         = 0U;
+
+        if (0U < m_cnt)
+        {
+            if (100U < percent)
+            {
+                percent = 100U;
+            }
+
+            /* Nearest rank method */
+            rank = (static_cast<uint32_t>(percent) * m_cnt + 99U) / 100U;
+
+            if (0U == rank)
+            {
+                rank = 1U;
+            }
+
+            /* Find the bucket, which contains the rank. */
+            while((bucketCnt > idx) && (rank > (sum + m_buckets[idx])))
+            {
+                sum += m_buckets[idx];
+                ++idx;
+            }
+
+            /* The last bucket has no upper bound. */
+            if ((bucketCnt - 1U) <= idx)
+            {
+                percentile = m_max;
+            }
+            else
+            {
+                percentile = static_cast<T>(idx + 1U) * bucketWidth - 1U;
+            }
+
+            if (m_max < percentile)
+            {
+                percentile = m_max;
+            }
+        }
+
+        return percentile;
+    }
+
+    /**
+     * Get the number of values in a bucket.
+     * 
+     * @param[in] idx   Bucket index
+     * 
+     * @return Number of values in the bucket.
+     */
+    uint32_t getBucket(uint32_t idx) const
+    {
+        uint32_t cnt = 0U;
+
+        if (bucketCnt > idx)
+        {
+            cnt = m_buckets[idx];
+        }
+
+        return cnt;
+    }
+
+    /**
+     * Get the number of buckets.
+     * 
+     * @return Number of buckets
+     */
+    uint32_t getBucketCnt() const
+    {
+        return bucketCnt;
+    }
+
+    /**
+     * Get the width of a single bucket.
+     * 
+     * @return Bucket width
+     */
+    T getBucketWidth() const
+    {
+        return bucketWidth;
+    }
+
+private:
+
+    uint32_t    m_buckets[bucketCnt];   /**< Number of values per bucket. */
+    uint32_t    m_cnt;                  /**< Number of values since the last reset. */
+    T           m_min;                  /**< Minimum value, determined since the last reset. */
+    T           m_max;                  /**< Maximum value, determined since the last reset. */
+    T           m_sum;                  /**< Sum over all values since the last reset. */
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HISTOGRAM_HPP__ */
+
+/** @} */
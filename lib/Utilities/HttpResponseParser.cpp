@@ -0,0 +1,995 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Incremental HTTP response parser
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HttpResponseParser.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Headers, which are always handled by the parser. */
+static const char*  HEADER_CONTENT_LENGTH       = "Content-Length";
+static const char*  HEADER_TRANSFER_ENCODING    = "Transfer-Encoding";
+static const char*  HEADER_CONNECTION           = "Connection";
+static const char*  HEADER_CONTENT_ENCODING     = "Content-Encoding";
+
+/** Max. number of chunk size digits, which fits into size_t without overflow. */
+static const uint8_t CHUNK_SIZE_DIGITS_MAX      = 2U * sizeof(size_t) - 1U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+HttpResponseParser::HttpResponseParser() :
+    m_headerFilters(),
+    m_headerFilterCnt(0U),
+    m_state(STATE_VERSION),
+    m_version(),
+    m_versionLen(0U),
+    m_minorVersion(0U),
+    m_statusCode(0U),
+    m_statusCodeLen(0U),
+    m_reasonPhrase(),
+    m_reasonPhraseLen(0U),
+    m_nameBuffer(),
+    m_nameLen(0U),
+    m_isNameTruncated(false),
+    m_isHeaderRequested(false),
+    m_framing(FRAMING_NONE),
+    m_valueBuffer(),
+    m_valueLen(0U),
+    m_isValueTruncated(false),
+    m_name(),
+    m_value(),
+    m_body(),
+    m_bodyType(BODY_NONE),
+    m_contentLength(0U),
+    m_hasContentLength(false),
+    m_isConnectionClose(false),
+    m_isConnectionKeepAlive(false),
+    m_contentCoding(CONTENT_CODING_IDENTITY),
+    m_remaining(0U),
+    m_chunkSizeDigits(0U)
+{
+    resetResponse();
+}
+
+void HttpResponseParser::reset()
+{
+    resetResponse();
+}
+
+bool HttpResponseParser::addHeaderFilter(const char* name)
+{
+    bool isSuccessful = false;
+
+    if ((nullptr != name) &&
+        (MAX_HEADER_FILTERS > m_headerFilterCnt) &&
+        (NAME_SIZE_MAX >= strlen(name)))
+    {
+        m_headerFilters[m_headerFilterCnt] = name;
+        ++m_headerFilterCnt;
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+HttpResponseParser::Event HttpResponseParser::parse(const uint8_t* data, size_t size, size_t& index)
+{
+    Event       event           = EVENT_NONE;
+    const char* chars           = reinterpret_cast<const char*>(data);
+    bool        isDataRequired  = false;
+
+    /* The previous response is complete, new data belongs to the next one. */
+    if ((STATE_DONE == m_state) &&
+        (size > index))
+    {
+        resetResponse();
+    }
+
+    while ((EVENT_NONE == event) &&
+           (false == isDataRequired))
+    {
+        if (STATE_ERROR == m_state)
+        {
+            event = EVENT_ERROR;
+        }
+        else if (STATE_COMPLETE == m_state)
+        {
+            m_state = STATE_DONE;
+            event   = EVENT_COMPLETE;
+        }
+        else if ((STATE_DONE == m_state) ||
+                 (nullptr == data) ||
+                 (size <= index))
+        {
+            isDataRequired = true;
+        }
+        else if (STATE_STATUS_LF >= m_state)
+        {
+            event = parseStatusLine(chars[index]);
+            ++index;
+        }
+        else if ((STATE_VALUE_START == m_state) ||
+                 (STATE_VALUE == m_state))
+        {
+            /* The value is parsed as a whole, as far as the segment allows it. */
+            event = parseValue(chars, size, index);
+        }
+        else if (STATE_HEADERS_LF >= m_state)
+        {
+            event = parseHeader(chars[index]);
+            ++index;
+        }
+        else if ((STATE_BODY_LENGTH == m_state) ||
+                 (STATE_CHUNK_DATA == m_state))
+        {
+            event = provideBody(chars, size, index, m_remaining);
+        }
+        else if (STATE_BODY_CLOSE == m_state)
+        {
+            event = provideBody(chars, size, index, size - index);
+        }
+        else
+        {
+            event = parseChunked(chars[index]);
+            ++index;
+        }
+    }
+
+    return event;
+}
+
+bool HttpResponseParser::finish()
+{
+    bool isComplete = false;
+
+    if (STATE_BODY_CLOSE == m_state)
+    {
+        m_state     = STATE_DONE;
+        isComplete  = true;
+    }
+
+    return isComplete;
+}
+
+bool HttpResponseParser::isKeepAlive() const
+{
+    bool isKeepAlive = false;
+
+    if ((BODY_CLOSE != m_bodyType) &&
+        (false == m_isConnectionClose))
+    {
+        /* HTTP/1.1 uses persistent connections by default, HTTP/1.0 only on request. */
+        if (0U < m_minorVersion)
+        {
+            isKeepAlive = true;
+        }
+        else
+        {
+            isKeepAlive = m_isConnectionKeepAlive;
+        }
+    }
+
+    return isKeepAlive;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void HttpResponseParser::resetResponse()
+{
+    m_state                 = STATE_VERSION;
+    m_versionLen            = 0U;
+    m_minorVersion          = 0U;
+    m_statusCode            = 0U;
+    m_statusCodeLen         = 0U;
+    m_reasonPhrase[0]       = '\0';
+    m_reasonPhraseLen       = 0U;
+    m_nameLen               = 0U;
+    m_isNameTruncated       = false;
+    m_isHeaderRequested     = false;
+    m_framing               = FRAMING_NONE;
+    m_valueLen              = 0U;
+    m_isValueTruncated      = false;
+    m_name.data             = m_nameBuffer;
+    m_name.size             = 0U;
+    m_value.data            = m_valueBuffer;
+    m_value.size            = 0U;
+    m_body.data             = nullptr;
+    m_body.size             = 0U;
+    m_bodyType              = BODY_NONE;
+    m_contentLength         = 0U;
+    m_hasContentLength      = false;
+    m_isConnectionClose     = false;
+    m_isConnectionKeepAlive = false;
+    m_contentCoding         = CONTENT_CODING_IDENTITY;
+    m_remaining             = 0U;
+    m_chunkSizeDigits       = 0U;
+}
+
+HttpResponseParser::Event HttpResponseParser::parseStatusLine(char c)
+{
+    Event event = EVENT_NONE;
+
+    switch(m_state)
+    {
+    case STATE_VERSION:
+        if (' ' == c)
+        {
+            /* Only HTTP/1.x is supported. */
+            if ((VERSION_SIZE_MAX == m_versionLen) &&
+                (0 == memcmp(m_version, "HTTP/1.", VERSION_SIZE_MAX - 1U)) &&
+                ('0' <= m_version[VERSION_SIZE_MAX - 1U]) &&
+                ('9' >= m_version[VERSION_SIZE_MAX - 1U]))
+            {
+                m_minorVersion  = static_cast<uint8_t>(m_version[VERSION_SIZE_MAX - 1U] - '0');
+                m_state         = STATE_STATUS_CODE;
+            }
+            else
+            {
+                m_state = STATE_ERROR;
+            }
+        }
+        else if (VERSION_SIZE_MAX > m_versionLen)
+        {
+            m_version[m_versionLen] = c;
+            ++m_versionLen;
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_STATUS_CODE:
+        if (('0' <= c) &&
+            ('9' >= c) &&
+            (3U > m_statusCodeLen))
+        {
+            m_statusCode = static_cast<uint16_t>(m_statusCode * 10U + static_cast<uint16_t>(c - '0'));
+            ++m_statusCodeLen;
+        }
+        else if (3U != m_statusCodeLen)
+        {
+            m_state = STATE_ERROR;
+        }
+        else if (' ' == c)
+        {
+            m_state = STATE_REASON;
+        }
+        /* The reason phrase may be missing at all. */
+        else if ('\r' == c)
+        {
+            m_state = STATE_STATUS_LF;
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_REASON:
+        if ('\r' == c)
+        {
+            m_state = STATE_STATUS_LF;
+        }
+        else if ('\n' == c)
+        {
+            m_state = STATE_NAME_START;
+        }
+        /* The rest of a too long reason phrase is skipped. */
+        else if (REASON_SIZE_MAX > m_reasonPhraseLen)
+        {
+            m_reasonPhrase[m_reasonPhraseLen] = c;
+            ++m_reasonPhraseLen;
+            m_reasonPhrase[m_reasonPhraseLen] = '\0';
+        }
+        break;
+
+    case STATE_STATUS_LF:
+        m_state = ('\n' == c) ? STATE_NAME_START : STATE_ERROR;
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    if (STATE_ERROR == m_state)
+    {
+        event = EVENT_ERROR;
+    }
+
+    return event;
+}
+
+HttpResponseParser::Event HttpResponseParser::parseHeader(char c)
+{
+    Event event = EVENT_NONE;
+
+    switch(m_state)
+    {
+    case STATE_NAME_START:
+        if ('\r' == c)
+        {
+            m_state = STATE_HEADERS_LF;
+        }
+        else if ('\n' == c)
+        {
+            event = handleHeadersComplete();
+        }
+        else if ((':' == c) ||
+                 (' ' == c) ||
+                 ('\t' == c))
+        {
+            /* Empty header names and obsolete line folding are not supported. */
+            m_state = STATE_ERROR;
+        }
+        else
+        {
+            m_nameBuffer[0]     = c;
+            m_nameLen           = 1U;
+            m_isNameTruncated   = false;
+            m_state             = STATE_NAME;
+        }
+        break;
+
+    case STATE_NAME:
+        if (':' == c)
+        {
+            handleName();
+            m_state = STATE_VALUE_START;
+        }
+        else if (('\r' == c) ||
+                 ('\n' == c))
+        {
+            m_state = STATE_ERROR;
+        }
+        else if (NAME_SIZE_MAX > m_nameLen)
+        {
+            m_nameBuffer[m_nameLen] = c;
+            ++m_nameLen;
+        }
+        else
+        {
+            m_isNameTruncated = true;
+        }
+        break;
+
+    case STATE_HEADERS_LF:
+        if ('\n' == c)
+        {
+            event = handleHeadersComplete();
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    if (STATE_ERROR == m_state)
+    {
+        event = EVENT_ERROR;
+    }
+
+    return event;
+}
+
+HttpResponseParser::Event HttpResponseParser::parseValue(const char* data, size_t size, size_t& index)
+{
+    Event event = EVENT_NONE;
+
+    /* Skip leading whitespace. */
+    if (STATE_VALUE_START == m_state)
+    {
+        while ((size > index) &&
+               ((' ' == data[index]) ||
+                ('\t' == data[index])))
+        {
+            ++index;
+        }
+
+        if (size > index)
+        {
+            m_valueLen          = 0U;
+            m_isValueTruncated  = false;
+            m_state             = STATE_VALUE;
+        }
+    }
+
+    if (STATE_VALUE == m_state)
+    {
+        bool        isRequired  = (true == m_isHeaderRequested) || (FRAMING_NONE != m_framing);
+        const void* eol         = memchr(&data[index], '\n', size - index);
+        size_t      end         = (nullptr == eol) ? size : static_cast<size_t>(static_cast<const char*>(eol) - data);
+        const char* value       = &data[index];
+        size_t      valueLen    = end - index;
+
+        /* The value continues in the next segment or it started in the previous
+         * one. Only in this case it needs to be copied. The buffer has space
+         * for the carriage return of the line end, which may be copied too.
+         */
+        if ((true == isRequired) &&
+            ((nullptr == eol) || (0U < m_valueLen)))
+        {
+            size_t copyLen = valueLen;
+
+            if ((sizeof(m_valueBuffer) - m_valueLen) < copyLen)
+            {
+                copyLen             = sizeof(m_valueBuffer) - m_valueLen;
+                m_isValueTruncated  = true;
+            }
+
+            memcpy(&m_valueBuffer[m_valueLen], value, copyLen);
+            m_valueLen += copyLen;
+
+            value       = m_valueBuffer;
+            valueLen    = m_valueLen;
+        }
+
+        if (nullptr == eol)
+        {
+            index = size;
+        }
+        else
+        {
+            index = end + 1U;
+
+            /* Remove the carriage return of the line end. */
+            if ((0U < valueLen) &&
+                ('\r' == value[valueLen - 1U]))
+            {
+                --valueLen;
+            }
+
+            /* Independent of the segmentation, a too long value is never reported. */
+            if (VALUE_SIZE_MAX < valueLen)
+            {
+                m_isValueTruncated = true;
+            }
+
+            /* Remove trailing whitespace. */
+            while ((0U < valueLen) &&
+                   ((' ' == value[valueLen - 1U]) ||
+                    ('\t' == value[valueLen - 1U])))
+            {
+                --valueLen;
+            }
+
+            m_value.data    = value;
+            m_value.size    = valueLen;
+            m_state         = STATE_NAME_START;
+            event           = handleValue();
+        }
+    }
+
+    return event;
+}
+
+HttpResponseParser::Event HttpResponseParser::parseChunked(char c)
+{
+    Event   event   = EVENT_NONE;
+    uint8_t digit   = 0U;
+
+    switch(m_state)
+    {
+    case STATE_CHUNK_SIZE:
+        if (true == hexDigit(c, digit))
+        {
+            if (CHUNK_SIZE_DIGITS_MAX > m_chunkSizeDigits)
+            {
+                m_remaining = (m_remaining << 4U) | digit;
+                ++m_chunkSizeDigits;
+            }
+            else
+            {
+                m_state = STATE_ERROR;
+            }
+        }
+        else if (0U == m_chunkSizeDigits)
+        {
+            m_state = STATE_ERROR;
+        }
+        else if ('\r' == c)
+        {
+            m_state = STATE_CHUNK_SIZE_LF;
+        }
+        else if ('\n' == c)
+        {
+            m_state = (0U == m_remaining) ? STATE_TRAILER : STATE_CHUNK_DATA;
+        }
+        else if ((';' == c) ||
+                 (' ' == c) ||
+                 ('\t' == c))
+        {
+            m_state = STATE_CHUNK_EXT;
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_CHUNK_EXT:
+        /* Chunk extensions are not supported and skipped. */
+        if ('\r' == c)
+        {
+            m_state = STATE_CHUNK_SIZE_LF;
+        }
+        else if ('\n' == c)
+        {
+            m_state = (0U == m_remaining) ? STATE_TRAILER : STATE_CHUNK_DATA;
+        }
+        break;
+
+    case STATE_CHUNK_SIZE_LF:
+        if ('\n' == c)
+        {
+            m_state = (0U == m_remaining) ? STATE_TRAILER : STATE_CHUNK_DATA;
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_CHUNK_DATA_CR:
+        if ('\r' == c)
+        {
+            m_state = STATE_CHUNK_DATA_LF;
+        }
+        else if ('\n' == c)
+        {
+            m_chunkSizeDigits   = 0U;
+            m_state             = STATE_CHUNK_SIZE;
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_CHUNK_DATA_LF:
+        if ('\n' == c)
+        {
+            m_chunkSizeDigits   = 0U;
+            m_state             = STATE_CHUNK_SIZE;
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_TRAILER:
+        if ('\r' == c)
+        {
+            m_state = STATE_TRAILER_LF;
+        }
+        else if ('\n' == c)
+        {
+            m_state = STATE_COMPLETE;
+        }
+        else
+        {
+            /* Trailer fields are not supported and skipped. */
+            m_state = STATE_TRAILER_LINE;
+        }
+        break;
+
+    case STATE_TRAILER_LINE:
+        if ('\n' == c)
+        {
+            m_state = STATE_TRAILER;
+        }
+        break;
+
+    case STATE_TRAILER_LF:
+        m_state = ('\n' == c) ? STATE_COMPLETE : STATE_ERROR;
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    if (STATE_ERROR == m_state)
+    {
+        event = EVENT_ERROR;
+    }
+
+    return event;
+}
+
+void HttpResponseParser::handleName()
+{
+    uint8_t filterIdx = 0U;
+
+    m_name.data         = m_nameBuffer;
+    m_name.size         = m_nameLen;
+    m_isHeaderRequested = false;
+    m_framing           = FRAMING_NONE;
+
+    /* A truncated name can't match any known header. */
+    if (false == m_isNameTruncated)
+    {
+        if (true == isEqual(m_name, HEADER_CONTENT_LENGTH))
+        {
+            m_framing = FRAMING_CONTENT_LENGTH;
+        }
+        else if (true == isEqual(m_name, HEADER_TRANSFER_ENCODING))
+        {
+            m_framing = FRAMING_TRANSFER_ENCODING;
+        }
+        else if (true == isEqual(m_name, HEADER_CONNECTION))
+        {
+            m_framing = FRAMING_CONNECTION;
+        }
+        else if (true == isEqual(m_name, HEADER_CONTENT_ENCODING))
+        {
+            m_framing = FRAMING_CONTENT_ENCODING;
+        }
+
+        while ((m_headerFilterCnt > filterIdx) &&
+               (false == m_isHeaderRequested))
+        {
+            m_isHeaderRequested = isEqual(m_name, m_headerFilters[filterIdx]);
+            ++filterIdx;
+        }
+    }
+}
+
+HttpResponseParser::Event HttpResponseParser::handleValue()
+{
+    Event event = EVENT_NONE;
+
+    if (true == m_isValueTruncated)
+    {
+        /* The message framing can't be determined without the whole value. */
+        if (FRAMING_NONE != m_framing)
+        {
+            m_state = STATE_ERROR;
+            event   = EVENT_ERROR;
+        }
+    }
+    else
+    {
+        switch(m_framing)
+        {
+        case FRAMING_CONTENT_LENGTH:
+            {
+                size_t  contentLength   = 0U;
+                size_t  idx             = 0U;
+                bool    isValid         = (0U < m_value.size);
+
+                while ((true == isValid) &&
+                       (m_value.size > idx))
+                {
+                    char c = m_value.data[idx];
+
+                    if (('0' > c) ||
+                        ('9' < c) ||
+                        (((static_cast<size_t>(-1) - static_cast<size_t>(c - '0')) / 10U) < contentLength))
+                    {
+                        isValid = false;
+                    }
+                    else
+                    {
+                        contentLength = contentLength * 10U + static_cast<size_t>(c - '0');
+                    }
+
+                    ++idx;
+                }
+
+                /* Different content lengths are ambiguous. */
+                if ((false == isValid) ||
+                    ((true == m_hasContentLength) && (contentLength != m_contentLength)))
+                {
+                    m_state = STATE_ERROR;
+                    event   = EVENT_ERROR;
+                }
+                else
+                {
+                    m_contentLength     = contentLength;
+                    m_hasContentLength  = true;
+                }
+            }
+            break;
+
+        case FRAMING_TRANSFER_ENCODING:
+            /* Only the chunked transfer coding is supported. */
+            if (true == isEqual(m_value, "chunked"))
+            {
+                m_bodyType = BODY_CHUNKED;
+            }
+            else
+            {
+                m_state = STATE_ERROR;
+                event   = EVENT_ERROR;
+            }
+            break;
+
+        case FRAMING_CONNECTION:
+            if (true == containsToken(m_value, "close"))
+            {
+                m_isConnectionClose = true;
+            }
+
+            if (true == containsToken(m_value, "keep-alive"))
+            {
+                m_isConnectionKeepAlive = true;
+            }
+            break;
+
+        case FRAMING_CONTENT_ENCODING:
+            if ((0U == m_value.size) ||
+                (true == isEqual(m_value, "identity")))
+            {
+                m_contentCoding = CONTENT_CODING_IDENTITY;
+            }
+            else if ((true == isEqual(m_value, "gzip")) ||
+                     (true == isEqual(m_value, "x-gzip")))
+            {
+                m_contentCoding = CONTENT_CODING_GZIP;
+            }
+            else
+            {
+                m_contentCoding = CONTENT_CODING_UNSUPPORTED;
+            }
+            break;
+
+        case FRAMING_NONE:
+        default:
+            break;
+        }
+
+        if ((EVENT_NONE == event) &&
+            (true == m_isHeaderRequested))
+        {
+            event = EVENT_HEADER;
+        }
+    }
+
+    m_valueLen          = 0U;
+    m_isValueTruncated  = false;
+
+    return event;
+}
+
+HttpResponseParser::Event HttpResponseParser::handleHeadersComplete()
+{
+    /* Informational responses, "No Content" and "Not Modified" never have a body. */
+    if ((200U > m_statusCode) ||
+        (204U == m_statusCode) ||
+        (304U == m_statusCode))
+    {
+        m_bodyType  = BODY_NONE;
+        m_state     = STATE_COMPLETE;
+    }
+    /* The transfer coding overrides the content length. */
+    else if (BODY_CHUNKED == m_bodyType)
+    {
+        m_remaining         = 0U;
+        m_chunkSizeDigits   = 0U;
+        m_state             = STATE_CHUNK_SIZE;
+    }
+    else if (true == m_hasContentLength)
+    {
+        if (0U == m_contentLength)
+        {
+            m_bodyType  = BODY_NONE;
+            m_state     = STATE_COMPLETE;
+        }
+        else
+        {
+            m_bodyType  = BODY_LENGTH;
+            m_remaining = m_contentLength;
+            m_state     = STATE_BODY_LENGTH;
+        }
+    }
+    else
+    {
+        m_bodyType  = BODY_CLOSE;
+        m_state     = STATE_BODY_CLOSE;
+    }
+
+    return EVENT_HEADERS_COMPLETE;
+}
+
+HttpResponseParser::Event HttpResponseParser::provideBody(const char* data, size_t size, size_t& index, size_t max)
+{
+    size_t available = size - index;
+
+    m_body.data = &data[index];
+    m_body.size = (max < available) ? max : available;
+    index      += m_body.size;
+
+    if (STATE_BODY_CLOSE != m_state)
+    {
+        m_remaining -= m_body.size;
+
+        if (0U == m_remaining)
+        {
+            m_state = (STATE_CHUNK_DATA == m_state) ? STATE_CHUNK_DATA_CR : STATE_COMPLETE;
+        }
+    }
+
+    return EVENT_BODY;
+}
+
+bool HttpResponseParser::isEqual(const Span& span, const char* str)
+{
+    size_t  idx     = 0U;
+    bool    isEqual = true;
+
+    while ((true == isEqual) &&
+           (span.size > idx))
+    {
+        /* The end of the string never matches, because the span contains no null-terminator. */
+        if (('\0' == str[idx]) ||
+            (toLower(span.data[idx]) != toLower(str[idx])))
+        {
+            isEqual = false;
+        }
+
+        ++idx;
+    }
+
+    /* The string must end together with the span. */
+    if ((true == isEqual) &&
+        ('\0' != str[idx]))
+    {
+        isEqual = false;
+    }
+
+    return isEqual;
+}
+
+bool HttpResponseParser::containsToken(const Span& span, const char* token)
+{
+    bool    isFound = false;
+    size_t  idx     = 0U;
+
+    while ((false == isFound) &&
+           (span.size > idx))
+    {
+        Span    element;
+
+        /* Skip separators and whitespace. */
+        while ((span.size > idx) &&
+               ((',' == span.data[idx]) ||
+                (' ' == span.data[idx]) ||
+                ('\t' == span.data[idx])))
+        {
+            ++idx;
+        }
+
+        element.data = &span.data[idx];
+        element.size = 0U;
+
+        while ((span.size > idx) &&
+               (',' != span.data[idx]) &&
+               (' ' != span.data[idx]) &&
+               ('\t' != span.data[idx]))
+        {
+            ++element.size;
+            ++idx;
+        }
+
+        if ((0U < element.size) &&
+            (true == isEqual(element, token)))
+        {
+            isFound = true;
+        }
+    }
+
+    return isFound;
+}
+
+char HttpResponseParser::toLower(char c)
+{
+    if (('A' <= c) &&
+        ('Z' >= c))
+    {
+        c = c - 'A' + 'a';
+    }
+
+    return c;
+}
+
+bool HttpResponseParser::hexDigit(char c, uint8_t& value)
+{
+    bool isDigit = true;
+
+    if (('0' <= c) &&
+        ('9' >= c))
+    {
+        value = static_cast<uint8_t>(c - '0');
+    }
+    else if (('a' <= c) &&
+             ('f' >= c))
+    {
+        value = static_cast<uint8_t>(c - 'a' + 10);
+    }
+    else if (('A' <= c) &&
+             ('F' >= c))
+    {
+        value = static_cast<uint8_t>(c - 'A' + 10);
+    }
+    else
+    {
+        isDigit = false;
+    }
+
+    return isDigit;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,481 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Incremental HTTP response parser
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __HTTP_RESPONSE_PARSER_H__
+#define __HTTP_RESPONSE_PARSER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Incremental HTTP/1.x response parser (RFC7230), which works directly on
+ * the received segments, e.g. TCP segments. The parser is pulled by the
+ * caller and returns an event, as soon as something is available:
+ *
+ * - EVENT_HEADER: A header, which the caller asked for. Name and value are
+ *   provided as spans.
+ * - EVENT_HEADERS_COMPLETE: Status line and headers are parsed, the
+ *   message framing (content length, chunked, keep-alive) is known.
+ * - EVENT_BODY: A part of the body (chunk framing removed), provided as span
+ *   into the segment.
+ * - EVENT_COMPLETE: The response is complete. The next response on the same
+ *   connection can be parsed afterwards.
+ *
+ * Header values are only copied, if they are split over segments. The body
+ * is never copied. All spans are valid until the next call of parse().
+ */
+class HttpResponseParser
+{
+public:
+
+    /** Parser events */
+    enum Event
+    {
+        EVENT_NONE = 0,         /**< More data required */
+        EVENT_HEADER,           /**< A requested header is available. */
+        EVENT_HEADERS_COMPLETE, /**< Status line and all headers are parsed. */
+        EVENT_BODY,             /**< A body part is available. */
+        EVENT_COMPLETE,         /**< Response is complete. */
+        EVENT_ERROR             /**< Invalid or unsupported response */
+    };
+
+    /** Content coding of the body */
+    enum ContentCoding
+    {
+        CONTENT_CODING_IDENTITY = 0,    /**< Not encoded */
+        CONTENT_CODING_GZIP,            /**< gzip encoded */
+        CONTENT_CODING_UNSUPPORTED      /**< Unsupported encoding */
+    };
+
+    /**
+     * A span of characters, which is not null-terminated.
+     */
+    struct Span
+    {
+        const char* data;   /**< Characters */
+        size_t      size;   /**< Number of characters */
+    };
+
+    /** Max. number of headers, which can be requested. */
+    static const uint8_t    MAX_HEADER_FILTERS  = 8U;
+
+    /** Max. header name length in byte. Longer names are never requested. */
+    static const size_t     NAME_SIZE_MAX       = 32U;
+
+    /** Max. length of a header value in byte, which is split over segments. */
+    static const size_t     VALUE_SIZE_MAX      = 256U;
+
+    /** Max. reason phrase length in byte. A longer one is truncated. */
+    static const size_t     REASON_SIZE_MAX     = 32U;
+
+    /**
+     * Constructs the parser.
+     */
+    HttpResponseParser();
+
+    /**
+     * Destroys the parser.
+     */
+    ~HttpResponseParser()
+    {
+    }
+
+    /**
+     * Reset the parser to be ready for the response on a new connection.
+     * The requested headers are kept.
+     */
+    void reset();
+
+    /**
+     * Request a header, which shall be reported with EVENT_HEADER.
+     * The name is compared case-insensitive and must be valid during the
+     * parser lifetime, e.g. a string literal.
+     *
+     * @param[in] name  Header name
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool addHeaderFilter(const char* name);
+
+    /**
+     * Parse the next part of the received data, until an event happens.
+     *
+     * @param[in]       data    Received data
+     * @param[in]       size    Received data size in byte
+     * @param[in,out]   index   Index of the next byte to parse. It is updated
+     *                          with the first not parsed byte.
+     *
+     * @return Event
+     */
+    Event parse(const uint8_t* data, size_t size, size_t& index);
+
+    /**
+     * Signal that the connection is closed. A body, which is delimited by
+     * the connection close, is complete then.
+     *
+     * @return If the response is complete by closing, it will return true otherwise false.
+     */
+    bool finish();
+
+    /**
+     * Get the name of the current header. Valid after EVENT_HEADER.
+     *
+     * @return Header name
+     */
+    const Span& getHeaderName() const
+    {
+        return m_name;
+    }
+
+    /**
+     * Get the value of the current header. Valid after EVENT_HEADER.
+     *
+     * @return Header value
+     */
+    const Span& getHeaderValue() const
+    {
+        return m_value;
+    }
+
+    /**
+     * Get the current body part. Valid after EVENT_BODY.
+     *
+     * @return Body part
+     */
+    const Span& getBody() const
+    {
+        return m_body;
+    }
+
+    /**
+     * Get the HTTP minor version, e.g. 1 for HTTP/1.1.
+     *
+     * @return HTTP minor version
+     */
+    uint8_t getMinorVersion() const
+    {
+        return m_minorVersion;
+    }
+
+    /**
+     * Get the status code.
+     *
+     * @return Status code
+     */
+    uint16_t getStatusCode() const
+    {
+        return m_statusCode;
+    }
+
+    /**
+     * Get the reason phrase. It is truncated to REASON_SIZE_MAX.
+     *
+     * @return Null-terminated reason phrase
+     */
+    const char* getReasonPhrase() const
+    {
+        return m_reasonPhrase;
+    }
+
+    /**
+     * Has the response a body? Valid after EVENT_HEADERS_COMPLETE.
+     *
+     * @return If a body follows, it will return true otherwise false.
+     */
+    bool hasBody() const
+    {
+        return (BODY_NONE != m_bodyType);
+    }
+
+    /**
+     * Is the body chunked transfer encoded? Valid after EVENT_HEADERS_COMPLETE.
+     *
+     * @return If chunked, it will return true otherwise false.
+     */
+    bool isChunked() const
+    {
+        return (BODY_CHUNKED == m_bodyType);
+    }
+
+    /**
+     * Get the content length. Valid after EVENT_HEADERS_COMPLETE.
+     *
+     * @return Content length in byte, 0 if unknown or no body.
+     */
+    size_t getContentLength() const
+    {
+        return (BODY_LENGTH == m_bodyType) ? m_contentLength : 0U;
+    }
+
+    /**
+     * Get the content coding. Valid after EVENT_HEADERS_COMPLETE.
+     *
+     * @return Content coding
+     */
+    ContentCoding getContentCoding() const
+    {
+        return m_contentCoding;
+    }
+
+    /**
+     * Can the connection be used for the next request after the response?
+     * Valid after EVENT_HEADERS_COMPLETE.
+     *
+     * @return If the connection can be kept alive, it will return true otherwise false.
+     */
+    bool isKeepAlive() const;
+
+private:
+
+    /** Parser states */
+    enum State
+    {
+        STATE_VERSION = 0,      /**< HTTP version of the status line */
+        STATE_STATUS_CODE,      /**< Status code */
+        STATE_REASON,           /**< Reason phrase */
+        STATE_STATUS_LF,        /**< Line feed of the status line */
+        STATE_NAME_START,       /**< Header name or end of headers */
+        STATE_NAME,             /**< Header name */
+        STATE_VALUE_START,      /**< Whitespace before the header value */
+        STATE_VALUE,            /**< Header value */
+        STATE_HEADERS_LF,       /**< Line feed of the empty line after the headers */
+        STATE_BODY_LENGTH,      /**< Body with known length */
+        STATE_BODY_CLOSE,       /**< Body, which is delimited by connection close */
+        STATE_CHUNK_SIZE,       /**< Chunk size */
+        STATE_CHUNK_EXT,        /**< Chunk extension */
+        STATE_CHUNK_SIZE_LF,    /**< Line feed of the chunk size line */
+        STATE_CHUNK_DATA,       /**< Chunk data */
+        STATE_CHUNK_DATA_CR,    /**< Carriage return after the chunk data */
+        STATE_CHUNK_DATA_LF,    /**< Line feed after the chunk data */
+        STATE_TRAILER,          /**< Trailer line or end of trailer */
+        STATE_TRAILER_LINE,     /**< Trailer line, which is skipped. */
+        STATE_TRAILER_LF,       /**< Line feed of the empty line after the trailer */
+        STATE_COMPLETE,         /**< Response complete, but not reported yet. */
+        STATE_DONE,             /**< Response complete and reported */
+        STATE_ERROR             /**< Invalid response */
+    };
+
+    /** Body type */
+    enum BodyType
+    {
+        BODY_NONE = 0,  /**< No body */
+        BODY_LENGTH,    /**< Body with content length */
+        BODY_CHUNKED,   /**< Chunked transfer coding */
+        BODY_CLOSE      /**< Body is delimited by connection close. */
+    };
+
+    /** Headers, which are handled by the parser itself. */
+    enum Framing
+    {
+        FRAMING_NONE = 0,           /**< Not a framing header */
+        FRAMING_CONTENT_LENGTH,     /**< Content-Length */
+        FRAMING_TRANSFER_ENCODING,  /**< Transfer-Encoding */
+        FRAMING_CONNECTION,         /**< Connection */
+        FRAMING_CONTENT_ENCODING    /**< Content-Encoding */
+    };
+
+    /** Max. length of the HTTP version in the status line, e.g. "HTTP/1.1" */
+    static const size_t     VERSION_SIZE_MAX    = 8U;
+
+    const char*     m_headerFilters[MAX_HEADER_FILTERS];    /**< Requested headers */
+    uint8_t         m_headerFilterCnt;                      /**< Number of requested headers */
+    State           m_state;                                /**< Parser state */
+    char            m_version[VERSION_SIZE_MAX];            /**< HTTP version of the status line */
+    size_t          m_versionLen;                           /**< HTTP version length */
+    uint8_t         m_minorVersion;                         /**< HTTP minor version */
+    uint16_t        m_statusCode;                           /**< Status code */
+    uint8_t         m_statusCodeLen;                        /**< Number of status code digits */
+    char            m_reasonPhrase[REASON_SIZE_MAX + 1U];   /**< Null-terminated reason phrase */
+    size_t          m_reasonPhraseLen;                      /**< Reason phrase length */
+    char            m_nameBuffer[NAME_SIZE_MAX];            /**< Current header name */
+    size_t          m_nameLen;                              /**< Current header name length */
+    bool            m_isNameTruncated;                      /**< Is the current header name too long? */
+    bool            m_isHeaderRequested;                    /**< Is the current header requested? */
+    Framing         m_framing;                              /**< Framing header, which is parsed. */
+    char            m_valueBuffer[VALUE_SIZE_MAX + 1U];     /**< Value, which is split over segments, incl. carriage return */
+    size_t          m_valueLen;                             /**< Length of the value in the buffer */
+    bool            m_isValueTruncated;                     /**< Is the value too long? */
+    Span            m_name;                                 /**< Span of the current header name */
+    Span            m_value;                                /**< Span of the current header value */
+    Span            m_body;                                 /**< Span of the current body part */
+    BodyType        m_bodyType;                             /**< Body type */
+    size_t          m_contentLength;                        /**< Content length in byte */
+    bool            m_hasContentLength;                     /**< Is the content length available? */
+    bool            m_isConnectionClose;                    /**< Connection: close */
+    bool            m_isConnectionKeepAlive;                /**< Connection: keep-alive */
+    ContentCoding   m_contentCoding;                        /**< Content coding */
+    size_t          m_remaining;                            /**< Remaining bytes of the body or current chunk */
+    uint8_t         m_chunkSizeDigits;                      /**< Number of chunk size digits */
+
+    HttpResponseParser(const HttpResponseParser& parser);
+    HttpResponseParser& operator=(const HttpResponseParser& parser);
+
+    /**
+     * Reset the response related values for the next response.
+     */
+    void resetResponse();
+
+    /**
+     * Parse the next character of the status line.
+     *
+     * @param[in] c Character
+     *
+     * @return Event
+     */
+    Event parseStatusLine(char c);
+
+    /**
+     * Parse the next character of a header name or the end of the headers.
+     *
+     * @param[in] c Character
+     *
+     * @return Event
+     */
+    Event parseHeader(char c);
+
+    /**
+     * Parse the header value, as far as it is available in the segment.
+     *
+     * @param[in]       data    Received data
+     * @param[in]       size    Received data size in byte
+     * @param[in,out]   index   Index of the next byte to parse
+     *
+     * @return Event
+     */
+    Event parseValue(const char* data, size_t size, size_t& index);
+
+    /**
+     * Parse the next character of the chunk framing.
+     *
+     * @param[in] c Character
+     *
+     * @return Event
+     */
+    Event parseChunked(char c);
+
+    /**
+     * Handle the end of the header name.
+     */
+    void handleName();
+
+    /**
+     * Handle a complete header value.
+     *
+     * @return Event
+     */
+    Event handleValue();
+
+    /**
+     * Handle the end of all headers and determine the body type.
+     *
+     * @return Event
+     */
+    Event handleHeadersComplete();
+
+    /**
+     * Provide a part of the body.
+     *
+     * @param[in]       data    Received data
+     * @param[in]       size    Received data size in byte
+     * @param[in,out]   index   Index of the next byte to parse
+     * @param[in]       max     Max. body part size in byte
+     *
+     * @return Event
+     */
+    Event provideBody(const char* data, size_t size, size_t& index, size_t max);
+
+    /**
+     * Is the span equal to the string, case-insensitive?
+     *
+     * @param[in] span  Span
+     * @param[in] str   Null-terminated string
+     *
+     * @return If equal, it will return true otherwise false.
+     */
+    static bool isEqual(const Span& span, const char* str);
+
+    /**
+     * Does the span contain the token (case-insensitive), e.g. in a comma
+     * separated list?
+     *
+     * @param[in] span  Span
+     * @param[in] token Null-terminated token
+     *
+     * @return If found, it will return true otherwise false.
+     */
+    static bool containsToken(const Span& span, const char* token);
+
+    /**
+     * Convert a character to lower case.
+     *
+     * @param[in] c Character
+     *
+     * @return Lower case character
+     */
+    static char toLower(char c);
+
+    /**
+     * Get the value of a hexadecimal digit.
+     *
+     * @param[in]   c       Character
+     * @param[out]  value   Digit value
+     *
+     * @return If the character is a hexadecimal digit, it will return true otherwise false.
+     */
+    static bool hexDigit(char c, uint8_t& value);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HTTP_RESPONSE_PARSER_H__ */
+
+/** @} */
@@ -0,0 +1,363 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Job scheduler
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "JobScheduler.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool isDue(uint32_t due, uint32_t timestamp);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+JobScheduler::JobScheduler(uint8_t maxRunning, uint32_t maxJitter, uint32_t retryPeriod, uint32_t seed) :
+    m_jobs(),
+    m_maxRunning(maxRunning),
+    m_runningCnt(0U),
+    m_maxJitter(maxJitter),
+    m_retryPeriod(retryPeriod),
+    m_random(seed)
+{
+    /* The pseudo random number generator would stuck at 0. */
+    if (0U == m_random)
+    {
+        m_random = 1U;
+    }
+}
+
+uint8_t JobScheduler::add(uint32_t period, uint8_t priority, uint32_t timestamp)
+{
+    uint8_t id = 0U;
+
+    while((MAX_JOBS > id) && (true == m_jobs[id].isUsed))
+    {
+        ++id;
+    }
+
+    if (MAX_JOBS <= id)
+    {
+        id = INVALID_ID;
+    }
+    else
+    {
+        Job& job = m_jobs[id];
+
+        job.isUsed      = true;
+        job.isRunning   = false;
+        job.period      = period;
+        job.priority    = priority;
+        job.due         = timestamp + getRandom(m_maxJitter);
+        job.failureCnt  = 0U;
+    }
+
+    return id;
+}
+
+void JobScheduler::remove(uint8_t id)
+{
+    if (true == isValid(id))
+    {
+        if (true == m_jobs[id].isRunning)
+        {
+            --m_runningCnt;
+        }
+
+        m_jobs[id] = Job();
+    }
+}
+
+void JobScheduler::setPeriod(uint8_t id, uint32_t period)
+{
+    if (true == isValid(id))
+    {
+        m_jobs[id].period = period;
+    }
+}
+
+void JobScheduler::setPriority(uint8_t id, uint8_t priority)
+{
+    if (true == isValid(id))
+    {
+        m_jobs[id].priority = priority;
+    }
+}
+
+void JobScheduler::trigger(uint8_t id, uint32_t timestamp)
+{
+    if (true == isValid(id))
+    {
+        m_jobs[id].due = timestamp;
+    }
+}
+
+void JobScheduler::spread(uint32_t window, uint32_t timestamp)
+{
+    uint8_t id = 0U;
+
+    for(id = 0U; id < MAX_JOBS; ++id)
+    {
+        Job& job = m_jobs[id];
+
+        if ((true == job.isUsed) &&
+            (false == job.isRunning))
+        {
+            job.due         = timestamp + getRandom(window);
+            job.failureCnt  = 0U;
+        }
+    }
+}
+
+uint8_t JobScheduler::next(uint32_t timestamp)
+{
+    uint8_t nextId  = INVALID_ID;
+    uint8_t id      = 0U;
+
+    if (m_maxRunning <= m_runningCnt)
+    {
+        return INVALID_ID;
+    }
+
+    for(id = 0U; id < MAX_JOBS; ++id)
+    {
+        const Job& job = m_jobs[id];
+
+        if ((true == job.isUsed) &&
+            (false == job.isRunning) &&
+            (true == isDue(job.due, timestamp)))
+        {
+            /* Higher priority first, the longest overdue first on equal priority. */
+            if (INVALID_ID == nextId)
+            {
+                nextId = id;
+            }
+            else if (m_jobs[nextId].priority < job.priority)
+            {
+                nextId = id;
+            }
+            else if ((m_jobs[nextId].priority == job.priority) &&
+                     ((timestamp - m_jobs[nextId].due) < (timestamp - job.due)))
+            {
+                nextId = id;
+            }
+        }
+    }
+
+    if (INVALID_ID != nextId)
+    {
+        m_jobs[nextId].isRunning = true;
+        ++m_runningCnt;
+    }
+
+    return nextId;
+}
+
+void JobScheduler::finish(uint8_t id, bool isSuccessful, uint32_t timestamp)
+{
+    if ((true == isValid(id)) &&
+        (true == m_jobs[id].isRunning))
+    {
+        Job&        job     = m_jobs[id];
+        uint32_t    delay   = job.period;
+        uint32_t    jitter  = m_maxJitter;
+
+        job.isRunning = false;
+        --m_runningCnt;
+
+        if (true == isSuccessful)
+        {
+            job.failureCnt = 0U;
+        }
+        else
+        {
+            uint8_t backoffExp = job.failureCnt;
+
+            if (MAX_BACKOFF_EXP < backoffExp)
+            {
+                backoffExp = MAX_BACKOFF_EXP;
+            }
+
+            /* Retry with exponential backoff, but not later than the period.
+             * A job with a period shorter than the retry period is retried
+             * with the retry period.
+             */
+            if (m_retryPeriod > delay)
+            {
+                delay = m_retryPeriod;
+            }
+            else if ((m_retryPeriod << backoffExp) < delay)
+            {
+                delay = m_retryPeriod << backoffExp;
+            }
+
+            if (UINT8_MAX > job.failureCnt)
+            {
+                ++job.failureCnt;
+            }
+
+            /* Jobs, which failed at the same time e.g. because the server
+             * is not reachable, shall not be retried at the same time.
+             * The jitter is limited to a fraction of the delay.
+             */
+            if ((delay / RETRY_JITTER_DIVIDER) < jitter)
+            {
+                jitter = delay / RETRY_JITTER_DIVIDER;
+            }
+
+            delay += getRandom(jitter);
+        }
+
+        /* A successful job keeps its period. The jobs were already spread
+         * by the jitter after adding or spreading them.
+         */
+        job.due = timestamp + delay;
+    }
+}
+
+bool JobScheduler::isRunning(uint8_t id) const
+{
+    return (true == isValid(id)) && (true == m_jobs[id].isRunning);
+}
+
+uint32_t JobScheduler::getRemaining(uint8_t id, uint32_t timestamp) const
+{
+    uint32_t remaining = 0U;
+
+    if ((true == isValid(id)) &&
+        (false == m_jobs[id].isRunning) &&
+        (false == isDue(m_jobs[id].due, timestamp)))
+    {
+        remaining = m_jobs[id].due - timestamp;
+    }
+
+    return remaining;
+}
+
+uint8_t JobScheduler::getFailureCount(uint8_t id) const
+{
+    uint8_t failureCnt = 0U;
+
+    if (true == isValid(id))
+    {
+        failureCnt = m_jobs[id].failureCnt;
+    }
+
+    return failureCnt;
+}
+
+uint8_t JobScheduler::getCount() const
+{
+    uint8_t cnt = 0U;
+    uint8_t id  = 0U;
+
+    for(id = 0U; id < MAX_JOBS; ++id)
+    {
+        if (true == m_jobs[id].isUsed)
+        {
+            ++cnt;
+        }
+    }
+
+    return cnt;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool JobScheduler::isValid(uint8_t id) const
+{
+    return (MAX_JOBS > id) && (true == m_jobs[id].isUsed);
+}
+
+uint32_t JobScheduler::getRandom(uint32_t range)
+{
+    uint32_t value = 0U;
+
+    /* Xorshift32 */
+    m_random ^= m_random << 13U;
+    m_random ^= m_random >> 17U;
+    m_random ^= m_random << 5U;
+
+    if (0U < range)
+    {
+        value = m_random % range;
+    }
+
+    return value;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Is the due time reached?
+ *
+ * @param[in] due       Due timestamp in ms
+ * @param[in] timestamp Current timestamp in ms
+ *
+ * @return If due, it will return true otherwise false.
+ */
+static bool isDue(uint32_t due, uint32_t timestamp)
+{
+    /* Considers the timestamp overflow. */
+    return (0 <= static_cast<int32_t>(timestamp - due));
+}
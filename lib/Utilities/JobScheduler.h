@@ -0,0 +1,286 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Job scheduler
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __JOB_SCHEDULER_H__
+#define __JOB_SCHEDULER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Schedules periodic jobs, e.g. requests to a server.
+ *
+ * - An added or spread job is due after a random jitter, which spreads jobs
+ *   with the same period over time. Afterwards a successful job is due
+ *   again exactly after its period.
+ * - Only a limited number of jobs are running at the same time.
+ * - If several jobs are due, the one with the highest priority is started
+ *   first.
+ * - A failed job is retried with an exponential backoff, but never later
+ *   than its period. A job with a period shorter than the retry period is
+ *   retried with the retry period. A small jitter, limited to a fraction of
+ *   the retry delay, prevents that failed jobs are retried all at once.
+ *
+ * The scheduler doesn't run the jobs itself. The user asks for the next
+ * job, runs it and reports when its finished. It is not thread-safe.
+ */
+class JobScheduler
+{
+public:
+
+    /** Max. number of jobs. */
+    static const uint8_t    MAX_JOBS            = 16U;
+
+    /** Invalid job id. */
+    static const uint8_t    INVALID_ID              = UINT8_MAX;
+
+    /** Max. exponent of the retry backoff, the retry period is at most multiplied by 2^MAX_BACKOFF_EXP. */
+    static const uint8_t    MAX_BACKOFF_EXP         = 6U;
+
+    /** The jitter of a retry is limited to the retry delay divided by this value. */
+    static const uint32_t   RETRY_JITTER_DIVIDER    = 10U;
+
+    /**
+     * Constructs the job scheduler.
+     *
+     * @param[in] maxRunning    Max. number of jobs running at the same time.
+     * @param[in] maxJitter     Max. random jitter in ms, which is added to the due time.
+     * @param[in] retryPeriod   Retry period in ms after the first failure.
+     * @param[in] seed          Seed for the jitter, must not be 0.
+     */
+    JobScheduler(uint8_t maxRunning, uint32_t maxJitter, uint32_t retryPeriod, uint32_t seed = 1U);
+
+    /**
+     * Destroys the job scheduler.
+     */
+    ~JobScheduler()
+    {
+    }
+
+    /**
+     * Add a job. It is due the first time after a random jitter.
+     *
+     * @param[in] period    Period in ms
+     * @param[in] priority  Priority, higher value means higher priority.
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return Job id or INVALID_ID, if no job is available anymore.
+     */
+    uint8_t add(uint32_t period, uint8_t priority, uint32_t timestamp);
+
+    /**
+     * Remove a job. If the job is running, its result will be ignored.
+     *
+     * @param[in] id    Job id
+     */
+    void remove(uint8_t id);
+
+    /**
+     * Set the period of a job. It will be considered the next time the job
+     * is scheduled.
+     *
+     * @param[in] id        Job id
+     * @param[in] period    Period in ms
+     */
+    void setPeriod(uint8_t id, uint32_t period);
+
+    /**
+     * Set the priority of a job.
+     *
+     * @param[in] id        Job id
+     * @param[in] priority  Priority, higher value means higher priority.
+     */
+    void setPriority(uint8_t id, uint8_t priority);
+
+    /**
+     * Job shall be due as soon as possible.
+     *
+     * @param[in] id        Job id
+     * @param[in] timestamp Current timestamp in ms
+     */
+    void trigger(uint8_t id, uint32_t timestamp);
+
+    /**
+     * Spread all jobs, which are not running, randomly over the given time
+     * window and forget about previous failures. This is useful after the
+     * network connection was (re-)established, where all jobs would be due
+     * at once otherwise.
+     *
+     * @param[in] window    Time window in ms
+     * @param[in] timestamp Current timestamp in ms
+     */
+    void spread(uint32_t window, uint32_t timestamp);
+
+    /**
+     * Get the next due job and mark it as running.
+     * If the max. number of running jobs is reached, no job will be provided.
+     *
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return Job id or INVALID_ID, if no job shall be started.
+     */
+    uint8_t next(uint32_t timestamp);
+
+    /**
+     * Finish a running job and schedule it again.
+     *
+     * @param[in] id            Job id
+     * @param[in] isSuccessful  Was the job successful?
+     * @param[in] timestamp     Current timestamp in ms
+     */
+    void finish(uint8_t id, bool isSuccessful, uint32_t timestamp);
+
+    /**
+     * Is the job running?
+     *
+     * @param[in] id    Job id
+     *
+     * @return If the job is running, it will return true otherwise false.
+     */
+    bool isRunning(uint8_t id) const;
+
+    /**
+     * Get the time until the job is due.
+     *
+     * @param[in] id        Job id
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return Time in ms. If the job is already due, running or unknown it returns 0.
+     */
+    uint32_t getRemaining(uint8_t id, uint32_t timestamp) const;
+
+    /**
+     * Get number of consecutive failures of a job.
+     *
+     * @param[in] id    Job id
+     *
+     * @return Number of consecutive failures
+     */
+    uint8_t getFailureCount(uint8_t id) const;
+
+    /**
+     * Get number of jobs.
+     *
+     * @return Number of jobs
+     */
+    uint8_t getCount() const;
+
+    /**
+     * Get number of running jobs.
+     *
+     * @return Number of running jobs
+     */
+    uint8_t getRunningCount() const
+    {
+        return m_runningCnt;
+    }
+
+private:
+
+    /** A single job. */
+    struct Job
+    {
+        bool        isUsed;     /**< Is job used? */
+        bool        isRunning;  /**< Is job running? */
+        uint32_t    period;     /**< Period in ms */
+        uint8_t     priority;   /**< Priority, higher value means higher priority. */
+        uint32_t    due;        /**< Timestamp in ms, when the job is due. */
+        uint8_t     failureCnt; /**< Number of consecutive failures */
+
+        /**
+         * Constructs a unused job.
+         */
+        Job() :
+            isUsed(false),
+            isRunning(false),
+            period(0U),
+            priority(0U),
+            due(0U),
+            failureCnt(0U)
+        {
+        }
+    };
+
+    Job         m_jobs[MAX_JOBS];   /**< Jobs */
+    uint8_t     m_maxRunning;       /**< Max. number of jobs running at the same time */
+    uint8_t     m_runningCnt;       /**< Number of running jobs */
+    uint32_t    m_maxJitter;        /**< Max. jitter in ms */
+    uint32_t    m_retryPeriod;      /**< Retry period in ms after the first failure */
+    uint32_t    m_random;           /**< State of the pseudo random number generator */
+
+    JobScheduler();
+    JobScheduler(const JobScheduler& scheduler);
+    JobScheduler& operator=(const JobScheduler& scheduler);
+
+    /**
+     * Is the job id valid and the job used?
+     *
+     * @param[in] id    Job id
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    bool isValid(uint8_t id) const;
+
+    /**
+     * Get a pseudo random number in the range [0; range).
+     *
+     * @param[in] range Range
+     *
+     * @return Pseudo random number, 0 if range is 0.
+     */
+    uint32_t getRandom(uint32_t range);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __JOB_SCHEDULER_H__ */
+
+/** @} */
@@ -0,0 +1,521 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming JSON filter
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "JsonStreamFilter.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+JsonStreamFilter::JsonStreamFilter(const JsonDocument& filter, size_t maxOutputSize) :
+    m_filter(filter.as<JsonVariantConst>()),
+    m_output(maxOutputSize),
+    m_isOutputOverflow(false),
+    m_state(STATE_VALUE),
+    m_levels(),
+    m_depth(0U),
+    m_valueFilter(),
+    m_isValueKept(true),
+    m_key(),
+    m_keyLen(0U),
+    m_isKeyTruncated(false),
+    m_isEscape(false),
+    m_isRawKept(false),
+    m_isRawString(false),
+    m_rawDepth(0U)
+{
+    reset();
+}
+
+void JsonStreamFilter::reset()
+{
+    m_output.clear();
+    m_isOutputOverflow  = false;
+    m_state             = STATE_VALUE;
+    m_depth             = 0U;
+    m_valueFilter       = m_filter.as<JsonVariantConst>();
+    m_isValueKept       = true;
+    m_keyLen            = 0U;
+    m_isKeyTruncated    = false;
+    m_isEscape          = false;
+    m_isRawKept         = false;
+    m_isRawString       = false;
+    m_rawDepth          = 0U;
+}
+
+bool JsonStreamFilter::parse(const uint8_t* data, size_t size)
+{
+    size_t idx = 0U;
+
+    if (nullptr == data)
+    {
+        return false;
+    }
+
+    while((size > idx) && (STATE_ERROR != m_state))
+    {
+        /* A not consumed character is parsed again in the new state. */
+        if (true == parseChar(static_cast<char>(data[idx])))
+        {
+            ++idx;
+        }
+
+        if (true == m_isOutputOverflow)
+        {
+            m_state = STATE_ERROR;
+        }
+    }
+
+    return (STATE_ERROR != m_state);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool JsonStreamFilter::parseChar(char c)
+{
+    bool isConsumed = true;
+
+    /* Whitespace between the tokens is dropped. */
+    if ((STATE_KEY_STRING == m_state) ||
+        (STATE_RAW == m_state) ||
+        (false == isWhitespace(c)))
+    {
+        switch(m_state)
+        {
+        case STATE_VALUE:
+            /* Empty array or trailing separator */
+            if ((0U < m_depth) &&
+                (false == m_levels[m_depth - 1U].isObject) &&
+                (']' == c))
+            {
+                finishLevel(c);
+            }
+            else
+            {
+                isConsumed = parseValueStart(c);
+            }
+            break;
+
+        case STATE_KEY:
+            if ('"' == c)
+            {
+                m_keyLen            = 0U;
+                m_isKeyTruncated    = false;
+                m_isEscape          = false;
+                m_state             = STATE_KEY_STRING;
+            }
+            /* Empty object or trailing separator */
+            else if ('}' == c)
+            {
+                finishLevel(c);
+            }
+            else
+            {
+                m_state = STATE_ERROR;
+            }
+            break;
+
+        case STATE_KEY_STRING:
+            parseKeyChar(c);
+            break;
+
+        case STATE_COLON:
+            if (':' == c)
+            {
+                selectValueFilter();
+
+                if (true == m_isValueKept)
+                {
+                    writeSeparator();
+                    write("\"", 1U);
+                    write(m_key, m_keyLen);
+                    write("\":", 2U);
+                }
+
+                m_state = STATE_VALUE;
+            }
+            else
+            {
+                m_state = STATE_ERROR;
+            }
+            break;
+
+        case STATE_NEXT:
+            if (',' == c)
+            {
+                if (true == m_levels[m_depth - 1U].isObject)
+                {
+                    m_state = STATE_KEY;
+                }
+                else
+                {
+                    selectValueFilter();
+                    m_state = STATE_VALUE;
+                }
+            }
+            else if (((true == m_levels[m_depth - 1U].isObject) && ('}' == c)) ||
+                     ((false == m_levels[m_depth - 1U].isObject) && (']' == c)))
+            {
+                finishLevel(c);
+            }
+            else
+            {
+                m_state = STATE_ERROR;
+            }
+            break;
+
+        case STATE_RAW:
+            isConsumed = parseRawChar(c);
+            break;
+
+        /* Only whitespace may follow the document. */
+        case STATE_DONE:
+            m_state = STATE_ERROR;
+            break;
+
+        case STATE_ERROR:
+            /* fallthrough */
+        default:
+            break;
+        }
+    }
+
+    return isConsumed;
+}
+
+void JsonStreamFilter::parseKeyChar(char c)
+{
+    if ((false == m_isEscape) &&
+        ('"' == c))
+    {
+        m_key[m_keyLen] = '\0';
+        m_state         = STATE_COLON;
+    }
+    else
+    {
+        /* The key is kept escaped, like it is written to the output. */
+        if (true == m_isEscape)
+        {
+            m_isEscape = false;
+        }
+        else if ('\\' == c)
+        {
+            m_isEscape = true;
+        }
+
+        if ((KEY_SIZE_MAX - 1U) > m_keyLen)
+        {
+            m_key[m_keyLen] = c;
+            ++m_keyLen;
+        }
+        else
+        {
+            m_isKeyTruncated = true;
+        }
+    }
+}
+
+bool JsonStreamFilter::parseValueStart(char c)
+{
+    bool    isConsumed  = true;
+    bool    isElement   = (0U < m_depth) && (false == m_levels[m_depth - 1U].isObject);
+
+    /* The separator of a object member is written together with its key. */
+    if ((true == m_isValueKept) &&
+        (true == isElement))
+    {
+        writeSeparator();
+    }
+
+    if (false == m_isValueKept)
+    {
+        isConsumed = startRaw(c, false);
+    }
+    /* Without filter everything is kept. */
+    else if ((true == isAllowedAll(m_valueFilter)) ||
+             ((0U == m_depth) && (true == m_valueFilter.isNull())))
+    {
+        isConsumed = startRaw(c, true);
+    }
+    else if ((true == m_valueFilter.is<JsonObjectConst>()) &&
+             ('{' == c))
+    {
+        startLevel(m_valueFilter, true);
+    }
+    else if ((true == m_valueFilter.is<JsonArrayConst>()) &&
+             ('[' == c))
+    {
+        startLevel(m_valueFilter[0], false);
+    }
+    /* Value type doesn't match to the filter. */
+    else
+    {
+        write("null", 4U);
+        isConsumed = startRaw(c, false);
+    }
+
+    return isConsumed;
+}
+
+bool JsonStreamFilter::startRaw(char c, bool isKept)
+{
+    m_isRawKept     = isKept;
+    m_isRawString   = false;
+    m_isEscape      = false;
+    m_rawDepth      = 0U;
+    m_state         = STATE_RAW;
+
+    return parseRawChar(c);
+}
+
+void JsonStreamFilter::startLevel(const JsonVariantConst& filter, bool isObject)
+{
+    if (DEPTH_MAX <= m_depth)
+    {
+        m_state = STATE_ERROR;
+    }
+    else
+    {
+        Level& level = m_levels[m_depth];
+
+        level.filter    = filter;
+        level.isObject  = isObject;
+        level.isFirst   = true;
+        ++m_depth;
+
+        if (true == isObject)
+        {
+            write("{", 1U);
+            m_state = STATE_KEY;
+        }
+        else
+        {
+            write("[", 1U);
+            selectValueFilter();
+            m_state = STATE_VALUE;
+        }
+    }
+}
+
+void JsonStreamFilter::finishLevel(char c)
+{
+    write(&c, 1U);
+    --m_depth;
+    finishValue();
+}
+
+bool JsonStreamFilter::parseRawChar(char c)
+{
+    bool isConsumed = true;
+
+    if (true == m_isRawString)
+    {
+        if (true == m_isRawKept)
+        {
+            write(&c, 1U);
+        }
+
+        if (true == m_isEscape)
+        {
+            m_isEscape = false;
+        }
+        else if ('\\' == c)
+        {
+            m_isEscape = true;
+        }
+        else if ('"' == c)
+        {
+            m_isRawString = false;
+
+            if (0U == m_rawDepth)
+            {
+                finishValue();
+            }
+        }
+    }
+    /* Whitespace outside of strings is dropped, but it terminates a literal. */
+    else if (true == isWhitespace(c))
+    {
+        if (0U == m_rawDepth)
+        {
+            finishValue();
+            isConsumed = false;
+        }
+    }
+    /* A separator or closing bracket terminates a literal on top level. */
+    else if ((0U == m_rawDepth) &&
+             ((',' == c) || ('}' == c) || (']' == c)))
+    {
+        finishValue();
+        isConsumed = false;
+    }
+    else
+    {
+        if (true == m_isRawKept)
+        {
+            write(&c, 1U);
+        }
+
+        if ('"' == c)
+        {
+            m_isRawString = true;
+        }
+        else if (('{' == c) || ('[' == c))
+        {
+            ++m_rawDepth;
+        }
+        else if (('}' == c) || (']' == c))
+        {
+            --m_rawDepth;
+
+            if (0U == m_rawDepth)
+            {
+                finishValue();
+            }
+        }
+    }
+
+    return isConsumed;
+}
+
+void JsonStreamFilter::selectValueFilter()
+{
+    const Level& level = m_levels[m_depth - 1U];
+
+    if (false == level.isObject)
+    {
+        m_valueFilter = level.filter;
+    }
+    else
+    {
+        if (false == m_isKeyTruncated)
+        {
+            m_valueFilter = level.filter[static_cast<const char*>(m_key)];
+        }
+
+        if ((true == m_isKeyTruncated) ||
+            (true == m_valueFilter.isNull()))
+        {
+            m_valueFilter = level.filter["*"];
+        }
+    }
+
+    m_isValueKept = isAllowed(m_valueFilter);
+}
+
+void JsonStreamFilter::finishValue()
+{
+    if (0U == m_depth)
+    {
+        m_state = STATE_DONE;
+    }
+    else
+    {
+        m_state = STATE_NEXT;
+    }
+}
+
+void JsonStreamFilter::writeSeparator()
+{
+    Level& level = m_levels[m_depth - 1U];
+
+    if (false == level.isFirst)
+    {
+        write(",", 1U);
+    }
+
+    level.isFirst = false;
+}
+
+void JsonStreamFilter::write(const char* data, size_t size)
+{
+    if (false == m_output.append(reinterpret_cast<const uint8_t*>(data), size))
+    {
+        m_isOutputOverflow = true;
+    }
+}
+
+bool JsonStreamFilter::isAllowed(const JsonVariantConst& filter)
+{
+    return (true == isAllowedAll(filter)) ||
+           (true == filter.is<JsonObjectConst>()) ||
+           (true == filter.is<JsonArrayConst>());
+}
+
+bool JsonStreamFilter::isAllowedAll(const JsonVariantConst& filter)
+{
+    return (true == filter.is<bool>()) &&
+           (true == filter.as<bool>());
+}
+
+bool JsonStreamFilter::isWhitespace(char c)
+{
+    return (' ' == c) || ('\t' == c) || ('\r' == c) || ('\n' == c);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,317 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming JSON filter
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __JSON_STREAM_FILTER_H__
+#define __JSON_STREAM_FILTER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <ArduinoJson.h>
+
+#include "GrowBuffer.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Filters a JSON document, which is received in several parts, e.g. TCP
+ * segments of a HTTP response body. The parts are parsed as soon as they
+ * arrive and only the filtered JSON text is kept. The filter follows the
+ * rules of the ArduinoJson filter (DeserializationOption::Filter), incl.
+ * the "*" wildcard key and the first array element as element filter.
+ *
+ * After the document is complete, the filtered JSON text can be
+ * deserialized with the usual deserializeJson(). The required memory is
+ * therefore bounded by the filtered result and not by the whole document.
+ */
+class JsonStreamFilter
+{
+public:
+
+    /** Default max. size of the filtered JSON text in byte. */
+    static const size_t DEFAULT_MAX_OUTPUT_SIZE = 2048U;
+
+    /** Max. supported nesting depth of filtered objects and arrays. */
+    static const size_t DEPTH_MAX               = 8U;
+
+    /** Max. key length in byte. Longer keys only match the wildcard. */
+    static const size_t KEY_SIZE_MAX            = 32U;
+
+    /**
+     * Constructs the filter. The filter document is copied.
+     *
+     * @param[in] filter        Filter document, see ArduinoJson filter.
+     * @param[in] maxOutputSize Max. size of the filtered JSON text in byte.
+     */
+    JsonStreamFilter(const JsonDocument& filter, size_t maxOutputSize = DEFAULT_MAX_OUTPUT_SIZE);
+
+    /**
+     * Destroys the filter.
+     */
+    ~JsonStreamFilter()
+    {
+    }
+
+    /**
+     * Reset the parser to be ready for the next document.
+     */
+    void reset();
+
+    /**
+     * Parse the next part of the JSON document.
+     *
+     * @param[in] data  JSON document part
+     * @param[in] size  Part size in byte
+     *
+     * @return If successful parsed, it will return true. If the document is
+     *          invalid or the filtered text doesn't fit, it will return false.
+     */
+    bool parse(const uint8_t* data, size_t size);
+
+    /**
+     * Is the JSON document complete?
+     *
+     * @return If the root value is complete parsed, it will return true otherwise false.
+     */
+    bool isComplete() const
+    {
+        return (STATE_DONE == m_state);
+    }
+
+    /**
+     * Did a parse error happen?
+     *
+     * @return If an error happened, it will return true otherwise false.
+     */
+    bool isError() const
+    {
+        return (STATE_ERROR == m_state);
+    }
+
+    /**
+     * Get the filtered JSON text. It is not null-terminated.
+     *
+     * @return Filtered JSON text
+     */
+    const char* getOutput() const
+    {
+        return reinterpret_cast<const char*>(m_output.getData());
+    }
+
+    /**
+     * Get the size of the filtered JSON text.
+     *
+     * @return Size in byte
+     */
+    size_t getOutputSize() const
+    {
+        return m_output.getSize();
+    }
+
+private:
+
+    /** Parser states */
+    enum State
+    {
+        STATE_VALUE = 0,    /**< Value expected */
+        STATE_KEY,          /**< Object key or object end expected */
+        STATE_KEY_STRING,   /**< Inside object key */
+        STATE_COLON,        /**< Colon after key expected */
+        STATE_NEXT,         /**< Separator or container end expected */
+        STATE_RAW,          /**< Inside a value, which is kept or skipped completely. */
+        STATE_DONE,         /**< Document complete */
+        STATE_ERROR         /**< Parse error */
+    };
+
+    /** A filtered object or array. */
+    struct Level
+    {
+        JsonVariantConst    filter;     /**< Filter for the object members, resp. array elements. */
+        bool                isObject;   /**< Is it a object (true) or array (false)? */
+        bool                isFirst;    /**< No member/element was written yet. */
+    };
+
+    DynamicJsonDocument m_filter;               /**< Filter document */
+    GrowBuffer          m_output;               /**< Filtered JSON text */
+    bool                m_isOutputOverflow;     /**< Filtered JSON text doesn't fit into the output. */
+    State               m_state;                /**< Parser state */
+    Level               m_levels[DEPTH_MAX];    /**< Filtered objects and arrays */
+    size_t              m_depth;                /**< Number of filtered objects and arrays */
+    JsonVariantConst    m_valueFilter;          /**< Filter of the next value */
+    bool                m_isValueKept;          /**< Is the next value written to the output? */
+    char                m_key[KEY_SIZE_MAX];    /**< Current object key */
+    size_t              m_keyLen;               /**< Current object key length */
+    bool                m_isKeyTruncated;       /**< Is the current object key truncated? */
+    bool                m_isEscape;             /**< Is the next string character escaped? */
+    bool                m_isRawKept;            /**< Is the raw value written to the output? */
+    bool                m_isRawString;          /**< Inside a string of a raw value? */
+    size_t              m_rawDepth;             /**< Nesting depth inside a raw value */
+
+    JsonStreamFilter();
+    JsonStreamFilter(const JsonStreamFilter& filter);
+    JsonStreamFilter& operator=(const JsonStreamFilter& filter);
+
+    /**
+     * Parse a single character.
+     *
+     * @param[in] c Character
+     *
+     * @return If the character is consumed, it will return true. If it must
+     *          be parsed again in the new state, it will return false.
+     */
+    bool parseChar(char c);
+
+    /**
+     * Parse a single character of a object key.
+     *
+     * @param[in] c Character
+     */
+    void parseKeyChar(char c);
+
+    /**
+     * Parse the start of a value.
+     *
+     * @param[in] c First value character
+     *
+     * @return If the character is consumed, it will return true otherwise false.
+     */
+    bool parseValueStart(char c);
+
+    /**
+     * Start a value, which is kept or skipped completely.
+     *
+     * @param[in] c         First value character
+     * @param[in] isKept    Keep (true) or skip (false) the value.
+     *
+     * @return If the character is consumed, it will return true otherwise false.
+     */
+    bool startRaw(char c, bool isKept);
+
+    /**
+     * Start a filtered object or array.
+     *
+     * @param[in] filter    Filter for the members, resp. elements.
+     * @param[in] isObject  Object (true) or array (false)
+     */
+    void startLevel(const JsonVariantConst& filter, bool isObject);
+
+    /**
+     * Finish the current filtered object or array.
+     *
+     * @param[in] c Closing character
+     */
+    void finishLevel(char c);
+
+    /**
+     * Parse a character inside a value, which is kept or skipped completely.
+     *
+     * @param[in] c Character
+     *
+     * @return If the character is consumed, it will return true otherwise false.
+     */
+    bool parseRawChar(char c);
+
+    /**
+     * Select the filter of the next array element or the next value after
+     * the current object key.
+     */
+    void selectValueFilter();
+
+    /**
+     * Finish the current value and continue with the parent.
+     */
+    void finishValue();
+
+    /**
+     * Write the separator, if the current object or array contains already
+     * a member/element.
+     */
+    void writeSeparator();
+
+    /**
+     * Write data to the filtered JSON text.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     */
+    void write(const char* data, size_t size);
+
+    /**
+     * Does the filter allow the value?
+     *
+     * @param[in] filter    Filter
+     *
+     * @return If allowed, it will return true otherwise false.
+     */
+    static bool isAllowed(const JsonVariantConst& filter);
+
+    /**
+     * Does the filter allow the whole value incl. all children?
+     *
+     * @param[in] filter    Filter
+     *
+     * @return If allowed, it will return true otherwise false.
+     */
+    static bool isAllowedAll(const JsonVariantConst& filter);
+
+    /**
+     * Is the character a whitespace?
+     *
+     * @param[in] c Character
+     *
+     * @return If whitespace, it will return true otherwise false.
+     */
+    static bool isWhitespace(char c);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __JSON_STREAM_FILTER_H__ */
+
+/** @} */
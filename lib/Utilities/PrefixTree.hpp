@@ -0,0 +1,387 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Prefix tree
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __PREFIX_TREE_HPP__
+#define __PREFIX_TREE_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A prefix tree (trie) which maps string keys to values. Keys with a common
+ * prefix share their nodes, therefore a lookup costs O(key length) and is
+ * independent of the number of stored keys.
+ * 
+ * @tparam TValue   Data type of the value
+ */
+template < typename TValue >
+class PrefixTree
+{
+public:
+
+    /**
+     * Create a empty prefix tree.
+     */
+    PrefixTree() :
+        m_root('\0'),
+        m_cnt(0U)
+    {
+    }
+
+    /**
+     * Destroys the prefix tree.
+     */
+    ~PrefixTree()
+    {
+        clear();
+    }
+
+    /**
+     * Insert a key with its value. If the key already exists, its value
+     * will be overwritten.
+     * 
+     * @param[in] key   Key, which must be null-terminated.
+     * @param[in] value Value
+     * 
+     * @return If successful, it will return true otherwise false.
+     */
+    bool insert(const char* key, const TValue& value)
+    {
+        bool    isSuccessful    = true;
+        Node*   node            = &m_root;
+        size_t  idx             = 0U;
+
+        if (nullptr == key)
+        {
+            return false;
+        }
+
+        while((true == isSuccessful) && ('\0' != key[idx]))
+        {
+            Node* child = findChild(node, key[idx]);
+
+            if (nullptr == child)
+            {
+                child = new(std::nothrow) Node(key[idx]);
+
+                if (nullptr == child)
+                {
+                    isSuccessful = false;
+                }
+                else
+                {
+                    child->sibling  = node->child;
+                    node->child     = child;
+                }
+            }
+
+            node = child;
+            ++idx;
+        }
+
+        if (false == isSuccessful)
+        {
+            bool isRemoved = false;
+
+            /* Release the nodes, which were created for the key. */
+            (void)removeNode(&m_root, key, isRemoved);
+        }
+        else
+        {
+            if (false == node->hasValue)
+            {
+                node->hasValue = true;
+                ++m_cnt;
+            }
+
+            node->value = value;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Remove a key and its value.
+     * 
+     * @param[in] key   Key, which must be null-terminated.
+     * 
+     * @return If the key was found and removed, it will return true otherwise false.
+     */
+    bool remove(const char* key)
+    {
+        bool isRemoved = false;
+
+        if (nullptr != key)
+        {
+            (void)removeNode(&m_root, key, isRemoved);
+
+            if (true == isRemoved)
+            {
+                --m_cnt;
+            }
+        }
+
+        return isRemoved;
+    }
+
+    /**
+     * Find the value of a key.
+     * 
+     * @param[in]   key     Key, which must be null-terminated.
+     * @param[out]  value   Value of the key
+     * 
+     * @return If the key is found, it will return true otherwise false.
+     */
+    bool find(const char* key, TValue& value) const
+    {
+        bool isFound = false;
+
+        if (nullptr != key)
+        {
+            isFound = find(key, strlen(key), value);
+        }
+
+        return isFound;
+    }
+
+    /**
+     * Find the value of a key, which is given by its first characters.
+     * This way a part of a string can be used as key without copying it.
+     * 
+     * @param[in]   key     Key, which doesn't need to be null-terminated.
+     * @param[in]   keyLen  Key length in characters
+     * @param[out]  value   Value of the key
+     * 
+     * @return If the key is found, it will return true otherwise false.
+     */
+    bool find(const char* key, size_t keyLen, TValue& value) const
+    {
+        bool        isFound = false;
+        const Node* node    = &m_root;
+        size_t      idx     = 0U;
+
+        if (nullptr == key)
+        {
+            return false;
+        }
+
+        while((nullptr != node) && (keyLen > idx))
+        {
+            node = findChild(node, key[idx]);
+            ++idx;
+        }
+
+        if ((nullptr != node) &&
+            (true == node->hasValue))
+        {
+            value   = node->value;
+            isFound = true;
+        }
+
+        return isFound;
+    }
+
+    /**
+     * Remove all keys.
+     */
+    void clear()
+    {
+        destroyNodes(m_root.child);
+
+        m_root.child    = nullptr;
+        m_root.hasValue = false;
+        m_root.value    = TValue();
+        m_cnt           = 0U;
+    }
+
+    /**
+     * Get the number of stored keys.
+     * 
+     * @return Number of keys
+     */
+    uint32_t getCount() const
+    {
+        return m_cnt;
+    }
+
+private:
+
+    /**
+     * A single tree node, which represents one character of the key.
+     * The children of a node are single linked by its siblings.
+     */
+    struct Node
+    {
+        char    key;        /**< Key character */
+        bool    hasValue;   /**< Is a key ending in this node? */
+        TValue  value;      /**< Value, only valid if a key ends in this node. */
+        Node*   child;      /**< First child node */
+        Node*   sibling;    /**< Next sibling node */
+
+        /**
+         * Constructs a node.
+         * 
+         * @param[in] keyChar   Key character
+         */
+        Node(char keyChar) :
+            key(keyChar),
+            hasValue(false),
+            value(),
+            child(nullptr),
+            sibling(nullptr)
+        {
+        }
+    };
+
+    Node        m_root; /**< Root node, which represents the empty key. */
+    uint32_t    m_cnt;  /**< Number of stored keys. */
+
+    PrefixTree(const PrefixTree& tree);
+    PrefixTree& operator=(const PrefixTree& tree);
+
+    /**
+     * Find the child node with the given key character.
+     * 
+     * @param[in] node      Parent node
+     * @param[in] keyChar   Key character
+     * 
+     * @return If found, it will return the child node otherwise nullptr.
+     */
+    static Node* findChild(const Node* node, char keyChar)
+    {
+        Node* child = node->child;
+
+        while((nullptr != child) && (keyChar != child->key))
+        {
+            child = child->sibling;
+        }
+
+        return child;
+    }
+
+    /**
+     * Remove the value of the key below the given node and release all
+     * nodes on the path, which are not used anymore.
+     * 
+     * @param[in]   node        Node, where the key starts.
+     * @param[in]   key         Remaining key, null-terminated.
+     * @param[out]  isRemoved   Set to true, if a value was removed.
+     * 
+     * @return If the node is not used anymore, it will return true otherwise false.
+     */
+    static bool removeNode(Node* node, const char* key, bool& isRemoved)
+    {
+        if ('\0' == key[0])
+        {
+            if (true == node->hasValue)
+            {
+                node->hasValue  = false;
+                node->value     = TValue();
+                isRemoved       = true;
+            }
+        }
+        else
+        {
+            Node*   prev    = nullptr;
+            Node*   child   = node->child;
+
+            while((nullptr != child) && (key[0] != child->key))
+            {
+                prev    = child;
+                child   = child->sibling;
+            }
+
+            if ((nullptr != child) &&
+                (true == removeNode(child, &key[1], isRemoved)))
+            {
+                if (nullptr == prev)
+                {
+                    node->child = child->sibling;
+                }
+                else
+                {
+                    prev->sibling = child->sibling;
+                }
+
+                delete child;
+            }
+        }
+
+        return (false == node->hasValue) && (nullptr == node->child);
+    }
+
+    /**
+     * Destroy the node, its siblings and all of their children.
+     * 
+     * @param[in] node  Node
+     */
+    static void destroyNodes(Node* node)
+    {
+        while(nullptr != node)
+        {
+            Node* sibling = node->sibling;
+
+            destroyNodes(node->child);
+            delete node;
+
+            node = sibling;
+        }
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PREFIX_TREE_HPP__ */
+
+/** @} */
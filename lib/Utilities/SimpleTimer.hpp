@@ -186,6 +186,35 @@ public:
         return isTimeout;
     }
 
+    /**
+     * Get the remaining time until timeout.
+     * If timer is not running, it will return UINT32_MAX.
+     * If timeout happened, it will return 0.
+     * 
+     * @return Remaining time in ms
+     */
+    uint32_t getRemaining() const
+    {
+        uint32_t remaining = UINT32_MAX;
+
+        if (true == m_isRunning)
+        {
+            remaining = 0U;
+
+            if (false == m_isTimeout)
+            {
+                uint32_t delta = millis() - m_start;
+
+                if (m_duration > delta)
+                {
+                    remaining = m_duration - delta;
+                }
+            }
+        }
+
+        return remaining;
+    }
+
 private:
 
     bool        m_isRunning;    /**< Timer is running or not. */
@@ -198,6 +198,59 @@ public:
         return avg;
     }
 
+    /**
+     * Get the percentile value, determined over the values, which are considered
+     * by the moving average calculation (nearest rank method).
+     * Note, the values are copied and sorted, therefore don't call it in a
+     * time critical context.
+     * 
+     * @param[in] percent   Percent [0; 100]
+     * 
+     * @return Percentile value
+     */
+    T getPercentile(uint8_t percent) const
+    {
+        T           sorted[avgCnt];
+        T           percentile  = zero;
+        uint32_t    idx         = 0U;
+        uint32_t    rank        = 0U;
+
+        if (0U < m_cnt)
+        {
+            if (100U < percent)
+            {
+                percent = 100U;
+            }
+
+            /* Insertion sort, because there are only a few values. */
+            for(idx = 0U; idx < m_cnt; ++idx)
+            {
+                uint32_t    pos     = idx;
+                T           value   = m_values[idx];
+
+                while((0U < pos) && (sorted[pos - 1U] > value))
+                {
+                    sorted[pos] = sorted[pos - 1U];
+                    --pos;
+                }
+
+                sorted[pos] = value;
+            }
+
+            /* Determine the rank and convert it to an array index. */
+            rank = (static_cast<uint32_t>(percent) * m_cnt + 99U) / 100U;
+
+            if (0U < rank)
+            {
+                --rank;
+            }
+
+            percentile = sorted[rank];
+        }
+
+        return percentile;
+    }
+
     /**
      * Get the last updated value.
      * 
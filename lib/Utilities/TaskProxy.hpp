@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <functional>
 #include <Queue.hpp>
 
 /******************************************************************************
@@ -67,11 +68,18 @@ class TaskProxy
 {
 public:
 
+    /**
+     * Prototype of the wakeup function, which is called after a item was
+     * successful sent. Note, it is called in the context of the sender task.
+     */
+    typedef std::function<void(void)> WakeUpFunc;
+
     /**
      * Create the task proxy with a empty queue.
      */
     TaskProxy() :
-        m_queue()
+        m_queue(),
+        m_wakeUpFunc()
     {
         (void)m_queue.create(size);
     }
@@ -94,7 +102,15 @@ public:
      */
     bool send(const T& item)
     {
-        return m_queue.sendToBack(item, waitTimeTicks);
+        bool isSuccessful = m_queue.sendToBack(item, waitTimeTicks);
+
+        if ((true == isSuccessful) &&
+            (nullptr != m_wakeUpFunc))
+        {
+            m_wakeUpFunc();
+        }
+
+        return isSuccessful;
     }
 
     /**
@@ -110,9 +126,33 @@ public:
         return m_queue.receive(&item, waitTimeTicks);
     }
 
+    /**
+     * Is the queue empty?
+     * 
+     * @return If no item is pending, it will return true otherwise false.
+     */
+    bool isEmpty() const
+    {
+        return (0U == m_queue.getItemCount()) ? true : false;
+    }
+
+    /**
+     * Set the wakeup function, which will be called after every successful
+     * sent item. It can be used to notify the receiver about a pending item.
+     * Set it before any item is sent, because it is not protected against
+     * concurrent access.
+     * 
+     * @param[in] wakeUpFunc    Wakeup function
+     */
+    void setWakeUp(const WakeUpFunc& wakeUpFunc)
+    {
+        m_wakeUpFunc = wakeUpFunc;
+    }
+
 private:
 
-    Queue<T>    m_queue;    /**< Queue with elements, used for decoupling from task. */
+    Queue<T>    m_queue;        /**< Queue with elements, used for decoupling from task. */
+    WakeUpFunc  m_wakeUpFunc;   /**< Wakeup function, called after a item was sent. */
 
     TaskProxy(const TaskProxy& proxy);
     TaskProxy& operator=(const TaskProxy& proxy);
@@ -0,0 +1,226 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Time budget
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __TIME_BUDGET_HPP__
+#define __TIME_BUDGET_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Observes the processing duration of a job against its time budget.
+ * It counts the violations and keeps the punishment of a job, which exceeds
+ * its budget repeatedly: skipping it for a number of cycles or disabling it.
+ * A disabled job is not processed anymore, until it is enabled again.
+ */
+class TimeBudget
+{
+public:
+
+    /**
+     * Constructs the time budget observer in initial state.
+     */
+    TimeBudget() :
+        m_violations(0U),
+        m_violationCnt(0U),
+        m_skipCnt(0U),
+        m_isDisabled(false)
+    {
+    }
+
+    /**
+     * Destroys the time budget observer.
+     */
+    ~TimeBudget()
+    {
+    }
+
+    /**
+     * Check a measured duration against the time budget.
+     *
+     * @param[in] duration  Measured duration
+     * @param[in] budget    Time budget
+     * @param[in] limit     Max. number of violations per period
+     *
+     * @return If the limit is reached by this violation, it will return true otherwise false.
+     */
+    bool check(uint32_t duration, uint32_t budget, uint32_t limit)
+    {
+        bool isLimitReached = false;
+
+        if (budget < duration)
+        {
+            ++m_violations;
+            ++m_violationCnt;
+
+            /* Report only once per period. */
+            isLimitReached = (limit == m_violationCnt);
+        }
+
+        return isLimitReached;
+    }
+
+    /**
+     * Start the next period, which resets the violation counter of the
+     * current period.
+     */
+    void nextPeriod()
+    {
+        m_violationCnt = 0U;
+    }
+
+    /**
+     * Skip the job for the given number of cycles.
+     *
+     * @param[in] cycles    Number of cycles
+     */
+    void skip(uint32_t cycles)
+    {
+        m_skipCnt = cycles;
+    }
+
+    /**
+     * Disable the job, until it is enabled again.
+     */
+    void disable()
+    {
+        m_isDisabled = true;
+    }
+
+    /**
+     * Shall the job be processed in this cycle?
+     * During skipping, every call consumes one cycle. A job disabled by
+     * its time budget is processed again, after it was enabled e.g. by
+     * the user.
+     *
+     * @param[in] isEnabled Is the job enabled?
+     *
+     * @return If the job shall be processed, it will return true otherwise false.
+     */
+    bool isProcessingAllowed(bool isEnabled)
+    {
+        bool isAllowed = false;
+
+        if (true == m_isDisabled)
+        {
+            if (true == isEnabled)
+            {
+                m_isDisabled    = false;
+                m_violationCnt  = 0U;
+                isAllowed       = true;
+            }
+        }
+        else if (0U < m_skipCnt)
+        {
+            --m_skipCnt;
+        }
+        else
+        {
+            isAllowed = true;
+        }
+
+        return isAllowed;
+    }
+
+    /**
+     * Get the number of violations since the last reset.
+     *
+     * @return Number of violations
+     */
+    uint32_t getViolations() const
+    {
+        return m_violations;
+    }
+
+    /**
+     * Is the job skipped?
+     *
+     * @return If skipped, it will return true otherwise false.
+     */
+    bool isSkipped() const
+    {
+        return (0U < m_skipCnt);
+    }
+
+    /**
+     * Is the job disabled by its time budget?
+     *
+     * @return If disabled, it will return true otherwise false.
+     */
+    bool isDisabled() const
+    {
+        return m_isDisabled;
+    }
+
+    /**
+     * Reset to initial state, e.g. after the job changed.
+     */
+    void reset()
+    {
+        m_violations    = 0U;
+        m_violationCnt  = 0U;
+        m_skipCnt       = 0U;
+        m_isDisabled    = false;
+    }
+
+private:
+
+    uint32_t    m_violations;   /**< Number of violations */
+    uint32_t    m_violationCnt; /**< Number of violations in the current period */
+    uint32_t    m_skipCnt;      /**< Number of cycles, the job will be skipped */
+    bool        m_isDisabled;   /**< Is the job disabled by its time budget? */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __TIME_BUDGET_HPP__ */
+
+/** @} */
@@ -303,6 +303,19 @@ public:
         return status;
     }
 
+    /**
+     * Is the text static shown? This is the case if the text is not scrolling
+     * and no new text is pending.
+     *
+     * @return If the text is static, it will return true otherwise false.
+     */
+    bool isStatic() const
+    {
+        return ((false == m_isNewTextAvailable) &&
+                (false == m_handleNewText) &&
+                (false == m_scrollInfo.isEnabled));
+    }
+
     /** Default text color */
     static const uint32_t   DEFAULT_TEXT_COLOR      = ColorDef::WHITE;
 
@@ -0,0 +1,335 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pool of JSON document memory
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "JsonDocPool.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Configuration of a size class.
+ */
+struct SizeClassCfg
+{
+    size_t  blockSize;  /**< Block size in byte */
+    uint8_t blockCnt;   /**< Number of blocks, max. 32 */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/**
+ * Size classes, ordered by block size. They cover the JSON document sizes,
+ * which are used most by the web request handlers and the plugin
+ * configuration. The reservation is kept small (4 kB), larger and
+ * concurrent requests are served by the heap. Adapt it according to the
+ * hits and misses, reported by the REST API.
+ */
+static const SizeClassCfg   gSizeClassCfg[JsonDocPool::SIZE_CLASS_CNT] =
+{
+    { 512U,     2U },
+    { 1024U,    1U },
+    { 2048U,    1U }
+};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool JsonDocPool::begin()
+{
+    bool                isSuccessful    = true;
+    uint8_t             classIdx        = 0U;
+    MutexGuard<Mutex>   guard(m_mutex);
+
+    for(classIdx = 0U; classIdx < SIZE_CLASS_CNT; ++classIdx)
+    {
+        SizeClass& sizeClass = m_sizeClasses[classIdx];
+
+        if (nullptr == sizeClass.area)
+        {
+            sizeClass.area = static_cast<uint8_t*>(malloc(sizeClass.statistics.blockSize * sizeClass.statistics.blockCnt));
+
+            if (nullptr == sizeClass.area)
+            {
+                LOG_ERROR("Couldn't reserve %u JSON document blocks with %u bytes.", sizeClass.statistics.blockCnt, sizeClass.statistics.blockSize);
+                isSuccessful = false;
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+void* JsonDocPool::allocate(size_t size)
+{
+    void* ptr = nullptr;
+
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        uint8_t             classIdx    = 0U;
+        uint8_t             idx         = 0U;
+
+        /* Find the smallest size class, which fits. */
+        while((SIZE_CLASS_CNT > classIdx) && (size > m_sizeClasses[classIdx].statistics.blockSize))
+        {
+            ++classIdx;
+        }
+
+        /* If all blocks of the size class are in use, a larger one is used. */
+        idx = classIdx;
+        while((SIZE_CLASS_CNT > idx) && (nullptr == ptr))
+        {
+            SizeClass&  sizeClass   = m_sizeClasses[idx];
+            uint8_t     blockIdx    = 0U;
+
+            if (nullptr != sizeClass.area)
+            {
+                while((sizeClass.statistics.blockCnt > blockIdx) && (0U != (sizeClass.usedMask & (1U << blockIdx))))
+                {
+                    ++blockIdx;
+                }
+
+                if (sizeClass.statistics.blockCnt > blockIdx)
+                {
+                    sizeClass.usedMask |= (1U << blockIdx);
+                    ptr = &sizeClass.area[blockIdx * sizeClass.statistics.blockSize];
+
+                    ++sizeClass.statistics.hits;
+                    ++sizeClass.statistics.used;
+
+                    if (sizeClass.statistics.highWater < sizeClass.statistics.used)
+                    {
+                        sizeClass.statistics.highWater = sizeClass.statistics.used;
+                    }
+                }
+            }
+
+            ++idx;
+        }
+
+        if (nullptr == ptr)
+        {
+            if (SIZE_CLASS_CNT <= classIdx)
+            {
+                ++m_oversizeCnt;
+            }
+            else
+            {
+                ++m_sizeClasses[classIdx].statistics.misses;
+            }
+        }
+    }
+
+    /* Fallback */
+    if (nullptr == ptr)
+    {
+        ptr = malloc(size);
+    }
+
+    return ptr;
+}
+
+void JsonDocPool::deallocate(void* ptr)
+{
+    if (nullptr != ptr)
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        uint8_t             blockIdx    = 0U;
+        SizeClass*          sizeClass   = findSizeClass(ptr, blockIdx);
+
+        if (nullptr == sizeClass)
+        {
+            free(ptr);
+        }
+        else
+        {
+            sizeClass->usedMask &= ~(1U << blockIdx);
+            --sizeClass->statistics.used;
+        }
+    }
+}
+
+void* JsonDocPool::reallocate(void* ptr, size_t size)
+{
+    void*       newPtr      = nullptr;
+    size_t      blockSize   = 0U;
+
+    if (nullptr == ptr)
+    {
+        newPtr = allocate(size);
+    }
+    else
+    {
+        {
+            MutexGuard<Mutex>   guard(m_mutex);
+            uint8_t             blockIdx    = 0U;
+            SizeClass*          sizeClass   = findSizeClass(ptr, blockIdx);
+
+            if (nullptr != sizeClass)
+            {
+                blockSize = sizeClass->statistics.blockSize;
+            }
+        }
+
+        /* Not pooled? */
+        if (0U == blockSize)
+        {
+            newPtr = realloc(ptr, size);
+        }
+        /* The block is large enough. */
+        else if (blockSize >= size)
+        {
+            newPtr = ptr;
+        }
+        else
+        {
+            newPtr = allocate(size);
+
+            if (nullptr != newPtr)
+            {
+                memcpy(newPtr, ptr, blockSize);
+                deallocate(ptr);
+            }
+        }
+    }
+
+    return newPtr;
+}
+
+bool JsonDocPool::getStatistics(uint8_t sizeClass, Statistics& statistics) const
+{
+    bool isSuccessful = false;
+
+    if (SIZE_CLASS_CNT > sizeClass)
+    {
+        MutexGuard<Mutex> guard(m_mutex);
+
+        statistics      = m_sizeClasses[sizeClass].statistics;
+        isSuccessful    = true;
+    }
+
+    return isSuccessful;
+}
+
+uint32_t JsonDocPool::getOversizeCnt() const
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    uint32_t            oversizeCnt = m_oversizeCnt;
+
+    return oversizeCnt;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+JsonDocPool::JsonDocPool() :
+    m_sizeClasses(),
+    m_oversizeCnt(0U),
+    m_mutex()
+{
+    uint8_t classIdx = 0U;
+
+    for(classIdx = 0U; classIdx < SIZE_CLASS_CNT; ++classIdx)
+    {
+        SizeClass& sizeClass = m_sizeClasses[classIdx];
+
+        sizeClass.statistics.blockSize  = gSizeClassCfg[classIdx].blockSize;
+        sizeClass.statistics.blockCnt   = gSizeClassCfg[classIdx].blockCnt;
+        sizeClass.statistics.used       = 0U;
+        sizeClass.statistics.highWater  = 0U;
+        sizeClass.statistics.hits       = 0U;
+        sizeClass.statistics.misses     = 0U;
+        sizeClass.area                  = nullptr;
+        sizeClass.usedMask              = 0U;
+    }
+
+    (void)m_mutex.create();
+}
+
+JsonDocPool::SizeClass* JsonDocPool::findSizeClass(const void* ptr, uint8_t& blockIdx)
+{
+    SizeClass*      sizeClass   = nullptr;
+    const uint8_t*  bytePtr     = static_cast<const uint8_t*>(ptr);
+    uint8_t         classIdx    = 0U;
+
+    while((SIZE_CLASS_CNT > classIdx) && (nullptr == sizeClass))
+    {
+        SizeClass&  candidate   = m_sizeClasses[classIdx];
+        size_t      areaSize    = candidate.statistics.blockSize * candidate.statistics.blockCnt;
+
+        if ((nullptr != candidate.area) &&
+            (candidate.area <= bytePtr) &&
+            (&candidate.area[areaSize] > bytePtr))
+        {
+            sizeClass   = &candidate;
+            blockIdx    = static_cast<uint8_t>((bytePtr - candidate.area) / candidate.statistics.blockSize);
+        }
+
+        ++classIdx;
+    }
+
+    return sizeClass;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
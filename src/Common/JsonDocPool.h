@@ -0,0 +1,250 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pool of JSON document memory
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __JSON_DOC_POOL_H__
+#define __JSON_DOC_POOL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <ArduinoJson.h>
+#include <Mutex.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A pool of pre-allocated memory blocks for JSON documents, organized in
+ * size classes. A request is served by the smallest free block, which fits.
+ * If no block is available, the memory is allocated on the heap as fallback.
+ *
+ * The blocks are reserved once, therefore short living JSON documents in
+ * the web request handlers don't fragment the heap.
+ */
+class JsonDocPool
+{
+public:
+
+    /** Number of size classes. */
+    static const uint8_t SIZE_CLASS_CNT = 3U;
+
+    /**
+     * Statistics of a single size class.
+     */
+    struct Statistics
+    {
+        size_t      blockSize;  /**< Block size in byte */
+        uint8_t     blockCnt;   /**< Number of blocks */
+        uint8_t     used;       /**< Number of blocks currently in use */
+        uint8_t     highWater;  /**< Max. number of blocks in use at the same time */
+        uint32_t    hits;       /**< Number of requests served by a block of this class */
+        uint32_t    misses;     /**< Number of requests for this class, served by the heap */
+    };
+
+    /**
+     * Get JSON document pool instance.
+     *
+     * @return JSON document pool instance
+     */
+    static JsonDocPool& getInstance()
+    {
+        static JsonDocPool instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Reserve the memory blocks of all size classes.
+     * Call it once as early as possible, as long as the heap is not fragmented.
+     * Until then every request is served by the heap.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Allocate memory for a JSON document.
+     *
+     * @param[in] size  Size in byte
+     *
+     * @return If successful, it will return the memory otherwise nullptr.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * Release memory of a JSON document.
+     *
+     * @param[in] ptr   Memory, which was allocated by allocate().
+     */
+    void deallocate(void* ptr);
+
+    /**
+     * Change the size of the memory of a JSON document.
+     *
+     * @param[in] ptr   Memory, which was allocated by allocate().
+     * @param[in] size  New size in byte
+     *
+     * @return If successful, it will return the memory otherwise nullptr.
+     */
+    void* reallocate(void* ptr, size_t size);
+
+    /**
+     * Get statistics of a size class.
+     *
+     * @param[in]   sizeClass   Size class index [0; SIZE_CLASS_CNT - 1]
+     * @param[out]  statistics  Statistics
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool getStatistics(uint8_t sizeClass, Statistics& statistics) const;
+
+    /**
+     * Get the number of requests, which are greater than the largest block
+     * and were therefore served by the heap.
+     *
+     * @return Number of oversized requests
+     */
+    uint32_t getOversizeCnt() const;
+
+private:
+
+    /**
+     * A size class with its blocks. The blocks are placed in a single
+     * memory area one after another.
+     */
+    struct SizeClass
+    {
+        Statistics  statistics; /**< Statistics, which contains the block size and number of blocks too. */
+        uint8_t*    area;       /**< Memory area of all blocks */
+        uint32_t    usedMask;   /**< Every bit marks a used block. */
+    };
+
+    SizeClass       m_sizeClasses[SIZE_CLASS_CNT];  /**< Size classes, ordered by block size. */
+    uint32_t        m_oversizeCnt;                  /**< Number of requests, which are greater than the largest block. */
+    mutable Mutex   m_mutex;                        /**< Mutex to protect against concurrent access. */
+
+    /**
+     * Constructs the JSON document pool.
+     */
+    JsonDocPool();
+
+    /**
+     * Destroys the JSON document pool.
+     */
+    ~JsonDocPool()
+    {
+        /* Will never be called. */
+    }
+
+    JsonDocPool(const JsonDocPool& pool);
+    JsonDocPool& operator=(const JsonDocPool& pool);
+
+    /**
+     * Find the size class of a pooled memory block.
+     *
+     * @param[in]   ptr         Memory
+     * @param[out]  blockIdx    Index of the block in the size class
+     *
+     * @return If the memory is pooled, it will return its size class otherwise nullptr.
+     */
+    SizeClass* findSizeClass(const void* ptr, uint8_t& blockIdx);
+};
+
+/**
+ * ArduinoJson allocator, which uses the JSON document pool.
+ */
+struct JsonDocPoolAllocator
+{
+    /**
+     * Allocate memory.
+     *
+     * @param[in] size  Size in byte
+     *
+     * @return If successful, it will return the memory otherwise nullptr.
+     */
+    void* allocate(size_t size)
+    {
+        return JsonDocPool::getInstance().allocate(size);
+    }
+
+    /**
+     * Release memory.
+     *
+     * @param[in] ptr   Memory
+     */
+    void deallocate(void* ptr)
+    {
+        JsonDocPool::getInstance().deallocate(ptr);
+    }
+
+    /**
+     * Change the size of the memory.
+     *
+     * @param[in] ptr   Memory
+     * @param[in] size  New size in byte
+     *
+     * @return If successful, it will return the memory otherwise nullptr.
+     */
+    void* reallocate(void* ptr, size_t size)
+    {
+        return JsonDocPool::getInstance().reallocate(ptr, size);
+    }
+};
+
+/**
+ * JSON document, which leases its memory from the JSON document pool.
+ * The memory is given back to the pool, as soon as the document is destroyed.
+ * Use it like a DynamicJsonDocument.
+ */
+typedef BasicJsonDocument<JsonDocPoolAllocator> PooledJsonDocument;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __JSON_DOC_POOL_H__ */
+
+/** @} */
@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "JsonFile.h"
 
+#include <new>
+
 #define STREAMUTILS_ENABLE_EEPROM 0
 #include <StreamUtils.h>
 
@@ -57,26 +59,47 @@
  * Local Variables
  *****************************************************************************/
 
+/* Initialize pending writes. */
+JsonFile::PendingWrite* JsonFile::m_pendingWrites[PENDING_WRITES_MAX]  = { nullptr };
+
+/* Initialize deferring task. */
+TaskHandle_t            JsonFile::m_deferringTask                       = nullptr;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 bool JsonFile::load(const String& fileName, JsonDocument& doc)
 {
-    bool    isSuccessful    = false;
-    File    fd              = m_fs.open(fileName, "r");
+    bool            isSuccessful    = false;
+    PendingWrite*   pendingWrite    = (true == isDeferred()) ? findPendingWrite(fileName) : nullptr;
 
-    if (true == fd)
+    /* A pending write is newer than the file content. */
+    if (nullptr != pendingWrite)
     {
-        ReadBufferingStream     bufferedStream(fd, CHUNK_SIZE);
-        DeserializationError    error   = deserializeJson(doc, bufferedStream);
+        DeserializationError error = deserializeJson(doc, pendingWrite->content);
 
         if (DeserializationError::Ok == error.code())
         {
             isSuccessful = true;
         }
+    }
+    else
+    {
+        File fd = m_fs.open(fileName, "r");
 
-        fd.close();
+        if (true == fd)
+        {
+            ReadBufferingStream     bufferedStream(fd, CHUNK_SIZE);
+            DeserializationError    error   = deserializeJson(doc, bufferedStream);
+
+            if (DeserializationError::Ok == error.code())
+            {
+                isSuccessful = true;
+            }
+
+            fd.close();
+        }
     }
 
     return isSuccessful;
@@ -84,26 +107,82 @@ bool JsonFile::load(const String& fileName, JsonDocument& doc)
 
 bool JsonFile::save(const String& fileName, const JsonDocument& doc)
 {
-    bool    isSuccessful    = false;
-    File    fd              = m_fs.open(fileName, "w");
+    bool isSuccessful = false;
 
-    if (true == fd)
+    if ((true == isDeferred()) &&
+        (true == deferSave(fileName, doc)))
     {
-        WriteBufferingStream    bufferedStream(fd, CHUNK_SIZE);
-        size_t                  write   = measureJsonPretty(doc);
-        
-        if (write == serializeJsonPretty(doc, bufferedStream))
+        isSuccessful = true;
+    }
+    else
+    {
+        File fd = m_fs.open(fileName, "w");
+
+        if (true == fd)
         {
-            isSuccessful = true;
+            WriteBufferingStream    bufferedStream(fd, CHUNK_SIZE);
+            size_t                  write   = measureJsonPretty(doc);
+            
+            if (write == serializeJsonPretty(doc, bufferedStream))
+            {
+                isSuccessful = true;
+            }
+
+            bufferedStream.flush();
+            fd.close();
         }
+    }
 
-        bufferedStream.flush();
-        fd.close();
+    return isSuccessful;
+}
+
+bool JsonFile::beginDeferredWrites()
+{
+    bool isSuccessful = false;
+
+    if (nullptr == m_deferringTask)
+    {
+        m_deferringTask = xTaskGetCurrentTaskHandle();
+        isSuccessful    = true;
     }
 
     return isSuccessful;
 }
 
+uint32_t JsonFile::endDeferredWrites()
+{
+    uint32_t    cnt = 0U;
+    uint8_t     idx = 0U;
+
+    if (true == isDeferred())
+    {
+        for(idx = 0U; idx < PENDING_WRITES_MAX; ++idx)
+        {
+            PendingWrite* pendingWrite = m_pendingWrites[idx];
+
+            if (nullptr != pendingWrite)
+            {
+                File fd = pendingWrite->fs.open(pendingWrite->fileName, "w");
+
+                if (true == fd)
+                {
+                    (void)fd.print(pendingWrite->content);
+                    fd.close();
+
+                    ++cnt;
+                }
+
+                delete pendingWrite;
+                m_pendingWrites[idx] = nullptr;
+            }
+        }
+
+        m_deferringTask = nullptr;
+    }
+
+    return cnt;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -112,6 +191,62 @@ bool JsonFile::save(const String& fileName, const JsonDocument& doc)
  * Private Methods
  *****************************************************************************/
 
+bool JsonFile::isDeferred()
+{
+    return (nullptr != m_deferringTask) && (xTaskGetCurrentTaskHandle() == m_deferringTask);
+}
+
+JsonFile::PendingWrite* JsonFile::findPendingWrite(const String& fileName)
+{
+    PendingWrite*   pendingWrite    = nullptr;
+    uint8_t         idx             = 0U;
+
+    while((PENDING_WRITES_MAX > idx) && (nullptr == pendingWrite))
+    {
+        if ((nullptr != m_pendingWrites[idx]) &&
+            (fileName == m_pendingWrites[idx]->fileName))
+        {
+            pendingWrite = m_pendingWrites[idx];
+        }
+
+        ++idx;
+    }
+
+    return pendingWrite;
+}
+
+bool JsonFile::deferSave(const String& fileName, const JsonDocument& doc)
+{
+    PendingWrite* pendingWrite = findPendingWrite(fileName);
+
+    /* Not pending yet? */
+    if (nullptr == pendingWrite)
+    {
+        uint8_t idx = 0U;
+
+        while((PENDING_WRITES_MAX > idx) && (nullptr != m_pendingWrites[idx]))
+        {
+            ++idx;
+        }
+
+        if (PENDING_WRITES_MAX > idx)
+        {
+            pendingWrite = new(std::nothrow) PendingWrite(m_fs, fileName);
+
+            m_pendingWrites[idx] = pendingWrite;
+        }
+    }
+
+    /* The last write wins. */
+    if (nullptr != pendingWrite)
+    {
+        pendingWrite->content.clear();
+        (void)serializeJsonPretty(doc, pendingWrite->content);
+    }
+
+    return (nullptr != pendingWrite);
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
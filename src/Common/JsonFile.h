@@ -45,6 +45,8 @@
  *****************************************************************************/
 #include <ArduinoJson.h>
 #include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 /******************************************************************************
  * Macros
@@ -109,6 +111,25 @@ public:
      */
     bool save(const String& fileName, const JsonDocument& doc);
 
+    /**
+     * Defer all JSON file writes of the calling task, until endDeferredWrites()
+     * is called. Several writes to the same file are coalesced to a single
+     * write. Loading a file with a pending write provides the pending content.
+     *
+     * Only one task can defer writes at the same time. Writes of other tasks
+     * are not affected.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool beginDeferredWrites();
+
+    /**
+     * Write all pending files and stop deferring the writes of the calling task.
+     *
+     * @return Number of written files.
+     */
+    static uint32_t endDeferredWrites();
+
 protected:
 
 private:
@@ -119,8 +140,66 @@ private:
      */
     static const size_t CHUNK_SIZE  = 64U;
 
+    /**
+     * Max. number of pending writes. If exceeded, further files are
+     * written immediately.
+     */
+    static const uint8_t PENDING_WRITES_MAX = 8U;
+
+    /**
+     * A deferred JSON file write.
+     */
+    struct PendingWrite
+    {
+        FS      fs;         /**< Filesystem */
+        String  fileName;   /**< Name of the JSON file */
+        String  content;    /**< Serialized JSON document */
+
+        /**
+         * Constructs a pending write.
+         *
+         * @param[in] fileSystem    Filesystem
+         * @param[in] name          Name of the JSON file
+         */
+        PendingWrite(const FS& fileSystem, const String& name) :
+            fs(fileSystem),
+            fileName(name),
+            content()
+        {
+        }
+    };
+
+    static PendingWrite*    m_pendingWrites[PENDING_WRITES_MAX];    /**< Pending writes */
+    static TaskHandle_t     m_deferringTask;                        /**< Task, which writes are deferred. */
+
     FS  m_fs;   /**< Filesystem */
 
+    /**
+     * Are the writes of the calling task deferred?
+     *
+     * @return If deferred, it will return true otherwise false.
+     */
+    static bool isDeferred();
+
+    /**
+     * Find the pending write of a file.
+     *
+     * @param[in] fileName  Name of the JSON file
+     *
+     * @return If found, it will return the pending write otherwise nullptr.
+     */
+    static PendingWrite* findPendingWrite(const String& fileName);
+
+    /**
+     * Defer the write of a file, by keeping the serialized JSON document.
+     *
+     * @param[in] fileName  Name of the JSON file.
+     * @param[in] doc       JSON document, which contain the content to save.
+     *
+     * @return If successful deferred, it will return true otherwise false.
+     */
+    bool deferSave(const String& fileName, const JsonDocument& doc);
+
     JsonFile();
     JsonFile& operator=(const JsonFile& jsonFile);
 };
@@ -119,6 +119,12 @@ static const char*  KEY_SCROLL_PAUSE                = "scroll_pause";
 /** NotifyURL key */
 static const char*  KEY_NOTIFY_URL                  = "notify_url";
 
+/** Plugin time budget key */
+static const char*  KEY_TIME_BUDGET                 = "time_budget";
+
+/** Plugin time budget violation policy key */
+static const char*  KEY_TIME_BUDGET_POLICY          = "budget_policy";
+
 /* ---------- Key value pair names ---------- */
 
 /** Wifi network name of key value pair */
@@ -175,6 +181,12 @@ static const char*  NAME_SCROLL_PAUSE               = "Text scroll pause [ms]";
 /** NotifyURL name */
 static const char*  NAME_NOTIFY_URL                 = "URL to be triggered when PIXELIX has connected to a remote network.";
 
+/** Plugin time budget name */
+static const char*  NAME_TIME_BUDGET                = "Plugin time budget per frame [us]";
+
+/** Plugin time budget violation policy name */
+static const char*  NAME_TIME_BUDGET_POLICY         = "Plugin time budget violation: 0 = log, 1 = skip process, 2 = disable slot";
+
 /* ---------- Default values ---------- */
 
 /** Wifi network default value */
@@ -231,6 +243,12 @@ static uint32_t         DEFAULT_SCROLL_PAUSE            = 80U;
 /** NotifyURL default value */
 static const char*     DEFAULT_NOTIFY_URL               = "-";
 
+/** Plugin time budget default value in us */
+static uint32_t         DEFAULT_TIME_BUDGET             = 10000U;
+
+/** Plugin time budget violation policy default value */
+static uint8_t          DEFAULT_TIME_BUDGET_POLICY      = 0U;
+
 /* ---------- Minimum values ---------- */
 
 /** Wifi network SSID min. length. Section 7.3.2.1 of the 802.11-2007 specification. */
@@ -284,6 +302,12 @@ static uint32_t         MIN_VALUE_SCROLL_PAUSE          = 20U;
 /** NotifyURL min. length */
 static const size_t     MIN_VALUE_NOTIFY_URL            = 0U;
 
+/** Plugin time budget minimum value in us */
+static uint32_t         MIN_VALUE_TIME_BUDGET           = 1000U;
+
+/** Plugin time budget violation policy minimum value */
+static uint8_t          MIN_VALUE_TIME_BUDGET_POLICY    = 0U;
+
 /* ---------- Maximum values ---------- */
 
 /** Wifi network SSID max. length. Section 7.3.2.1 of the 802.11-2007 specification. */
@@ -337,6 +361,12 @@ static uint32_t         MAX_VALUE_SCROLL_PAUSE          = 500U;
 /** NotifyURL max. length */
 static const size_t     MAX_VALUE_NOTIFY_URL            = 64U;
 
+/** Plugin time budget maximum value in us */
+static uint32_t         MAX_VALUE_TIME_BUDGET           = 1000000U;
+
+/** Plugin time budget violation policy maximum value */
+static uint8_t          MAX_VALUE_TIME_BUDGET_POLICY    = 2U;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -418,7 +448,9 @@ Settings::Settings() :
     m_maxSlots              (m_preferences, KEY_MAX_SLOTS,              NAME_MAX_SLOTS,             DEFAULT_MAX_SLOTS,              MIN_MAX_SLOTS,                  MAX_MAX_SLOTS),
     m_slotConfig            (m_preferences, KEY_SLOT_CONFIG,            NAME_SLOT_CONFIG,           DEFAULT_SLOT_CONFIG,            MIN_VALUE_SLOT_CONFIG,          MAX_VALUE_SLOT_CONFIG),
     m_scrollPause           (m_preferences, KEY_SCROLL_PAUSE,           NAME_SCROLL_PAUSE,          DEFAULT_SCROLL_PAUSE,           MIN_VALUE_SCROLL_PAUSE,         MAX_VALUE_SCROLL_PAUSE),
-    m_notifyURL             (m_preferences, KEY_NOTIFY_URL,             NAME_NOTIFY_URL,            DEFAULT_NOTIFY_URL,             MIN_VALUE_NOTIFY_URL,           MAX_VALUE_NOTIFY_URL)
+    m_notifyURL             (m_preferences, KEY_NOTIFY_URL,             NAME_NOTIFY_URL,            DEFAULT_NOTIFY_URL,             MIN_VALUE_NOTIFY_URL,           MAX_VALUE_NOTIFY_URL),
+    m_timeBudget            (m_preferences, KEY_TIME_BUDGET,            NAME_TIME_BUDGET,           DEFAULT_TIME_BUDGET,            MIN_VALUE_TIME_BUDGET,          MAX_VALUE_TIME_BUDGET),
+    m_timeBudgetPolicy      (m_preferences, KEY_TIME_BUDGET_POLICY,     NAME_TIME_BUDGET_POLICY,    DEFAULT_TIME_BUDGET_POLICY,     MIN_VALUE_TIME_BUDGET_POLICY,   MAX_VALUE_TIME_BUDGET_POLICY)
 {
     uint8_t idx = 0;
 
@@ -457,6 +489,10 @@ Settings::Settings() :
     m_keyValueList[idx] = &m_scrollPause;
     ++idx;
     m_keyValueList[idx] = &m_notifyURL;
+    ++idx;
+    m_keyValueList[idx] = &m_timeBudget;
+    ++idx;
+    m_keyValueList[idx] = &m_timeBudgetPolicy;
 }
 
 Settings::~Settings()
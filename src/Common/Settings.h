@@ -275,6 +275,27 @@ public:
     {
         return m_notifyURL;
     }
+
+    /**
+     * Get the default plugin time budget per display refresh cycle.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt32& getTimeBudget()
+    {
+        return m_timeBudget;
+    }
+
+    /**
+     * Get the policy, which is applied to plugins which exceed their time budget.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt8& getTimeBudgetPolicy()
+    {
+        return m_timeBudgetPolicy;
+    }
+
     /**
      * Get a list of all key value pairs.
      *
@@ -305,7 +326,7 @@ public:
     KeyValue* getSettingByKey(const char* key);
 
     /** Number of key value pairs. */
-    static const uint8_t KEY_VALUE_PAIR_NUM = 18U;
+    static const uint8_t KEY_VALUE_PAIR_NUM = 20U;
 
 private:
 
@@ -330,6 +351,8 @@ private:
     KeyValueJson    m_slotConfig;           /**< Display slot configuration */
     KeyValueUInt32  m_scrollPause;          /**< Text scroll pause */
     KeyValueString  m_notifyURL;            /**< URL to be triggered when PIXELIX has connected to a remote network. */
+    KeyValueUInt32  m_timeBudget;           /**< Default plugin time budget per display refresh cycle. */
+    KeyValueUInt8   m_timeBudgetPolicy;     /**< Plugin time budget violation policy. */
 
     /**
      * Constructs the settings instance.
@@ -36,20 +36,27 @@
 #include "Settings.h"
 #include "BrightnessCtrl.h"
 #include "PluginMgr.h"
+#include "JsonDocPool.h"
 
 #include <Display.h>
 #include <Logging.h>
 #include <ArduinoJson.h>
 #include <Util.h>
 
-#if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
-#include <StatisticValue.hpp>
-#endif /* (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS) */
-
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
 
+#ifndef CONFIG_DISPLAY_MGR_ENABLE_STATISTICS
+
+/**
+ * Enable the frame time statistics by default after startup.
+ * They can be enabled/disabled during runtime too.
+ */
+#define CONFIG_DISPLAY_MGR_ENABLE_STATISTICS    (0)
+
+#endif  /* CONFIG_DISPLAY_MGR_ENABLE_STATISTICS */
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -58,21 +65,6 @@
  * Types and classes
  *****************************************************************************/
 
-#if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
-
-/**
- * A collection of statistics, which are interesting for debugging purposes.
- */
-struct Statistics
-{
-    StatisticValue<uint32_t, 0U, 10U>   pluginProcessing;
-    StatisticValue<uint32_t, 0U, 10U>   displayUpdate;
-    StatisticValue<uint32_t, 0U, 10U>   total;
-    StatisticValue<uint32_t, 0U, 10U>   refreshPeriod;
-};
-
-#endif /* (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS) */
-
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -93,21 +85,31 @@ bool DisplayMgr::begin()
     uint8_t     maxSlots            = 0U;
     uint8_t     brightnessPercent   = 0U;
     uint16_t    brightness          = 0U;
+    uint8_t     timeBudgetPolicy    = 0U;
     Settings&   settings            = Settings::getInstance();
 
     if (false == settings.open(true))
     {
         maxSlots            = settings.getMaxSlots().getDefault();
         brightnessPercent   = settings.getBrightness().getDefault();
+        m_timeBudget        = settings.getTimeBudget().getDefault();
+        timeBudgetPolicy    = settings.getTimeBudgetPolicy().getDefault();
     }
     else
     {
         maxSlots            = settings.getMaxSlots().getValue();
         brightnessPercent   = settings.getBrightness().getValue();
+        m_timeBudget        = settings.getTimeBudget().getValue();
+        timeBudgetPolicy    = settings.getTimeBudgetPolicy().getValue();
 
         settings.close();
     }
 
+    if (TIME_BUDGET_POLICY_MAX > timeBudgetPolicy)
+    {
+        m_timeBudgetPolicy = static_cast<TimeBudgetPolicy>(timeBudgetPolicy);
+    }
+
     /* Set the display brightness here just once.
      * There is no need to do this in the process() method periodically.
      */
@@ -122,7 +124,11 @@ bool DisplayMgr::begin()
 
         if (0U < m_maxSlots)
         {
-            m_slots = new(std::nothrow) Slot[m_maxSlots];
+            m_slots             = new(std::nothrow) Slot[m_maxSlots];
+            m_slotStatistics    = new(std::nothrow) SlotStatistics[m_maxSlots];
+            m_wakeups           = new(std::nothrow) Wakeup[m_maxSlots];
+            m_wakeupCnt         = 0U;
+            m_isWakeupInvalid   = true;
 
             /* Load slot configuration */
             load();
@@ -148,6 +154,10 @@ bool DisplayMgr::begin()
         m_selectedFrameBuffer = &m_framebuffers[0U];
     }
 
+    /* The physical display shall be refreshed periodically, even if the content is static. */
+    m_keepAliveTimer.start(KEEP_ALIVE_PERIOD);
+    m_rateTimer.start(RATE_PERIOD);
+
     /* Not started yet? */
     if ((nullptr == m_taskHandle) &&
         (nullptr != m_slots))
@@ -323,6 +333,16 @@ uint8_t DisplayMgr::installPlugin(IPluginMaintenance* plugin, uint8_t slotId)
 
         if (m_maxSlots > slotId)
         {
+            MutexGuard<MutexRecursive> guard(m_mutex);
+
+            if (nullptr != m_slotStatistics)
+            {
+                m_slotStatistics[slotId].reset();
+            }
+
+            /* The new plugin shall be processed immediately. */
+            m_isWakeupInvalid = true;
+
             LOG_INFO("Plugin %s (UID %u) installed in slot %u.", plugin->getName(), plugin->getUID(), slotId);
         }
     }
@@ -360,6 +380,7 @@ bool DisplayMgr::uninstallPlugin(IPluginMaintenance* plugin)
                 }
                 else
                 {
+                    m_isWakeupInvalid = true;
                     status = true;
                 }
             }
@@ -542,6 +563,16 @@ bool DisplayMgr::movePluginToSlot(IPluginMaintenance* plugin, uint8_t slotId)
                 srcSlot->setPlugin(dstSlot->getPlugin());
                 dstSlot->setPlugin(plugin);
 
+                /* The statistics belong to the plugins, which are now in other slots. */
+                if (nullptr != m_slotStatistics)
+                {
+                    m_slotStatistics[srcSlotId].reset();
+                    m_slotStatistics[slotId].reset();
+                }
+
+                /* The plugin wakeups refer to the slots too. */
+                m_isWakeupInvalid = true;
+
                 /* Is one of the moved plugins selected at the moment? */
                 if ((m_selectedPlugin == srcSlot->getPlugin()) ||
                     (m_selectedPlugin == dstSlot->getPlugin()))
@@ -641,25 +672,10 @@ void DisplayMgr::getFBCopy(uint32_t* fb, size_t length, uint8_t* slotId)
         (0 < length))
     {
         IDisplay&                   display = Display::getInstance();
-        int16_t                     x       = 0;
-        int16_t                     y       = 0;
-        size_t                      index   = 0;
         MutexGuard<MutexRecursive>  guard(m_mutex);
 
         /* Copy framebuffer after it is completely updated. */
-        for(y = 0; y < display.getHeight(); ++y)
-        {
-            for(x = 0; x < display.getWidth(); ++x)
-            {
-                fb[index] = display.getColor(x, y);
-                ++index;
-
-                if (length <= index)
-                {
-                    break;
-                }
-            }
-        }
+        (void)display.readFramebuffer(fb, length);
 
         if (nullptr != slotId)
         {
@@ -670,6 +686,137 @@ void DisplayMgr::getFBCopy(uint32_t* fb, size_t length, uint8_t* slotId)
     return;
 }
 
+void DisplayMgr::getRefreshRates(uint32_t& renderRate, uint32_t& transmitRate)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    renderRate      = m_renderRate;
+    transmitRate    = m_transmitRate;
+
+    return;
+}
+
+void DisplayMgr::enableStatistics(bool enable)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if (m_isStatisticsEnabled != enable)
+    {
+        uint8_t idx = 0U;
+
+        /* Start always with a clean statistic. */
+        for(idx = 0U; idx < STATISTICS_ID_MAX; ++idx)
+        {
+            m_statistics[idx].reset();
+        }
+
+        m_isStatisticsEnabled = enable;
+    }
+
+    return;
+}
+
+bool DisplayMgr::isStatisticsEnabled()
+{
+    bool                        isEnabled = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    isEnabled = m_isStatisticsEnabled;
+
+    return isEnabled;
+}
+
+bool DisplayMgr::getStatistics(StatisticsId id, FrameTimeHistogram& histogram)
+{
+    bool                        isSuccessful    = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    if (STATISTICS_ID_MAX > id)
+    {
+        histogram       = m_statistics[id];
+        isSuccessful    = true;
+    }
+
+    return isSuccessful;
+}
+
+void DisplayMgr::resetStatistics()
+{
+    uint8_t                     idx = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    for(idx = 0U; idx < STATISTICS_ID_MAX; ++idx)
+    {
+        m_statistics[idx].reset();
+    }
+
+    return;
+}
+
+const char* DisplayMgr::getStatisticsName(StatisticsId id)
+{
+    const char* name = "";
+
+    switch(id)
+    {
+    case STATISTICS_ID_REFRESH_PERIOD:
+        name = "refreshPeriod";
+        break;
+
+    case STATISTICS_ID_PLUGIN_PROCESSING:
+        name = "pluginProcessing";
+        break;
+
+    case STATISTICS_ID_DISPLAY_UPDATE:
+        name = "displayUpdate";
+        break;
+
+    case STATISTICS_ID_TOTAL:
+        name = "total";
+        break;
+
+    default:
+        break;
+    }
+
+    return name;
+}
+
+uint32_t DisplayMgr::getTimeBudget()
+{
+    uint32_t                    timeBudget = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    timeBudget = m_timeBudget;
+
+    return timeBudget;
+}
+
+DisplayMgr::TimeBudgetPolicy DisplayMgr::getTimeBudgetPolicy()
+{
+    TimeBudgetPolicy            policy = TIME_BUDGET_POLICY_LOG;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    policy = m_timeBudgetPolicy;
+
+    return policy;
+}
+
+bool DisplayMgr::getSlotStatistics(uint8_t slotId, SlotStatistics& statistics)
+{
+    bool                        isSuccessful    = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    if ((m_maxSlots > slotId) &&
+        (nullptr != m_slotStatistics))
+    {
+        statistics      = m_slotStatistics[slotId];
+        isSuccessful    = true;
+    }
+
+    return isSuccessful;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -684,11 +831,16 @@ DisplayMgr::DisplayMgr() :
     m_taskExit(false),
     m_xSemaphore(nullptr),
     m_slots(nullptr),
+    m_slotStatistics(nullptr),
+    m_wakeups(nullptr),
+    m_wakeupCnt(0U),
+    m_isWakeupInvalid(true),
     m_maxSlots(0U),
     m_selectedSlot(SLOT_ID_INVALID),
     m_selectedPlugin(nullptr),
     m_requestedPlugin(nullptr),
     m_slotTimer(),
+    m_isNextSlotAnnounced(false),
     m_displayFadeState(FADE_IN),
     m_selectedFrameBuffer(nullptr),
     m_framebuffers(),
@@ -697,7 +849,20 @@ DisplayMgr::DisplayMgr() :
     m_fadeMoveYEffect(),
     m_fadeEffect(&m_fadeLinearEffect),
     m_fadeEffectIndex(FADE_EFFECT_LINEAR),
-    m_fadeEffectUpdate(false)
+    m_fadeEffectUpdate(false),
+    m_isUpdateForced(true),
+    m_lastUpdateTimestamp(0U),
+    m_lastBrightness(0U),
+    m_keepAliveTimer(),
+    m_rateTimer(),
+    m_renderCnt(0U),
+    m_transmitCnt(0U),
+    m_renderRate(0U),
+    m_transmitRate(0U),
+    m_isStatisticsEnabled(0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS),
+    m_statistics(),
+    m_timeBudget(0U),
+    m_timeBudgetPolicy(TIME_BUDGET_POLICY_LOG)
 {
 }
 
@@ -748,6 +913,28 @@ uint8_t DisplayMgr::nextSlot(uint8_t slotId)
     return slotId;
 }
 
+void DisplayMgr::announceNextSlot()
+{
+    uint32_t remaining = m_slotTimer.getRemaining();
+
+    /* A infinite active slot is never left, its timer reports UINT32_MAX. */
+    if ((false == m_isNextSlotAnnounced) &&
+        (PREPARE_ACTIVE_LEAD_TIME >= remaining))
+    {
+        uint8_t slotId = nextSlot(m_selectedSlot);
+
+        if ((m_maxSlots > slotId) &&
+            (m_selectedSlot != slotId))
+        {
+            m_slots[slotId].getPlugin()->prepareActive(remaining, m_slots[slotId].getDuration());
+        }
+
+        m_isNextSlotAnnounced = true;
+    }
+
+    return;
+}
+
 void DisplayMgr::startFadeOut()
 {
     /* Select next framebuffer and keep old content, until
@@ -790,7 +977,7 @@ void DisplayMgr::fadeInOut(YAGfx& dst)
         /* Continously update the current canvas with its framebuffer. */
         if (nullptr != m_selectedPlugin)
         {
-            m_selectedPlugin->update(*m_selectedFrameBuffer);
+            updateSelectedPlugin(*m_selectedFrameBuffer);
         }
 
         /* Handle fading */
@@ -825,10 +1012,354 @@ void DisplayMgr::fadeInOut(YAGfx& dst)
     return;
 }
 
+bool DisplayMgr::isUpdateRequired() const
+{
+    bool isRequired = false;
+
+    /* During fading or after e.g. a plugin activation, the content must be updated. */
+    if ((FADE_IDLE != m_displayFadeState) ||
+        (true == m_isUpdateForced))
+    {
+        isRequired = true;
+    }
+    /* Has the selected plugin something new to show? */
+    else if (nullptr != m_selectedPlugin)
+    {
+        if (true == m_selectedPlugin->isUpdateRequired())
+        {
+            uint32_t updatePeriod = m_selectedPlugin->getUpdatePeriod();
+
+            /* Consider the update period, the plugin asks for. */
+            if (updatePeriod <= (millis() - m_lastUpdateTimestamp))
+            {
+                isRequired = true;
+            }
+        }
+    }
+    else
+    {
+        /* Nothing to do. */
+        ;
+    }
+
+    return isRequired;
+}
+
+void DisplayMgr::updateSelectedPlugin(YAGfx& gfx)
+{
+    if (nullptr != m_selectedPlugin)
+    {
+        uint32_t timestamp = micros();
+
+        m_selectedPlugin->update(gfx);
+
+        if ((nullptr != m_slotStatistics) &&
+            (m_maxSlots > m_selectedSlot))
+        {
+            SlotStatistics& statistics  = m_slotStatistics[m_selectedSlot];
+            uint32_t        duration    = micros() - timestamp;
+
+            statistics.update.update(duration);
+            ++statistics.updateCnt;
+
+            checkTimeBudget(m_selectedSlot, m_selectedPlugin, duration);
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::checkTimeBudget(uint8_t slotId, IPluginMaintenance* plugin, uint32_t duration)
+{
+    if ((nullptr != plugin) &&
+        (nullptr != m_slotStatistics) &&
+        (m_maxSlots > slotId))
+    {
+        uint32_t timeBudget = plugin->getTimeBudget();
+
+        /* Plugin specific time budget or the default one? */
+        if (0U == timeBudget)
+        {
+            timeBudget = m_timeBudget;
+        }
+
+        /* Apply the policy only once per rate period to repeat offenders. */
+        if (true == m_slotStatistics[slotId].budget.check(duration, timeBudget, TIME_BUDGET_VIOLATION_LIMIT))
+        {
+            SlotStatistics&     statistics  = m_slotStatistics[slotId];
+            TimeBudgetPolicy    policy      = m_timeBudgetPolicy;
+
+            /* Locked slots, e.g. the system message slot, can't be disabled. */
+            if ((TIME_BUDGET_POLICY_DISABLE == policy) &&
+                (true == m_slots[slotId].isLocked()))
+            {
+                policy = TIME_BUDGET_POLICY_LOG;
+            }
+
+            switch(policy)
+            {
+            case TIME_BUDGET_POLICY_LOG:
+                LOG_WARNING("Plugin %s (UID %u) in slot %u exceeds time budget: %u us > %u us.",
+                    plugin->getName(), plugin->getUID(), slotId, duration, timeBudget);
+                break;
+
+            case TIME_BUDGET_POLICY_SKIP:
+                LOG_WARNING("Plugin %s (UID %u) in slot %u exceeds time budget, skip processing for %u frames.",
+                    plugin->getName(), plugin->getUID(), slotId, TIME_BUDGET_SKIP_FRAMES);
+                statistics.budget.skip(TIME_BUDGET_SKIP_FRAMES);
+                break;
+
+            case TIME_BUDGET_POLICY_DISABLE:
+                LOG_WARNING("Plugin %s (UID %u) in slot %u exceeds time budget, disable it.",
+                    plugin->getName(), plugin->getUID(), slotId);
+                statistics.budget.disable();
+                plugin->disable();
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::processPlugin(uint8_t slotId, IPluginMaintenance* plugin)
+{
+    /* Skip the plugin as long as it is punished, because it exceeded its
+     * time budget. A plugin disabled by its time budget is processed
+     * again, after it was enabled e.g. by the user.
+     */
+    if ((nullptr == m_slotStatistics) ||
+        (true == m_slotStatistics[slotId].budget.isProcessingAllowed(plugin->isEnabled())))
+    {
+        uint32_t timestamp = micros();
+
+        plugin->process();
+
+        if (nullptr != m_slotStatistics)
+        {
+            uint32_t duration = micros() - timestamp;
+
+            m_slotStatistics[slotId].process.update(duration);
+            ++m_slotStatistics[slotId].processCnt;
+
+            checkTimeBudget(slotId, plugin, duration);
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::processPlugins()
+{
+    uint8_t     slotId      = 0U;
+    uint32_t    timestamp   = millis();
+
+    /* Without plugin wakeups, all installed plugins are processed in every cycle. */
+    if (nullptr == m_wakeups)
+    {
+        for(slotId = 0U; slotId < m_maxSlots; ++slotId)
+        {
+            IPluginMaintenance* plugin = m_slots[slotId].getPlugin();
+
+            if (nullptr != plugin)
+            {
+                processPlugin(slotId, plugin);
+            }
+        }
+    }
+    else
+    {
+        uint8_t idx = 0U;
+
+        if (true == m_isWakeupInvalid)
+        {
+            rebuildWakeups(timestamp);
+        }
+
+        /* Plugins, which requested a wakeup e.g. after a message from
+         * another task arrived, are due immediately. Sifting up only swaps
+         * with already checked wakeups, therefore every one is checked once.
+         */
+        for(idx = 0U; idx < m_wakeupCnt; ++idx)
+        {
+            if (true == m_slots[m_wakeups[idx].slotId].takeWakeUpRequest())
+            {
+                m_wakeups[idx].timestamp = timestamp;
+                siftWakeupUp(idx);
+            }
+        }
+
+        /* Process all due plugins. The next wakeup is always in the future,
+         * therefore every plugin is processed at most once per cycle.
+         */
+        while((0U < m_wakeupCnt) &&
+              (0 <= static_cast<int32_t>(timestamp - m_wakeups[0U].timestamp)))
+        {
+            IPluginMaintenance* plugin  = nullptr;
+
+            slotId  = m_wakeups[0U].slotId;
+            plugin  = m_slots[slotId].getPlugin();
+
+            /* Slot empty in the meantime? Should never happen. */
+            if (nullptr == plugin)
+            {
+                --m_wakeupCnt;
+                m_wakeups[0U] = m_wakeups[m_wakeupCnt];
+                siftWakeupDown(0U);
+            }
+            else
+            {
+                uint32_t nextWakeup = 0U;
+
+                processPlugin(slotId, plugin);
+
+                /* A skipped plugin is due again in the next cycle. A plugin
+                 * disabled by its time budget is only checked for being enabled
+                 * again.
+                 */
+                if (nullptr == m_slotStatistics)
+                {
+                    nextWakeup = plugin->getNextWakeup();
+                }
+                else if (true == m_slotStatistics[slotId].budget.isDisabled())
+                {
+                    nextWakeup = WAKEUP_PERIOD_MAX;
+                }
+                else if (false == m_slotStatistics[slotId].budget.isSkipped())
+                {
+                    nextWakeup = plugin->getNextWakeup();
+                }
+                else
+                {
+                    ;
+                }
+
+                if (0U == nextWakeup)
+                {
+                    nextWakeup = 1U;
+                }
+                else if (WAKEUP_PERIOD_MAX < nextWakeup)
+                {
+                    nextWakeup = WAKEUP_PERIOD_MAX;
+                }
+                else
+                {
+                    ;
+                }
+
+                m_wakeups[0U].timestamp = timestamp + nextWakeup;
+                siftWakeupDown(0U);
+            }
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::rebuildWakeups(uint32_t timestamp)
+{
+    uint8_t slotId = 0U;
+
+    m_wakeupCnt = 0U;
+
+    /* All wakeups have the same timestamp, which is a valid min-heap. */
+    for(slotId = 0U; slotId < m_maxSlots; ++slotId)
+    {
+        if (false == m_slots[slotId].isEmpty())
+        {
+            m_wakeups[m_wakeupCnt].timestamp    = timestamp;
+            m_wakeups[m_wakeupCnt].slotId       = slotId;
+            ++m_wakeupCnt;
+
+            /* The plugin will be processed anyway. */
+            (void)m_slots[slotId].takeWakeUpRequest();
+        }
+    }
+
+    m_isWakeupInvalid = false;
+
+    return;
+}
+
+bool DisplayMgr::isWakeupEarlier(uint8_t idx1, uint8_t idx2) const
+{
+    /* Consider the timestamp overflow. */
+    return (0 > static_cast<int32_t>(m_wakeups[idx1].timestamp - m_wakeups[idx2].timestamp)) ? true : false;
+}
+
+void DisplayMgr::siftWakeupUp(uint8_t idx)
+{
+    bool isFinished = false;
+
+    while((0U < idx) && (false == isFinished))
+    {
+        uint8_t parentIdx = (idx - 1U) / 2U;
+
+        if (false == isWakeupEarlier(idx, parentIdx))
+        {
+            isFinished = true;
+        }
+        else
+        {
+            Wakeup tmp = m_wakeups[parentIdx];
+
+            m_wakeups[parentIdx]    = m_wakeups[idx];
+            m_wakeups[idx]          = tmp;
+            idx                     = parentIdx;
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::siftWakeupDown(uint8_t idx)
+{
+    bool isFinished = false;
+
+    while(false == isFinished)
+    {
+        uint16_t    leftIdx     = 2U * static_cast<uint16_t>(idx) + 1U;
+        uint16_t    rightIdx    = leftIdx + 1U;
+        uint8_t     minIdx      = idx;
+
+        if ((m_wakeupCnt > leftIdx) &&
+            (true == isWakeupEarlier(leftIdx, minIdx)))
+        {
+            minIdx = leftIdx;
+        }
+
+        if ((m_wakeupCnt > rightIdx) &&
+            (true == isWakeupEarlier(rightIdx, minIdx)))
+        {
+            minIdx = rightIdx;
+        }
+
+        if (minIdx == idx)
+        {
+            isFinished = true;
+        }
+        else
+        {
+            Wakeup tmp = m_wakeups[minIdx];
+
+            m_wakeups[minIdx]   = m_wakeups[idx];
+            m_wakeups[idx]      = tmp;
+            idx                 = minIdx;
+        }
+    }
+
+    return;
+}
+
 void DisplayMgr::process()
 {
-    IDisplay&                   display = Display::getInstance();
-    uint8_t                     index   = 0U;
+    IDisplay&                   display             = Display::getInstance();
+    uint8_t                     index               = 0U;
+    bool                        isTransmitRequired  = false;
+    uint8_t                     brightness          = 0U;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     /* Handle display brightness */
@@ -868,6 +1399,8 @@ void DisplayMgr::process()
                 {
                     m_slotTimer.start(duration);
                 }
+
+                m_isNextSlotAnnounced = false;
             }
             else
             {
@@ -917,6 +1450,8 @@ void DisplayMgr::process()
                 {
                     m_slotTimer.restart();
                 }
+
+                m_isNextSlotAnnounced = false;
             }
             else
             {
@@ -928,10 +1463,10 @@ void DisplayMgr::process()
                 startFadeOut();
             }
         }
+        /* Give the plugin in the next slot a chance to prepare its content. */
         else
         {
-            /* Nothing to do. */
-            ;
+            announceNextSlot();
         }
     }
 
@@ -964,6 +1499,8 @@ void DisplayMgr::process()
                 m_slotTimer.start(duration);
             }
 
+            m_isNextSlotAnnounced = false;
+
             if (nullptr != m_selectedFrameBuffer)
             {
                 m_selectedPlugin->active(*m_selectedFrameBuffer);
@@ -973,6 +1510,12 @@ void DisplayMgr::process()
                 m_selectedPlugin->active(display);
             }
 
+            /* The new plugin shall draw at least once, independent of its content. */
+            m_isUpdateForced = true;
+
+            /* Its next wakeup may have changed with the activation. */
+            m_slots[m_selectedSlot].wakeUp();
+
             LOG_INFO("Slot %u (%s) now active.", m_selectedSlot, m_selectedPlugin->getName());
         }
         /* No plugin is active, clear the display. */
@@ -983,6 +1526,8 @@ void DisplayMgr::process()
                 m_selectedFrameBuffer->fillScreen(ColorDef::BLACK);
             }
             display.clear();
+
+            m_isUpdateForced = true;
         }
     }
 
@@ -1012,36 +1557,85 @@ void DisplayMgr::process()
         m_fadeEffectUpdate = false;
     }
     
-    /* Process all installed plugins. */
-    for(index = 0U; index < m_maxSlots; ++index)
-    {
-        IPluginMaintenance* plugin = m_slots[index].getPlugin();
+    /* Process all plugins, which are due. */
+    processPlugins();
 
-        if (nullptr != plugin)
+    /* Skip the display content update, as long as the content is static. */
+    if (true == isUpdateRequired())
+    {
+        /* Update display (main canvas available) */
+        if (nullptr != m_selectedFrameBuffer)
         {
-            plugin->process();
+            fadeInOut(display);
+        }
+        /* Update display (main canvas not available) */
+        else if (nullptr != m_selectedPlugin)
+        {
+            updateSelectedPlugin(display);
+        }
+        /* No plugin selected. */
+        else
+        {
+            /* Nothing to do. */
+            ;
         }
+
+        m_isUpdateForced        = false;
+        m_lastUpdateTimestamp   = millis();
+        ++m_renderCnt;
+
+        isTransmitRequired = true;
     }
 
-    /* Update display (main canvas available) */
-    if (nullptr != m_selectedFrameBuffer)
+    /* A brightness change is applied with the next physical display refresh. */
+    brightness = BrightnessCtrl::getInstance().getBrightness();
+
+    if (m_lastBrightness != brightness)
     {
-        fadeInOut(display);
+        isTransmitRequired = true;
     }
-    /* Update display (main canvas not available) */
-    else if (nullptr != m_selectedPlugin)
+
+    /* Refresh the physical display periodically, even if the content is static. */
+    if (true == m_keepAliveTimer.isTimeout())
     {
-        m_selectedPlugin->update(display);
+        isTransmitRequired = true;
     }
-    /* No plugin selected. */
-    else
+
+    if (true == isTransmitRequired)
     {
-        /* Nothing to do. */
-        ;
+        delay(1U);
+        display.show();
+
+        m_lastBrightness = brightness;
+        m_keepAliveTimer.restart();
+        ++m_transmitCnt;
     }
 
-    delay(1U);
-    display.show();
+    /* Determine the render and transmit rates. */
+    if (true == m_rateTimer.isTimeout())
+    {
+        m_renderRate    = (m_renderCnt * 1000U) / RATE_PERIOD;
+        m_transmitRate  = (m_transmitCnt * 1000U) / RATE_PERIOD;
+        m_renderCnt     = 0U;
+        m_transmitCnt   = 0U;
+
+        if (nullptr != m_slotStatistics)
+        {
+            for(index = 0U; index < m_maxSlots; ++index)
+            {
+                SlotStatistics& statistics = m_slotStatistics[index];
+
+                statistics.processRate  = (statistics.processCnt * 1000U) / RATE_PERIOD;
+                statistics.updateRate   = (statistics.updateCnt * 1000U) / RATE_PERIOD;
+                statistics.processCnt   = 0U;
+                statistics.updateCnt    = 0U;
+
+                statistics.budget.nextPeriod();
+            }
+        }
+
+        m_rateTimer.restart();
+    }
 
     return;
 }
@@ -1053,15 +1647,7 @@ void DisplayMgr::updateTask(void* parameters)
     if ((nullptr != tthis) &&
         (nullptr != tthis->m_xSemaphore))
     {
-#if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
-        Statistics      statistics;
-        SimpleTimer     statisticsLogTimer;
-        const uint32_t  STATISTICS_LOG_PERIOD   = 4000U;    /* [ms] */
-        uint32_t        timestampLastUpdate     = millis();
-
-        statisticsLogTimer.start(STATISTICS_LOG_PERIOD);
-
-#endif /* (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS) */
+        uint32_t timestampLastUpdate = millis();
 
         (void)xSemaphoreTake(tthis->m_xSemaphore, portMAX_DELAY);
 
@@ -1069,6 +1655,7 @@ void DisplayMgr::updateTask(void* parameters)
         {
             uint32_t    timestamp           = millis();
             uint32_t    duration            = 0U;
+            uint32_t    durationProcessing  = 0U;
             uint32_t    timestampPhyUpdate  = millis();
             uint32_t    durationPhyUpdate   = 0U;
             bool        abort               = false;
@@ -1079,9 +1666,7 @@ void DisplayMgr::updateTask(void* parameters)
             /* Refresh display content periodically */
             tthis->process();
 
-#if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
-            statistics.pluginProcessing.update(millis() - timestamp);
-#endif /* (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS) */
+            durationProcessing = millis() - timestamp;
 
             /* Wait until the physical update is ready to avoid flickering
              * and artifacts on the display, because of e.g. webserver flash
@@ -1098,40 +1683,6 @@ void DisplayMgr::updateTask(void* parameters)
                 }
             }
 
-#if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
-            statistics.displayUpdate.update(durationPhyUpdate);
-            statistics.total.update(statistics.pluginProcessing.getCurrent() + statistics.displayUpdate.getCurrent());
-
-            if (true == statisticsLogTimer.isTimeout())
-            {
-                LOG_DEBUG("[ %2u, %2u, %2u ]", 
-                    statistics.refreshPeriod.getMin(),
-                    statistics.refreshPeriod.getAvg(),
-                    statistics.refreshPeriod.getMax()
-                );
-                
-                LOG_DEBUG("[ %2u, %2u, %2u ] [ %2u, %2u, %2u ] [ %2u, %2u, %2u ]",
-                    statistics.pluginProcessing.getMin(),
-                    statistics.pluginProcessing.getAvg(),
-                    statistics.pluginProcessing.getMax(),
-                    statistics.displayUpdate.getMin(),
-                    statistics.displayUpdate.getAvg(),
-                    statistics.displayUpdate.getMax(),
-                    statistics.total.getMin(),
-                    statistics.total.getAvg(),
-                    statistics.total.getMax()
-                );
-
-                /* Reset the statistics to get a new min./max. determination. */
-                statistics.pluginProcessing.reset();
-                statistics.displayUpdate.reset();
-                statistics.total.reset();
-                statistics.refreshPeriod.reset();
-
-                statisticsLogTimer.restart();
-            }
-#endif /* (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS) */
-
             /* Calculate overall duration */
             duration = millis() - timestamp;
 
@@ -1145,10 +1696,18 @@ void DisplayMgr::updateTask(void* parameters)
                 delay(TASK_PERIOD - duration);
             }
 
-#if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
-            statistics.refreshPeriod.update(millis() - timestampLastUpdate);
+            /* The statistics are only determined on demand. */
+            if (true == tthis->isStatisticsEnabled())
+            {
+                MutexGuard<MutexRecursive> guard(tthis->m_mutex);
+
+                tthis->m_statistics[STATISTICS_ID_PLUGIN_PROCESSING].update(durationProcessing);
+                tthis->m_statistics[STATISTICS_ID_DISPLAY_UPDATE].update(durationPhyUpdate);
+                tthis->m_statistics[STATISTICS_ID_TOTAL].update(durationProcessing + durationPhyUpdate);
+                tthis->m_statistics[STATISTICS_ID_REFRESH_PERIOD].update(millis() - timestampLastUpdate);
+            }
+
             timestampLastUpdate = millis();
-#endif /* (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS) */
         }
 
         (void)xSemaphoreGive(tthis->m_xSemaphore);
@@ -1182,7 +1741,7 @@ void DisplayMgr::load()
         else
         {
             const size_t            JSON_DOC_SIZE   = 512U;
-            DynamicJsonDocument     jsonDoc(JSON_DOC_SIZE);
+            PooledJsonDocument      jsonDoc(JSON_DOC_SIZE);
             DeserializationError    error           = deserializeJson(jsonDoc, config);
 
             if (true == jsonDoc.overflowed())
@@ -1237,7 +1796,7 @@ void DisplayMgr::save()
         uint8_t             slotId      = 0;
         Settings&           settings    = Settings::getInstance();
         const size_t        JSON_DOC_SIZE   = 512U;
-        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+        PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
         JsonArray           jsonSlots   = jsonDoc.createNestedArray("slots");
 
         for(slotId = 0; slotId < m_maxSlots; ++slotId)
@@ -47,6 +47,9 @@
 #include <Board.h>
 #include <TextWidget.h>
 #include <SimpleTimer.hpp>
+#include <StatisticValue.hpp>
+#include <Histogram.hpp>
+#include <TimeBudget.hpp>
 #include <FadeLinear.h>
 #include <FadeMoveX.h>
 #include <FadeMoveY.h>
@@ -83,6 +86,78 @@ public:
         FADE_EFFECT_COUNT   /**< Number of fade effects. */
     };
 
+    /** Frame time statistics ids. */
+    enum StatisticsId
+    {
+        STATISTICS_ID_REFRESH_PERIOD = 0,   /**< Period between two display refresh cycles. */
+        STATISTICS_ID_PLUGIN_PROCESSING,    /**< Duration of plugin processing and display content update. */
+        STATISTICS_ID_DISPLAY_UPDATE,       /**< Duration of waiting for the physical display update. */
+        STATISTICS_ID_TOTAL,                /**< Sum of plugin processing and physical display update. */
+        STATISTICS_ID_MAX                   /**< Number of frame time statistics. */
+    };
+
+    /** Policies, which are applied to plugins, which exceed their time budget repeatedly. */
+    enum TimeBudgetPolicy
+    {
+        TIME_BUDGET_POLICY_LOG = 0,     /**< Log the violation only. */
+        TIME_BUDGET_POLICY_SKIP,        /**< Skip process() for TIME_BUDGET_SKIP_FRAMES frames. */
+        TIME_BUDGET_POLICY_DISABLE,     /**< Disable the plugin in the slot and stop processing it, until it is enabled again. */
+        TIME_BUDGET_POLICY_MAX          /**< Number of policies. */
+    };
+
+    /** Frame time histogram in ms with a resolution of 1 ms. */
+    typedef Histogram<uint32_t, 0U, 1U, 64U> FrameTimeHistogram;
+
+    /** Number of values, used for the slot statistics calculation. */
+    static const uint32_t   SLOT_STATISTICS_VALUE_CNT   = 32U;
+
+    /** Rolling duration statistics in us, determined by calling a plugin. */
+    typedef StatisticValue<uint32_t, 0U, SLOT_STATISTICS_VALUE_CNT> DurationStatistics;
+
+    /**
+     * Statistics about the plugin in a slot, which are interesting to find
+     * the plugin, which makes the display stutter.
+     */
+    struct SlotStatistics
+    {
+        DurationStatistics  process;            /**< Duration of process() in us. */
+        DurationStatistics  update;             /**< Duration of update() in us. */
+        uint32_t            processCnt;         /**< Number of process() calls in the current rate period. */
+        uint32_t            updateCnt;          /**< Number of update() calls in the current rate period. */
+        uint32_t            processRate;        /**< Number of process() calls per second. */
+        uint32_t            updateRate;         /**< Number of update() calls per second. */
+        TimeBudget          budget;             /**< Time budget violations and punishment. */
+
+        /**
+         * Constructs the slot statistics in initial state.
+         */
+        SlotStatistics() :
+            process(),
+            update(),
+            processCnt(0U),
+            updateCnt(0U),
+            processRate(0U),
+            updateRate(0U),
+            budget()
+        {
+        }
+
+        /**
+         * Reset the statistics, e.g. after a plugin change.
+         */
+        void reset()
+        {
+            process.reset();
+            update.reset();
+            processCnt  = 0U;
+            updateCnt   = 0U;
+            processRate = 0U;
+            updateRate  = 0U;
+
+            budget.reset();
+        }
+    };
+
     /**
      * Get display manager instance.
      *
@@ -253,6 +328,24 @@ public:
      */
     bool isSlotLocked(uint8_t slotId);
 
+    /**
+     * Lock the display manager. As long as it is locked, the display is not
+     * updated. Use it to apply several plugin changes, which shall become
+     * visible at once. Every lock() requires a unlock().
+     */
+    void lock()
+    {
+        (void)m_mutex.take(portMAX_DELAY);
+    }
+
+    /**
+     * Unlock the display manager.
+     */
+    void unlock()
+    {
+        (void)m_mutex.give();
+    }
+
     /**
      * Get slot duration in ms, how long the given plugin will be shown.
      *
@@ -282,6 +375,79 @@ public:
      */
     void getFBCopy(uint32_t* fb, size_t length, uint8_t* slotId);
 
+    /**
+     * Get the number of display content updates (rendering) and physical
+     * display refreshes (transmission) per second. As long as the content
+     * is static, both are reduced to a minimum.
+     *
+     * @param[out] renderRate   Number of display content updates per second
+     * @param[out] transmitRate Number of physical display refreshes per second
+     */
+    void getRefreshRates(uint32_t& renderRate, uint32_t& transmitRate);
+
+    /**
+     * Enable/Disable the frame time statistics.
+     * Enabling/Disabling resets them.
+     *
+     * @param[in] enable    Enable (true) or disable (false)
+     */
+    void enableStatistics(bool enable);
+
+    /**
+     * Are the frame time statistics enabled?
+     *
+     * @return If enabled, it will return true otherwise false.
+     */
+    bool isStatisticsEnabled();
+
+    /**
+     * Get a copy of a frame time statistic.
+     *
+     * @param[in]   id          Statistics id
+     * @param[out]  histogram   Frame time histogram
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool getStatistics(StatisticsId id, FrameTimeHistogram& histogram);
+
+    /**
+     * Reset the frame time statistics.
+     */
+    void resetStatistics();
+
+    /**
+     * Get the name of a frame time statistic.
+     *
+     * @param[in] id    Statistics id
+     *
+     * @return Name of the statistic
+     */
+    static const char* getStatisticsName(StatisticsId id);
+
+    /**
+     * Get the default plugin time budget per display manager cycle.
+     *
+     * @return Time budget in us
+     */
+    uint32_t getTimeBudget();
+
+    /**
+     * Get the policy, which is applied to plugins, which exceed their time budget.
+     *
+     * @return Time budget policy
+     */
+    TimeBudgetPolicy getTimeBudgetPolicy();
+
+    /**
+     * Get a copy of the statistics of a slot.
+     *
+     * @param[in]   slotId      Slot id
+     * @param[out]  statistics  Slot statistics
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool getSlotStatistics(uint8_t slotId, SlotStatistics& statistics);
+
     /**
      * Get max. number of display slots, which can be used for plugins.
      *
@@ -307,6 +473,31 @@ public:
     /** Task priority, note Arduino loop and AsyncTcp have lower priorities. */
     static const UBaseType_t    TASK_PRIORITY       = 4U;
 
+    /** Period in ms, after which the physical display is refreshed, even if the content is static. */
+    static const uint32_t       KEEP_ALIVE_PERIOD   = 1000U;
+
+    /** Period in ms, used to determine the render and transmit rates. */
+    static const uint32_t       RATE_PERIOD         = 1000U;
+
+    /** Number of time budget violations in a rate period, after which the policy is applied. */
+    static const uint32_t       TIME_BUDGET_VIOLATION_LIMIT = 3U;
+
+    /** Number of frames, process() of a plugin is skipped by the skip policy. */
+    static const uint32_t       TIME_BUDGET_SKIP_FRAMES     = 50U;
+
+    /**
+     * Max. time in ms between two process() calls of a plugin. It limits the
+     * delay of plugin state changes, which happen outside of process() without
+     * a wakeup request, e.g. a configuration change via REST API.
+     */
+    static const uint32_t       WAKEUP_PERIOD_MAX           = 1000U;
+
+    /**
+     * Time in ms, the activation of the next slot is announced in advance
+     * to its plugin. It shall be long enough to prefetch data from the web.
+     */
+    static const uint32_t       PREPARE_ACTIVE_LEAD_TIME    = 5000U;
+
 private:
 
     /** Mutex to lock/unlock display update. */
@@ -324,6 +515,25 @@ private:
     /** List of all slots with their connected plugins. */
     Slot*               m_slots;
 
+    /** Statistics of all slots, same size as the slot list. */
+    SlotStatistics*     m_slotStatistics;
+
+    /** Plugin wakeup, used to schedule the plugin processing. */
+    struct Wakeup
+    {
+        uint32_t    timestamp;  /**< Timestamp in ms, when the plugin shall be processed. */
+        uint8_t     slotId;     /**< Slot id of the plugin */
+    };
+
+    /** Plugin wakeups as min-heap ordered by timestamp, same size as the slot list. */
+    Wakeup*             m_wakeups;
+
+    /** Number of plugin wakeups in the min-heap. */
+    uint8_t             m_wakeupCnt;
+
+    /** Flag to signal that the plugin wakeups shall be rebuilt, e.g. after a plugin was installed. */
+    bool                m_isWakeupInvalid;
+
     /** Max. number of slots. */
     uint8_t             m_maxSlots;
 
@@ -339,6 +549,9 @@ private:
     /** Timer, used for changing the slot after a specific duration. */
     SimpleTimer         m_slotTimer;
 
+    /** Flag to signal that the activation of the next slot was already announced. */
+    bool                m_isNextSlotAnnounced;
+
     /** Display fade state */
     enum FadeState
     {
@@ -368,6 +581,19 @@ private:
     IFadeEffect*        m_fadeEffect;                   /**< The fade effect itself. */
     FadeEffect          m_fadeEffectIndex;              /**< Fade effect index to determine the next fade effect. */
     bool                m_fadeEffectUpdate;             /**< Flag to indicate that the fadeEffect was updated. */
+    bool                m_isUpdateForced;               /**< Flag to force a display content update, independent of the plugin. */
+    uint32_t            m_lastUpdateTimestamp;          /**< Timestamp in ms of the last display content update. */
+    uint8_t             m_lastBrightness;               /**< Brightness of the last physical display refresh. */
+    SimpleTimer         m_keepAliveTimer;               /**< Timer used for the periodic physical display refresh. */
+    SimpleTimer         m_rateTimer;                    /**< Timer used to determine the render and transmit rates. */
+    uint32_t            m_renderCnt;                    /**< Number of display content updates in the current rate period. */
+    uint32_t            m_transmitCnt;                  /**< Number of physical display refreshes in the current rate period. */
+    uint32_t            m_renderRate;                   /**< Number of display content updates per second. */
+    uint32_t            m_transmitRate;                 /**< Number of physical display refreshes per second. */
+    bool                m_isStatisticsEnabled;          /**< Are the frame time statistics enabled? */
+    FrameTimeHistogram  m_statistics[STATISTICS_ID_MAX]; /**< Frame time statistics. */
+    uint32_t            m_timeBudget;                   /**< Default plugin time budget in us. */
+    TimeBudgetPolicy    m_timeBudgetPolicy;             /**< Policy for plugins, which exceed their time budget. */
 
     /**
      * Constructs the display manager.
@@ -392,6 +618,13 @@ private:
      */
     uint8_t nextSlot(uint8_t slotId);
 
+    /**
+     * Announce the activation of the next slot to its plugin, as soon as
+     * the selected slot runs out within the lead time. This is done only once
+     * per selected slot activation.
+     */
+    void announceNextSlot();
+
     /**
      * Start fade effect.
      */
@@ -404,6 +637,77 @@ private:
      */
     void fadeInOut(YAGfx& dst);
 
+    /**
+     * Is a display content update required?
+     * This is the case during fading, after a forced update request or if
+     * the selected plugin has something new to show.
+     *
+     * @return If a display content update is required, it will return true otherwise false.
+     */
+    bool isUpdateRequired() const;
+
+    /**
+     * Update the selected plugin and measure its duration.
+     *
+     * @param[in] gfx   Graphics interface, the plugin shall draw on.
+     */
+    void updateSelectedPlugin(YAGfx& gfx);
+
+    /**
+     * Check the duration of a plugin call against its time budget and
+     * apply the policy to repeat offenders.
+     *
+     * @param[in] slotId    Slot id of the plugin
+     * @param[in] plugin    Plugin
+     * @param[in] duration  Duration of the plugin call in us
+     */
+    void checkTimeBudget(uint8_t slotId, IPluginMaintenance* plugin, uint32_t duration);
+
+    /**
+     * Process a single plugin, considering its time budget.
+     *
+     * @param[in] slotId    Slot id of the plugin
+     * @param[in] plugin    Plugin
+     */
+    void processPlugin(uint8_t slotId, IPluginMaintenance* plugin);
+
+    /**
+     * Process all plugins, which are due or woken up. If no plugin wakeups
+     * are available, all installed plugins are processed.
+     */
+    void processPlugins();
+
+    /**
+     * Rebuild the plugin wakeups. Every installed plugin will be due immediately.
+     *
+     * @param[in] timestamp Current timestamp in ms
+     */
+    void rebuildWakeups(uint32_t timestamp);
+
+    /**
+     * Is the wakeup at the first index earlier than the one at the second index?
+     *
+     * @param[in] idx1  Index of the first wakeup
+     * @param[in] idx2  Index of the second wakeup
+     *
+     * @return If the first one is earlier, it will return true otherwise false.
+     */
+    bool isWakeupEarlier(uint8_t idx1, uint8_t idx2) const;
+
+    /**
+     * Move a wakeup up in the min-heap, until the heap order is restored.
+     *
+     * @param[in] idx   Index of the wakeup
+     */
+    void siftWakeupUp(uint8_t idx);
+
+    /**
+     * Move a wakeup down in the min-heap, until the heap order is restored.
+     *
+     * @param[in] idx   Index of the wakeup
+     */
+    void siftWakeupDown(uint8_t idx);
+
     /**
      * Process the slots. This shall be called periodically in
      * a higher period than the DEFAULT_PERIOD.
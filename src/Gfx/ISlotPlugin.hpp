@@ -74,6 +74,13 @@ public:
      */
     virtual uint32_t getDuration() const = 0;
 
+    /**
+     * Request to process the plugin in the next display manager cycle,
+     * independent of its next wakeup time.
+     * It can be called from any task context.
+     */
+    virtual void wakeUp() const = 0;
+
 protected:
 
     /**
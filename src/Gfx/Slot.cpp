@@ -69,7 +69,8 @@
 Slot::Slot() :
     m_plugin(nullptr),
     m_duration(DURATION_DEFAULT),
-    m_isLocked(false)
+    m_isLocked(false),
+    m_isWakeUpRequested(false)
 {
 }
 
@@ -136,6 +137,23 @@ bool Slot::isLocked() const
     return m_isLocked;
 }
 
+void Slot::wakeUp() const
+{
+    m_isWakeUpRequested = true;
+}
+
+bool Slot::takeWakeUpRequest()
+{
+    bool isRequested = m_isWakeUpRequested;
+
+    if (true == isRequested)
+    {
+        m_isWakeUpRequested = false;
+    }
+
+    return isRequested;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
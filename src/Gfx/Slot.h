@@ -128,6 +128,21 @@ public:
      */
     bool isLocked() const;
 
+    /**
+     * Request to process the plugin in the next display manager cycle,
+     * independent of its next wakeup time.
+     * It can be called from any task context.
+     */
+    void wakeUp() const final;
+
+    /**
+     * Is a wakeup of the plugin requested?
+     * The request will be cleared.
+     *
+     * @return If a wakeup is requested, it will return true otherwise false.
+     */
+    bool takeWakeUpRequest();
+
     /** Default duration in ms */
     static const uint32_t DURATION_DEFAULT  = 30000U;
 
@@ -137,6 +152,9 @@ private:
     uint32_t            m_duration; /**< Duration in ms, how long the plugin shall be active. */
     bool                m_isLocked; /**< Is slot locked or not. */
 
+    /** Plugin wakeup requested or not. May be set by any task. */
+    mutable volatile bool   m_isWakeUpRequested;
+
     Slot(const Slot& slot);
     Slot& operator=(const Slot& slot);
 };
@@ -222,6 +222,19 @@ public:
      */
     virtual void inactive() = 0;
 
+    /**
+     * This method will be called in case the plugin will be set active soon,
+     * which means it is in the next slot of the rotation. It is called once
+     * per activation, shortly before the plugin is set active.
+     * Use it to request data or to prepare the content in the background,
+     * but never wait for it. The activation won't wait for it either.
+     * Overwrite it if your plugin needs to know this.
+     *
+     * @param[in] timeToActive  Time in ms until the plugin will be set active.
+     * @param[in] duration      Duration in ms, the plugin will be active. 0 means infinite.
+     */
+    virtual void prepareActive(uint32_t timeToActive, uint32_t duration) = 0;
+
     /**
      * Update the display.
      * If the plugin is in active slot, this function will be called cyclic
@@ -231,6 +244,49 @@ public:
      */
     virtual void update(YAGfx& gfx) = 0;
 
+    /**
+     * Is a display update required?
+     * As long as the plugin content doesn't change, the display manager will
+     * skip the update() call and the physical display refresh.
+     * Overwrite it if your plugin shows static content for a longer time.
+     *
+     * @return If the plugin has something new to show, it will return true otherwise false.
+     */
+    virtual bool isUpdateRequired() const = 0;
+
+    /**
+     * Get the period in ms, the plugin wants to be updated via update().
+     * A period of 0 means that the plugin is updated in every display manager
+     * cycle.
+     * Overwrite it if your plugin is satisfied with a lower refresh rate.
+     *
+     * @return Update period in ms
+     */
+    virtual uint32_t getUpdatePeriod() const = 0;
+
+    /**
+     * Get the time budget in us, the plugin may spend in process() and update()
+     * per display manager cycle. A budget of 0 means that the default budget
+     * from the settings is used.
+     * Overwrite it if your plugin needs more time e.g. for loading a bitmap.
+     *
+     * @return Time budget in us
+     */
+    virtual uint32_t getTimeBudget() const = 0;
+
+    /**
+     * Get the time in ms, until process() shall be called next. The display
+     * manager will skip process() until then, except the plugin is woken up
+     * via its slot interface, e.g. after a message from another task arrived.
+     * A time of 0 means that the plugin is processed in every display manager
+     * cycle.
+     * Overwrite it if your plugin only has to do something after a timer
+     * expired or after a event.
+     *
+     * @return Time in ms until the next process() call
+     */
+    virtual uint32_t getNextWakeup() const = 0;
+
 protected:
 
     /**
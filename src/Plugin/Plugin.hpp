@@ -78,7 +78,7 @@ public:
      */
     virtual void setSlot(const ISlotPlugin* slotInterf) override
     {
-        UTIL_NOT_USED(slotInterf);
+        m_slot = slotInterf;
         return;
     }
 
@@ -285,6 +285,24 @@ public:
         return;
     }
 
+    /**
+     * This method will be called in case the plugin will be set active soon,
+     * which means it is in the next slot of the rotation. It is called once
+     * per activation, shortly before the plugin is set active.
+     * Use it to request data or to prepare the content in the background,
+     * but never wait for it. The activation won't wait for it either.
+     * Overwrite it if your plugin needs to know this.
+     *
+     * @param[in] timeToActive  Time in ms until the plugin will be set active.
+     * @param[in] duration      Duration in ms, the plugin will be active. 0 means infinite.
+     */
+    virtual void prepareActive(uint32_t timeToActive, uint32_t duration) override
+    {
+        UTIL_NOT_USED(timeToActive);
+        UTIL_NOT_USED(duration);
+        return;
+    }
+
     /**
      * Update the display.
      * If the plugin is in active slot, this function will be called cyclic
@@ -294,6 +312,61 @@ public:
      */
     virtual void update(YAGfx& gfx) = 0;
 
+    /**
+     * Is a display update required?
+     * As long as the plugin content doesn't change, the display manager will
+     * skip the update() call and the physical display refresh.
+     * Overwrite it if your plugin shows static content for a longer time.
+     *
+     * @return If the plugin has something new to show, it will return true otherwise false.
+     */
+    virtual bool isUpdateRequired() const override
+    {
+        return true;
+    }
+
+    /**
+     * Get the period in ms, the plugin wants to be updated via update().
+     * A period of 0 means that the plugin is updated in every display manager
+     * cycle.
+     * Overwrite it if your plugin is satisfied with a lower refresh rate.
+     *
+     * @return Update period in ms
+     */
+    virtual uint32_t getUpdatePeriod() const override
+    {
+        return 0U;
+    }
+
+    /**
+     * Get the time budget in us, the plugin may spend in process() and update()
+     * per display manager cycle. A budget of 0 means that the default budget
+     * from the settings is used.
+     * Overwrite it if your plugin needs more time e.g. for loading a bitmap.
+     *
+     * @return Time budget in us
+     */
+    virtual uint32_t getTimeBudget() const override
+    {
+        return 0U;
+    }
+
+    /**
+     * Get the time in ms, until process() shall be called next. The display
+     * manager will skip process() until then, except the plugin is woken up
+     * via its slot interface, e.g. after a message from another task arrived.
+     * A time of 0 means that the plugin is processed in every display manager
+     * cycle.
+     * Overwrite it if your plugin only has to do something after a timer
+     * expired or after a event.
+     *
+     * @return Time in ms until the next process() call
+     */
+    virtual uint32_t getNextWakeup() const override
+    {
+        return 0U;
+    }
+
     /**
      * Path where plugin specific configuration files shall be stored.
      */
@@ -312,10 +385,26 @@ protected:
         m_uid(uid),
         m_alias(),
         m_name(name),
-        m_isEnabled(false)
+        m_isEnabled(false),
+        m_slot(nullptr)
     {
     }
 
+    /**
+     * Request the display manager to call process() in its next cycle,
+     * independent of the next wakeup time. It can be called from any task,
+     * e.g. via the wakeup function of a task proxy.
+     */
+    void wakeUp() const
+    {
+        const ISlotPlugin* slot = m_slot;
+
+        if (nullptr != slot)
+        {
+            slot->wakeUp();
+        }
+    }
+
     /**
      * Generate the full path for any plugin instance specific kind of configuration
      * file.
@@ -342,10 +431,11 @@ protected:
 
 private:
 
-    uint16_t    m_uid;          /**< Unique id */
-    String      m_alias;        /**< Alias name */
-    String      m_name;         /**< Plugin name */
-    bool        m_isEnabled;    /**< Plugin is enabled or disabled */
+    uint16_t            m_uid;          /**< Unique id */
+    String              m_alias;        /**< Alias name */
+    String              m_name;         /**< Plugin name */
+    bool                m_isEnabled;    /**< Plugin is enabled or disabled */
+    const ISlotPlugin*  m_slot;         /**< Slot interface, the plugin is plugged in. */
 
     Plugin();
     Plugin(const Plugin& plugin);
@@ -38,9 +38,8 @@
 #include "RestApi.h"
 #include "Settings.h"
 #include "FileSystem.h"
+#include "JsonDocPool.h"
 #include "Plugin.hpp"
-#include "HttpStatus.h"
-#include "RestUtil.h"
 
 #include <Logging.h>
 #include <ArduinoJson.h>
@@ -72,6 +71,9 @@
 void PluginMgr::begin()
 {
     createPluginConfigDirectory();
+
+    /* A single web handler serves the topics of all plugins. */
+    (void)MyWebServer::getInstance().addHandler(&m_topicHandler);
 }
 
 void PluginMgr::registerPlugin(const String& name, IPluginMaintenance::CreateFunc createFunc)
@@ -166,6 +168,67 @@ String PluginMgr::getRestApiBaseUriByAlias(const String& alias)
     return baseUri;
 }
 
+IPluginMaintenance* PluginMgr::findPluginByUID(uint16_t uid)
+{
+    IPluginMaintenance*                 plugin  = nullptr;
+    DLinkedListIterator<PluginObjData*> it(m_pluginMeta);
+
+    if (true == it.first())
+    {
+        PluginObjData* pluginMeta = *it.current();
+
+        while((nullptr == plugin) && (nullptr != pluginMeta))
+        {
+            if ((nullptr != pluginMeta->plugin) &&
+                (uid == pluginMeta->plugin->getUID()))
+            {
+                plugin = pluginMeta->plugin;
+            }
+            else if (false == it.next())
+            {
+                pluginMeta = nullptr;
+            }
+            else
+            {
+                pluginMeta = *it.current();
+            }
+        }
+    }
+
+    return plugin;
+}
+
+IPluginMaintenance* PluginMgr::findPluginByAlias(const String& alias)
+{
+    IPluginMaintenance*                 plugin  = nullptr;
+    DLinkedListIterator<PluginObjData*> it(m_pluginMeta);
+
+    if ((false == alias.isEmpty()) &&
+        (true == it.first()))
+    {
+        PluginObjData* pluginMeta = *it.current();
+
+        while((nullptr == plugin) && (nullptr != pluginMeta))
+        {
+            if ((nullptr != pluginMeta->plugin) &&
+                (alias == pluginMeta->plugin->getAlias()))
+            {
+                plugin = pluginMeta->plugin;
+            }
+            else if (false == it.next())
+            {
+                pluginMeta = nullptr;
+            }
+            else
+            {
+                pluginMeta = *it.current();
+            }
+        }
+    }
+
+    return plugin;
+}
+
 void PluginMgr::load()
 {
     Settings& settings = Settings::getInstance();
@@ -185,7 +248,7 @@ void PluginMgr::load()
         else
         {
             const size_t            JSON_DOC_SIZE   = 1024U;
-            DynamicJsonDocument     jsonDoc(JSON_DOC_SIZE);
+            PooledJsonDocument      jsonDoc(JSON_DOC_SIZE);
             DeserializationError    error           = deserializeJson(jsonDoc, installation);
 
             checkJsonDocOverflow(jsonDoc, __LINE__);
@@ -263,7 +326,7 @@ void PluginMgr::save()
     uint8_t             slotId      = 0;
     Settings&           settings    = Settings::getInstance();
     const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     JsonArray           jsonSlots   = jsonDoc.createNestedArray("slots");
 
     for(slotId = 0; slotId < DisplayMgr::getInstance().getMaxSlots(); ++slotId)
@@ -309,13 +372,13 @@ void PluginMgr::save()
  *****************************************************************************/
 
 /**
- * Check dynamic JSON document for overflow and log a corresponding message,
+ * Check JSON document for overflow and log a corresponding message,
  * otherwise log its document size.
  * 
- * @param[in] jsonDoc   Dynamic JSON document, which to check.
+ * @param[in] jsonDoc   JSON document, which to check.
  * @param[in] line      Line number where the document is handled in the module.
  */
-void PluginMgr::checkJsonDocOverflow(const DynamicJsonDocument& jsonDoc, int line)
+void PluginMgr::checkJsonDocOverflow(const JsonDocument& jsonDoc, int line)
 {
     if (true == jsonDoc.overflowed())
     {
@@ -405,7 +468,7 @@ void PluginMgr::registerTopics(IPluginMaintenance* plugin)
     if (nullptr != plugin)
     {
         const size_t        JSON_DOC_SIZE   = 512U;
-        DynamicJsonDocument topicsDoc(JSON_DOC_SIZE);
+        PooledJsonDocument  topicsDoc(JSON_DOC_SIZE);
         JsonArray           topics          = topicsDoc.createNestedArray("topics");
 
         /* Get topics from plugin. */
@@ -418,12 +481,11 @@ void PluginMgr::registerTopics(IPluginMaintenance* plugin)
 
             if (nullptr != metaData)
             {
-                String baseUriByUid     = getRestApiBaseUriByUid(plugin->getUID());
-                String baseUriByAlias;
+                String baseUriByUid = getRestApiBaseUriByUid(plugin->getUID());
 
                 if (false == plugin->getAlias().isEmpty())
                 {
-                    baseUriByAlias = getRestApiBaseUriByAlias(plugin->getAlias());
+                    metaData->baseUriByAlias = getRestApiBaseUriByAlias(plugin->getAlias());
                 }
 
                 metaData->plugin = plugin;
@@ -432,9 +494,9 @@ void PluginMgr::registerTopics(IPluginMaintenance* plugin)
                 {
                     registerTopic(baseUriByUid, metaData, topic.as<String>());
 
-                    if (false == baseUriByAlias.isEmpty())
+                    if (false == metaData->baseUriByAlias.isEmpty())
                     {
-                        registerTopic(baseUriByAlias, metaData, topic.as<String>());
+                        registerTopic(metaData->baseUriByAlias, metaData, topic.as<String>());
                     }
                 }
 
@@ -449,208 +511,16 @@ void PluginMgr::registerTopics(IPluginMaintenance* plugin)
 
 void PluginMgr::registerTopic(const String& baseUri, PluginObjData* metaData, const String& topic)
 {
-    String          topicUri        = baseUri + topic;
-    uint8_t         idx             = 0U;
-    WebHandlerData* webHandlerData  = nullptr;
-
-    /* Find empty web handler slot */
-    for(idx = 0U; idx < PluginObjData::MAX_WEB_HANDLERS; ++idx)
-    {
-        if (nullptr == metaData->webHandlers[idx].webHandler)
-        {
-            webHandlerData = &metaData->webHandlers[idx];
-            break;
-        }
-    }
-
-    if (nullptr == webHandlerData)
+    if (false == m_topicHandler.registerTopic(baseUri, topic, metaData->plugin))
     {
-        LOG_WARNING("[%s][%u] No web handler available anymore.", metaData->plugin->getName(), metaData->plugin->getUID());
+        LOG_WARNING("[%s][%u] Couldn't register: %s%s", metaData->plugin->getName(), metaData->plugin->getUID(), baseUri.c_str(), topic.c_str());
     }
     else
     {
-        IPluginMaintenance* plugin = metaData->plugin;
-
-        webHandlerData->webHandler  = &MyWebServer::getInstance().on(
-                                        topicUri.c_str(),
-                                        HTTP_ANY,
-                                        [this, plugin, topic, webHandlerData](AsyncWebServerRequest *request)
-                                        {
-                                            this->webReqHandler(request, plugin, topic, webHandlerData);
-                                        },
-                                        [this, plugin, topic, webHandlerData](AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final)
-                                        {
-                                            this->uploadHandler(request, filename, index, data, len, final, plugin, topic, webHandlerData);
-                                        });
-        webHandlerData->uri         = topicUri;
-
-        LOG_INFO("[%s][%u] Register: %s", metaData->plugin->getName(), metaData->plugin->getUID(), topicUri.c_str());
+        LOG_INFO("[%s][%u] Register: %s%s", metaData->plugin->getName(), metaData->plugin->getUID(), baseUri.c_str(), topic.c_str());
     }
 }
 
-void PluginMgr::webReqHandler(AsyncWebServerRequest *request, IPluginMaintenance* plugin, const String& topic, WebHandlerData* webHandlerData)
-{
-    String              content;
-    const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    JsonObject          dataObj         = jsonDoc.createNestedObject("data");
-    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-
-    if ((nullptr == request) ||
-        (nullptr == plugin) ||
-        (nullptr == webHandlerData))
-    {
-        return;
-    }
-
-    if (HTTP_GET == request->method())
-    {
-        if (false == plugin->getTopic(topic, dataObj))
-        {
-            RestUtil::prepareRspError(jsonDoc, "Requested topic not supported.");
-
-            jsonDoc.remove("data");
-
-            httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
-        }
-        else
-        {
-            jsonDoc["status"]   = "ok";
-            httpStatusCode      = HttpStatus::STATUS_CODE_OK;
-        }
-    }
-    else if (HTTP_POST == request->method())
-    {
-        DynamicJsonDocument jsonDocPar(JSON_DOC_SIZE);
-        size_t              idx = 0U;
-
-        /* Add arguments */
-        for(idx = 0U; idx < request->args(); ++idx)
-        {
-            jsonDocPar[request->argName(idx)] = request->arg(idx);
-        }
-
-        /* Add uploaded file */
-        if ((false == webHandlerData->isUploadError) &&
-            (false == webHandlerData->fullPath.isEmpty()))
-        {
-            jsonDocPar["fullPath"] = webHandlerData->fullPath;
-        }
-
-        if (false == plugin->setTopic(topic, jsonDocPar.as<JsonObject>()))
-        {
-            RestUtil::prepareRspError(jsonDoc, "Requested topic not supported or invalid data.");
-
-            jsonDoc.remove("data");
-
-            /* If a file is available, it will be removed now. */
-            if (false == webHandlerData->fullPath.isEmpty())
-            {
-                (void)FILESYSTEM.remove(webHandlerData->fullPath);
-            }
-
-            httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
-        }
-        else
-        {
-            jsonDoc["status"]   = "ok";
-            httpStatusCode      = HttpStatus::STATUS_CODE_OK;
-        }
-    }
-    else
-    {
-        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
-
-        jsonDoc.remove("data");
-
-        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
-    }
-
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
-
-    return;
-}
-
-void PluginMgr::uploadHandler(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final, IPluginMaintenance* plugin, const String& topic, WebHandlerData* webHandlerData)
-{
-    /* Begin of upload? */
-    if (0 == index)
-    {
-        AsyncWebHeader* headerXFileSize = request->getHeader("X-File-Size");
-        size_t          fileSize        = request->contentLength();
-        size_t          fileSystemSpace = FILESYSTEM.totalBytes() - FILESYSTEM.usedBytes();
-
-        /* File size available? */
-        if (nullptr != headerXFileSize)
-        {
-            uint32_t u32FileSize = 0U;
-
-            if (true == Util::strToUInt32(headerXFileSize->value(), u32FileSize))
-            {
-                fileSize = u32FileSize;
-            }
-        }
-
-        if (fileSystemSpace <= fileSize)
-        {
-            LOG_WARNING("Upload of %s aborted. Not enough space.", filename.c_str());
-            webHandlerData->isUploadError = true;
-            webHandlerData->fullPath.clear();
-        }
-        else
-        {
-            LOG_INFO("Upload of %s (%d bytes) starts.", filename.c_str(), fileSize);
-            webHandlerData->isUploadError = false;
-            webHandlerData->fullPath.clear();
-
-            /* Ask plugin, whether the upload is allowed or not. */
-            if (false == plugin->isUploadAccepted(topic, filename, webHandlerData->fullPath))
-            {
-                LOG_WARNING("[%s][%u] Upload not supported.", plugin->getName(), plugin->getUID());
-                webHandlerData->isUploadError = true;
-                webHandlerData->fullPath.clear();
-            }
-            else
-            {
-                /* Create a new file and overwrite a existing one. */
-                webHandlerData->fd = FILESYSTEM.open(webHandlerData->fullPath, "w");
-
-                if (false == webHandlerData->fd)
-                {
-                    LOG_ERROR("Couldn't create file: %s", webHandlerData->fullPath.c_str());
-                    webHandlerData->isUploadError = true;
-                    webHandlerData->fullPath.clear();
-                }
-            }
-        }
-    }
-
-    if (false == webHandlerData->isUploadError)
-    {
-        /* If file is open, write data to it. */
-        if (true == webHandlerData->fd)
-        {
-            if (len != webHandlerData->fd.write(data, len))
-            {
-                LOG_ERROR("Less data written, upload aborted.");
-                webHandlerData->isUploadError = true;
-                webHandlerData->fullPath.clear();
-                webHandlerData->fd.close();
-            }
-        }
-
-        /* Upload finished? */
-        if (true == final)
-        {
-            LOG_INFO("Upload of %s finished.", filename.c_str());
-
-            webHandlerData->fd.close();
-        }
-    }
-
-    return;
-}
-
 void PluginMgr::unregisterTopics(IPluginMaintenance* plugin)
 {
     if (nullptr != plugin)
@@ -684,20 +554,23 @@ void PluginMgr::unregisterTopics(IPluginMaintenance* plugin)
             if ((true == isFound) &&
                 (nullptr != pluginMeta))
             {
-                uint8_t idx = 0U;
+                const size_t        JSON_DOC_SIZE   = 512U;
+                PooledJsonDocument  topicsDoc(JSON_DOC_SIZE);
+                JsonArray           topics          = topicsDoc.createNestedArray("topics");
+                String              baseUriByUid    = getRestApiBaseUriByUid(plugin->getUID());
 
-                for(idx = 0U; idx < PluginObjData::MAX_WEB_HANDLERS; ++idx)
-                {
-                    if (nullptr != pluginMeta->webHandlers[idx].webHandler)
-                    {
-                        LOG_INFO("[%s][%u] Unregister: %s", pluginMeta->plugin->getName(), pluginMeta->plugin->getUID(), pluginMeta->webHandlers[idx].uri.c_str());
+                /* The topics of a plugin never change. */
+                plugin->getTopics(topics);
 
-                        if (false == MyWebServer::getInstance().removeHandler(pluginMeta->webHandlers[idx].webHandler))
-                        {
-                            LOG_WARNING("Couldn't remove handler %u.", idx);
-                        }
+                for (JsonVariant topic : topics)
+                {
+                    LOG_INFO("[%s][%u] Unregister: %s%s", plugin->getName(), plugin->getUID(), baseUriByUid.c_str(), topic.as<const char*>());
+                    m_topicHandler.unregisterTopic(baseUriByUid, topic.as<String>());
 
-                        pluginMeta->webHandlers[idx].webHandler = nullptr;
+                    if (false == pluginMeta->baseUriByAlias.isEmpty())
+                    {
+                        LOG_INFO("[%s][%u] Unregister: %s%s", plugin->getName(), plugin->getUID(), pluginMeta->baseUriByAlias.c_str(), topic.as<const char*>());
+                        m_topicHandler.unregisterTopic(pluginMeta->baseUriByAlias, topic.as<String>());
                     }
                 }
 
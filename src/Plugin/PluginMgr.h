@@ -47,6 +47,7 @@
 #include "IPluginMaintenance.hpp"
 #include "DisplayMgr.h"
 #include "PluginFactory.h"
+#include "PluginTopicHandler.h"
 
 #include <LinkedList.hpp>
 #include <ESPAsyncWebServer.h>
@@ -155,6 +156,24 @@ public:
      */
     String getRestApiBaseUriByAlias(const String& alias);
 
+    /**
+     * Find a installed plugin, which provides topics, by its UID.
+     *
+     * @param[in] uid   Plugin UID
+     *
+     * @return If found, it will return the plugin otherwise nullptr.
+     */
+    IPluginMaintenance* findPluginByUID(uint16_t uid);
+
+    /**
+     * Find a installed plugin, which provides topics, by its alias name.
+     *
+     * @param[in] alias Plugin alias name
+     *
+     * @return If found, it will return the plugin otherwise nullptr.
+     */
+    IPluginMaintenance* findPluginByAlias(const String& alias);
+
     /**
      * Load plugin installation from persistent memory.
      * It will automatically enable the installed plugins.
@@ -169,58 +188,35 @@ public:
 
 private:
 
-    /**
-     * Web handler data, which is necessary for the webserver handling.
-     */
-    struct WebHandlerData
-    {
-        AsyncCallbackWebHandler*    webHandler;     /**< Webhandler callback, necessary to remove it later again. */
-        String                      uri;            /**< URI where the handler is registered. */
-        bool                        isUploadError;  /**< If upload error happened, it will be true otherwise false. */
-        String                      fullPath;       /**< Full path of uploaded file. If empty, there is no file available. */
-        File                        fd;             /**< Upload file descriptor */
-
-        /**
-         * Initialize the web handler data.
-         */
-        WebHandlerData() :
-            webHandler(nullptr),
-            uri(),
-            isUploadError(false),
-            fullPath(),
-            fd()
-        {
-        }
-    };
-
     /**
      * Plugin object specific data, used for plugin management.
      */
     struct PluginObjData
     {
-        static const uint8_t MAX_WEB_HANDLERS = 16U; /**< Max. number of web handlers. */
-
-        IPluginMaintenance* plugin;                         /**< Plugin object, where this data record belongs to. */
-        WebHandlerData      webHandlers[MAX_WEB_HANDLERS];  /**< Web data of the plugin, necessary to remove it later again. */
+        IPluginMaintenance* plugin;         /**< Plugin object, where this data record belongs to. */
+        String              baseUriByAlias; /**< REST API base URI by alias, which the topics are registered with. Empty if no alias is used. */
 
         /**
          * Initializes the plugin object data.
          */
         PluginObjData() :
             plugin(nullptr),
-            webHandlers()
+            baseUriByAlias()
         {
         }
     };
 
     PluginFactory               m_pluginFactory;    /**< The plugin factory with the plugin type registry. */
     DLinkedList<PluginObjData*> m_pluginMeta;       /**< Plugin object management information. */
+    PluginTopicHandler          m_topicHandler;     /**< Web request handler for all plugin topics. */
 
     /**
      * Constructs the plugin manager.
      */
     PluginMgr() :
-        m_pluginFactory()
+        m_pluginFactory(),
+        m_pluginMeta(),
+        m_topicHandler()
     {
     }
 
@@ -236,13 +232,13 @@ private:
     PluginMgr& operator=(const PluginMgr& fab);
 
     /**
-     * Check dynamic JSON document for overflow and log a corresponding message,
+     * Check JSON document for overflow and log a corresponding message,
      * otherwise log its document size.
      * 
-     * @param[in] jsonDoc   Dynamic JSON document, which to check.
+     * @param[in] jsonDoc   JSON document, which to check.
      * @param[in] line      Line number where the document is handled in the module.
      */
-    void checkJsonDocOverflow(const DynamicJsonDocument& jsonDoc, int line);
+    void checkJsonDocOverflow(const JsonDocument& jsonDoc, int line);
 
     /**
      * If configuration directory doesn't exists, it will be created.
@@ -298,31 +294,6 @@ private:
      */
     void registerTopic(const String& baseUri, PluginObjData* metaData, const String& topic);
 
-    /**
-     * The web request handler handles all incoming HTTP requests for every plugin topic.
-     * 
-     * @param[in] request           The web request information from the client.
-     * @param[in] plugin            The responsible plugin, which is related to the request.
-     * @param[in] topic             The topic, which is requested.
-     * @param[in] webHandlerData    Plugin web handler data, which is related to this request.
-     */
-    void webReqHandler(AsyncWebServerRequest *request, IPluginMaintenance* plugin, const String& topic, WebHandlerData* webHandlerData);
-
-    /**
-     * File upload handler.
-     *
-     * @param[in] request           HTTP request.
-     * @param[in] filename          Name of the uploaded file.
-     * @param[in] index             Current file offset.
-     * @param[in] data              Next data part of file, starting at offset.
-     * @param[in] len               Data part size in byte.
-     * @param[in] final             Is final packet or not.
-     * @param[in] plugin            The responsible plugin, which is related to the upload.
-     * @param[in] topic             The topic, which is requested.
-     * @param[in] webHandlerData    Plugin web handler data, which is related to this upload.
-     */
-    void uploadHandler(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final, IPluginMaintenance* plugin, const String& topic, WebHandlerData* webHandlerData);
-
     /**
      * Unregister all topics depended on the used communication networks.
      * 
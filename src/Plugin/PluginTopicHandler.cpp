@@ -0,0 +1,396 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin topic request handler
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PluginTopicHandler.h"
+#include "RestApi.h"
+#include "RestUtil.h"
+#include "HttpStatus.h"
+#include "FileSystem.h"
+#include "JsonDocPool.h"
+
+#include <Logging.h>
+#include <Util.h>
+#include <ArduinoJson.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+PluginTopicHandler::PluginTopicHandler() :
+    AsyncWebHandler(),
+    m_baseUri(RestApi::BASE_URI),
+    m_routes(),
+    m_mutex()
+{
+    m_baseUri += "/display";
+
+    (void)m_mutex.create();
+}
+
+PluginTopicHandler::~PluginTopicHandler()
+{
+    m_mutex.destroy();
+}
+
+bool PluginTopicHandler::registerTopic(const String& baseUri, const String& topic, IPluginMaintenance* plugin)
+{
+    bool isSuccessful = false;
+
+    if ((nullptr != plugin) &&
+        (true == baseUri.startsWith(m_baseUri)))
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        String                      path    = baseUri.substring(m_baseUri.length()) + topic;
+        Route                       route;
+
+        route.plugin    = plugin;
+        route.topicPos  = static_cast<uint16_t>(path.length() - topic.length());
+
+        isSuccessful = m_routes.insert(path.c_str(), route);
+    }
+
+    return isSuccessful;
+}
+
+void PluginTopicHandler::unregisterTopic(const String& baseUri, const String& topic)
+{
+    if (true == baseUri.startsWith(m_baseUri))
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        String                      path    = baseUri.substring(m_baseUri.length()) + topic;
+
+        (void)m_routes.remove(path.c_str());
+    }
+}
+
+bool PluginTopicHandler::canHandle(AsyncWebServerRequest* request)
+{
+    bool isHandled = false;
+
+    if (nullptr != request)
+    {
+        Route   route;
+        String  topic;
+
+        isHandled = findRoute(request->url(), route, topic);
+    }
+
+    return isHandled;
+}
+
+void PluginTopicHandler::handleRequest(AsyncWebServerRequest* request)
+{
+    const size_t        JSON_DOC_SIZE           = 1024U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+    JsonObject          dataObj                 = jsonDoc.createNestedObject("data");
+    uint32_t            httpStatusCode          = HttpStatus::STATUS_CODE_OK;
+    Route               route;
+    String              topic;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    /* The plugin might be uninstalled in the meantime. */
+    if (false == findRoute(request->url(), route, topic))
+    {
+        RestUtil::prepareRspError(jsonDoc, "Plugin not found.");
+
+        jsonDoc.remove("data");
+
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else if (HTTP_GET == request->method())
+    {
+        if (false == route.plugin->getTopic(topic, dataObj))
+        {
+            RestUtil::prepareRspError(jsonDoc, "Requested topic not supported.");
+
+            jsonDoc.remove("data");
+
+            httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+        }
+        else
+        {
+            jsonDoc["status"]   = "ok";
+            httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+        }
+    }
+    else if (HTTP_POST == request->method())
+    {
+        const char* fullPath        = static_cast<const char*>(request->_tempObject);
+        size_t      jsonDocParSize  = JSON_DOC_SIZE;
+        size_t      idx             = 0U;
+
+        /* The arguments are copied into the JSON document. Consider them in the
+         * document size, otherwise long values like a command list get lost.
+         */
+        for(idx = 0U; idx < request->args(); ++idx)
+        {
+            jsonDocParSize += request->argName(idx).length() + request->arg(idx).length() + 2U;
+        }
+
+        /* The document is allocated on the heap, therefore its size is limited. */
+        if (JSON_DOC_PAR_SIZE_MAX < jsonDocParSize)
+        {
+            RestUtil::prepareRspError(jsonDoc, "Request too large.");
+
+            jsonDoc.remove("data");
+
+            /* If a file is available, it will be removed now. */
+            if (nullptr != fullPath)
+            {
+                (void)FILESYSTEM.remove(fullPath);
+            }
+
+            httpStatusCode = HttpStatus::STATUS_CODE_PAYLOAD_TOO_LARGE;
+        }
+        else
+        {
+            PooledJsonDocument jsonDocPar(jsonDocParSize);
+
+            /* Add arguments */
+            for(idx = 0U; idx < request->args(); ++idx)
+            {
+                jsonDocPar[request->argName(idx)] = request->arg(idx);
+            }
+
+            /* Add uploaded file */
+            if (nullptr != fullPath)
+            {
+                jsonDocPar["fullPath"] = fullPath;
+            }
+
+            if (false == route.plugin->setTopic(topic, jsonDocPar.as<JsonObject>()))
+            {
+                RestUtil::prepareRspError(jsonDoc, "Requested topic not supported or invalid data.");
+
+                jsonDoc.remove("data");
+
+                /* If a file is available, it will be removed now. */
+                if (nullptr != fullPath)
+                {
+                    (void)FILESYSTEM.remove(fullPath);
+                }
+
+                httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+            }
+            else
+            {
+                jsonDoc["status"]   = "ok";
+                httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+            }
+        }
+    }
+    else
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+
+        jsonDoc.remove("data");
+
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+
+    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+
+    return;
+}
+
+void PluginTopicHandler::handleUpload(AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data, size_t len, bool final)
+{
+    Route   route;
+    String  topic;
+
+    if ((nullptr == request) ||
+        (false == findRoute(request->url(), route, topic)))
+    {
+        return;
+    }
+
+    /* Begin of upload? */
+    if (0U == index)
+    {
+        AsyncWebHeader* headerXFileSize = request->getHeader("X-File-Size");
+        size_t          fileSize        = request->contentLength();
+        size_t          fileSystemSpace = FILESYSTEM.totalBytes() - FILESYSTEM.usedBytes();
+
+        clearUploadPath(request);
+
+        /* File size available? */
+        if (nullptr != headerXFileSize)
+        {
+            uint32_t u32FileSize = 0U;
+
+            if (true == Util::strToUInt32(headerXFileSize->value(), u32FileSize))
+            {
+                fileSize = u32FileSize;
+            }
+        }
+
+        if (fileSystemSpace <= fileSize)
+        {
+            LOG_WARNING("Upload of %s aborted. Not enough space.", filename.c_str());
+        }
+        else
+        {
+            String fullPath;
+
+            LOG_INFO("Upload of %s (%d bytes) starts.", filename.c_str(), fileSize);
+
+            /* Ask plugin, whether the upload is allowed or not. */
+            if (false == route.plugin->isUploadAccepted(topic, filename, fullPath))
+            {
+                LOG_WARNING("[%s][%u] Upload not supported.", route.plugin->getName(), route.plugin->getUID());
+            }
+            else
+            {
+                /* Create a new file and overwrite a existing one. */
+                request->_tempFile = FILESYSTEM.open(fullPath, "w");
+
+                if (false == request->_tempFile)
+                {
+                    LOG_ERROR("Couldn't create file: %s", fullPath.c_str());
+                }
+                else
+                {
+                    setUploadPath(request, fullPath);
+                }
+            }
+        }
+    }
+
+    /* Upload not aborted? */
+    if (nullptr != request->_tempObject)
+    {
+        /* If file is open, write data to it. */
+        if (true == request->_tempFile)
+        {
+            if (len != request->_tempFile.write(data, len))
+            {
+                LOG_ERROR("Less data written, upload aborted.");
+                clearUploadPath(request);
+                request->_tempFile.close();
+            }
+        }
+
+        /* Upload finished? */
+        if (true == final)
+        {
+            LOG_INFO("Upload of %s finished.", filename.c_str());
+
+            request->_tempFile.close();
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool PluginTopicHandler::findRoute(const String& url, Route& route, String& topic) const
+{
+    bool isFound = false;
+
+    if (true == url.startsWith(m_baseUri))
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        const char*                 path    = &url.c_str()[m_baseUri.length()];
+        size_t                      pathLen = url.length() - m_baseUri.length();
+
+        if (true == m_routes.find(path, pathLen, route))
+        {
+            topic   = &path[route.topicPos];
+            isFound = true;
+        }
+    }
+
+    return isFound;
+}
+
+void PluginTopicHandler::setUploadPath(AsyncWebServerRequest* request, const String& fullPath)
+{
+    clearUploadPath(request);
+
+    /* The temporary object is released by the request. */
+    request->_tempObject = malloc(fullPath.length() + 1U);
+
+    if (nullptr != request->_tempObject)
+    {
+        memcpy(request->_tempObject, fullPath.c_str(), fullPath.length() + 1U);
+    }
+}
+
+void PluginTopicHandler::clearUploadPath(AsyncWebServerRequest* request)
+{
+    if (nullptr != request->_tempObject)
+    {
+        free(request->_tempObject);
+        request->_tempObject = nullptr;
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
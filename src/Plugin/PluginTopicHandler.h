@@ -0,0 +1,209 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin topic request handler
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __PLUGIN_TOPIC_HANDLER_H__
+#define __PLUGIN_TOPIC_HANDLER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "IPluginMaintenance.hpp"
+
+#include <ESPAsyncWebServer.h>
+#include <PrefixTree.hpp>
+#include <Mutex.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A single web request handler for all plugin topics. It is mounted at
+ * the display REST API base URI and dispatches every request by its path
+ * (uid/alias and topic) with a prefix tree lookup. Therefore no web handler
+ * per topic is necessary and the dispatch costs are independent of the
+ * number of installed plugins.
+ */
+class PluginTopicHandler : public AsyncWebHandler
+{
+public:
+
+    /**
+     * Constructs the plugin topic request handler.
+     */
+    PluginTopicHandler();
+
+    /**
+     * Destroys the plugin topic request handler.
+     */
+    ~PluginTopicHandler();
+
+    /**
+     * Register a plugin topic.
+     *
+     * @param[in] baseUri   The plugin REST API base URI, which must be below the display base URI.
+     * @param[in] topic     The topic.
+     * @param[in] plugin    The plugin, which provides the topic.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool registerTopic(const String& baseUri, const String& topic, IPluginMaintenance* plugin);
+
+    /**
+     * Unregister a plugin topic.
+     *
+     * @param[in] baseUri   The plugin REST API base URI, which must be below the display base URI.
+     * @param[in] topic     The topic.
+     */
+    void unregisterTopic(const String& baseUri, const String& topic);
+
+    /**
+     * Checks whether the request can be handled.
+     *
+     * @param[in] request   Web request
+     *
+     * @return If request can be handled, it will return true otherwise false.
+     */
+    bool canHandle(AsyncWebServerRequest* request) final;
+
+    /**
+     * Handles the request.
+     *
+     * @param[in] request   Web request, which to handle.
+     */
+    void handleRequest(AsyncWebServerRequest* request) final;
+
+    /**
+     * Handles a file upload.
+     * The upload state is kept in the request, the file descriptor in
+     * its temporary file and the full path in its temporary object.
+     *
+     * @param[in] request   HTTP request.
+     * @param[in] filename  Name of the uploaded file.
+     * @param[in] index     Current file offset.
+     * @param[in] data      Next data part of file, starting at offset.
+     * @param[in] len       Data part size in byte.
+     * @param[in] final     Is final packet or not.
+     */
+    void handleUpload(AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data, size_t len, bool final) final;
+
+    /**
+     * Non-trivial handler.
+     * This is important to control the HTTP body parsing. In case of a non-trivial
+     * handler, the webserver will parse the body and provides encoded parameters to
+     * the request handler.
+     */
+    bool isRequestHandlerTrivial() final
+    {
+        return false;
+    }
+
+    /**
+     * Max. size in byte of the JSON document with the topic parameters.
+     * It covers the largest topic argument, the canvas command list.
+     */
+    static const size_t JSON_DOC_PAR_SIZE_MAX   = 6144U;
+
+private:
+
+    /**
+     * A route to a plugin topic.
+     */
+    struct Route
+    {
+        IPluginMaintenance* plugin;     /**< Plugin, which provides the topic. */
+        uint16_t            topicPos;   /**< Position of the topic in the route path. */
+
+        /**
+         * Initializes the route.
+         */
+        Route() :
+            plugin(nullptr),
+            topicPos(0U)
+        {
+        }
+    };
+
+    String                  m_baseUri;  /**< Display REST API base URI, where the handler is mounted. */
+    PrefixTree<Route>       m_routes;   /**< Routes by path, relative to the base URI. */
+    mutable MutexRecursive  m_mutex;    /**< Mutex to protect the routes against concurrent access. */
+
+    PluginTopicHandler(const PluginTopicHandler& handler);
+    PluginTopicHandler& operator=(const PluginTopicHandler& handler);
+
+    /**
+     * Find the route of the requested URL.
+     *
+     * @param[in]   url     Requested URL
+     * @param[out]  route   Route
+     * @param[out]  topic   Requested topic
+     *
+     * @return If a route is found, it will return true otherwise false.
+     */
+    bool findRoute(const String& url, Route& route, String& topic) const;
+
+    /**
+     * Set the full path of the uploaded file in the request.
+     *
+     * @param[in] request   HTTP request
+     * @param[in] fullPath  Full path of the uploaded file
+     */
+    static void setUploadPath(AsyncWebServerRequest* request, const String& fullPath);
+
+    /**
+     * Clear the full path of the uploaded file in the request,
+     * which means there is no uploaded file available.
+     *
+     * @param[in] request   HTTP request
+     */
+    static void clearUploadPath(AsyncWebServerRequest* request);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PLUGIN_TOPIC_HANDLER_H__ */
+
+/** @} */
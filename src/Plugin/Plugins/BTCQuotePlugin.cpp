@@ -38,7 +38,10 @@
 
 #include <ArduinoJson.h>
 #include <Logging.h>
+#include <Util.h>
 #include <JsonFile.h>
+#include <JsonStreamFilter.h>
+#include <memory>
 
 /******************************************************************************
  * Compiler Switches
@@ -69,7 +72,9 @@ const char* BTCQuotePlugin::BTC_USD_IMAGE_PATH     = "/images/BTC_USD.bmp";
 
 void BTCQuotePlugin::start(uint16_t width, uint16_t height)
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
+    const size_t                JSON_DOC_SIZE   = 512U;
+    DynamicJsonDocument         jsonDoc(JSON_DOC_SIZE);
+    MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_iconCanvas.setPosAndSize(0, 0, ICON_WIDTH, ICON_HEIGHT);
     (void)m_iconCanvas.addWidget(m_bitmapWidget);
@@ -79,16 +84,17 @@ void BTCQuotePlugin::start(uint16_t width, uint16_t height)
     m_textCanvas.setPosAndSize(ICON_WIDTH, 0, width - ICON_WIDTH, height);
     (void)m_textCanvas.addWidget(m_textWidget);
 
-    initHttpClient();
-    if (false == startHttpRequest())
-    {
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
-    }
-    else
+    /* Show the data received before the restart, until fresh data is available. */
+    m_warmCache.setFullPath(generateFullPath("_warm.json"));
+    if (true == m_warmCache.load(jsonDoc))
     {
-        m_requestTimer.start(UPDATE_PERIOD);
+        handleWebResponse(jsonDoc);
+        m_textWidget.setTextColor(WarmCache::STALE_COLOR);
     }
 
+    initHttpClient();
+    (void)startHttpRequest();
+
     return;
 }
 
@@ -96,7 +102,8 @@ void BTCQuotePlugin::stop()
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
-    m_requestTimer.stop();
+    m_client.unsubscribe();
+    m_warmCache.remove();
 
     return;
 }
@@ -106,19 +113,6 @@ void BTCQuotePlugin::process()
     Msg                         msg;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
-    {
-        if (false == startHttpRequest())
-        {
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
-        }
-        else
-        {
-            m_requestTimer.start(UPDATE_PERIOD);
-        }
-    }
-
     if (true == m_taskProxy.receive(msg))
     {
         switch(msg.type)
@@ -131,7 +125,10 @@ void BTCQuotePlugin::process()
             if (nullptr != msg.rsp)
             {
                 handleWebResponse(*msg.rsp);
-                delete msg.rsp;
+                m_textWidget.setTextColor(TextWidget::DEFAULT_TEXT_COLOR);
+
+                /* The warm cache takes over the response and writes it in the main loop context. */
+                m_warmCache.save(msg.rsp);
                 msg.rsp = nullptr;
             }
             break;
@@ -145,6 +142,52 @@ void BTCQuotePlugin::process()
     return;
 }
 
+uint32_t BTCQuotePlugin::getNextWakeup() const
+{
+    uint32_t                    nextWakeup  = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Pending messages from the web task shall be handled in the next cycle.
+     * Otherwise the task proxy wakes the plugin up.
+     */
+    if (true == m_taskProxy.isEmpty())
+    {
+        nextWakeup = UINT32_MAX;
+    }
+
+    return nextWakeup;
+}
+
+void BTCQuotePlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    UTIL_NOT_USED(gfx);
+
+    /* The data of the shown plugin shall be requested first. */
+    m_client.setPriority(FetchScheduler::PRIORITY_HIGH);
+
+    return;
+}
+
+void BTCQuotePlugin::inactive()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.setPriority(FetchScheduler::PRIORITY_NORMAL);
+
+    return;
+}
+
+void BTCQuotePlugin::prepareActive(uint32_t timeToActive, uint32_t duration)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.prefetch(timeToActive + duration);
+
+    return;
+}
+
 void BTCQuotePlugin::update(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -169,17 +212,13 @@ bool BTCQuotePlugin::startHttpRequest()
     bool    status  = false;
     String  url     = String("http://api.coindesk.com/v1/bpi/currentprice/USD.json");
 
-    if (true == m_client.begin(url))
+    if (false == m_client.subscribe(url, UPDATE_PERIOD))
     {
-        if (false == m_client.GET())
-        {
-            LOG_WARNING("GET %s failed.", url.c_str());
-        }
-        else
-        {
-            LOG_INFO("GET %s success.", url.c_str());
-            status = true;
-        }
+        LOG_WARNING("Subscribe to %s failed.", url.c_str());
+    }
+    else
+    {
+        status = true;
     }
 
     return status;
@@ -187,54 +226,99 @@ bool BTCQuotePlugin::startHttpRequest()
 
 void BTCQuotePlugin::initHttpClient()
 {
-    /* Note: All registered callbacks are running in a different task context!
-     *       Therefore it is not allowed to access a member here directly.
-     *       The processing must be deferred via task proxy.
-     */
-    m_client.regOnResponse(
-        [this](const HttpResponse& rsp)
+    const size_t                        FILTER_SIZE     = 128U;
+    StaticJsonDocument<FILTER_SIZE>     filter;
+    std::shared_ptr<JsonStreamFilter>   streamFilter;
+
+    /* Process the plugin in the next cycle, after a message arrived. */
+    m_taskProxy.setWakeUp(
+        [this]()
         {
-            const size_t            JSON_DOC_SIZE   = 512U;
-            DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+            this->wakeUp();
+        }
+    );
 
-            if (nullptr != jsonDoc)
-            {
-                size_t                          payloadSize = 0U;
-                const char*                     payload     = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
-                const size_t                    FILTER_SIZE = 128U;
-                StaticJsonDocument<FILTER_SIZE> filter;
-                DeserializationError            error;
+    /* The response body is filtered while it is received, therefore only
+     * the filtered JSON text is kept instead of the whole body.
+     */
+    filter["bpi"]["USD"]["rate_float"]  = true;
+    filter["bpi"]["USD"]["rate"]        = true;
+
+    if (true == filter.overflowed())
+    {
+        LOG_ERROR("Less memory for filter available.");
+    }
 
-                filter["bpi"]["USD"]["rate_float"]      = true;
-                filter["bpi"]["USD"]["rate"]            = true;
+    streamFilter = std::shared_ptr<JsonStreamFilter>(new(std::nothrow) JsonStreamFilter(filter));
 
-                if (true == filter.overflowed())
+    if (nullptr == streamFilter)
+    {
+        LOG_ERROR("Couldn't create JSON stream filter.");
+    }
+    else
+    {
+        /* Note: All registered callbacks are running in a different task context!
+         *       Therefore it is not allowed to access a member here directly.
+         *       The processing must be deferred via task proxy.
+         *       The stream filter is only used in the callback context.
+         */
+        m_client.regOnBody(
+            [streamFilter](const uint8_t* data, size_t size, size_t index)
+            {
+                if (0U == index)
                 {
-                    LOG_ERROR("Less memory for filter available.");
+                    streamFilter->reset();
                 }
 
-                error = deserializeJson(*jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+                (void)streamFilter->parse(data, size);
+            }
+        );
 
-                if (DeserializationError::Ok != error.code())
+        m_client.regOnResponse(
+            [this, streamFilter](const HttpResponse& rsp)
+            {
+                const size_t            JSON_DOC_SIZE   = 512U;
+                DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+
+                UTIL_NOT_USED(rsp);
+
+                if (false == streamFilter->isComplete())
                 {
-                    LOG_ERROR("Invalid JSON message received: %s", error.c_str());
+                    LOG_WARNING("Incomplete or invalid JSON response.");
                 }
-                else
+                else if (nullptr != jsonDoc)
                 {
-                    Msg msg;
+                    DeserializationError error = deserializeJson(*jsonDoc, streamFilter->getOutput(), streamFilter->getOutputSize());
 
-                    msg.type    = MSG_TYPE_RSP;
-                    msg.rsp     = jsonDoc;
-
-                    if (false == this->m_taskProxy.send(msg))
+                    if (DeserializationError::Ok != error.code())
                     {
-                        delete jsonDoc;
-                        jsonDoc = nullptr;
+                        LOG_ERROR("Invalid JSON message received: %s", error.c_str());
                     }
+                    else
+                    {
+                        Msg msg;
+
+                        msg.type    = MSG_TYPE_RSP;
+                        msg.rsp     = jsonDoc;
+
+                        if (true == this->m_taskProxy.send(msg))
+                        {
+                            jsonDoc = nullptr;
+                        }
+                    }
+                }
+
+                if (nullptr != jsonDoc)
+                {
+                    delete jsonDoc;
+                    jsonDoc = nullptr;
                 }
+
+                /* Release the filtered JSON text until the next response. */
+                streamFilter->reset();
             }
-        }
-    );
+        );
+    }
 }
 
 void BTCQuotePlugin::handleWebResponse(DynamicJsonDocument& jsonDoc)
@@ -42,14 +42,14 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include "AsyncHttpClient.h"
+#include "FetchClient.h"
+#include "WarmCache.h"
 #include "Plugin.hpp"
 
 #include <WidgetGroup.h>
 #include <BitmapWidget.h>
 #include <stdint.h>
 #include <TextWidget.h>
-#include <SimpleTimer.hpp>
 #include <TaskProxy.hpp>
 #include <Mutex.hpp>
 
@@ -85,8 +85,8 @@ public:
         m_textWidget("\\calign?"),
         m_relevantResponsePart(""),
         m_client(),
+        m_warmCache(),
         m_mutex(),
-        m_requestTimer(),
         m_taskProxy()
     {
         /* Move the text widget one line lower for better look. */
@@ -100,15 +100,11 @@ public:
      */
     ~BTCQuotePlugin()
     {
-        m_client.regOnResponse(nullptr);
-        m_client.regOnClosed(nullptr);
-        m_client.regOnError(nullptr);
-
-        /* Abort any pending TCP request to avoid getting a callback after the
+        /* Unsubscribe first to avoid getting a callback after the
          * object is destroyed.
          */
-        m_client.abort();
-        
+        m_client.unsubscribe();
+
         clearQueue();
 
         m_mutex.destroy();
@@ -154,6 +150,39 @@ public:
      */
     void process(void) final;
 
+    /**
+     * Get the time in ms, until process() shall be called next.
+     * The plugin is only busy after a message from the web task arrived,
+     * which wakes it up via task proxy.
+     *
+     * @return Time in ms until the next process() call
+     */
+    uint32_t getNextWakeup() const final;
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
+    /**
+     * This method will be called in case the plugin will be set active soon.
+     * If the data would be refreshed during the activation anyway, it is
+     * requested now, to avoid that stale data is shown first.
+     *
+     * @param[in] timeToActive  Time in ms until the plugin will be set active.
+     * @param[in] duration      Duration in ms, the plugin will be active. 0 means infinite.
+     */
+    void prepareActive(uint32_t timeToActive, uint32_t duration) final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -180,24 +209,17 @@ private:
     static const char*      BTC_USD_IMAGE_PATH;
     /**
      * Period in ms for requesting quotes from Server (15 Minutes) (1 for testing!)
-     * This is used in case the last request to the server was successful.
      */
     static const uint32_t   UPDATE_PERIOD       = (15U * 60U * 1000U);
 
-    /**
-     * Short period in ms for requesting quote from server.
-     * This is used in case the request to the server failed.
-     */
-    static const uint32_t   UPDATE_PERIOD_SHORT = (60U * 1000U);
-
-    WidgetGroup         m_textCanvas;               /**< Canvas used for the text widget. */
-    WidgetGroup         m_iconCanvas;               /**< Canvas used for the bitmap widget. */
-    BitmapWidget        m_bitmapWidget;             /**< Bitmap widget, used to show the icon. */
-    TextWidget          m_textWidget;               /**< Text widget, used for showing the text. */
-    String              m_relevantResponsePart;     /**< String used for the relevant part of the HTTP response. */
-    AsyncHttpClient     m_client;                   /**< Asynchronous HTTP client. */
-    MutexRecursive      m_mutex;                    /**< Mutex to protect against concurrent access. */
-    SimpleTimer         m_requestTimer;             /**< Timer is used for cyclic weather http request. */
+    WidgetGroup             m_textCanvas;               /**< Canvas used for the text widget. */
+    WidgetGroup             m_iconCanvas;               /**< Canvas used for the bitmap widget. */
+    BitmapWidget            m_bitmapWidget;             /**< Bitmap widget, used to show the icon. */
+    TextWidget              m_textWidget;               /**< Text widget, used for showing the text. */
+    String                  m_relevantResponsePart;     /**< String used for the relevant part of the HTTP response. */
+    FetchClient             m_client;                   /**< Fetch client, which requests the data periodically. */
+    WarmCache               m_warmCache;                /**< Data received before the restart, shown until fresh data is available. */
+    mutable MutexRecursive  m_mutex;                    /**< Mutex to protect against concurrent access. */
 
     /**
      * Defines the message types, which are necessary for HTTP client/server handling.
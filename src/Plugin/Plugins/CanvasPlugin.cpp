@@ -0,0 +1,514 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Canvas plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "CanvasPlugin.h"
+
+#include <Logging.h>
+#include <FileSystem.h>
+#include <JsonDocPool.h>
+#include <ArduinoJson.h>
+#include <BmpImgLoader.h>
+#include <DrawCmd.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool getColor(const JsonVariantConst& value, Color& color);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize plugin topics. */
+const char* CanvasPlugin::TOPIC_DRAW        = "/draw";
+const char* CanvasPlugin::TOPIC_IMAGE       = "/image";
+
+/* Initialize bitmap image filename extension. */
+const char* CanvasPlugin::FILE_EXT_BITMAP   = ".bmp";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void CanvasPlugin::getTopics(JsonArray& topics) const
+{
+    (void)topics.add(TOPIC_DRAW);
+    (void)topics.add(TOPIC_IMAGE);
+}
+
+bool CanvasPlugin::getTopic(const String& topic, JsonObject& value) const
+{
+    bool isSuccessful = false;
+
+    if (0U != topic.equals(TOPIC_DRAW))
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        value["width"]  = m_buffers[m_frontIdx].getWidth();
+        value["height"] = m_buffers[m_frontIdx].getHeight();
+
+        isSuccessful = true;
+    }
+    else if (0U != topic.equals(TOPIC_IMAGE))
+    {
+        MutexGuard<MutexRecursive>  guard(m_drawMutex);
+        JsonArray                   images  = value.createNestedArray("images");
+        uint8_t                     imageId = 0U;
+
+        for(imageId = 0U; imageId < IMAGE_CNT_MAX; ++imageId)
+        {
+            JsonObject image = images.createNestedObject();
+
+            image["width"]  = m_images[imageId].getWidth();
+            image["height"] = m_images[imageId].getHeight();
+        }
+
+        isSuccessful = true;
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
+
+bool CanvasPlugin::setTopic(const String& topic, const JsonObject& value)
+{
+    bool isSuccessful = false;
+
+    if (0U != topic.equals(TOPIC_DRAW))
+    {
+        JsonVariantConst jsonCmds = value["cmds"];
+
+        if (false == jsonCmds.isNull())
+        {
+            MutexGuard<MutexRecursive> guard(m_drawMutex);
+
+            if (true == convertCmds(jsonCmds.as<String>()))
+            {
+                isSuccessful = draw(m_cmdList.get(), m_cmdList.getSize());
+            }
+        }
+    }
+    else if (0U != topic.equals(TOPIC_IMAGE))
+    {
+        JsonVariantConst    jsonId      = value["id"];
+        JsonVariantConst    jsonPath    = value["fullPath"];
+        uint8_t             imageId     = 0U;
+
+        if ((false == jsonId.isNull()) &&
+            (true == Util::strToUInt8(jsonId.as<String>(), imageId)) &&
+            (IMAGE_CNT_MAX > imageId))
+        {
+            MutexGuard<MutexRecursive>  guard(m_drawMutex);
+            String                      filename    = getImageFileName(imageId);
+
+            /* Without image, the cached one is removed. */
+            if (true == jsonPath.isNull())
+            {
+                m_images[imageId].release();
+                (void)FILESYSTEM.remove(filename);
+
+                isSuccessful = true;
+            }
+            else if (false == FILESYSTEM.rename(jsonPath.as<String>(), filename))
+            {
+                LOG_WARNING("Failed to rename %s.", jsonPath.as<String>().c_str());
+            }
+            else
+            {
+                isSuccessful = loadImage(imageId, filename);
+            }
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
+
+bool CanvasPlugin::isUploadAccepted(const String& topic, const String& srcFilename, String& dstFilename)
+{
+    bool isAccepted = false;
+
+    /* Accept upload of bitmap file, which is moved to the image cache later. */
+    if ((0U != topic.equals(TOPIC_IMAGE)) &&
+        (0U != srcFilename.endsWith(FILE_EXT_BITMAP)))
+    {
+        dstFilename = generateFullPath(String("_upload") + FILE_EXT_BITMAP);
+
+        isAccepted = true;
+    }
+
+    return isAccepted;
+}
+
+void CanvasPlugin::start(uint16_t width, uint16_t height)
+{
+    MutexGuard<MutexRecursive>  drawGuard(m_drawMutex);
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint8_t                     idx         = 0U;
+
+    for(idx = 0U; idx < BUFFER_CNT; ++idx)
+    {
+        if (false == m_buffers[idx].create(width, height))
+        {
+            LOG_ERROR("Not enough memory for the canvas.");
+        }
+        else
+        {
+            m_buffers[idx].fillScreen(ColorDef::BLACK);
+        }
+    }
+
+    if (false == m_cmdList.create(CMD_LIST_SIZE))
+    {
+        LOG_ERROR("Not enough memory for the command list.");
+    }
+
+    /* Restore the image cache. */
+    for(idx = 0U; idx < IMAGE_CNT_MAX; ++idx)
+    {
+        String filename = getImageFileName(idx);
+
+        if (true == FILESYSTEM.exists(filename))
+        {
+            (void)loadImage(idx, filename);
+        }
+    }
+
+    return;
+}
+
+void CanvasPlugin::stop()
+{
+    MutexGuard<MutexRecursive>  drawGuard(m_drawMutex);
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint8_t                     idx         = 0U;
+
+    for(idx = 0U; idx < BUFFER_CNT; ++idx)
+    {
+        m_buffers[idx].release();
+    }
+
+    for(idx = 0U; idx < IMAGE_CNT_MAX; ++idx)
+    {
+        String filename = getImageFileName(idx);
+
+        m_images[idx].release();
+
+        if (false != FILESYSTEM.remove(filename))
+        {
+            LOG_INFO("File %s removed", filename.c_str());
+        }
+    }
+
+    m_cmdList.release();
+
+    return;
+}
+
+void CanvasPlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    UTIL_NOT_USED(gfx);
+
+    m_isUpdated = true;
+
+    return;
+}
+
+void CanvasPlugin::update(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    gfx.drawBitmap(0, 0, m_buffers[m_frontIdx]);
+    m_isUpdated = false;
+
+    return;
+}
+
+bool CanvasPlugin::isUpdateRequired() const
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    return m_isUpdated;
+}
+
+bool CanvasPlugin::draw(const uint8_t* cmds, size_t size)
+{
+    bool                        isSuccessful    = false;
+    MutexGuard<MutexRecursive>  drawGuard(m_drawMutex);
+
+    /* The front buffer index is only changed here, therefore the draw mutex
+     * is sufficient to read it.
+     */
+    uint8_t                     backIdx         = (m_frontIdx + 1U) % BUFFER_CNT;
+    YAGfxDynamicBitmap&         back            = m_buffers[backIdx];
+
+    if (true == back.isAllocated())
+    {
+        const YAGfxBitmap*  images[IMAGE_CNT_MAX];
+        uint8_t             imageId = 0U;
+
+        for(imageId = 0U; imageId < IMAGE_CNT_MAX; ++imageId)
+        {
+            images[imageId] = (true == m_images[imageId].isAllocated()) ? &m_images[imageId] : nullptr;
+        }
+
+        /* Start with the current scene, so a command list can change it incrementally. */
+        back.copy(m_buffers[m_frontIdx]);
+
+        isSuccessful = DrawCmd::execute(back, m_gfxText, cmds, size, images, IMAGE_CNT_MAX);
+
+        if (true == isSuccessful)
+        {
+            MutexGuard<MutexRecursive> guard(m_mutex);
+
+            m_frontIdx  = backIdx;
+            m_isUpdated = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+String CanvasPlugin::getImageFileName(uint8_t imageId) const
+{
+    return generateFullPath(String("_") + imageId + FILE_EXT_BITMAP);
+}
+
+bool CanvasPlugin::loadImage(uint8_t imageId, const String& filename)
+{
+    BmpImgLoader        loader;
+    BmpImgLoader::Ret   ret     = loader.load(FILESYSTEM, filename, m_images[imageId]);
+
+    if (BmpImgLoader::RET_OK != ret)
+    {
+        LOG_WARNING("Failed to load image %s (%d).", filename.c_str(), ret);
+    }
+
+    return (BmpImgLoader::RET_OK == ret);
+}
+
+bool CanvasPlugin::convertCmds(const String& cmds)
+{
+    bool isSuccessful = false;
+
+    m_cmdList.clear();
+
+    if (CMDS_LENGTH_MAX < cmds.length())
+    {
+        LOG_WARNING("Command list too long.");
+    }
+    else
+    {
+        /* Every number or string in the command list needs a variant slot,
+         * which is bigger than the character it was parsed from.
+         */
+        const size_t            JSON_DOC_SIZE   = 4U * cmds.length() + 256U;
+        PooledJsonDocument      jsonDoc(JSON_DOC_SIZE);
+        DeserializationError    error           = deserializeJson(jsonDoc, cmds);
+
+        if (DeserializationError::Ok != error.code())
+        {
+            LOG_WARNING("JSON deserialization failed: %s", error.c_str());
+        }
+        else if (false == jsonDoc.is<JsonArray>())
+        {
+            LOG_WARNING("Command list is not a array.");
+        }
+        else
+        {
+            JsonArray   jsonCmds    = jsonDoc.as<JsonArray>();
+            uint32_t    idx         = 0U;
+
+            isSuccessful = true;
+
+            for(JsonArray jsonCmd: jsonCmds)
+            {
+                if (false == convertCmd(jsonCmd))
+                {
+                    LOG_WARNING("Command %u is invalid.", idx);
+                    isSuccessful = false;
+                    break;
+                }
+
+                ++idx;
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool CanvasPlugin::convertCmd(const JsonArray& cmd)
+{
+    bool        isSuccessful    = false;
+    String      name            = cmd[0].as<String>();
+    size_t      parCnt          = cmd.size();
+    Color       color;
+
+    if ((0U != name.equals("clear")) &&
+        (2U == parCnt) &&
+        (true == getColor(cmd[1], color)))
+    {
+        isSuccessful = m_cmdList.fillScreen(color);
+    }
+    else if ((0U != name.equals("fill")) &&
+             (6U == parCnt) &&
+             (true == getColor(cmd[5], color)))
+    {
+        isSuccessful = m_cmdList.fillRect(cmd[1].as<int16_t>(), cmd[2].as<int16_t>(), cmd[3].as<uint16_t>(), cmd[4].as<uint16_t>(), color);
+    }
+    else if ((0U != name.equals("rect")) &&
+             (6U == parCnt) &&
+             (true == getColor(cmd[5], color)))
+    {
+        isSuccessful = m_cmdList.drawRectangle(cmd[1].as<int16_t>(), cmd[2].as<int16_t>(), cmd[3].as<uint16_t>(), cmd[4].as<uint16_t>(), color);
+    }
+    else if ((0U != name.equals("line")) &&
+             (6U == parCnt) &&
+             (true == getColor(cmd[5], color)))
+    {
+        isSuccessful = m_cmdList.drawLine(cmd[1].as<int16_t>(), cmd[2].as<int16_t>(), cmd[3].as<int16_t>(), cmd[4].as<int16_t>(), color);
+    }
+    else if ((0U != name.equals("pixel")) &&
+             (4U == parCnt) &&
+             (true == getColor(cmd[3], color)))
+    {
+        isSuccessful = m_cmdList.drawPixel(cmd[1].as<int16_t>(), cmd[2].as<int16_t>(), color);
+    }
+    else if ((0U != name.equals("text")) &&
+             (5U == parCnt) &&
+             (true == getColor(cmd[3], color)) &&
+             (true == cmd[4].is<const char*>()))
+    {
+        isSuccessful = m_cmdList.drawText(cmd[1].as<int16_t>(), cmd[2].as<int16_t>(), color, cmd[4].as<const char*>());
+    }
+    else if ((0U != name.equals("blit")) &&
+             (4U == parCnt))
+    {
+        isSuccessful = m_cmdList.blit(cmd[1].as<int16_t>(), cmd[2].as<int16_t>(), cmd[3].as<uint8_t>());
+    }
+    else if ((0U != name.equals("scroll")) &&
+             (3U == parCnt))
+    {
+        isSuccessful = m_cmdList.scroll(cmd[1].as<int16_t>(), cmd[2].as<int16_t>(), ColorDef::BLACK);
+    }
+    else if ((0U != name.equals("scroll")) &&
+             (4U == parCnt) &&
+             (true == getColor(cmd[3], color)))
+    {
+        isSuccessful = m_cmdList.scroll(cmd[1].as<int16_t>(), cmd[2].as<int16_t>(), color);
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get color from JSON value, which is either a number in RGB888 format or
+ * a string in the format "#RRGGBB".
+ *
+ * @param[in]  value    JSON value
+ * @param[out] color    Color
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool getColor(const JsonVariantConst& value, Color& color)
+{
+    bool isSuccessful = false;
+
+    if (true == value.is<uint32_t>())
+    {
+        color           = value.as<uint32_t>();
+        isSuccessful    = true;
+    }
+    else if (true == value.is<const char*>())
+    {
+        String colorStr = value.as<String>();
+
+        if ((7U == colorStr.length()) &&
+            ('#' == colorStr[0U]))
+        {
+            color           = Util::hexToUInt32(colorStr.substring(1U));
+            isSuccessful    = true;
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
@@ -0,0 +1,305 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Canvas plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __CANVASPLUGIN_H__
+#define __CANVASPLUGIN_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "Plugin.hpp"
+
+#include <YAGfxBitmap.h>
+#include <YAGfxText.h>
+#include <TextWidget.h>
+#include <DrawCmdList.h>
+#include <Mutex.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Shows a canvas, which is drawn by a list of drawing commands (fill
+ * rectangle, line, text, cached image, scroll, etc.). The whole list is
+ * sent with a single request and executed on a off-screen buffer. The
+ * buffers are swapped only after the list was completely executed, so
+ * the display shows either the old or the new scene, but never a partial
+ * drawn one.
+ */
+class CanvasPlugin : public Plugin
+{
+public:
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    CanvasPlugin(const String& name, uint16_t uid) :
+        Plugin(name, uid),
+        m_buffers(),
+        m_frontIdx(0U),
+        m_images(),
+        m_gfxText(TextWidget::DEFAULT_FONT),
+        m_cmdList(),
+        m_isUpdated(false),
+        m_mutex(),
+        m_drawMutex()
+    {
+        (void)m_mutex.create();
+        (void)m_drawMutex.create();
+    }
+
+    /**
+     * Destroys the plugin.
+     */
+    ~CanvasPlugin()
+    {
+        m_drawMutex.destroy();
+        m_mutex.destroy();
+    }
+
+    /**
+     * Plugin creation method, used to register on the plugin manager.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     *
+     * @return If successful, it will return the pointer to the plugin instance, otherwise nullptr.
+     */
+    static IPluginMaintenance* create(const String& name, uint16_t uid)
+    {
+        return new CanvasPlugin(name, uid);
+    }
+
+    /**
+     * Get plugin topics, which can be get/set via different communication
+     * interfaces like REST, websocket, MQTT, etc.
+     * 
+     * Example:
+     * {
+     *     "topics": [
+     *         "/draw",
+     *         "/image"
+     *     ]
+     * }
+     * 
+     * @param[out] topics   Topis in JSON format
+     */
+    void getTopics(JsonArray& topics) const final;
+
+    /**
+     * Get a topic data.
+     * Note, currently only JSON format is supported.
+     * 
+     * @param[in]   topic   The topic which data shall be retrieved.
+     * @param[out]  value   The topic value in JSON format.
+     * 
+     * @return If successful it will return true otherwise false.
+     */
+    bool getTopic(const String& topic, JsonObject& value) const final;
+
+    /**
+     * Set a topic data.
+     * Note, currently only JSON format is supported.
+     * 
+     * @param[in]   topic   The topic which data shall be retrieved.
+     * @param[in]   value   The topic value in JSON format.
+     * 
+     * @return If successful it will return true otherwise false.
+     */
+    bool setTopic(const String& topic, const JsonObject& value) final;
+
+    /**
+     * Is a upload request accepted or rejected?
+     * 
+     * @param[in] topic         The topic which the upload belongs to.
+     * @param[in] srcFilename   Name of the file, which will be uploaded if accepted.
+     * @param[in] dstFilename   The destination filename, after storing the uploaded file.
+     * 
+     * @return If accepted it will return true otherwise false.
+     */
+    bool isUploadAccepted(const String& topic, const String& srcFilename, String& dstFilename) final;
+
+    /**
+     * Start the plugin. This is called only once during plugin lifetime.
+     * It can be used as deferred initialization (after the constructor)
+     * and provides the canvas size.
+     * 
+     * Overwrite it if your plugin needs to know that it was installed.
+     * 
+     * @param[in] width     Display width in pixel
+     * @param[in] height    Display height in pixel
+     */
+    void start(uint16_t width, uint16_t height) final;
+
+   /**
+     * Stop the plugin. This is called only once during plugin lifetime.
+     * It can be used as a first clean-up, before the plugin will be destroyed.
+     * 
+     * Overwrite it if your plugin needs to know that it will be uninstalled.
+     */
+    void stop() final;
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
+    /**
+     * Update the display.
+     * The scheduler will call this method periodically.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void update(YAGfx& gfx) final;
+
+    /**
+     * Is a display update required?
+     * The canvas is only redrawn, after a new scene was drawn.
+     *
+     * @return If the plugin has something new to show, it will return true otherwise false.
+     */
+    bool isUpdateRequired() const final;
+
+    /**
+     * Execute a binary drawing command list on the off-screen buffer,
+     * which starts with the current scene. If all commands are valid,
+     * the off-screen buffer is shown, otherwise the scene is not changed.
+     *
+     * @param[in] cmds  Binary drawing command list, see DrawCmd.
+     * @param[in] size  Command list size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool draw(const uint8_t* cmds, size_t size);
+
+private:
+
+    /**
+     * Plugin topic, used to draw.
+     */
+    static const char*      TOPIC_DRAW;
+
+    /**
+     * Plugin topic, used to upload images to the image cache.
+     */
+    static const char*      TOPIC_IMAGE;
+
+    /** Filename extension of bitmap image file. */
+    static const char*      FILE_EXT_BITMAP;
+
+    /** Number of double buffers. */
+    static const uint8_t    BUFFER_CNT          = 2U;
+
+    /** Max. number of cached images. */
+    static const uint8_t    IMAGE_CNT_MAX       = 4U;
+
+    /** Max. size of the binary command list in byte. */
+    static const size_t     CMD_LIST_SIZE       = 2048U;
+
+    /** Max. length of the JSON command list in characters. */
+    static const size_t     CMDS_LENGTH_MAX     = 4096U;
+
+    YAGfxDynamicBitmap      m_buffers[BUFFER_CNT];      /**< Front and off-screen buffer. */
+    uint8_t                 m_frontIdx;                 /**< Index of the front buffer, which is shown. */
+    YAGfxDynamicBitmap      m_images[IMAGE_CNT_MAX];    /**< Image cache, used by the blit command. */
+    YAGfxText               m_gfxText;                  /**< Text properties, used by the text command. */
+    DrawCmdList             m_cmdList;                  /**< Command list, converted from JSON. */
+    bool                    m_isUpdated;                /**< Is a new scene available? */
+    mutable MutexRecursive  m_mutex;                    /**< Mutex to protect the front buffer. */
+    MutexRecursive          m_drawMutex;                /**< Mutex to protect the off-screen buffer, image cache and command list. */
+
+    /**
+     * Get the filename of a cached image.
+     *
+     * @param[in] imageId   Image id
+     *
+     * @return Full path to the image file
+     */
+    String getImageFileName(uint8_t imageId) const;
+
+    /**
+     * Load a image into the image cache.
+     *
+     * @param[in] imageId   Image id
+     * @param[in] filename  Full path to the bitmap image file
+     *
+     * @return If successful loaded, it will return true otherwise false.
+     */
+    bool loadImage(uint8_t imageId, const String& filename);
+
+    /**
+     * Convert a command list in JSON format to the binary command list.
+     *
+     * @param[in] cmds  Command list in JSON format
+     *
+     * @return If successful converted, it will return true otherwise false.
+     */
+    bool convertCmds(const String& cmds);
+
+    /**
+     * Convert a single command in JSON format and add it to the binary
+     * command list.
+     *
+     * @param[in] cmd   Command in JSON format, e.g. ["line", 0, 0, 7, 7, "#FF0000"]
+     *
+     * @return If successful converted, it will return true otherwise false.
+     */
+    bool convertCmd(const JsonArray& cmd);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __CANVASPLUGIN_H__ */
+
+/** @} */
@@ -41,6 +41,7 @@
 #include <ArduinoJson.h>
 #include <Logging.h>
 #include <JsonFile.h>
+#include <JsonDocPool.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -286,7 +287,7 @@ bool CountdownPlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["day"]                  = m_targetDate.day;
@@ -313,7 +314,7 @@ bool CountdownPlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
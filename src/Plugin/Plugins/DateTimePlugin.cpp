@@ -38,6 +38,7 @@
 #include <Logging.h>
 #include <FileSystem.h>
 #include <JsonFile.h>
+#include <JsonDocPool.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -225,6 +226,16 @@ void DateTimePlugin::update(YAGfx& gfx)
     return;
 }
 
+bool DateTimePlugin::isUpdateRequired() const
+{
+    bool                        isRequired  = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    isRequired = m_isUpdateAvailable;
+
+    return isRequired;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -438,7 +449,7 @@ bool DateTimePlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["cfg"] = m_cfg;
@@ -461,7 +472,7 @@ bool DateTimePlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
@@ -209,6 +209,14 @@ public:
      */
     void update(YAGfx& gfx) final;
 
+    /**
+     * Is a display update required?
+     * The date/time is only redrawn, after it changed.
+     *
+     * @return If the plugin has something new to show, it will return true otherwise false.
+     */
+    bool isUpdateRequired() const final;
+
     /** Plugin configuration possibilities. */
     enum Cfg
     {
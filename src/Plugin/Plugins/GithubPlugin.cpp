@@ -37,8 +37,12 @@
 #include "FileSystem.h"
 
 #include <Logging.h>
+#include <Util.h>
 #include <ArduinoJson.h>
 #include <JsonFile.h>
+#include <JsonStreamFilter.h>
+#include <memory>
+#include <JsonDocPool.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -124,7 +128,9 @@ bool GithubPlugin::setTopic(const String& topic, const JsonObject& value)
 
 void GithubPlugin::start(uint16_t width, uint16_t height)
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
+    const size_t                JSON_DOC_SIZE   = 512U;
+    DynamicJsonDocument         jsonDoc(JSON_DOC_SIZE);
+    MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_iconCanvas.setPosAndSize(0, 0, ICON_WIDTH, ICON_HEIGHT);
     (void)m_iconCanvas.addWidget(m_stdIconWidget);
@@ -148,17 +154,19 @@ void GithubPlugin::start(uint16_t width, uint16_t height)
         }
     }
 
+    /* Show the data received before the restart, until fresh data is available. */
+    m_warmCache.setFullPath(generateFullPath("_warm.json"));
+    if (true == m_warmCache.load(jsonDoc))
+    {
+        handleWebResponse(jsonDoc);
+        m_textWidget.setTextColor(WarmCache::STALE_COLOR);
+    }
+
     initHttpClient();
     if (false == startHttpRequest())
     {
         /* If a request fails, show standard icon and a '?' */
         m_textWidget.setFormatStr("\\calign?");
-
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
-    }
-    else
-    {
-        m_requestTimer.start(UPDATE_PERIOD);
     }
 
     return;
@@ -169,13 +177,15 @@ void GithubPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_requestTimer.stop();
+    m_client.unsubscribe();
 
     if (false != FILESYSTEM.remove(configurationFilename))
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
 
+    m_warmCache.remove();
+
     return;
 }
 
@@ -184,22 +194,6 @@ void GithubPlugin::process()
     Msg                         msg;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
-    {
-        if (false == startHttpRequest())
-        {
-            /* If a request fails, show standard icon and a '?' */
-            m_textWidget.setFormatStr("\\calign?");
-
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
-        }
-        else
-        {
-            m_requestTimer.start(UPDATE_PERIOD);
-        }
-    }
-
     if (true == m_taskProxy.receive(msg))
     {
         switch(msg.type)
@@ -212,27 +206,24 @@ void GithubPlugin::process()
             if (nullptr != msg.rsp)
             {
                 handleWebResponse(*msg.rsp);
-                delete msg.rsp;
+                m_textWidget.setTextColor(TextWidget::DEFAULT_TEXT_COLOR);
+
+                /* The warm cache takes over the response and writes it in the main loop context. */
+                m_warmCache.save(msg.rsp);
                 msg.rsp = nullptr;
             }
             break;
 
-        case MSG_TYPE_CONN_CLOSED:
-            LOG_INFO("Connection closed.");
+        case MSG_TYPE_CONN_ERROR:
+            LOG_WARNING("Connection error.");
 
-            if (true == m_isConnectionError)
+            /* If a request fails, show standard icon and a '?'. Data received
+             * before the restart is kept, until fresh data is available.
+             */
+            if (false == m_warmCache.isStale())
             {
-                /* If a request fails, show standard icon and a '?' */
                 m_textWidget.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
             }
-            m_isConnectionError = false;
-            break;
-
-        case MSG_TYPE_CONN_ERROR:
-            LOG_WARNING("Connection error.");
-            m_isConnectionError = true;
             break;
 
         default:
@@ -244,6 +235,52 @@ void GithubPlugin::process()
     return;
 }
 
+uint32_t GithubPlugin::getNextWakeup() const
+{
+    uint32_t                    nextWakeup  = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Pending messages from the web task shall be handled in the next cycle.
+     * Otherwise the task proxy wakes the plugin up.
+     */
+    if (true == m_taskProxy.isEmpty())
+    {
+        nextWakeup = UINT32_MAX;
+    }
+
+    return nextWakeup;
+}
+
+void GithubPlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    UTIL_NOT_USED(gfx);
+
+    /* The data of the shown plugin shall be requested first. */
+    m_client.setPriority(FetchScheduler::PRIORITY_HIGH);
+
+    return;
+}
+
+void GithubPlugin::inactive()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.setPriority(FetchScheduler::PRIORITY_NORMAL);
+
+    return;
+}
+
+void GithubPlugin::prepareActive(uint32_t timeToActive, uint32_t duration)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.prefetch(timeToActive + duration);
+
+    return;
+}
+
 void GithubPlugin::update(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -276,7 +313,7 @@ void GithubPlugin::setUser(const String& name)
         (void)saveConfiguration();
 
         /* Force update on display */
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
+        (void)startHttpRequest();
     }
 
     return;
@@ -303,7 +340,7 @@ void GithubPlugin::setRepository(const String& name)
         (void)saveConfiguration();
 
         /* Force update on display */
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
+        (void)startHttpRequest();
     }
 
     return;
@@ -326,82 +363,124 @@ bool GithubPlugin::startHttpRequest()
     {
         String url = String("https://api.github.com/repos/") + m_githubUser + "/" + m_githubRepository;
 
-        if (true == m_client.begin(url))
+        if (false == m_client.subscribe(url, UPDATE_PERIOD))
         {
-            if (false == m_client.GET())
-            {
-                LOG_WARNING("GET %s failed.", url.c_str());
-            }
-            else
-            {
-                status = true;
-            }
+            LOG_WARNING("Subscribe to %s failed.", url.c_str());
+        }
+        else
+        {
+            status = true;
         }
     }
+    /* Nothing to request without configuration. */
+    else
+    {
+        m_client.unsubscribe();
+    }
 
     return status;
 }
 
 void GithubPlugin::initHttpClient()
 {
-    /* Note: All registered callbacks are running in a different task context!
-     *       Therefore it is not allowed to access a member here directly.
-     *       The processing must be deferred via task proxy.
-     */
-    m_client.regOnResponse(
-        [this](const HttpResponse& rsp)
+    const size_t                        FILTER_SIZE     = 128U;
+    StaticJsonDocument<FILTER_SIZE>     filter;
+    std::shared_ptr<JsonStreamFilter>   streamFilter;
+
+    /* Process the plugin in the next cycle, after a message arrived. */
+    m_taskProxy.setWakeUp(
+        [this]()
         {
-            const size_t            JSON_DOC_SIZE   = 512U;
-            DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+            this->wakeUp();
+        }
+    );
+
+    /* The response body is filtered while it is received, therefore only
+     * the filtered JSON text is kept instead of the whole body.
+     */
+    filter["stargazers_count"] = true;
 
-            if (nullptr != jsonDoc)
+    if (true == filter.overflowed())
+    {
+        LOG_ERROR("Less memory for filter available.");
+    }
+
+    streamFilter = std::shared_ptr<JsonStreamFilter>(new(std::nothrow) JsonStreamFilter(filter));
+
+    if (nullptr == streamFilter)
+    {
+        LOG_ERROR("Couldn't create JSON stream filter.");
+    }
+    else
+    {
+        /* Note: All registered callbacks are running in a different task context!
+         *       Therefore it is not allowed to access a member here directly.
+         *       The processing must be deferred via task proxy.
+         *       The stream filter is only used in the callback context.
+         */
+        m_client.regOnBody(
+            [streamFilter](const uint8_t* data, size_t size, size_t index)
             {
-                size_t                          payloadSize = 0U;
-                const char*                     payload     = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
-                const size_t                    FILTER_SIZE = 128U;
-                StaticJsonDocument<FILTER_SIZE> filter;
-                DeserializationError            error;
-
-                filter["stargazers_count"] = true;
-                
-                if (true == filter.overflowed())
+                if (0U == index)
                 {
-                    LOG_ERROR("Less memory for filter available.");
+                    streamFilter->reset();
                 }
 
-                error = deserializeJson(*jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+                (void)streamFilter->parse(data, size);
+            }
+        );
 
-                if (DeserializationError::Ok != error.code())
+        m_client.regOnResponse(
+            [this, streamFilter](const HttpResponse& rsp)
+            {
+                const size_t            JSON_DOC_SIZE   = 512U;
+                DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+
+                UTIL_NOT_USED(rsp);
+
+                if (false == streamFilter->isComplete())
                 {
-                    LOG_WARNING("JSON parse error: %s", error.c_str());
+                    LOG_WARNING("Incomplete or invalid JSON response.");
                 }
-                else
+                else if (nullptr != jsonDoc)
                 {
-                    Msg msg;
-
-                    msg.type    = MSG_TYPE_RSP;
-                    msg.rsp     = jsonDoc;
+                    DeserializationError error = deserializeJson(*jsonDoc, streamFilter->getOutput(), streamFilter->getOutputSize());
 
-                    if (false == this->m_taskProxy.send(msg))
+                    if (DeserializationError::Ok != error.code())
                     {
-                        delete jsonDoc;
-                        jsonDoc = nullptr;
+                        LOG_WARNING("JSON parse error: %s", error.c_str());
                     }
-                }
-            }
-        }
-    );
+                    else
+                    {
+                        Msg msg;
 
-    m_client.regOnClosed(
-        [this]()
-        {
-            Msg msg;
+                        /* The fetch client is thread-safe. If the data is not
+                         * modified until the next request, the cached filtered
+                         * JSON text is provided again.
+                         */
+                        (void)this->m_client.cache(streamFilter->getOutput(), streamFilter->getOutputSize());
 
-            msg.type = MSG_TYPE_CONN_CLOSED;
+                        msg.type    = MSG_TYPE_RSP;
+                        msg.rsp     = jsonDoc;
 
-            (void)this->m_taskProxy.send(msg);
-        }
-    );
+                        if (true == this->m_taskProxy.send(msg))
+                        {
+                            jsonDoc = nullptr;
+                        }
+                    }
+                }
+
+                if (nullptr != jsonDoc)
+                {
+                    delete jsonDoc;
+                    jsonDoc = nullptr;
+                }
+
+                /* Release the filtered JSON text until the next response. */
+                streamFilter->reset();
+            }
+        );
+    }
 
     m_client.regOnError(
         [this]()
@@ -439,7 +518,7 @@ bool GithubPlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["user"] = m_githubUser;
@@ -463,7 +542,7 @@ bool GithubPlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
@@ -40,6 +40,9 @@
 #include <ArduinoJson.h>
 #include <Logging.h>
 #include <JsonFile.h>
+#include <JsonDocPool.h>
+#include <Util.h>
+#include <memory>
 
 /******************************************************************************
  * Compiler Switches
@@ -67,6 +70,9 @@ const char* GruenbeckPlugin::IMAGE_PATH = "/images/gruenbeck.bmp";
 /* Initialize plugin topic. */
 const char* GruenbeckPlugin::TOPIC      = "/ipAddress";
 
+/* Initialize form data. */
+const char* GruenbeckPlugin::FORM_DATA  = "id=42&show=D_Y_10_1~";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -117,7 +123,9 @@ bool GruenbeckPlugin::setTopic(const String& topic, const JsonObject& value)
 
 void GruenbeckPlugin::start(uint16_t width, uint16_t height)
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
+    const size_t                JSON_DOC_SIZE   = 256U;
+    DynamicJsonDocument         jsonDoc(JSON_DOC_SIZE);
+    MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_iconCanvas.setPosAndSize(0, 0, ICON_WIDTH, ICON_HEIGHT);
     (void)m_iconCanvas.addWidget(m_bitmapWidget);
@@ -138,17 +146,19 @@ void GruenbeckPlugin::start(uint16_t width, uint16_t height)
         }
     }
 
+    /* Show the data received before the restart, until fresh data is available. */
+    m_warmCache.setFullPath(generateFullPath("_warm.json"));
+    if (true == m_warmCache.load(jsonDoc))
+    {
+        handleWebResponse(jsonDoc);
+        m_textWidget.setTextColor(WarmCache::STALE_COLOR);
+    }
+
     initHttpClient();
     if (false == startHttpRequest())
     {
         /* If a request fails, show a '?' */
         m_textWidget.setFormatStr("\\calign?");
-
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
-    }
-    else
-    {
-        m_requestTimer.start(UPDATE_PERIOD);
     }
 
     return;
@@ -159,13 +169,15 @@ void GruenbeckPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_requestTimer.stop();
+    m_client.unsubscribe();
 
     if (false != FILESYSTEM.remove(configurationFilename))
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
 
+    m_warmCache.remove();
+
     return;
 }
 
@@ -174,22 +186,6 @@ void GruenbeckPlugin::process()
     Msg                         msg;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
-    {
-        if (false == startHttpRequest())
-        {
-            /* If a request fails, show a '?' */
-            m_textWidget.setFormatStr("\\calign?");
-
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
-        }
-        else
-        {
-            m_requestTimer.start(UPDATE_PERIOD);
-        }
-    }
-
     if (true == m_taskProxy.receive(msg))
     {
         switch(msg.type)
@@ -202,27 +198,24 @@ void GruenbeckPlugin::process()
             if (nullptr != msg.rsp)
             {
                 handleWebResponse(*msg.rsp);
-                delete msg.rsp;
+                m_textWidget.setTextColor(TextWidget::DEFAULT_TEXT_COLOR);
+
+                /* The warm cache takes over the response and writes it in the main loop context. */
+                m_warmCache.save(msg.rsp);
                 msg.rsp = nullptr;
             }
             break;
 
-        case MSG_TYPE_CONN_CLOSED:
-            LOG_INFO("Connection closed.");
+        case MSG_TYPE_CONN_ERROR:
+            LOG_WARNING("Connection error.");
 
-            if (true == m_isConnectionError)
+            /* If a request fails, show a '?'. Data received before the
+             * restart is kept, until fresh data is available.
+             */
+            if (false == m_warmCache.isStale())
             {
-                /* If a request fails, show a '?' */
                 m_textWidget.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
             }
-            m_isConnectionError = false;
-            break;
-
-        case MSG_TYPE_CONN_ERROR:
-            LOG_WARNING("Connection error.");
-            m_isConnectionError = true;
             break;
 
         default:
@@ -234,10 +227,29 @@ void GruenbeckPlugin::process()
     return;
 }
 
+uint32_t GruenbeckPlugin::getNextWakeup() const
+{
+    uint32_t                    nextWakeup  = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Pending messages from the web task shall be handled in the next cycle.
+     * Otherwise the task proxy wakes the plugin up.
+     */
+    if (true == m_taskProxy.isEmpty())
+    {
+        nextWakeup = UINT32_MAX;
+    }
+
+    return nextWakeup;
+}
+
 void GruenbeckPlugin::active(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
+    /* The data of the shown plugin shall be requested first. */
+    m_client.setPriority(FetchScheduler::PRIORITY_HIGH);
+
     gfx.fillScreen(ColorDef::BLACK);
     m_iconCanvas.update(gfx);
     m_textCanvas.update(gfx);
@@ -247,7 +259,19 @@ void GruenbeckPlugin::active(YAGfx& gfx)
 
 void GruenbeckPlugin::inactive()
 {
-    /* Nothing to do */
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.setPriority(FetchScheduler::PRIORITY_NORMAL);
+
+    return;
+}
+
+void GruenbeckPlugin::prepareActive(uint32_t timeToActive, uint32_t duration)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.prefetch(timeToActive + duration);
+
     return;
 }
 
@@ -288,6 +312,9 @@ void GruenbeckPlugin::setIPAddress(const String& ipAddress)
     m_ipAddress = ipAddress;
     (void)saveConfiguration();
 
+    /* Request the data with the changed configuration. */
+    (void)startHttpRequest();
+
     return;
 }
 
@@ -307,90 +334,118 @@ bool GruenbeckPlugin::startHttpRequest()
     {
         String url = String("http://") + m_ipAddress + "/mux_http";
 
-        if (true == m_client.begin(url))
+        if (false == m_client.subscribe(url, UPDATE_PERIOD, FORM_DATA))
         {
-            m_client.addPar("id","42");
-            m_client.addPar("show","D_Y_10_1~");
-
-            if (false == m_client.POST())
-            {
-                LOG_WARNING("POST %s failed.", url.c_str());
-            }
-            else
-            {
-                status = true;
-            }
+            LOG_WARNING("Subscribe to %s failed.", url.c_str());
+        }
+        else
+        {
+            status = true;
         }
     }
+    /* Nothing to request without configuration. */
+    else
+    {
+        m_client.unsubscribe();
+    }
 
     return status;
 }
 
 void GruenbeckPlugin::initHttpClient()
 {
-    m_client.regOnResponse(
-        [this](const HttpResponse& rsp)
+    /* Start index of relevant data */
+    const size_t            START_INDEX_OF_RELEVANT_DATA    = 31U;
+
+    /* Length of relevant data */
+    const size_t            RELEVANT_DATA_LENGTH            = 3U;
+
+    /* Relevant data, collected from the response body. */
+    std::shared_ptr<String> restCapacity(new(std::nothrow) String());
+
+    /* Process the plugin in the next cycle, after a message arrived. */
+    m_taskProxy.setWakeUp(
+        [this]()
         {
-            const size_t            JSON_DOC_SIZE   = 256U;
-            DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+            this->wakeUp();
+        }
+    );
 
-            if (nullptr != jsonDoc)
+    /* Structure of response-payload for requesting D_Y_10_1
+     *
+     * <data><code>ok</code><D_Y_10_1>XYZ</D_Y_10_1></data>
+     *
+     * <data><code>ok</code><D_Y_10_1>  = 31 bytes
+     * XYZ                              = 3 byte (relevant data)
+     * </D_Y_10_1></data>               = 18 bytes
+     *
+     * Only the relevant data is taken from the response body, while it is
+     * received. The body itself is not stored.
+     */
+    if (nullptr == restCapacity)
+    {
+        LOG_ERROR("Couldn't create response buffer.");
+    }
+    else
+    {
+        m_client.regOnBody(
+            [restCapacity](const uint8_t* data, size_t size, size_t index)
             {
-                /* Structure of response-payload for requesting D_Y_10_1
-                *
-                * <data><code>ok</code><D_Y_10_1>XYZ</D_Y_10_1></data>
-                *
-                * <data><code>ok</code><D_Y_10_1>  = 31 bytes
-                * XYZ                              = 3 byte (relevant data)
-                * </D_Y_10_1></data>               = 18 bytes
-                */
-
-                /* Start index of relevant data */
-                const uint32_t  START_INDEX_OF_RELEVANT_DATA    = 31U;
-
-                /* Length of relevant data */
-                const uint32_t  RELEVANT_DATA_LENGTH            = 3U;
-
-                size_t          payloadSize                     = 0U;
-                const char*     payload                         = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
-                char            restCapacity[RELEVANT_DATA_LENGTH + 1];
-                Msg             msg;
-
-                if (payloadSize >= (START_INDEX_OF_RELEVANT_DATA + RELEVANT_DATA_LENGTH))
+                size_t idx = 0U;
+
+                if (0U == index)
                 {
-                    memcpy(restCapacity, &payload[START_INDEX_OF_RELEVANT_DATA], RELEVANT_DATA_LENGTH);
-                    restCapacity[RELEVANT_DATA_LENGTH] = '\0';
+                    restCapacity->clear();
                 }
-                else
+
+                for(idx = 0U; idx < size; ++idx)
                 {
-                    restCapacity[0] = '?';
-                    restCapacity[1] = '\0';
+                    size_t bodyIdx = index + idx;
+
+                    if ((START_INDEX_OF_RELEVANT_DATA <= bodyIdx) &&
+                        ((START_INDEX_OF_RELEVANT_DATA + RELEVANT_DATA_LENGTH) > bodyIdx))
+                    {
+                        (*restCapacity) += static_cast<char>(data[idx]);
+                    }
                 }
+            }
+        );
 
-                (*jsonDoc)["restCapacity"] = restCapacity;
+        m_client.regOnResponse(
+            [this, restCapacity](const HttpResponse& rsp)
+            {
+                const size_t            JSON_DOC_SIZE   = 256U;
+                DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
 
-                msg.type    = MSG_TYPE_RSP;
-                msg.rsp     = jsonDoc;
+                UTIL_NOT_USED(rsp);
 
-                if (false == this->m_taskProxy.send(msg))
+                if (nullptr != jsonDoc)
                 {
-                    delete jsonDoc;
-                    jsonDoc = nullptr;
+                    Msg msg;
+
+                    if (RELEVANT_DATA_LENGTH == restCapacity->length())
+                    {
+                        (*jsonDoc)["restCapacity"] = *restCapacity;
+                    }
+                    else
+                    {
+                        (*jsonDoc)["restCapacity"] = "?";
+                    }
+
+                    msg.type    = MSG_TYPE_RSP;
+                    msg.rsp     = jsonDoc;
+
+                    if (false == this->m_taskProxy.send(msg))
+                    {
+                        delete jsonDoc;
+                        jsonDoc = nullptr;
+                    }
                 }
-            }
-        }
-    );
-
-    m_client.regOnClosed(
-        [this]()
-        {
-            Msg msg;
-
-            msg.type = MSG_TYPE_CONN_CLOSED;
 
-            (void)this->m_taskProxy.send(msg);
-        }
-    );
+                restCapacity->clear();
+            }
+        );
+    }
 
     m_client.regOnError(
         [this]()
@@ -424,7 +479,7 @@ bool GruenbeckPlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["gruenbeckIP"] = m_ipAddress;
@@ -447,7 +502,7 @@ bool GruenbeckPlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
@@ -120,6 +120,16 @@ void JustTextPlugin::update(YAGfx& gfx)
     return;
 }
 
+bool JustTextPlugin::isUpdateRequired() const
+{
+    bool                        isRequired  = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    isRequired = (false == m_textWidget.isStatic());
+
+    return isRequired;
+}
+
 String JustTextPlugin::getText() const
 {
     String                      formattedText;
@@ -148,6 +148,14 @@ public:
      */
     void update(YAGfx& gfx) final;
 
+    /**
+     * Is a display update required?
+     * As long as the text is static shown, the display content won't change.
+     *
+     * @return If the plugin has something new to show, it will return true otherwise false.
+     */
+    bool isUpdateRequired() const final;
+
     /**
      * Get text.
      * 
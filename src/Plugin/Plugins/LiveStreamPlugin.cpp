@@ -0,0 +1,519 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  LiveStream plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "LiveStreamPlugin.h"
+
+#include <Logging.h>
+#include <FileSystem.h>
+#include <JsonFile.h>
+#include <JsonDocPool.h>
+#include <StreamPacket.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize plugin topics. */
+const char* LiveStreamPlugin::TOPIC_STREAM      = "/stream";
+const char* LiveStreamPlugin::TOPIC_STATISTICS  = "/statistics";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void LiveStreamPlugin::getTopics(JsonArray& topics) const
+{
+    (void)topics.add(TOPIC_STREAM);
+    (void)topics.add(TOPIC_STATISTICS);
+}
+
+bool LiveStreamPlugin::getTopic(const String& topic, JsonObject& value) const
+{
+    bool                        isSuccessful    = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    if (0U != topic.equals(TOPIC_STREAM))
+    {
+        value["port"]   = m_port;
+        value["depth"]  = m_depth;
+
+        isSuccessful = true;
+    }
+    else if (0U != topic.equals(TOPIC_STATISTICS))
+    {
+        const JitterBuffer::Statistics& statistics = m_jitterBuffer.getStatistics();
+
+        value["received"]   = statistics.received;
+        value["presented"]  = statistics.presented;
+        value["late"]       = statistics.late;
+        value["dropped"]    = statistics.dropped;
+        value["duplicate"]  = statistics.duplicate;
+
+        isSuccessful = true;
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
+
+bool LiveStreamPlugin::setTopic(const String& topic, const JsonObject& value)
+{
+    bool                        isSuccessful    = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    if (0U != topic.equals(TOPIC_STREAM))
+    {
+        JsonVariant jsonPort    = value["port"];
+        JsonVariant jsonDepth   = value["depth"];
+        uint16_t    port        = m_port;
+        uint8_t     depth       = m_depth;
+
+        if (false == jsonPort.isNull())
+        {
+            port            = jsonPort.as<uint16_t>();
+            isSuccessful    = true;
+        }
+
+        if (false == jsonDepth.isNull())
+        {
+            depth           = jsonDepth.as<uint8_t>();
+            isSuccessful    = (0U < depth) && (SLOT_CNT > depth);
+        }
+
+        if (true == isSuccessful)
+        {
+            if (depth != m_depth)
+            {
+                m_depth = depth;
+
+                if (0U < m_canvas.getWidth())
+                {
+                    isSuccessful = m_jitterBuffer.init(m_canvas.getWidth(), m_canvas.getHeight(), SLOT_CNT, m_depth, HOLD_TIME);
+                }
+            }
+
+            if (port != m_port)
+            {
+                stopUdp();
+                m_port = port;
+                startUdp();
+            }
+
+            (void)saveConfiguration();
+        }
+    }
+    else if (0U != topic.equals(TOPIC_STATISTICS))
+    {
+        /* Any value resets the statistics. */
+        m_jitterBuffer.resetStatistics();
+
+        isSuccessful = true;
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
+
+void LiveStreamPlugin::start(uint16_t width, uint16_t height)
+{
+    /* Dispatching locks the registry before the plugin, therefore the plugin
+     * registers itself before it is locked. Frames received before the jitter
+     * buffer is initialized are rejected by it.
+     */
+    registerInstance();
+
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    /* Try to load configuration. If there is no configuration available, a default configuration
+     * will be created.
+     */
+    if (false == loadConfiguration())
+    {
+        if (false == saveConfiguration())
+        {
+            LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
+        }
+    }
+
+    if (false == m_canvas.create(width, height))
+    {
+        LOG_ERROR("Not enough memory for the canvas.");
+    }
+    else
+    {
+        m_canvas.fillScreen(ColorDef::BLACK);
+    }
+
+    /* All frame slots are allocated once, so no memory is allocated while streaming. */
+    if (false == m_jitterBuffer.init(width, height, SLOT_CNT, m_depth, HOLD_TIME))
+    {
+        LOG_ERROR("Not enough memory for the jitter buffer.");
+    }
+
+    startUdp();
+
+    return;
+}
+
+void LiveStreamPlugin::stop()
+{
+    String configurationFilename = getFullPathToConfiguration();
+
+    /* No stream packet shall be dispatched anymore. Because dispatching locks
+     * the registry before the plugin, it must be done before the plugin is locked.
+     */
+    unregisterInstance();
+
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    stopUdp();
+    m_jitterBuffer.release();
+    m_canvas.release();
+
+    if (false != FILESYSTEM.remove(configurationFilename))
+    {
+        LOG_INFO("File %s removed", configurationFilename.c_str());
+    }
+
+    return;
+}
+
+void LiveStreamPlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    UTIL_NOT_USED(gfx);
+
+    m_isRedrawRequired = true;
+
+    return;
+}
+
+void LiveStreamPlugin::update(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    const uint32_t*             pixels  = m_jitterBuffer.pop(millis());
+
+    if (nullptr != pixels)
+    {
+        uint16_t    x       = 0U;
+        uint16_t    y       = 0U;
+        size_t      index   = 0U;
+
+        for(y = 0U; y < m_canvas.getHeight(); ++y)
+        {
+            for(x = 0U; x < m_canvas.getWidth(); ++x)
+            {
+                m_canvas.drawPixel(x, y, pixels[index]);
+                ++index;
+            }
+        }
+    }
+
+    gfx.drawBitmap(0, 0, m_canvas);
+    m_isRedrawRequired = false;
+
+    return;
+}
+
+bool LiveStreamPlugin::isUpdateRequired() const
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    return (true == m_isRedrawRequired) || (0U < m_jitterBuffer.getCount());
+}
+
+void LiveStreamPlugin::ingest(uint16_t seqNum, const uint8_t* frame, size_t size)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    JitterBuffer::Result        result  = m_jitterBuffer.push(seqNum, frame, size, millis());
+
+    if (JitterBuffer::RESULT_INVALID == result)
+    {
+        LOG_WARNING("Invalid frame %u received.", seqNum);
+    }
+
+    return;
+}
+
+bool LiveStreamPlugin::dispatch(const uint8_t* packet, size_t size)
+{
+    bool            isDispatched    = false;
+    uint16_t        uid             = 0U;
+    uint16_t        seqNum          = 0U;
+    const uint8_t*  frame           = nullptr;
+    size_t          frameSize       = 0U;
+
+    if (true == StreamPacket::parse(packet, size, uid, seqNum, frame, frameSize))
+    {
+        isDispatched = dispatchFrame(uid, seqNum, frame, frameSize);
+    }
+
+    return isDispatched;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+LiveStreamPlugin::Registry& LiveStreamPlugin::getRegistry()
+{
+    static Registry registry;
+
+    return registry;
+}
+
+void LiveStreamPlugin::registerInstance()
+{
+    Registry&                   registry    = getRegistry();
+    MutexGuard<MutexRecursive>  guard(registry.mutex);
+    uint8_t                     idx         = 0U;
+    uint8_t                     freeIdx     = MAX_INSTANCES;
+
+    for(idx = 0U; idx < MAX_INSTANCES; ++idx)
+    {
+        /* Already registered? */
+        if (this == registry.instances[idx])
+        {
+            freeIdx = idx;
+            break;
+        }
+
+        if ((MAX_INSTANCES == freeIdx) &&
+            (nullptr == registry.instances[idx]))
+        {
+            freeIdx = idx;
+        }
+    }
+
+    if (MAX_INSTANCES <= freeIdx)
+    {
+        LOG_WARNING("Max. number of LiveStream plugins reached, UID %u won't receive stream packets.", getUID());
+    }
+    else
+    {
+        registry.instances[freeIdx] = this;
+    }
+
+    return;
+}
+
+void LiveStreamPlugin::unregisterInstance()
+{
+    Registry&                   registry    = getRegistry();
+    MutexGuard<MutexRecursive>  guard(registry.mutex);
+    uint8_t                     idx         = 0U;
+
+    for(idx = 0U; idx < MAX_INSTANCES; ++idx)
+    {
+        if (this == registry.instances[idx])
+        {
+            registry.instances[idx] = nullptr;
+        }
+    }
+
+    return;
+}
+
+bool LiveStreamPlugin::dispatchFrame(uint16_t uid, uint16_t seqNum, const uint8_t* frame, size_t size)
+{
+    bool                        isDispatched    = false;
+    Registry&                   registry        = getRegistry();
+    MutexGuard<MutexRecursive>  guard(registry.mutex);
+    uint8_t                     idx             = 0U;
+
+    /* The registry stays locked during ingestion, so the plugin can't be destroyed meanwhile. */
+    for(idx = 0U; idx < MAX_INSTANCES; ++idx)
+    {
+        LiveStreamPlugin* plugin = registry.instances[idx];
+
+        if ((nullptr != plugin) &&
+            (uid == plugin->getUID()))
+        {
+            plugin->ingest(seqNum, frame, size);
+            isDispatched = true;
+            break;
+        }
+    }
+
+    return isDispatched;
+}
+
+void LiveStreamPlugin::startUdp()
+{
+    if ((false == m_isUdpListening) &&
+        (PORT_DISABLED != m_port))
+    {
+        if (false == m_udp.listen(m_port))
+        {
+            LOG_WARNING("Failed to listen on UDP port %u.", m_port);
+        }
+        else
+        {
+            uint16_t ownUid = getUID();
+
+            /* The plugin is only accessed via registry, because a packet may be
+             * received during the plugin is stopped.
+             */
+            m_udp.onPacket([ownUid](AsyncUDPPacket& packet) {
+                uint16_t        uid         = 0U;
+                uint16_t        seqNum      = 0U;
+                const uint8_t*  frame       = nullptr;
+                size_t          frameSize   = 0U;
+
+                /* The UID is checked too, to detect senders which are misconfigured. */
+                if ((true == StreamPacket::parse(packet.data(), packet.length(), uid, seqNum, frame, frameSize)) &&
+                    (ownUid == uid))
+                {
+                    (void)dispatchFrame(uid, seqNum, frame, frameSize);
+                }
+            });
+
+            m_isUdpListening = true;
+            LOG_INFO("Listen on UDP port %u for stream packets.", m_port);
+        }
+    }
+
+    return;
+}
+
+void LiveStreamPlugin::stopUdp()
+{
+    if (true == m_isUdpListening)
+    {
+        m_udp.close();
+        m_isUdpListening = false;
+    }
+
+    return;
+}
+
+bool LiveStreamPlugin::saveConfiguration() const
+{
+    bool                status                  = true;
+    JsonFile            jsonFile(FILESYSTEM);
+    const size_t        JSON_DOC_SIZE           = 512U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+    String              configurationFilename   = getFullPathToConfiguration();
+
+    jsonDoc["port"]     = m_port;
+    jsonDoc["depth"]    = m_depth;
+
+    if (false == jsonFile.save(configurationFilename, jsonDoc))
+    {
+        LOG_WARNING("Failed to save file %s.", configurationFilename.c_str());
+        status = false;
+    }
+    else
+    {
+        LOG_INFO("File %s saved.", configurationFilename.c_str());
+    }
+
+    return status;
+}
+
+bool LiveStreamPlugin::loadConfiguration()
+{
+    bool                status                  = true;
+    JsonFile            jsonFile(FILESYSTEM);
+    const size_t        JSON_DOC_SIZE           = 512U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+    String              configurationFilename   = getFullPathToConfiguration();
+
+    if (false == jsonFile.load(configurationFilename, jsonDoc))
+    {
+        LOG_WARNING("Failed to load file %s.", configurationFilename.c_str());
+        status = false;
+    }
+    else
+    {
+        JsonVariant jsonPort    = jsonDoc["port"];
+        JsonVariant jsonDepth   = jsonDoc["depth"];
+
+        if ((false == jsonPort.is<uint16_t>()) ||
+            (false == jsonDepth.is<uint8_t>()))
+        {
+            LOG_WARNING("JSON port or depth not found or invalid type.");
+            status = false;
+        }
+        else
+        {
+            m_port  = jsonPort.as<uint16_t>();
+            m_depth = jsonDepth.as<uint8_t>();
+
+            if ((0U == m_depth) ||
+                (SLOT_CNT <= m_depth))
+            {
+                m_depth = DEFAULT_DEPTH;
+            }
+        }
+    }
+
+    return status;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
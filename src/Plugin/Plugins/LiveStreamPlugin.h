@@ -0,0 +1,342 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  LiveStream plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __LIVESTREAMPLUGIN_H__
+#define __LIVESTREAMPLUGIN_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "Plugin.hpp"
+
+#include <YAGfxBitmap.h>
+#include <Mutex.hpp>
+#include <AsyncUDP.h>
+#include <JitterBuffer.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Shows display frames, which are streamed by a host, e.g. animations
+ * rendered on a server.
+ *
+ * The frames are received as stream packets (see StreamPacket) via websocket
+ * binary message or via UDP, if a port is configured. They are buffered in a
+ * jitter buffer and presented with the display refresh.
+ */
+class LiveStreamPlugin : public Plugin
+{
+public:
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    LiveStreamPlugin(const String& name, uint16_t uid) :
+        Plugin(name, uid),
+        m_canvas(),
+        m_jitterBuffer(),
+        m_udp(),
+        m_port(PORT_DISABLED),
+        m_depth(DEFAULT_DEPTH),
+        m_isUdpListening(false),
+        m_isRedrawRequired(false),
+        m_mutex()
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the plugin.
+     */
+    ~LiveStreamPlugin()
+    {
+        unregisterInstance();
+
+        m_mutex.destroy();
+    }
+
+    /**
+     * Plugin creation method, used to register on the plugin manager.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     *
+     * @return If successful, it will return the pointer to the plugin instance, otherwise nullptr.
+     */
+    static IPluginMaintenance* create(const String& name, uint16_t uid)
+    {
+        return new LiveStreamPlugin(name, uid);
+    }
+
+    /**
+     * Get plugin topics, which can be get/set via different communication
+     * interfaces like REST, websocket, MQTT, etc.
+     * 
+     * Example:
+     * {
+     *     "topics": [
+     *         "/stream",
+     *         "/statistics"
+     *     ]
+     * }
+     * 
+     * @param[out] topics   Topis in JSON format
+     */
+    void getTopics(JsonArray& topics) const final;
+
+    /**
+     * Get a topic data.
+     * Note, currently only JSON format is supported.
+     * 
+     * @param[in]   topic   The topic which data shall be retrieved.
+     * @param[out]  value   The topic value in JSON format.
+     * 
+     * @return If successful it will return true otherwise false.
+     */
+    bool getTopic(const String& topic, JsonObject& value) const final;
+
+    /**
+     * Set a topic data.
+     * Note, currently only JSON format is supported.
+     * 
+     * @param[in]   topic   The topic which data shall be retrieved.
+     * @param[in]   value   The topic value in JSON format.
+     * 
+     * @return If successful it will return true otherwise false.
+     */
+    bool setTopic(const String& topic, const JsonObject& value) final;
+
+    /**
+     * Start the plugin. This is called only once during plugin lifetime.
+     * It can be used as deferred initialization (after the constructor)
+     * and provides the canvas size.
+     * 
+     * @param[in] width     Display width in pixel
+     * @param[in] height    Display height in pixel
+     */
+    void start(uint16_t width, uint16_t height) final;
+
+    /**
+     * Stop the plugin. This is called only once during plugin lifetime.
+     * It can be used as a first clean-up, before the plugin will be destroyed.
+     */
+    void stop() final;
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
+    /**
+     * Update the display.
+     * The scheduler will call this method periodically.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void update(YAGfx& gfx) final;
+
+    /**
+     * Is a display update required?
+     * Only if a frame is buffered, which may be presented.
+     *
+     * @return If the plugin has something new to show, it will return true otherwise false.
+     */
+    bool isUpdateRequired() const final;
+
+    /**
+     * Push a received display frame into the jitter buffer.
+     * It can be called from any task.
+     *
+     * @param[in] seqNum    Sequence number of the frame
+     * @param[in] frame     Display frame
+     * @param[in] size      Display frame size in byte
+     */
+    void ingest(uint16_t seqNum, const uint8_t* frame, size_t size);
+
+    /**
+     * Dispatch a stream packet to the addressed LiveStream plugin.
+     * It can be called from any task. The plugin can't be stopped or
+     * destroyed during dispatching.
+     *
+     * @param[in] packet    Stream packet
+     * @param[in] size      Stream packet size in byte
+     *
+     * @return If the packet was dispatched, it will return true otherwise false.
+     */
+    static bool dispatch(const uint8_t* packet, size_t size);
+
+private:
+
+    /**
+     * Plugin topic, used for the stream configuration.
+     */
+    static const char*      TOPIC_STREAM;
+
+    /**
+     * Plugin topic, used to get/reset the stream statistics.
+     */
+    static const char*      TOPIC_STATISTICS;
+
+    /** UDP port, which means that UDP reception is disabled. */
+    static const uint16_t   PORT_DISABLED   = 0U;
+
+    /** Number of pre-allocated frame slots in the jitter buffer. */
+    static const uint8_t    SLOT_CNT        = 4U;
+
+    /** Default number of frames, which are buffered before presentation. */
+    static const uint8_t    DEFAULT_DEPTH   = 2U;
+
+    /** Max. time in ms, a frame is hold back in the jitter buffer. */
+    static const uint32_t   HOLD_TIME       = 100U;
+
+    /** Max. number of LiveStream plugins, which can receive stream packets. */
+    static const uint8_t    MAX_INSTANCES   = 4U;
+
+    /**
+     * Registry of the LiveStream plugin instances, which stream packets are
+     * dispatched to. A plugin is only accessed while the registry is locked
+     * and it removes itself from the registry, before it is stopped or
+     * destroyed. The registry is always locked before a plugin.
+     */
+    struct Registry
+    {
+        LiveStreamPlugin*   instances[MAX_INSTANCES];   /**< Registered plugins */
+        MutexRecursive      mutex;                      /**< Mutex to protect the registry. */
+
+        /**
+         * Constructs an empty registry.
+         */
+        Registry() :
+            instances(),
+            mutex()
+        {
+            (void)mutex.create();
+        }
+
+        /**
+         * Destroys the registry.
+         */
+        ~Registry()
+        {
+            mutex.destroy();
+        }
+    };
+
+    YAGfxDynamicBitmap      m_canvas;           /**< Last presented frame */
+    JitterBuffer            m_jitterBuffer;     /**< Jitter buffer for the received frames */
+    AsyncUDP                m_udp;              /**< UDP socket */
+    uint16_t                m_port;             /**< UDP port */
+    uint8_t                 m_depth;            /**< Number of frames, which are buffered before presentation. */
+    bool                    m_isUdpListening;   /**< Is the UDP socket listening? */
+    bool                    m_isRedrawRequired; /**< Is a redraw of the last presented frame required? */
+    mutable MutexRecursive  m_mutex;            /**< Mutex to protect against concurrent access. */
+
+    /**
+     * Get the registry of all LiveStream plugin instances.
+     *
+     * @return Registry
+     */
+    static Registry& getRegistry();
+
+    /**
+     * Register the plugin to receive stream packets.
+     */
+    void registerInstance();
+
+    /**
+     * Unregister the plugin. After it returns, no stream packet is
+     * dispatched to the plugin anymore.
+     */
+    void unregisterInstance();
+
+    /**
+     * Push a received display frame into the jitter buffer of the
+     * registered plugin with the given UID.
+     *
+     * @param[in] uid       Plugin UID
+     * @param[in] seqNum    Sequence number of the frame
+     * @param[in] frame     Display frame
+     * @param[in] size      Display frame size in byte
+     *
+     * @return If a plugin with the UID is registered, it will return true otherwise false.
+     */
+    static bool dispatchFrame(uint16_t uid, uint16_t seqNum, const uint8_t* frame, size_t size);
+
+    /**
+     * Start listening on the configured UDP port, if enabled.
+     */
+    void startUdp();
+
+    /**
+     * Stop listening on the UDP port.
+     */
+    void stopUdp();
+
+    /**
+     * Saves current configuration to JSON file.
+     */
+    bool saveConfiguration() const;
+
+    /**
+     * Load configuration from JSON file.
+     */
+    bool loadConfiguration();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LIVESTREAMPLUGIN_H__ */
+
+/** @} */
@@ -37,8 +37,12 @@
 #include "FileSystem.h"
 
 #include <Logging.h>
+#include <Util.h>
 #include <ArduinoJson.h>
 #include <JsonFile.h>
+#include <JsonStreamFilter.h>
+#include <memory>
+#include <JsonDocPool.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -161,13 +165,18 @@ bool OpenWeatherPlugin::setTopic(const String& topic, const JsonObject& value)
 
 void OpenWeatherPlugin::setSlot(const ISlotPlugin* slotInterf)
 {
+    /* Keep the base informed, which is required for the wakeup. */
+    Plugin::setSlot(slotInterf);
+
     m_slotInterf = slotInterf;
     return;
 }
 
 void OpenWeatherPlugin::start(uint16_t width, uint16_t height)
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
+    const size_t                JSON_DOC_SIZE   = 256U;
+    DynamicJsonDocument         jsonDoc(JSON_DOC_SIZE);
+    MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_iconCanvas.setPosAndSize(0, 0, ICON_WIDTH, ICON_HEIGHT);
     (void)m_iconCanvas.addWidget(m_bitmapWidget);
@@ -188,18 +197,20 @@ void OpenWeatherPlugin::start(uint16_t width, uint16_t height)
         }
     }
 
+    /* Show the data received before the restart, until fresh data is available. */
+    m_warmCache.setFullPath(generateFullPath("_warm.json"));
+    if (true == m_warmCache.load(jsonDoc))
+    {
+        handleWebResponse(jsonDoc);
+        m_textWidget.setTextColor(WarmCache::STALE_COLOR);
+    }
+
     initHttpClient();
     if (false == startHttpRequest())
     {
         /* If a request fails, show standard icon and a '?' */
         (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
         m_textWidget.setFormatStr("\\calign?");
-
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
-    }
-    else
-    {
-        m_requestTimer.start(UPDATE_PERIOD);
     }
 
     return;
@@ -210,13 +221,15 @@ void OpenWeatherPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_requestTimer.stop();
+    m_client.unsubscribe();
 
     if (false != FILESYSTEM.remove(configurationFilename))
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
 
+    m_warmCache.remove();
+
     return;
 }
 
@@ -225,23 +238,6 @@ void OpenWeatherPlugin::process()
     Msg                         msg;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
-    {
-        if (false == startHttpRequest())
-        {
-            /* If a request fails, show standard icon and a '?' */
-            (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
-            m_textWidget.setFormatStr("\\calign?");
-
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
-        }
-        else
-        {
-            m_requestTimer.start(UPDATE_PERIOD);
-        }
-    }
-
     if ((true == m_updateContentTimer.isTimerRunning()) &&
         (true == m_updateContentTimer.isTimeout()))
     {
@@ -261,28 +257,25 @@ void OpenWeatherPlugin::process()
             if (nullptr != msg.rsp)
             {
                 handleWebResponse(*msg.rsp);
-                delete msg.rsp;
+                m_textWidget.setTextColor(TextWidget::DEFAULT_TEXT_COLOR);
+
+                /* The warm cache takes over the response and writes it in the main loop context. */
+                m_warmCache.save(msg.rsp);
                 msg.rsp = nullptr;
             }
             break;
 
-        case MSG_TYPE_CONN_CLOSED:
-            LOG_INFO("Connection closed.");
+        case MSG_TYPE_CONN_ERROR:
+            LOG_WARNING("Connection error.");
 
-            if (true == m_isConnectionError)
+            /* If a request fails, show standard icon and a '?'. Data received
+             * before the restart is kept, until fresh data is available.
+             */
+            if (false == m_warmCache.isStale())
             {
-                /* If a request fails, show standard icon and a '?' */
                 (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
                 m_textWidget.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
             }
-            m_isConnectionError = false;
-            break;
-
-        case MSG_TYPE_CONN_ERROR:
-            LOG_WARNING("Connection error.");
-            m_isConnectionError = true;
             break;
 
         default:
@@ -294,6 +287,20 @@ void OpenWeatherPlugin::process()
     return;
 }
 
+uint32_t OpenWeatherPlugin::getNextWakeup() const
+{
+    uint32_t                    nextWakeup  = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Pending messages from the web task shall be handled in the next cycle. */
+    if (true == m_taskProxy.isEmpty())
+    {
+        nextWakeup = m_updateContentTimer.getRemaining();
+    }
+
+    return nextWakeup;
+}
+
 void OpenWeatherPlugin::active(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -303,6 +310,12 @@ void OpenWeatherPlugin::active(YAGfx& gfx)
      */
     (void)loadConfiguration();
 
+    /* The data of the shown plugin shall be requested first. The request
+     * is updated too, in case the configuration changed.
+     */
+    m_client.setPriority(FetchScheduler::PRIORITY_HIGH);
+    (void)startHttpRequest();
+
     /* Force immediate weather update on activation */
     updateDisplay(true);
 
@@ -320,11 +333,21 @@ void OpenWeatherPlugin::inactive()
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
+    m_client.setPriority(FetchScheduler::PRIORITY_NORMAL);
     m_updateContentTimer.stop();
 
     return;
 }
 
+void OpenWeatherPlugin::prepareActive(uint32_t timeToActive, uint32_t duration)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.prefetch(timeToActive + duration);
+
+    return;
+}
+
 void OpenWeatherPlugin::update(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -360,6 +383,9 @@ void OpenWeatherPlugin::setApiKey(const String& apiKey)
         m_apiKey = apiKey;
 
         (void)saveConfiguration();
+
+        /* Request the data with the changed configuration. */
+        (void)startHttpRequest();
     }
 
     return;
@@ -384,6 +410,9 @@ void OpenWeatherPlugin::setLatitude(const String& latitude)
         m_latitude = latitude;
 
         (void)saveConfiguration();
+
+        /* Request the data with the changed configuration. */
+        (void)startHttpRequest();
     }
 
     return;
@@ -408,6 +437,9 @@ void OpenWeatherPlugin::setLongitude(const String& longitude)
         m_longitude = longitude;
 
         (void)saveConfiguration();
+
+        /* Request the data with the changed configuration. */
+        (void)startHttpRequest();
     }
 
     return;
@@ -456,6 +488,9 @@ void OpenWeatherPlugin::setUnits(const String& units)
         m_units = units;
 
         (void)saveConfiguration();
+
+        /* Request the data with the changed configuration. */
+        (void)startHttpRequest();
     }
 
     return;
@@ -609,88 +644,129 @@ bool OpenWeatherPlugin::startHttpRequest()
         url += m_apiKey;
         url += "&exclude=minutely,hourly,daily,alerts";
 
-        if (true == m_client.begin(url))
+        if (false == m_client.subscribe(url, UPDATE_PERIOD))
         {
-            if (false == m_client.GET())
-            {
-                LOG_WARNING("GET %s failed.", url.c_str());
-            }
-            else
-            {
-                status = true;
-            }
+            LOG_WARNING("Subscribe to %s failed.", url.c_str());
+        }
+        else
+        {
+            status = true;
         }
     }
+    /* Nothing to request without configuration. */
+    else
+    {
+        m_client.unsubscribe();
+    }
 
     return status;
 }
 
 void OpenWeatherPlugin::initHttpClient()
 {
-    /* Note: All registered callbacks are running in a different task context!
-     *       Therefore it is not allowed to access a member here directly.
-     *       The processing must be deferred via task proxy.
-     */
-    m_client.regOnResponse(
-        [this](const HttpResponse& rsp)
+    const size_t                        FILTER_SIZE     = 128U;
+    StaticJsonDocument<FILTER_SIZE>     filter;
+    std::shared_ptr<JsonStreamFilter>   streamFilter;
+
+    /* Process the plugin in the next cycle, after a message arrived. */
+    m_taskProxy.setWakeUp(
+        [this]()
         {
-            const size_t            JSON_DOC_SIZE   = 256U;
-            DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+            this->wakeUp();
+        }
+    );
+
+    /* The response body is filtered while it is received, therefore only
+     * the filtered JSON text is kept instead of the whole body.
+     */
+    /* See https://openweathermap.org/api/one-call-api for an example of API response. */
+    filter["current"]["temp"]               = true;
+    filter["current"]["uvi"]                = true;
+    filter["current"]["humidity"]           = true;
+    filter["current"]["wind_speed"]         = true;
+    filter["current"]["weather"][0]["icon"] = true;
+
+    if (true == filter.overflowed())
+    {
+        LOG_ERROR("Less memory for filter available.");
+    }
+
+    streamFilter = std::shared_ptr<JsonStreamFilter>(new(std::nothrow) JsonStreamFilter(filter));
 
-            if (nullptr != jsonDoc)
+    if (nullptr == streamFilter)
+    {
+        LOG_ERROR("Couldn't create JSON stream filter.");
+    }
+    else
+    {
+        /* Note: All registered callbacks are running in a different task context!
+         *       Therefore it is not allowed to access a member here directly.
+         *       The processing must be deferred via task proxy.
+         *       The stream filter is only used in the callback context.
+         */
+        m_client.regOnBody(
+            [streamFilter](const uint8_t* data, size_t size, size_t index)
             {
-                size_t                          payloadSize             = 0U;
-                const char*                     payload                 = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
-                const size_t                    FILTER_SIZE             = 128U;
-                StaticJsonDocument<FILTER_SIZE> filter;
-                JsonObject                      filterCurrent           = filter.createNestedObject("current");
-                DeserializationError            error;
-
-                /* See https://openweathermap.org/api/one-call-api for an example of API response. */
-                filterCurrent["temp"]                  = true;
-                filterCurrent["uvi"]                   = true;
-                filterCurrent["humidity"]              = true;
-                filterCurrent["wind_speed"]            = true;
-                filterCurrent["weather"][0]["icon"]    = true;
-                
-                if (true == filter.overflowed())
+                if (0U == index)
                 {
-                    LOG_ERROR("Less memory for filter available.");
+                    streamFilter->reset();
                 }
 
-                error = deserializeJson(*jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+                (void)streamFilter->parse(data, size);
+            }
+        );
+
+        m_client.regOnResponse(
+            [this, streamFilter](const HttpResponse& rsp)
+            {
+                const size_t            JSON_DOC_SIZE   = 256U;
+                DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
 
-                if (DeserializationError::Ok != error.code())
+                UTIL_NOT_USED(rsp);
+
+                if (false == streamFilter->isComplete())
                 {
-                    LOG_WARNING("JSON parse error: %s", error.c_str());
+                    LOG_WARNING("Incomplete or invalid JSON response.");
                 }
-                else
+                else if (nullptr != jsonDoc)
                 {
-                    Msg msg;
-
-                    msg.type    = MSG_TYPE_RSP;
-                    msg.rsp     = jsonDoc;
+                    DeserializationError error = deserializeJson(*jsonDoc, streamFilter->getOutput(), streamFilter->getOutputSize());
 
-                    if (false == this->m_taskProxy.send(msg))
+                    if (DeserializationError::Ok != error.code())
                     {
-                        delete jsonDoc;
-                        jsonDoc = nullptr;
+                        LOG_WARNING("JSON parse error: %s", error.c_str());
                     }
-                }
-            }
-        }
-    );
+                    else
+                    {
+                        Msg msg;
 
-    m_client.regOnClosed(
-        [this]()
-        {
-            Msg msg;
+                        /* The fetch client is thread-safe. If the data is not
+                         * modified until the next request, the cached filtered
+                         * JSON text is provided again.
+                         */
+                        (void)this->m_client.cache(streamFilter->getOutput(), streamFilter->getOutputSize());
 
-            msg.type = MSG_TYPE_CONN_CLOSED;
+                        msg.type    = MSG_TYPE_RSP;
+                        msg.rsp     = jsonDoc;
 
-            (void)this->m_taskProxy.send(msg);
-        }
-    );
+                        if (true == this->m_taskProxy.send(msg))
+                        {
+                            jsonDoc = nullptr;
+                        }
+                    }
+                }
+
+                if (nullptr != jsonDoc)
+                {
+                    delete jsonDoc;
+                    jsonDoc = nullptr;
+                }
+
+                /* Release the filtered JSON text until the next response. */
+                streamFilter->reset();
+            }
+        );
+    }
 
     m_client.regOnError(
         [this]()
@@ -796,7 +872,7 @@ bool OpenWeatherPlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["apiKey"]   = m_apiKey;
@@ -823,7 +899,7 @@ bool OpenWeatherPlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
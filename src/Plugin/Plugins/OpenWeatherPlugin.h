@@ -45,7 +45,8 @@
  *****************************************************************************/
 #include <stdint.h>
 #include "Plugin.hpp"
-#include "AsyncHttpClient.h"
+#include "FetchClient.h"
+#include "WarmCache.h"
 
 #include <WidgetGroup.h>
 #include <BitmapWidget.h>
@@ -87,10 +88,9 @@ public:
         m_units("metric"),
         m_configurationFilename(),
         m_client(),
-        m_requestTimer(),
+        m_warmCache(),
         m_updateContentTimer(),
         m_mutex(),
-        m_isConnectionError(false),
         m_currentTemp("\\calign?"),
         m_currentWeatherIcon(IMAGE_PATH_STD_ICON),
         m_currentUvIndex("\\calign?"),
@@ -123,15 +123,11 @@ public:
      */
     ~OpenWeatherPlugin()
     {
-        m_client.regOnResponse(nullptr);
-        m_client.regOnClosed(nullptr);
-        m_client.regOnError(nullptr);
-
-        /* Abort any pending TCP request to avoid getting a callback after the
+        /* Unsubscribe first to avoid getting a callback after the
          * object is destroyed.
          */
-        m_client.abort();
-        
+        m_client.unsubscribe();
+
         clearQueue();
         
         m_mutex.destroy();
@@ -222,6 +218,15 @@ public:
      */
     void process(void) final;
 
+    /**
+     * Get the time in ms, until process() shall be called next.
+     * The plugin is only busy after its timers expired or after a message
+     * from the web task arrived, which wakes it up via task proxy.
+     *
+     * @return Time in ms until the next process() call
+     */
+    uint32_t getNextWakeup() const final;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -236,6 +241,16 @@ public:
      */
     void inactive() final;
 
+    /**
+     * This method will be called in case the plugin will be set active soon.
+     * If the data would be refreshed during the activation anyway, it is
+     * requested now, to avoid that stale data is shown first.
+     *
+     * @param[in] timeToActive  Time in ms until the plugin will be set active.
+     * @param[in] duration      Duration in ms, the plugin will be active. 0 means infinite.
+     */
+    void prepareActive(uint32_t timeToActive, uint32_t duration) final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -363,18 +378,11 @@ private:
 
     /**
      * Period in ms for requesting data from server.
-     * This is used in case the last request to the server was successful.
      * 
      * Note, the OpenWeather recommendation is no more than once in 10 minutes.
      */
     static const uint32_t   UPDATE_PERIOD           = (10U * 60U * 1000U);
 
-    /**
-     * Short period in ms for requesting data from server.
-     * This is used in case the request to the server failed.
-     */
-    static const uint32_t   UPDATE_PERIOD_SHORT     = (10U * 1000U);
-
     /** Time for duration tick period in ms */
     static const uint32_t   DURATION_TICK_PERIOD    = 1000U;
 
@@ -388,11 +396,10 @@ private:
     OtherWeatherInformation     m_additionalInformation;    /**< The configured additional weather information. */
     String                      m_units;                    /**< The units. */
     String                      m_configurationFilename;    /**< String used for specifying the configuration filename. */
-    AsyncHttpClient             m_client;                   /**< Asynchronous HTTP client. */
-    SimpleTimer                 m_requestTimer;             /**< Timer used for cyclic request of new data. */
+    FetchClient                 m_client;                   /**< Fetch client, which requests the data periodically. */
+    WarmCache                   m_warmCache;                /**< Data received before the restart, shown until fresh data is available. */
     SimpleTimer                 m_updateContentTimer;       /**< Timer used for duration ticks in [s]. */
     mutable MutexRecursive      m_mutex;                    /**< Mutex to protect against concurrent access. */
-    bool                        m_isConnectionError;        /**< Is connection error happened? */
     String                      m_currentTemp;              /**< The current temperature. */
     String                      m_currentWeatherIcon;       /**< The current weather condition icon. */
     String                      m_currentUvIndex;           /**< The current UV index. */
@@ -409,7 +416,6 @@ private:
     {
         MSG_TYPE_INVALID = 0,   /**< Invalid message type. */
         MSG_TYPE_RSP,           /**< A response, caused by a previous request. */
-        MSG_TYPE_CONN_CLOSED,   /**< The connection is closed. */
         MSG_TYPE_CONN_ERROR     /**< A connection error happened. */
     };
 
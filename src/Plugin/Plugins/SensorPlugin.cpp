@@ -39,6 +39,7 @@
 #include <Logging.h>
 #include <ArduinoJson.h>
 #include <JsonFile.h>
+#include <JsonDocPool.h>
 #include <SensorDataProvider.h>
 #include <SensorChannelType.hpp>
 
@@ -305,7 +306,7 @@ bool SensorPlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["sensorIndex"]  = m_sensorIdx;
@@ -329,7 +330,7 @@ bool SensorPlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
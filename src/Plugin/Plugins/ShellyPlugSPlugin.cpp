@@ -43,6 +43,7 @@
 #include <ArduinoJson.h>
 #include <Logging.h>
 #include <JsonFile.h>
+#include <JsonDocPool.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -142,14 +143,7 @@ void ShellyPlugSPlugin::start(uint16_t width, uint16_t height)
     }
 
     initHttpClient();
-    if (false == startHttpRequest())
-    {
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
-    }
-    else
-    {
-        m_requestTimer.start(UPDATE_PERIOD);
-    }
+    (void)startHttpRequest();
 
     return;
 }
@@ -159,7 +153,7 @@ void ShellyPlugSPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_requestTimer.stop();
+    m_client.unsubscribe();
 
     if (false != FILESYSTEM.remove(configurationFilename))
     {
@@ -174,19 +168,6 @@ void ShellyPlugSPlugin::process()
     Msg                         msg;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
-    {
-        if (false == startHttpRequest())
-        {
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
-        }
-        else
-        {
-            m_requestTimer.start(UPDATE_PERIOD);
-        }
-    }
-
     if (true == m_taskProxy.receive(msg))
     {
         switch(msg.type)
@@ -213,6 +194,52 @@ void ShellyPlugSPlugin::process()
     return;
 }
 
+uint32_t ShellyPlugSPlugin::getNextWakeup() const
+{
+    uint32_t                    nextWakeup  = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Pending messages from the web task shall be handled in the next cycle.
+     * Otherwise the task proxy wakes the plugin up.
+     */
+    if (true == m_taskProxy.isEmpty())
+    {
+        nextWakeup = UINT32_MAX;
+    }
+
+    return nextWakeup;
+}
+
+void ShellyPlugSPlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    UTIL_NOT_USED(gfx);
+
+    /* The data of the shown plugin shall be requested first. */
+    m_client.setPriority(FetchScheduler::PRIORITY_HIGH);
+
+    return;
+}
+
+void ShellyPlugSPlugin::inactive()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.setPriority(FetchScheduler::PRIORITY_NORMAL);
+
+    return;
+}
+
+void ShellyPlugSPlugin::prepareActive(uint32_t timeToActive, uint32_t duration)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.prefetch(timeToActive + duration);
+
+    return;
+}
+
 void ShellyPlugSPlugin::update(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -233,6 +260,9 @@ void ShellyPlugSPlugin::setIPAddress(const String& ipAddress)
         m_ipAddress = ipAddress;
 
         (void)saveConfiguration();
+
+        /* Request the data with the changed configuration. */
+        (void)startHttpRequest();
     }
 
     return;
@@ -260,27 +290,29 @@ bool ShellyPlugSPlugin::startHttpRequest()
 {
     bool    status  = false;
     String  url     = String("http://") + m_ipAddress + "/meter/0/";
-    wl_status_t connectionStatus    = WiFi.status();
 
-    if (WL_CONNECTED == connectionStatus)
+    /* The request is scheduled after the WiFi connection is established. */
+    if (false == m_client.subscribe(url, UPDATE_PERIOD))
     {
-        if (true == m_client.begin(url))
-        {
-            if (false == m_client.GET())
-            {
-                LOG_WARNING("GET %s failed.", url.c_str());
-            }
-            else
-            {
-                status = true;
-            }
-        }
+        LOG_WARNING("Subscribe to %s failed.", url.c_str());
+    }
+    else
+    {
+        status = true;
     }
 
     return status;
 }
 void ShellyPlugSPlugin::initHttpClient()
 {
+    /* Process the plugin in the next cycle, after a message arrived. */
+    m_taskProxy.setWakeUp(
+        [this]()
+        {
+            this->wakeUp();
+        }
+    );
+
     /* Note: All registered callbacks are running in a different task context!
      *       Therefore it is not allowed to access a member here directly.
      *       The processing must be deferred via task proxy.
@@ -369,7 +401,7 @@ bool ShellyPlugSPlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["shellyPlugSIP"] = m_ipAddress;
@@ -392,7 +424,7 @@ bool ShellyPlugSPlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
@@ -44,14 +44,13 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include "AsyncHttpClient.h"
+#include "FetchClient.h"
 #include "Plugin.hpp"
 
 #include <WidgetGroup.h>
 #include <BitmapWidget.h>
 #include <stdint.h>
 #include <TextWidget.h>
-#include <SimpleTimer.hpp>
 #include <TaskProxy.hpp>
 #include <Mutex.hpp>
 
@@ -85,7 +84,6 @@ public:
         m_ipAddress("192.168.1.123"), /* Example data */
         m_client(),
         m_mutex(),
-        m_requestTimer(),
         m_taskProxy()
     {
         /* Move the text widget one line lower for better look. */
@@ -99,15 +97,11 @@ public:
      */
     ~ShellyPlugSPlugin()
     {
-        m_client.regOnResponse(nullptr);
-        m_client.regOnClosed(nullptr);
-        m_client.regOnError(nullptr);
-
-        /* Abort any pending TCP request to avoid getting a callback after the
+        /* Unsubscribe first to avoid getting a callback after the
          * object is destroyed.
          */
-        m_client.abort();
-        
+        m_client.unsubscribe();
+
         clearQueue();
         
         m_mutex.destroy();
@@ -190,6 +184,39 @@ public:
      */
     void process(void) final;
 
+    /**
+     * Get the time in ms, until process() shall be called next.
+     * The plugin is only busy after a message from the web task arrived,
+     * which wakes it up via task proxy.
+     *
+     * @return Time in ms until the next process() call
+     */
+    uint32_t getNextWakeup() const final;
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
+    /**
+     * This method will be called in case the plugin will be set active soon.
+     * If the data would be refreshed during the activation anyway, it is
+     * requested now, to avoid that stale data is shown first.
+     *
+     * @param[in] timeToActive  Time in ms until the plugin will be set active.
+     * @param[in] duration      Duration in ms, the plugin will be active. 0 means infinite.
+     */
+    void prepareActive(uint32_t timeToActive, uint32_t duration) final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -236,24 +263,16 @@ private:
 
     /**
      * Period in ms for requesting power consumption from the Shelly PlugS.
-     * This is used in case the last request to the server was successful.
      */
     static const uint32_t   UPDATE_PERIOD       = (15U * 1000U);
 
-    /**
-     * Short period in ms for requesting power consumption from the Shelly PlugS.
-     * This is used in case the request to the server failed.
-     */
-    static const uint32_t   UPDATE_PERIOD_SHORT = (10U * 1000U);
-
     WidgetGroup             m_textCanvas;       /**< Canvas used for the text widget. */
     WidgetGroup             m_iconCanvas;       /**< Canvas used for the bitmap widget. */
     BitmapWidget            m_bitmapWidget;     /**< Bitmap widget, used to show the icon. */
     TextWidget              m_textWidget;       /**< Text widget, used for showing the text. */
     String                  m_ipAddress;        /**< IP-address of the ShellyPlugS server. */
-    AsyncHttpClient         m_client;           /**< Asynchronous HTTP client. */
+    FetchClient             m_client;           /**< Fetch client, which requests the data periodically. */
     mutable MutexRecursive  m_mutex;            /**< Mutex to protect against concurrent access. */
-    SimpleTimer             m_requestTimer;     /**< Timer is used for cyclic ShellyPlugS  http request. */
 
     /**
      * Defines the message types, which are necessary for HTTP client/server handling.
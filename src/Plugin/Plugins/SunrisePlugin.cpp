@@ -43,6 +43,7 @@
 #include <ArduinoJson.h>
 #include <Logging.h>
 #include <JsonFile.h>
+#include <JsonDocPool.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -164,14 +165,7 @@ void SunrisePlugin::start(uint16_t width, uint16_t height)
     }
 
     initHttpClient();
-    if (false == startHttpRequest())
-    {
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
-    }
-    else
-    {
-        m_requestTimer.start(UPDATE_PERIOD);
-    }
+    (void)startHttpRequest();
 
     return;
 }
@@ -181,7 +175,7 @@ void SunrisePlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_requestTimer.stop();
+    m_client.unsubscribe();
 
     if (false != FILESYSTEM.remove(configurationFilename))
     {
@@ -196,19 +190,6 @@ void SunrisePlugin::process()
     Msg                         msg;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
-    {
-        if (false == startHttpRequest())
-        {
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
-        }
-        else
-        {
-            m_requestTimer.start(UPDATE_PERIOD);
-        }
-    }
-
     if (true == m_taskProxy.receive(msg))
     {
         switch(msg.type)
@@ -235,6 +216,52 @@ void SunrisePlugin::process()
     return;
 }
 
+uint32_t SunrisePlugin::getNextWakeup() const
+{
+    uint32_t                    nextWakeup  = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Pending messages from the web task shall be handled in the next cycle.
+     * Otherwise the task proxy wakes the plugin up.
+     */
+    if (true == m_taskProxy.isEmpty())
+    {
+        nextWakeup = UINT32_MAX;
+    }
+
+    return nextWakeup;
+}
+
+void SunrisePlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    UTIL_NOT_USED(gfx);
+
+    /* The data of the shown plugin shall be requested first. */
+    m_client.setPriority(FetchScheduler::PRIORITY_HIGH);
+
+    return;
+}
+
+void SunrisePlugin::inactive()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.setPriority(FetchScheduler::PRIORITY_NORMAL);
+
+    return;
+}
+
+void SunrisePlugin::prepareActive(uint32_t timeToActive, uint32_t duration)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.prefetch(timeToActive + duration);
+
+    return;
+}
+
 void SunrisePlugin::update(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -270,6 +297,9 @@ void SunrisePlugin::setLocation(const String& longitude, const String& latitude)
          * plugin activation.
          */
         (void)saveConfiguration();
+
+        /* Request the data with the changed configuration. */
+        (void)startHttpRequest();
     }
 
     return;
@@ -288,16 +318,13 @@ bool SunrisePlugin::startHttpRequest()
     bool    status  = false;
     String  url     = String("http://api.sunrise-sunset.org/json?lat=") + m_latitude + "&lng=" + m_longitude + "&formatted=0";
 
-    if (true == m_client.begin(url))
+    if (false == m_client.subscribe(url, UPDATE_PERIOD))
     {
-        if (false == m_client.GET())
-        {
-            LOG_WARNING("GET %s failed.", url.c_str());
-        }
-        else
-        {
-            status = true;
-        }
+        LOG_WARNING("Subscribe to %s failed.", url.c_str());
+    }
+    else
+    {
+        status = true;
     }
 
     return status;
@@ -305,6 +332,14 @@ bool SunrisePlugin::startHttpRequest()
 
 void SunrisePlugin::initHttpClient()
 {
+    /* Process the plugin in the next cycle, after a message arrived. */
+    m_taskProxy.setWakeUp(
+        [this]()
+        {
+            this->wakeUp();
+        }
+    );
+
     /* Note: All registered callbacks are running in a different task context!
      *       Therefore it is not allowed to access a member here directly.
      *       The processing must be deferred via task proxy.
@@ -430,7 +465,7 @@ bool SunrisePlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["longitude"]    = m_longitude;
@@ -454,7 +489,7 @@ bool SunrisePlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
@@ -39,6 +39,7 @@
 #include <Logging.h>
 #include <ArduinoJson.h>
 #include <JsonFile.h>
+#include <JsonDocPool.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -167,12 +168,6 @@ void VolumioPlugin::start(uint16_t width, uint16_t height)
         /* If a request fails, show standard icon and a '?' */
         changeState(STATE_UNKNOWN);
         m_textWidget.setFormatStr("\\calign?");
-
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
-    }
-    else
-    {
-        m_requestTimer.start(UPDATE_PERIOD);
     }
 
     m_offlineTimer.start(OFFLINE_PERIOD);
@@ -186,7 +181,7 @@ void VolumioPlugin::stop()
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_offlineTimer.stop();
-    m_requestTimer.stop();
+    m_client.unsubscribe();
 
     if (false != FILESYSTEM.remove(configurationFilename))
     {
@@ -201,23 +196,6 @@ void VolumioPlugin::process()
     Msg                         msg;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
-    {
-        if (false == startHttpRequest())
-        {
-            /* If a request fails, show standard icon and a '?' */
-            changeState(STATE_UNKNOWN);
-            m_textWidget.setFormatStr("\\calign?");
-
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
-        }
-        else
-        {
-            m_requestTimer.start(UPDATE_PERIOD);
-        }
-    }
-
     if (true == m_taskProxy.receive(msg))
     {
         switch(msg.type)
@@ -235,23 +213,12 @@ void VolumioPlugin::process()
             }
             break;
 
-        case MSG_TYPE_CONN_CLOSED:
-            LOG_INFO("Connection closed.");
-
-            if (true == m_isConnectionError)
-            {
-                /* If a request fails, show standard icon and a '?' */
-                changeState(STATE_UNKNOWN);
-                m_textWidget.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            m_isConnectionError = false;
-            break;
-
         case MSG_TYPE_CONN_ERROR:
             LOG_WARNING("Connection error.");
-            m_isConnectionError = true;
+
+            /* If a request fails, show standard icon and a '?' */
+            changeState(STATE_UNKNOWN);
+            m_textWidget.setFormatStr("\\calign?");
             break;
 
         default:
@@ -272,6 +239,50 @@ void VolumioPlugin::process()
     return;
 }
 
+uint32_t VolumioPlugin::getNextWakeup() const
+{
+    uint32_t                    nextWakeup  = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Pending messages from the web task shall be handled in the next cycle. */
+    if (true == m_taskProxy.isEmpty())
+    {
+        nextWakeup = m_offlineTimer.getRemaining();
+    }
+
+    return nextWakeup;
+}
+
+void VolumioPlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    UTIL_NOT_USED(gfx);
+
+    /* The data of the shown plugin shall be requested first. */
+    m_client.setPriority(FetchScheduler::PRIORITY_HIGH);
+
+    return;
+}
+
+void VolumioPlugin::inactive()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.setPriority(FetchScheduler::PRIORITY_NORMAL);
+
+    return;
+}
+
+void VolumioPlugin::prepareActive(uint32_t timeToActive, uint32_t duration)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_client.prefetch(timeToActive + duration);
+
+    return;
+}
+
 void VolumioPlugin::update(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive>  guard(m_mutex);
@@ -310,6 +321,9 @@ void VolumioPlugin::setHost(const String& host)
     {
         m_volumioHost = host;
         (void)saveConfiguration();
+
+        /* Request the data with the changed configuration. */
+        (void)startHttpRequest();
     }
 
     return;
@@ -382,17 +396,19 @@ bool VolumioPlugin::startHttpRequest()
     {
         String url = String("http://") + m_volumioHost + "/api/v1/getState";
 
-        if (true == m_client.begin(url))
+        if (false == m_client.subscribe(url, UPDATE_PERIOD))
         {
-            if (false == m_client.GET())
-            {
-                LOG_WARNING("GET %s failed.", url.c_str());
-            }
-            else
-            {
-                status = true;
-            }
+            LOG_WARNING("Subscribe to %s failed.", url.c_str());
         }
+        else
+        {
+            status = true;
+        }
+    }
+    /* Nothing to request without configuration. */
+    else
+    {
+        m_client.unsubscribe();
     }
 
     return status;
@@ -400,6 +416,14 @@ bool VolumioPlugin::startHttpRequest()
 
 void VolumioPlugin::initHttpClient()
 {
+    /* Process the plugin in the next cycle, after a message arrived. */
+    m_taskProxy.setWakeUp(
+        [this]()
+        {
+            this->wakeUp();
+        }
+    );
+
     /* Note: All registered callbacks are running in a different task context!
      *       Therefore it is not allowed to access a member here directly.
      *       The processing must be deferred via task proxy.
@@ -453,17 +477,6 @@ void VolumioPlugin::initHttpClient()
         }
     );
 
-    m_client.regOnClosed(
-        [this]()
-        {
-            Msg msg;
-
-            msg.type = MSG_TYPE_CONN_CLOSED;
-
-            (void)this->m_taskProxy.send(msg);
-        }
-    );
-
     m_client.regOnError(
         [this]()
         {
@@ -623,7 +636,7 @@ bool VolumioPlugin::saveConfiguration() const
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["host"] = m_volumioHost;
@@ -646,7 +659,7 @@ bool VolumioPlugin::loadConfiguration()
     bool                status                  = true;
     JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     String              configurationFilename   = getFullPathToConfiguration();
 
     if (false == jsonFile.load(configurationFilename, jsonDoc))
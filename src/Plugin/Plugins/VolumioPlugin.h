@@ -45,7 +45,7 @@
  *****************************************************************************/
 #include <stdint.h>
 #include "Plugin.hpp"
-#include "AsyncHttpClient.h"
+#include "FetchClient.h"
 
 #include <WidgetGroup.h>
 #include <BitmapWidget.h>
@@ -92,10 +92,8 @@ public:
         m_urlIcon(),
         m_urlText(),
         m_client(),
-        m_requestTimer(),
         m_offlineTimer(),
         m_mutex(),
-        m_isConnectionError(false),
         m_lastSeekValue(0U),
         m_pos(0U),
         m_state(STATE_UNKNOWN),
@@ -112,15 +110,11 @@ public:
      */
     ~VolumioPlugin()
     {
-        m_client.regOnResponse(nullptr);
-        m_client.regOnClosed(nullptr);
-        m_client.regOnError(nullptr);
-
-        /* Abort any pending TCP request to avoid getting a callback after the
+        /* Unsubscribe first to avoid getting a callback after the
          * object is destroyed.
          */
-        m_client.abort();
-        
+        m_client.unsubscribe();
+
         clearQueue();
 
         m_mutex.destroy();
@@ -203,6 +197,39 @@ public:
      */
     void process(void) final;
 
+    /**
+     * Get the time in ms, until process() shall be called next.
+     * The plugin is only busy after its timers expired or after a message
+     * from the web task arrived, which wakes it up via task proxy.
+     *
+     * @return Time in ms until the next process() call
+     */
+    uint32_t getNextWakeup() const final;
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
+    /**
+     * This method will be called in case the plugin will be set active soon.
+     * If the data would be refreshed during the activation anyway, it is
+     * requested now, to avoid that stale data is shown first.
+     *
+     * @param[in] timeToActive  Time in ms until the plugin will be set active.
+     * @param[in] duration      Duration in ms, the plugin will be active. 0 means infinite.
+     */
+    void prepareActive(uint32_t timeToActive, uint32_t duration) final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -275,18 +302,11 @@ private:
 
     /**
      * Period in ms for requesting data from server.
-     * This is used in case the last request to the server was successful.
-     * The period is shorter than the UPDATE_PERIOD_SHORT, because if the music
-     * changes, the display shall be updated more or less immediately.
+     * The period is short, because if the music changes, the display shall
+     * be updated more or less immediately.
      */
     static const uint32_t   UPDATE_PERIOD       = (2U * 1000U);
 
-    /**
-     * Short period in ms for requesting data from server.
-     * This is used in case the request to the server failed.
-     */
-    static const uint32_t   UPDATE_PERIOD_SHORT = (10U * 1000U);
-
     /**
      * Period in ms after which the plugin gets automatically disabled if no new
      * data is available.
@@ -303,11 +323,9 @@ private:
     String                  m_volumioHost;              /**< Host address of the VOLUMIO server. */
     String                  m_urlIcon;                  /**< REST API URL for updating the icon */
     String                  m_urlText;                  /**< REST API URL for updating the text */
-    AsyncHttpClient         m_client;                   /**< Asynchronous HTTP client. */
-    SimpleTimer             m_requestTimer;             /**< Timer used for cyclic request of new data. */
+    FetchClient             m_client;                   /**< Fetch client, which requests the data periodically. */
     SimpleTimer             m_offlineTimer;             /**< Timer used for offline detection. */
     mutable MutexRecursive  m_mutex;                    /**< Mutex to protect against concurrent access. */
-    bool                    m_isConnectionError;        /**< Is connection error happened? */
     uint32_t                m_lastSeekValue;            /**< Last seek value, retrieved from VOLUMIO. Used to cross-check the provided status. */
     uint8_t                 m_pos;                      /**< Current music position in percent. */
     VolumioState            m_state;                    /**< Volumio player state */
@@ -319,7 +337,6 @@ private:
     {
         MSG_TYPE_INVALID = 0,   /**< Invalid message type. */
         MSG_TYPE_RSP,           /**< A response, caused by a previous request. */
-        MSG_TYPE_CONN_CLOSED,   /**< The connection is closed. */
         MSG_TYPE_CONN_ERROR     /**< A connection error happened. */
     };
 
@@ -0,0 +1,326 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Warm restart cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WarmCache.h"
+#include "WarmCacheWriter.h"
+#include "FileSystem.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+#include <JsonFile.h>
+#include <JsonDocPool.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Size of the cache file structure around the data. */
+static const size_t FILE_OVERHEAD_SIZE  = JSON_OBJECT_SIZE(2U) + 32U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+WarmCache::WarmCache() :
+    m_mutex(),
+    m_isStale(false),
+    m_isFreshDataReceived(false),
+    m_savedData(nullptr),
+    m_fileMutex(),
+    m_fullPath(),
+    m_unwrittenData(nullptr),
+    m_isWritten(false),
+    m_hash(0U),
+    m_lastSaveTimestamp(0U)
+{
+    (void)m_mutex.create();
+    (void)m_fileMutex.create();
+
+    WarmCacheWriter::getInstance().registerCache(*this);
+}
+
+WarmCache::~WarmCache()
+{
+    /* Unregister first, to ensure that the writer doesn't access the
+     * cache anymore.
+     */
+    WarmCacheWriter::getInstance().unregisterCache(*this);
+
+    if (nullptr != m_savedData)
+    {
+        delete m_savedData;
+        m_savedData = nullptr;
+    }
+
+    if (nullptr != m_unwrittenData)
+    {
+        delete m_unwrittenData;
+        m_unwrittenData = nullptr;
+    }
+
+    m_fileMutex.destroy();
+    m_mutex.destroy();
+}
+
+bool WarmCache::load(JsonDocument& data)
+{
+    bool                        isSuccessful    = false;
+    JsonFile                    jsonFile(FILESYSTEM);
+    PooledJsonDocument          jsonDoc(data.capacity() + FILE_OVERHEAD_SIZE);
+    MutexGuard<MutexRecursive>  guard(m_fileMutex);
+
+    if (false == FILESYSTEM.exists(m_fullPath))
+    {
+        LOG_INFO("No cached data in %s.", m_fullPath.c_str());
+    }
+    else if (false == jsonFile.load(m_fullPath, jsonDoc))
+    {
+        LOG_WARNING("Failed to load file %s.", m_fullPath.c_str());
+    }
+    else
+    {
+        JsonVariantConst    jsonTimestamp   = jsonDoc["timestamp"];
+        JsonVariantConst    jsonData        = jsonDoc["data"];
+        time_t              now             = time(nullptr);
+
+        if (false == jsonTimestamp.is<uint32_t>())
+        {
+            LOG_WARNING("Cached data timestamp not found or invalid type.");
+        }
+        else if (true == jsonData.isNull())
+        {
+            LOG_WARNING("Cached data not found.");
+        }
+        /* The age is only known, if the system time was set at both, the
+         * reception and now. Otherwise the data is shown stale.
+         */
+        else if ((UNIX_TIME_MIN <= static_cast<time_t>(jsonTimestamp.as<uint32_t>())) &&
+                 (UNIX_TIME_MIN <= now) &&
+                 (MAX_AGE < static_cast<uint32_t>(now - static_cast<time_t>(jsonTimestamp.as<uint32_t>()))))
+        {
+            LOG_INFO("Cached data from %u expired.", jsonTimestamp.as<uint32_t>());
+        }
+        else if (false == data.set(jsonData))
+        {
+            LOG_WARNING("Cached data too large.");
+        }
+        else
+        {
+            MutexGuard<MutexRecursive> dataGuard(m_mutex);
+
+            m_isStale           = true;
+            m_hash              = calcHash(data);
+            isSuccessful        = true;
+
+            LOG_INFO("Cached content from %u available after %u ms.", jsonTimestamp.as<uint32_t>(), millis());
+        }
+    }
+
+    return isSuccessful;
+}
+
+void WarmCache::save(DynamicJsonDocument* data)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_isStale = false;
+
+    if (false == m_isFreshDataReceived)
+    {
+        LOG_INFO("Fresh content available after %u ms.", millis());
+        m_isFreshDataReceived = true;
+    }
+
+    /* Only the latest data is of interest. */
+    if (nullptr != m_savedData)
+    {
+        delete m_savedData;
+    }
+
+    m_savedData = data;
+}
+
+void WarmCache::write()
+{
+    DynamicJsonDocument*        data        = nullptr;
+    uint32_t                    timestamp   = millis();
+    MutexGuard<MutexRecursive>  guard(m_fileMutex);
+
+    /* Take over the saved data, to keep the lock short. */
+    if (true == m_mutex.take(portMAX_DELAY))
+    {
+        data        = m_savedData;
+        m_savedData = nullptr;
+
+        (void)m_mutex.give();
+    }
+
+    if (nullptr != data)
+    {
+        uint32_t hash = calcHash(*data);
+
+        if (hash == m_hash)
+        {
+            delete data;
+        }
+        else
+        {
+            if (nullptr != m_unwrittenData)
+            {
+                delete m_unwrittenData;
+            }
+
+            m_unwrittenData = data;
+            m_hash          = hash;
+        }
+
+        data = nullptr;
+    }
+
+    /* After the first write, changes are only written periodically. */
+    if ((nullptr != m_unwrittenData) &&
+        ((false == m_isWritten) || (MIN_SAVE_PERIOD <= (timestamp - m_lastSaveTimestamp))))
+    {
+        writeFile(*m_unwrittenData);
+
+        delete m_unwrittenData;
+        m_unwrittenData = nullptr;
+
+        m_isWritten         = true;
+        m_lastSaveTimestamp = timestamp;
+    }
+}
+
+void WarmCache::remove()
+{
+    MutexGuard<MutexRecursive> guard(m_fileMutex);
+
+    if (false != FILESYSTEM.remove(m_fullPath))
+    {
+        LOG_INFO("File %s removed", m_fullPath.c_str());
+    }
+
+    if (true == m_mutex.take(portMAX_DELAY))
+    {
+        if (nullptr != m_savedData)
+        {
+            delete m_savedData;
+            m_savedData = nullptr;
+        }
+
+        m_isStale = false;
+
+        (void)m_mutex.give();
+    }
+
+    if (nullptr != m_unwrittenData)
+    {
+        delete m_unwrittenData;
+        m_unwrittenData = nullptr;
+    }
+
+    m_hash = 0U;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void WarmCache::writeFile(const JsonDocument& data)
+{
+    JsonFile            jsonFile(FILESYSTEM);
+    PooledJsonDocument  jsonDoc(data.memoryUsage() + FILE_OVERHEAD_SIZE);
+    time_t              now     = time(nullptr);
+
+    /* System time not set yet? */
+    if (UNIX_TIME_MIN > now)
+    {
+        now = 0;
+    }
+
+    jsonDoc["timestamp"]    = static_cast<uint32_t>(now);
+    jsonDoc["data"]         = data.as<JsonVariantConst>();
+
+    if (false == jsonFile.save(m_fullPath, jsonDoc))
+    {
+        LOG_WARNING("Failed to save file %s.", m_fullPath.c_str());
+    }
+}
+
+uint32_t WarmCache::calcHash(const JsonDocument& data)
+{
+    const uint32_t  FNV_OFFSET_BASIS    = 2166136261U;
+    const uint32_t  FNV_PRIME           = 16777619U;
+    uint32_t        hash                = FNV_OFFSET_BASIS;
+    String          text;
+    size_t          idx                 = 0U;
+
+    (void)serializeJson(data, text);
+
+    for(idx = 0U; idx < text.length(); ++idx)
+    {
+        hash ^= static_cast<uint8_t>(text[idx]);
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,199 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Warm restart cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __WARM_CACHE_H__
+#define __WARM_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <time.h>
+#include <WString.h>
+#include <ArduinoJson.h>
+#include <Mutex.hpp>
+#include <ColorDef.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The warm restart cache persists the last received data of a network
+ * plugin, e.g. the filtered JSON response. After a restart the plugin shows
+ * it immediately, instead of a placeholder until the first request after
+ * the WiFi connection succeeded. The loaded data is marked as stale, until
+ * fresh data is received. Data older than MAX_AGE is not loaded, as long as
+ * the system time allows to determine the age.
+ *
+ * The data is written together with the current time in the plugin
+ * configuration directory. Saving only takes over the data, it is written
+ * later by the warm cache writer in the main loop context. To spare the
+ * flash, it is only written if it changed and not more often than
+ * MIN_SAVE_PERIOD.
+ *
+ * The time after boot until the first content is available (cached or
+ * fresh) is logged, to measure the time to meaningful content.
+ */
+class WarmCache
+{
+public:
+
+    /**
+     * Constructs the warm restart cache.
+     */
+    WarmCache();
+
+    /**
+     * Destroys the warm restart cache.
+     */
+    ~WarmCache();
+
+    /**
+     * Set the full path of the cache file. Call it before any other method.
+     *
+     * @param[in] fullPath  Full path of the cache file
+     */
+    void setFullPath(const String& fullPath)
+    {
+        MutexGuard<MutexRecursive> guard(m_fileMutex);
+
+        m_fullPath = fullPath;
+    }
+
+    /**
+     * Load the data, which was received before the restart.
+     * The data is stale afterwards.
+     *
+     * @param[out] data Data
+     *
+     * @return If data is available, it will return true otherwise false.
+     */
+    bool load(JsonDocument& data);
+
+    /**
+     * Save fresh received data. The data is not stale anymore.
+     * The cache takes over the ownership of the data and writes it later
+     * in the main loop context.
+     *
+     * @param[in] data  Data
+     */
+    void save(DynamicJsonDocument* data);
+
+    /**
+     * Write the saved data to the filesystem, if necessary.
+     * Call it in the main loop context only, see WarmCacheWriter.
+     */
+    void write();
+
+    /**
+     * Remove the cache file, e.g. because the plugin is uninstalled.
+     */
+    void remove();
+
+    /**
+     * Is the shown data stale, because it was received before the restart?
+     *
+     * @return If stale, it will return true otherwise false.
+     */
+    bool isStale() const
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        return m_isStale;
+    }
+
+    /** Min. period in ms between two writes of the cache file. */
+    static const uint32_t   MIN_SAVE_PERIOD = 10U * 60U * 1000U;
+
+    /** Max. age in s of the cached data, to be loaded after a restart. */
+    static const uint32_t   MAX_AGE         = 24U * 60U * 60U;
+
+    /** Text color, which shows the user that stale data is shown. */
+    static const uint32_t   STALE_COLOR     = ColorDef::GRAY;
+
+private:
+
+    /**
+     * Unix time of 2020-01-01, used to detect whether the system time is set.
+     */
+    static const time_t     UNIX_TIME_MIN   = 1577836800;
+
+    mutable MutexRecursive  m_mutex;                /**< Protects the saved data against concurrent access. */
+    bool                    m_isStale;              /**< Is the data stale? */
+    bool                    m_isFreshDataReceived;  /**< Was fresh data received after the restart? */
+    DynamicJsonDocument*    m_savedData;            /**< Saved data, which is not handled by the writer yet. */
+    MutexRecursive          m_fileMutex;            /**< Protects the cache file against concurrent access. */
+    String                  m_fullPath;             /**< Full path of the cache file */
+    DynamicJsonDocument*    m_unwrittenData;        /**< Changed data, which is not written to the cache file yet. */
+    bool                    m_isWritten;            /**< Was the cache file written after the restart? */
+    uint32_t                m_hash;                 /**< Hash of the latest data, used to detect changes. */
+    uint32_t                m_lastSaveTimestamp;    /**< Timestamp in ms of the last write */
+
+    WarmCache(const WarmCache& cache);
+    WarmCache& operator=(const WarmCache& cache);
+
+    /**
+     * Write the data to the cache file, together with the current time.
+     *
+     * @param[in] data  Data
+     */
+    void writeFile(const JsonDocument& data);
+
+    /**
+     * Calculate the hash (FNV-1a) of the serialized data.
+     *
+     * @param[in] data  Data
+     *
+     * @return Hash
+     */
+    static uint32_t calcHash(const JsonDocument& data);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __WARM_CACHE_H__ */
+
+/** @} */
@@ -0,0 +1,135 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Warm restart cache writer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __WARM_CACHE_WRITER_H__
+#define __WARM_CACHE_WRITER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Mutex.hpp>
+#include <LinkedList.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+class WarmCache;
+
+/**
+ * The warm cache writer writes the data of all warm restart caches to the
+ * filesystem. The plugins save their data in the display task context,
+ * while the plugin and display locks are held. Calculating the hash and
+ * writing the file takes place in the main loop context instead.
+ */
+class WarmCacheWriter
+{
+public:
+
+    /**
+     * Get warm cache writer instance.
+     *
+     * @return Warm cache writer instance
+     */
+    static WarmCacheWriter& getInstance()
+    {
+        static WarmCacheWriter instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Process the writer. Call it cyclic in the main loop context.
+     */
+    void process();
+
+    /**
+     * Register a warm restart cache.
+     *
+     * @param[in] cache Warm restart cache
+     */
+    void registerCache(WarmCache& cache);
+
+    /**
+     * Unregister a warm restart cache. After return, the writer won't
+     * access it anymore.
+     *
+     * @param[in] cache Warm restart cache
+     */
+    void unregisterCache(WarmCache& cache);
+
+private:
+
+    mutable MutexRecursive  m_mutex;    /**< Mutex to protect against concurrent access. */
+    DLinkedList<WarmCache*> m_caches;   /**< Registered warm restart caches */
+
+    /**
+     * Constructs the warm cache writer.
+     */
+    WarmCacheWriter() :
+        m_mutex(),
+        m_caches()
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the warm cache writer.
+     */
+    ~WarmCacheWriter()
+    {
+        m_mutex.destroy();
+    }
+
+    WarmCacheWriter(const WarmCacheWriter& writer);
+    WarmCacheWriter& operator=(const WarmCacheWriter& writer);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __WARM_CACHE_WRITER_H__ */
+
+/** @} */
@@ -40,6 +40,9 @@
 #include "ClockDrv.h"
 #include "ButtonDrv.h"
 #include "DisplayMgr.h"
+#include "FetchScheduler.h"
+#include "ParseWorker.h"
+#include "WarmCacheWriter.h"
 
 #include "ConnectingState.h"
 #include "RestartState.h"
@@ -122,6 +125,15 @@ void ConnectedState::entry(StateMachine& sm)
         SysMsg::getInstance().show(infoStr, 4000U, 2U);
 
         LOG_INFO(infoStr);
+
+        /* Received responses are processed in the background. */
+        if (false == ParseWorker::getInstance().start())
+        {
+            LOG_WARNING("Parse worker not available, processing in the TCP task.");
+        }
+
+        /* Plugins may request data from servers now. */
+        FetchScheduler::getInstance().start();
     }
 
     /* Notify that Pixelix is online only if URL was set. */
@@ -166,6 +178,12 @@ void ConnectedState::process(StateMachine& sm)
     /* Handle update, there may be one in the background. */
     UpdateMgr::getInstance().process();
 
+    /* Start the due plugin requests. */
+    FetchScheduler::getInstance().process();
+
+    /* Write the data of the network plugins, received in the current session. */
+    WarmCacheWriter::getInstance().process();
+
     /* Restart requested by update manager? This may happen after a successful received
      * new firmware or filesystem binary.
      */
@@ -194,6 +212,10 @@ void ConnectedState::exit(StateMachine& sm)
 {
     UTIL_NOT_USED(sm);
 
+    /* No plugin request shall be started without connection. */
+    FetchScheduler::getInstance().stop();
+    ParseWorker::getInstance().stop();
+
     /* Disconnect all connections */
     (void)WiFi.disconnect();
 
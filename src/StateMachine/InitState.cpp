@@ -52,6 +52,7 @@
 #include "WebConfig.h"
 #include "FileSystem.h"
 #include "JsonFile.h"
+#include "JsonDocPool.h"
 #include "Version.h"
 
 #include "APState.h"
@@ -63,6 +64,7 @@
 #include <ESPmDNS.h>
 
 #include "BTCQuotePlugin.h"
+#include "CanvasPlugin.h"
 #include "CountdownPlugin.h"
 #include "DateTimePlugin.h"
 #include "FirePlugin.h"
@@ -72,6 +74,7 @@
 #include "IconTextLampPlugin.h"
 #include "IconTextPlugin.h"
 #include "JustTextPlugin.h"
+#include "LiveStreamPlugin.h"
 #include "MatrixPlugin.h"
 #include "OpenWeatherPlugin.h"
 #include "RainbowPlugin.h"
@@ -124,6 +127,12 @@ void InitState::entry(StateMachine& sm)
     /* Show as soon as possible the user on the serial console that the system is booting. */
     showStartupInfoOnSerial();
 
+    /* Reserve the JSON document memory, as long as the heap is not fragmented. */
+    if (false == JsonDocPool::getInstance().begin())
+    {
+        LOG_WARNING("JSON documents will use the heap.");
+    }
+
     /* Initialize two-wire (I2C) */
     if (false == Wire.begin())
     {
@@ -449,6 +458,7 @@ void InitState::registerPlugins()
     /* Register in alphabetic order. */
 
     pluginMgr.registerPlugin("BTCQuotePlugin", BTCQuotePlugin::create);
+    pluginMgr.registerPlugin("CanvasPlugin", CanvasPlugin::create);
     pluginMgr.registerPlugin("CountdownPlugin", CountdownPlugin::create);
     pluginMgr.registerPlugin("DateTimePlugin", DateTimePlugin::create);
     pluginMgr.registerPlugin("FirePlugin", FirePlugin::create);
@@ -458,6 +468,7 @@ void InitState::registerPlugins()
     pluginMgr.registerPlugin("IconTextLampPlugin", IconTextLampPlugin::create);
     pluginMgr.registerPlugin("IconTextPlugin", IconTextPlugin::create);
     pluginMgr.registerPlugin("JustTextPlugin", JustTextPlugin::create);
+    pluginMgr.registerPlugin("LiveStreamPlugin", LiveStreamPlugin::create);
     pluginMgr.registerPlugin("MatrixPlugin", MatrixPlugin::create);
     pluginMgr.registerPlugin("OpenWeatherPlugin", OpenWeatherPlugin::create);
     pluginMgr.registerPlugin("PacManPlugin",PacManPlugin::create);    
@@ -33,6 +33,8 @@
  * Includes
  *****************************************************************************/
 #include "AsyncHttpClient.h"
+#include "HttpConnectionPool.h"
+#include "UrlCache.h"
 
 #include <Util.h>
 #include <Logging.h>
@@ -63,8 +65,9 @@
  *****************************************************************************/
 
 AsyncHttpClient::AsyncHttpClient() :
-    m_tcpClient(),
+    m_tcpClient(nullptr),
     m_onRspCallback(nullptr),
+    m_onBodyCallback(nullptr),
     m_onClosedCallback(),
     m_onErrorCallback(),
     m_hostname(),
@@ -77,70 +80,52 @@ AsyncHttpClient::AsyncHttpClient() :
     m_method(),
     m_userAgent("AsyncHttpClient"),
     m_isHttpVer10(false),
-    m_isKeepAlive(false),
+    m_isKeepAlive(true),
+    m_isRspKeepAlive(false),
+    m_isGzipAccepted(false),
+    m_isGzipDecoded(true),
     m_urlEncodedPars(),
     m_payload(nullptr),
     m_payloadSize(0U),
-    m_rspPart(RESPONSE_PART_STATUS_LINE),
+    m_reqBuffer(),
+    m_reqSize(0U),
+    m_isReqOverflow(false),
+    m_rspParser(),
     m_rsp(),
-    m_rspLine(),
-    m_transferCoding(TRANSFER_CODING_IDENTITY),
-    m_contentLength(0U),
-    m_contentIndex(0U),
-    m_chunkSize(0U),
-    m_chunkIndex(0U),
-    m_chunkBodyPart(CHUNK_SIZE)
+    m_bodyIndex(0U),
+    m_isRspGzip(false),
+    m_isRspGzipEncoded(false),
+    m_gzipDecoder()
 {
-    m_tcpClient.onConnect(  [this](void* arg, AsyncClient* client)
-                            {
-                                UTIL_NOT_USED(arg);
-
-                                onConnect(client);
-                            });
-
-    m_tcpClient.onDisconnect(   [this](void* arg, AsyncClient* client)
-                                {
-                                    UTIL_NOT_USED(arg);
-
-                                    onDisconnect(client);
-                                });
-
-    m_tcpClient.onError(    [this](void* arg, AsyncClient* client, int8_t error)
-                            {
-                                UTIL_NOT_USED(arg);
-
-                                onError(client, error);
-                            });
-
-    m_tcpClient.onData( [this](void* arg, AsyncClient* client, void* data, size_t len)
-                        {
-                            UTIL_NOT_USED(arg);
-
-                            onData(client, static_cast<uint8_t*>(data), len);
-                        });
-
-    m_tcpClient.onTimeout(  [this](void* arg, AsyncClient* client, uint32_t timeout)
-                            {
-                                UTIL_NOT_USED(arg);
-
-                                onTimeout(client, timeout);
-                            });
 }
 
 AsyncHttpClient::~AsyncHttpClient()
 {
+    abort();
 }
 
 bool AsyncHttpClient::begin(const String& url)
 {
-    bool    status  = true;
-    int     index   = url.indexOf(':');
+    bool            status  = true;
+    int             index   = url.indexOf(':');
+    UrlCache::Url   parts;
 
     /* If a response is pending, abort. */
     if (true == m_isReqOpen)
     {
         status = false;
     }
+    /* URL parsed already? */
+    else if (true == UrlCache::getInstance().get(url, parts))
+    {
+        clear();
+
+        m_hostname              = parts.hostname;
+        m_port                  = parts.port;
+        m_isSecure              = parts.isSecure;
+        m_uri                   = parts.uri;
+        m_base64Authorization   = parts.base64Authorization;
+    }
     /* The URL must contain the protocol. */
     else if (0 > index)
     {
@@ -254,6 +239,14 @@ bool AsyncHttpClient::begin(const String& url)
                 {
                     LOG_INFO("Authorization: %s", auth.c_str());
                 }
+
+                parts.hostname              = m_hostname;
+                parts.port                  = m_port;
+                parts.isSecure              = m_isSecure;
+                parts.uri                   = m_uri;
+                parts.base64Authorization   = m_base64Authorization;
+
+                UrlCache::getInstance().add(url, parts);
             }
         }
 
@@ -274,27 +267,45 @@ void AsyncHttpClient::end()
 
 bool AsyncHttpClient::connect()
 {
-    return m_tcpClient.connect(m_hostname.c_str(), m_port, m_isSecure);
+    /* The connection pool provides a idle connection to the host, which
+     * is already connected or a new one, which is connecting.
+     */
+    if (nullptr == m_tcpClient)
+    {
+        m_tcpClient = HttpConnectionPool::getInstance().acquire(m_hostname, m_port, m_isSecure, this);
+    }
+
+    return (nullptr != m_tcpClient);
 }
 
 void AsyncHttpClient::disconnect()
 {
-    m_tcpClient.close();
+    if (nullptr != m_tcpClient)
+    {
+        m_tcpClient->close();
+    }
 }
 
 void AsyncHttpClient::abort()
 {
-    m_tcpClient.abort();
+    if (nullptr != m_tcpClient)
+    {
+        HttpConnectionPool::getInstance().abort(m_tcpClient, this);
+        m_tcpClient = nullptr;
+
+        /* No disconnect event will follow. */
+        clear();
+    }
 }
 
 bool AsyncHttpClient::isConnected()
 {
-    return m_tcpClient.connected();
+    return (nullptr != m_tcpClient) && (true == m_tcpClient->connected());
 }
 
 bool AsyncHttpClient::isDisconnected()
 {
-    return m_tcpClient.freeable();
+    return (nullptr == m_tcpClient) || (true == m_tcpClient->freeable());
 }
 
 void AsyncHttpClient::setHttpVersion(bool useHttp10)
@@ -307,6 +318,26 @@ void AsyncHttpClient::setKeepAlive(bool keepAlive)
     m_isKeepAlive = keepAlive;
 }
 
+void AsyncHttpClient::setAcceptGzip(bool acceptGzip)
+{
+    m_isGzipAccepted = acceptGzip;
+}
+
+void AsyncHttpClient::setDecodeGzip(bool decodeGzip)
+{
+    m_isGzipDecoded = decodeGzip;
+}
+
+bool AsyncHttpClient::isRspGzipEncoded() const
+{
+    return m_isRspGzipEncoded;
+}
+
+bool AsyncHttpClient::addRspHeaderFilter(const char* name)
+{
+    return m_rspParser.addHeaderFilter(name);
+}
+
 void AsyncHttpClient::addHeader(const String& name, const String& value)
 {
     /* Only add header if not handled by the client itself. */
@@ -355,6 +386,11 @@ void AsyncHttpClient::regOnResponse(const OnResponse& onResponse)
     m_onRspCallback = onResponse;
 }
 
+void AsyncHttpClient::regOnBody(const OnBody& onBody)
+{
+    m_onBodyCallback = onBody;
+}
+
 void AsyncHttpClient::regOnClosed(const OnClosed& onClosed)
 {
     m_onClosedCallback = onClosed;
@@ -375,16 +411,7 @@ bool AsyncHttpClient::GET()
         m_payload       = nullptr;
         m_payloadSize   = 0U;
 
-        if (false == isConnected())
-        {
-            status = connect();
-            m_isReqOpen = status;
-        }
-        else
-        {
-            status = sendRequest();
-            m_isReqOpen = false;
-        }
+        status = startRequest();
     }
 
     return status;
@@ -400,16 +427,7 @@ bool AsyncHttpClient::POST(const uint8_t* payload, size_t size)
         m_payload       = payload;
         m_payloadSize   = size;
 
-        if (false == isConnected())
-        {
-            status = connect();
-            m_isReqOpen = status;
-        }
-        else
-        {
-            status = sendRequest();
-            m_isReqOpen = false;
-        }
+        status = startRequest();
     }
 
     return status;
@@ -434,16 +452,7 @@ bool AsyncHttpClient::POST(const String& payload)
             m_payloadSize   = payload.length();
         }
 
-        if (false == isConnected())
-        {
-            status = connect();
-            m_isReqOpen = status;
-        }
-        else
-        {
-            status = sendRequest();
-            m_isReqOpen = false;
-        }
+        status = startRequest();
     }
 
     return status;
@@ -478,6 +487,16 @@ void AsyncHttpClient::onDisconnect(AsyncClient* client)
     UTIL_NOT_USED(client);
 
     LOG_INFO("Disconnected.");
+
+    /* The connection pool destroys the TCP client afterwards. */
+    m_tcpClient = nullptr;
+
+    /* A response body, which is delimited by the connection close, is complete now. */
+    if (true == m_rspParser.finish())
+    {
+        notifyResponse();
+    }
+
     clear();
     notifyClosed();
 }
@@ -502,103 +521,60 @@ void AsyncHttpClient::onError(AsyncClient* client, int8_t error)
 
 void AsyncHttpClient::onData(AsyncClient* client, const uint8_t* data, size_t len)
 {
-    size_t      index       = 0U;
-    const char* asciiData   = reinterpret_cast<const char*>(data);
-    bool        isError     = false;
-
-    /* RFC2616 - Response = Status-Line
-     *                      *(( general-header
-     *                       | response-header
-     *                       | entity-header ) CRLF)
-     *                CRLF
-     *                [ message-body ]
-     */
+    size_t                      index           = 0U;
+    bool                        isError         = false;
+    bool                        isRspComplete   = false;
+    HttpResponseParser::Event   event           = HttpResponseParser::EVENT_NONE;
 
     LOG_DEBUG("onData(): len = %u", len);
 
-    while((len > index) && (false == isError))
+    /* The parser works directly on the received data. Only the requested
+     * headers are copied to the response and the body parts are provided
+     * without any copy.
+     */
+    do
     {
-        switch(m_rspPart)
-        {
-        case RESPONSE_PART_STATUS_LINE:
-            if (true == parseRspStatusLine(asciiData, len, index))
-            {
-                LOG_DEBUG("Rsp. HTTP-Version: %s", m_rsp.getHttpVersion().c_str());
-                LOG_DEBUG("Rsp. Status-Code: %u", m_rsp.getStatusCode());
-                LOG_DEBUG("Rsp. Reason-Phrase: %s", m_rsp.getReasonPhrase().c_str());
+        event = m_rspParser.parse(data, len, index);
 
-                m_rspPart = RESPONSE_PART_HEADER;
-            }
+        switch(event)
+        {
+        case HttpResponseParser::EVENT_NONE:
+            /* More data required. */
             break;
 
-        case RESPONSE_PART_HEADER:
-            if (true == parseRspHeader(asciiData, len, index))
-            {
-                /* Examine response header.
-                 * This is important to determine the number of following
-                 * payload data and to know when the last data is
-                 * received.
-                 */
-                if (false == handleRspHeader())
-                {
-                    /* Not nice, but anyway. */
-                    LOG_ERROR("Header error.");
-                    client->close();
-                    isError = true;
-                }
-                else if (TRANSFER_CODING_IDENTITY == m_transferCoding)
-                {
-                    /* "Content-Length" may be missing. */
-                    if (0U == m_contentLength)
-                    {
-                        m_contentLength = len - index;
-                    }
-                }
-                m_rspPart = RESPONSE_PART_BODY;
-            }
+        case HttpResponseParser::EVENT_HEADER:
+            m_rsp.addHeader(toString(m_rspParser.getHeaderName()), toString(m_rspParser.getHeaderValue()));
             break;
 
-        case RESPONSE_PART_BODY:
-            if (TRANSFER_CODING_CHUNCKED == m_transferCoding)
+        case HttpResponseParser::EVENT_HEADERS_COMPLETE:
+            /* Examine response header.
+             * This is important to determine the number of following
+             * payload data and to know when the last data is
+             * received.
+             */
+            if (false == handleRspHeader())
             {
-                if (true == parseChunkedResponse(data, len, index))
-                {
-                    notifyResponse();
-
-                    m_transferCoding = TRANSFER_CODING_IDENTITY;
-                    m_rspPart = RESPONSE_PART_STATUS_LINE;
-                    m_rsp.clear();
-                }
+                /* Not nice, but anyway. */
+                LOG_ERROR("Header error.");
+                client->close();
+                isError = true;
             }
-            else
-            {
-                size_t available    = len - index;
-                size_t needed       = m_contentLength - m_contentIndex;
-                size_t copySize     = 0U;
-
-                if (available >= needed)
-                {
-                    copySize = needed;
-                }
-                else
-                {
-                    copySize = available;
-                }
+            break;
 
-                m_rsp.addPayload(&data[index], copySize);
-                m_contentIndex += copySize;
-                index += copySize;
+        case HttpResponseParser::EVENT_BODY:
+            handleRspBody(reinterpret_cast<const uint8_t*>(m_rspParser.getBody().data), m_rspParser.getBody().size);
+            break;
 
-                if (m_contentLength <= m_contentIndex)
-                {
-                    notifyResponse();
+        case HttpResponseParser::EVENT_COMPLETE:
+            notifyResponse();
+            m_rsp.clear();
+            isRspComplete = true;
+            break;
 
-                    m_rspPart = RESPONSE_PART_STATUS_LINE;
-                    m_rsp.clear();
-                    m_contentLength = 0U;
-                    m_contentIndex = 0U;
-                }
-            }
+        case HttpResponseParser::EVENT_ERROR:
+            LOG_ERROR("Invalid response.");
+            client->close();
+            isError = true;
             break;
 
         default:
@@ -608,6 +584,13 @@ void AsyncHttpClient::onData(AsyncClient* client, const uint8_t* data, size_t le
             break;
         }
     }
+    while((HttpResponseParser::EVENT_NONE != event) && (false == isError) && (false == isRspComplete));
+
+    if ((true == isRspComplete) &&
+        (true == m_isRspKeepAlive))
+    {
+        releaseConnection();
+    }
 }
 
 void AsyncHttpClient::onTimeout(AsyncClient* client, uint32_t timeout)
@@ -618,10 +601,38 @@ void AsyncHttpClient::onTimeout(AsyncClient* client, uint32_t timeout)
     client->close();
 }
 
+bool AsyncHttpClient::startRequest()
+{
+    bool status = false;
+
+    if (false == isConnected())
+    {
+        status = connect();
+    }
+
+    /* Already connected, e.g. a kept alive connection from the pool? */
+    if (true == isConnected())
+    {
+        status = sendRequest();
+        m_isReqOpen = false;
+
+        if (false == status)
+        {
+            m_tcpClient->close();
+        }
+    }
+    /* Send request after the connection is established. */
+    else
+    {
+        m_isReqOpen = status;
+    }
+
+    return status;
+}
+
 bool AsyncHttpClient::sendRequest()
 {
     bool        status      = false;
-    String      request;
     const char* PROTOCOL    = "HTTP";
     const char* SP          = " ";
     const char* CRLF        = "\r\n";
@@ -634,40 +645,44 @@ bool AsyncHttpClient::sendRequest()
      *            CRLF
      *            [ message-body ]
      *
+     * The request is built in the request buffer, which is reused for every
+     * request. This avoids the heap fragmentation by many string operations.
      */
+    m_reqSize       = 0U;
+    m_isReqOverflow = false;
 
     /* Request-Line: Method SP Request-URI SP HTTP-Version CRLF */
 
     /* Method */
-    request += m_method;
-    request += SP;
+    appendReq(m_method);
+    appendReq(SP);
 
     /* Request-URI    = "*" | absoluteURI | abs_path | authority */
     if (true == m_uri.isEmpty())
     {
-        request += "/";
+        appendReq("/");
     }
     else
     {
-        request += m_uri;
+        appendReq(m_uri);
     }
 
-    request += SP;
+    appendReq(SP);
 
     /* HTTP-Version */
-    request += PROTOCOL;
-    request += "/";
+    appendReq(PROTOCOL);
+    appendReq("/");
 
     if (false == m_isHttpVer10)
     {
-        request += "1.1";
+        appendReq("1.1");
     }
     else
     {
-        request += "1.0";
+        appendReq("1.0");
     }
 
-    request += CRLF;
+    appendReq(CRLF);
 
     /* --- Add now the request headers. --- */
 
@@ -675,52 +690,60 @@ bool AsyncHttpClient::sendRequest()
     /* Empty */
 
     /* RFC2616 - request-header */
-    request += "Host: ";
-    request += m_hostname;
+    appendReq("Host: ");
+    appendReq(m_hostname);
 
     if ((HTTP_PORT != m_port) &&
         (HTTPS_PORT != m_port))
     {
-        request += ":";
-        request += m_port;
+        appendReq(":");
+        appendReq(static_cast<uint32_t>(m_port));
     }
 
-    request += CRLF;
+    appendReq(CRLF);
 
-    request += "User-Agent: ";
-    request += m_userAgent;
-    request += CRLF;
+    appendReq("User-Agent: ");
+    appendReq(m_userAgent);
+    appendReq(CRLF);
 
     /* HTTP/1.1 defines the "close" connection option for the sender to
      * signal that the connection will be closed after completion of the
      * response.
      */
-    request += "Connection: ";
+    appendReq("Connection: ");
 
     if (false == m_isKeepAlive)
     {
-        request += "close";
+        appendReq("close");
     }
     else
     {
-        request += "keep-alive";
+        appendReq("keep-alive");
     }
-    request += CRLF;
+    appendReq(CRLF);
 
     if (false == m_isHttpVer10)
     {
-        /* By the client supported transfer codings. */
-        request += "Accept-Encoding: ";
-        request += "identity;q=1,chunked;q=0.1,*;q=0";
-        request += CRLF;
+        /* By the client supported content codings. */
+        appendReq("Accept-Encoding: ");
+
+        if (true == m_isGzipAccepted)
+        {
+            appendReq("gzip;q=1,identity;q=0.5,*;q=0");
+        }
+        else
+        {
+            appendReq("identity;q=1,chunked;q=0.1,*;q=0");
+        }
+        appendReq(CRLF);
     }
 
     if (0U < m_base64Authorization.length())
     {
         m_base64Authorization.replace("\n", "");
-        request += "Authorization: Basic ";
-        request += m_base64Authorization;
-        request += CRLF;
+        appendReq("Authorization: Basic ");
+        appendReq(m_base64Authorization);
+        appendReq(CRLF);
     }
 
     /* Only user defined payload can be sent or URL encoded parameters.
@@ -731,9 +754,9 @@ bool AsyncHttpClient::sendRequest()
     if ((nullptr != m_payload) &&
         (0U < m_payloadSize))
     {
-        request += "Content-Length: ";
-        request += m_payloadSize;
-        request += CRLF;
+        appendReq("Content-Length: ");
+        appendReq(static_cast<uint32_t>(m_payloadSize));
+        appendReq(CRLF);
 
         if (false == m_urlEncodedPars.isEmpty())
         {
@@ -742,33 +765,59 @@ bool AsyncHttpClient::sendRequest()
     }
     else if (false == m_urlEncodedPars.isEmpty())
     {
-        request += "Content-Type: application/x-www-form-urlencoded";
-        request += CRLF;
-        request += "Content-Length: ";
-        request += m_urlEncodedPars.length();
-        request += CRLF;
+        appendReq("Content-Type: application/x-www-form-urlencoded");
+        appendReq(CRLF);
+        appendReq("Content-Length: ");
+        appendReq(static_cast<uint32_t>(m_urlEncodedPars.length()));
+        appendReq(CRLF);
 
         m_payload       = reinterpret_cast<const uint8_t*>(m_urlEncodedPars.c_str());
         m_payloadSize   = m_urlEncodedPars.length();
     }
 
-    request += m_headers;
-    request += CRLF;
+    appendReq(m_headers);
+    appendReq(CRLF);
 
-    /* Send header */
-    status = (request.length() == m_tcpClient.write(request.c_str(), request.length()));
-
-    /* Send payload */
-    if ((true == status) &&
-        (nullptr != m_payload) &&
-        (0U < m_payloadSize))
+    if (true == m_isReqOverflow)
     {
-        status = (m_payloadSize == m_tcpClient.write(reinterpret_cast<const char*>(m_payload), m_payloadSize, 0));
+        LOG_ERROR("Request exceeds %u bytes.", REQ_BUFFER_SIZE);
+    }
+    else
+    {
+        /* Send header, the TCP client copies it. */
+        status = (m_reqSize == m_tcpClient->write(m_reqBuffer, m_reqSize));
+
+        /* Send payload */
+        if ((true == status) &&
+            (nullptr != m_payload) &&
+            (0U < m_payloadSize))
+        {
+            status = (m_payloadSize == m_tcpClient->write(reinterpret_cast<const char*>(m_payload), m_payloadSize, 0));
+        }
     }
 
     return status;
 }
 
+void AsyncHttpClient::releaseConnection()
+{
+    AsyncClient* client = m_tcpClient;
+
+    if (true == HttpConnectionPool::getInstance().release(client))
+    {
+        /* The connection is kept alive by the pool for the next request.
+         * For the user the connection is closed.
+         */
+        m_tcpClient = nullptr;
+        clear();
+        notifyClosed();
+    }
+    else
+    {
+        client->close();
+    }
+}
+
 void AsyncHttpClient::clear()
 {
     m_hostname.clear();
@@ -779,360 +828,176 @@ void AsyncHttpClient::clear()
     m_urlEncodedPars.clear();
 
     m_isReqOpen = false;
+    m_isRspKeepAlive = false;
 
-    m_rspPart = RESPONSE_PART_STATUS_LINE;
+    m_rspParser.reset();
     m_rsp.clear();
-    m_rspLine.clear();
-    m_transferCoding = TRANSFER_CODING_IDENTITY;
-    m_contentLength = 0U;
-    m_contentIndex = 0U;
-    m_chunkSize = 0U;
-    m_chunkIndex = 0U;
-    m_chunkBodyPart = CHUNK_SIZE;
+    m_bodyIndex = 0U;
+    m_isRspGzip = false;
+    m_isRspGzipEncoded = false;
+    m_gzipDecoder.release();
 
     return;
 }
 
-bool AsyncHttpClient::isEOL(const String& str, size_t& len)
-{
-    bool        isEOL               = false;
-    const char  TERMINATOR_LF[]     = "\n";
-    const char  TERMINATOR_CRLF[]   = "\r\n";
-
-    len = 0U;
-
-    /* RFC7230 - 3.5. Message Parsing Robustness
-     * Although the line terminator for the start-line and header fields is
-     * the sequence CRLF, a recipient MAY recognize a single LF as a line
-     * terminator and ignore any preceding CR.
-     */
-    if (0U != str.endsWith(TERMINATOR_LF))
-    {
-        isEOL = true;
-
-        if (0U != str.endsWith(TERMINATOR_CRLF))
-        {
-            len = 2U;
-        }
-        else
-        {
-            len = 1U;
-        }
-    }
-
-    return isEOL;
-}
-
-bool AsyncHttpClient::handleRspHeader()
+void AsyncHttpClient::appendReq(const char* str, size_t len)
 {
-    bool    isSuccess = true;
-    String  value;
-
-    /* Connection = "Connection" ":" 1#(connection-token)
-     * connection-token = token
-     *
-     * HTTP/1.1 defines the "close" connection option for the sender to
-     * signal that the connection will be closed after completion of the
-     * response.
-     */
-    value = m_rsp.getHeader("Connection");
-
-    if (false == value.isEmpty())
-    {
-        /* Server closes the connection after the response? */
-        if (0 <= value.indexOf("close"))
-        {
-            /* Client want a permanent connection? */
-            if (true == m_isKeepAlive)
-            {
-                LOG_WARNING("Connection can not be kept-alive.");
-                m_isKeepAlive = false;
-            }
-        }
-    }
-
-    value = m_rsp.getHeader("Content-Length");
-
-    if (false == value.isEmpty())
+    if ((REQ_BUFFER_SIZE - m_reqSize) < len)
     {
-        m_contentLength = value.toInt();
+        m_isReqOverflow = true;
     }
     else
     {
-        m_contentLength = 0U;
-    }
-
-    value = m_rsp.getHeader("Transfer-Encoding");
-
-    if (false == value.isEmpty())
-    {
-        /* Only IDENTITY (default) and CHUNKED transfer coding are supported. */
-        if (0U != value.equalsIgnoreCase("chunked"))
-        {
-            m_transferCoding = TRANSFER_CODING_CHUNCKED;
-        }
-        /* Unsupported transfer coding */
-        else
-        {
-            isSuccess = false;
-        }
+        memcpy(&m_reqBuffer[m_reqSize], str, len);
+        m_reqSize += len;
     }
-
-    return isSuccess;
 }
 
-bool AsyncHttpClient::parseChunkedResponseSize(const char* data, size_t len, size_t& index)
+void AsyncHttpClient::appendReq(const char* str)
 {
-    bool isSizeEOF = false;
-
-    while((len > index) && (false == isSizeEOF))
-    {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            m_rspLine.remove(m_rspLine.length() - terminatorLen);
-            m_chunkSize = Util::hexToUInt32(m_rspLine);
-
-            LOG_INFO("Chunk size is %u byte.", m_chunkSize);
-
-            m_rspLine.clear();
-            isSizeEOF = true;
-        }
-    }
-
-    return isSizeEOF;
+    appendReq(str, strlen(str));
 }
 
-bool AsyncHttpClient::parseChunkedResponseChunkData(const uint8_t* data, size_t len, size_t& index)
+void AsyncHttpClient::appendReq(const String& str)
 {
-    size_t  available   = len - index;
-    size_t  needed      = m_chunkSize - m_chunkIndex;
-    size_t  copySize    = 0U;
-    bool    isDataEOF   = false;
-
-    if (available >= needed)
-    {
-        copySize = needed;
-    }
-    else
-    {
-        copySize = available;
-    }
-
-    m_rsp.addPayload(&data[index], copySize);
-    index += copySize;
-    m_chunkIndex += copySize;
-
-    if (m_chunkSize <= m_chunkIndex)
-    {
-        m_chunkIndex = 0U;
-        isDataEOF = true;
-    }
-
-    return isDataEOF;
+    appendReq(str.c_str(), str.length());
 }
 
-bool AsyncHttpClient::parseChunkedResponseChunkDataEnd(const char* data, size_t len, size_t& index)
+void AsyncHttpClient::appendReq(uint32_t value)
 {
-    bool isDataEOF = false;
+    char    digits[10];
+    size_t  idx         = sizeof(digits);
 
-    while((len > index) && (false == isDataEOF))
+    /* Digits are determined from right to left. */
+    do
     {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            m_rspLine.clear();
-            isDataEOF = true;
-        }
+        --idx;
+        digits[idx] = static_cast<char>('0' + (value % 10U));
+        value /= 10U;
     }
+    while ((0U < value) && (0U < idx));
 
-    return isDataEOF;
+    appendReq(&digits[idx], sizeof(digits) - idx);
 }
 
-bool AsyncHttpClient::parseChunkedResponseTrailer(const char* data, size_t len, size_t& index)
+bool AsyncHttpClient::handleRspHeader()
 {
-    bool isTrailerEOF = false;
-
-    while((len > index) && (false == isTrailerEOF))
-    {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            if (terminatorLen < m_rspLine.length())
-            {
-                m_rspLine.remove(m_rspLine.length() - terminatorLen);
-
-                LOG_DEBUG("Rsp. trailer: %s", m_rspLine.c_str());
-            }
-            else
-            {
-                LOG_DEBUG("Rsp. chunked transfer finished.");
+    bool    isSuccess   = true;
+    String  httpVersion = "HTTP/1.";
 
-                isTrailerEOF = true;
-            }
+    httpVersion += m_rspParser.getMinorVersion();
+    m_rsp.setStatusLine(httpVersion, m_rspParser.getStatusCode(), m_rspParser.getReasonPhrase());
 
-            m_rspLine.clear();
-        }
-    }
-
-    return isTrailerEOF;
-}
+    LOG_DEBUG("Rsp. HTTP-Version: %s", m_rsp.getHttpVersion().c_str());
+    LOG_DEBUG("Rsp. Status-Code: %u", m_rsp.getStatusCode());
+    LOG_DEBUG("Rsp. Reason-Phrase: %s", m_rsp.getReasonPhrase().c_str());
 
-bool AsyncHttpClient::parseChunkedResponse(const uint8_t* data, size_t len, size_t& index)
-{
-    const char* asciiData   = reinterpret_cast<const char*>(data);
-    bool        isChunkEOF  = false;
-
-    /*
-     * Chunked-Body   = *chunk
-     *                 last-chunk
-     *                 trailer
-     *                 CRLF
-     *
-     * chunk          = chunk-size [ chunk-extension ] CRLF
-     *                 chunk-data CRLF
-     * chunk-size     = 1*HEX
-     * last-chunk     = 1*("0") [ chunk-extension ] CRLF
-     *
-     * chunk-extension= *( ";" chunk-ext-name [ "=" chunk-ext-val ] )
-     * chunk-ext-name = token
-     * chunk-ext-val  = token | quoted-string
-     * chunk-data     = chunk-size(OCTET)
-     * trailer        = *(entity-header CRLF)
+    /* The parser considers the "Connection" header, the HTTP version and
+     * whether the body is delimited by closing the connection.
      */
+    m_isRspKeepAlive    = (true == m_isKeepAlive) && (true == m_rspParser.isKeepAlive());
+    m_isRspGzip         = false;
+    m_isRspGzipEncoded  = false;
+    m_bodyIndex         = 0U;
 
-    while((len > index) && (false == isChunkEOF))
+    if (true == m_rspParser.hasBody())
     {
-        switch(m_chunkBodyPart)
+        switch(m_rspParser.getContentCoding())
         {
-        /* Handle chunk or last-chunk size */
-        case CHUNK_SIZE:
-            if (true == parseChunkedResponseSize(asciiData, len, index))
-            {
-                if (0U == m_chunkSize)
-                {
-                    m_chunkBodyPart = TRAILER;
-                }
-                else
-                {
-                    m_chunkBodyPart = CHUNK_DATA;
-
-                    /* Extend response payload */
-                    m_rsp.extendPayload(m_chunkSize);
-                }
-            }
+        case HttpResponseParser::CONTENT_CODING_IDENTITY:
             break;
 
-        /* Handle chunk data */
-        case CHUNK_DATA:
-            if (true == parseChunkedResponseChunkData(data, len, index))
+        case HttpResponseParser::CONTENT_CODING_GZIP:
+            if (false == m_isGzipAccepted)
             {
-                m_chunkBodyPart = CHUNK_DATA_END;
+                LOG_ERROR("Unrequested gzip content encoding.");
+                isSuccess = false;
             }
-            break;
-
-        /* Handle chunk data end (CRLF) */
-        case CHUNK_DATA_END:
-            if (true == parseChunkedResponseChunkDataEnd(asciiData, len, index))
+            else if (true == m_isGzipDecoded)
             {
-                m_chunkBodyPart = CHUNK_SIZE;
+                m_isRspGzip = true;
+                m_gzipDecoder.reset();
             }
-            break;
-
-        /* Handle trailer and CRLF */
-        case TRAILER:
-            if (true == parseChunkedResponseTrailer(asciiData, len, index))
+            else
             {
-                m_chunkBodyPart = CHUNK_SIZE;
-                isChunkEOF = true;
+                m_isRspGzipEncoded = true;
             }
             break;
 
+        case HttpResponseParser::CONTENT_CODING_UNSUPPORTED:
         default:
-            LOG_FATAL("Should never happen.");
+            LOG_ERROR("Unsupported content encoding.");
+            isSuccess = false;
             break;
         }
+
+        /* Payload size is known, allocate it at once. */
+        if ((true == isSuccess) &&
+            (nullptr == m_onBodyCallback) &&
+            (0U < m_rspParser.getContentLength()))
+        {
+            m_rsp.extendPayload(m_rspParser.getContentLength());
+        }
     }
 
-    return isChunkEOF;
+    return isSuccess;
 }
 
-bool AsyncHttpClient::parseRspStatusLine(const char* data, size_t len, size_t& index)
+void AsyncHttpClient::notifyResponse()
 {
-    bool isStatusLineEOF = false;
-
-    while((len > index) && (false == isStatusLineEOF))
+    /* A body, which is not completely decoded, is invalid. */
+    if ((true == m_isRspGzip) &&
+        (false == m_gzipDecoder.isComplete()))
     {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            m_rspLine.remove(m_rspLine.length() - terminatorLen);
-
-            m_rsp.addStatusLine(m_rspLine);
+        LOG_ERROR("Response body decoding failed.");
 
-            isStatusLineEOF = true;
-            m_rspLine.clear();
-        }
+        m_isRspKeepAlive = false;
+        notifyError();
+        disconnect();
+    }
+    else if (nullptr != m_onRspCallback)
+    {
+        m_onRspCallback(m_rsp);
     }
 
-    return isStatusLineEOF;
+    /* Release the window until the next encoded response. */
+    if (true == m_isRspGzip)
+    {
+        m_gzipDecoder.release();
+        m_isRspGzip = false;
+    }
 }
 
-bool AsyncHttpClient::parseRspHeader(const char* data, size_t len, size_t& index)
+void AsyncHttpClient::handleRspBody(const uint8_t* data, size_t size)
 {
-    bool isHeaderEOF = false;
-
-    while((len > index) && (false == isHeaderEOF))
+    if (false == m_isRspGzip)
     {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            if (terminatorLen < m_rspLine.length())
-            {
-                m_rspLine.remove(m_rspLine.length() - terminatorLen);
-
-                LOG_DEBUG("Rsp. header: %s", m_rspLine.c_str());
-
-                m_rsp.addHeader(m_rspLine);
-            }
-            else
+        handleDecodedRspBody(data, size);
+    }
+    /* After a decoding error, the rest of the body is discarded. */
+    else if (false == m_gzipDecoder.isError())
+    {
+        (void)m_gzipDecoder.decode(data, size,
+            [this](const uint8_t* decodedData, size_t decodedSize)
             {
-                isHeaderEOF = true;
+                this->handleDecodedRspBody(decodedData, decodedSize);
             }
-
-            m_rspLine.clear();
-        }
+        );
     }
-
-    return isHeaderEOF;
 }
 
-void AsyncHttpClient::notifyResponse()
+void AsyncHttpClient::handleDecodedRspBody(const uint8_t* data, size_t size)
 {
-    if (nullptr != m_onRspCallback)
+    if (nullptr != m_onBodyCallback)
     {
-        m_onRspCallback(m_rsp);
+        m_onBodyCallback(data, size, m_bodyIndex);
     }
+    else
+    {
+        m_rsp.addPayload(data, size);
+    }
+
+    m_bodyIndex += size;
 }
 
 void AsyncHttpClient::notifyClosed()
@@ -1285,6 +1150,23 @@ const char* AsyncHttpClient::errorToStr(int8_t error)
     return errorDescription;
 }
 
+String AsyncHttpClient::toString(const HttpResponseParser::Span& span)
+{
+    String  str;
+    size_t  idx = 0U;
+
+    if (0U != str.reserve(span.size))
+    {
+        while (span.size > idx)
+        {
+            str += span.data[idx];
+            ++idx;
+        }
+    }
+
+    return str;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -48,6 +48,9 @@
 
 #include "HttpResponse.h"
 
+#include <GzipDecoder.h>
+#include <HttpResponseParser.h>
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -72,6 +75,16 @@ public:
      */
     typedef std::function<void(const HttpResponse& rsp)> OnResponse;
 
+    /**
+     * Prototype of HTTP response callback for a part of the response body.
+     * The body is already decoded from the chunked transfer coding.
+     *
+     * @param[in] data  Body part
+     * @param[in] size  Body part size in byte
+     * @param[in] index Index of the body part in the body. 0 means a new body starts.
+     */
+    typedef std::function<void(const uint8_t* data, size_t size, size_t index)> OnBody;
+
     /**
      * Prototype of HTTP response callback for a closed connection.
      */
@@ -147,11 +160,57 @@ public:
 
     /**
      * Keep connection alive or close it after a request.
+     * A connection, which is kept alive, is released to the connection pool
+     * after the response and may be used by the next request to the same
+     * host. For the user it looks like the connection was closed.
+     * Default is to keep the connection alive.
      *
      * @param[in] keepAlive Keep alive (true) or close (false) it.
      */
     void setKeepAlive(bool keepAlive);
 
+    /**
+     * Accept gzip content encoding of the response body or not.
+     * A gzip encoded body is decoded transparently, the application gets
+     * the decoded body only. During decoding the sliding window of
+     * GzipDecoder::MAX_WINDOW_SIZE is allocated.
+     * Default is to accept only the identity encoding.
+     *
+     * @param[in] acceptGzip    Accept gzip (true) or not (false).
+     */
+    void setAcceptGzip(bool acceptGzip);
+
+    /**
+     * Decode a gzip encoded response body or provide it as received.
+     * If not decoded, the application decodes it, e.g. outside the TCP
+     * task. Use isRspGzipEncoded() to distinguish the encoding.
+     * Default is to decode it.
+     *
+     * @param[in] decodeGzip    Decode gzip (true) or not (false).
+     */
+    void setDecodeGzip(bool decodeGzip);
+
+    /**
+     * Is the body of the current response provided gzip encoded?
+     * It is only valid in the body and the response callback.
+     *
+     * @return If the body is gzip encoded, it will return true otherwise false.
+     */
+    bool isRspGzipEncoded() const;
+
+    /**
+     * Request a response header, which shall be available in the response.
+     * Only requested headers are copied from the received data to the
+     * response, all others are skipped. The headers are kept for all
+     * further requests. Max. HttpResponseParser::MAX_HEADER_FILTERS
+     * headers can be requested.
+     *
+     * @param[in] name  Header name, which must be valid during the client lifetime, e.g. a string literal.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool addRspHeaderFilter(const char* name);
+
     /**
      * Add header to request header.
      *
@@ -189,6 +248,16 @@ public:
      */
     void regOnResponse(const OnResponse& onResponse);
 
+    /**
+     * Register callback function, which consumes the response body part by
+     * part, as soon as it is received. If registered, the response body is
+     * not stored in the response and the response provided to the response
+     * callback has no payload.
+     *
+     * @param[in] onBody    Callback
+     */
+    void regOnBody(const OnBody& onBody);
+
     /**
      * Register callback function on closed connection.
      *
@@ -231,74 +300,54 @@ public:
 
 private:
 
-    /**
-     * HTTP response parts.
-     */
-    enum ResponsePart
-    {
-        RESPONSE_PART_STATUS_LINE = 0,  /**< Response status line */
-        RESPONSE_PART_HEADER,           /**< Response headers */
-        RESPONSE_PART_BODY              /**< Response body */
-    };
-
-    /**
-     * Supported HTTP transfer codings
-     */
-    enum TransferCoding
-    {
-        TRANSFER_CODING_IDENTITY = 0,   /**< Identity */
-        TRANSFER_CODING_CHUNCKED        /**< Chunked */
-    };
-
-    /**
-     * Chunk body parts
-     */
-    enum ChunkBodyPart
-    {
-        CHUNK_SIZE = 0, /**< Chunk or last chunk size */
-        CHUNK_DATA,     /**< Chunk data */
-        CHUNK_DATA_END, /**< Chunk data end */
-        TRAILER         /**< Trailer */
-    };
-
     /** HTTP port */
-    static const uint16_t   HTTP_PORT   = 80U;
+    static const uint16_t   HTTP_PORT       = 80U;
 
     /** HTTPS port */
-    static const uint16_t   HTTPS_PORT  = 443U;
-
-    AsyncClient     m_tcpClient;            /**< Asynchronous TCP client */
-    OnResponse      m_onRspCallback;        /**< Callback which to call for a complete response. */
-    OnClosed        m_onClosedCallback;     /**< Callback which to call for a closed connection. */
-    OnError         m_onErrorCallback;      /**< Callback which to call for a connection error. */
-    String          m_hostname;             /**< Server hostname */
-    uint16_t        m_port;                 /**< Server port */
-    bool            m_isSecure;             /**< Secure transport (true) or not (false) */
-    String          m_base64Authorization;  /**< Authorization BASE64 encoded */
-    String          m_uri;                  /**< Request URI */
-    String          m_headers;              /**< Additional request headers */
-    bool            m_isReqOpen;            /**< Is a request open? */
-    String          m_method;               /**< Request method, e.g. GET, PUT, etc. */
-    String          m_userAgent;            /**< User agent */
-    bool            m_isHttpVer10;          /**< Use HTTP/1.0 (true) instead of HTTP/1.1 (false) */
-    bool            m_isKeepAlive;          /**< Keep connection alive or not? */
-    String          m_urlEncodedPars;       /**< URL encoded paramters (application/x-www-form-urlencoded) */
-    const uint8_t*  m_payload;              /**< Request payload */
-    size_t          m_payloadSize;          /**< Request payload size in byte */
-
-    ResponsePart    m_rspPart;              /**< Current parsing part of the response */
-    HttpResponse    m_rsp;                  /**< Response */
-    String          m_rspLine;              /**< Single line, used for response parsing */
-    TransferCoding  m_transferCoding;       /**< Transfer coding */
-    size_t          m_contentLength;        /**< Content length in byte */
-    size_t          m_contentIndex;         /**< Content index */
-    size_t          m_chunkSize;            /**< Chunk size in byte */
-    size_t          m_chunkIndex;           /**< Chunk body index */
-    ChunkBodyPart   m_chunkBodyPart;        /**< Current part of chunked response */
+    static const uint16_t   HTTPS_PORT      = 443U;
+
+    /** Request buffer size in byte, which is sufficient for request line and headers. */
+    static const size_t     REQ_BUFFER_SIZE = 1024U;
+
+    AsyncClient*        m_tcpClient;                   /**< Asynchronous TCP client, provided by the connection pool. */
+    OnResponse          m_onRspCallback;               /**< Callback which to call for a complete response. */
+    OnBody              m_onBodyCallback;              /**< Callback which to call for every response body part. */
+    OnClosed            m_onClosedCallback;            /**< Callback which to call for a closed connection. */
+    OnError             m_onErrorCallback;             /**< Callback which to call for a connection error. */
+    String              m_hostname;                    /**< Server hostname */
+    uint16_t            m_port;                        /**< Server port */
+    bool                m_isSecure;                    /**< Secure transport (true) or not (false) */
+    String              m_base64Authorization;         /**< Authorization BASE64 encoded */
+    String              m_uri;                         /**< Request URI */
+    String              m_headers;                     /**< Additional request headers */
+    bool                m_isReqOpen;                   /**< Is a request open? */
+    String              m_method;                      /**< Request method, e.g. GET, PUT, etc. */
+    String              m_userAgent;                   /**< User agent */
+    bool                m_isHttpVer10;                 /**< Use HTTP/1.0 (true) instead of HTTP/1.1 (false) */
+    bool                m_isKeepAlive;                 /**< Keep connection alive or not? */
+    bool                m_isRspKeepAlive;              /**< Keep connection alive after the current response? */
+    bool                m_isGzipAccepted;              /**< Is gzip content encoding accepted? */
+    bool                m_isGzipDecoded;               /**< Is a gzip encoded body decoded? */
+    String              m_urlEncodedPars;              /**< URL encoded paramters (application/x-www-form-urlencoded) */
+    const uint8_t*      m_payload;                     /**< Request payload */
+    size_t              m_payloadSize;                 /**< Request payload size in byte */
+    char                m_reqBuffer[REQ_BUFFER_SIZE];  /**< Request line and headers, reused for every request */
+    size_t              m_reqSize;                     /**< Request size in the buffer in byte */
+    bool                m_isReqOverflow;               /**< Did the request exceed the request buffer? */
+
+    HttpResponseParser  m_rspParser;                   /**< Parses the response directly in the received data. */
+    HttpResponse        m_rsp;                         /**< Response */
+    size_t              m_bodyIndex;                   /**< Response body index */
+    bool                m_isRspGzip;                   /**< Is the response body gzip encoded and decoded? */
+    bool                m_isRspGzipEncoded;            /**< Is the response body provided gzip encoded? */
+    GzipDecoder         m_gzipDecoder;                 /**< Decoder for a gzip encoded response body */
 
     AsyncHttpClient(const AsyncHttpClient& client);
     AsyncHttpClient& operator=(const AsyncHttpClient& client);
 
+    /* The connection pool forwards the TCP client events. */
+    friend class HttpConnectionPool;
+
     /**
      * This method is called by the TCP client if a connection is successful established.
      *
@@ -338,6 +387,14 @@ private:
      */
     void onTimeout(AsyncClient* client, uint32_t timeout);
 
+    /**
+     * Send request to host. If not connected, the request will be sent
+     * after the connection is established.
+     *
+     * @return If request is successful sent or queued, it will return true otherwise false.
+     */
+    bool startRequest();
+
     /**
      * Send request to host.
      *
@@ -346,110 +403,78 @@ private:
     bool sendRequest();
 
     /**
-     * Clear all server related parameters.
+     * Release the connection to the connection pool after a complete
+     * response, which allows to keep the connection alive.
      */
-    void clear();
+    void releaseConnection();
 
     /**
-     * Is line terminator detected?
-     *
-     * @param[in]   str String
-     * @param[out]  len Length of terminator
-     *
-     * @return If line terminator detected, it will return true otherwise false.
+     * Clear all server related parameters.
      */
-    bool isEOL(const String& str, size_t& len);
+    void clear();
 
     /**
-     * Handle response header.
+     * Append characters to the request in the request buffer.
+     * If the buffer is too small, the request is marked as overflowed.
      *
-     * @return If client is fine with the resposne header, it will return true otherwise false.
+     * @param[in] str   Characters
+     * @param[in] len   Number of characters
      */
-    bool handleRspHeader();
+    void appendReq(const char* str, size_t len);
 
     /**
-     * Parse response chunked transfer chunk size.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
+     * Append a null-terminated string to the request in the request buffer.
      *
-     * @return If complete parsed, it will return true otherwise false.
+     * @param[in] str   String
      */
-    bool parseChunkedResponseSize(const char* data, size_t len, size_t& index);
+    void appendReq(const char* str);
 
     /**
-     * Parse response chunked transfer chunk data.
+     * Append a string to the request in the request buffer.
      *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
-     *
-     * @return If complete parsed, it will return true otherwise false.
+     * @param[in] str   String
      */
-    bool parseChunkedResponseChunkData(const uint8_t* data, size_t len, size_t& index);
+    void appendReq(const String& str);
 
     /**
-     * Parse response chunked transfer chunk data end.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
+     * Append a unsigned number in decimal format to the request in the request buffer.
      *
-     * @return If complete parsed, it will return true otherwise false.
+     * @param[in] value Number
      */
-    bool parseChunkedResponseChunkDataEnd(const char* data, size_t len, size_t& index);
+    void appendReq(uint32_t value);
 
     /**
-     * Parse response chunked transfer trailer.
+     * Handle response status line and header, after they are parsed
+     * completely.
      *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
-     *
-     * @return If complete parsed, it will return true otherwise false.
+     * @return If client is fine with the response header, it will return true otherwise false.
      */
-    bool parseChunkedResponseTrailer(const char* data, size_t len, size_t& index);
+    bool handleRspHeader();
 
     /**
-     * Parse response chunked transfer.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
-     *
-     * @return If chunked transfer is finished, it will return true otherwise false.
+     * This method will be called for every complete response and provides
+     * it to the application, depended on whether a application callback
+     * function is registered or not.
      */
-    bool parseChunkedResponse(const uint8_t* data, size_t len, size_t& index);
+    void notifyResponse();
 
     /**
-     * Parse response status line.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
+     * Handle a part of the response body. If its content is encoded, it
+     * will be decoded first.
      *
-     * @return If status line is parsed, it will return true otherwise false.
+     * @param[in] data  Body part
+     * @param[in] size  Body part size in byte
      */
-    bool parseRspStatusLine(const char* data, size_t len, size_t& index);
+    void handleRspBody(const uint8_t* data, size_t size);
 
     /**
-     * Parse response header.
+     * Handle a part of the decoded response body. Either it is provided to the
+     * application body callback or it is stored in the response.
      *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
-     *
-     * @return If all headers are parsed, it will return true otherwise false.
-     */
-    bool parseRspHeader(const char* data, size_t len, size_t& index);
-
-    /**
-     * This method will be called for every complete response and provides
-     * it to the application, depended on whether a application callback
-     * function is registered or not.
+     * @param[in] data  Decoded body part
+     * @param[in] size  Decoded body part size in byte
      */
-    void notifyResponse();
+    void handleDecodedRspBody(const uint8_t* data, size_t size);
 
     /**
      * This method will be called for a closed connection and notifies the
@@ -482,6 +507,15 @@ private:
      * @return User friendly error information. May be nullptr in case of unknown error id.
      */
     const char* errorToStr(int8_t error);
+
+    /**
+     * Copy a span of the received data to a string.
+     *
+     * @param[in] span  Span
+     *
+     * @return String
+     */
+    static String toString(const HttpResponseParser::Span& span);
 };
 
 /******************************************************************************
@@ -0,0 +1,359 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display mirror
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DisplayMirror.h"
+#include "DisplayMgr.h"
+
+#include <Display.h>
+#include <Logging.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool DisplayMirror::subscribe(uint32_t clientId, uint8_t fps)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    Subscriber*                 subscriber      = nullptr;
+    uint8_t                     idx             = 0U;
+    bool                        isSuccessful    = false;
+
+    if ((0U == fps) ||
+        (MAX_FPS < fps))
+    {
+        return false;
+    }
+
+    /* Already subscribed? */
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        if ((true == m_subscribers[idx].isUsed) &&
+            (clientId == m_subscribers[idx].clientId))
+        {
+            subscriber = &m_subscribers[idx];
+            break;
+        }
+    }
+
+    if ((nullptr == subscriber) &&
+        (true == allocateBuffers()))
+    {
+        for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+        {
+            if (false == m_subscribers[idx].isUsed)
+            {
+                subscriber = &m_subscribers[idx];
+
+                subscriber->isUsed      = true;
+                subscriber->clientId    = clientId;
+                subscriber->isSynced    = false;
+                subscriber->frameId     = 0U;
+                ++m_subscriberCnt;
+
+                LOG_INFO("Client %u subscribed to display mirror.", clientId);
+                break;
+            }
+        }
+
+        /* No free entry? */
+        if ((nullptr == subscriber) &&
+            (0U == m_subscriberCnt))
+        {
+            releaseBuffers();
+        }
+    }
+
+    if (nullptr != subscriber)
+    {
+        const uint32_t  MS_PER_S    = 1000U;
+        uint32_t        period      = MS_PER_S / fps;
+
+        /* Send the first frame immediately. */
+        subscriber->period      = period;
+        subscriber->lastSent    = millis() - period;
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void DisplayMirror::unsubscribe(uint32_t clientId)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint8_t                     idx     = 0U;
+
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        if ((true == m_subscribers[idx].isUsed) &&
+            (clientId == m_subscribers[idx].clientId))
+        {
+            remove(m_subscribers[idx]);
+
+            LOG_INFO("Client %u unsubscribed from display mirror.", clientId);
+            break;
+        }
+    }
+
+    return;
+}
+
+void DisplayMirror::process(AsyncWebSocket& server)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint32_t                    timestamp   = millis();
+    bool                        isAnyDue    = false;
+    uint8_t                     idx         = 0U;
+
+    if (0U == m_subscriberCnt)
+    {
+        return;
+    }
+
+    /* Remove the subscribers, which are gone and check whether anyone is due. */
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        Subscriber& subscriber = m_subscribers[idx];
+
+        if (true == subscriber.isUsed)
+        {
+            if (nullptr == server.client(subscriber.clientId))
+            {
+                remove(subscriber);
+            }
+            else if (subscriber.period <= (timestamp - subscriber.lastSent))
+            {
+                isAnyDue = true;
+            }
+            else
+            {
+                ;
+            }
+        }
+    }
+
+    if (true == isAnyDue)
+    {
+        IDisplay&               display         = Display::getInstance();
+        uint8_t                 slotId          = DisplayMgr::SLOT_ID_INVALID;
+        DisplayFrame::FrameInfo info            = { COLOR_FORMAT, DisplayFrame::SOURCE_MIRROR, 0U, display.getWidth(), display.getHeight() };
+        uint32_t                prevFrameId     = m_frameId;
+        size_t                  keyFrameSize    = 0U;
+        size_t                  deltaFrameSize  = 0U;
+
+        DisplayMgr::getInstance().getFBCopy(m_framebuffer, m_length, &slotId);
+        info.slotId = slotId;
+
+        /* Encode only a changed frame and only once for all subscribers. */
+        if ((false == m_isReferenceValid) ||
+            (slotId != m_slotId) ||
+            (0 != memcmp(m_framebuffer, m_reference, m_length * sizeof(uint32_t))))
+        {
+            if (true == m_isReferenceValid)
+            {
+                deltaFrameSize = DisplayFrame::encodeDeltaFrame(m_deltaFrame, m_frameSize, info, m_framebuffer, m_reference);
+            }
+
+            (void)memcpy(m_reference, m_framebuffer, m_length * sizeof(uint32_t));
+            m_isReferenceValid  = true;
+            m_slotId            = slotId;
+            ++m_frameId;
+        }
+
+        for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+        {
+            Subscriber&             subscriber  = m_subscribers[idx];
+            AsyncWebSocketClient*   client      = nullptr;
+
+            if ((false == subscriber.isUsed) ||
+                (subscriber.period > (timestamp - subscriber.lastSent)))
+            {
+                continue;
+            }
+
+            client              = server.client(subscriber.clientId);
+            subscriber.lastSent = timestamp;
+
+            /* Nothing new or client is too slow? */
+            if ((nullptr == client) ||
+                ((true == subscriber.isSynced) && (m_frameId == subscriber.frameId)) ||
+                (false == client->canSend()))
+            {
+                continue;
+            }
+
+            /* A delta frame is only possible, if the client received the previous frame. */
+            if ((true == subscriber.isSynced) &&
+                (prevFrameId == subscriber.frameId) &&
+                (0U < deltaFrameSize))
+            {
+                server.binary(subscriber.clientId, m_deltaFrame, deltaFrameSize);
+            }
+            else
+            {
+                /* The key frame is encoded at most once per cycle and only if any subscriber needs it. */
+                if (0U == keyFrameSize)
+                {
+                    keyFrameSize = DisplayFrame::encodeKeyFrame(m_keyFrame, info, m_reference);
+                }
+
+                server.binary(subscriber.clientId, m_keyFrame, keyFrameSize);
+            }
+
+            subscriber.isSynced = true;
+            subscriber.frameId  = m_frameId;
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool DisplayMirror::allocateBuffers()
+{
+    bool isSuccessful = true;
+
+    if (nullptr == m_framebuffer)
+    {
+        IDisplay&               display = Display::getInstance();
+        DisplayFrame::FrameInfo info    = { COLOR_FORMAT, DisplayFrame::SOURCE_MIRROR, 0U, display.getWidth(), display.getHeight() };
+
+        m_length        = static_cast<size_t>(display.getWidth()) * display.getHeight();
+        m_frameSize     = DisplayFrame::getMaxFrameSize(info);
+        m_framebuffer   = new(std::nothrow) uint32_t[m_length];
+        m_reference     = new(std::nothrow) uint32_t[m_length];
+        m_keyFrame      = new(std::nothrow) uint8_t[m_frameSize];
+        m_deltaFrame    = new(std::nothrow) uint8_t[m_frameSize];
+
+        if ((nullptr == m_framebuffer) ||
+            (nullptr == m_reference) ||
+            (nullptr == m_keyFrame) ||
+            (nullptr == m_deltaFrame))
+        {
+            LOG_ERROR("Not enough memory for display mirror.");
+
+            releaseBuffers();
+            isSuccessful = false;
+        }
+
+        m_isReferenceValid = false;
+    }
+
+    return isSuccessful;
+}
+
+void DisplayMirror::releaseBuffers()
+{
+    if (nullptr != m_framebuffer)
+    {
+        delete[] m_framebuffer;
+        m_framebuffer = nullptr;
+    }
+
+    if (nullptr != m_reference)
+    {
+        delete[] m_reference;
+        m_reference = nullptr;
+    }
+
+    if (nullptr != m_keyFrame)
+    {
+        delete[] m_keyFrame;
+        m_keyFrame = nullptr;
+    }
+
+    if (nullptr != m_deltaFrame)
+    {
+        delete[] m_deltaFrame;
+        m_deltaFrame = nullptr;
+    }
+
+    m_isReferenceValid = false;
+
+    return;
+}
+
+void DisplayMirror::remove(Subscriber& subscriber)
+{
+    subscriber.isUsed = false;
+
+    if (0U < m_subscriberCnt)
+    {
+        --m_subscriberCnt;
+
+        if (0U == m_subscriberCnt)
+        {
+            releaseBuffers();
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,215 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display mirror
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __DISPLAY_MIRROR_H__
+#define __DISPLAY_MIRROR_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+#include <Mutex.hpp>
+#include <DisplayFrame.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The display mirror pushes the display content to all subscribed websocket
+ * clients. Every changed frame is encoded only once and the same frame is
+ * sent to all subscribers, which are due. Unchanged frames are not sent and
+ * clients with a full send queue are skipped.
+ */
+class DisplayMirror
+{
+public:
+
+    /**
+     * Get display mirror instance.
+     *
+     * @return Display mirror instance
+     */
+    static DisplayMirror& getInstance()
+    {
+        static DisplayMirror instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Subscribe a websocket client. If the client is already subscribed,
+     * only the frame rate will be updated.
+     *
+     * @param[in] clientId  Websocket client id
+     * @param[in] fps       Max. frame rate in frames per second
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool subscribe(uint32_t clientId, uint8_t fps);
+
+    /**
+     * Unsubscribe a websocket client.
+     *
+     * @param[in] clientId  Websocket client id
+     */
+    void unsubscribe(uint32_t clientId);
+
+    /**
+     * Send the display content to all subscribers, which are due.
+     * Call it cyclic.
+     *
+     * @param[in] server    Websocket server
+     */
+    void process(AsyncWebSocket& server);
+
+    /** Max. number of subscribers. */
+    static const uint8_t    MAX_SUBSCRIBERS = 4U;
+
+    /** Max. frame rate in frames per second. */
+    static const uint8_t    MAX_FPS         = 25U;
+
+private:
+
+    /** A websocket client, which subscribed to the display mirror. */
+    struct Subscriber
+    {
+        bool        isUsed;     /**< Is subscriber entry used? */
+        uint32_t    clientId;   /**< Websocket client id */
+        uint32_t    period;     /**< Min. period between two frames in ms */
+        uint32_t    lastSent;   /**< Timestamp in ms, when the last frame was sent. */
+        bool        isSynced;   /**< Has the client received a frame, which is a valid reference? */
+        uint32_t    frameId;    /**< Id of the last frame, which the client received. */
+
+        /**
+         * Constructs a unused subscriber entry.
+         */
+        Subscriber() :
+            isUsed(false),
+            clientId(0U),
+            period(0U),
+            lastSent(0U),
+            isSynced(false),
+            frameId(0U)
+        {
+        }
+    };
+
+    /** Color format of the mirror frames. */
+    static const DisplayFrame::ColorFormat  COLOR_FORMAT    = DisplayFrame::COLOR_FORMAT_RGB888;
+
+    mutable MutexRecursive  m_mutex;                        /**< Mutex to protect against concurrent access. */
+    Subscriber              m_subscribers[MAX_SUBSCRIBERS]; /**< Subscribers */
+    uint8_t                 m_subscriberCnt;                /**< Number of subscribers */
+    size_t                  m_length;                       /**< Number of pixels per frame */
+    uint32_t*               m_framebuffer;                  /**< Current display content */
+    uint32_t*               m_reference;                    /**< Display content, which was sent last. */
+    bool                    m_isReferenceValid;             /**< Is the reference valid? */
+    uint8_t                 m_slotId;                       /**< Slot id of the reference */
+    uint32_t                m_frameId;                      /**< Id of the reference */
+    size_t                  m_frameSize;                    /**< Frame buffer size in byte */
+    uint8_t*                m_keyFrame;                     /**< Key frame of the reference */
+    uint8_t*                m_deltaFrame;                   /**< Delta frame from the previous frame to the reference */
+
+    /**
+     * Constructs the display mirror.
+     */
+    DisplayMirror() :
+        m_mutex(),
+        m_subscribers(),
+        m_subscriberCnt(0U),
+        m_length(0U),
+        m_framebuffer(nullptr),
+        m_reference(nullptr),
+        m_isReferenceValid(false),
+        m_slotId(0U),
+        m_frameId(0U),
+        m_frameSize(0U),
+        m_keyFrame(nullptr),
+        m_deltaFrame(nullptr)
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the display mirror.
+     */
+    ~DisplayMirror()
+    {
+        releaseBuffers();
+        m_mutex.destroy();
+    }
+
+    DisplayMirror(const DisplayMirror& mirror);
+    DisplayMirror& operator=(const DisplayMirror& mirror);
+
+    /**
+     * Allocate the frame buffers, if not already done.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool allocateBuffers();
+
+    /**
+     * Release all frame buffers.
+     */
+    void releaseBuffers();
+
+    /**
+     * Remove a subscriber. The frame buffers are released after the last
+     * subscriber left.
+     *
+     * @param[in] subscriber    Subscriber
+     */
+    void remove(Subscriber& subscriber);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DISPLAY_MIRROR_H__ */
+
+/** @} */
@@ -0,0 +1,153 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS resolver
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DnsResolver.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+#include <lwip/dns.h>
+#include <lwip/err.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+DnsCache::Result DnsResolver::resolve(const String& host, IPAddress& address)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint32_t                    timestamp   = millis();
+    uint32_t                    ipv4        = 0U;
+    DnsCache::Result            result      = m_cache.lookup(host.c_str(), timestamp, ipv4);
+
+    if (DnsCache::RESULT_MISS == result)
+    {
+        ip_addr_t   ipAddr;
+        err_t       err     = dns_gethostbyname(host.c_str(), &ipAddr, onFound, nullptr);
+
+        /* Host name is a IP address or lwIP knows it already. */
+        if (ERR_OK == err)
+        {
+            setResult(host.c_str(), &ipAddr);
+            result = m_cache.lookup(host.c_str(), timestamp, ipv4);
+        }
+        /* onFound() is called later. */
+        else if (ERR_INPROGRESS == err)
+        {
+            (void)m_cache.setPending(host.c_str(), PENDING_TIMEOUT, timestamp);
+            result = DnsCache::RESULT_PENDING;
+        }
+        else
+        {
+            LOG_WARNING("Couldn't resolve %s (%d).", host.c_str(), err);
+
+            (void)m_cache.setFailed(host.c_str(), NEGATIVE_TTL, timestamp);
+            result = DnsCache::RESULT_FAILED;
+        }
+    }
+
+    if (DnsCache::RESULT_RESOLVED == result)
+    {
+        address = ipv4;
+    }
+
+    return result;
+}
+
+void DnsResolver::invalidate(const String& host)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_cache.remove(host.c_str());
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void DnsResolver::setResult(const char* name, const ip_addr_t* ipAddr)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint32_t                    timestamp   = millis();
+
+    if ((nullptr != ipAddr) &&
+        (true == IP_IS_V4(ipAddr)))
+    {
+        (void)m_cache.setResolved(name, ip4_addr_get_u32(ip_2_ip4(ipAddr)), TTL, timestamp);
+    }
+    else
+    {
+        LOG_WARNING("Couldn't resolve %s.", name);
+
+        (void)m_cache.setFailed(name, NEGATIVE_TTL, timestamp);
+    }
+}
+
+void DnsResolver::onFound(const char* name, const ip_addr_t* ipAddr, void* arg)
+{
+    (void)arg;
+
+    getInstance().setResult(name, ipAddr);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,166 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS resolver
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __DNS_RESOLVER_H__
+#define __DNS_RESOLVER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+#include <IPAddress.h>
+#include <Mutex.hpp>
+#include <DnsCache.h>
+#include <lwip/ip_addr.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The DNS resolver keeps the addresses of the hosts, which are requested
+ * over and over again, e.g. by the plugins. A host name is only resolved
+ * via lwIP if it is unknown or its cached address expired. Failed
+ * resolutions are cached for a short time, so requests to a unknown host
+ * fail fast instead of waiting for the DNS server every time.
+ *
+ * The resolution itself is asynchronous: if the host is not cached, it is
+ * started in the background and the caller continues with the host name.
+ */
+class DnsResolver
+{
+public:
+
+    /**
+     * Get DNS resolver instance.
+     *
+     * @return DNS resolver instance
+     */
+    static DnsResolver& getInstance()
+    {
+        static DnsResolver instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Resolve a host name. If it is not cached, the resolution will be
+     * started in the background and RESULT_PENDING is returned.
+     *
+     * @param[in]   host    Host name
+     * @param[out]  address IPv4 address, only valid if resolved.
+     *
+     * @return Result of the resolution.
+     */
+    DnsCache::Result resolve(const String& host, IPAddress& address);
+
+    /**
+     * Invalidate the cached address of a host, e.g. because connecting
+     * to it failed.
+     *
+     * @param[in] host  Host name
+     */
+    void invalidate(const String& host);
+
+    /** Time to live in ms of a resolved address. */
+    static const uint32_t   TTL                 = 5U * 60U * 1000U;
+
+    /** Time to live in ms of a failed resolution. */
+    static const uint32_t   NEGATIVE_TTL        = 30U * 1000U;
+
+    /** Time in ms, after a pending resolution is considered as lost. */
+    static const uint32_t   PENDING_TIMEOUT     = 10U * 1000U;
+
+private:
+
+    mutable MutexRecursive  m_mutex;    /**< Mutex to protect against concurrent access. */
+    DnsCache                m_cache;    /**< Cached host addresses */
+
+    /**
+     * Constructs the DNS resolver.
+     */
+    DnsResolver() :
+        m_mutex(),
+        m_cache()
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the DNS resolver.
+     */
+    ~DnsResolver()
+    {
+        m_mutex.destroy();
+    }
+
+    DnsResolver(const DnsResolver& resolver);
+    DnsResolver& operator=(const DnsResolver& resolver);
+
+    /**
+     * Store the result of a resolution.
+     *
+     * @param[in] name      Host name
+     * @param[in] ipAddr    IP address or nullptr, if the resolution failed.
+     */
+    void setResult(const char* name, const ip_addr_t* ipAddr);
+
+    /**
+     * Called by lwIP in the TCP/IP task context, after a asynchronous
+     * resolution finished.
+     *
+     * @param[in] name      Host name
+     * @param[in] ipAddr    IP address or nullptr, if the resolution failed.
+     * @param[in] arg       Not used
+     */
+    static void onFound(const char* name, const ip_addr_t* ipAddr, void* arg);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DNS_RESOLVER_H__ */
+
+/** @} */
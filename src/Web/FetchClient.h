@@ -0,0 +1,231 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fetch client
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __FETCH_CLIENT_H__
+#define __FETCH_CLIENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+
+#include "FetchScheduler.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The fetch client subscribes periodically requested data from a server via
+ * the fetch scheduler. It is used instead of a own asynchronous HTTP client
+ * and request timer.
+ *
+ * Register all callbacks before subscribing. They are called in the context
+ * of the parse worker task or, if it is not available, in the context of the TCP
+ * task.
+ */
+class FetchClient
+{
+public:
+
+    /**
+     * Constructs the fetch client.
+     */
+    FetchClient() :
+        m_jobId(JobScheduler::INVALID_ID),
+        m_period(0U),
+        m_priority(FetchScheduler::PRIORITY_NORMAL),
+        m_isPending(false),
+        m_onRspCallback(),
+        m_onBodyCallback(),
+        m_onErrorCallback()
+    {
+    }
+
+    /**
+     * Destroys the fetch client.
+     */
+    ~FetchClient()
+    {
+        unsubscribe();
+    }
+
+    /**
+     * Register callback function on response reception.
+     *
+     * @param[in] onResponse    Callback
+     */
+    void regOnResponse(const AsyncHttpClient::OnResponse& onResponse)
+    {
+        m_onRspCallback = onResponse;
+    }
+
+    /**
+     * Register callback function on HTTP body reception.
+     * If its registered, the body won't be stored in the response.
+     *
+     * @param[in] onBody    Callback
+     */
+    void regOnBody(const AsyncHttpClient::OnBody& onBody)
+    {
+        m_onBodyCallback = onBody;
+    }
+
+    /**
+     * Register callback function on a failed request.
+     *
+     * @param[in] onError   Callback
+     */
+    void regOnError(const AsyncHttpClient::OnError& onError)
+    {
+        m_onErrorCallback = onError;
+    }
+
+    /**
+     * Subscribe periodically to the data of a URL. If the client is already
+     * subscribed to the same URL and form data, only the period is updated.
+     *
+     * @param[in] url       URL
+     * @param[in] period    Period in ms
+     * @param[in] formData  URL encoded form data. If not empty, it will be send via POST.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool subscribe(const String& url, uint32_t period, const String& formData = "")
+    {
+        return FetchScheduler::getInstance().subscribe(*this, url, period, formData);
+    }
+
+    /**
+     * Unsubscribe. After it returns, no callback will be called anymore.
+     */
+    void unsubscribe()
+    {
+        FetchScheduler::getInstance().unsubscribe(*this);
+    }
+
+    /**
+     * Is the client subscribed?
+     *
+     * @return If subscribed, it will return true otherwise false.
+     */
+    bool isSubscribed() const
+    {
+        return (JobScheduler::INVALID_ID != m_jobId);
+    }
+
+    /**
+     * Set the request priority, e.g. the plugin in the active slot shall
+     * be preferred. It can be set before subscribing.
+     *
+     * @param[in] priority  Priority
+     */
+    void setPriority(FetchScheduler::Priority priority)
+    {
+        FetchScheduler::getInstance().setPriority(*this, priority);
+    }
+
+    /**
+     * Request the data as soon as possible, e.g. after the configuration
+     * changed.
+     */
+    void trigger()
+    {
+        FetchScheduler::getInstance().trigger(*this);
+    }
+
+    /**
+     * Request the data as soon as possible, if it would be refreshed within
+     * the given time anyway, e.g. before the plugin is set active.
+     *
+     * @param[in] horizon   Time in ms
+     */
+    void prefetch(uint32_t horizon)
+    {
+        FetchScheduler::getInstance().prefetch(*this, horizon);
+    }
+
+    /**
+     * Cache the processed data of the current response, e.g. the filtered
+     * JSON text. Call it only in the response callback. If the server
+     * reports later that the data is not modified, the cached data is
+     * provided via body callback again, followed by the response callback.
+     * The cache is persistent, so the data is available after a restart too.
+     *
+     * Subscribers of the same URL are expected to process the data the same way.
+     *
+     * @param[in] data  Processed data
+     * @param[in] size  Data size in byte
+     *
+     * @return If successful cached, it will return true otherwise false.
+     */
+    bool cache(const char* data, size_t size)
+    {
+        return FetchScheduler::getInstance().cache(*this, data, size);
+    }
+
+private:
+
+    /** The fetch scheduler manages the subscription. */
+    friend class FetchScheduler;
+
+    uint8_t                         m_jobId;            /**< Job id of the subscribed request */
+    uint32_t                        m_period;           /**< Request period in ms */
+    FetchScheduler::Priority        m_priority;         /**< Request priority */
+    bool                            m_isPending;        /**< Does the client wait for the running request? */
+    AsyncHttpClient::OnResponse     m_onRspCallback;    /**< Callback which is called on response reception */
+    AsyncHttpClient::OnBody         m_onBodyCallback;   /**< Callback which is called on HTTP body reception */
+    AsyncHttpClient::OnError        m_onErrorCallback;  /**< Callback which is called on a failed request */
+
+    FetchClient(const FetchClient& client);
+    FetchClient& operator=(const FetchClient& client);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FETCH_CLIENT_H__ */
+
+/** @} */
@@ -0,0 +1,919 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fetch scheduler
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FetchScheduler.h"
+#include "FetchClient.h"
+#include "HttpStatus.h"
+#include "HttpCache.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+#include <Util.h>
+#include <GzipDecoder.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void FetchScheduler::start()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    /* After boot or a reconnect all requests would be due at once. */
+    m_scheduler.spread(SPREAD_WINDOW, millis());
+    m_isEnabled = true;
+}
+
+void FetchScheduler::stop()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_isEnabled = false;
+}
+
+void FetchScheduler::process()
+{
+    uint8_t idx = 0U;
+
+    /* The HTTP cache accesses the filesystem, which shall be done in the
+     * main loop context only.
+     */
+    HttpCache::getInstance().process();
+
+    for(idx = 0U; idx < MAX_RUNNING; ++idx)
+    {
+        Worker& worker      = m_workers[idx];
+        String  url;
+        bool    isStarted   = false;
+
+        {
+            MutexGuard<MutexRecursive> guard(m_mutex);
+
+            if ((true == m_isEnabled) &&
+                (false == worker.isBusy))
+            {
+                uint8_t jobId = m_scheduler.next(millis());
+
+                if (JobScheduler::INVALID_ID != jobId)
+                {
+                    uint8_t subscriberIdx = 0U;
+
+                    url                     = m_requests[jobId].url;
+                    worker.isBusy           = true;
+                    worker.jobId            = jobId;
+                    worker.isRspReceived    = false;
+                    worker.isError          = false;
+                    worker.formData         = m_requests[jobId].formData;
+
+                    /* Only the current subscribers get the response. */
+                    for(subscriberIdx = 0U; subscriberIdx < MAX_SUBSCRIBERS; ++subscriberIdx)
+                    {
+                        FetchClient* subscriber = m_subscribers[subscriberIdx];
+
+                        if ((nullptr != subscriber) &&
+                            (jobId == subscriber->m_jobId))
+                        {
+                            subscriber->m_isPending = true;
+                        }
+                    }
+
+                    isStarted = true;
+                }
+            }
+        }
+
+        /* The request is started without holding the lock, because the
+         * HTTP client callbacks are called with the connection pool lock
+         * held, which would cause a deadlock otherwise.
+         */
+        if (true == isStarted)
+        {
+            if (false == startRequest(worker, url))
+            {
+                LOG_WARNING("Request to %s failed.", url.c_str());
+
+                /* Avoid any follow up event of the failed request. */
+                worker.client.abort();
+
+                {
+                    MutexGuard<MutexRecursive> guard(m_mutex);
+
+                    finishRequest(worker, false);
+                }
+            }
+        }
+    }
+}
+
+void FetchScheduler::getStatistics(Statistics& statistics) const
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    statistics.responses        = m_rspCnt;
+    statistics.bodyDurationMax  = m_bodyDurationMax;
+    statistics.rspDurationAvg   = 0U;
+    statistics.rspDurationMax   = m_rspDurationMax;
+
+    if (0U < m_rspCnt)
+    {
+        statistics.rspDurationAvg = m_rspDurationSum / m_rspCnt;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+FetchScheduler::FetchScheduler() :
+    m_mutex(),
+    m_scheduler(MAX_RUNNING, MAX_JITTER, RETRY_PERIOD, static_cast<uint32_t>(random(1, INT32_MAX))),
+    m_isEnabled(false),
+    m_requests(),
+    m_subscribers(),
+    m_workers(),
+    m_deliveryMutex(),
+    m_deliveries(),
+    m_cacheableDelivery(nullptr),
+    m_rspCnt(0U),
+    m_bodyDurationMax(0U),
+    m_rspDurationSum(0U),
+    m_rspDurationMax(0U)
+{
+    uint8_t idx = 0U;
+
+    (void)m_mutex.create();
+    (void)m_deliveryMutex.create();
+
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        m_subscribers[idx] = nullptr;
+    }
+
+    for(idx = 0U; idx < MAX_RUNNING; ++idx)
+    {
+        initWorker(m_workers[idx]);
+    }
+}
+
+bool FetchScheduler::subscribe(FetchClient& client, const String& url, uint32_t period, const String& formData)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = false;
+    uint8_t                     jobId           = client.m_jobId;
+
+    /* Already subscribed to the same request? */
+    if ((JobScheduler::INVALID_ID != jobId) &&
+        (url == m_requests[jobId].url) &&
+        (formData == m_requests[jobId].formData))
+    {
+        client.m_period = period;
+        updateRequest(jobId);
+
+        isSuccessful = true;
+    }
+    else if (true == url.isEmpty())
+    {
+        LOG_WARNING("No URL to subscribe.");
+    }
+    else
+    {
+        uint8_t subscriberIdx   = 0U;
+        uint8_t freeIdx         = MAX_SUBSCRIBERS;
+
+        removeSubscriber(client);
+
+        for(subscriberIdx = 0U; subscriberIdx < MAX_SUBSCRIBERS; ++subscriberIdx)
+        {
+            if (nullptr == m_subscribers[subscriberIdx])
+            {
+                freeIdx = subscriberIdx;
+                break;
+            }
+        }
+
+        /* Look for the same request of another subscriber. */
+        for(jobId = 0U; jobId < JobScheduler::MAX_JOBS; ++jobId)
+        {
+            if ((url == m_requests[jobId].url) &&
+                (formData == m_requests[jobId].formData))
+            {
+                break;
+            }
+        }
+
+        if (MAX_SUBSCRIBERS <= freeIdx)
+        {
+            LOG_ERROR("Max. number of subscribers reached.");
+        }
+        else if (JobScheduler::MAX_JOBS > jobId)
+        {
+            LOG_INFO("Share request to %s.", url.c_str());
+
+            /* The new subscriber shall get the data soon. If the request is
+             * running, it will be triggered after it finished.
+             */
+            if (false == m_scheduler.isRunning(jobId))
+            {
+                m_scheduler.trigger(jobId, millis());
+            }
+
+            isSuccessful = true;
+        }
+        else
+        {
+            jobId = m_scheduler.add(period, client.m_priority, millis());
+
+            if (JobScheduler::INVALID_ID == jobId)
+            {
+                LOG_ERROR("Max. number of requests reached.");
+            }
+            else
+            {
+                m_requests[jobId].url       = url;
+                m_requests[jobId].formData  = formData;
+
+                isSuccessful = true;
+            }
+        }
+
+        if (true == isSuccessful)
+        {
+            client.m_jobId              = jobId;
+            client.m_period             = period;
+            client.m_isPending          = false;
+            m_subscribers[freeIdx]      = &client;
+
+            updateRequest(jobId);
+        }
+    }
+
+    return isSuccessful;
+}
+
+void FetchScheduler::unsubscribe(FetchClient& client)
+{
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        removeSubscriber(client);
+    }
+
+    /* Wait until a running delivery finished, which may call the client callbacks.
+     * The lock must not be held, because the delivery takes it too.
+     */
+    (void)m_deliveryMutex.take(portMAX_DELAY);
+    (void)m_deliveryMutex.give();
+}
+
+void FetchScheduler::removeSubscriber(FetchClient& client)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint8_t                     jobId   = client.m_jobId;
+    uint8_t                     idx     = 0U;
+
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        if (&client == m_subscribers[idx])
+        {
+            uint8_t deliveryIdx = 0U;
+
+            m_subscribers[idx] = nullptr;
+
+            /* The subscriber index may be reused by another client. */
+            for(deliveryIdx = 0U; deliveryIdx < MAX_DELIVERIES; ++deliveryIdx)
+            {
+                m_deliveries[deliveryIdx].subscribers &= ~(1U << idx);
+            }
+        }
+    }
+
+    client.m_jobId      = JobScheduler::INVALID_ID;
+    client.m_isPending  = false;
+
+    if (JobScheduler::INVALID_ID != jobId)
+    {
+        updateRequest(jobId);
+    }
+}
+
+void FetchScheduler::setPriority(FetchClient& client, Priority priority)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if (priority != client.m_priority)
+    {
+        client.m_priority = priority;
+
+        if (JobScheduler::INVALID_ID != client.m_jobId)
+        {
+            updateRequest(client.m_jobId);
+        }
+    }
+}
+
+void FetchScheduler::updateRequest(uint8_t jobId)
+{
+    uint32_t    period          = UINT32_MAX;
+    Priority    priority        = PRIORITY_LOW;
+    bool        isSubscribed    = false;
+    uint8_t     idx             = 0U;
+
+    /* The most demanding subscriber determines period and priority. */
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        const FetchClient* subscriber = m_subscribers[idx];
+
+        if ((nullptr != subscriber) &&
+            (jobId == subscriber->m_jobId))
+        {
+            if (subscriber->m_period < period)
+            {
+                period = subscriber->m_period;
+            }
+
+            if (priority < subscriber->m_priority)
+            {
+                priority = subscriber->m_priority;
+            }
+
+            isSubscribed = true;
+        }
+    }
+
+    if (true == isSubscribed)
+    {
+        m_scheduler.setPeriod(jobId, period);
+        m_scheduler.setPriority(jobId, priority);
+    }
+    else
+    {
+        m_scheduler.remove(jobId);
+        m_requests[jobId] = Request();
+
+        /* A running request is not aborted, but its result is ignored. */
+        for(idx = 0U; idx < MAX_RUNNING; ++idx)
+        {
+            if (jobId == m_workers[idx].jobId)
+            {
+                m_workers[idx].jobId = JobScheduler::INVALID_ID;
+            }
+        }
+    }
+}
+
+void FetchScheduler::trigger(FetchClient& client)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if ((JobScheduler::INVALID_ID != client.m_jobId) &&
+        (false == m_scheduler.isRunning(client.m_jobId)))
+    {
+        m_scheduler.trigger(client.m_jobId, millis());
+    }
+}
+
+void FetchScheduler::prefetch(FetchClient& client, uint32_t horizon)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint32_t                    timestamp   = millis();
+
+    if ((JobScheduler::INVALID_ID != client.m_jobId) &&
+        (false == m_scheduler.isRunning(client.m_jobId)) &&
+        (0U == m_scheduler.getFailureCount(client.m_jobId)) &&
+        (horizon >= m_scheduler.getRemaining(client.m_jobId, timestamp)))
+    {
+        m_scheduler.trigger(client.m_jobId, timestamp);
+    }
+}
+
+bool FetchScheduler::cache(FetchClient& client, const char* data, size_t size)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = false;
+    uint8_t                     idx             = 0U;
+
+    if ((nullptr != m_cacheableDelivery) &&
+        (true == m_cacheableDelivery->isCacheable))
+    {
+        for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+        {
+            if (&client == getSubscriber(*m_cacheableDelivery, idx))
+            {
+                isSuccessful = HttpCache::getInstance().setData(m_cacheableDelivery->url, data, size);
+                break;
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+void FetchScheduler::initWorker(Worker& worker)
+{
+    /* JSON responses are usually well compressible. The body is decoded
+     * by the parse worker, not in the TCP task.
+     */
+    worker.client.setAcceptGzip(true);
+    worker.client.setDecodeGzip(false);
+
+    /* Only the cache validators are needed from the response headers. */
+    (void)worker.client.addRspHeaderFilter("ETag");
+    (void)worker.client.addRspHeaderFilter("Last-Modified");
+
+    worker.client.regOnBody(
+        [this, &worker](const uint8_t* data, size_t size, size_t index)
+        {
+            this->onBody(worker, data, size, index);
+        }
+    );
+
+    worker.client.regOnResponse(
+        [this, &worker](const HttpResponse& rsp)
+        {
+            this->onResponse(worker, rsp);
+        }
+    );
+
+    worker.client.regOnError(
+        [this, &worker]()
+        {
+            this->onError(worker);
+        }
+    );
+
+    worker.client.regOnClosed(
+        [this, &worker]()
+        {
+            this->onClosed(worker);
+        }
+    );
+}
+
+bool FetchScheduler::startRequest(Worker& worker, const String& url)
+{
+    bool isSuccessful = false;
+
+    if (true == worker.client.begin(url))
+    {
+        if (true == worker.formData.isEmpty())
+        {
+            String  etag;
+            String  lastModified;
+
+            /* Receive the body only, if it was modified since the data was cached. */
+            if (true == HttpCache::getInstance().getValidators(url, etag, lastModified))
+            {
+                if (false == etag.isEmpty())
+                {
+                    worker.client.addHeader("If-None-Match", etag);
+                }
+
+                if (false == lastModified.isEmpty())
+                {
+                    worker.client.addHeader("If-Modified-Since", lastModified);
+                }
+            }
+
+            isSuccessful = worker.client.GET();
+        }
+        else
+        {
+            worker.client.addHeader("Content-Type", "application/x-www-form-urlencoded");
+            isSuccessful = worker.client.POST(worker.formData);
+        }
+    }
+
+    return isSuccessful;
+}
+
+void FetchScheduler::finishRequest(Worker& worker, bool isSuccessful)
+{
+    if (false == worker.isBusy)
+    {
+        return;
+    }
+
+    if (JobScheduler::INVALID_ID != worker.jobId)
+    {
+        bool    isWaiting   = false;
+        uint8_t idx         = 0U;
+
+        m_scheduler.finish(worker.jobId, isSuccessful, millis());
+
+        if (false == isSuccessful)
+        {
+            LOG_WARNING("Request to %s failed %u times.", m_requests[worker.jobId].url.c_str(), m_scheduler.getFailureCount(worker.jobId));
+        }
+
+        for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+        {
+            FetchClient* subscriber = m_subscribers[idx];
+
+            if ((nullptr != subscriber) &&
+                (worker.jobId == subscriber->m_jobId))
+            {
+                if (false == subscriber->m_isPending)
+                {
+                    isWaiting = true;
+                }
+                else if ((false == isSuccessful) &&
+                         (nullptr != subscriber->m_onErrorCallback))
+                {
+                    subscriber->m_onErrorCallback();
+                }
+
+                subscriber->m_isPending = false;
+            }
+        }
+
+        /* A subscriber joined during the request and waits for its data. */
+        if ((true == isSuccessful) &&
+            (true == isWaiting))
+        {
+            m_scheduler.trigger(worker.jobId, millis());
+        }
+    }
+
+    worker.isBusy   = false;
+    worker.jobId    = JobScheduler::INVALID_ID;
+    worker.formData.clear();
+    worker.body.clear();
+}
+
+void FetchScheduler::onBody(Worker& worker, const uint8_t* data, size_t size, size_t index)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint32_t                    timestamp   = micros();
+    uint32_t                    duration    = 0U;
+
+    UTIL_NOT_USED(index);
+
+    if ((JobScheduler::INVALID_ID == worker.jobId) ||
+        (true == worker.isError))
+    {
+        return;
+    }
+
+    /* The body is only collected here, it's processed by the parse worker. */
+    if (false == worker.body.append(data, size))
+    {
+        LOG_WARNING("Response body of %s exceeds %u byte.", m_requests[worker.jobId].url.c_str(), BODY_SIZE_MAX);
+        worker.isError = true;
+    }
+
+    duration = micros() - timestamp;
+
+    if (m_bodyDurationMax < duration)
+    {
+        m_bodyDurationMax = duration;
+    }
+}
+
+void FetchScheduler::onResponse(Worker& worker, const HttpResponse& rsp)
+{
+    uint32_t    timestamp   = micros();
+    uint32_t    duration    = 0U;
+    Delivery*   delivery    = nullptr;
+    GrowBuffer  body(BODY_SIZE_MAX);
+
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        if ((JobScheduler::INVALID_ID != worker.jobId) &&
+            (false == worker.isError))
+        {
+            delivery = prepareDelivery(worker, rsp, body);
+        }
+
+        worker.body.clear();
+    }
+
+    /* The lock is not held, because the delivery may happen in this context. */
+    if (nullptr != delivery)
+    {
+        (void)ParseWorker::getInstance().post(body,
+            [this, delivery](const char* data, size_t size)
+            {
+                this->deliver(*delivery, reinterpret_cast<const uint8_t*>(data), size);
+            }
+        );
+    }
+
+    duration = micros() - timestamp;
+
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        ++m_rspCnt;
+        m_rspDurationSum += duration;
+
+        if (m_rspDurationMax < duration)
+        {
+            m_rspDurationMax = duration;
+        }
+    }
+}
+
+FetchScheduler::Delivery* FetchScheduler::prepareDelivery(Worker& worker, const HttpResponse& rsp, GrowBuffer& body)
+{
+    Delivery*       delivery        = nullptr;
+    const String&   url             = m_requests[worker.jobId].url;
+    uint16_t        statusCode      = rsp.getStatusCode();
+    bool            isGzip          = false;
+    bool            isCacheable     = false;
+    uint32_t        subscribers     = 0U;
+    uint8_t         idx             = 0U;
+
+    if (HttpStatus::STATUS_CODE_NOT_MODIFIED == statusCode)
+    {
+        String data;
+
+        /* The subscribers get the cached data instead of the body. */
+        if (false == HttpCache::getInstance().getData(url, data))
+        {
+            LOG_WARNING("No cached data of %s available.", url.c_str());
+            return nullptr;
+        }
+
+        if (false == body.append(reinterpret_cast<const uint8_t*>(data.c_str()), data.length()))
+        {
+            return nullptr;
+        }
+
+        worker.isRspReceived = true;
+    }
+    else
+    {
+        /* A server error shall be retried with backoff as well. */
+        if (HttpStatus::STATUS_CODE_BAD_REQUEST > statusCode)
+        {
+            worker.isRspReceived = true;
+
+            /* Only the data of a GET request can be validated later. */
+            if ((HttpStatus::STATUS_CODE_OK == statusCode) &&
+                (true == worker.formData.isEmpty()))
+            {
+                HttpCache::getInstance().setValidators(url, rsp.getHeader("ETag"), rsp.getHeader("Last-Modified"));
+                isCacheable = true;
+            }
+        }
+
+        isGzip = worker.client.isRspGzipEncoded();
+        (void)body.take(worker.body);
+    }
+
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        const FetchClient* subscriber = m_subscribers[idx];
+
+        if ((nullptr != subscriber) &&
+            (worker.jobId == subscriber->m_jobId) &&
+            (true == subscriber->m_isPending))
+        {
+            subscribers |= (1U << idx);
+        }
+    }
+
+    if (0U != subscribers)
+    {
+        for(idx = 0U; idx < MAX_DELIVERIES; ++idx)
+        {
+            if (false == m_deliveries[idx].isUsed)
+            {
+                delivery = &m_deliveries[idx];
+                break;
+            }
+        }
+
+        if (nullptr == delivery)
+        {
+            LOG_WARNING("No delivery available for %s.", url.c_str());
+        }
+        else
+        {
+            delivery->isUsed        = true;
+            delivery->subscribers   = subscribers;
+            delivery->url           = url;
+            delivery->rsp           = rsp;
+            delivery->isGzip        = isGzip;
+            delivery->isCacheable   = isCacheable;
+        }
+    }
+
+    return delivery;
+}
+
+void FetchScheduler::deliver(Delivery& delivery, const uint8_t* body, size_t size)
+{
+    MutexGuard<MutexRecursive>  deliveryGuard(m_deliveryMutex);
+    bool                        isValid             = true;
+    bool                        isPayloadRequired   = false;
+    uint8_t                     idx                 = 0U;
+
+    /* A subscriber without body callback gets the body as response payload. */
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        FetchClient* subscriber = getSubscriber(delivery, idx);
+
+        if ((nullptr != subscriber) &&
+            (nullptr == subscriber->m_onBodyCallback))
+        {
+            isPayloadRequired = true;
+        }
+    }
+
+    if (true == delivery.isGzip)
+    {
+        /* The window is only allocated during decoding. */
+        GzipDecoder* decoder = new(std::nothrow) GzipDecoder();
+
+        if (nullptr == decoder)
+        {
+            isValid = false;
+        }
+        else
+        {
+            size_t index = 0U;
+
+            (void)decoder->decode(body, size,
+                [this, &delivery, &index, isPayloadRequired](const uint8_t* decodedData, size_t decodedSize)
+                {
+                    this->deliverBody(delivery, decodedData, decodedSize, index, isPayloadRequired);
+                    index += decodedSize;
+                }
+            );
+
+            isValid = decoder->isComplete();
+
+            delete decoder;
+        }
+    }
+    else if (0U < size)
+    {
+        deliverBody(delivery, body, size, 0U, isPayloadRequired);
+    }
+    else
+    {
+        ;
+    }
+
+    if (false == isValid)
+    {
+        LOG_ERROR("Response body decoding of %s failed.", delivery.url.c_str());
+
+        for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+        {
+            FetchClient* subscriber = getSubscriber(delivery, idx);
+
+            if ((nullptr != subscriber) &&
+                (nullptr != subscriber->m_onErrorCallback))
+            {
+                subscriber->m_onErrorCallback();
+            }
+        }
+    }
+    else
+    {
+        /* The subscribers can cache their data only in the response callback. */
+        {
+            MutexGuard<MutexRecursive> guard(m_mutex);
+
+            m_cacheableDelivery = &delivery;
+        }
+
+        for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+        {
+            FetchClient* subscriber = getSubscriber(delivery, idx);
+
+            if ((nullptr != subscriber) &&
+                (nullptr != subscriber->m_onRspCallback))
+            {
+                subscriber->m_onRspCallback(delivery.rsp);
+            }
+        }
+    }
+
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        m_cacheableDelivery     = nullptr;
+        delivery.isUsed         = false;
+        delivery.subscribers    = 0U;
+        delivery.url.clear();
+        delivery.rsp.clear();
+    }
+}
+
+void FetchScheduler::deliverBody(Delivery& delivery, const uint8_t* data, size_t size, size_t index, bool isPayloadRequired)
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0U; idx < MAX_SUBSCRIBERS; ++idx)
+    {
+        FetchClient* subscriber = getSubscriber(delivery, idx);
+
+        if ((nullptr != subscriber) &&
+            (nullptr != subscriber->m_onBodyCallback))
+        {
+            subscriber->m_onBodyCallback(data, size, index);
+        }
+    }
+
+    if (true == isPayloadRequired)
+    {
+        delivery.rsp.addPayload(data, size);
+    }
+}
+
+FetchClient* FetchScheduler::getSubscriber(const Delivery& delivery, uint8_t idx)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    FetchClient*                subscriber  = nullptr;
+
+    /* A client, which unsubscribed meanwhile, is removed from the delivery. */
+    if ((MAX_SUBSCRIBERS > idx) &&
+        (0U != (delivery.subscribers & (1U << idx))))
+    {
+        subscriber = m_subscribers[idx];
+    }
+
+    return subscriber;
+}
+
+void FetchScheduler::onError(Worker& worker)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    worker.isError = true;
+}
+
+void FetchScheduler::onClosed(Worker& worker)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    finishRequest(worker, (true == worker.isRspReceived) && (false == worker.isError));
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
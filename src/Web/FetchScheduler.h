@@ -0,0 +1,458 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fetch scheduler
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __FETCH_SCHEDULER_H__
+#define __FETCH_SCHEDULER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+#include <Mutex.hpp>
+#include <JobScheduler.h>
+#include <GrowBuffer.h>
+
+#include "AsyncHttpClient.h"
+#include "ParseWorker.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+class FetchClient;
+
+/**
+ * The fetch scheduler requests periodically data from servers on behalf of
+ * its subscribers (fetch clients), which are usually plugins.
+ *
+ * - Subscribers of the same URL (and form data) share one request, the
+ *   response is fanned out to all of them.
+ * - The requests are spread with a random jitter, especially after the
+ *   network connection is (re-)established.
+ * - Only a limited number of requests are running at the same time.
+ * - A failed request is retried with an exponential backoff.
+ * - Requests of a subscriber with higher priority, e.g. the plugin in the
+ *   active slot, are started first.
+ * - GET requests are sent conditional, if the subscribers cached their
+ *   processed data. On "304 Not Modified" the cached data is provided
+ *   via body callback again.
+ *
+ * In the TCP task the received body is only collected, still gzip encoded.
+ * After the response is complete, it is handed over to the parse worker,
+ * which decodes it and calls the subscriber callbacks. So decoding,
+ * filtering and deserialization don't stall other connections. If the
+ * parse worker is not available, the callbacks are called in the context
+ * of the TCP task.
+ */
+class FetchScheduler
+{
+public:
+
+    /**
+     * Request priority.
+     */
+    enum Priority
+    {
+        PRIORITY_LOW = 0,   /**< Low priority */
+        PRIORITY_NORMAL,    /**< Normal priority */
+        PRIORITY_HIGH       /**< High priority, e.g. the plugin is shown. */
+    };
+
+    /**
+     * Durations of the response handling in the TCP task.
+     */
+    struct Statistics
+    {
+        uint32_t    responses;          /**< Number of handled responses */
+        uint32_t    bodyDurationMax;    /**< Max. duration in us to collect one received body part */
+        uint32_t    rspDurationAvg;     /**< Average duration in us to hand a response over */
+        uint32_t    rspDurationMax;     /**< Max. duration in us to hand a response over */
+    };
+
+    /**
+     * Get fetch scheduler instance.
+     *
+     * @return Fetch scheduler instance
+     */
+    static FetchScheduler& getInstance()
+    {
+        static FetchScheduler instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start scheduling requests, after the network connection is established.
+     * All pending requests are spread over a time window.
+     */
+    void start();
+
+    /**
+     * Stop scheduling requests, after the network connection is lost.
+     * Running requests are not aborted.
+     */
+    void stop();
+
+    /**
+     * Process the fetch scheduler. It starts the due requests.
+     */
+    void process();
+
+    /**
+     * Get the statistics.
+     *
+     * @param[out] statistics   Statistics
+     */
+    void getStatistics(Statistics& statistics) const;
+
+    /** Max. number of requests running at the same time. */
+    static const uint8_t    MAX_RUNNING         = 2U;
+
+    /** Max. number of subscribers, not more than 32 (see Delivery::subscribers). */
+    static const uint8_t    MAX_SUBSCRIBERS     = 24U;
+
+    /** Max. jitter in ms, which spreads new requests and the requests after a reconnect. */
+    static const uint32_t   MAX_JITTER          = 3000U;
+
+    /** Retry period in ms after the first failed request. It doubles with every further failure. */
+    static const uint32_t   RETRY_PERIOD        = 10000U;
+
+    /** Time window in ms, in which the requests are spread after the network connection is established. */
+    static const uint32_t   SPREAD_WINDOW       = 10000U;
+
+    /** Max. size in byte of a received (encoded) response body. */
+    static const size_t     BODY_SIZE_MAX       = 32768U;
+
+private:
+
+    /** The fetch client is the subscriber interface. */
+    friend class FetchClient;
+
+    /**
+     * A request, shared by all its subscribers.
+     */
+    struct Request
+    {
+        String  url;        /**< URL, empty if not used. */
+        String  formData;   /**< URL encoded form data. If available, it will be send via POST. */
+    };
+
+    /**
+     * A worker runs one request at a time.
+     */
+    struct Worker
+    {
+        AsyncHttpClient client;         /**< Asynchronous HTTP client */
+        bool            isBusy;         /**< Is a request running? */
+        uint8_t         jobId;          /**< Job id of the running request. Invalid if the request was removed meanwhile. */
+        bool            isRspReceived;  /**< Is a successful response received? */
+        bool            isError;        /**< Did an error happen? */
+        String          formData;       /**< Form data, which must be available until it is sent. */
+        GrowBuffer      body;           /**< Received response body, still encoded. */
+
+        /**
+         * Constructs a idle worker.
+         */
+        Worker() :
+            client(),
+            isBusy(false),
+            jobId(JobScheduler::INVALID_ID),
+            isRspReceived(false),
+            isError(false),
+            formData(),
+            body(BODY_SIZE_MAX)
+        {
+        }
+    };
+
+    /**
+     * A complete response, which is delivered to its subscribers by the
+     * parse worker.
+     */
+    struct Delivery
+    {
+        bool            isUsed;         /**< Is the delivery in use? */
+        uint32_t        subscribers;    /**< Subscribers, which get the response. Bit n is the subscriber index n. */
+        String          url;            /**< URL of the request */
+        HttpResponse    rsp;            /**< Response, the payload is only used if a subscriber has no body callback. */
+        bool            isGzip;         /**< Is the body gzip encoded? */
+        bool            isCacheable;    /**< Can the subscribers cache the processed response data? */
+
+        /**
+         * Constructs a unused delivery.
+         */
+        Delivery() :
+            isUsed(false),
+            subscribers(0U),
+            url(),
+            rsp(),
+            isGzip(false),
+            isCacheable(false)
+        {
+        }
+    };
+
+    /**
+     * Max. number of deliveries: All parse worker jobs and one, which is
+     * processed in the TCP task, if the parse worker is busy.
+     */
+    static const uint8_t    MAX_DELIVERIES      = ParseWorker::MAX_JOBS + 1U;
+
+    mutable MutexRecursive  m_mutex;                            /**< Mutex to protect against concurrent access. */
+    JobScheduler            m_scheduler;                        /**< Schedules the requests */
+    bool                    m_isEnabled;                        /**< Is network available to start requests? */
+    Request                 m_requests[JobScheduler::MAX_JOBS]; /**< Requests, the index is the job id. */
+    FetchClient*            m_subscribers[MAX_SUBSCRIBERS];     /**< Subscribers */
+    Worker                  m_workers[MAX_RUNNING];             /**< Workers */
+    MutexRecursive          m_deliveryMutex;                    /**< Mutex, which is hold during a delivery. */
+    Delivery                m_deliveries[MAX_DELIVERIES];       /**< Deliveries */
+    Delivery*               m_cacheableDelivery;                /**< Delivery, which response callbacks are called. */
+    uint32_t                m_rspCnt;                           /**< Number of responses processed by the subscribers */
+    uint32_t                m_bodyDurationMax;                  /**< Max. duration in us of the body callbacks for one body part */
+    uint32_t                m_rspDurationSum;                   /**< Sum of all response callback durations in us */
+    uint32_t                m_rspDurationMax;                   /**< Max. duration in us of the response callbacks for one response */
+
+    /**
+     * Constructs the fetch scheduler.
+     */
+    FetchScheduler();
+
+    /**
+     * Destroys the fetch scheduler.
+     */
+    ~FetchScheduler()
+    {
+        m_deliveryMutex.destroy();
+        m_mutex.destroy();
+    }
+
+    FetchScheduler(const FetchScheduler& scheduler);
+    FetchScheduler& operator=(const FetchScheduler& scheduler);
+
+    /**
+     * Subscribe a fetch client to a URL. If the client is already subscribed
+     * to a different URL, it will be unsubscribed first.
+     *
+     * @param[in] client    Fetch client
+     * @param[in] url       URL
+     * @param[in] period    Period in ms
+     * @param[in] formData  URL encoded form data. If not empty, it will be send via POST.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool subscribe(FetchClient& client, const String& url, uint32_t period, const String& formData);
+
+    /**
+     * Unsubscribe a fetch client. After it returns, no callback of the
+     * client will be called anymore.
+     *
+     * @param[in] client    Fetch client
+     */
+    void unsubscribe(FetchClient& client);
+
+    /**
+     * Remove a fetch client from the subscribers and from all pending
+     * deliveries. A running delivery may still call its callbacks.
+     *
+     * @param[in] client    Fetch client
+     */
+    void removeSubscriber(FetchClient& client);
+
+    /**
+     * Set the request priority of a fetch client.
+     *
+     * @param[in] client    Fetch client
+     * @param[in] priority  Priority
+     */
+    void setPriority(FetchClient& client, Priority priority);
+
+    /**
+     * Update the request period and priority, after a subscriber changed.
+     * A request without subscriber is removed.
+     *
+     * @param[in] jobId Job id of the request
+     */
+    void updateRequest(uint8_t jobId);
+
+    /**
+     * Request the data of a fetch client as soon as possible.
+     *
+     * @param[in] client    Fetch client
+     */
+    void trigger(FetchClient& client);
+
+    /**
+     * Request the data of a fetch client as soon as possible, if it would
+     * be due within the given time anyway. After failed requests, the
+     * retry delay is kept.
+     *
+     * @param[in] client    Fetch client
+     * @param[in] horizon   Time in ms
+     */
+    void prefetch(FetchClient& client, uint32_t horizon);
+
+    /**
+     * Cache the processed response data of a fetch client. This is only
+     * possible during the response callback of a successful GET request.
+     *
+     * @param[in] client    Fetch client
+     * @param[in] data      Processed response data
+     * @param[in] size      Data size in byte
+     *
+     * @return If successful cached, it will return true otherwise false.
+     */
+    bool cache(FetchClient& client, const char* data, size_t size);
+
+
+    /**
+     * Register the callbacks of a worker.
+     *
+     * @param[in] worker    Worker
+     */
+    void initWorker(Worker& worker);
+
+    /**
+     * Start the request of a worker.
+     *
+     * @param[in] worker    Worker
+     * @param[in] url       URL
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool startRequest(Worker& worker, const String& url);
+
+    /**
+     * Finish the request of a worker and schedule it again.
+     * On failure the subscribers are notified.
+     *
+     * @param[in] worker        Worker
+     * @param[in] isSuccessful  Was the request successful?
+     */
+    void finishRequest(Worker& worker, bool isSuccessful);
+
+    /**
+     * This method is called by the worker for every received part of the response body.
+     *
+     * @param[in] worker    Worker
+     * @param[in] data      Body data
+     * @param[in] size      Body data size in byte
+     * @param[in] index     Index of the body data in the whole body
+     */
+    void onBody(Worker& worker, const uint8_t* data, size_t size, size_t index);
+
+    /**
+     * This method is called by the worker after the response is completely received.
+     *
+     * @param[in] worker    Worker
+     * @param[in] rsp       Response
+     */
+    void onResponse(Worker& worker, const HttpResponse& rsp);
+
+    /**
+     * Prepare the delivery of a complete response to the pending subscribers.
+     * On "304 Not Modified" the cached data is delivered instead of the body.
+     *
+     * @param[in]  worker   Worker
+     * @param[in]  rsp      Response
+     * @param[out] body     Body, which to deliver
+     *
+     * @return Delivery or nullptr, if there is nothing to deliver.
+     */
+    Delivery* prepareDelivery(Worker& worker, const HttpResponse& rsp, GrowBuffer& body);
+
+    /**
+     * Decode the body and deliver it with the response to the subscribers.
+     * It is called in the parse worker task context or if the parse worker
+     * is not available in the TCP task context. The delivery is released
+     * afterwards.
+     *
+     * @param[in] delivery  Delivery
+     * @param[in] body      Body, maybe gzip encoded
+     * @param[in] size      Body size in byte
+     */
+    void deliver(Delivery& delivery, const uint8_t* body, size_t size);
+
+    /**
+     * Deliver a part of the decoded body to the subscribers.
+     *
+     * @param[in] delivery              Delivery
+     * @param[in] data                  Part of the decoded body
+     * @param[in] size                  Part size in byte
+     * @param[in] index                 Index of the part in the whole body
+     * @param[in] isPayloadRequired     Shall the body be added to the response payload?
+     */
+    void deliverBody(Delivery& delivery, const uint8_t* data, size_t size, size_t index, bool isPayloadRequired);
+
+    /**
+     * Get a subscriber of a delivery, if it still waits for it.
+     *
+     * @param[in] delivery  Delivery
+     * @param[in] idx       Subscriber index
+     *
+     * @return Subscriber or nullptr
+     */
+    FetchClient* getSubscriber(const Delivery& delivery, uint8_t idx);
+
+    /**
+     * This method is called by the worker if a error occurred.
+     *
+     * @param[in] worker    Worker
+     */
+    void onError(Worker& worker);
+
+    /**
+     * This method is called by the worker after the request is finished.
+     *
+     * @param[in] worker    Worker
+     */
+    void onClosed(Worker& worker);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FETCH_SCHEDULER_H__ */
+
+/** @} */
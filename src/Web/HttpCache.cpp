@@ -0,0 +1,365 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HttpCache.h"
+#include "FileSystem.h"
+
+#include <Logging.h>
+#include <ArduinoJson.h>
+#include <JsonFile.h>
+#include <JsonDocPool.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize cache file name. */
+const char* HttpCache::FILE_NAME    = "/httpCache.json";
+
+/** JSON document size in byte, which is required to load or save all entries. */
+static const size_t JSON_DOC_SIZE   = 8192U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void HttpCache::process()
+{
+    bool isLoadRequired = false;
+    bool isSaveRequired = false;
+
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        if (false == m_isLoaded)
+        {
+            m_isLoaded      = true;
+            isLoadRequired  = true;
+        }
+        else if (true == m_isDirty)
+        {
+            m_isDirty       = false;
+            isSaveRequired  = true;
+        }
+    }
+
+    if (true == isLoadRequired)
+    {
+        load();
+    }
+    else if (true == isSaveRequired)
+    {
+        save();
+    }
+}
+
+bool HttpCache::getValidators(const String& url, String& etag, String& lastModified)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isAvailable = false;
+    Entry*                      entry       = find(url);
+
+    if ((nullptr != entry) &&
+        (false == entry->data.isEmpty()))
+    {
+        etag            = entry->etag;
+        lastModified    = entry->lastModified;
+        entry->lastUsed = ++m_usageCounter;
+        isAvailable     = true;
+    }
+
+    return isAvailable;
+}
+
+void HttpCache::setValidators(const String& url, const String& etag, const String& lastModified)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if ((true == etag.isEmpty()) &&
+        (true == lastModified.isEmpty()))
+    {
+        remove(url);
+    }
+    else
+    {
+        Entry& entry = acquire(url);
+
+        /* The former data belongs to the former validators. */
+        entry.etag          = etag;
+        entry.lastModified  = lastModified;
+        entry.data.clear();
+        entry.lastUsed      = ++m_usageCounter;
+    }
+}
+
+bool HttpCache::setData(const String& url, const char* data, size_t size)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = false;
+    Entry*                      entry           = find(url);
+
+    if ((nullptr != entry) &&
+        (nullptr != data) &&
+        (0U < size))
+    {
+        if (MAX_DATA_SIZE < size)
+        {
+            LOG_WARNING("Data of %s too large for cache.", url.c_str());
+        }
+        else
+        {
+            size_t idx = 0U;
+
+            entry->data.clear();
+            (void)entry->data.reserve(size);
+
+            for(idx = 0U; idx < size; ++idx)
+            {
+                entry->data += data[idx];
+            }
+
+            entry->lastUsed = ++m_usageCounter;
+            m_isDirty       = true;
+            isSuccessful    = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool HttpCache::getData(const String& url, String& data)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isAvailable = false;
+    Entry*                      entry       = find(url);
+
+    if ((nullptr != entry) &&
+        (false == entry->data.isEmpty()))
+    {
+        data            = entry->data;
+        entry->lastUsed = ++m_usageCounter;
+        isAvailable     = true;
+    }
+
+    return isAvailable;
+}
+
+void HttpCache::remove(const String& url)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    Entry*                      entry   = find(url);
+
+    if (nullptr != entry)
+    {
+        /* Only entries with data are persistent. */
+        if (false == entry->data.isEmpty())
+        {
+            m_isDirty = true;
+        }
+
+        *entry = Entry();
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+HttpCache::Entry* HttpCache::find(const String& url)
+{
+    Entry*  entry   = nullptr;
+    uint8_t idx     = 0U;
+
+    if (false == url.isEmpty())
+    {
+        for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+        {
+            if (url == m_entries[idx].url)
+            {
+                entry = &m_entries[idx];
+                break;
+            }
+        }
+    }
+
+    return entry;
+}
+
+HttpCache::Entry& HttpCache::acquire(const String& url)
+{
+    Entry* entry = find(url);
+
+    if (nullptr == entry)
+    {
+        uint8_t idx = 0U;
+
+        entry = &m_entries[0U];
+
+        /* Prefer a free entry, otherwise replace the least recently used one. */
+        for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+        {
+            if (true == m_entries[idx].url.isEmpty())
+            {
+                entry = &m_entries[idx];
+                break;
+            }
+
+            if ((m_usageCounter - m_entries[idx].lastUsed) > (m_usageCounter - entry->lastUsed))
+            {
+                entry = &m_entries[idx];
+            }
+        }
+
+        if (false == entry->data.isEmpty())
+        {
+            m_isDirty = true;
+        }
+
+        *entry      = Entry();
+        entry->url  = url;
+    }
+
+    return *entry;
+}
+
+void HttpCache::load()
+{
+    JsonFile            jsonFile(FILESYSTEM);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+
+    if (false == jsonFile.load(FILE_NAME, jsonDoc))
+    {
+        LOG_INFO("No HTTP cache available.");
+    }
+    else
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        JsonArray                   jsonEntries = jsonDoc["entries"];
+        uint8_t                     cnt         = 0U;
+
+        for(JsonObject jsonEntry: jsonEntries)
+        {
+            String url  = jsonEntry["url"] | "";
+            String data = jsonEntry["data"] | "";
+
+            /* Entries, which were updated meanwhile, are more recent. */
+            if ((MAX_ENTRIES > cnt) &&
+                (false == url.isEmpty()) &&
+                (false == data.isEmpty()) &&
+                (nullptr == find(url)))
+            {
+                Entry& entry = acquire(url);
+
+                entry.etag          = jsonEntry["etag"] | "";
+                entry.lastModified  = jsonEntry["lastModified"] | "";
+                entry.data          = data;
+                entry.lastUsed      = ++m_usageCounter;
+
+                ++cnt;
+            }
+        }
+
+        LOG_INFO("HTTP cache loaded with %u entries.", cnt);
+    }
+}
+
+void HttpCache::save()
+{
+    JsonFile            jsonFile(FILESYSTEM);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+    JsonArray           jsonEntries = jsonDoc.createNestedArray("entries");
+
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        uint8_t                     idx     = 0U;
+
+        /* Validators without data are useless after a restart. */
+        for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+        {
+            const Entry& entry = m_entries[idx];
+
+            if ((false == entry.url.isEmpty()) &&
+                (false == entry.data.isEmpty()))
+            {
+                JsonObject jsonEntry = jsonEntries.createNestedObject();
+
+                jsonEntry["url"]            = entry.url;
+                jsonEntry["etag"]           = entry.etag;
+                jsonEntry["lastModified"]   = entry.lastModified;
+                jsonEntry["data"]           = entry.data;
+            }
+        }
+    }
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("Less memory for HTTP cache available.");
+    }
+    else if (false == jsonFile.save(FILE_NAME, jsonDoc))
+    {
+        LOG_WARNING("Failed to save file %s.", FILE_NAME);
+    }
+    else
+    {
+        LOG_INFO("File %s saved.", FILE_NAME);
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
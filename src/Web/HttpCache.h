@@ -0,0 +1,242 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __HTTP_CACHE_H__
+#define __HTTP_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+#include <Mutex.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The HTTP cache keeps the validators (ETag and Last-Modified) of the last
+ * successful response per URL, together with the processed response data,
+ * e.g. the filtered JSON text. With it the next request can be sent
+ * conditional and if the server responds with "304 Not Modified", the
+ * cached data is used instead of receiving and parsing the whole body again.
+ *
+ * The cache is persisted in the filesystem, so the data is available after
+ * a restart too. Loading and saving takes only place in process().
+ */
+class HttpCache
+{
+public:
+
+    /**
+     * Get HTTP cache instance.
+     *
+     * @return HTTP cache instance
+     */
+    static HttpCache& getInstance()
+    {
+        static HttpCache instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Process the HTTP cache. Call it cyclic in the main loop context.
+     * It loads the cache from the filesystem once and saves it after changes.
+     */
+    void process();
+
+    /**
+     * Get the validators of a URL. They are only provided, if the data is
+     * cached as well, otherwise a "304 Not Modified" response would be useless.
+     *
+     * @param[in]   url             URL
+     * @param[out]  etag            Entity tag, may be empty.
+     * @param[out]  lastModified    Last modification date, may be empty.
+     *
+     * @return If validators are available, it will return true otherwise false.
+     */
+    bool getValidators(const String& url, String& etag, String& lastModified);
+
+    /**
+     * Set the validators of a URL after a successful response. Any cached
+     * data of the URL is invalidated, because it belongs to the former
+     * response. Without any validator, the URL is removed from the cache.
+     *
+     * @param[in] url           URL
+     * @param[in] etag          Entity tag, may be empty.
+     * @param[in] lastModified  Last modification date, may be empty.
+     */
+    void setValidators(const String& url, const String& etag, const String& lastModified);
+
+    /**
+     * Set the data of a URL, which belongs to the current validators.
+     *
+     * @param[in] url   URL
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return If successful cached, it will return true otherwise false.
+     */
+    bool setData(const String& url, const char* data, size_t size);
+
+    /**
+     * Get the data of a URL.
+     *
+     * @param[in]   url     URL
+     * @param[out]  data    Data
+     *
+     * @return If data is available, it will return true otherwise false.
+     */
+    bool getData(const String& url, String& data);
+
+    /**
+     * Remove a URL from the cache, e.g. if the cached data was not accepted.
+     *
+     * @param[in] url   URL
+     */
+    void remove(const String& url);
+
+    /** Max. number of cached URLs. */
+    static const uint8_t    MAX_ENTRIES     = 8U;
+
+    /** Max. data size in byte per URL. */
+    static const size_t     MAX_DATA_SIZE   = 512U;
+
+    /** Full path to the cache file. */
+    static const char*      FILE_NAME;
+
+private:
+
+    /**
+     * A single cache entry.
+     */
+    struct Entry
+    {
+        String      url;            /**< URL, empty if not used. */
+        String      etag;           /**< Entity tag */
+        String      lastModified;   /**< Last modification date */
+        String      data;           /**< Cached data */
+        uint32_t    lastUsed;       /**< Usage counter value of the last access, used to replace the least recently used entry. */
+
+        /**
+         * Constructs a empty entry.
+         */
+        Entry() :
+            url(),
+            etag(),
+            lastModified(),
+            data(),
+            lastUsed(0U)
+        {
+        }
+    };
+
+    mutable MutexRecursive  m_mutex;                /**< Mutex to protect against concurrent access. */
+    Entry                   m_entries[MAX_ENTRIES]; /**< Cache entries */
+    uint32_t                m_usageCounter;         /**< Incremented with every access, used for the replacement strategy. */
+    bool                    m_isLoaded;             /**< Is the cache loaded from the filesystem? */
+    bool                    m_isDirty;              /**< Does the cache file need to be written? */
+
+    /**
+     * Constructs the HTTP cache.
+     */
+    HttpCache() :
+        m_mutex(),
+        m_entries(),
+        m_usageCounter(0U),
+        m_isLoaded(false),
+        m_isDirty(false)
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the HTTP cache.
+     */
+    ~HttpCache()
+    {
+        m_mutex.destroy();
+    }
+
+    HttpCache(const HttpCache& cache);
+    HttpCache& operator=(const HttpCache& cache);
+
+    /**
+     * Find the entry of a URL.
+     *
+     * @param[in] url   URL
+     *
+     * @return If found, it will return the entry otherwise nullptr.
+     */
+    Entry* find(const String& url);
+
+    /**
+     * Get the entry of a URL. If the URL is not cached yet, a free or the
+     * least recently used entry is taken.
+     *
+     * @param[in] url   URL
+     *
+     * @return Entry
+     */
+    Entry& acquire(const String& url);
+
+    /**
+     * Load the cache from the filesystem.
+     */
+    void load();
+
+    /**
+     * Save the cache to the filesystem.
+     */
+    void save();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HTTP_CACHE_H__ */
+
+/** @} */
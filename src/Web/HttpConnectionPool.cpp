@@ -0,0 +1,509 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP connection pool
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HttpConnectionPool.h"
+#include "AsyncHttpClient.h"
+#include "DnsResolver.h"
+
+#include <Arduino.h>
+#include <Util.h>
+#include <Logging.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+AsyncClient* HttpConnectionPool::acquire(const String& host, uint16_t port, bool isSecure, AsyncHttpClient* owner)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    AsyncClient*                client  = m_pool.acquireIdle(host.c_str(), port, isSecure, owner);
+
+    if (nullptr != client)
+    {
+        ++m_reusedCnt;
+
+        if (true == isSecure)
+        {
+            ++getTlsEntry(host, port).statistics.reused;
+        }
+
+        LOG_INFO("Reuse connection to %s:%u (created: %u, reused: %u).", host.c_str(), port, m_createdCnt, m_reusedCnt);
+    }
+    else
+    {
+        client = createClient();
+
+        if (nullptr == client)
+        {
+            LOG_ERROR("Couldn't create connection.");
+        }
+        else
+        {
+            bool isAdded = m_pool.add(client, host.c_str(), port, isSecure, owner);
+
+            /* All connections used? Make room by closing the connection,
+             * which is idle for the longest time.
+             */
+            if ((false == isAdded) &&
+                (MAX_CONNS <= m_pool.getCount()))
+            {
+                AsyncClient* idleClient = m_pool.getOldestIdle(millis());
+
+                if (nullptr != idleClient)
+                {
+                    /* The pool removes it in the disconnect event. */
+                    idleClient->close(true);
+
+                    isAdded = m_pool.add(client, host.c_str(), port, isSecure, owner);
+                }
+            }
+
+            if (false == isAdded)
+            {
+                LOG_WARNING("Connection limit to %s:%u reached.", host.c_str(), port);
+
+                delete client;
+                client = nullptr;
+            }
+            else
+            {
+                if (true == isSecure)
+                {
+                    startHandshake(client, host, port);
+                }
+
+                if (false == connect(client, host, port, isSecure))
+                {
+                    LOG_WARNING("Couldn't connect to %s:%u.", host.c_str(), port);
+
+                    finishHandshake(client, false);
+                    (void)m_pool.remove(client);
+                    delete client;
+                    client = nullptr;
+                }
+                else
+                {
+                    ++m_createdCnt;
+                }
+            }
+        }
+    }
+
+    return client;
+}
+
+bool HttpConnectionPool::release(AsyncClient* client)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isReleased  = false;
+
+    if ((nullptr != client) &&
+        (true == client->connected()))
+    {
+        isReleased = m_pool.release(client, millis());
+    }
+
+    return isReleased;
+}
+
+void HttpConnectionPool::abort(AsyncClient* client, const AsyncHttpClient* owner)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if ((nullptr != client) &&
+        (nullptr != owner) &&
+        (owner == m_pool.getOwner(client)))
+    {
+        /* Detach first to avoid any follow up event to the owner. */
+        m_pool.detach(owner);
+        client->abort();
+    }
+}
+
+bool HttpConnectionPool::getTlsStatistics(uint8_t index, TlsStatistics& statistics) const
+{
+    bool isSuccessful = false;
+
+    if (TLS_STATISTICS_CNT > index)
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        if (false == m_tlsEntries[index].statistics.host.isEmpty())
+        {
+            statistics      = m_tlsEntries[index].statistics;
+            isSuccessful    = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+AsyncClient* HttpConnectionPool::createClient()
+{
+    AsyncClient* tcpClient = new(std::nothrow) AsyncClient();
+
+    if (nullptr != tcpClient)
+    {
+        tcpClient->onConnect(  [this](void* arg, AsyncClient* client)
+                               {
+                                   UTIL_NOT_USED(arg);
+
+                                   onConnect(client);
+                               });
+
+        tcpClient->onDisconnect(   [this](void* arg, AsyncClient* client)
+                                   {
+                                       UTIL_NOT_USED(arg);
+
+                                       onDisconnect(client);
+                                   });
+
+        tcpClient->onError(    [this](void* arg, AsyncClient* client, int8_t error)
+                               {
+                                   UTIL_NOT_USED(arg);
+
+                                   onError(client, error);
+                               });
+
+        tcpClient->onData( [this](void* arg, AsyncClient* client, void* data, size_t len)
+                           {
+                               UTIL_NOT_USED(arg);
+
+                               onData(client, static_cast<uint8_t*>(data), len);
+                           });
+
+        tcpClient->onTimeout(  [this](void* arg, AsyncClient* client, uint32_t timeout)
+                               {
+                                   UTIL_NOT_USED(arg);
+
+                                   onTimeout(client, timeout);
+                               });
+
+        tcpClient->onPoll( [this](void* arg, AsyncClient* client)
+                           {
+                               UTIL_NOT_USED(arg);
+
+                               onPoll(client);
+                           });
+    }
+
+    return tcpClient;
+}
+
+HttpConnectionPool::TlsEntry& HttpConnectionPool::getTlsEntry(const String& host, uint16_t port)
+{
+    uint32_t    timestamp   = millis();
+    TlsEntry*   entry       = nullptr;
+    uint8_t     idx         = 0U;
+
+    while((TLS_STATISTICS_CNT > idx) && (nullptr == entry))
+    {
+        if ((port == m_tlsEntries[idx].statistics.port) &&
+            (host == m_tlsEntries[idx].statistics.host))
+        {
+            entry = &m_tlsEntries[idx];
+        }
+
+        ++idx;
+    }
+
+    /* Replace the unused entry or the one, which was not used for the longest time. */
+    if (nullptr == entry)
+    {
+        entry = &m_tlsEntries[0U];
+
+        for(idx = 1U; idx < TLS_STATISTICS_CNT; ++idx)
+        {
+            if (true == entry->statistics.host.isEmpty())
+            {
+                break;
+            }
+
+            if ((true == m_tlsEntries[idx].statistics.host.isEmpty()) ||
+                ((timestamp - entry->lastUsed) < (timestamp - m_tlsEntries[idx].lastUsed)))
+            {
+                entry = &m_tlsEntries[idx];
+            }
+        }
+
+        *entry                  = TlsEntry();
+        entry->statistics.host  = host;
+        entry->statistics.port  = port;
+    }
+
+    entry->lastUsed = timestamp;
+
+    return *entry;
+}
+
+bool HttpConnectionPool::connect(AsyncClient* client, const String& host, uint16_t port, bool isSecure)
+{
+    bool                isStarted   = false;
+    IPAddress           address;
+    DnsCache::Result    result      = DnsResolver::getInstance().resolve(host, address);
+
+    if (DnsCache::RESULT_FAILED == result)
+    {
+        LOG_WARNING("Host %s is unknown.", host.c_str());
+    }
+    else if ((false == isSecure) &&
+             (DnsCache::RESULT_RESOLVED == result))
+    {
+        isStarted = client->connect(address, port, false);
+    }
+    else
+    {
+        isStarted = client->connect(host.c_str(), port, isSecure);
+    }
+
+    return isStarted;
+}
+
+void HttpConnectionPool::startHandshake(AsyncClient* client, const String& host, uint16_t port)
+{
+    uint8_t idx = 0U;
+
+    while(MAX_CONNS > idx)
+    {
+        Handshake& handshake = m_handshakes[idx];
+
+        if (nullptr == handshake.client)
+        {
+            handshake.client    = client;
+            handshake.host      = host;
+            handshake.port      = port;
+            handshake.timestamp = millis();
+            handshake.freeHeap  = ESP.getFreeHeap();
+            break;
+        }
+
+        ++idx;
+    }
+}
+
+void HttpConnectionPool::finishHandshake(AsyncClient* client, bool isConnected)
+{
+    uint8_t idx = 0U;
+
+    if (nullptr == client)
+    {
+        return;
+    }
+
+    for(idx = 0U; idx < MAX_CONNS; ++idx)
+    {
+        Handshake& handshake = m_handshakes[idx];
+
+        if (client == handshake.client)
+        {
+            if (true == isConnected)
+            {
+                TlsEntry&       entry       = getTlsEntry(handshake.host, handshake.port);
+                TlsStatistics&  statistics  = entry.statistics;
+                uint32_t        duration    = millis() - handshake.timestamp;
+                uint32_t        freeHeap    = ESP.getFreeHeap();
+                uint32_t        heap        = 0U;
+
+                if (handshake.freeHeap > freeHeap)
+                {
+                    heap = handshake.freeHeap - freeHeap;
+                }
+
+                ++statistics.handshakes;
+                entry.durationSum       += duration;
+                statistics.durationAvg  = entry.durationSum / statistics.handshakes;
+
+                if (statistics.durationMax < duration)
+                {
+                    statistics.durationMax = duration;
+                }
+
+                if (statistics.heapMax < heap)
+                {
+                    statistics.heapMax = heap;
+                }
+
+                LOG_INFO("Secure connection to %s:%u established in %u ms, heap %u byte.", handshake.host.c_str(), handshake.port, duration, heap);
+                LOG_INFO("Handshakes: %u, reused: %u", statistics.handshakes, statistics.reused);
+            }
+
+            handshake.client = nullptr;
+            handshake.host.clear();
+        }
+    }
+}
+
+void HttpConnectionPool::onConnect(AsyncClient* client)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    AsyncHttpClient*            owner   = m_pool.getOwner(client);
+
+    finishHandshake(client, true);
+
+    if (nullptr != owner)
+    {
+        owner->onConnect(client);
+    }
+    /* The owner aborted the connection meanwhile. */
+    else
+    {
+        client->close(true);
+    }
+}
+
+void HttpConnectionPool::onDisconnect(AsyncClient* client)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    AsyncHttpClient*            owner   = m_pool.getOwner(client);
+
+    finishHandshake(client, false);
+
+    if (nullptr != owner)
+    {
+        owner->onDisconnect(client);
+    }
+    else if (true == m_pool.isIdle(client))
+    {
+        LOG_INFO("Idle connection closed.");
+    }
+
+    (void)m_pool.remove(client);
+
+    /* The TCP client is not used anymore after the disconnect event,
+     * therefore its safe to destroy it here.
+     */
+    delete client;
+}
+
+void HttpConnectionPool::onError(AsyncClient* client, int8_t error)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    AsyncHttpClient*            owner   = m_pool.getOwner(client);
+
+    /* Connection establishment failed, the cached address may be outdated. */
+    if (false == client->connected())
+    {
+        const char* host = m_pool.getHost(client);
+
+        if (nullptr != host)
+        {
+            DnsResolver::getInstance().invalidate(host);
+        }
+    }
+
+    if (nullptr != owner)
+    {
+        owner->onError(client, error);
+    }
+}
+
+void HttpConnectionPool::onData(AsyncClient* client, const uint8_t* data, size_t len)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    AsyncHttpClient*            owner   = m_pool.getOwner(client);
+
+    if (nullptr != owner)
+    {
+        owner->onData(client, data, len);
+    }
+    /* Nobody waits for data on a idle connection. */
+    else
+    {
+        LOG_WARNING("Unexpected data on idle connection.");
+        client->close();
+    }
+}
+
+void HttpConnectionPool::onTimeout(AsyncClient* client, uint32_t timeout)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    AsyncHttpClient*            owner   = m_pool.getOwner(client);
+
+    if (nullptr != owner)
+    {
+        owner->onTimeout(client, timeout);
+    }
+    else
+    {
+        client->close();
+    }
+}
+
+void HttpConnectionPool::onPoll(AsyncClient* client)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if (true == m_pool.isIdleExpired(client, millis()))
+    {
+        LOG_INFO("Close idle connection.");
+        client->close();
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
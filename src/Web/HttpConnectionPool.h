@@ -0,0 +1,355 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP connection pool
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __HTTP_CONNECTION_POOL_H__
+#define __HTTP_CONNECTION_POOL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <AsyncTCP.h>
+#include <WString.h>
+#include <Mutex.hpp>
+#include <ConnectionPool.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+class AsyncHttpClient;
+
+/**
+ * The HTTP connection pool is shared by all asynchronous HTTP clients.
+ * It owns the TCP connections and keeps them alive after a response, so the
+ * next request to the same host, port and protocol skips the connection
+ * establishment. Idle connections are closed after the idle timeout.
+ *
+ * All TCP client events are forwarded to the HTTP client, which uses the
+ * connection currently.
+ *
+ * For secure connections the pool tracks per host how long the connection
+ * establishment incl. the TLS handshake takes and how much heap it costs.
+ * A secure connection, which is taken from the pool, counts as reused,
+ * because it saves the handshake.
+ */
+class HttpConnectionPool
+{
+public:
+
+    /** Max. number of hosts with TLS statistics. */
+    static const uint8_t TLS_STATISTICS_CNT = 4U;
+
+    /**
+     * TLS statistics of a single host.
+     */
+    struct TlsStatistics
+    {
+        String      host;               /**< Host name, empty if not used. */
+        uint16_t    port;               /**< Port */
+        uint32_t    handshakes;         /**< Number of connection establishments with full handshake */
+        uint32_t    reused;             /**< Number of requests, which reused a connection without handshake */
+        uint32_t    durationAvg;        /**< Average duration of a connection establishment in ms */
+        uint32_t    durationMax;        /**< Max. duration of a connection establishment in ms */
+        uint32_t    heapMax;            /**< Max. heap in byte, which a connection consumed after establishment */
+    };
+
+    /**
+     * Get HTTP connection pool instance.
+     *
+     * @return HTTP connection pool instance
+     */
+    static HttpConnectionPool& getInstance()
+    {
+        static HttpConnectionPool instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Acquire a connection to the host. A idle connection is preferred,
+     * which is already connected. Otherwise a new and not connected one
+     * is provided.
+     *
+     * @param[in] host      Host name
+     * @param[in] port      Port
+     * @param[in] isSecure  Secure connection or not
+     * @param[in] owner     HTTP client, which will use the connection.
+     *
+     * @return If the connection limits are not reached, it will return the connection otherwise nullptr.
+     */
+    AsyncClient* acquire(const String& host, uint16_t port, bool isSecure, AsyncHttpClient* owner);
+
+    /**
+     * Release a connection after a complete response. It will be kept alive
+     * for the next request.
+     *
+     * @param[in] client    TCP client
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool release(AsyncClient* client);
+
+    /**
+     * Abort a connection (non-gracefully). The owner won't get any follow up
+     * event of the connection.
+     *
+     * @param[in] client    TCP client
+     * @param[in] owner     HTTP client, which uses the connection.
+     */
+    void abort(AsyncClient* client, const AsyncHttpClient* owner);
+
+    /**
+     * Get TLS statistics of a host.
+     * The hosts, which were not used for the longest time, are replaced.
+     *
+     * @param[in]   index       Index [0; TLS_STATISTICS_CNT - 1]
+     * @param[out]  statistics  Statistics
+     *
+     * @return If the statistics entry is used, it will return true otherwise false.
+     */
+    bool getTlsStatistics(uint8_t index, TlsStatistics& statistics) const;
+
+    /** Max. number of connections in total. */
+    static const size_t     MAX_CONNS           = 8U;
+
+    /** Max. number of connections per host. */
+    static const size_t     MAX_CONNS_PER_HOST  = 2U;
+
+    /** Idle connections are closed after this timeout in ms. */
+    static const uint32_t   IDLE_TIMEOUT        = 10000U;
+
+private:
+
+    /** Connection pool bookkeeping */
+    typedef ConnectionPool<AsyncClient, AsyncHttpClient, MAX_CONNS> Pool;
+
+    /**
+     * A pending establishment of a secure connection.
+     */
+    struct Handshake
+    {
+        AsyncClient*    client;     /**< TCP client, nullptr if not used. */
+        String          host;       /**< Host name */
+        uint16_t        port;       /**< Port */
+        uint32_t        timestamp;  /**< Timestamp in ms, when the connection establishment started. */
+        uint32_t        freeHeap;   /**< Free heap in byte, when the connection establishment started. */
+
+        /**
+         * Constructs a unused entry.
+         */
+        Handshake() :
+            client(nullptr),
+            host(),
+            port(0U),
+            timestamp(0U),
+            freeHeap(0U)
+        {
+        }
+    };
+
+    /**
+     * TLS statistics entry of a host.
+     */
+    struct TlsEntry
+    {
+        TlsStatistics   statistics;     /**< Statistics */
+        uint32_t        durationSum;    /**< Sum of all connection establishment durations in ms */
+        uint32_t        lastUsed;       /**< Timestamp in ms, when the host was used last time. */
+
+        /**
+         * Constructs a unused entry.
+         */
+        TlsEntry() :
+            statistics(),
+            durationSum(0U),
+            lastUsed(0U)
+        {
+            statistics.port         = 0U;
+            statistics.handshakes   = 0U;
+            statistics.reused       = 0U;
+            statistics.durationAvg  = 0U;
+            statistics.durationMax  = 0U;
+            statistics.heapMax      = 0U;
+        }
+    };
+
+    mutable MutexRecursive  m_mutex;                            /**< Mutex to protect against concurrent access. */
+    Pool                    m_pool;                             /**< Connections */
+    uint32_t                m_createdCnt;                       /**< Number of established connections */
+    uint32_t                m_reusedCnt;                        /**< Number of reused connections */
+    Handshake               m_handshakes[MAX_CONNS];            /**< Pending establishments of secure connections */
+    TlsEntry                m_tlsEntries[TLS_STATISTICS_CNT];   /**< TLS statistics per host */
+
+    /**
+     * Constructs the HTTP connection pool.
+     */
+    HttpConnectionPool() :
+        m_mutex(),
+        m_pool(MAX_CONNS_PER_HOST, IDLE_TIMEOUT),
+        m_createdCnt(0U),
+        m_reusedCnt(0U),
+        m_handshakes(),
+        m_tlsEntries()
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the HTTP connection pool.
+     */
+    ~HttpConnectionPool()
+    {
+        m_mutex.destroy();
+    }
+
+    HttpConnectionPool(const HttpConnectionPool& pool);
+    HttpConnectionPool& operator=(const HttpConnectionPool& pool);
+
+    /**
+     * Create a new TCP client, which events are handled by the pool.
+     *
+     * @return TCP client or nullptr, if out of memory.
+     */
+    AsyncClient* createClient();
+
+    /**
+     * Connect a TCP client to the host. A plain connection uses the cached
+     * address of the host, if available. A secure connection always
+     * connects via host name, because it is required for the TLS
+     * handshake. If resolving the host failed recently, no connection
+     * attempt is made.
+     *
+     * @param[in] client    TCP client
+     * @param[in] host      Host name
+     * @param[in] port      Port
+     * @param[in] isSecure  Secure connection or not
+     *
+     * @return If connection establishment is started, it will return true otherwise false.
+     */
+    bool connect(AsyncClient* client, const String& host, uint16_t port, bool isSecure);
+
+    /**
+     * Get the TLS statistics entry of a host. If the host has no entry yet,
+     * the entry, which was not used for the longest time, is taken.
+     *
+     * @param[in] host  Host name
+     * @param[in] port  Port
+     *
+     * @return TLS statistics entry
+     */
+    TlsEntry& getTlsEntry(const String& host, uint16_t port);
+
+    /**
+     * Start measuring the establishment of a secure connection.
+     *
+     * @param[in] client    TCP client
+     * @param[in] host      Host name
+     * @param[in] port      Port
+     */
+    void startHandshake(AsyncClient* client, const String& host, uint16_t port);
+
+    /**
+     * Finish measuring the establishment of a secure connection.
+     *
+     * @param[in] client        TCP client
+     * @param[in] isConnected   Is the connection established or failed?
+     */
+    void finishHandshake(AsyncClient* client, bool isConnected);
+
+    /**
+     * This method is called by the TCP client if a connection is successful established.
+     *
+     * @param[in] client    TCP client
+     */
+    void onConnect(AsyncClient* client);
+
+    /**
+     * This method is called by the TCP client if a connection is disconnected.
+     * The TCP client is destroyed afterwards.
+     *
+     * @param[in] client    TCP client
+     */
+    void onDisconnect(AsyncClient* client);
+
+    /**
+     * This method is called by the TCP client if a error occurred.
+     *
+     * @param[in] client    TCP client
+     * @param[in] error     Error id
+     */
+    void onError(AsyncClient* client, int8_t error);
+
+    /**
+     * This method is called by the TCP client if data is received.
+     *
+     * @param[in] client    TCP client
+     * @param[in] data      Data stream
+     * @param[in] len       Data size in byte
+     */
+    void onData(AsyncClient* client, const uint8_t* data, size_t len);
+
+    /**
+     * This method is called by the TCP client if ACK timeout happens.
+     *
+     * @param[in] client    TCP client
+     * @param[in] timeout   Timeout value in ms
+     */
+    void onTimeout(AsyncClient* client, uint32_t timeout);
+
+    /**
+     * This method is called by the TCP client periodically.
+     * It is used to close idle connections after the idle timeout.
+     *
+     * @param[in] client    TCP client
+     */
+    void onPoll(AsyncClient* client);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HTTP_CONNECTION_POOL_H__ */
+
+/** @} */
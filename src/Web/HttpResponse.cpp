@@ -34,6 +34,7 @@
  *****************************************************************************/
 #include "HttpResponse.h"
 #include <new>
+#include <Logging.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -68,28 +69,7 @@ HttpResponse& HttpResponse::operator=(const HttpResponse& rsp)
         m_httpVersion   = rsp.m_httpVersion;
         m_statusCode    = rsp.m_statusCode;
         m_reasonPhrase  = rsp.m_reasonPhrase;
-
-        if (nullptr != m_payload)
-        {
-            delete[] m_payload;
-        }
-
-        if (nullptr != rsp.m_payload)
-        {
-            m_payload = new(std::nothrow) uint8_t[rsp.m_size];
-
-            if (nullptr == m_payload)
-            {
-                m_size = 0U;
-                m_wrIndex = 0U;
-            }
-            else
-            {
-                memcpy(m_payload, rsp.m_payload, rsp.m_size);
-                m_size = rsp.m_size;
-                m_wrIndex = rsp.m_wrIndex;
-            }
-        }
+        m_payload       = rsp.m_payload;
 
         if (true == it.first())
         {
@@ -113,49 +93,19 @@ HttpResponse& HttpResponse::operator=(const HttpResponse& rsp)
 void HttpResponse::clear()
 {
     clearHeaders();
-    clearPayload();
-    m_wrIndex = 0U;
+    m_payload.clear();
 }
 
-void HttpResponse::addStatusLine(const String& line)
+void HttpResponse::setStatusLine(const String& httpVersion, uint16_t statusCode, const String& reasonPhrase)
 {
-    const char* SP          = " ";
-    int         idx         = 0;
-    int         begin       = 0;
-    String      statusCode;
-
-    /* Status-Line = HTTP-Version SP Status-Code SP Reason-Phrase CRLF */
-
-    /* HTTP-Version */
-    idx             = line.indexOf(SP);
-    m_httpVersion   = line.substring(begin, idx);
-
-    /* Overstep all spaces */
-    while(('\0' != line[idx]) && (' ' == line[idx]))
-    {
-        ++idx;
-    }
-    begin = idx;
-
-    /* Status-Code */
-    idx             = line.indexOf(SP, begin);
-    statusCode      = line.substring(begin, idx);
-    m_statusCode    = statusCode.toInt();
-
-    /* Overstep all spaces */
-    while(('\0' != line[idx]) && (' ' == line[idx]))
-    {
-        ++idx;
-    }
-    begin = idx;
-
-    /* Reason-Phrase */
-    m_reasonPhrase  = line.substring(begin);
+    m_httpVersion   = httpVersion;
+    m_statusCode    = statusCode;
+    m_reasonPhrase  = reasonPhrase;
 }
 
-void HttpResponse::addHeader(const String& line)
+void HttpResponse::addHeader(const String& name, const String& value)
 {
-    HttpHeader* header = new(std::nothrow) HttpHeader(line);
+    HttpHeader* header = new(std::nothrow) HttpHeader(name, value);
 
     if (nullptr != header)
     {
@@ -165,40 +115,17 @@ void HttpResponse::addHeader(const String& line)
 
 void HttpResponse::extendPayload(size_t size)
 {
-    uint8_t* tmp = m_payload;
-
-    m_payload = new(std::nothrow) uint8_t[m_size + size];
-
-    if (nullptr != m_payload)
-    {
-        m_size += size;
-    }
-
-    if ((nullptr != m_payload) &&
-        (nullptr != tmp))
-    {
-        memcpy(m_payload, tmp, m_wrIndex);
-    }
-
-    if (nullptr != tmp)
+    if (false == m_payload.reserve(m_payload.getSize() + size))
     {
-        delete[] tmp;
+        LOG_WARNING("Failed to reserve %u bytes payload.", m_payload.getSize() + size);
     }
 }
 
 void HttpResponse::addPayload(const uint8_t* payload, size_t size)
 {
-    if ((nullptr == m_payload) ||
-        ((m_size - m_wrIndex) < size))
+    if (false == m_payload.append(payload, size))
     {
-        extendPayload(size);
-    }
-
-    if ((nullptr != m_payload) &&
-        ((m_size - m_wrIndex) >= size))
-    {
-        memcpy(&m_payload[m_wrIndex], payload, size);
-        m_wrIndex += size;
+        LOG_ERROR("Payload dropped, size %u exceeds max. %u bytes or out of memory.", m_payload.getSize() + size, m_payload.getMaxSize());
     }
 }
 
@@ -217,10 +144,10 @@ String HttpResponse::getReasonPhrase() const
     return m_reasonPhrase;
 }
 
-String HttpResponse::getHeader(const String& name)
+String HttpResponse::getHeader(const String& name) const
 {
-    String                              value;
-    DLinkedListIterator<HttpHeader*>    it(m_headers);
+    String                                  value;
+    DLinkedListConstIterator<HttpHeader*>   it(m_headers);
 
     if (true == it.first())
     {
@@ -247,8 +174,8 @@ String HttpResponse::getHeader(const String& name)
 
 const uint8_t* HttpResponse::getPayload(size_t& size) const
 {
-    size = m_size;
-    return m_payload;
+    size = m_payload.getSize();
+    return m_payload.getData();
 }
 
 /******************************************************************************
@@ -272,17 +199,6 @@ void HttpResponse::clearHeaders()
     }
 }
 
-void HttpResponse::clearPayload()
-{
-    if (nullptr != m_payload)
-    {
-        delete[] m_payload;
-        m_payload = nullptr;
-    }
-
-    m_size = 0U;
-}
-
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include <WString.h>
 #include <LinkedList.hpp>
+#include <GrowBuffer.h>
 
 #include "HttpHeader.h"
 
@@ -71,9 +72,7 @@ public:
         m_statusCode(0U),
         m_reasonPhrase(),
         m_headers(),
-        m_payload(nullptr),
-        m_size(0U),
-        m_wrIndex(0U)
+        m_payload(PAYLOAD_SIZE_MAX)
     {
     }
 
@@ -95,9 +94,7 @@ public:
         m_statusCode(0U),
         m_reasonPhrase(),
         m_headers(),
-        m_payload(nullptr),
-        m_size(0U),
-        m_wrIndex(0U)
+        m_payload(PAYLOAD_SIZE_MAX)
     {
         *this = rsp;
     }
@@ -117,21 +114,25 @@ public:
     void clear();
 
     /**
-     * Add status line during parsing the response.
+     * Set status line during parsing the response.
      *
-     * @param[in] line  Status line
+     * @param[in] httpVersion   HTTP version, e.g. "HTTP/1.1"
+     * @param[in] statusCode    Status code
+     * @param[in] reasonPhrase  Reason phrase
      */
-    void addStatusLine(const String& line);
+    void setStatusLine(const String& httpVersion, uint16_t statusCode, const String& reasonPhrase);
 
     /**
      * Add header during parsing the response.
      *
-     * @param[in] line  Single header line
+     * @param[in] name  Header name
+     * @param[in] value Header value
      */
-    void addHeader(const String& line);
+    void addHeader(const String& name, const String& value);
 
     /**
-     * Extend payload size in bytes.
+     * Extend payload capacity in bytes. Use it if the payload size is known
+     * in advance, to avoid reallocations while the payload is added.
      *
      * @param[in] size  Size in bytes
      */
@@ -139,6 +140,7 @@ public:
 
     /**
      * Add a complete payload or add it several times partly.
+     * The payload capacity grows geometrically, up to PAYLOAD_SIZE_MAX.
      *
      * @param[in] payload   Complete or partly payload
      * @param[in] size      Payload size in byte
@@ -171,7 +173,7 @@ public:
      *
      * @param[in] name  Field name
      */
-    String getHeader(const String& name);
+    String getHeader(const String& name) const;
 
     /**
      * Get payload.
@@ -182,25 +184,21 @@ public:
      */
     const uint8_t* getPayload(size_t& size) const;
 
+    /** Max. payload size in byte. */
+    static const size_t PAYLOAD_SIZE_MAX    = GrowBuffer::DEFAULT_MAX_SIZE;
+
 private:
 
     String                      m_httpVersion;  /**< HTTP version */
     uint16_t                    m_statusCode;   /**< Status code */
     String                      m_reasonPhrase; /**< Reason phrase */
     DLinkedList<HttpHeader*>    m_headers;      /**< List of headers */
-    uint8_t*                    m_payload;      /**< Payload */
-    size_t                      m_size;         /**< Payload size in byte */
-    size_t                      m_wrIndex;      /**< Payload write index */
+    GrowBuffer                  m_payload;      /**< Payload */
 
     /**
      * Clear headers.
      */
     void clearHeaders();
-
-    /**
-     * Clears the payload.
-     */
-    void clearPayload();
 };
 
 /******************************************************************************
@@ -0,0 +1,238 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  JSON document web response
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "JsonDocResponse.h"
+
+#include <Esp.h>
+#include <Print.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Print destination, which writes only a part of the printed data to a buffer.
+ * All data before the offset is dropped, as well as all data which doesn't
+ * fit into the buffer anymore.
+ */
+class PartPrint : public Print
+{
+public:
+
+    /**
+     * Constructs the print destination.
+     *
+     * @param[in] buffer    Destination buffer
+     * @param[in] size      Destination buffer size in byte
+     * @param[in] offset    Number of bytes, which to drop first.
+     */
+    PartPrint(uint8_t* buffer, size_t size, size_t offset) :
+        Print(),
+        m_buffer(buffer),
+        m_size(size),
+        m_offset(offset),
+        m_written(0U)
+    {
+    }
+
+    /**
+     * Destroys the print destination.
+     */
+    ~PartPrint()
+    {
+    }
+
+    /**
+     * Write a single byte.
+     *
+     * @param[in] data  Byte
+     *
+     * @return Number of handled bytes
+     */
+    size_t write(uint8_t data) final
+    {
+        return write(&data, 1U);
+    }
+
+    /**
+     * Write several bytes.
+     *
+     * @param[in] buffer    Bytes
+     * @param[in] size      Number of bytes
+     *
+     * @return Number of handled bytes
+     */
+    size_t write(const uint8_t* buffer, size_t size) final
+    {
+        size_t handled = size;
+
+        /* Drop data before the offset. */
+        if (m_offset >= size)
+        {
+            m_offset    -= size;
+            size        = 0U;
+        }
+        else
+        {
+            buffer      = &buffer[m_offset];
+            size        -= m_offset;
+            m_offset    = 0U;
+        }
+
+        /* Drop data, which doesn't fit anymore. */
+        if ((m_size - m_written) < size)
+        {
+            size = m_size - m_written;
+        }
+
+        if (0U < size)
+        {
+            memcpy(&m_buffer[m_written], buffer, size);
+            m_written += size;
+        }
+
+        return handled;
+    }
+
+    /**
+     * Get number of bytes written to the buffer.
+     *
+     * @return Number of bytes
+     */
+    size_t getWritten() const
+    {
+        return m_written;
+    }
+
+private:
+
+    uint8_t*    m_buffer;   /**< Destination buffer */
+    size_t      m_size;     /**< Destination buffer size in byte */
+    size_t      m_offset;   /**< Number of bytes, which are still to drop. */
+    size_t      m_written;  /**< Number of bytes written to the buffer. */
+
+    PartPrint();
+    PartPrint(const PartPrint& print);
+    PartPrint& operator=(const PartPrint& print);
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+JsonDocResponse::JsonDocResponse(const String& name, size_t docSize) :
+    AsyncAbstractResponse(),
+    m_name(name),
+    m_heapAtStart(ESP.getFreeHeap()),
+    m_minHeap(m_heapAtStart),
+    m_jsonDoc(docSize),
+    m_offset(0U)
+{
+    _code           = 200;
+    _contentType    = "application/json";
+
+    updateMinHeap();
+}
+
+JsonDocResponse::~JsonDocResponse()
+{
+    LOG_INFO("%s: %u bytes sent, peak heap %u bytes.", m_name.c_str(), m_offset, m_heapAtStart - m_minHeap);
+}
+
+void JsonDocResponse::finalize(uint32_t httpStatusCode)
+{
+    _code           = static_cast<int>(httpStatusCode);
+    _contentLength  = measureJsonPretty(m_jsonDoc);
+    m_offset        = 0U;
+
+    updateMinHeap();
+}
+
+size_t JsonDocResponse::_fillBuffer(uint8_t* buf, size_t maxLen)
+{
+    PartPrint partPrint(buf, maxLen, m_offset);
+
+    /* The document is serialized again for every part, but only the
+     * requested part is written to the buffer.
+     */
+    (void)serializeJsonPretty(m_jsonDoc, partPrint);
+    m_offset += partPrint.getWritten();
+
+    updateMinHeap();
+
+    return partPrint.getWritten();
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void JsonDocResponse::updateMinHeap()
+{
+    uint32_t freeHeap = ESP.getFreeHeap();
+
+    if (m_minHeap > freeHeap)
+    {
+        m_minHeap = freeHeap;
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,147 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  JSON document web response
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __JSON_DOC_RESPONSE_H__
+#define __JSON_DOC_RESPONSE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
+
+#include "JsonDocPool.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A web response, which owns its JSON document. The document is serialized
+ * directly into the send buffers of the webserver, piece by piece as TCP
+ * space becomes available. Therefore no copy of the serialized document
+ * is necessary.
+ *
+ * The peak heap usage, while the response exists, is reported in the log.
+ */
+class JsonDocResponse : public AsyncAbstractResponse
+{
+public:
+
+    /**
+     * Constructs the response.
+     *
+     * @param[in] name      Name used for the log, e.g. the requested URL.
+     * @param[in] docSize   JSON document size in byte.
+     */
+    JsonDocResponse(const String& name, size_t docSize);
+
+    /**
+     * Destroys the response.
+     */
+    ~JsonDocResponse();
+
+    /**
+     * Get the JSON document, which to fill.
+     *
+     * @return JSON document
+     */
+    JsonDocument& getJsonDoc()
+    {
+        return m_jsonDoc;
+    }
+
+    /**
+     * Finalize the response, after the JSON document is complete.
+     * Don't change the JSON document afterwards.
+     *
+     * @param[in] httpStatusCode    HTTP status code
+     */
+    void finalize(uint32_t httpStatusCode);
+
+    /**
+     * Is the response source valid?
+     *
+     * @return The JSON document is always valid.
+     */
+    bool _sourceValid() const final
+    {
+        return true;
+    }
+
+    /**
+     * Fill the send buffer with the next part of the serialized JSON document.
+     *
+     * @param[out]  buf     Send buffer
+     * @param[in]   maxLen  Send buffer size in byte
+     *
+     * @return Number of written bytes
+     */
+    size_t _fillBuffer(uint8_t* buf, size_t maxLen) final;
+
+private:
+
+    String              m_name;         /**< Name used for the log */
+    uint32_t            m_heapAtStart;  /**< Free heap in byte at response creation */
+    uint32_t            m_minHeap;      /**< Min. free heap in byte during the response lifetime */
+    PooledJsonDocument  m_jsonDoc;      /**< JSON document */
+    size_t              m_offset;       /**< Offset in the serialized JSON document, which is sent next. */
+
+    JsonDocResponse();
+    JsonDocResponse(const JsonDocResponse& rsp);
+    JsonDocResponse& operator=(const JsonDocResponse& rsp);
+
+    /**
+     * Update the min. free heap.
+     */
+    void updateMinHeap();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __JSON_DOC_RESPONSE_H__ */
+
+/** @} */
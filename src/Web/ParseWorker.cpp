@@ -0,0 +1,338 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Parse worker
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ParseWorker.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool ParseWorker::start()
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = true;
+
+    if (nullptr == m_taskHandle)
+    {
+        if (false == m_queue.create(MAX_JOBS))
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            /* Create binary semaphore to signal task exit. */
+            m_xSemaphore = xSemaphoreCreateBinary();
+
+            if (nullptr == m_xSemaphore)
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                BaseType_t  osRet   = pdFAIL;
+
+                /* Task shall run */
+                m_taskExit = false;
+
+                osRet = xTaskCreateUniversal(   processTask,
+                                                "parseWorkerTask",
+                                                TASK_STACK_SIZE,
+                                                this,
+                                                TASK_PRIORITY,
+                                                &m_taskHandle,
+                                                TASK_RUN_CORE);
+
+                /* Task successful created? */
+                if (pdPASS == osRet)
+                {
+                    (void)xSemaphoreGive(m_xSemaphore);
+                    isSuccessful = true;
+                }
+                else
+                {
+                    m_taskHandle = nullptr;
+                    isSuccessful = false;
+                }
+            }
+        }
+
+        /* Any error happened? */
+        if (false == isSuccessful)
+        {
+            if (nullptr != m_xSemaphore)
+            {
+                vSemaphoreDelete(m_xSemaphore);
+                m_xSemaphore = nullptr;
+            }
+
+            m_queue.destroy();
+        }
+        else
+        {
+            LOG_INFO("Parse worker task is up.");
+        }
+    }
+
+    return isSuccessful;
+}
+
+void ParseWorker::stop()
+{
+    bool isRunning = false;
+
+    /* No job will be queued anymore. */
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        if (nullptr != m_taskHandle)
+        {
+            m_taskHandle    = nullptr;
+            m_taskExit      = true;
+            isRunning       = true;
+        }
+    }
+
+    if (true == isRunning)
+    {
+        /* Join */
+        (void)xSemaphoreTake(m_xSemaphore, portMAX_DELAY);
+
+        LOG_INFO("Parse worker task is down.");
+
+        vSemaphoreDelete(m_xSemaphore);
+        m_xSemaphore = nullptr;
+
+        m_queue.destroy();
+    }
+}
+
+bool ParseWorker::post(GrowBuffer& data, const OnParse& onParse)
+{
+    bool    isSuccessful    = false;
+    bool    isQueued        = false;
+
+    if (nullptr != onParse)
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        Job*                        job     = nullptr;
+        uint8_t                     idx     = 0U;
+
+        if (nullptr != m_taskHandle)
+        {
+            while((MAX_JOBS > idx) && (nullptr == job))
+            {
+                if (false == m_jobs[idx].isUsed)
+                {
+                    job = &m_jobs[idx];
+                }
+
+                ++idx;
+            }
+        }
+
+        if ((nullptr != job) &&
+            (true == job->data.take(data)))
+        {
+            job->isUsed     = true;
+            job->onParse    = onParse;
+
+            if (false == m_queue.sendToBack(job, 0U))
+            {
+                /* Give the data back. */
+                (void)data.take(job->data);
+                release(*job);
+            }
+            else
+            {
+                uint32_t queueDepth = m_queue.getItemCount();
+
+                if (m_queueDepthMax < queueDepth)
+                {
+                    m_queueDepthMax = queueDepth;
+                }
+
+                isQueued = true;
+            }
+        }
+
+        isSuccessful = true;
+    }
+
+    /* Worker not available or busy, parse it in the caller context.
+     * Waiting for a free job would block the caller, e.g. the TCP task.
+     */
+    if ((true == isSuccessful) &&
+        (false == isQueued))
+    {
+        parse(data, onParse, true);
+        data.clear();
+    }
+
+    return isSuccessful;
+}
+
+void ParseWorker::getStatistics(Statistics& statistics) const
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint32_t                    cnt     = m_jobCnt + m_inlineJobCnt;
+
+    statistics.jobs             = m_jobCnt;
+    statistics.inlineJobs       = m_inlineJobCnt;
+    statistics.queueDepth       = m_queue.getItemCount();
+    statistics.queueDepthMax    = m_queueDepthMax;
+    statistics.durationAvg      = 0U;
+    statistics.durationMax      = m_durationMax;
+
+    if (0U < cnt)
+    {
+        statistics.durationAvg = m_durationSum / cnt;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void ParseWorker::processTask(void* parameters)
+{
+    ParseWorker* tthis = reinterpret_cast<ParseWorker*>(parameters);
+
+    if ((nullptr != tthis) &&
+        (nullptr != tthis->m_xSemaphore))
+    {
+        Job* job = nullptr;
+
+        (void)xSemaphoreTake(tthis->m_xSemaphore, portMAX_DELAY);
+
+        while(false == tthis->m_taskExit)
+        {
+            if (true == tthis->m_queue.receive(&job, RECEIVE_TIMEOUT / portTICK_PERIOD_MS))
+            {
+                tthis->process(*job);
+            }
+        }
+
+        /* Process the remaining jobs, no job gets lost. */
+        while(true == tthis->m_queue.receive(&job, 0U))
+        {
+            tthis->process(*job);
+        }
+
+        (void)xSemaphoreGive(tthis->m_xSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+void ParseWorker::process(Job& job)
+{
+    parse(job.data, job.onParse, false);
+    release(job);
+}
+
+void ParseWorker::release(Job& job)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    job.data.clear();
+    job.onParse = nullptr;
+    job.isUsed  = false;
+}
+
+void ParseWorker::parse(const GrowBuffer& data, const OnParse& onParse, bool isInline)
+{
+    uint32_t    timestamp   = millis();
+    uint32_t    duration    = 0U;
+
+    onParse(reinterpret_cast<const char*>(data.getData()), data.getSize());
+
+    duration = millis() - timestamp;
+
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        if (true == isInline)
+        {
+            ++m_inlineJobCnt;
+        }
+        else
+        {
+            ++m_jobCnt;
+        }
+
+        m_durationSum += duration;
+
+        if (m_durationMax < duration)
+        {
+            m_durationMax = duration;
+        }
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
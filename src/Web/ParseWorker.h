@@ -0,0 +1,260 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Parse worker
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __PARSE_WORKER_H__
+#define __PARSE_WORKER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <functional>
+#include <Mutex.hpp>
+#include <Queue.hpp>
+#include <GrowBuffer.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The parse worker processes received data, e.g. decodes and deserializes
+ * a HTTP response body, in a low priority task. The HTTP client callbacks
+ * run in the context of the TCP task and while a large response is
+ * processed there, all other connections (web interface, websocket) would
+ * stall.
+ *
+ * The data is handed over without copying and the parse callback is called
+ * in the worker task context. The jobs are processed in the order they are
+ * posted.
+ *
+ * If the worker is not running or all jobs are in use, the data is parsed
+ * directly in the caller context, so no data gets lost.
+ */
+class ParseWorker
+{
+public:
+
+    /**
+     * Prototype of the parse callback.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     */
+    typedef std::function<void(const char* data, size_t size)> OnParse;
+
+    /**
+     * Parse worker statistics.
+     */
+    struct Statistics
+    {
+        uint32_t    jobs;           /**< Number of jobs processed by the worker task */
+        uint32_t    inlineJobs;     /**< Number of jobs processed in the caller context */
+        uint32_t    queueDepth;     /**< Number of currently queued jobs */
+        uint32_t    queueDepthMax;  /**< Max. number of queued jobs */
+        uint32_t    durationAvg;    /**< Average parse duration in ms */
+        uint32_t    durationMax;    /**< Max. parse duration in ms */
+    };
+
+    /**
+     * Get parse worker instance.
+     *
+     * @return Parse worker instance
+     */
+    static ParseWorker& getInstance()
+    {
+        static ParseWorker instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start the worker task.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool start();
+
+    /**
+     * Stop the worker task. Queued jobs are processed before.
+     */
+    void stop();
+
+    /**
+     * Post data, which to parse. The data is taken over without copying.
+     * Don't call it with a lock held, which the parse callback takes too,
+     * because the data may be parsed in the caller context.
+     *
+     * @param[in] data      Data, which is empty afterwards.
+     * @param[in] onParse   Parse callback
+     *
+     * @return If the data is parsed or queued, it will return true otherwise false.
+     */
+    bool post(GrowBuffer& data, const OnParse& onParse);
+
+    /**
+     * Get the statistics.
+     *
+     * @param[out] statistics   Statistics
+     */
+    void getStatistics(Statistics& statistics) const;
+
+    /** Max. number of queued jobs. */
+    static const uint8_t        MAX_JOBS            = 4U;
+
+private:
+
+    /** Task stack size in bytes, the gzip decoder and JSON deserialization run in the task. */
+    static const uint32_t       TASK_STACK_SIZE     = 6144U;
+
+    /** MCU core where the task shall run */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+    /** Task priority, lower than the TCP task. */
+    static const UBaseType_t    TASK_PRIORITY       = 1U;
+
+    /** Time in ms to wait for a job, before the task exit flag is checked. */
+    static const uint32_t       RECEIVE_TIMEOUT     = 100U;
+
+    /**
+     * A single job.
+     */
+    struct Job
+    {
+        bool        isUsed;     /**< Is the job in use? */
+        GrowBuffer  data;       /**< Data, which to parse */
+        OnParse     onParse;    /**< Parse callback */
+
+        /**
+         * Constructs a unused job.
+         */
+        Job() :
+            isUsed(false),
+            data(),
+            onParse()
+        {
+        }
+    };
+
+    mutable MutexRecursive  m_mutex;            /**< Mutex to protect the jobs and statistics against concurrent access. */
+    Queue<Job*>             m_queue;            /**< Queued jobs */
+    Job                     m_jobs[MAX_JOBS];   /**< Jobs */
+    TaskHandle_t            m_taskHandle;       /**< Task handle */
+    bool                    m_taskExit;         /**< Flag to signal the task to exit. */
+    SemaphoreHandle_t       m_xSemaphore;       /**< Binary semaphore used to signal the task exit. */
+    uint32_t                m_jobCnt;           /**< Number of jobs processed by the worker task */
+    uint32_t                m_inlineJobCnt;     /**< Number of jobs processed in the caller context */
+    uint32_t                m_queueDepthMax;    /**< Max. number of queued jobs */
+    uint32_t                m_durationSum;      /**< Sum of all parse durations in ms */
+    uint32_t                m_durationMax;      /**< Max. parse duration in ms */
+
+    /**
+     * Constructs the parse worker.
+     */
+    ParseWorker() :
+        m_mutex(),
+        m_queue(),
+        m_jobs(),
+        m_taskHandle(nullptr),
+        m_taskExit(false),
+        m_xSemaphore(nullptr),
+        m_jobCnt(0U),
+        m_inlineJobCnt(0U),
+        m_queueDepthMax(0U),
+        m_durationSum(0U),
+        m_durationMax(0U)
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the parse worker.
+     */
+    ~ParseWorker()
+    {
+        stop();
+
+        m_mutex.destroy();
+    }
+
+    ParseWorker(const ParseWorker& worker);
+    ParseWorker& operator=(const ParseWorker& worker);
+
+    /**
+     * Processing task.
+     *
+     * @param[in]   parameters  Task parameters
+     */
+    static void processTask(void* parameters);
+
+    /**
+     * Process a single job in the worker task context.
+     *
+     * @param[in] job   Job
+     */
+    void process(Job& job);
+
+    /**
+     * Release a job, after it was processed.
+     *
+     * @param[in] job   Job
+     */
+    void release(Job& job);
+
+    /**
+     * Call the parse callback and measure the duration.
+     *
+     * @param[in] data      Data
+     * @param[in] onParse   Parse callback
+     * @param[in] isInline  Is the callback called in the caller context?
+     */
+    void parse(const GrowBuffer& data, const OnParse& onParse, bool isInline);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PARSE_WORKER_H__ */
+
+/** @} */
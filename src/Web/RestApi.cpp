@@ -38,9 +38,15 @@
 #include "DisplayMgr.h"
 #include "Version.h"
 #include "PluginMgr.h"
+#include "PluginTopicHandler.h"
 #include "WiFiUtil.h"
 #include "FileSystem.h"
 #include "RestUtil.h"
+#include "JsonFile.h"
+#include "JsonDocPool.h"
+#include "HttpConnectionPool.h"
+#include "FetchScheduler.h"
+#include "ParseWorker.h"
 
 #include <Util.h>
 #include <WiFi.h>
@@ -48,6 +54,7 @@
 #include <Esp.h>
 #include <Logging.h>
 #include <SensorDataProvider.h>
+#include <memory>
 
 /******************************************************************************
  * Compiler Switches
@@ -61,6 +68,67 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * Context of a streamed filesystem directory listing.
+ * The directory entries are read lazily, one by one, as soon as the
+ * webserver requests the next part of the response.
+ */
+struct FsListing
+{
+    /** Listing states, which correspond to the JSON response parts. */
+    enum State
+    {
+        STATE_HEAD = 0, /**< Response head, which starts the data array. */
+        STATE_ENTRIES,  /**< Directory entries */
+        STATE_TAIL,     /**< Response tail, which closes the data array. */
+        STATE_DONE      /**< Response complete */
+    };
+
+    /** Max. size of a single serialized part in byte. */
+    static const size_t PART_SIZE   = 320U;
+
+    File        fdRoot;             /**< Listed directory */
+    uint32_t    preCount;           /**< Number of entries to skip, because of paging. */
+    uint32_t    count;              /**< Number of entries still to list. */
+    State       state;              /**< Current listing state */
+    bool        isFirst;            /**< Is the next entry the first one in the data array? */
+    char        part[PART_SIZE];    /**< Serialized part, which is sent next. */
+    size_t      partLen;            /**< Length of the serialized part in byte. */
+    size_t      partPos;            /**< Number of already sent bytes of the part. */
+    uint32_t    heapAtStart;        /**< Free heap in byte at listing start */
+    uint32_t    minHeap;            /**< Min. free heap in byte during the listing */
+
+    /**
+     * Constructs the listing context.
+     */
+    FsListing() :
+        fdRoot(),
+        preCount(0U),
+        count(0U),
+        state(STATE_HEAD),
+        isFirst(true),
+        part(),
+        partLen(0U),
+        partPos(0U),
+        heapAtStart(ESP.getFreeHeap()),
+        minHeap(heapAtStart)
+    {
+    }
+
+    /**
+     * Destroys the listing context and reports the peak heap usage.
+     */
+    ~FsListing()
+    {
+        if (true == fdRoot)
+        {
+            fdRoot.close();
+        }
+
+        LOG_INFO("Filesystem listing: peak heap %u bytes.", heapAtStart - minHeap);
+    }
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -68,6 +136,12 @@
 static void handleButton(AsyncWebServerRequest* request);
 static void handleFadeEffect(AsyncWebServerRequest* request);
 static void handleSlots(AsyncWebServerRequest* request);
+static void handleDisplayStatistics(AsyncWebServerRequest* request);
+static void handleDisplayBatch(AsyncWebServerRequest* request);
+static void displayBatchBodyHandler(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total);
+static bool applyBatchItem(const JsonObject& item, String& error, uint32_t& errorCode);
+static void addDurationStatistics(JsonObject& obj, const DisplayMgr::DurationStatistics& statistics, uint32_t rate);
+static void addFrameStatistics(JsonObject& obj);
 static void handlePluginInstall(AsyncWebServerRequest* request);
 static void handlePluginUninstall(AsyncWebServerRequest* request);
 static void handlePlugins(AsyncWebServerRequest* request);
@@ -77,6 +151,8 @@ static void handleSetting(AsyncWebServerRequest* request);
 static bool storeSetting(KeyValue* parameter, const String& value, String& error);
 static void handleStatus(AsyncWebServerRequest* request);
 static void handleFilesystem(AsyncWebServerRequest* request);
+static size_t fillFsListing(FsListing& listing, uint8_t* buffer, size_t maxLen);
+static bool prepareNextFsEntry(FsListing& listing);
 static void handleFileGet(AsyncWebServerRequest* request);
 static String getContentType(const String& filename);
 static void handleFilePost(AsyncWebServerRequest* request);
@@ -88,6 +164,23 @@ static bool isValidHostname(const String& hostname);
  * Local Variables
  *****************************************************************************/
 
+/** Max. size of a batch request body in byte. */
+static const size_t BATCH_BODY_SIZE_MAX = 8192U;
+
+/** Max. number of items in a batch request. */
+static const size_t BATCH_ITEMS_MAX     = 32U;
+
+/** Number of parameters per batch item, which is considered in the document size. */
+static const size_t BATCH_ITEM_PAR_MAX  = 8U;
+
+/**
+ * JSON document size in byte of a batch request, derived from the limits.
+ * Every item has the plugin uid or alias, the topic and the parameters.
+ * The strings are not copied, because the body is deserialized in place.
+ */
+static const size_t BATCH_DOC_SIZE      = JSON_ARRAY_SIZE(BATCH_ITEMS_MAX) +
+                                          BATCH_ITEMS_MAX * (JSON_OBJECT_SIZE(3U) + JSON_OBJECT_SIZE(BATCH_ITEM_PAR_MAX));
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -109,6 +202,8 @@ void RestApi::init(AsyncWebServer& srv)
     (void)srv.on("/rest/api/v1/button", handleButton);
     (void)srv.on("/rest/api/v1/display/fadeEffect", handleFadeEffect);
     (void)srv.on("/rest/api/v1/display/slots", handleSlots);
+    (void)srv.on("/rest/api/v1/display/stats", handleDisplayStatistics);
+    (void)srv.on("/rest/api/v1/display/batch", HTTP_POST, handleDisplayBatch, nullptr, displayBatchBodyHandler);
     (void)srv.on("/rest/api/v1/plugin/install", handlePluginInstall);
     (void)srv.on("/rest/api/v1/plugin/uninstall", handlePluginUninstall);
     (void)srv.on("/rest/api/v1/plugins", handlePlugins);
@@ -132,7 +227,7 @@ void RestApi::init(AsyncWebServer& srv)
 void RestApi::error(AsyncWebServerRequest* request)
 {
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_NOT_FOUND;
 
     if (nullptr == request)
@@ -161,7 +256,7 @@ static void handleButton(AsyncWebServerRequest* request)
 {
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -196,7 +291,7 @@ static void handleFadeEffect(AsyncWebServerRequest* request)
 {
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -244,7 +339,7 @@ static void handleSlots(AsyncWebServerRequest* request)
 {
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -292,6 +387,444 @@ static void handleSlots(AsyncWebServerRequest* request)
     return;
 }
 
+/**
+ * Get the frame time statistics and the plugin duration statistics of every slot.
+ * GET \c "/api/v1/display/stats"
+ *
+ * Enable/Disable (?enable=<true|false>) or reset (?reset=true) the frame time statistics.
+ * POST \c "/api/v1/display/stats"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleDisplayStatistics(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 4096U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET == request->method())
+    {
+        JsonVariant                 dataObj     = RestUtil::prepareRspSuccess(jsonDoc);
+        JsonObject                  frameObj    = dataObj.createNestedObject("frame");
+        JsonArray                   slotArray   = dataObj.createNestedArray("slots");
+        uint8_t                     slotId      = 0U;
+        DisplayMgr&                 displayMgr  = DisplayMgr::getInstance();
+        DisplayMgr::SlotStatistics  statistics;
+
+        /* Frame times are in ms. */
+        addFrameStatistics(frameObj);
+
+        /* Time budget in us. */
+        dataObj["timeBudget"]       = displayMgr.getTimeBudget();
+        dataObj["timeBudgetPolicy"] = static_cast<uint8_t>(displayMgr.getTimeBudgetPolicy());
+
+        /* Durations are in us. */
+        for(slotId = 0U; slotId < displayMgr.getMaxSlots(); ++slotId)
+        {
+            IPluginMaintenance* plugin  = displayMgr.getPluginInSlot(slotId);
+            JsonObject          slot    = slotArray.createNestedObject();
+
+            slot["name"]    = (nullptr != plugin) ? plugin->getName() : "";
+            slot["uid"]     = (nullptr != plugin) ? plugin->getUID() : 0U;
+
+            if ((nullptr != plugin) &&
+                (true == displayMgr.getSlotStatistics(slotId, statistics)))
+            {
+                JsonObject  processObj  = slot.createNestedObject("process");
+                JsonObject  updateObj   = slot.createNestedObject("update");
+                uint32_t    timeBudget  = plugin->getTimeBudget();
+
+                addDurationStatistics(processObj, statistics.process, statistics.processRate);
+                addDurationStatistics(updateObj, statistics.update, statistics.updateRate);
+
+                slot["timeBudget"]          = (0U == timeBudget) ? displayMgr.getTimeBudget() : timeBudget;
+                slot["budgetViolations"]    = statistics.budget.getViolations();
+                slot["isSkipped"]           = statistics.budget.isSkipped();
+                slot["isBudgetDisabled"]    = statistics.budget.isDisabled();
+            }
+        }
+
+        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+    }
+    else if (HTTP_POST == request->method())
+    {
+        const String&   enableStr   = request->arg("enable");
+        const String&   resetStr    = request->arg("reset");
+        bool            isValid     = true;
+
+        if ((false == enableStr.isEmpty()) &&
+            (enableStr != "true") &&
+            (enableStr != "false"))
+        {
+            isValid = false;
+        }
+
+        if ((false == resetStr.isEmpty()) &&
+            (resetStr != "true"))
+        {
+            isValid = false;
+        }
+
+        if (false == isValid)
+        {
+            RestUtil::prepareRspError(jsonDoc, "Invalid value.");
+            httpStatusCode = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else
+        {
+            JsonVariant dataObj     = RestUtil::prepareRspSuccess(jsonDoc);
+            JsonObject  frameObj    = dataObj.createNestedObject("frame");
+
+            if (false == enableStr.isEmpty())
+            {
+                DisplayMgr::getInstance().enableStatistics(enableStr == "true");
+            }
+
+            if (false == resetStr.isEmpty())
+            {
+                DisplayMgr::getInstance().resetStatistics();
+            }
+
+            addFrameStatistics(frameObj);
+
+            httpStatusCode = HttpStatus::STATUS_CODE_OK;
+        }
+    }
+    else
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+
+    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+
+    return;
+}
+
+/**
+ * Set several plugin topics at once. The body contains a JSON array of items,
+ * every item is addressed either by plugin UID or alias:
+ * [{"uid": 1, "topic": "/text", "parameters": {"show": "Hello"}}, ...]
+ *
+ * All items are applied with a single display lock, therefore they get
+ * visible at once. Configuration writes are coalesced and done after the
+ * display is unlocked again. The response contains the status of every item
+ * in the same order.
+ * POST \c "/api/v1/display/batch"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleDisplayBatch(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 2048U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+    char*               body            = nullptr;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    body = static_cast<char*>(request->_tempObject);
+
+    if (HTTP_POST != request->method())
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else if (BATCH_BODY_SIZE_MAX < request->contentLength())
+    {
+        RestUtil::prepareRspError(jsonDoc, "Body too long.");
+        httpStatusCode = HttpStatus::STATUS_CODE_PAYLOAD_TOO_LARGE;
+    }
+    else if (nullptr == body)
+    {
+        RestUtil::prepareRspError(jsonDoc, "Body missing.");
+        httpStatusCode = HttpStatus::STATUS_CODE_BAD_REQUEST;
+    }
+    else
+    {
+        PooledJsonDocument      jsonDocBatch(BATCH_DOC_SIZE);
+        DeserializationError    jsonRet         = deserializeJson(jsonDocBatch, body); /* Zero-copy, the strings remain in the body. */
+        JsonArray               itemArray       = jsonDocBatch.as<JsonArray>();
+
+        if (DeserializationError::NoMemory == jsonRet.code())
+        {
+            RestUtil::prepareRspError(jsonDoc, "Batch too large.");
+            httpStatusCode = HttpStatus::STATUS_CODE_PAYLOAD_TOO_LARGE;
+        }
+        else if (DeserializationError::Ok != jsonRet.code())
+        {
+            RestUtil::prepareRspError(jsonDoc, "Invalid JSON.");
+            httpStatusCode = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else if (true == itemArray.isNull())
+        {
+            RestUtil::prepareRspError(jsonDoc, "JSON array expected.");
+            httpStatusCode = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else if (BATCH_ITEMS_MAX < itemArray.size())
+        {
+            RestUtil::prepareRspError(jsonDoc, "Too many items.");
+            httpStatusCode = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else
+        {
+            JsonVariant dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
+            JsonArray   resultArray     = dataObj.createNestedArray("items");
+            DisplayMgr& displayMgr      = DisplayMgr::getInstance();
+            bool        isDeferred      = JsonFile::beginDeferredWrites();
+            uint32_t    writeCnt        = 0U;
+
+            /* Apply all items at once, the display task must not show an
+             * intermediate state.
+             */
+            displayMgr.lock();
+
+            for(JsonVariant item: itemArray)
+            {
+                JsonObject  resultObj   = resultArray.createNestedObject();
+                String      error;
+                uint32_t    errorCode   = HttpStatus::STATUS_CODE_OK;
+
+                if (false == applyBatchItem(item.as<JsonObject>(), error, errorCode))
+                {
+                    JsonObject errorObj = resultObj.createNestedObject("error");
+
+                    resultObj["status"] = "error";
+                    errorObj["code"]    = errorCode;
+                    errorObj["msg"]     = error;
+                }
+                else
+                {
+                    resultObj["status"] = "ok";
+                }
+            }
+
+            displayMgr.unlock();
+
+            /* Write the configuration files after the display is released. */
+            if (true == isDeferred)
+            {
+                writeCnt = JsonFile::endDeferredWrites();
+            }
+
+            LOG_INFO("Batch with %u items applied, %u config writes.", itemArray.size(), writeCnt);
+
+            httpStatusCode = HttpStatus::STATUS_CODE_OK;
+        }
+    }
+
+    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+
+    return;
+}
+
+/**
+ * Collects the body of a batch request. The body is stored null-terminated
+ * in the request temporary object, which is released by the request itself.
+ * A body which exceeds the max. size is dropped.
+ *
+ * @param[in] request   HTTP request
+ * @param[in] data      Body data chunk
+ * @param[in] len       Length of the body data chunk in byte
+ * @param[in] index     Index of the chunk in the body
+ * @param[in] total     Total body length in byte
+ */
+static void displayBatchBodyHandler(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total)
+{
+    if ((nullptr == request) ||
+        (nullptr == data))
+    {
+        return;
+    }
+
+    if ((0U == index) &&
+        (nullptr == request->_tempObject) &&
+        (BATCH_BODY_SIZE_MAX >= total))
+    {
+        request->_tempObject = malloc(total + 1U);
+
+        if (nullptr != request->_tempObject)
+        {
+            static_cast<char*>(request->_tempObject)[total] = '\0';
+        }
+    }
+
+    if ((nullptr != request->_tempObject) &&
+        (total >= (index + len)))
+    {
+        memcpy(&static_cast<uint8_t*>(request->_tempObject)[index], data, len);
+    }
+
+    return;
+}
+
+/**
+ * Apply a single batch item by setting the plugin topic.
+ * The parameters are passed as strings to the plugin, like they are
+ * received by the plugin topic REST API.
+ *
+ * @param[in]   item        Batch item
+ * @param[out]  error       Error message in case of failure
+ * @param[out]  errorCode   HTTP status code, which corresponds to the failure
+ *
+ * @return If successful applied, it will return true otherwise false.
+ */
+static bool applyBatchItem(const JsonObject& item, String& error, uint32_t& errorCode)
+{
+    bool                isSuccessful    = false;
+    PluginMgr&          pluginMgr       = PluginMgr::getInstance();
+    IPluginMaintenance* plugin          = nullptr;
+    JsonVariantConst    jsonUid         = item["uid"];
+    JsonVariantConst    jsonAlias       = item["alias"];
+    JsonVariantConst    jsonTopic       = item["topic"];
+    JsonObjectConst     jsonParameters  = item["parameters"];
+
+    if (true == item.isNull())
+    {
+        error       = "Item is not a JSON object.";
+        errorCode   = HttpStatus::STATUS_CODE_BAD_REQUEST;
+    }
+    else if (false == jsonTopic.is<const char*>())
+    {
+        error       = "Topic missing.";
+        errorCode   = HttpStatus::STATUS_CODE_BAD_REQUEST;
+    }
+    else
+    {
+        if (true == jsonUid.is<uint16_t>())
+        {
+            plugin = pluginMgr.findPluginByUID(jsonUid.as<uint16_t>());
+        }
+        else if (true == jsonAlias.is<const char*>())
+        {
+            plugin = pluginMgr.findPluginByAlias(jsonAlias.as<String>());
+        }
+        else
+        {
+            ;
+        }
+
+        if (nullptr == plugin)
+        {
+            error       = "Plugin not found.";
+            errorCode   = HttpStatus::STATUS_CODE_NOT_FOUND;
+        }
+        else
+        {
+            const size_t        JSON_DOC_SIZE   = 1024U;
+            size_t              jsonDocParSize  = JSON_DOC_SIZE;
+
+            /* Consider long values like a command list in the document size. */
+            for(JsonPairConst pair: jsonParameters)
+            {
+                jsonDocParSize += strlen(pair.key().c_str()) + measureJson(pair.value()) + 2U;
+            }
+
+            /* The document is allocated on the heap, therefore its size is limited
+             * like for a single plugin topic request.
+             */
+            if (PluginTopicHandler::JSON_DOC_PAR_SIZE_MAX < jsonDocParSize)
+            {
+                error       = "Parameters too large.";
+                errorCode   = HttpStatus::STATUS_CODE_PAYLOAD_TOO_LARGE;
+            }
+            else
+            {
+                PooledJsonDocument  jsonDocPar(jsonDocParSize);
+                JsonObject          parObj      = jsonDocPar.to<JsonObject>();
+                String              value;
+
+                /* Plugins expect the parameters as strings, like the HTTP arguments. */
+                for(JsonPairConst pair: jsonParameters)
+                {
+                    if (true == pair.value().is<const char*>())
+                    {
+                        value = pair.value().as<const char*>();
+                    }
+                    else
+                    {
+                        value.clear();
+                        (void)serializeJson(pair.value(), value);
+                    }
+
+                    parObj[pair.key().c_str()] = value;
+                }
+
+                if (false == plugin->setTopic(jsonTopic.as<String>(), parObj))
+                {
+                    error       = "Requested topic not supported or invalid data.";
+                    errorCode   = HttpStatus::STATUS_CODE_NOT_FOUND;
+                }
+                else
+                {
+                    isSuccessful = true;
+                }
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+/**
+ * Add duration statistics to a JSON object.
+ *
+ * @param[in] obj           JSON object
+ * @param[in] statistics    Duration statistics in us
+ * @param[in] rate          Number of calls per second
+ */
+static void addDurationStatistics(JsonObject& obj, const DisplayMgr::DurationStatistics& statistics, uint32_t rate)
+{
+    obj["p50"]  = statistics.getPercentile(50U);
+    obj["p99"]  = statistics.getPercentile(99U);
+    obj["max"]  = statistics.getMax();
+    obj["avg"]  = statistics.getAvg();
+    obj["rate"] = rate;
+
+    return;
+}
+
+/**
+ * Add the frame time statistics of the display manager to a JSON object.
+ *
+ * @param[in] obj   JSON object
+ */
+static void addFrameStatistics(JsonObject& obj)
+{
+    DisplayMgr&                     displayMgr  = DisplayMgr::getInstance();
+    DisplayMgr::FrameTimeHistogram  histogram;
+    uint8_t                         idx         = 0U;
+
+    obj["isEnabled"] = displayMgr.isStatisticsEnabled();
+
+    for(idx = 0U; idx < DisplayMgr::STATISTICS_ID_MAX; ++idx)
+    {
+        DisplayMgr::StatisticsId id = static_cast<DisplayMgr::StatisticsId>(idx);
+
+        if (true == displayMgr.getStatistics(id, histogram))
+        {
+            JsonObject histogramObj = obj.createNestedObject(DisplayMgr::getStatisticsName(id));
+
+            histogramObj["cnt"] = histogram.getCount();
+            histogramObj["min"] = histogram.getMin();
+            histogramObj["p50"] = histogram.getPercentile(50U);
+            histogramObj["p99"] = histogram.getPercentile(99U);
+            histogramObj["max"] = histogram.getMax();
+            histogramObj["avg"] = histogram.getAvg();
+        }
+    }
+
+    return;
+}
+
 /**
  * Install plugin
  * POST \c "/api/v1/plugin/install?name=<plugin-name>"
@@ -301,7 +834,7 @@ static void handleSlots(AsyncWebServerRequest* request)
 static void handlePluginInstall(AsyncWebServerRequest* request)
 {
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -365,7 +898,7 @@ static void handlePluginInstall(AsyncWebServerRequest* request)
 static void handlePluginUninstall(AsyncWebServerRequest* request)
 {
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -453,7 +986,7 @@ static void handlePluginUninstall(AsyncWebServerRequest* request)
 static void handlePlugins(AsyncWebServerRequest* request)
 {
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    JsonDocResponse*    response        = nullptr;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -461,6 +994,16 @@ static void handlePlugins(AsyncWebServerRequest* request)
         return;
     }
 
+    response = new(std::nothrow) JsonDocResponse(request->url(), JSON_DOC_SIZE);
+
+    if (nullptr == response)
+    {
+        request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        return;
+    }
+
+    JsonDocument& jsonDoc = response->getJsonDoc();
+
     if (HTTP_GET != request->method())
     {
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
@@ -481,7 +1024,7 @@ static void handlePlugins(AsyncWebServerRequest* request)
         httpStatusCode = HttpStatus::STATUS_CODE_OK;
     }
 
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+    RestUtil::sendJsonRsp(request, response, httpStatusCode);
 
     return;
 }
@@ -495,7 +1038,7 @@ static void handlePlugins(AsyncWebServerRequest* request)
 static void handleSensors(AsyncWebServerRequest* request)
 {
     const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -567,7 +1110,7 @@ static void handleSensors(AsyncWebServerRequest* request)
 static void handleSettings(AsyncWebServerRequest* request)
 {
     const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    JsonDocResponse*    response        = nullptr;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -575,6 +1118,16 @@ static void handleSettings(AsyncWebServerRequest* request)
         return;
     }
 
+    response = new(std::nothrow) JsonDocResponse(request->url(), JSON_DOC_SIZE);
+
+    if (nullptr == response)
+    {
+        request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        return;
+    }
+
+    JsonDocument& jsonDoc = response->getJsonDoc();
+
     if (HTTP_GET != request->method())
     {
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
@@ -600,7 +1153,7 @@ static void handleSettings(AsyncWebServerRequest* request)
         httpStatusCode = HttpStatus::STATUS_CODE_OK;
     }
 
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+    RestUtil::sendJsonRsp(request, response, httpStatusCode);
 
     return;
 }
@@ -615,7 +1168,7 @@ static void handleSettings(AsyncWebServerRequest* request)
 static void handleSetting(AsyncWebServerRequest* request)
 {
     const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -689,7 +1242,7 @@ static void handleSetting(AsyncWebServerRequest* request)
                 {
                     KeyValueJson*           kvJson      = static_cast<KeyValueJson*>(setting);
                     JsonObject              valueObj    = dataObj.createNestedObject("value");
-                    DynamicJsonDocument     jsonBuffer(JSON_DOC_SIZE);
+                    PooledJsonDocument      jsonBuffer(JSON_DOC_SIZE);
                     DeserializationError    error       = deserializeJson(jsonBuffer, kvJson->getValue());
 
                     if (DeserializationError::Ok != error.code())
@@ -1025,8 +1578,8 @@ static bool storeSetting(KeyValue* parameter, const String& value, String& error
 static void handleStatus(AsyncWebServerRequest* request)
 {
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    const size_t        JSON_DOC_SIZE   = 2048U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1040,13 +1593,28 @@ static void handleStatus(AsyncWebServerRequest* request)
     }
     else
     {
-        String      ssid;
-        int8_t      rssi            = -100; // dbm
-        JsonVariant dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
-        JsonObject  hwObj           = dataObj.createNestedObject("hardware");
-        JsonObject  swObj           = dataObj.createNestedObject("software");
-        JsonObject  internalRamObj  = swObj.createNestedObject("internalRam");
-        JsonObject  wifiObj         = dataObj.createNestedObject("wifi");
+        String                      ssid;
+        int8_t                      rssi            = -100; // dbm
+        uint32_t                    renderRate      = 0U;
+        uint32_t                    transmitRate    = 0U;
+        JsonVariant                 dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
+        JsonObject                  hwObj           = dataObj.createNestedObject("hardware");
+        JsonObject                  swObj           = dataObj.createNestedObject("software");
+        JsonObject                  internalRamObj  = swObj.createNestedObject("internalRam");
+        JsonObject                  jsonDocPoolObj  = swObj.createNestedObject("jsonDocPool");
+        JsonArray                   sizeClassArray  = jsonDocPoolObj.createNestedArray("sizeClasses");
+        JsonObject                  wifiObj         = dataObj.createNestedObject("wifi");
+        JsonObject                  displayObj      = dataObj.createNestedObject("display");
+        JsonDocPool&                jsonDocPool     = JsonDocPool::getInstance();
+        JsonDocPool::Statistics     statistics;
+        uint8_t                     sizeClass       = 0U;
+        JsonArray                   tlsArray        = swObj.createNestedArray("tls");
+        HttpConnectionPool&         httpConnPool    = HttpConnectionPool::getInstance();
+        uint8_t                     tlsIndex        = 0U;
+        JsonObject                  fetchObj        = swObj.createNestedObject("fetchScheduler");
+        FetchScheduler::Statistics  fetchStatistics;
+        JsonObject                  parseWorkerObj  = swObj.createNestedObject("parseWorker");
+        ParseWorker::Statistics     parseStatistics;
 
         /* Only in station mode it makes sense to retrieve the RSSI.
          * Otherwise keep it -100 dbm.
@@ -1073,10 +1641,70 @@ static void handleStatus(AsyncWebServerRequest* request)
         internalRamObj["heapSize"]      = ESP.getHeapSize();
         internalRamObj["availableHeap"] = ESP.getFreeHeap();
 
+        /* Misses and oversized requests are served by the heap. */
+        for(sizeClass = 0U; sizeClass < JsonDocPool::SIZE_CLASS_CNT; ++sizeClass)
+        {
+            if (true == jsonDocPool.getStatistics(sizeClass, statistics))
+            {
+                JsonObject sizeClassObj = sizeClassArray.createNestedObject();
+
+                sizeClassObj["blockSize"]   = statistics.blockSize;
+                sizeClassObj["blockCnt"]    = statistics.blockCnt;
+                sizeClassObj["used"]        = statistics.used;
+                sizeClassObj["highWater"]   = statistics.highWater;
+                sizeClassObj["hits"]        = statistics.hits;
+                sizeClassObj["misses"]      = statistics.misses;
+            }
+        }
+
+        jsonDocPoolObj["oversize"] = jsonDocPool.getOversizeCnt();
+
+        /* Connection establishment incl. TLS handshake per host. */
+        for(tlsIndex = 0U; tlsIndex < HttpConnectionPool::TLS_STATISTICS_CNT; ++tlsIndex)
+        {
+            HttpConnectionPool::TlsStatistics tlsStatistics;
+
+            if (true == httpConnPool.getTlsStatistics(tlsIndex, tlsStatistics))
+            {
+                JsonObject tlsObj = tlsArray.createNestedObject();
+
+                tlsObj["host"]          = tlsStatistics.host;
+                tlsObj["port"]          = tlsStatistics.port;
+                tlsObj["handshakes"]    = tlsStatistics.handshakes;
+                tlsObj["reused"]        = tlsStatistics.reused;
+                tlsObj["durationAvg"]   = tlsStatistics.durationAvg;    // ms
+                tlsObj["durationMax"]   = tlsStatistics.durationMax;    // ms
+                tlsObj["heapMax"]       = tlsStatistics.heapMax;        // byte
+            }
+        }
+
+        /* Response handling in the TCP task. */
+        FetchScheduler::getInstance().getStatistics(fetchStatistics);
+
+        fetchObj["responses"]       = fetchStatistics.responses;
+        fetchObj["bodyDurationMax"] = fetchStatistics.bodyDurationMax;  // us
+        fetchObj["rspDurationAvg"]  = fetchStatistics.rspDurationAvg;   // us
+        fetchObj["rspDurationMax"]  = fetchStatistics.rspDurationMax;   // us
+
+        /* Response decoding, filtering and deserialization in the background. */
+        ParseWorker::getInstance().getStatistics(parseStatistics);
+
+        parseWorkerObj["jobs"]          = parseStatistics.jobs;
+        parseWorkerObj["inlineJobs"]    = parseStatistics.inlineJobs;
+        parseWorkerObj["queueDepth"]    = parseStatistics.queueDepth;
+        parseWorkerObj["queueDepthMax"] = parseStatistics.queueDepthMax;
+        parseWorkerObj["durationAvg"]   = parseStatistics.durationAvg;  // ms
+        parseWorkerObj["durationMax"]   = parseStatistics.durationMax;  // ms
+
         wifiObj["ssid"]         = ssid;
         wifiObj["rssi"]         = rssi;                             // dBm
         wifiObj["quality"]      = WiFiUtil::getSignalQuality(rssi); // percent
 
+        DisplayMgr::getInstance().getRefreshRates(renderRate, transmitRate);
+
+        displayObj["renderRate"]    = renderRate;   // updates per second
+        displayObj["transmitRate"]  = transmitRate; // refreshes per second
+
         httpStatusCode          = HttpStatus::STATUS_CODE_OK;
     }
 
@@ -1087,6 +1715,8 @@ static void handleStatus(AsyncWebServerRequest* request)
 
 /**
  * List files of given directory (?dir=<path>).
+ * The listing is paged (?page=<page>) and streamed with chunked transfer
+ * encoding, while the directory is read lazily.
  * 
  * GET \c "/api/v1/fs"
  *
@@ -1094,11 +1724,6 @@ static void handleStatus(AsyncWebServerRequest* request)
  */
 static void handleFilesystem(AsyncWebServerRequest* request)
 {
-    String              content;
-    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 2048U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-
     if (nullptr == request)
     {
         return;
@@ -1106,89 +1731,207 @@ static void handleFilesystem(AsyncWebServerRequest* request)
 
     if (HTTP_GET != request->method())
     {
+        const size_t        JSON_DOC_SIZE   = 256U;
+        PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
-        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
     }
     else
     {
-        const String&   path                = request->arg("dir");
-        const String&   pageStr             = request->arg("page");
-        File            fdRoot              = FILESYSTEM.open(path, "r");
-        JsonArray       jsonData            = jsonDoc.createNestedArray("data");
-        const uint32_t  DEFAULT_MAX_FILES   = 15U;
-        uint32_t        count               = DEFAULT_MAX_FILES;
-        uint32_t        page                = 0U;
-        uint32_t        preCount            = page * count;
+        const String&               path                = request->arg("dir");
+        const String&               pageStr             = request->arg("page");
+        const uint32_t              DEFAULT_MAX_FILES   = 15U;
+        uint32_t                    page                = 0U;
+        std::shared_ptr<FsListing>  listing(new(std::nothrow) FsListing());
+        AsyncWebServerResponse*     response            = nullptr;
+
+        if (nullptr == listing)
+        {
+            request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+            return;
+        }
+
+        listing->count = DEFAULT_MAX_FILES;
 
         if (false == pageStr.isEmpty())
         {
             if (true == Util::strToUInt32(pageStr, page))
             {
-                preCount = page * count;
+                listing->preCount = page * DEFAULT_MAX_FILES;
             }
         }
 
-        if (false == fdRoot)
+        listing->fdRoot = FILESYSTEM.open(path, "r");
+
+        if (false == listing->fdRoot)
         {
             LOG_WARNING("Invalid path.");
         }
+        else if (false == listing->fdRoot.isDirectory())
+        {
+            LOG_WARNING("Requested path is not a directory.");
+            listing->fdRoot.close();
+        }
+
+        response = request->beginChunkedResponse(
+            "application/json",
+            [listing](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+            {
+                (void)index;
+                return fillFsListing(*listing, buffer, maxLen);
+            });
+
+        if (nullptr == response)
+        {
+            request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        }
         else
         {
-            if (false == fdRoot.isDirectory())
+            request->send(response);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Fill the response buffer with the next part of the filesystem listing.
+ * The listing parts are produced lazily, until the buffer is full.
+ *
+ * @param[in]   listing Filesystem listing context
+ * @param[out]  buffer  Response buffer
+ * @param[in]   maxLen  Response buffer size in byte
+ *
+ * @return Number of written bytes. If 0, the listing is complete.
+ */
+static size_t fillFsListing(FsListing& listing, uint8_t* buffer, size_t maxLen)
+{
+    size_t      written     = 0U;
+    bool        isComplete  = false;
+    uint32_t    freeHeap    = ESP.getFreeHeap();
+
+    if (listing.minHeap > freeHeap)
+    {
+        listing.minHeap = freeHeap;
+    }
+
+    while((maxLen > written) && (false == isComplete))
+    {
+        /* Send the rest of the current part first. */
+        if (listing.partLen > listing.partPos)
+        {
+            size_t partRest = listing.partLen - listing.partPos;
+            size_t copyLen  = maxLen - written;
+
+            if (partRest < copyLen)
             {
-                LOG_WARNING("Requested path is not a directory.");
+                copyLen = partRest;
             }
-            else
+
+            memcpy(&buffer[written], &listing.part[listing.partPos], copyLen);
+            written         += copyLen;
+            listing.partPos += copyLen;
+        }
+        else
+        {
+            listing.partLen = 0U;
+            listing.partPos = 0U;
+
+            switch(listing.state)
             {
-                File fd = fdRoot.openNextFile();
+            case FsListing::STATE_HEAD:
+                listing.partLen = snprintf(listing.part, sizeof(listing.part), "{\"data\":[");
+                listing.state   = FsListing::STATE_ENTRIES;
+                break;
 
-                while((true == fd) && (0U < count))
+            case FsListing::STATE_ENTRIES:
+                if (false == prepareNextFsEntry(listing))
                 {
-                    /* Page handling */
-                    if (0U < preCount)
-                    {
-                        --preCount;
-                    }
-                    else
-                    {
-                        JsonObject jsonFile = jsonData.createNestedObject();
+                    listing.state = FsListing::STATE_TAIL;
+                }
+                break;
 
-                        jsonFile["name"] = String(fd.name());
-                        jsonFile["size"] = fd.size();
+            case FsListing::STATE_TAIL:
+                listing.partLen = snprintf(listing.part, sizeof(listing.part), "],\"status\":\"ok\"}");
+                listing.state   = FsListing::STATE_DONE;
+                break;
 
-                        if (true == fd.isDirectory())
-                        {
-                            jsonFile["type"] = "dir";
-                        }
-                        else
-                        {
-                            jsonFile["type"] = "file";
-                        }
+            case FsListing::STATE_DONE:
+                /* fallthrough */
+            default:
+                isComplete = true;
+                break;
+            }
+        }
+    }
 
-                        --count;
-                    }
+    return written;
+}
 
-                    fd.close();
+/**
+ * Serialize the next directory entry of the filesystem listing.
+ * Entries before the requested page are skipped.
+ *
+ * @param[in] listing   Filesystem listing context
+ *
+ * @return If a entry is available, it will return true otherwise false.
+ */
+static bool prepareNextFsEntry(FsListing& listing)
+{
+    bool isAvailable = false;
 
-                    if (0U < count)
-                    {
-                        fd = fdRoot.openNextFile();
-                    }
-                }
-            }
+    while((false == isAvailable) && (0U < listing.count) && (true == listing.fdRoot))
+    {
+        File fd = listing.fdRoot.openNextFile();
 
-            fdRoot.close();
+        if (false == fd)
+        {
+            listing.fdRoot.close();
+        }
+        /* Page handling */
+        else if (0U < listing.preCount)
+        {
+            --listing.preCount;
+            fd.close();
         }
+        else
+        {
+            const size_t                        JSON_DOC_SIZE   = JSON_OBJECT_SIZE(3);
+            StaticJsonDocument<JSON_DOC_SIZE>   jsonDoc;
+            size_t                              offset          = 0U;
 
-        /* Prepare response */
-        jsonDoc["status"]   = "ok";
+            jsonDoc["name"] = fd.name();
+            jsonDoc["size"] = fd.size();
 
-        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
-    }
+            if (true == fd.isDirectory())
+            {
+                jsonDoc["type"] = "dir";
+            }
+            else
+            {
+                jsonDoc["type"] = "file";
+            }
 
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+            if (false == listing.isFirst)
+            {
+                listing.part[offset] = ',';
+                ++offset;
+            }
 
-    return;
+            /* The file name is only referenced by the JSON document,
+             * therefore the file is closed after serialization.
+             */
+            listing.partLen = offset + serializeJson(jsonDoc, &listing.part[offset], sizeof(listing.part) - offset);
+            fd.close();
+            listing.isFirst = false;
+
+            --listing.count;
+            isAvailable = true;
+        }
+    }
+
+    return isAvailable;
 }
 
 /**
@@ -1202,7 +1945,7 @@ static void handleFileGet(AsyncWebServerRequest* request)
 {
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1311,7 +2054,7 @@ static void handleFilePost(AsyncWebServerRequest* request)
 {
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1403,7 +2146,7 @@ static void handleFileDelete(AsyncWebServerRequest* request)
 {
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
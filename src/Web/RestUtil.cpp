@@ -139,6 +139,43 @@ void RestUtil::sendJsonRsp(AsyncWebServerRequest* request, const JsonDocument& j
     }
 }
 
+/**
+ * Send a application/json response to the client back. The JSON document
+ * of the response is streamed, without copying it into a string before.
+ * The response is owned by the webserver afterwards.
+ * 
+ * @param[in] request           Client request
+ * @param[in] response          JSON response
+ * @param[in] httpStatusCode    HTTP status code
+ */
+void RestUtil::sendJsonRsp(AsyncWebServerRequest* request, JsonDocResponse* response, uint32_t httpStatusCode)
+{
+    if (nullptr != response)
+    {
+        const JsonDocument& jsonDoc = response->getJsonDoc();
+
+        if (true == jsonDoc.overflowed())
+        {
+            LOG_ERROR("JSON document has less memory available.");
+        }
+        else
+        {
+            LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+        }
+
+        response->finalize(httpStatusCode);
+
+        if (nullptr != request)
+        {
+            request->send(response);
+        }
+        else
+        {
+            delete response;
+        }
+    }
+}
+
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
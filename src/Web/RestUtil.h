@@ -47,6 +47,8 @@
 #include <ArduinoJson.h>
 #include <ESPAsyncWebServer.h>
 
+#include "JsonDocResponse.h"
+
 /** REST API Utilities */
 namespace RestUtil
 {
@@ -96,6 +98,17 @@ void prepareRspErrorHttpMethodNotSupported(JsonDocument& jsonDoc);
  */
 void sendJsonRsp(AsyncWebServerRequest* request, const JsonDocument& jsonDoc, uint32_t httpStatusCode);
 
+/**
+ * Send a application/json response to the client back. The JSON document
+ * of the response is streamed, without copying it into a string before.
+ * The response is owned by the webserver afterwards.
+ * 
+ * @param[in] request           Client request
+ * @param[in] response          JSON response
+ * @param[in] httpStatusCode    HTTP status code
+ */
+void sendJsonRsp(AsyncWebServerRequest* request, JsonDocResponse* response, uint32_t httpStatusCode);
+
 }
 
 #endif  /* __REST_UTIL_H__ */
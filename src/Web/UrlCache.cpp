@@ -0,0 +1,146 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  URL cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "UrlCache.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool UrlCache::get(const String& url, Url& parts)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    Entry*                      entry   = find(url);
+    bool                        isFound = false;
+
+    if (nullptr != entry)
+    {
+        ++m_usageCounter;
+        entry->lastUsed = m_usageCounter;
+        parts           = entry->parts;
+        isFound         = true;
+    }
+
+    return isFound;
+}
+
+void UrlCache::add(const String& url, const Url& parts)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    Entry*                      entry   = find(url);
+
+    if (nullptr == entry)
+    {
+        uint8_t idx = 0U;
+
+        entry = &m_entries[0U];
+
+        /* Prefer a free entry, otherwise replace the least recently used one. */
+        for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+        {
+            if (true == m_entries[idx].url.isEmpty())
+            {
+                entry = &m_entries[idx];
+                break;
+            }
+
+            if ((m_usageCounter - m_entries[idx].lastUsed) > (m_usageCounter - entry->lastUsed))
+            {
+                entry = &m_entries[idx];
+            }
+        }
+
+        entry->url = url;
+    }
+
+    ++m_usageCounter;
+    entry->parts    = parts;
+    entry->lastUsed = m_usageCounter;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+UrlCache::Entry* UrlCache::find(const String& url)
+{
+    Entry*  entry   = nullptr;
+    uint8_t idx     = 0U;
+
+    if (false == url.isEmpty())
+    {
+        for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+        {
+            if (url == m_entries[idx].url)
+            {
+                entry = &m_entries[idx];
+                break;
+            }
+        }
+    }
+
+    return entry;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,188 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  URL cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __URL_CACHE_H__
+#define __URL_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+#include <Mutex.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The URL cache keeps the parts of the recently parsed URLs. The plugins
+ * request the same URLs cyclic, therefore a URL is parsed only once.
+ */
+class UrlCache
+{
+public:
+
+    /**
+     * The parts of a parsed URL.
+     */
+    struct Url
+    {
+        String      hostname;               /**< Server hostname */
+        uint16_t    port;                   /**< Server port */
+        bool        isSecure;               /**< Secure transport (true) or not (false) */
+        String      uri;                    /**< Request URI */
+        String      base64Authorization;    /**< Authorization BASE64 encoded */
+
+        /**
+         * Constructs a empty URL.
+         */
+        Url() :
+            hostname(),
+            port(0U),
+            isSecure(false),
+            uri(),
+            base64Authorization()
+        {
+        }
+    };
+
+    /**
+     * Get URL cache instance.
+     *
+     * @return URL cache instance
+     */
+    static UrlCache& getInstance()
+    {
+        static UrlCache instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Get the parts of a URL.
+     *
+     * @param[in]   url     URL
+     * @param[out]  parts   Parts of the URL
+     *
+     * @return If the URL is cached, it will return true otherwise false.
+     */
+    bool get(const String& url, Url& parts);
+
+    /**
+     * Add the parts of a successful parsed URL. If the cache is full, the
+     * least recently used URL is replaced.
+     *
+     * @param[in] url   URL
+     * @param[in] parts Parts of the URL
+     */
+    void add(const String& url, const Url& parts);
+
+    /** Max. number of cached URLs. */
+    static const uint8_t    MAX_ENTRIES     = 8U;
+
+private:
+
+    /**
+     * A single cache entry.
+     */
+    struct Entry
+    {
+        String      url;        /**< URL, empty if not used. */
+        Url         parts;      /**< Parts of the URL */
+        uint32_t    lastUsed;   /**< Usage counter value of the last access, used to replace the least recently used entry. */
+
+        /**
+         * Constructs a empty entry.
+         */
+        Entry() :
+            url(),
+            parts(),
+            lastUsed(0U)
+        {
+        }
+    };
+
+    mutable MutexRecursive  m_mutex;                /**< Mutex to protect against concurrent access. */
+    Entry                   m_entries[MAX_ENTRIES]; /**< Cache entries */
+    uint32_t                m_usageCounter;         /**< Incremented with every access, used for the replacement strategy. */
+
+    /**
+     * Constructs the URL cache.
+     */
+    UrlCache() :
+        m_mutex(),
+        m_entries(),
+        m_usageCounter(0U)
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the URL cache.
+     */
+    ~UrlCache()
+    {
+        m_mutex.destroy();
+    }
+
+    UrlCache(const UrlCache& cache);
+    UrlCache& operator=(const UrlCache& cache);
+
+    /**
+     * Find the entry of a URL.
+     *
+     * @param[in] url   URL
+     *
+     * @return If found, it will return the entry otherwise nullptr.
+     */
+    Entry* find(const String& url);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __URL_CACHE_H__ */
+
+/** @} */
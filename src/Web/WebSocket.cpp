@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "WebSocket.h"
 #include "Settings.h"
+#include "DisplayMirror.h"
+#include "LiveStreamPlugin.h"
 
 #include "WsCmdAlias.h"
 #include "WsCmdBrightness.h"
@@ -43,15 +45,18 @@
 #include "WsCmdInstall.h"
 #include "WsCmdIperf.h"
 #include "WsCmdLog.h"
+#include "WsCmdMirror.h"
 #include "WsCmdMove.h"
 #include "WsCmdPlugins.h"
 #include "WsCmdReset.h"
 #include "WsCmdSlotDuration.h"
 #include "WsCmdSlots.h"
+#include "WsCmdStats.h"
 #include "WsCmdUninstall.h"
 
 #include <Logging.h>
 #include <Util.h>
+#include <new>
 
 /******************************************************************************
  * Compiler Switches
@@ -115,6 +120,12 @@ static WsCmdEffect          gWsCmdEffect;
 /** Websocket get/set plugin alias name command */
 static WsCmdAlias           gWsCmdAlias;
 
+/** Websocket frame time statistics command */
+static WsCmdStats           gWsCmdStats;
+
+/** Websocket display mirror subscription command */
+static WsCmdMirror          gWsCmdMirror;
+
 /** Websocket command list */
 static WsCmd*       gWsCommands[] =
 {
@@ -131,7 +142,9 @@ static WsCmd*       gWsCommands[] =
     &gWsCmdIperf,
     &gWsCmdButton,
     &gWsCmdEffect,
-    &gWsCmdAlias
+    &gWsCmdAlias,
+    &gWsCmdStats,
+    &gWsCmdMirror
 };
 
 /******************************************************************************
@@ -168,6 +181,14 @@ void WebSocketSrv::init(AsyncWebServer& srv)
     return;
 }
 
+void WebSocketSrv::process()
+{
+    /* Push the display content to the mirror subscribers. */
+    DisplayMirror::getInstance().process(m_webSocket);
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -229,6 +250,9 @@ void WebSocketSrv::onConnect(AsyncWebSocket* server, AsyncWebSocketClient* clien
 void WebSocketSrv::onDisconnect(AsyncWebSocket* server, AsyncWebSocketClient* client)
 {
     LOG_INFO("ws[%s][%u] Client disconnected.", server->url(), client->id());
+
+    DisplayMirror::getInstance().unsubscribe(client->id());
+
     return;
 }
 
@@ -270,6 +294,11 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
         LOG_ERROR("ws[%s][%u] Frame info is missing.", server->url(), client->id());
         server->close(client->id(), 0U, "Frame info is missing.");
     }
+    /* Binary frame, which carries a stream packet? */
+    else if (WS_BINARY == info->opcode)
+    {
+        handleBinaryMsg(server, client, info, data, len);
+    }
     /* No text frame? */
     else if (WS_TEXT != info->opcode)
     {
@@ -303,6 +332,78 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
     return;
 }
 
+void WebSocketSrv::handleBinaryMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsFrameInfo* info, const uint8_t* data, size_t len)
+{
+    /* Is the whole message in a single frame and we got all of it's data? */
+    if ((0U < info->final) &&
+        (0U == info->index) &&
+        (len == info->len))
+    {
+        if (false == LiveStreamPlugin::dispatch(data, len))
+        {
+            LOG_WARNING("ws[%s][%u] Stream packet not dispatched.", server->url(), client->id());
+        }
+    }
+    /* Frame is split into multiple packets, which are collected. */
+    else if (0U == info->num)
+    {
+        /* First packet of the frame? */
+        if (0U == info->index)
+        {
+            m_binaryMsgSize     = 0U;
+            m_binaryMsgClientId = client->id();
+
+            if (BINARY_MSG_SIZE_MAX < info->len)
+            {
+                LOG_WARNING("ws[%s][%u] Binary message too long: %u byte", server->url(), client->id(), static_cast<uint32_t>(info->len));
+            }
+            /* The buffer is reused for all further messages. */
+            else if (m_binaryMsgCapacity < info->len)
+            {
+                if (nullptr != m_binaryMsg)
+                {
+                    delete[] m_binaryMsg;
+                }
+
+                m_binaryMsg         = new(std::nothrow) uint8_t[static_cast<size_t>(info->len)];
+                m_binaryMsgCapacity = (nullptr == m_binaryMsg) ? 0U : static_cast<size_t>(info->len);
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        /* Only a continuous message of one client can be collected. */
+        if ((client->id() == m_binaryMsgClientId) &&
+            (m_binaryMsgCapacity >= info->len) &&
+            (m_binaryMsgSize == info->index) &&
+            (info->len >= (info->index + len)))
+        {
+            (void)memcpy(&m_binaryMsg[m_binaryMsgSize], data, len);
+            m_binaryMsgSize += len;
+
+            if ((0U < info->final) &&
+                (info->len == m_binaryMsgSize))
+            {
+                if (false == LiveStreamPlugin::dispatch(m_binaryMsg, m_binaryMsgSize))
+                {
+                    LOG_WARNING("ws[%s][%u] Stream packet not dispatched.", server->url(), client->id());
+                }
+
+                m_binaryMsgSize = 0U;
+            }
+        }
+    }
+    /* Message is comprised of multiple frames */
+    else
+    {
+        LOG_ERROR("ws[%s][%u] Fragmented binary messages not supported.", server->url(), client->id());
+    }
+
+    return;
+}
+
 void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const char* msg, size_t msgLen)
 {
     size_t      msgIndex    = 0U;
@@ -83,15 +83,32 @@ public:
      */
     void init(AsyncWebServer& srv);
 
+    /**
+     * Process the websocket server, which pushes the display content to
+     * the display mirror subscribers. Call it cyclic.
+     */
+    void process();
+
 private:
 
-    AsyncWebSocket  m_webSocket;    /**< Websocket */
+    /** Max. size of a binary message in byte, which is split into multiple packets. */
+    static const size_t BINARY_MSG_SIZE_MAX = 16384U;
+
+    AsyncWebSocket  m_webSocket;            /**< Websocket */
+    uint8_t*        m_binaryMsg;            /**< Buffer to collect a binary message, which is split into multiple packets. */
+    size_t          m_binaryMsgCapacity;    /**< Binary message buffer size in byte */
+    size_t          m_binaryMsgSize;        /**< Number of collected bytes of the binary message */
+    uint32_t        m_binaryMsgClientId;    /**< Id of the websocket client, which sends the binary message. */
 
     /**
      * Constructs the websocket server.
      */
     WebSocketSrv() :
-        m_webSocket(WebConfig::WEBSOCKET_PATH)
+        m_webSocket(WebConfig::WEBSOCKET_PATH),
+        m_binaryMsg(nullptr),
+        m_binaryMsgCapacity(0U),
+        m_binaryMsgSize(0U),
+        m_binaryMsgClientId(0U)
     {
     }
 
@@ -100,6 +117,11 @@ private:
      */
     ~WebSocketSrv()
     {
+        if (nullptr != m_binaryMsg)
+        {
+            delete[] m_binaryMsg;
+            m_binaryMsg = nullptr;
+        }
     }
 
     /**
@@ -173,6 +195,18 @@ private:
      */
     void handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const char* msg, size_t msgLen);
 
+    /**
+     * Handle a websocket binary message, which carries a stream packet.
+     * A message, which is split into multiple packets, is collected before.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     * @param[in] info      Websocket frame info
+     * @param[in] data      Websocket data
+     * @param[in] len       Websocket data length in bytes
+     */
+    void handleBinaryMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsFrameInfo* info, const uint8_t* data, size_t len);
+
     /**
      * Write single data byte to all clients.
      *
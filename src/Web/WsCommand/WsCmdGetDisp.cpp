@@ -37,6 +37,8 @@
 
 #include <Util.h>
 #include <Display.h>
+#include <Logging.h>
+#include <new>
 
 /******************************************************************************
  * Compiler Switches
@@ -77,37 +79,72 @@ void WsCmdGetDisp::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     }
     else
     {
-        uint32_t    index       = 0U;
-        String      rsp         = "ACK";
-        const char  DELIMITER   = ';';
         IDisplay&   display     = Display::getInstance();
         uint32_t    framebuffer[display.getWidth() * display.getHeight()];
         uint8_t     slotId      = DisplayMgr::SLOT_ID_INVALID;
 
         DisplayMgr::getInstance().getFBCopy(framebuffer, UTIL_ARRAY_NUM(framebuffer), &slotId);
 
-        rsp += DELIMITER;
-        rsp += slotId;
-
-        for(index = 0U; index <  UTIL_ARRAY_NUM(framebuffer); ++index)
+        if (false == m_isBinary)
         {
-            rsp += DELIMITER;
-            rsp += Util::uint32ToHex(framebuffer[index]);
+            sendText(server, client, framebuffer, UTIL_ARRAY_NUM(framebuffer), slotId);
+        }
+        else
+        {
+            sendBinary(server, client, framebuffer, UTIL_ARRAY_NUM(framebuffer), slotId);
         }
-
-        server->text(client->id(), rsp);
     }
 
-    m_isError = false;
+    m_isError           = false;
+    m_parCnt            = 0U;
+    m_isBinary          = false;
+    m_colorFormat       = DisplayFrame::COLOR_FORMAT_RGB888;
+    m_isDeltaAllowed    = false;
 
     return;
 }
 
 void WsCmdGetDisp::setPar(const char* par)
 {
-    UTIL_NOT_USED(par);
+    String parStr(par);
+
+    switch(m_parCnt)
+    {
+    case 0:
+        m_isBinary = true;
+
+        if (parStr.equals("RGB888"))
+        {
+            m_colorFormat = DisplayFrame::COLOR_FORMAT_RGB888;
+        }
+        else if (parStr.equals("RGB565"))
+        {
+            m_colorFormat = DisplayFrame::COLOR_FORMAT_RGB565;
+        }
+        else
+        {
+            LOG_ERROR("Unknown color format: %s", par);
+            m_isError = true;
+        }
+        break;
+
+    case 1:
+        if (parStr.equals("DELTA"))
+        {
+            m_isDeltaAllowed = true;
+        }
+        else
+        {
+            m_isError = true;
+        }
+        break;
+
+    default:
+        m_isError = true;
+        break;
+    }
 
-    m_isError = true;
+    ++m_parCnt;
 
     return;
 }
@@ -120,6 +157,139 @@ void WsCmdGetDisp::setPar(const char* par)
  * Private Methods
  *****************************************************************************/
 
+void WsCmdGetDisp::sendText(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint32_t* framebuffer, size_t length, uint8_t slotId)
+{
+    /* "ACK;<slot-id>" and ";<color>" with up to 8 hex digits per pixel. */
+    const size_t    RSP_SIZE    = 8U + length * 9U;
+    size_t          index       = 0U;
+    String          rsp;
+    const char      DELIMITER   = ';';
+
+    /* Avoid the reallocation during the concatenation. */
+    (void)rsp.reserve(RSP_SIZE);
+
+    rsp += "ACK";
+    rsp += DELIMITER;
+    rsp += slotId;
+
+    for(index = 0U; index < length; ++index)
+    {
+        rsp += DELIMITER;
+        rsp += Util::uint32ToHex(framebuffer[index]);
+    }
+
+    server->text(client->id(), rsp);
+
+    return;
+}
+
+void WsCmdGetDisp::sendBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint32_t* framebuffer, size_t length, uint8_t slotId)
+{
+    IDisplay&                   display     = Display::getInstance();
+    DisplayFrame::FrameInfo     info        = { m_colorFormat, DisplayFrame::SOURCE_REQUEST, slotId, display.getWidth(), display.getHeight() };
+    const size_t                FRAME_SIZE  = DisplayFrame::getMaxFrameSize(info);
+    uint8_t*                    frame       = new(std::nothrow) uint8_t[FRAME_SIZE];
+
+    if (nullptr == frame)
+    {
+        server->text(client->id(), "NACK;\"Out of memory.\"");
+    }
+    else
+    {
+        ClientFrame*    clientFrame = getClientFrame(client->id(), length);
+        size_t          frameSize   = 0U;
+
+        /* A delta frame is only possible, if the client received the reference before in the same color format. */
+        if ((true == m_isDeltaAllowed) &&
+            (nullptr != clientFrame) &&
+            (true == clientFrame->isValid) &&
+            (m_colorFormat == clientFrame->format))
+        {
+            frameSize = DisplayFrame::encodeDeltaFrame(frame, FRAME_SIZE, info, framebuffer, clientFrame->pixels);
+        }
+
+        /* Delta frame not possible or bigger than a key frame? */
+        if (0U == frameSize)
+        {
+            frameSize = DisplayFrame::encodeKeyFrame(frame, info, framebuffer);
+        }
+
+        if (nullptr != clientFrame)
+        {
+            /* If the frame would be dropped, the client has no valid reference anymore. */
+            if (false == client->canSend())
+            {
+                clientFrame->isValid = false;
+            }
+            else
+            {
+                (void)memcpy(clientFrame->pixels, framebuffer, length * sizeof(uint32_t));
+
+                clientFrame->isValid    = true;
+                clientFrame->format     = m_colorFormat;
+            }
+        }
+
+        server->binary(client->id(), frame, frameSize);
+
+        delete[] frame;
+    }
+
+    return;
+}
+
+WsCmdGetDisp::ClientFrame* WsCmdGetDisp::getClientFrame(uint32_t clientId, size_t length)
+{
+    ClientFrame*    clientFrame = nullptr;
+    uint8_t         idx         = 0U;
+
+    ++m_usageCnt;
+
+    /* Known client? */
+    for(idx = 0U; idx < CLIENT_FRAME_MAX; ++idx)
+    {
+        if ((nullptr != m_clientFrames[idx].pixels) &&
+            (clientId == m_clientFrames[idx].clientId))
+        {
+            clientFrame = &m_clientFrames[idx];
+            break;
+        }
+    }
+
+    /* Replace the least recently used one. */
+    if (nullptr == clientFrame)
+    {
+        clientFrame = &m_clientFrames[0U];
+
+        for(idx = 1U; idx < CLIENT_FRAME_MAX; ++idx)
+        {
+            if ((m_usageCnt - m_clientFrames[idx].lastUsage) > (m_usageCnt - clientFrame->lastUsage))
+            {
+                clientFrame = &m_clientFrames[idx];
+            }
+        }
+
+        if (nullptr == clientFrame->pixels)
+        {
+            clientFrame->pixels = new(std::nothrow) uint32_t[length];
+        }
+
+        clientFrame->isValid    = false;
+        clientFrame->clientId   = clientId;
+    }
+
+    if (nullptr == clientFrame->pixels)
+    {
+        clientFrame = nullptr;
+    }
+    else
+    {
+        clientFrame->lastUsage = m_usageCnt;
+    }
+
+    return clientFrame;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
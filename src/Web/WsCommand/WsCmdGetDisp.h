@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include "WsCmd.h"
+#include <DisplayFrame.h>
 
 /******************************************************************************
  * Macros
@@ -55,6 +56,11 @@
 
 /**
  * Websocket command get display content
+ * 
+ * Without parameter the display content is sent in text format. With a
+ * color format as parameter, it is sent as binary frame. If additionally
+ * delta frames are allowed, only the pixels which changed since the last
+ * frame sent to the same client are transmitted.
  */
 class WsCmdGetDisp: public WsCmd
 {
@@ -65,7 +71,13 @@ public:
      */
     WsCmdGetDisp() :
         WsCmd("GETDISP"),
-        m_isError(false)
+        m_isError(false),
+        m_parCnt(0U),
+        m_isBinary(false),
+        m_colorFormat(DisplayFrame::COLOR_FORMAT_RGB888),
+        m_isDeltaAllowed(false),
+        m_clientFrames(),
+        m_usageCnt(0U)
     {
     }
 
@@ -74,6 +86,16 @@ public:
      */
     ~WsCmdGetDisp()
     {
+        uint8_t idx = 0U;
+
+        for(idx = 0U; idx < CLIENT_FRAME_MAX; ++idx)
+        {
+            if (nullptr != m_clientFrames[idx].pixels)
+            {
+                delete[] m_clientFrames[idx].pixels;
+                m_clientFrames[idx].pixels = nullptr;
+            }
+        }
     }
 
     /**
@@ -93,10 +115,78 @@ public:
 
 private:
 
-    bool    m_isError;  /**< Any error happened during parameter reception? */
+    /**
+     * The last frame, which was sent to a client. It is the reference for
+     * the next delta frame.
+     */
+    struct ClientFrame
+    {
+        bool                        isValid;    /**< Is reference valid? */
+        uint32_t                    clientId;   /**< Websocket client id */
+        DisplayFrame::ColorFormat   format;     /**< Color format, which was used. */
+        uint32_t*                   pixels;     /**< Pixels in RGB888 format */
+        uint32_t                    lastUsage;  /**< Usage counter value of the last usage, used to replace the least recently used one. */
+
+        /**
+         * Constructs a invalid client frame.
+         */
+        ClientFrame() :
+            isValid(false),
+            clientId(0U),
+            format(DisplayFrame::COLOR_FORMAT_RGB888),
+            pixels(nullptr),
+            lastUsage(0U)
+        {
+        }
+    };
+
+    /** Max. number of clients, which can receive delta frames at the same time. */
+    static const uint8_t    CLIENT_FRAME_MAX    = 2U;
+
+    bool                        m_isError;                          /**< Any error happened during parameter reception? */
+    uint8_t                     m_parCnt;                           /**< Number of received parameters */
+    bool                        m_isBinary;                         /**< Send display content as binary frame? */
+    DisplayFrame::ColorFormat   m_colorFormat;                      /**< Color format of the binary frame */
+    bool                        m_isDeltaAllowed;                   /**< Is a delta frame allowed? */
+    ClientFrame                 m_clientFrames[CLIENT_FRAME_MAX];   /**< Last frames sent to the clients */
+    uint32_t                    m_usageCnt;                         /**< Usage counter, used to determine the least recently used client frame. */
 
     WsCmdGetDisp(const WsCmdGetDisp& cmd);
     WsCmdGetDisp& operator=(const WsCmdGetDisp& cmd);
+
+    /**
+     * Send the display content in text format.
+     *
+     * @param[in] server        Websocket server
+     * @param[in] client        Websocket client
+     * @param[in] framebuffer   Framebuffer copy in RGB888 format
+     * @param[in] length        Number of pixels in the framebuffer copy
+     * @param[in] slotId        Id of the slot, from which the copy was taken.
+     */
+    void sendText(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint32_t* framebuffer, size_t length, uint8_t slotId);
+
+    /**
+     * Send the display content as binary frame.
+     *
+     * @param[in] server        Websocket server
+     * @param[in] client        Websocket client
+     * @param[in] framebuffer   Framebuffer copy in RGB888 format
+     * @param[in] length        Number of pixels in the framebuffer copy
+     * @param[in] slotId        Id of the slot, from which the copy was taken.
+     */
+    void sendBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint32_t* framebuffer, size_t length, uint8_t slotId);
+
+    /**
+     * Get the frame, which was sent last to the client. If the client is
+     * unknown, the least recently used one will be invalidated and assigned
+     * to the client.
+     *
+     * @param[in] clientId  Websocket client id
+     * @param[in] length    Number of pixels per frame
+     *
+     * @return Client frame or nullptr, if no memory is available.
+     */
+    ClientFrame* getClientFrame(uint32_t clientId, size_t length);
 };
 
 /******************************************************************************
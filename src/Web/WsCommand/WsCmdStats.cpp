@@ -0,0 +1,184 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to get the frame time statistics
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmdStats.h"
+#include "WebSocket.h"
+
+#include "DisplayMgr.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void WsCmdStats::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    /* Any error happended? */
+    if (true == m_isError)
+    {
+        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+    }
+    else
+    {
+        String                          rsp         = "ACK";
+        const char                      DELIMITER   = ';';
+        DisplayMgr&                     displayMgr  = DisplayMgr::getInstance();
+        DisplayMgr::FrameTimeHistogram  histogram;
+        uint8_t                         idx         = 0U;
+
+        /* Reset the statistics? */
+        if (true == m_isReset)
+        {
+            displayMgr.resetStatistics();
+        }
+        /* Enable/Disable the statistics? */
+        else if (0 < m_cnt)
+        {
+            displayMgr.enableStatistics(m_isEnabled);
+        }
+        else
+        {
+            /* Nothing to do. */
+            ;
+        }
+
+        rsp += DELIMITER;
+        rsp += (true == displayMgr.isStatisticsEnabled()) ? "1" : "0";
+
+        for(idx = 0U; idx < DisplayMgr::STATISTICS_ID_MAX; ++idx)
+        {
+            DisplayMgr::StatisticsId id = static_cast<DisplayMgr::StatisticsId>(idx);
+
+            if (true == displayMgr.getStatistics(id, histogram))
+            {
+                rsp += DELIMITER;
+                rsp += "\"";
+                rsp += DisplayMgr::getStatisticsName(id);
+                rsp += "\"";
+                rsp += DELIMITER;
+                rsp += histogram.getCount();
+                rsp += DELIMITER;
+                rsp += histogram.getMin();
+                rsp += DELIMITER;
+                rsp += histogram.getPercentile(50U);
+                rsp += DELIMITER;
+                rsp += histogram.getPercentile(99U);
+                rsp += DELIMITER;
+                rsp += histogram.getMax();
+                rsp += DELIMITER;
+                rsp += histogram.getAvg();
+            }
+        }
+
+        server->text(client->id(), rsp);
+    }
+
+    m_cnt       = 0U;
+    m_isError   = false;
+    m_isReset   = false;
+
+    return;
+}
+
+void WsCmdStats::setPar(const char* par)
+{
+    if (0U == m_cnt)
+    {
+        if (0 == strcmp(par, "0"))
+        {
+            m_isEnabled = false;
+        }
+        else if (0 == strcmp(par, "1"))
+        {
+            m_isEnabled = true;
+        }
+        else if (0 == strcmp(par, "RESET"))
+        {
+            m_isReset = true;
+        }
+        else
+        {
+            m_isError = true;
+        }
+
+        ++m_cnt;
+    }
+    else
+    {
+        m_isError = true;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -36,6 +36,7 @@
 #include <Logging.h>
 #include <LogSinkPrinter.h>
 #include "LogSinkWebsocket.h"
+#include "WebSocket.h"
 #include <StateMachine.hpp>
 #include <Board.h>
 
@@ -127,6 +128,13 @@ void loop()
     /* Process system state machine */
     gSysStateMachine.process();
 
+    /* Push the display content to the websocket display mirror subscribers.
+     * This is done in every system state, because a client may stay
+     * connected e.g. during a reconnect. In access point mode there is
+     * no websocket, so there are no subscribers and it returns immediately.
+     */
+    WebSocketSrv::getInstance().process();
+
     /* Task monitor */
     TaskMon::getInstance().process();
 
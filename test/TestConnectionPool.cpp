@@ -0,0 +1,443 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test connection pool.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestConnectionPool.h"
+
+#include <unity.h>
+#include <ConnectionPool.hpp>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Connection to the stand-in server. */
+struct StandInConn
+{
+    bool        isOpen;     /**< Is connection open? */
+    uint32_t    requests;   /**< Number of requests, handled over this connection. */
+};
+
+/**
+ * Local stand-in for a HTTP server, which keeps connections alive and counts
+ * every accepted connection.
+ */
+class StandInServer
+{
+public:
+
+    /**
+     * Constructs the server.
+     */
+    StandInServer() :
+        m_acceptCnt(0U),
+        m_requestCnt(0U)
+    {
+    }
+
+    /**
+     * Destroys the server.
+     */
+    ~StandInServer()
+    {
+    }
+
+    /**
+     * Accept a new connection.
+     *
+     * @return Connection
+     */
+    StandInConn* accept()
+    {
+        StandInConn* conn = new(std::nothrow) StandInConn;
+
+        if (nullptr != conn)
+        {
+            conn->isOpen    = true;
+            conn->requests  = 0U;
+
+            ++m_acceptCnt;
+        }
+
+        return conn;
+    }
+
+    /**
+     * Handle a request. The connection is kept alive afterwards.
+     *
+     * @param[in] conn  Connection
+     *
+     * @return If the request was handled, it will return true otherwise false.
+     */
+    bool handle(StandInConn* conn)
+    {
+        if ((nullptr == conn) ||
+            (false == conn->isOpen))
+        {
+            return false;
+        }
+
+        ++conn->requests;
+        ++m_requestCnt;
+
+        return true;
+    }
+
+    /**
+     * Close a connection.
+     *
+     * @param[in] conn  Connection
+     */
+    void close(StandInConn* conn)
+    {
+        delete conn;
+    }
+
+    /**
+     * Get number of accepted connections.
+     *
+     * @return Number of accepted connections
+     */
+    uint32_t getAcceptCount() const
+    {
+        return m_acceptCnt;
+    }
+
+    /**
+     * Get number of handled requests.
+     *
+     * @return Number of handled requests
+     */
+    uint32_t getRequestCount() const
+    {
+        return m_requestCnt;
+    }
+
+private:
+
+    uint32_t    m_acceptCnt;    /**< Number of accepted connections */
+    uint32_t    m_requestCnt;   /**< Number of handled requests */
+
+    StandInServer(const StandInServer& server);
+    StandInServer& operator=(const StandInServer& server);
+};
+
+class TestClient;
+
+/** Pool with connections to the stand-in server, owned by test clients. */
+typedef ConnectionPool<StandInConn, TestClient, 4U> TestPool;
+
+/**
+ * HTTP client, which uses the pool like the AsyncHttpClient does.
+ */
+class TestClient
+{
+public:
+
+    /**
+     * Constructs the client.
+     *
+     * @param[in] pool      Connection pool
+     * @param[in] server    Stand-in server
+     */
+    TestClient(TestPool& pool, StandInServer& server) :
+        m_pool(pool),
+        m_server(server),
+        m_conn(nullptr)
+    {
+    }
+
+    /**
+     * Destroys the client.
+     */
+    ~TestClient()
+    {
+        m_pool.detach(this);
+    }
+
+    /**
+     * Send a request. A idle connection is preferred, otherwise a new one
+     * is established.
+     *
+     * @param[in] host  Host name
+     *
+     * @return If successful sent, it will return true otherwise false.
+     */
+    bool request(const char* host)
+    {
+        m_conn = m_pool.acquireIdle(host, PORT, false, this);
+
+        if (nullptr == m_conn)
+        {
+            m_conn = m_server.accept();
+
+            if (false == m_pool.add(m_conn, host, PORT, false, this))
+            {
+                m_server.close(m_conn);
+                m_conn = nullptr;
+            }
+        }
+
+        return m_server.handle(m_conn);
+    }
+
+    /**
+     * Response received, release the connection to the pool.
+     *
+     * @param[in] timestamp Current timestamp in ms
+     */
+    void finish(uint32_t timestamp)
+    {
+        (void)m_pool.release(m_conn, timestamp);
+        m_conn = nullptr;
+    }
+
+    /**
+     * Get the current connection.
+     *
+     * @return Connection
+     */
+    StandInConn* getConn()
+    {
+        return m_conn;
+    }
+
+    /** Port of the stand-in server */
+    static const uint16_t PORT = 80U;
+
+private:
+
+    TestPool&       m_pool;     /**< Connection pool */
+    StandInServer&  m_server;   /**< Stand-in server */
+    StandInConn*    m_conn;     /**< Current connection */
+
+    TestClient(const TestClient& client);
+    TestClient& operator=(const TestClient& client);
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void closeExpired(TestPool& pool, StandInServer& server, StandInConn* conn, uint32_t timestamp);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test connection pool.
+ */
+extern void testConnectionPool()
+{
+    const size_t    MAX_CONNS_PER_HOST  = 2U;
+    const uint32_t  IDLE_TIMEOUT        = 10000U;
+    const char*     HOST_A              = "api.example.org";
+    const char*     HOST_B              = "example.com";
+    TestPool        pool(MAX_CONNS_PER_HOST, IDLE_TIMEOUT);
+    StandInServer   server;
+    TestClient      client1(pool, server);
+    TestClient      client2(pool, server);
+    TestClient      client3(pool, server);
+    StandInConn*    conn                = nullptr;
+    StandInConn     otherConn;
+    uint32_t        idx                 = 0U;
+
+    /* Empty pool */
+    TEST_ASSERT_EQUAL_UINT32(0U, pool.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0U, pool.getIdleCount());
+    TEST_ASSERT_NULL(pool.acquireIdle(HOST_A, TestClient::PORT, false, &client1));
+    TEST_ASSERT_FALSE(pool.release(nullptr, 0U));
+    TEST_ASSERT_FALSE(pool.remove(nullptr));
+
+    /* Sequential requests to the same host use a single connection. */
+    for(idx = 0U; idx < 5U; ++idx)
+    {
+        TEST_ASSERT_TRUE(client1.request(HOST_A));
+        TEST_ASSERT_EQUAL_PTR(&client1, pool.getOwner(client1.getConn()));
+        TEST_ASSERT_EQUAL_STRING(HOST_A, pool.getHost(client1.getConn()));
+        client1.finish(idx * 100U);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1U, server.getAcceptCount());
+    TEST_ASSERT_EQUAL_UINT32(5U, server.getRequestCount());
+    TEST_ASSERT_EQUAL_UINT32(1U, pool.getCount());
+    TEST_ASSERT_EQUAL_UINT32(1U, pool.getIdleCount());
+
+    /* Different client, same host, the idle connection is handed over. */
+    TEST_ASSERT_TRUE(client2.request(HOST_A));
+    TEST_ASSERT_EQUAL_UINT32(1U, server.getAcceptCount());
+    TEST_ASSERT_EQUAL_UINT32(6U, client2.getConn()->requests);
+    TEST_ASSERT_EQUAL_PTR(&client2, pool.getOwner(client2.getConn()));
+    TEST_ASSERT_EQUAL_UINT32(0U, pool.getIdleCount());
+
+    /* Concurrent request to the same host needs a second connection. */
+    TEST_ASSERT_TRUE(client1.request(HOST_A));
+    TEST_ASSERT_EQUAL_UINT32(2U, server.getAcceptCount());
+    TEST_ASSERT_TRUE(client1.getConn() != client2.getConn());
+
+    /* Per host limit is reached, a third concurrent request is refused. */
+    TEST_ASSERT_FALSE(client3.request(HOST_A));
+    TEST_ASSERT_EQUAL_UINT32(3U, server.getAcceptCount());
+    TEST_ASSERT_EQUAL_UINT32(2U, pool.getCount());
+
+    /* Other host is not affected by the limit. */
+    TEST_ASSERT_TRUE(client3.request(HOST_B));
+    TEST_ASSERT_EQUAL_UINT32(4U, server.getAcceptCount());
+    TEST_ASSERT_EQUAL_UINT32(3U, pool.getCount());
+
+    /* Other port or secure connection is a different key. */
+    TEST_ASSERT_NULL(pool.acquireIdle(HOST_A, 443U, false, &client3));
+    TEST_ASSERT_NULL(pool.acquireIdle(HOST_A, TestClient::PORT, true, &client3));
+
+    /* Release all, they become idle. */
+    client1.finish(1000U);
+    client2.finish(1000U);
+    client3.finish(1000U);
+    TEST_ASSERT_EQUAL_UINT32(3U, pool.getCount());
+    TEST_ASSERT_EQUAL_UINT32(3U, pool.getIdleCount());
+    TEST_ASSERT_NULL(pool.getOwner(client1.getConn()));
+
+    /* Idle timeout not expired yet, the connection is reused. */
+    TEST_ASSERT_TRUE(client3.request(HOST_B));
+    TEST_ASSERT_EQUAL_UINT32(4U, server.getAcceptCount());
+    conn = client3.getConn();
+    client3.finish(2000U);
+    TEST_ASSERT_FALSE(pool.isIdleExpired(conn, 2000U + IDLE_TIMEOUT - 1U));
+
+    /* Idle timeout expired, the connection is closed and a new one is established. */
+    TEST_ASSERT_TRUE(pool.isIdleExpired(conn, 2000U + IDLE_TIMEOUT));
+    closeExpired(pool, server, conn, 2000U + IDLE_TIMEOUT);
+    TEST_ASSERT_FALSE(pool.isKnown(conn));
+    TEST_ASSERT_EQUAL_UINT32(2U, pool.getCount());
+    TEST_ASSERT_TRUE(client3.request(HOST_B));
+    TEST_ASSERT_EQUAL_UINT32(5U, server.getAcceptCount());
+    TEST_ASSERT_EQUAL_UINT32(1U, client3.getConn()->requests);
+
+    /* Connection in use never expires. */
+    TEST_ASSERT_FALSE(pool.isIdle(client3.getConn()));
+    TEST_ASSERT_FALSE(pool.isIdleExpired(client3.getConn(), 100000U));
+
+    /* Timestamp overflow is considered. */
+    conn = client3.getConn();
+    client3.finish(0xFFFFFF00U);
+    TEST_ASSERT_TRUE(pool.isIdle(conn));
+    TEST_ASSERT_FALSE(pool.isIdleExpired(conn, 0x00000010U));
+
+    /* Total limit */
+    TEST_ASSERT_TRUE(client1.request("a.example.com"));
+    TEST_ASSERT_EQUAL_UINT32(4U, pool.getCount());
+    TEST_ASSERT_FALSE(client2.request("b.example.com"));
+    TEST_ASSERT_EQUAL_UINT32(4U, pool.getCount());
+
+    /* The connection, which is idle for the longest time, can be evicted. */
+    TEST_ASSERT_EQUAL_PTR(conn, pool.getOldestIdle(0xFFFFFF00U + 2U * IDLE_TIMEOUT));
+    TEST_ASSERT_TRUE(conn != pool.getOldestIdle(0x00000010U));
+    TEST_ASSERT_TRUE(pool.isIdle(pool.getOldestIdle(0x00000010U)));
+
+    /* Detached owner leaves the connection in use, until it is removed. */
+    conn = client1.getConn();
+    pool.detach(&client1);
+    TEST_ASSERT_NULL(pool.getOwner(conn));
+    TEST_ASSERT_FALSE(pool.isIdle(conn));
+    TEST_ASSERT_TRUE(pool.remove(conn));
+    TEST_ASSERT_NULL(pool.getHost(conn));
+    server.close(conn);
+    TEST_ASSERT_EQUAL_UINT32(3U, pool.getCount());
+
+    /* Too long host name */
+    TEST_ASSERT_FALSE(pool.add(&otherConn, "0123456789012345678901234567890123456789012345678901234567890123", TestClient::PORT, false, &client1));
+
+    /* Clean up */
+    while(0U < pool.getIdleCount())
+    {
+        conn = pool.acquireIdle(HOST_A, TestClient::PORT, false, nullptr);
+
+        if (nullptr == conn)
+        {
+            conn = pool.acquireIdle(HOST_B, TestClient::PORT, false, nullptr);
+        }
+
+        TEST_ASSERT_NOT_NULL(conn);
+        TEST_ASSERT_TRUE(pool.remove(conn));
+        server.close(conn);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0U, pool.getCount());
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Close the connection, if its idle timeout expired.
+ *
+ * @param[in] pool      Connection pool
+ * @param[in] server    Stand-in server
+ * @param[in] conn      Connection
+ * @param[in] timestamp Current timestamp in ms
+ */
+static void closeExpired(TestPool& pool, StandInServer& server, StandInConn* conn, uint32_t timestamp)
+{
+    if (true == pool.isIdleExpired(conn, timestamp))
+    {
+        (void)pool.remove(conn);
+        server.close(conn);
+    }
+}
@@ -0,0 +1,166 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test DNS cache.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestDnsCache.h"
+
+#include <unity.h>
+#include <DnsCache.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test DNS cache.
+ */
+extern void testDnsCache()
+{
+    const uint32_t  TTL             = 60000U;
+    const uint32_t  NEGATIVE_TTL    = 10000U;
+    const uint32_t  ADDRESS_1       = 0x0100A8C0U;
+    const uint32_t  ADDRESS_2       = 0x0200A8C0U;
+    DnsCache        cache;
+    uint32_t        address         = 0U;
+    uint8_t         idx             = 0U;
+    char            host[DnsCache::HOST_SIZE_MAX + 1U];
+
+    /* Empty cache */
+    TEST_ASSERT_EQUAL_UINT8(0U, cache.getCount());
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_MISS, cache.lookup("example.org", 0U, address));
+
+    /* Invalid host names are not cached. */
+    TEST_ASSERT_FALSE(cache.setResolved(nullptr, ADDRESS_1, TTL, 0U));
+    TEST_ASSERT_FALSE(cache.setResolved("", ADDRESS_1, TTL, 0U));
+
+    for(idx = 0U; idx < DnsCache::HOST_SIZE_MAX; ++idx)
+    {
+        host[idx] = 'a';
+    }
+    host[DnsCache::HOST_SIZE_MAX] = '\0';
+    TEST_ASSERT_FALSE(cache.setResolved(host, ADDRESS_1, TTL, 0U));
+
+    /* Pending resolution, which is lost after its timeout. */
+    TEST_ASSERT_TRUE(cache.setPending("example.org", 5000U, 1000U));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_PENDING, cache.lookup("example.org", 5999U, address));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_MISS, cache.lookup("example.org", 6000U, address));
+    TEST_ASSERT_EQUAL_UINT8(0U, cache.getCount());
+
+    /* Resolved host is valid for its time to live, case-insensitive. */
+    TEST_ASSERT_TRUE(cache.setPending("example.org", 5000U, 1000U));
+    TEST_ASSERT_TRUE(cache.setResolved("example.org", ADDRESS_1, TTL, 2000U));
+    TEST_ASSERT_EQUAL_UINT8(1U, cache.getCount());
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_RESOLVED, cache.lookup("Example.ORG", 2000U + TTL - 1U, address));
+    TEST_ASSERT_EQUAL_UINT32(ADDRESS_1, address);
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_MISS, cache.lookup("example.org", 2000U + TTL, address));
+
+    /* Timestamp overflow */
+    TEST_ASSERT_TRUE(cache.setResolved("example.org", ADDRESS_2, TTL, UINT32_MAX - 10U));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_RESOLVED, cache.lookup("example.org", 100U, address));
+    TEST_ASSERT_EQUAL_UINT32(ADDRESS_2, address);
+
+    /* Negative caching */
+    TEST_ASSERT_TRUE(cache.setFailed("unknown.example.org", NEGATIVE_TTL, 0U));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_FAILED, cache.lookup("unknown.example.org", NEGATIVE_TTL - 1U, address));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_MISS, cache.lookup("unknown.example.org", NEGATIVE_TTL, address));
+
+    /* Remove a host */
+    cache.remove("example.org");
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_MISS, cache.lookup("example.org", 100U, address));
+
+    /* If the cache is full, the least recently used host is replaced. */
+    cache.clear();
+
+    for(idx = 0U; idx < DnsCache::MAX_ENTRIES; ++idx)
+    {
+        host[0] = 'a' + idx;
+        host[1] = '\0';
+
+        TEST_ASSERT_TRUE(cache.setResolved(host, idx, TTL, 0U));
+    }
+    TEST_ASSERT_EQUAL_UINT8(DnsCache::MAX_ENTRIES, cache.getCount());
+
+    /* Use the first host, so the second one is the least recently used. */
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_RESOLVED, cache.lookup("a", 0U, address));
+    TEST_ASSERT_TRUE(cache.setResolved("new", ADDRESS_1, TTL, 0U));
+    TEST_ASSERT_EQUAL_UINT8(DnsCache::MAX_ENTRIES, cache.getCount());
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_RESOLVED, cache.lookup("a", 0U, address));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_MISS, cache.lookup("b", 0U, address));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_RESOLVED, cache.lookup("new", 0U, address));
+    TEST_ASSERT_EQUAL_UINT32(ADDRESS_1, address);
+
+    /* An expired host is replaced before the least recently used one. */
+    TEST_ASSERT_TRUE(cache.setResolved("c", 2U, 10U, 0U));
+    TEST_ASSERT_TRUE(cache.setResolved("newer", ADDRESS_2, TTL, 100U));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_MISS, cache.lookup("c", 100U, address));
+    TEST_ASSERT_EQUAL(DnsCache::RESULT_RESOLVED, cache.lookup("d", 100U, address));
+    TEST_ASSERT_EQUAL_UINT32(3U, address);
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,223 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test drawing command list.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestDrawCmd.h"
+
+#include <unity.h>
+#include <DrawCmd.h>
+#include <DrawCmdList.h>
+#include <YAGfxBitmap.h>
+#include <ColorDef.hpp>
+#include <TomThumb.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool isFilled(const YAGfxBitmap& bitmap, int16_t x, int16_t y, uint16_t width, uint16_t height, const Color& color);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Canvas width in pixel. */
+static const uint16_t   CANVAS_WIDTH    = 16U;
+
+/** Canvas height in pixel. */
+static const uint16_t   CANVAS_HEIGHT   = 8U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test drawing command list.
+ */
+extern void testDrawCmd()
+{
+    YAGfxDynamicBitmap  canvas(CANVAS_WIDTH, CANVAS_HEIGHT);
+    YAGfxDynamicBitmap  image(2U, 2U);
+    const YAGfxBitmap*  images[]        = { &image, nullptr };
+    const size_t        IMAGE_CNT       = sizeof(images) / sizeof(images[0]);
+    YAGfxText           text(&TomThumb);
+    DrawCmdList         cmdList;
+    const uint8_t       truncated[]     = { DrawCmd::OPCODE_FILL_RECT, 0U, 0U };
+    const uint8_t       unknown[]       = { DrawCmd::OPCODE_MAX, 0U, 0U, 0U };
+
+    TEST_ASSERT_TRUE(canvas.isAllocated());
+    TEST_ASSERT_TRUE(image.isAllocated());
+    image.fillScreen(ColorDef::BLUE);
+
+    /* Empty, truncated and unknown commands */
+    TEST_ASSERT_EQUAL(0U, DrawCmd::getCmdSize(nullptr, 0U));
+    TEST_ASSERT_EQUAL(0U, DrawCmd::getCmdSize(truncated, sizeof(truncated)));
+    TEST_ASSERT_EQUAL(0U, DrawCmd::getCmdSize(unknown, sizeof(unknown)));
+    TEST_ASSERT_TRUE(DrawCmd::validate(nullptr, 0U, 0U));
+    TEST_ASSERT_FALSE(DrawCmd::validate(truncated, sizeof(truncated), 0U));
+    TEST_ASSERT_FALSE(DrawCmd::validate(unknown, sizeof(unknown), 0U));
+
+    /* Without buffer, no command can be added. */
+    TEST_ASSERT_FALSE(cmdList.fillScreen(ColorDef::RED));
+    TEST_ASSERT_TRUE(cmdList.isOverflow());
+
+    /* A command which doesn't fit, is rejected without changing the list. */
+    TEST_ASSERT_TRUE(cmdList.create(8U));
+    TEST_ASSERT_FALSE(cmdList.isOverflow());
+    TEST_ASSERT_TRUE(cmdList.fillScreen(ColorDef::RED));
+    TEST_ASSERT_FALSE(cmdList.fillRect(0, 0, 1U, 1U, ColorDef::RED));
+    TEST_ASSERT_TRUE(cmdList.isOverflow());
+    TEST_ASSERT_EQUAL(4U, cmdList.getSize());
+    TEST_ASSERT_EQUAL(4U, DrawCmd::getCmdSize(cmdList.get(), cmdList.getSize()));
+
+    /* Execute a batch of commands at once. */
+    TEST_ASSERT_TRUE(cmdList.create(256U));
+    TEST_ASSERT_TRUE(cmdList.fillScreen(ColorDef::BLACK));
+    TEST_ASSERT_TRUE(cmdList.fillRect(1, 1, 3U, 2U, ColorDef::RED));
+    TEST_ASSERT_TRUE(cmdList.drawLine(0, 7, 15, 7, ColorDef::GREEN));
+    TEST_ASSERT_TRUE(cmdList.drawPixel(15, 0, ColorDef::WHITE));
+    TEST_ASSERT_TRUE(cmdList.blit(10, 2, 0U));
+    TEST_ASSERT_FALSE(cmdList.isOverflow());
+    TEST_ASSERT_TRUE(DrawCmd::execute(canvas, text, cmdList.get(), cmdList.getSize(), images, IMAGE_CNT));
+
+    TEST_ASSERT_TRUE(isFilled(canvas, 1, 1, 3U, 2U, ColorDef::RED));
+    TEST_ASSERT_TRUE(isFilled(canvas, 0, 7, 16U, 1U, ColorDef::GREEN));
+    TEST_ASSERT_TRUE(isFilled(canvas, 15, 0, 1U, 1U, ColorDef::WHITE));
+    TEST_ASSERT_TRUE(isFilled(canvas, 10, 2, 2U, 2U, ColorDef::BLUE));
+    TEST_ASSERT_TRUE(isFilled(canvas, 0, 0, 15U, 1U, ColorDef::BLACK));
+
+    /* A invalid command list doesn't draw anything, even if the first
+     * commands are valid.
+     */
+    cmdList.clear();
+    TEST_ASSERT_TRUE(cmdList.fillScreen(ColorDef::YELLOW));
+    TEST_ASSERT_TRUE(cmdList.blit(0, 0, IMAGE_CNT));
+    TEST_ASSERT_FALSE(DrawCmd::execute(canvas, text, cmdList.get(), cmdList.getSize(), images, IMAGE_CNT));
+    TEST_ASSERT_TRUE(isFilled(canvas, 1, 1, 3U, 2U, ColorDef::RED));
+
+    /* A missing image is skipped. */
+    cmdList.clear();
+    TEST_ASSERT_TRUE(cmdList.blit(0, 0, 1U));
+    TEST_ASSERT_TRUE(DrawCmd::execute(canvas, text, cmdList.get(), cmdList.getSize(), images, IMAGE_CNT));
+    TEST_ASSERT_TRUE(isFilled(canvas, 0, 0, 1U, 1U, ColorDef::BLACK));
+
+    /* Scroll right and down by one pixel. */
+    cmdList.clear();
+    TEST_ASSERT_TRUE(cmdList.scroll(1, 1, ColorDef::CYAN));
+    TEST_ASSERT_TRUE(DrawCmd::execute(canvas, text, cmdList.get(), cmdList.getSize(), images, IMAGE_CNT));
+    TEST_ASSERT_TRUE(isFilled(canvas, 2, 2, 3U, 2U, ColorDef::RED));
+    TEST_ASSERT_TRUE(isFilled(canvas, 11, 3, 2U, 2U, ColorDef::BLUE));
+    TEST_ASSERT_TRUE(isFilled(canvas, 0, 0, 16U, 1U, ColorDef::CYAN));
+    TEST_ASSERT_TRUE(isFilled(canvas, 0, 0, 1U, 8U, ColorDef::CYAN));
+    TEST_ASSERT_TRUE(isFilled(canvas, 1, 1, 1U, 1U, ColorDef::BLACK));
+
+    /* Scroll left and up by one pixel. */
+    cmdList.clear();
+    TEST_ASSERT_TRUE(cmdList.scroll(-1, -1, ColorDef::MAGENTA));
+    TEST_ASSERT_TRUE(DrawCmd::execute(canvas, text, cmdList.get(), cmdList.getSize(), images, IMAGE_CNT));
+    TEST_ASSERT_TRUE(isFilled(canvas, 1, 1, 3U, 2U, ColorDef::RED));
+    TEST_ASSERT_TRUE(isFilled(canvas, 10, 2, 2U, 2U, ColorDef::BLUE));
+    TEST_ASSERT_TRUE(isFilled(canvas, 15, 0, 1U, 8U, ColorDef::MAGENTA));
+    TEST_ASSERT_TRUE(isFilled(canvas, 0, 7, 16U, 1U, ColorDef::MAGENTA));
+
+    /* Text is drawn below the given position. */
+    cmdList.clear();
+    TEST_ASSERT_TRUE(cmdList.fillScreen(ColorDef::BLACK));
+    TEST_ASSERT_TRUE(cmdList.drawText(0, 2, ColorDef::WHITE, "I"));
+    TEST_ASSERT_TRUE(DrawCmd::execute(canvas, text, cmdList.get(), cmdList.getSize(), images, IMAGE_CNT));
+    TEST_ASSERT_TRUE(isFilled(canvas, 0, 0, 16U, 2U, ColorDef::BLACK));
+    TEST_ASSERT_FALSE(isFilled(canvas, 0, 2, 3U, 5U, ColorDef::BLACK));
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Check whether all pixels of a rectangle have the same color.
+ *
+ * @param[in] bitmap    Bitmap
+ * @param[in] x         Upper left x-coordinate
+ * @param[in] y         Upper left y-coordinate
+ * @param[in] width     Width in pixel
+ * @param[in] height    Height in pixel
+ * @param[in] color     Expected color
+ *
+ * @return If all pixels have the expected color, it will return true otherwise false.
+ */
+static bool isFilled(const YAGfxBitmap& bitmap, int16_t x, int16_t y, uint16_t width, uint16_t height, const Color& color)
+{
+    bool    isEqual = true;
+    int16_t xIdx    = 0;
+    int16_t yIdx    = 0;
+
+    for(yIdx = y; yIdx < (y + height); ++yIdx)
+    {
+        for(xIdx = x; xIdx < (x + width); ++xIdx)
+        {
+            if (static_cast<uint32_t>(color) != static_cast<uint32_t>(bitmap.getColor(xIdx, yIdx)))
+            {
+                isEqual = false;
+            }
+        }
+    }
+
+    return isEqual;
+}
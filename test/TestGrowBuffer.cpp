@@ -0,0 +1,331 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test grow buffer.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestGrowBuffer.h"
+
+#include <unity.h>
+#include <GrowBuffer.h>
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Buffer, which grows by the appended size only. It is the reference for the
+ * copy effort and corresponds to the former HTTP response payload handling.
+ */
+class ExactGrowBuffer
+{
+public:
+
+    /**
+     * Constructs a empty buffer.
+     */
+    ExactGrowBuffer() :
+        m_buffer(nullptr),
+        m_size(0U)
+    {
+    }
+
+    /**
+     * Destroys the buffer.
+     */
+    ~ExactGrowBuffer()
+    {
+        delete[] m_buffer;
+    }
+
+    /**
+     * Append data to the buffer.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return Number of copied bytes, caused by the reallocation.
+     */
+    size_t append(const uint8_t* data, size_t size)
+    {
+        uint8_t*    buffer      = new(std::nothrow) uint8_t[m_size + size];
+        size_t      copySize    = m_size;
+
+        if (nullptr != m_buffer)
+        {
+            memcpy(buffer, m_buffer, m_size);
+            delete[] m_buffer;
+        }
+
+        memcpy(&buffer[m_size], data, size);
+        m_buffer    = buffer;
+        m_size      += size;
+
+        return copySize;
+    }
+
+private:
+
+    uint8_t*    m_buffer;   /**< Buffer */
+    size_t      m_size;     /**< Used size in byte */
+
+    ExactGrowBuffer(const ExactGrowBuffer& buffer);
+    ExactGrowBuffer& operator=(const ExactGrowBuffer& buffer);
+};
+
+/** Segment pattern, used to compare the copy effort. */
+struct SegmentPattern
+{
+    const char* name;           /**< Pattern name */
+    size_t      segmentSize;    /**< Size of a single segment in byte */
+    size_t      totalSize;      /**< Total payload size in byte */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void compareSegmentPattern(const SegmentPattern& pattern);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Realistic segment patterns of received HTTP responses. */
+static const SegmentPattern gSegmentPatterns[] =
+{
+    { "Small JSON, MSS 1436",       1436U,  2000U   },
+    { "One Call, MSS 1436",         1436U,  40000U  },
+    { "One Call, MSS 536",          536U,   40000U  },
+    { "One Call, small segments",   128U,   40000U  }
+};
+
+/** Source data for all appends. */
+static uint8_t gSegment[1436U];
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test grow buffer.
+ */
+extern void testGrowBuffer()
+{
+    const size_t    MAX_SIZE    = 1024U;
+    GrowBuffer      growBuffer(MAX_SIZE);
+    const uint8_t   data[]      = { 1U, 2U, 3U, 4U, 5U };
+    size_t          idx         = 0U;
+
+    /* Empty buffer */
+    TEST_ASSERT_EQUAL_UINT32(0U, growBuffer.getSize());
+    TEST_ASSERT_EQUAL_UINT32(0U, growBuffer.getCapacity());
+    TEST_ASSERT_EQUAL_UINT32(MAX_SIZE, growBuffer.getMaxSize());
+    TEST_ASSERT_NULL(growBuffer.getData());
+
+    /* Invalid data */
+    TEST_ASSERT_FALSE(growBuffer.append(nullptr, 1U));
+    TEST_ASSERT_EQUAL_UINT32(0U, growBuffer.getSize());
+
+    /* First append allocates the min. capacity. */
+    TEST_ASSERT_TRUE(growBuffer.append(data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(data), growBuffer.getSize());
+    TEST_ASSERT_EQUAL_UINT32(GrowBuffer::MIN_CAPACITY, growBuffer.getCapacity());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, growBuffer.getData(), sizeof(data));
+
+    /* Fill up to the capacity, no reallocation. */
+    while(GrowBuffer::MIN_CAPACITY > growBuffer.getSize())
+    {
+        TEST_ASSERT_TRUE(growBuffer.append(&data[idx % sizeof(data)], 1U));
+        ++idx;
+    }
+    TEST_ASSERT_EQUAL_UINT32(GrowBuffer::MIN_CAPACITY, growBuffer.getCapacity());
+
+    /* Capacity is doubled and the content is kept. */
+    TEST_ASSERT_TRUE(growBuffer.append(data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT32(2U * GrowBuffer::MIN_CAPACITY, growBuffer.getCapacity());
+    TEST_ASSERT_EQUAL_UINT32(GrowBuffer::MIN_CAPACITY + sizeof(data), growBuffer.getSize());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, growBuffer.getData(), sizeof(data));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, &growBuffer.getData()[GrowBuffer::MIN_CAPACITY], sizeof(data));
+
+    /* Copy */
+    {
+        GrowBuffer copy(growBuffer);
+
+        TEST_ASSERT_EQUAL_UINT32(growBuffer.getSize(), copy.getSize());
+        TEST_ASSERT_EQUAL_UINT32(growBuffer.getMaxSize(), copy.getMaxSize());
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(growBuffer.getData(), copy.getData(), growBuffer.getSize());
+    }
+
+    /* Take over the memory without copying. */
+    {
+        GrowBuffer      other(MAX_SIZE);
+        GrowBuffer      small(GrowBuffer::MIN_CAPACITY);
+        const uint8_t*  memory  = growBuffer.getData();
+        size_t          size    = growBuffer.getSize();
+
+        TEST_ASSERT_TRUE(other.append(data, sizeof(data)));
+        TEST_ASSERT_FALSE(other.take(other));
+        TEST_ASSERT_FALSE(small.take(growBuffer));
+        TEST_ASSERT_TRUE(other.take(growBuffer));
+        TEST_ASSERT_EQUAL_PTR(memory, other.getData());
+        TEST_ASSERT_EQUAL_UINT32(size, other.getSize());
+        TEST_ASSERT_EQUAL_UINT32(0U, growBuffer.getSize());
+        TEST_ASSERT_EQUAL_UINT32(0U, growBuffer.getCapacity());
+        TEST_ASSERT_NULL(growBuffer.getData());
+
+        /* Give it back. */
+        TEST_ASSERT_TRUE(growBuffer.take(other));
+        TEST_ASSERT_EQUAL_PTR(memory, growBuffer.getData());
+        TEST_ASSERT_NULL(other.getData());
+    }
+
+    /* Capacity is limited to the max. size. */
+    while((MAX_SIZE - growBuffer.getSize()) >= sizeof(data))
+    {
+        TEST_ASSERT_TRUE(growBuffer.append(data, sizeof(data)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(MAX_SIZE, growBuffer.getCapacity());
+    TEST_ASSERT_FALSE(growBuffer.append(data, sizeof(data)));
+    TEST_ASSERT_TRUE(MAX_SIZE >= growBuffer.getSize());
+
+    /* Clear releases the memory. */
+    growBuffer.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, growBuffer.getSize());
+    TEST_ASSERT_EQUAL_UINT32(0U, growBuffer.getCapacity());
+    TEST_ASSERT_NULL(growBuffer.getData());
+
+    /* Reserve exactly, if the size is known in advance. */
+    TEST_ASSERT_FALSE(growBuffer.reserve(MAX_SIZE + 1U));
+    TEST_ASSERT_TRUE(growBuffer.reserve(300U));
+    TEST_ASSERT_EQUAL_UINT32(300U, growBuffer.getCapacity());
+    TEST_ASSERT_TRUE(growBuffer.reserve(100U));
+    TEST_ASSERT_EQUAL_UINT32(300U, growBuffer.getCapacity());
+
+    /* Compare with the buffer, which grows by the appended size only. */
+    for(idx = 0U; idx < (sizeof(gSegmentPatterns) / sizeof(gSegmentPatterns[0])); ++idx)
+    {
+        compareSegmentPattern(gSegmentPatterns[idx]);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Feed the segment pattern into a grow buffer and into a buffer, which grows
+ * by the appended size only. The number of reallocations and the copy effort
+ * are compared.
+ *
+ * @param[in] pattern   Segment pattern
+ */
+static void compareSegmentPattern(const SegmentPattern& pattern)
+{
+    GrowBuffer      growBuffer;
+    ExactGrowBuffer exactBuffer;
+    size_t          growCopies      = 0U;
+    size_t          growReallocs    = 0U;
+    size_t          exactCopies     = 0U;
+    size_t          exactReallocs   = 0U;
+    size_t          written         = 0U;
+
+    memset(gSegment, 0xA5, sizeof(gSegment));
+
+    while(pattern.totalSize > written)
+    {
+        size_t  size        = pattern.totalSize - written;
+        size_t  capacity    = growBuffer.getCapacity();
+
+        if (pattern.segmentSize < size)
+        {
+            size = pattern.segmentSize;
+        }
+
+        TEST_ASSERT_TRUE(growBuffer.append(gSegment, size));
+
+        if (capacity != growBuffer.getCapacity())
+        {
+            growCopies += written;
+            ++growReallocs;
+        }
+
+        written += size;
+    }
+
+    written = 0U;
+    while(pattern.totalSize > written)
+    {
+        size_t size = pattern.totalSize - written;
+
+        if (pattern.segmentSize < size)
+        {
+            size = pattern.segmentSize;
+        }
+
+        exactCopies += exactBuffer.append(gSegment, size);
+        ++exactReallocs;
+
+        written += size;
+    }
+
+    /* The complete payload must be available. */
+    TEST_ASSERT_EQUAL_UINT32(pattern.totalSize, growBuffer.getSize());
+
+    /* Amortized linear copy effort, independent of the segment size. */
+    TEST_ASSERT_TRUE_MESSAGE((2U * pattern.totalSize) >= growCopies, pattern.name);
+    TEST_ASSERT_TRUE_MESSAGE(exactReallocs >= growReallocs, pattern.name);
+    TEST_ASSERT_TRUE_MESSAGE(exactCopies >= growCopies, pattern.name);
+}
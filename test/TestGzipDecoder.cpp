@@ -0,0 +1,359 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test gzip decoder.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestGzipDecoder.h"
+
+#include <unity.h>
+#include <GzipDecoder.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool decodeInSegments(GzipDecoder& decoder, const uint8_t* data, size_t size, size_t segmentSize);
+static void assertOutput(const uint8_t* expected, size_t size);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** JSON text, which is compressed in gGzipDynamic. */
+static const char*      gJson       =
+    "{\"current\":{\"temp\":12.5,\"humidity\":80,\"weather\":[{\"id\":500,\"main\":\"Rain\",\"icon\":\"10d\"}]},"
+    "\"hourly\":[{\"temp\":12.1,\"humidity\":81},{\"temp\":12.4,\"humidity\":79},{\"temp\":13.0,\"humidity\":75},"
+    "{\"temp\":13.6,\"humidity\":71},{\"temp\":14.2,\"humidity\":68}],\"timezone\":\"Europe/Berlin\"}";
+
+/** "Hello World!" with fixed Huffman codes */
+static const uint8_t gGzipFixed[] =
+{
+    0x1FU, 0x8BU, 0x08U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x02U, 0x03U, 0xF3U, 0x48U,
+    0xCDU, 0xC9U, 0xC9U, 0x57U, 0x08U, 0xCFU, 0x2FU, 0xCAU, 0x49U, 0x51U, 0x04U, 0x00U,
+    0xA3U, 0x1CU, 0x29U, 0x1CU, 0x0CU, 0x00U, 0x00U, 0x00U
+};
+
+/** JSON text with dynamic Huffman codes and original file name in the header */
+static const uint8_t gGzipDynamic[] =
+{
+    0x1FU, 0x8BU, 0x08U, 0x08U, 0x00U, 0x00U, 0x00U, 0x00U, 0x02U, 0x03U, 0x64U, 0x61U,
+    0x74U, 0x61U, 0x2EU, 0x6AU, 0x73U, 0x6FU, 0x6EU, 0x00U, 0x55U, 0xCFU, 0xC1U, 0x0AU,
+    0x83U, 0x30U, 0x0CU, 0x06U, 0xE0U, 0x77U, 0xF9U, 0xCFU, 0xC5U, 0xB5U, 0x4EU, 0x9DU,
+    0xEBU, 0x51U, 0xD8U, 0x0BU, 0xECU, 0x3AU, 0x3CU, 0x88U, 0x06U, 0x2CU, 0x58U, 0x2BU,
+    0xA5U, 0x65U, 0x38U, 0xE9U, 0xBBU, 0xAFU, 0xEEU, 0x30U, 0xDAU, 0x53U, 0x48U, 0x3EU,
+    0xF2U, 0x93U, 0x1CU, 0x18U, 0xBDU, 0xB5U, 0xB4U, 0x3AU, 0xC8U, 0x03U, 0x8EU, 0xF4U,
+    0x06U, 0x29U, 0xCAU, 0xA2U, 0x66U, 0x98U, 0xBDU, 0x56U, 0x93U, 0x72U, 0x3BU, 0x64U,
+    0xCBU, 0x19U, 0xDEU, 0x34U, 0xB8U, 0x99U, 0x2CU, 0xE4U, 0xEBU, 0x80U, 0x9AU, 0x20U,
+    0x6BU, 0x1EU, 0x87U, 0x7AU, 0x50U, 0x2BU, 0x24U, 0x9EU, 0x67U, 0x61U, 0x50U, 0xA3U,
+    0x39U, 0x3BU, 0xC1U, 0x27U, 0x84U, 0x3EU, 0xC4U, 0x00U, 0xE3U, 0xEDU, 0xB2U, 0xFFU,
+    0x36U, 0xFEU, 0xB9U, 0x22U, 0xCBU, 0x15U, 0x81U, 0x25U, 0x56U, 0xA5U, 0x76U, 0xBBU,
+    0x27U, 0x76U, 0x2DU, 0x78U, 0x66U, 0x75U, 0x66U, 0x4DU, 0x66U, 0x69U, 0x66U, 0x55U,
+    0x94U, 0xA9U, 0x35U, 0x6DU, 0xE8U, 0x19U, 0x9CU, 0xD2U, 0xF4U, 0x31U, 0x2BU, 0xC5U,
+    0x53U, 0x1FU, 0xDEU, 0x9AU, 0x8DU, 0x2EU, 0x1DU, 0xD9U, 0x25U, 0x7EU, 0x10U, 0xBEU,
+    0x26U, 0x6FU, 0x0DU, 0x12U, 0x0BU, 0x01U, 0x00U, 0x00U
+};
+
+/** "Hello World!" in a stored block */
+static const uint8_t gGzipStored[] =
+{
+    0x1FU, 0x8BU, 0x08U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x02U, 0x03U, 0x01U, 0x0CU,
+    0x00U, 0xF3U, 0xFFU, 0x48U, 0x65U, 0x6CU, 0x6CU, 0x6FU, 0x20U, 0x57U, 0x6FU, 0x72U,
+    0x6CU, 0x64U, 0x21U, 0xA3U, 0x1CU, 0x29U, 0x1CU, 0x0CU, 0x00U, 0x00U, 0x00U
+};
+
+/** 300 pseudo random bytes, repeated once with a distance of 300 byte */
+static const uint8_t gGzipFar[] =
+{
+    0x1FU, 0x8BU, 0x08U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x02U, 0x03U, 0x3BU, 0x56U,
+    0xD7U, 0x98U, 0xEDU, 0xFDU, 0xFBU, 0xD1U, 0xEFU, 0x90U, 0x6FU, 0x7BU, 0xEFU, 0xD7U,
+    0xC8U, 0x3CU, 0x6CU, 0x67U, 0xDCU, 0x6FU, 0x78U, 0x2FU, 0xACU, 0x88U, 0xDFU, 0x3DU,
+    0x3DU, 0xADU, 0x3DU, 0x72U, 0x55U, 0x87U, 0x4DU, 0xE4U, 0xABU, 0x30U, 0xE1U, 0xEAU,
+    0x4BU, 0xADU, 0x0BU, 0x6FU, 0xD8U, 0x84U, 0x84U, 0xEAU, 0x9BU, 0xAFU, 0x4BU, 0x8DU,
+    0xBEU, 0xC5U, 0x54U, 0x39U, 0xE3U, 0xCCU, 0x63U, 0xA9U, 0xB2U, 0xBEU, 0xF8U, 0x9BU,
+    0x33U, 0xFBU, 0xE5U, 0xEDU, 0xCDU, 0xDEU, 0x39U, 0x57U, 0xF8U, 0xF2U, 0xFEU, 0xDAU,
+    0xB7U, 0xECU, 0xD6U, 0x93U, 0xB6U, 0xBEU, 0x3BU, 0x9AU, 0xB9U, 0x7EU, 0xFFU, 0xC3U,
+    0x1EU, 0x16U, 0x28U, 0xFCU, 0xEEU, 0xDFU, 0x18U, 0xC1U, 0x3AU, 0xE1U, 0x28U, 0xE7U,
+    0x9DU, 0xE0U, 0xB3U, 0xABU, 0xACU, 0x3DU, 0x66U, 0x06U, 0x5DU, 0x0EU, 0x9AU, 0xCBU,
+    0x36U, 0xFFU, 0xD5U, 0xD6U, 0x43U, 0x6CU, 0xC2U, 0x33U, 0x3CU, 0x37U, 0x31U, 0xCAU,
+    0xADU, 0x31U, 0xEAU, 0x30U, 0x9CU, 0x13U, 0xE4U, 0x36U, 0xB5U, 0xD0U, 0xACU, 0x3FU,
+    0xFCU, 0x9BU, 0xA5U, 0xACU, 0xD8U, 0xAFU, 0x8EU, 0x92U, 0xAFU, 0x33U, 0x6AU, 0xC4U,
+    0x63U, 0x1CU, 0x77U, 0xE7U, 0x16U, 0xF6U, 0xF1U, 0x17U, 0x44U, 0x1EU, 0x67U, 0x94U,
+    0xD6U, 0x37U, 0xB6U, 0x9DU, 0x78U, 0x40U, 0x76U, 0x29U, 0x2FU, 0xEFU, 0x6AU, 0xE3U,
+    0xDEU, 0xBAU, 0xB8U, 0x7EU, 0xBBU, 0x67U, 0x19U, 0x25U, 0xCBU, 0xACU, 0x36U, 0x1EU,
+    0x9EU, 0x2CU, 0xB8U, 0x22U, 0xE5U, 0xF8U, 0xEDU, 0x53U, 0x0FU, 0x12U, 0x1EU, 0x7EU,
+    0xDEU, 0xCFU, 0xC9U, 0x90U, 0xBEU, 0xE8U, 0xB1U, 0xEAU, 0x02U, 0x45U, 0xC3U, 0xF6U,
+    0xABU, 0x49U, 0x47U, 0x57U, 0xF8U, 0xD7U, 0xE9U, 0x71U, 0x66U, 0x4FU, 0x99U, 0xBFU,
+    0x21U, 0x77U, 0xE5U, 0xBCU, 0x28U, 0x6EU, 0xB7U, 0x82U, 0x86U, 0x6DU, 0xE7U, 0xDDU,
+    0x79U, 0x96U, 0x2DU, 0xD5U, 0xBAU, 0xB1U, 0xE6U, 0xF7U, 0x82U, 0xD7U, 0xDBU, 0x2BU,
+    0x55U, 0x8AU, 0x94U, 0x27U, 0x79U, 0x34U, 0x1CU, 0x5DU, 0xB6U, 0xBCU, 0x75U, 0xFBU,
+    0xF5U, 0x9EU, 0x09U, 0x4FU, 0x56U, 0x27U, 0xBBU, 0x04U, 0xA5U, 0x3DU, 0x9EU, 0x63U,
+    0xACU, 0xFAU, 0x33U, 0x6EU, 0xD5U, 0xAEU, 0xE2U, 0x84U, 0x58U, 0xEFU, 0xC2U, 0xBAU,
+    0x7DU, 0x2BU, 0x7BU, 0xC2U, 0x25U, 0x0BU, 0x0FU, 0x9FU, 0x8AU, 0x7BU, 0xAAU, 0x65U,
+    0xBCU, 0xA6U, 0x23U, 0x30U, 0x6DU, 0x61U, 0x75U, 0x69U, 0x7AU, 0xCAU, 0xACU, 0xCCU,
+    0xF7U, 0xF9U, 0x61U, 0x4EU, 0x0BU, 0x64U, 0x03U, 0x8FU, 0x32U, 0x7DU, 0xDFU, 0x3DU,
+    0xC9U, 0xF5U, 0xD8U, 0x68U, 0x58U, 0x11U, 0x1DU, 0x56U, 0x00U, 0x3FU, 0x23U, 0x1DU,
+    0x03U, 0x58U, 0x02U, 0x00U, 0x00U
+};
+
+/** Buffer for the decoded data. */
+static uint8_t          gOutput[1024U];
+
+/** Size of the decoded data in byte. */
+static size_t           gOutputSize = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test gzip decoder.
+ */
+extern void testGzipDecoder()
+{
+    const char*     HELLO_WORLD = "Hello World!";
+    const size_t    FAR_SIZE    = 300U;
+    uint8_t         farData[2U * FAR_SIZE];
+    uint32_t        random      = 1U;
+    size_t          segmentSize = 0U;
+    size_t          idx         = 0U;
+    uint8_t         corrupted[sizeof(gGzipFixed)];
+
+    /* Same pseudo random bytes as in the test vector. */
+    for(idx = 0U; idx < FAR_SIZE; ++idx)
+    {
+        random = random * 1103515245U + 12345U;
+        farData[idx] = static_cast<uint8_t>(random >> 16U);
+        farData[FAR_SIZE + idx] = farData[idx];
+    }
+
+    /* The result must be independent of the segmentation. */
+    for(segmentSize = 1U; segmentSize <= sizeof(gGzipFar); segmentSize *= 3U)
+    {
+        GzipDecoder decoder;
+
+        TEST_ASSERT_TRUE(decodeInSegments(decoder, gGzipFixed, sizeof(gGzipFixed), segmentSize));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+        assertOutput(reinterpret_cast<const uint8_t*>(HELLO_WORLD), strlen(HELLO_WORLD));
+
+        /* Reset for the next stream. */
+        decoder.reset();
+        TEST_ASSERT_FALSE(decoder.isComplete());
+        TEST_ASSERT_TRUE(decodeInSegments(decoder, gGzipDynamic, sizeof(gGzipDynamic), segmentSize));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+        assertOutput(reinterpret_cast<const uint8_t*>(gJson), strlen(gJson));
+
+        decoder.reset();
+        TEST_ASSERT_TRUE(decodeInSegments(decoder, gGzipStored, sizeof(gGzipStored), segmentSize));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+        assertOutput(reinterpret_cast<const uint8_t*>(HELLO_WORLD), strlen(HELLO_WORLD));
+
+        decoder.reset();
+        TEST_ASSERT_TRUE(decodeInSegments(decoder, gGzipFar, sizeof(gGzipFar), segmentSize));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+        assertOutput(farData, sizeof(farData));
+    }
+
+    /* A window smaller than the distance can't decode the stream. */
+    {
+        GzipDecoder decoder(256U);
+
+        TEST_ASSERT_EQUAL(256U, decoder.getWindowSize());
+        TEST_ASSERT_FALSE(decodeInSegments(decoder, gGzipFar, sizeof(gGzipFar), sizeof(gGzipFar)));
+        TEST_ASSERT_TRUE(decoder.isError());
+
+        /* Error is kept until reset. */
+        TEST_ASSERT_FALSE(decodeInSegments(decoder, gGzipFixed, sizeof(gGzipFixed), sizeof(gGzipFixed)));
+        decoder.reset();
+        TEST_ASSERT_TRUE(decodeInSegments(decoder, gGzipFixed, sizeof(gGzipFixed), sizeof(gGzipFixed)));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+    }
+
+    /* A window, which wraps around, but is large enough. */
+    {
+        GzipDecoder decoder(512U);
+
+        TEST_ASSERT_TRUE(decodeInSegments(decoder, gGzipFar, sizeof(gGzipFar), 7U));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+        assertOutput(farData, sizeof(farData));
+    }
+
+    /* Invalid window size falls back to the max. window size. */
+    {
+        GzipDecoder decoder(1000U);
+
+        TEST_ASSERT_EQUAL(GzipDecoder::MAX_WINDOW_SIZE, decoder.getWindowSize());
+    }
+
+    /* Incomplete stream */
+    {
+        GzipDecoder decoder;
+
+        TEST_ASSERT_TRUE(decodeInSegments(decoder, gGzipDynamic, sizeof(gGzipDynamic) - 1U, 16U));
+        TEST_ASSERT_FALSE(decoder.isComplete());
+        TEST_ASSERT_FALSE(decoder.isError());
+
+        /* The remaining byte completes it, data after the stream is ignored. */
+        TEST_ASSERT_TRUE(decoder.decode(&gGzipDynamic[sizeof(gGzipDynamic) - 1U], 1U, nullptr));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+        TEST_ASSERT_TRUE(decoder.decode(gGzipFixed, sizeof(gGzipFixed), nullptr));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+    }
+
+    /* Invalid magic number */
+    {
+        GzipDecoder decoder;
+
+        memcpy(corrupted, gGzipFixed, sizeof(gGzipFixed));
+        corrupted[1U] = 0x8CU;
+
+        TEST_ASSERT_FALSE(decodeInSegments(decoder, corrupted, sizeof(corrupted), sizeof(corrupted)));
+        TEST_ASSERT_TRUE(decoder.isError());
+    }
+
+    /* CRC32 mismatch */
+    {
+        GzipDecoder decoder;
+
+        memcpy(corrupted, gGzipFixed, sizeof(gGzipFixed));
+        corrupted[sizeof(corrupted) - 8U] ^= 0x01U;
+
+        TEST_ASSERT_FALSE(decodeInSegments(decoder, corrupted, sizeof(corrupted), sizeof(corrupted)));
+        TEST_ASSERT_TRUE(decoder.isError());
+    }
+
+    /* Size mismatch */
+    {
+        GzipDecoder decoder;
+
+        memcpy(corrupted, gGzipFixed, sizeof(gGzipFixed));
+        corrupted[sizeof(corrupted) - 4U] ^= 0x01U;
+
+        TEST_ASSERT_FALSE(decodeInSegments(decoder, corrupted, sizeof(corrupted), sizeof(corrupted)));
+        TEST_ASSERT_TRUE(decoder.isError());
+    }
+
+    /* Release the window, the decoder can be used afterwards again. */
+    {
+        GzipDecoder decoder;
+
+        decoder.release();
+        TEST_ASSERT_TRUE(decodeInSegments(decoder, gGzipStored, sizeof(gGzipStored), sizeof(gGzipStored)));
+        TEST_ASSERT_TRUE(decoder.isComplete());
+        decoder.release();
+        TEST_ASSERT_FALSE(decoder.isComplete());
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Decode a gzip stream, which is split into segments.
+ *
+ * @param[in] decoder       The gzip decoder.
+ * @param[in] data          gzip stream
+ * @param[in] size          gzip stream size in byte
+ * @param[in] segmentSize   Segment size in byte
+ *
+ * @return If all segments are successful decoded, it will return true otherwise false.
+ */
+static bool decodeInSegments(GzipDecoder& decoder, const uint8_t* data, size_t size, size_t segmentSize)
+{
+    bool    isSuccessful    = true;
+    size_t  index           = 0U;
+
+    gOutputSize = 0U;
+
+    while((true == isSuccessful) && (size > index))
+    {
+        size_t partSize = size - index;
+
+        if (segmentSize < partSize)
+        {
+            partSize = segmentSize;
+        }
+
+        isSuccessful = decoder.decode(&data[index], partSize,
+            [](const uint8_t* part, size_t partLen)
+            {
+                TEST_ASSERT_LESS_OR_EQUAL(sizeof(gOutput), gOutputSize + partLen);
+
+                memcpy(&gOutput[gOutputSize], part, partLen);
+                gOutputSize += partLen;
+            }
+        );
+
+        index += partSize;
+    }
+
+    return isSuccessful;
+}
+
+/**
+ * Verify the decoded data.
+ *
+ * @param[in] expected  Expected data
+ * @param[in] size      Expected data size in byte
+ */
+static void assertOutput(const uint8_t* expected, size_t size)
+{
+    TEST_ASSERT_EQUAL(size, gOutputSize);
+    TEST_ASSERT_EQUAL_MEMORY(expected, gOutput, size);
+}
@@ -0,0 +1,151 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test histogram.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestHistogram.h"
+
+#include <unity.h>
+#include <Histogram.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test histogram.
+ */
+extern void testHistogram()
+{
+    Histogram<uint32_t, 0U, 2U, 10U>    histogram;
+    uint32_t                            idx         = 0U;
+
+    /* No value available yet. */
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getMin());
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getAvg());
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getPercentile(50U));
+    TEST_ASSERT_EQUAL_UINT32(10U, histogram.getBucketCnt());
+    TEST_ASSERT_EQUAL_UINT32(2U, histogram.getBucketWidth());
+
+    /* Count values 0 - 9, two values per bucket. */
+    for(idx = 0U; idx < 10U; ++idx)
+    {
+        histogram.update(idx);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(10U, histogram.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getMin());
+    TEST_ASSERT_EQUAL_UINT32(9U, histogram.getMax());
+    TEST_ASSERT_EQUAL_UINT32(4U, histogram.getAvg());
+    TEST_ASSERT_EQUAL_UINT32(2U, histogram.getBucket(0U));
+    TEST_ASSERT_EQUAL_UINT32(2U, histogram.getBucket(4U));
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getBucket(5U));
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getBucket(10U));
+
+    /* Percentile is the upper bound of the bucket. */
+    TEST_ASSERT_EQUAL_UINT32(1U, histogram.getPercentile(0U));
+    TEST_ASSERT_EQUAL_UINT32(5U, histogram.getPercentile(50U));
+    TEST_ASSERT_EQUAL_UINT32(9U, histogram.getPercentile(99U));
+
+    /* Values out of range are counted in the last bucket. */
+    histogram.update(100U);
+    TEST_ASSERT_EQUAL_UINT32(1U, histogram.getBucket(9U));
+    TEST_ASSERT_EQUAL_UINT32(100U, histogram.getMax());
+    TEST_ASSERT_EQUAL_UINT32(100U, histogram.getPercentile(100U));
+
+    /* Reset to initial state. */
+    histogram.reset();
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getBucket(0U));
+    TEST_ASSERT_EQUAL_UINT32(0U, histogram.getPercentile(99U));
+
+    /* Outliers above the range must not be hidden by the percentiles. */
+    for(idx = 0U; idx < 95U; ++idx)
+    {
+        histogram.update(2U);
+    }
+
+    for(idx = 0U; idx < 5U; ++idx)
+    {
+        histogram.update(30U + idx * 10U);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(5U, histogram.getBucket(9U));
+    TEST_ASSERT_EQUAL_UINT32(3U, histogram.getPercentile(95U));
+    TEST_ASSERT_EQUAL_UINT32(70U, histogram.getPercentile(96U));
+    TEST_ASSERT_EQUAL_UINT32(70U, histogram.getPercentile(99U));
+
+    /* A value in the last bucket, but within the range. */
+    histogram.reset();
+    histogram.update(18U);
+    TEST_ASSERT_EQUAL_UINT32(18U, histogram.getPercentile(99U));
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,714 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test HTTP response parser.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestHttpResponseParser.h"
+
+#include <unity.h>
+#include <HttpResponseParser.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Canned response with the expected parser transcript.
+ */
+typedef struct
+{
+    const char* response;   /**< Response as received */
+    bool        isFinished; /**< Is the connection closed after the response? */
+    const char* transcript; /**< Expected transcript */
+
+} CannedResponse;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void initParser(HttpResponseParser& parser);
+static bool feed(HttpResponseParser& parser, const char* data, size_t size);
+static void finish(HttpResponseParser& parser, bool isError, const CannedResponse& canned);
+static void parseSplit(HttpResponseParser& parser, const CannedResponse& canned, size_t splitPos);
+static void parseByteByByte(HttpResponseParser& parser, const CannedResponse& canned);
+static void append(const char* format, ...);
+static void appendSpan(const HttpResponseParser::Span& span);
+static uint32_t nextRandom();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Canned responses */
+static const CannedResponse gCannedResponses[] =
+{
+    /* Content length and a requested header */
+    {
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/json\r\n"
+        "ETag: \"33a64df5\"\r\n"
+        "Content-Length: 13\r\n"
+        "\r\n"
+        "{\"a\":\"hello\"}",
+        false,
+        "header ETag=\"33a64df5\"\n"
+        "status 200 OK keep-alive length 13\n"
+        "body {\"a\":\"hello\"}\n"
+        "complete\n"
+    },
+    /* Chunked with chunk extension and trailer, connection closed by the server */
+    {
+        "HTTP/1.1 200 OK\r\n"
+        "transfer-encoding: Chunked\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+        "5;name=value\r\n"
+        "Hello\r\n"
+        "07\r\n"
+        " World!\r\n"
+        "0\r\n"
+        "X-Trailer: 1\r\n"
+        "\r\n",
+        false,
+        "status 200 OK chunked\n"
+        "body Hello World!\n"
+        "complete\n"
+    },
+    /* Not modified, followed by the next response on the same connection */
+    {
+        "HTTP/1.1 304 Not Modified\r\n"
+        "ETag:\"33a64df5\"\r\n"
+        "Last-Modified:   Wed, 21 Oct 2015 07:28:00 GMT  \r\n"
+        "\r\n"
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 2\r\n"
+        "\r\n"
+        "ok",
+        false,
+        "header ETag=\"33a64df5\"\n"
+        "header Last-Modified=Wed, 21 Oct 2015 07:28:00 GMT\n"
+        "status 304 Not Modified keep-alive\n"
+        "complete\n"
+        "status 200 OK keep-alive length 2\n"
+        "body ok\n"
+        "complete\n"
+    },
+    /* Body delimited by the connection close, gzip encoded */
+    {
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Encoding: gzip\r\n"
+        "\r\n"
+        "compressed",
+        true,
+        "status 200 OK gzip\n"
+        "body compressed\n"
+        "complete\n"
+    },
+    /* HTTP/1.0 with keep-alive, no reason phrase and empty values */
+    {
+        "HTTP/1.0 204\r\n"
+        "Connection: Keep-Alive\r\n"
+        "etag:\r\n"
+        "X-Empty: \r\n"
+        "\r\n",
+        false,
+        "header etag=\n"
+        "status 204  keep-alive\n"
+        "complete\n"
+    },
+    /* HTTP/1.0 closes the connection by default, even with a content length. */
+    {
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Length: 2\r\n"
+        "\r\n"
+        "ok",
+        false,
+        "status 200 OK length 2\n"
+        "body ok\n"
+        "complete\n"
+    },
+    /* Too long header values are not reported. */
+    {
+        "HTTP/1.1 200 OK\r\n"
+        "ETag: \"0123456789012345678901234567890123456789012345678901234567890123456789"
+        "0123456789012345678901234567890123456789012345678901234567890123456789"
+        "0123456789012345678901234567890123456789012345678901234567890123456789"
+        "0123456789012345678901234567890123456789012345678901234567890123456789\"\r\n"
+        "X-A-Very-Long-Header-Name-Which-Is-Truncated: 1\r\n"
+        "Content-Length: 0\r\n"
+        "\r\n",
+        false,
+        "status 200 OK keep-alive\n"
+        "complete\n"
+    },
+    /* Unsupported transfer coding */
+    {
+        "HTTP/1.1 200 OK\r\n"
+        "Transfer-Encoding: gzip, chunked\r\n"
+        "\r\n",
+        false,
+        "error\n"
+    },
+    /* Invalid chunk size */
+    {
+        "HTTP/1.1 200 OK\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "x\r\n",
+        false,
+        "status 200 OK keep-alive chunked\n"
+        "error\n"
+    },
+    /* Invalid content length */
+    {
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 1a\r\n"
+        "\r\n",
+        false,
+        "error\n"
+    },
+    /* Unsupported HTTP version */
+    {
+        "HTTP/2 200 OK\r\n"
+        "\r\n",
+        false,
+        "error\n"
+    }
+};
+
+/** Transcript of the parser events */
+static char     gTranscript[1024];
+
+/** Current transcript length */
+static size_t   gTranscriptLen  = 0U;
+
+/** Body parts of the current response */
+static char     gBody[64];
+
+/** Current body length */
+static size_t   gBodyLen        = 0U;
+
+/** Pseudo random number generator state */
+static uint32_t gRandom         = 1U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test HTTP response parser.
+ */
+extern void testHttpResponseParser()
+{
+    HttpResponseParser  parser;
+    size_t              idx         = 0U;
+    size_t              splitPos    = 0U;
+
+    /* Not more than the max. number of headers can be requested. */
+    {
+        HttpResponseParser filterParser;
+
+        for(idx = 0U; idx < HttpResponseParser::MAX_HEADER_FILTERS; ++idx)
+        {
+            TEST_ASSERT_TRUE(filterParser.addHeaderFilter("X-Filter"));
+        }
+        TEST_ASSERT_FALSE(filterParser.addHeaderFilter("X-Filter"));
+    }
+
+    /* Header names longer than the max. name size can't be requested. */
+    TEST_ASSERT_FALSE(parser.addHeaderFilter("X-A-Very-Long-Header-Name-Which-Is-Truncated"));
+
+    TEST_ASSERT_TRUE(parser.addHeaderFilter("ETag"));
+    TEST_ASSERT_TRUE(parser.addHeaderFilter("Last-Modified"));
+
+    /* Every canned response, split at every byte boundary and byte by byte,
+     * must result in the same transcript.
+     */
+    for(idx = 0U; idx < (sizeof(gCannedResponses) / sizeof(gCannedResponses[0])); ++idx)
+    {
+        const CannedResponse&   canned  = gCannedResponses[idx];
+        size_t                  size    = strlen(canned.response);
+
+        for(splitPos = 0U; splitPos <= size; ++splitPos)
+        {
+            parseSplit(parser, canned, splitPos);
+            TEST_ASSERT_EQUAL_STRING(canned.transcript, gTranscript);
+        }
+
+        parseByteByByte(parser, canned);
+        TEST_ASSERT_EQUAL_STRING(canned.transcript, gTranscript);
+    }
+
+    /* Header values and body parts inside a segment are not copied. */
+    {
+        const char*                 response    = gCannedResponses[0].response;
+        size_t                      size        = strlen(response);
+        size_t                      index       = 0U;
+        HttpResponseParser::Event   event       = HttpResponseParser::EVENT_NONE;
+        const uint8_t*              data        = reinterpret_cast<const uint8_t*>(response);
+
+        initParser(parser);
+
+        event = parser.parse(data, size, index);
+        TEST_ASSERT_EQUAL(HttpResponseParser::EVENT_HEADER, event);
+        TEST_ASSERT_EQUAL_PTR(strstr(response, "\"33a64df5\""), parser.getHeaderValue().data);
+
+        event = parser.parse(data, size, index);
+        TEST_ASSERT_EQUAL(HttpResponseParser::EVENT_HEADERS_COMPLETE, event);
+        TEST_ASSERT_EQUAL_UINT16(200U, parser.getStatusCode());
+        TEST_ASSERT_EQUAL_UINT8(1U, parser.getMinorVersion());
+        TEST_ASSERT_EQUAL(13U, parser.getContentLength());
+
+        event = parser.parse(data, size, index);
+        TEST_ASSERT_EQUAL(HttpResponseParser::EVENT_BODY, event);
+        TEST_ASSERT_EQUAL_PTR(strstr(response, "{"), parser.getBody().data);
+        TEST_ASSERT_EQUAL(13U, parser.getBody().size);
+
+        event = parser.parse(data, size, index);
+        TEST_ASSERT_EQUAL(HttpResponseParser::EVENT_COMPLETE, event);
+        TEST_ASSERT_EQUAL(size, index);
+        TEST_ASSERT_TRUE(parser.isKeepAlive());
+
+        /* Nothing more to parse */
+        event = parser.parse(data, size, index);
+        TEST_ASSERT_EQUAL(HttpResponseParser::EVENT_NONE, event);
+    }
+
+    /* A body delimited by the connection close is incomplete, until the connection is closed. */
+    {
+        const char* response = "HTTP/1.1 200 OK\r\n\r\nabc";
+
+        initParser(parser);
+        TEST_ASSERT_FALSE(feed(parser, response, strlen(response)));
+        TEST_ASSERT_EQUAL_STRING("status 200 OK\n", gTranscript);
+        TEST_ASSERT_EQUAL(3U, gBodyLen);
+        TEST_ASSERT_FALSE(parser.isKeepAlive());
+        TEST_ASSERT_TRUE(parser.finish());
+        TEST_ASSERT_FALSE(parser.finish());
+    }
+
+    /* Mutated responses, fed in random segments, must never lead to an
+     * out of bounds access or an endless loop. The rounds cover every
+     * canned response several times with each kind of mutation.
+     */
+    {
+        char    mutated[512];
+        size_t  round   = 0U;
+
+        for(round = 0U; round < 500U; ++round)
+        {
+            const CannedResponse&   canned      = gCannedResponses[nextRandom() % (sizeof(gCannedResponses) / sizeof(gCannedResponses[0]))];
+            size_t                  size        = strlen(canned.response);
+            uint32_t                mutations   = 1U + (nextRandom() % 4U);
+            size_t                  offset      = 0U;
+            size_t                  bodySize    = 0U;
+            bool                    isError     = false;
+
+            memcpy(mutated, canned.response, size);
+
+            while (0U < mutations)
+            {
+                size_t pos = nextRandom() % size;
+
+                switch(nextRandom() % 3U)
+                {
+                case 0U:
+                    /* Replace a byte with a random one. */
+                    mutated[pos] = static_cast<char>(nextRandom());
+                    break;
+
+                case 1U:
+                    /* Replace a byte with a HTTP delimiter. */
+                    mutated[pos] = ":\r\n 0;"[nextRandom() % 6U];
+                    break;
+
+                default:
+                    /* Truncate the response. */
+                    size = pos + 1U;
+                    break;
+                }
+
+                --mutations;
+            }
+
+            initParser(parser);
+
+            while ((size > offset) &&
+                   (false == isError))
+            {
+                size_t                      segmentSize = 1U + (nextRandom() % 16U);
+                size_t                      index       = 0U;
+                size_t                      loops       = 0U;
+                HttpResponseParser::Event   event       = HttpResponseParser::EVENT_NONE;
+
+                if ((size - offset) < segmentSize)
+                {
+                    segmentSize = size - offset;
+                }
+
+                do
+                {
+                    event = parser.parse(reinterpret_cast<const uint8_t*>(&mutated[offset]), segmentSize, index);
+
+                    TEST_ASSERT_LESS_OR_EQUAL(segmentSize, index);
+
+                    if (HttpResponseParser::EVENT_HEADER == event)
+                    {
+                        TEST_ASSERT_LESS_OR_EQUAL(HttpResponseParser::NAME_SIZE_MAX, parser.getHeaderName().size);
+                        TEST_ASSERT_LESS_OR_EQUAL(HttpResponseParser::VALUE_SIZE_MAX, parser.getHeaderValue().size);
+                    }
+                    else if (HttpResponseParser::EVENT_BODY == event)
+                    {
+                        bodySize += parser.getBody().size;
+                    }
+
+                    /* Every event consumes data or leads to a state change. */
+                    ++loops;
+                    TEST_ASSERT_LESS_OR_EQUAL(2U * segmentSize + 4U, loops);
+                }
+                while ((HttpResponseParser::EVENT_NONE != event) &&
+                       (HttpResponseParser::EVENT_ERROR != event));
+
+                offset += segmentSize;
+                isError = (HttpResponseParser::EVENT_ERROR == event);
+            }
+
+            TEST_ASSERT_LESS_OR_EQUAL(size, bodySize);
+        }
+    }
+
+    /* Back-to-back responses on a kept connection, fed in segments of
+     * every size up to 16 byte without a parser reset in between.
+     */
+    {
+        const CannedResponse&   canned          = gCannedResponses[2];
+        size_t                  size            = strlen(canned.response);
+        const uint8_t*          data            = reinterpret_cast<const uint8_t*>(canned.response);
+        size_t                  segmentSize     = 0U;
+        uint32_t                completed       = 0U;
+        uint32_t                notModified     = 0U;
+        size_t                  bodySize        = 0U;
+        size_t                  parsedSize      = 0U;
+
+        initParser(parser);
+
+        for(segmentSize = 1U; segmentSize <= 16U; ++segmentSize)
+        {
+            size_t offset = 0U;
+
+            while (size > offset)
+            {
+                size_t                      length  = ((size - offset) < segmentSize) ? (size - offset) : segmentSize;
+                size_t                      index   = 0U;
+                HttpResponseParser::Event   event   = HttpResponseParser::EVENT_NONE;
+
+                do
+                {
+                    event = parser.parse(&data[offset], length, index);
+
+                    TEST_ASSERT_NOT_EQUAL(HttpResponseParser::EVENT_ERROR, event);
+
+                    if (HttpResponseParser::EVENT_HEADERS_COMPLETE == event)
+                    {
+                        if (304U == parser.getStatusCode())
+                        {
+                            ++notModified;
+                        }
+                    }
+                    else if (HttpResponseParser::EVENT_BODY == event)
+                    {
+                        bodySize += parser.getBody().size;
+                    }
+                    else if (HttpResponseParser::EVENT_COMPLETE == event)
+                    {
+                        ++completed;
+                    }
+                }
+                while (HttpResponseParser::EVENT_NONE != event);
+
+                TEST_ASSERT_EQUAL(length, index);
+
+                parsedSize  += index;
+                offset      += length;
+            }
+        }
+
+        TEST_ASSERT_EQUAL_UINT32(2U * 16U, completed);
+        TEST_ASSERT_EQUAL_UINT32(16U, notModified);
+        TEST_ASSERT_EQUAL(2U * 16U, bodySize);
+        TEST_ASSERT_EQUAL(size * 16U, parsedSize);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Reset the parser and the transcript for the next response.
+ *
+ * @param[in] parser    HTTP response parser
+ */
+static void initParser(HttpResponseParser& parser)
+{
+    parser.reset();
+
+    gTranscript[0]  = '\0';
+    gTranscriptLen  = 0U;
+    gBodyLen        = 0U;
+}
+
+/**
+ * Feed a segment to the parser and record the events in the transcript.
+ *
+ * @param[in] parser    HTTP response parser
+ * @param[in] data      Segment data
+ * @param[in] size      Segment size in byte
+ *
+ * @return If a parse error happened, it will return true otherwise false.
+ */
+static bool feed(HttpResponseParser& parser, const char* data, size_t size)
+{
+    size_t                      index   = 0U;
+    HttpResponseParser::Event   event   = HttpResponseParser::EVENT_NONE;
+
+    do
+    {
+        event = parser.parse(reinterpret_cast<const uint8_t*>(data), size, index);
+
+        switch(event)
+        {
+        case HttpResponseParser::EVENT_HEADER:
+            append("header ");
+            appendSpan(parser.getHeaderName());
+            append("=");
+            appendSpan(parser.getHeaderValue());
+            append("\n");
+            break;
+
+        case HttpResponseParser::EVENT_HEADERS_COMPLETE:
+            append("status %u %s", parser.getStatusCode(), parser.getReasonPhrase());
+
+            if (true == parser.isKeepAlive())
+            {
+                append(" keep-alive");
+            }
+
+            if (true == parser.isChunked())
+            {
+                append(" chunked");
+            }
+
+            if (0U < parser.getContentLength())
+            {
+                append(" length %u", static_cast<uint32_t>(parser.getContentLength()));
+            }
+
+            if (HttpResponseParser::CONTENT_CODING_GZIP == parser.getContentCoding())
+            {
+                append(" gzip");
+            }
+
+            append("\n");
+            break;
+
+        case HttpResponseParser::EVENT_BODY:
+            TEST_ASSERT_LESS_OR_EQUAL(sizeof(gBody), gBodyLen + parser.getBody().size);
+            memcpy(&gBody[gBodyLen], parser.getBody().data, parser.getBody().size);
+            gBodyLen += parser.getBody().size;
+            break;
+
+        case HttpResponseParser::EVENT_COMPLETE:
+            if (0U < gBodyLen)
+            {
+                append("body %.*s\n", static_cast<int>(gBodyLen), gBody);
+                gBodyLen = 0U;
+            }
+
+            append("complete\n");
+            break;
+
+        case HttpResponseParser::EVENT_ERROR:
+            append("error\n");
+            break;
+
+        case HttpResponseParser::EVENT_NONE:
+        default:
+            break;
+        }
+    }
+    while ((HttpResponseParser::EVENT_NONE != event) &&
+           (HttpResponseParser::EVENT_ERROR != event));
+
+    return (HttpResponseParser::EVENT_ERROR == event);
+}
+
+/**
+ * Finish the connection and record the completed response.
+ *
+ * @param[in] parser    HTTP response parser
+ * @param[in] isError   Did a parse error happen before?
+ * @param[in] canned    Canned response
+ */
+static void finish(HttpResponseParser& parser, bool isError, const CannedResponse& canned)
+{
+    /* An incomplete body, which is delimited by the connection close, is reported at the end. */
+    if ((false == isError) &&
+        (true == canned.isFinished) &&
+        (true == parser.finish()))
+    {
+        append("body %.*s\n", static_cast<int>(gBodyLen), gBody);
+        append("complete\n");
+    }
+    else if ((false == isError) &&
+             (0U < gBodyLen))
+    {
+        append("body %.*s\n", static_cast<int>(gBodyLen), gBody);
+    }
+}
+
+/**
+ * Parse a canned response in two segments.
+ *
+ * @param[in] parser    HTTP response parser
+ * @param[in] canned    Canned response
+ * @param[in] splitPos  Position in the response, where to split.
+ */
+static void parseSplit(HttpResponseParser& parser, const CannedResponse& canned, size_t splitPos)
+{
+    size_t  size    = strlen(canned.response);
+    bool    isError = false;
+
+    initParser(parser);
+
+    isError = feed(parser, canned.response, splitPos);
+
+    if (false == isError)
+    {
+        isError = feed(parser, &canned.response[splitPos], size - splitPos);
+    }
+
+    finish(parser, isError, canned);
+}
+
+/**
+ * Parse a canned response byte by byte.
+ *
+ * @param[in] parser    HTTP response parser
+ * @param[in] canned    Canned response
+ */
+static void parseByteByByte(HttpResponseParser& parser, const CannedResponse& canned)
+{
+    size_t  size    = strlen(canned.response);
+    size_t  idx     = 0U;
+    bool    isError = false;
+
+    initParser(parser);
+
+    while ((size > idx) &&
+           (false == isError))
+    {
+        isError = feed(parser, &canned.response[idx], 1U);
+        ++idx;
+    }
+
+    finish(parser, isError, canned);
+}
+
+/**
+ * Append formatted text to the transcript.
+ *
+ * @param[in] format    Format string
+ */
+static void append(const char* format, ...)
+{
+    va_list args;
+    int     len     = 0;
+
+    va_start(args, format);
+    len = vsnprintf(&gTranscript[gTranscriptLen], sizeof(gTranscript) - gTranscriptLen, format, args);
+    va_end(args);
+
+    TEST_ASSERT_TRUE(0 <= len);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(gTranscript) - 1U, gTranscriptLen + static_cast<size_t>(len));
+
+    gTranscriptLen += static_cast<size_t>(len);
+}
+
+/**
+ * Append a span to the transcript.
+ *
+ * @param[in] span  Span
+ */
+static void appendSpan(const HttpResponseParser::Span& span)
+{
+    append("%.*s", static_cast<int>(span.size), span.data);
+}
+
+/**
+ * Get the next pseudo random number (linear congruential generator), which
+ * keeps the fuzzing reproducible.
+ *
+ * @return Pseudo random number
+ */
+static uint32_t nextRandom()
+{
+    gRandom = gRandom * 1103515245U + 12345U;
+
+    return (gRandom >> 16U) & 0x7FFFU;
+}
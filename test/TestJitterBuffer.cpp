@@ -0,0 +1,273 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test jitter buffer.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestJitterBuffer.h"
+
+#include <unity.h>
+#include <string.h>
+#include <JitterBuffer.h>
+#include <LoopbackSender.h>
+#include <StreamPacket.h>
+#include <ColorDef.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool isEqual(const uint32_t* pixels, uint16_t width, uint16_t height, uint32_t frameNo);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Test frame width in pixel */
+static const uint16_t   WIDTH   = 8U;
+
+/** Test frame height in pixel */
+static const uint16_t   HEIGHT  = 4U;
+
+/** Plugin UID, which receives the frames. */
+static const uint16_t   UID     = 1234U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test jitter buffer, fed by the loopback sender.
+ */
+extern void testJitterBuffer()
+{
+    JitterBuffer            jitterBuffer;
+    LoopbackSender          sender;
+    JitterBuffer::Result    result      = JitterBuffer::RESULT_OK;
+    uint32_t                timestamp   = 0U;
+    uint32_t                framebuffer[WIDTH * HEIGHT];
+    uint8_t                 packetCopy[StreamPacket::HEADER_SIZE + DisplayFrame::HEADER_SIZE + WIDTH * HEIGHT * 3U];
+    size_t                  packetCopySize  = 0U;
+    const uint32_t*         pixels      = nullptr;
+    uint32_t                frameNo     = 0U;
+    uint16_t                idx         = 0U;
+
+    /* Receive the stream packets like the plugin does. */
+    sender.setSendFunc([&](const uint8_t* packet, size_t size) {
+        uint16_t        uid         = 0U;
+        uint16_t        seqNum      = 0U;
+        const uint8_t*  frame       = nullptr;
+        size_t          frameSize   = 0U;
+
+        TEST_ASSERT_TRUE(StreamPacket::parse(packet, size, uid, seqNum, frame, frameSize));
+        TEST_ASSERT_EQUAL_UINT16(UID, uid);
+
+        result = jitterBuffer.push(seqNum, frame, frameSize, timestamp);
+    });
+
+    /* Invalid parameters */
+    TEST_ASSERT_FALSE(jitterBuffer.init(0U, HEIGHT, 4U, 2U, 100U));
+    TEST_ASSERT_FALSE(jitterBuffer.init(WIDTH, HEIGHT, 1U, 1U, 100U));
+    TEST_ASSERT_FALSE(jitterBuffer.init(WIDTH, HEIGHT, 4U, 4U, 100U));
+    TEST_ASSERT_FALSE(jitterBuffer.init(WIDTH, HEIGHT, JitterBuffer::SLOTS_MAX + 1U, 2U, 100U));
+
+    /* Nothing received, nothing to present. */
+    TEST_ASSERT_TRUE(jitterBuffer.init(WIDTH, HEIGHT, 4U, 2U, 100U));
+    TEST_ASSERT_TRUE(sender.init(UID, WIDTH, HEIGHT, DisplayFrame::COLOR_FORMAT_RGB888, 0U));
+    TEST_ASSERT_NULL(jitterBuffer.pop(timestamp));
+
+    /* First frame is a key frame, but it is hold back until the depth is reached. */
+    LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+    TEST_ASSERT_EQUAL_UINT32(StreamPacket::HEADER_SIZE + DisplayFrame::HEADER_SIZE + WIDTH * HEIGHT * 3U, sender.encode(framebuffer));
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_OK, result);
+    TEST_ASSERT_NULL(jitterBuffer.pop(timestamp));
+
+    /* Second frame is a small delta frame, now the first one is presented. */
+    LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+    TEST_ASSERT_LESS_THAN_UINT32(StreamPacket::HEADER_SIZE + DisplayFrame::HEADER_SIZE + WIDTH * HEIGHT * 3U, sender.encode(framebuffer));
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_OK, result);
+    pixels = jitterBuffer.pop(timestamp);
+    TEST_ASSERT_NOT_NULL(pixels);
+    TEST_ASSERT_TRUE(isEqual(pixels, WIDTH, HEIGHT, 0U));
+    TEST_ASSERT_EQUAL_UINT8(1U, jitterBuffer.getCount());
+
+    /* Duplicate packet */
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_DUPLICATE, result);
+    TEST_ASSERT_EQUAL_UINT32(1U, jitterBuffer.getStatistics().duplicate);
+
+    /* Without further frames, the second one is presented after the hold time. */
+    TEST_ASSERT_NULL(jitterBuffer.pop(timestamp));
+    timestamp += 100U;
+    pixels = jitterBuffer.pop(timestamp);
+    TEST_ASSERT_NOT_NULL(pixels);
+    TEST_ASSERT_TRUE(isEqual(pixels, WIDTH, HEIGHT, 1U));
+    TEST_ASSERT_NULL(jitterBuffer.pop(timestamp));
+
+    /* Lost packet: The following delta frame has no reference. */
+    LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+    TEST_ASSERT_NOT_EQUAL(0U, sender.encode(framebuffer));
+    LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+    TEST_ASSERT_NOT_EQUAL(0U, sender.encode(framebuffer));
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_NO_REFERENCE, result);
+    TEST_ASSERT_EQUAL_UINT32(1U, jitterBuffer.getStatistics().dropped);
+
+    /* Recover with a key frame. */
+    LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+    sender.forceKeyFrame();
+    TEST_ASSERT_NOT_EQUAL(0U, sender.encode(framebuffer));
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_OK, result);
+
+    /* Reordered packets: The older one is late. */
+    LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+    packetCopySize = sender.encode(framebuffer);
+    (void)memcpy(packetCopy, sender.getPacket(), packetCopySize);
+    LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+    sender.forceKeyFrame();
+    TEST_ASSERT_NOT_EQUAL(0U, sender.encode(framebuffer));
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_OK, result);
+    result = jitterBuffer.push(static_cast<uint16_t>(packetCopy[2U]) | (static_cast<uint16_t>(packetCopy[3U]) << 8U),
+                               &packetCopy[StreamPacket::HEADER_SIZE],
+                               packetCopySize - StreamPacket::HEADER_SIZE,
+                               timestamp);
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_LATE, result);
+    TEST_ASSERT_EQUAL_UINT32(1U, jitterBuffer.getStatistics().late);
+
+    /* Two frames are buffered, the depth is reached. */
+    pixels = jitterBuffer.pop(timestamp);
+    TEST_ASSERT_NOT_NULL(pixels);
+    TEST_ASSERT_TRUE(isEqual(pixels, WIDTH, HEIGHT, 4U));
+
+    /* Overflow: The oldest frames are dropped and skipped to keep the latency low. */
+    for(idx = 0U; idx < 6U; ++idx)
+    {
+        LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+        TEST_ASSERT_NOT_EQUAL(0U, sender.encode(framebuffer));
+        TEST_ASSERT_TRUE(sender.send());
+        TEST_ASSERT_EQUAL(JitterBuffer::RESULT_OK, result);
+    }
+    TEST_ASSERT_EQUAL_UINT8(4U, jitterBuffer.getCount());
+    TEST_ASSERT_EQUAL_UINT32(1U + 3U, jitterBuffer.getStatistics().dropped);
+    pixels = jitterBuffer.pop(timestamp);
+    TEST_ASSERT_NOT_NULL(pixels);
+    TEST_ASSERT_TRUE(isEqual(pixels, WIDTH, HEIGHT, frameNo - 2U));
+    TEST_ASSERT_EQUAL_UINT32(1U + 3U + 2U, jitterBuffer.getStatistics().dropped);
+
+    /* Restart of the stream with a key frame. */
+    sender.setSeqNum(0U);
+    sender.forceKeyFrame();
+    LoopbackSender::drawTestPattern(framebuffer, WIDTH, HEIGHT, frameNo++);
+    TEST_ASSERT_NOT_EQUAL(0U, sender.encode(framebuffer));
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_LATE, result);
+    sender.setSeqNum(static_cast<uint16_t>(0U - JitterBuffer::RESTART_THRESHOLD));
+    sender.forceKeyFrame();
+    TEST_ASSERT_NOT_EQUAL(0U, sender.encode(framebuffer));
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_OK, result);
+
+    /* Invalid frame size */
+    result = jitterBuffer.push(0U, &sender.getPacket()[StreamPacket::HEADER_SIZE], DisplayFrame::HEADER_SIZE - 1U, timestamp);
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_INVALID, result);
+
+    /* RGB565 key frame */
+    jitterBuffer.reset();
+    TEST_ASSERT_TRUE(sender.init(UID, WIDTH, HEIGHT, DisplayFrame::COLOR_FORMAT_RGB565, 0U));
+    for(idx = 0U; idx < (WIDTH * HEIGHT); ++idx)
+    {
+        framebuffer[idx] = 0x123456U * idx;
+    }
+    TEST_ASSERT_EQUAL_UINT32(StreamPacket::HEADER_SIZE + DisplayFrame::HEADER_SIZE + WIDTH * HEIGHT * 2U, sender.encode(framebuffer));
+    TEST_ASSERT_TRUE(sender.send());
+    TEST_ASSERT_EQUAL(JitterBuffer::RESULT_OK, result);
+    timestamp += 100U;
+    pixels = jitterBuffer.pop(timestamp);
+    TEST_ASSERT_NOT_NULL(pixels);
+    for(idx = 0U; idx < (WIDTH * HEIGHT); ++idx)
+    {
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::convert565To888(ColorDef::convert888To565(framebuffer[idx])), pixels[idx]);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Check whether the pixels are equal to the test pattern.
+ *
+ * @param[in] pixels    Pixels in RGB888 format
+ * @param[in] width     Frame width in pixel
+ * @param[in] height    Frame height in pixel
+ * @param[in] frameNo   Frame number of the test pattern
+ *
+ * @return If equal, it will return true otherwise false.
+ */
+static bool isEqual(const uint32_t* pixels, uint16_t width, uint16_t height, uint32_t frameNo)
+{
+    uint32_t expected[width * height];
+
+    LoopbackSender::drawTestPattern(expected, width, height, frameNo);
+
+    return (0 == memcmp(expected, pixels, sizeof(expected)));
+}
@@ -0,0 +1,234 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test job scheduler.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestJobScheduler.h"
+
+#include <unity.h>
+#include <JobScheduler.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test job scheduler.
+ */
+extern void testJobScheduler()
+{
+    const uint8_t   MAX_RUNNING     = 2U;
+    const uint32_t  MAX_JITTER      = 1000U;
+    const uint32_t  RETRY_PERIOD    = 10000U;
+    const uint32_t  PERIOD          = 60000U;
+    const uint32_t  SHORT_PERIOD    = 500U;
+    const uint8_t   PRIO_LOW        = 0U;
+    const uint8_t   PRIO_HIGH       = 2U;
+    JobScheduler    scheduler(MAX_RUNNING, MAX_JITTER, RETRY_PERIOD);
+    uint8_t         jobA            = JobScheduler::INVALID_ID;
+    uint8_t         jobB            = JobScheduler::INVALID_ID;
+    uint8_t         jobC            = JobScheduler::INVALID_ID;
+    uint8_t         idx             = 0U;
+    uint32_t        timestamp       = 0U;
+    uint32_t        remaining       = 0U;
+    uint32_t        retryDelay      = RETRY_PERIOD;
+
+    /* No job */
+    TEST_ASSERT_EQUAL_UINT8(0U, scheduler.getCount());
+    TEST_ASSERT_EQUAL_UINT8(JobScheduler::INVALID_ID, scheduler.next(0U));
+
+    /* First due time is within the jitter. */
+    jobA = scheduler.add(PERIOD, PRIO_LOW, timestamp);
+    TEST_ASSERT_NOT_EQUAL(JobScheduler::INVALID_ID, jobA);
+    TEST_ASSERT_EQUAL_UINT8(1U, scheduler.getCount());
+    TEST_ASSERT_LESS_THAN_UINT32(MAX_JITTER, scheduler.getRemaining(jobA, timestamp));
+    TEST_ASSERT_EQUAL_UINT8(jobA, scheduler.next(timestamp + MAX_JITTER));
+    TEST_ASSERT_TRUE(scheduler.isRunning(jobA));
+    TEST_ASSERT_EQUAL_UINT8(1U, scheduler.getRunningCount());
+
+    /* Running job is not provided again. */
+    TEST_ASSERT_EQUAL_UINT8(JobScheduler::INVALID_ID, scheduler.next(timestamp + MAX_JITTER));
+
+    /* Successful job is due exactly after its period, without jitter. */
+    timestamp = 2000U;
+    scheduler.finish(jobA, true, timestamp);
+    TEST_ASSERT_FALSE(scheduler.isRunning(jobA));
+    TEST_ASSERT_EQUAL_UINT8(0U, scheduler.getRunningCount());
+    TEST_ASSERT_EQUAL_UINT32(PERIOD, scheduler.getRemaining(jobA, timestamp));
+    TEST_ASSERT_EQUAL_UINT8(JobScheduler::INVALID_ID, scheduler.next(timestamp + PERIOD - 1U));
+
+    /* A job with a period shorter than the jitter keeps its period in steady state. */
+    scheduler.setPeriod(jobA, SHORT_PERIOD);
+    for(idx = 0U; idx < 10U; ++idx)
+    {
+        scheduler.trigger(jobA, timestamp);
+        TEST_ASSERT_EQUAL_UINT8(jobA, scheduler.next(timestamp));
+        scheduler.finish(jobA, true, timestamp);
+        TEST_ASSERT_EQUAL_UINT32(SHORT_PERIOD, scheduler.getRemaining(jobA, timestamp));
+
+        timestamp += SHORT_PERIOD;
+    }
+    scheduler.setPeriod(jobA, PERIOD);
+
+    /* Failed job is retried with exponential backoff, but never later than its period. */
+    for(idx = 0U; idx < 5U; ++idx)
+    {
+        scheduler.trigger(jobA, timestamp);
+        TEST_ASSERT_EQUAL_UINT8(jobA, scheduler.next(timestamp));
+        scheduler.finish(jobA, false, timestamp);
+        TEST_ASSERT_EQUAL_UINT8(idx + 1U, scheduler.getFailureCount(jobA));
+
+        /* The retry jitter is limited to a fraction of the delay. */
+        remaining = scheduler.getRemaining(jobA, timestamp);
+        TEST_ASSERT_TRUE(retryDelay <= remaining);
+        TEST_ASSERT_LESS_THAN_UINT32(retryDelay + (retryDelay / JobScheduler::RETRY_JITTER_DIVIDER), remaining);
+
+        retryDelay *= 2U;
+
+        if (PERIOD < retryDelay)
+        {
+            retryDelay = PERIOD;
+        }
+    }
+
+    /* Success resets the backoff. */
+    scheduler.trigger(jobA, timestamp);
+    TEST_ASSERT_EQUAL_UINT8(jobA, scheduler.next(timestamp));
+    scheduler.finish(jobA, true, timestamp);
+    TEST_ASSERT_EQUAL_UINT8(0U, scheduler.getFailureCount(jobA));
+
+    /* Job with a short period is retried with the retry period. */
+    scheduler.setPeriod(jobA, 1000U);
+    scheduler.trigger(jobA, timestamp);
+    TEST_ASSERT_EQUAL_UINT8(jobA, scheduler.next(timestamp));
+    scheduler.finish(jobA, false, timestamp);
+    remaining = scheduler.getRemaining(jobA, timestamp);
+    TEST_ASSERT_TRUE(RETRY_PERIOD <= remaining);
+    TEST_ASSERT_LESS_THAN_UINT32(RETRY_PERIOD + MAX_JITTER, remaining);
+    scheduler.setPeriod(jobA, PERIOD);
+
+    /* Higher priority job is started first, max. number of running jobs is considered. */
+    jobB = scheduler.add(PERIOD, PRIO_LOW, timestamp);
+    jobC = scheduler.add(PERIOD, PRIO_LOW, timestamp);
+    scheduler.trigger(jobA, timestamp);
+    scheduler.trigger(jobB, timestamp);
+    scheduler.trigger(jobC, timestamp + 1U);
+    scheduler.setPriority(jobC, PRIO_HIGH);
+    TEST_ASSERT_EQUAL_UINT8(jobC, scheduler.next(timestamp + 1U));
+    TEST_ASSERT_EQUAL_UINT8(jobA, scheduler.next(timestamp + 1U));
+    TEST_ASSERT_EQUAL_UINT8(2U, scheduler.getRunningCount());
+    TEST_ASSERT_EQUAL_UINT8(JobScheduler::INVALID_ID, scheduler.next(timestamp + 1U));
+    TEST_ASSERT_FALSE(scheduler.isRunning(jobB));
+
+    /* Removing a running job frees its running slot. */
+    scheduler.remove(jobC);
+    TEST_ASSERT_FALSE(scheduler.isRunning(jobC));
+    TEST_ASSERT_EQUAL_UINT8(1U, scheduler.getRunningCount());
+    TEST_ASSERT_EQUAL_UINT8(jobB, scheduler.next(timestamp + 1U));
+    scheduler.finish(jobC, true, timestamp);
+    TEST_ASSERT_EQUAL_UINT8(2U, scheduler.getRunningCount());
+    scheduler.finish(jobA, true, timestamp);
+    scheduler.finish(jobB, true, timestamp);
+    TEST_ASSERT_EQUAL_UINT8(0U, scheduler.getRunningCount());
+
+    /* Spread all jobs over a time window and forget the failures. */
+    scheduler.trigger(jobA, timestamp);
+    TEST_ASSERT_EQUAL_UINT8(jobA, scheduler.next(timestamp));
+    scheduler.finish(jobA, false, timestamp);
+    scheduler.spread(5000U, timestamp);
+    TEST_ASSERT_EQUAL_UINT8(0U, scheduler.getFailureCount(jobA));
+    TEST_ASSERT_LESS_THAN_UINT32(5000U, scheduler.getRemaining(jobA, timestamp));
+    TEST_ASSERT_LESS_THAN_UINT32(5000U, scheduler.getRemaining(jobB, timestamp));
+
+    /* Timestamp overflow is considered. */
+    timestamp = UINT32_MAX - 100U;
+    scheduler.spread(0U, timestamp);
+    TEST_ASSERT_EQUAL_UINT8(jobA, scheduler.next(timestamp));
+    scheduler.finish(jobA, true, timestamp);
+    TEST_ASSERT_FALSE(scheduler.isRunning(jobA));
+    TEST_ASSERT_TRUE((PERIOD - 200U) <= scheduler.getRemaining(jobA, timestamp + 200U));
+
+    /* All jobs used */
+    scheduler.remove(jobA);
+    scheduler.remove(jobB);
+    TEST_ASSERT_EQUAL_UINT8(0U, scheduler.getCount());
+
+    for(idx = 0U; idx < JobScheduler::MAX_JOBS; ++idx)
+    {
+        TEST_ASSERT_NOT_EQUAL(JobScheduler::INVALID_ID, scheduler.add(PERIOD, PRIO_LOW, 0U));
+    }
+    TEST_ASSERT_EQUAL_UINT8(JobScheduler::INVALID_ID, scheduler.add(PERIOD, PRIO_LOW, 0U));
+
+    /* Invalid job ids are ignored. */
+    scheduler.remove(JobScheduler::INVALID_ID);
+    scheduler.finish(JobScheduler::INVALID_ID, true, 0U);
+    TEST_ASSERT_FALSE(scheduler.isRunning(JobScheduler::INVALID_ID));
+    TEST_ASSERT_EQUAL_UINT32(0U, scheduler.getRemaining(JobScheduler::INVALID_ID, 0U));
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,227 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test JSON stream filter.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestJsonStreamFilter.h"
+
+#include <unity.h>
+#include <JsonStreamFilter.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool feedInSegments(JsonStreamFilter& streamFilter, const char* json, size_t segmentSize);
+static void assertOutput(const JsonStreamFilter& streamFilter, const char* expected);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Shortened OpenWeather One Call API response. */
+static const char*  gOneCallRsp =
+    "{\r\n"
+    "  \"lat\": 33.44, \"lon\": -94.04, \"timezone\": \"America/Chicago\",\r\n"
+    "  \"current\": {\r\n"
+    "    \"dt\": 1618317040, \"temp\": 284.07, \"humidity\": 62, \"uvi\": 0.89,\r\n"
+    "    \"wind_speed\": 6, \"wind_deg\": 300,\r\n"
+    "    \"weather\": [ { \"id\": 500, \"main\": \"Rain\", \"description\": \"light \\\"rain\\\" [1]\", \"icon\": \"10d\" },\r\n"
+    "                   { \"id\": 501, \"icon\": \"10n\" } ],\r\n"
+    "    \"rain\": { \"1h\": 0.21 }\r\n"
+    "  },\r\n"
+    "  \"hourly\": [ { \"dt\": 1618315200, \"temp\": 282.58, \"weather\": [ { \"icon\": \"04d\" } ] } ]\r\n"
+    "}\r\n";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test JSON stream filter.
+ */
+extern void testJsonStreamFilter()
+{
+    const size_t                    FILTER_SIZE     = 256U;
+    StaticJsonDocument<FILTER_SIZE> filter;
+    const char*                     EXPECTED        = "{\"current\":{\"temp\":284.07,\"humidity\":62,\"uvi\":0.89,\"wind_speed\":6,\"weather\":[{\"icon\":\"10d\"},{\"icon\":\"10n\"}]}}";
+    size_t                          segmentSize     = 0U;
+
+    filter["current"]["temp"]               = true;
+    filter["current"]["uvi"]                = true;
+    filter["current"]["humidity"]           = true;
+    filter["current"]["wind_speed"]         = true;
+    filter["current"]["weather"][0]["icon"] = true;
+
+    /* The result must be independent of the segmentation. */
+    for(segmentSize = 1U; segmentSize <= strlen(gOneCallRsp); segmentSize *= 3U)
+    {
+        JsonStreamFilter streamFilter(filter);
+
+        TEST_ASSERT_TRUE(feedInSegments(streamFilter, gOneCallRsp, segmentSize));
+        TEST_ASSERT_TRUE(streamFilter.isComplete());
+        assertOutput(streamFilter, EXPECTED);
+    }
+
+    /* Reset for the next document, incomplete document. */
+    {
+        JsonStreamFilter streamFilter(filter);
+
+        TEST_ASSERT_TRUE(feedInSegments(streamFilter, "{\"current\":{\"temp\":1", 5U));
+        TEST_ASSERT_FALSE(streamFilter.isComplete());
+
+        streamFilter.reset();
+        TEST_ASSERT_EQUAL_UINT32(0U, streamFilter.getOutputSize());
+        TEST_ASSERT_TRUE(feedInSegments(streamFilter, gOneCallRsp, 100U));
+        TEST_ASSERT_TRUE(streamFilter.isComplete());
+        assertOutput(streamFilter, EXPECTED);
+    }
+
+    /* Wildcard key and value type, which doesn't match to the filter. */
+    {
+        StaticJsonDocument<FILTER_SIZE> filterWildcard;
+
+        filterWildcard["bpi"]["*"]["rate"]  = true;
+        filterWildcard["time"]["x"]         = true;
+
+        JsonStreamFilter streamFilter(filterWildcard);
+
+        TEST_ASSERT_TRUE(feedInSegments(streamFilter, "{\"time\":\"now\",\"bpi\":{\"USD\":{\"rate\":\"1,0\",\"code\":\"USD\"},\"EUR\":{\"rate\":\"2\"}},\"x\":[]}", 7U));
+        TEST_ASSERT_TRUE(streamFilter.isComplete());
+        assertOutput(streamFilter, "{\"time\":null,\"bpi\":{\"USD\":{\"rate\":\"1,0\"},\"EUR\":{\"rate\":\"2\"}}}");
+    }
+
+    /* Empty filter keeps everything, only whitespace is dropped. */
+    {
+        StaticJsonDocument<FILTER_SIZE> filterEmpty;
+        JsonStreamFilter                streamFilter(filterEmpty);
+
+        TEST_ASSERT_TRUE(feedInSegments(streamFilter, " { \"a\" : [ 1 , \"b c\" ] } ", 2U));
+        TEST_ASSERT_TRUE(streamFilter.isComplete());
+        assertOutput(streamFilter, "{\"a\":[1,\"b c\"]}");
+    }
+
+    /* Invalid document */
+    {
+        JsonStreamFilter streamFilter(filter);
+
+        TEST_ASSERT_FALSE(feedInSegments(streamFilter, "{\"current\" 1}", 4U));
+        TEST_ASSERT_TRUE(streamFilter.isError());
+        TEST_ASSERT_FALSE(streamFilter.isComplete());
+    }
+
+    /* Filtered result exceeds the max. output size. */
+    {
+        StaticJsonDocument<FILTER_SIZE> filterAll;
+
+        filterAll["hourly"] = true;
+
+        JsonStreamFilter streamFilter(filterAll, 16U);
+
+        TEST_ASSERT_FALSE(feedInSegments(streamFilter, gOneCallRsp, 64U));
+        TEST_ASSERT_TRUE(streamFilter.isError());
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Feed the JSON document in segments into the stream filter.
+ *
+ * @param[in] streamFilter  JSON stream filter
+ * @param[in] json          JSON document
+ * @param[in] segmentSize   Segment size in byte
+ *
+ * @return If all segments are successful parsed, it will return true otherwise false.
+ */
+static bool feedInSegments(JsonStreamFilter& streamFilter, const char* json, size_t segmentSize)
+{
+    bool    isSuccessful    = true;
+    size_t  jsonSize        = strlen(json);
+    size_t  index           = 0U;
+
+    while((jsonSize > index) && (true == isSuccessful))
+    {
+        size_t size = jsonSize - index;
+
+        if (segmentSize < size)
+        {
+            size = segmentSize;
+        }
+
+        isSuccessful = streamFilter.parse(reinterpret_cast<const uint8_t*>(&json[index]), size);
+        index += size;
+    }
+
+    return isSuccessful;
+}
+
+/**
+ * Assert that the filtered JSON text is equal to the expected one.
+ *
+ * @param[in] streamFilter  JSON stream filter
+ * @param[in] expected      Expected filtered JSON text
+ */
+static void assertOutput(const JsonStreamFilter& streamFilter, const char* expected)
+{
+    TEST_ASSERT_EQUAL_UINT32(strlen(expected), streamFilter.getOutputSize());
+    TEST_ASSERT_EQUAL_INT(0, strncmp(expected, streamFilter.getOutput(), streamFilter.getOutputSize()));
+}
@@ -50,6 +50,19 @@
 #include "TestLogging.h"
 #include "TestUtil.h"
 #include "TestBmpImgLoader.h"
+#include "TestStatisticValue.h"
+#include "TestHistogram.h"
+#include "TestTimeBudget.h"
+#include "TestJitterBuffer.h"
+#include "TestDrawCmd.h"
+#include "TestPrefixTree.h"
+#include "TestGrowBuffer.h"
+#include "TestJsonStreamFilter.h"
+#include "TestConnectionPool.h"
+#include "TestJobScheduler.h"
+#include "TestGzipDecoder.h"
+#include "TestHttpResponseParser.h"
+#include "TestDnsCache.h"
 
 /******************************************************************************
  * Macros
@@ -99,6 +112,19 @@ int main(int argc, char **argv)
     RUN_TEST(testProgressBar);
     RUN_TEST(testLogging);
     RUN_TEST(testUtil);
+    RUN_TEST(testStatisticValue);
+    RUN_TEST(testHistogram);
+    RUN_TEST(testTimeBudget);
+    RUN_TEST(testJitterBuffer);
+    RUN_TEST(testDrawCmd);
+    RUN_TEST(testPrefixTree);
+    RUN_TEST(testGrowBuffer);
+    RUN_TEST(testJsonStreamFilter);
+    RUN_TEST(testConnectionPool);
+    RUN_TEST(testJobScheduler);
+    RUN_TEST(testGzipDecoder);
+    RUN_TEST(testHttpResponseParser);
+    RUN_TEST(testDnsCache);
 
     return UNITY_END();
 }
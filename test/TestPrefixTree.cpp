@@ -0,0 +1,164 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test prefix tree.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestPrefixTree.h"
+
+#include <unity.h>
+#include <PrefixTree.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test prefix tree.
+ */
+extern void testPrefixTree()
+{
+    PrefixTree<uint32_t>    prefixTree;
+    uint32_t                value       = 0U;
+    const char*             url         = "/uid/1/text?show=1";
+
+    /* Empty tree */
+    TEST_ASSERT_EQUAL_UINT32(0U, prefixTree.getCount());
+    TEST_ASSERT_FALSE(prefixTree.find("", value));
+    TEST_ASSERT_FALSE(prefixTree.find("/uid/1/text", value));
+    TEST_ASSERT_FALSE(prefixTree.find(nullptr, value));
+    TEST_ASSERT_FALSE(prefixTree.remove("/uid/1/text"));
+
+    /* Keys with common prefix */
+    TEST_ASSERT_TRUE(prefixTree.insert("/uid/1/text", 1U));
+    TEST_ASSERT_TRUE(prefixTree.insert("/uid/1/icon", 2U));
+    TEST_ASSERT_TRUE(prefixTree.insert("/uid/12/text", 3U));
+    TEST_ASSERT_TRUE(prefixTree.insert("/alias/clock/cfg", 4U));
+    TEST_ASSERT_FALSE(prefixTree.insert(nullptr, 5U));
+    TEST_ASSERT_EQUAL_UINT32(4U, prefixTree.getCount());
+
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/1/text", value));
+    TEST_ASSERT_EQUAL_UINT32(1U, value);
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/1/icon", value));
+    TEST_ASSERT_EQUAL_UINT32(2U, value);
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/12/text", value));
+    TEST_ASSERT_EQUAL_UINT32(3U, value);
+    TEST_ASSERT_TRUE(prefixTree.find("/alias/clock/cfg", value));
+    TEST_ASSERT_EQUAL_UINT32(4U, value);
+
+    /* A prefix or a extended key is not a key. */
+    TEST_ASSERT_FALSE(prefixTree.find("/uid/1", value));
+    TEST_ASSERT_FALSE(prefixTree.find("/uid/1/text/", value));
+    TEST_ASSERT_FALSE(prefixTree.find("", value));
+
+    /* Find a key, which is part of a longer string. */
+    TEST_ASSERT_TRUE(prefixTree.find(url, 11U, value));
+    TEST_ASSERT_EQUAL_UINT32(1U, value);
+    TEST_ASSERT_FALSE(prefixTree.find(url, 10U, value));
+
+    /* Overwrite value */
+    TEST_ASSERT_TRUE(prefixTree.insert("/uid/1/text", 10U));
+    TEST_ASSERT_EQUAL_UINT32(4U, prefixTree.getCount());
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/1/text", value));
+    TEST_ASSERT_EQUAL_UINT32(10U, value);
+
+    /* Remove a key, the others with common prefix must remain. */
+    TEST_ASSERT_TRUE(prefixTree.remove("/uid/1/text"));
+    TEST_ASSERT_FALSE(prefixTree.remove("/uid/1/text"));
+    TEST_ASSERT_FALSE(prefixTree.remove("/uid/1"));
+    TEST_ASSERT_EQUAL_UINT32(3U, prefixTree.getCount());
+    TEST_ASSERT_FALSE(prefixTree.find("/uid/1/text", value));
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/1/icon", value));
+    TEST_ASSERT_EQUAL_UINT32(2U, value);
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/12/text", value));
+    TEST_ASSERT_EQUAL_UINT32(3U, value);
+
+    /* A key which is the prefix of another key. */
+    TEST_ASSERT_TRUE(prefixTree.insert("/uid/1", 6U));
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/1", value));
+    TEST_ASSERT_EQUAL_UINT32(6U, value);
+    TEST_ASSERT_TRUE(prefixTree.remove("/uid/1/icon"));
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/1", value));
+    TEST_ASSERT_EQUAL_UINT32(6U, value);
+
+    /* Empty key */
+    TEST_ASSERT_TRUE(prefixTree.insert("", 7U));
+    TEST_ASSERT_TRUE(prefixTree.find("", value));
+    TEST_ASSERT_EQUAL_UINT32(7U, value);
+    TEST_ASSERT_EQUAL_UINT32(4U, prefixTree.getCount());
+
+    /* Remove all */
+    prefixTree.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, prefixTree.getCount());
+    TEST_ASSERT_FALSE(prefixTree.find("", value));
+    TEST_ASSERT_FALSE(prefixTree.find("/uid/12/text", value));
+    TEST_ASSERT_TRUE(prefixTree.insert("/uid/12/text", 8U));
+    TEST_ASSERT_TRUE(prefixTree.find("/uid/12/text", value));
+    TEST_ASSERT_EQUAL_UINT32(8U, value);
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -83,6 +83,7 @@ extern void testSimpleTimer()
     /* Timer must be stopped */
     TEST_ASSERT_FALSE(testTimer.isTimerRunning());
     TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, testTimer.getRemaining());
 
     /* Start and check */
     testTimer.start(0U);
@@ -103,9 +104,12 @@ extern void testSimpleTimer()
     /* Start timer and start it again after timeout. */
     testTimer.start(0U);
     TEST_ASSERT_TRUE(testTimer.isTimeout());
+    TEST_ASSERT_EQUAL_UINT32(0U, testTimer.getRemaining());
     testTimer.start(100U);
     TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_UINT32_WITHIN(1U, 100U, testTimer.getRemaining());
     testTimer.stop();
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, testTimer.getRemaining());
 
     return;
 }
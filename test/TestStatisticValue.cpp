@@ -0,0 +1,123 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test statistic value.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestStatisticValue.h"
+
+#include <unity.h>
+#include <StatisticValue.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test statistic value.
+ */
+extern void testStatisticValue()
+{
+    StatisticValue<uint32_t, 0U, 10U>   statisticValue;
+    uint32_t                            idx             = 0U;
+
+    /* No value available yet. */
+    TEST_ASSERT_EQUAL_UINT32(0U, statisticValue.getMin());
+    TEST_ASSERT_EQUAL_UINT32(0U, statisticValue.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0U, statisticValue.getAvg());
+    TEST_ASSERT_EQUAL_UINT32(0U, statisticValue.getPercentile(50U));
+
+    /* Update with values in descending order. */
+    for(idx = 10U; idx > 0U; --idx)
+    {
+        statisticValue.update(idx);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1U, statisticValue.getCurrent());
+    TEST_ASSERT_EQUAL_UINT32(1U, statisticValue.getMin());
+    TEST_ASSERT_EQUAL_UINT32(10U, statisticValue.getMax());
+    TEST_ASSERT_EQUAL_UINT32(5U, statisticValue.getAvg());
+
+    /* Percentiles with the nearest rank method. */
+    TEST_ASSERT_EQUAL_UINT32(1U, statisticValue.getPercentile(0U));
+    TEST_ASSERT_EQUAL_UINT32(5U, statisticValue.getPercentile(50U));
+    TEST_ASSERT_EQUAL_UINT32(9U, statisticValue.getPercentile(90U));
+    TEST_ASSERT_EQUAL_UINT32(10U, statisticValue.getPercentile(99U));
+    TEST_ASSERT_EQUAL_UINT32(10U, statisticValue.getPercentile(100U));
+
+    /* Only the last values are considered, the oldest is dropped. */
+    statisticValue.update(20U);
+    TEST_ASSERT_EQUAL_UINT32(20U, statisticValue.getPercentile(100U));
+    TEST_ASSERT_EQUAL_UINT32(1U, statisticValue.getPercentile(0U));
+
+    /* Reset to initial state. */
+    statisticValue.reset();
+    TEST_ASSERT_EQUAL_UINT32(0U, statisticValue.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0U, statisticValue.getPercentile(99U));
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
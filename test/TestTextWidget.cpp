@@ -129,6 +129,12 @@ extern void testTextWidget()
     TEST_ASSERT_NOT_NULL(textWidget.getFont().getGfxFont());
     TEST_ASSERT_EQUAL_PTR(TextWidget::DEFAULT_FONT, textWidget.getFont().getGfxFont());
 
+    /* Short text fits into the canvas, it must be static after drawing. */
+    textWidget.setFormatStr("Hi");
+    TEST_ASSERT_FALSE(textWidget.isStatic());
+    textWidget.update(testGfx);
+    TEST_ASSERT_TRUE(textWidget.isStatic());
+
     /* Set text with format tag and get text without format tag back. */
     textWidget.setFormatStr("\\#FF00FFHello World!");
     TEST_ASSERT_EQUAL_STRING("Hello World!", textWidget.getStr().c_str());
@@ -0,0 +1,161 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test time budget.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TestTimeBudget.h"
+
+#include <unity.h>
+#include <TimeBudget.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Test time budget.
+ */
+extern void testTimeBudget()
+{
+    const uint32_t  BUDGET          = 1000U;
+    const uint32_t  LIMIT           = 3U;
+    const uint32_t  OVERRUN         = 5000U;
+    const uint32_t  SKIP_CYCLES     = 5U;
+    const uint32_t  CYCLES          = 20U;
+    TimeBudget      budget;
+    bool            isEnabled       = true;
+    uint32_t        processCnt      = 0U;
+    uint32_t        cycle           = 0U;
+
+    /* Initial state */
+    TEST_ASSERT_EQUAL_UINT32(0U, budget.getViolations());
+    TEST_ASSERT_FALSE(budget.isSkipped());
+    TEST_ASSERT_FALSE(budget.isDisabled());
+    TEST_ASSERT_TRUE(budget.isProcessingAllowed(isEnabled));
+
+    /* Within the budget, no violation. */
+    TEST_ASSERT_FALSE(budget.check(BUDGET, BUDGET, LIMIT));
+    TEST_ASSERT_EQUAL_UINT32(0U, budget.getViolations());
+
+    /* The limit is reported once per period. */
+    TEST_ASSERT_FALSE(budget.check(OVERRUN, BUDGET, LIMIT));
+    TEST_ASSERT_FALSE(budget.check(OVERRUN, BUDGET, LIMIT));
+    TEST_ASSERT_TRUE(budget.check(OVERRUN, BUDGET, LIMIT));
+    TEST_ASSERT_FALSE(budget.check(OVERRUN, BUDGET, LIMIT));
+    TEST_ASSERT_EQUAL_UINT32(4U, budget.getViolations());
+
+    /* In the next period it is reported again. */
+    budget.nextPeriod();
+    TEST_ASSERT_FALSE(budget.check(OVERRUN, BUDGET, LIMIT));
+    TEST_ASSERT_FALSE(budget.check(OVERRUN, BUDGET, LIMIT));
+    TEST_ASSERT_TRUE(budget.check(OVERRUN, BUDGET, LIMIT));
+
+    /* Skipping consumes one cycle per call. */
+    budget.skip(SKIP_CYCLES);
+    TEST_ASSERT_TRUE(budget.isSkipped());
+    for(cycle = 0U; cycle < SKIP_CYCLES; ++cycle)
+    {
+        TEST_ASSERT_FALSE(budget.isProcessingAllowed(isEnabled));
+    }
+    TEST_ASSERT_FALSE(budget.isSkipped());
+    TEST_ASSERT_TRUE(budget.isProcessingAllowed(isEnabled));
+
+    /* A job, which exceeds its budget in every cycle, is disabled and
+     * not processed anymore.
+     */
+    budget.reset();
+    TEST_ASSERT_EQUAL_UINT32(0U, budget.getViolations());
+    for(cycle = 0U; cycle < CYCLES; ++cycle)
+    {
+        if (true == budget.isProcessingAllowed(isEnabled))
+        {
+            ++processCnt;
+
+            if (true == budget.check(OVERRUN, BUDGET, LIMIT))
+            {
+                budget.disable();
+                isEnabled = false;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(LIMIT, processCnt);
+    TEST_ASSERT_EQUAL_UINT32(LIMIT, budget.getViolations());
+    TEST_ASSERT_TRUE(budget.isDisabled());
+
+    /* Enabled again, it is processed again. */
+    isEnabled = true;
+    TEST_ASSERT_TRUE(budget.isProcessingAllowed(isEnabled));
+    TEST_ASSERT_FALSE(budget.isDisabled());
+
+    /* Its violation counter of the current period starts from scratch. */
+    TEST_ASSERT_FALSE(budget.check(OVERRUN, BUDGET, LIMIT));
+    TEST_ASSERT_FALSE(budget.check(OVERRUN, BUDGET, LIMIT));
+    TEST_ASSERT_TRUE(budget.check(OVERRUN, BUDGET, LIMIT));
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/